@@ -1,10 +1,12 @@
 TEMPLATE = subdirs
-SUBDIRS = YUViewLib YUViewApp
+SUBDIRS = YUViewLib YUViewApp YUViewMetrics
 
 YUViewApp.subdir = YUViewApp
 YUViewLib.subdir = YUViewLib
+YUViewMetrics.subdir = YUViewMetrics
 
 YUViewApp.depends = YUViewLib
+YUViewMetrics.depends = YUViewLib
 
 UNITTESTS {
   SUBDIRS += Googletest
@@ -0,0 +1,159 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BufferPool.h"
+
+#include <new>
+
+namespace
+{
+
+constexpr std::size_t SMALLEST_SIZE_CLASS = 4096;
+
+// Each buffer starts with a header that holds its size class. The header takes one alignment
+// unit so that the data after it is aligned as well.
+static_assert(sizeof(std::size_t) <= BufferPool::ALIGNMENT);
+
+void *allocateAligned(std::size_t sizeClass)
+{
+  auto memory = static_cast<char *>(
+      ::operator new(sizeClass + BufferPool::ALIGNMENT, std::align_val_t(BufferPool::ALIGNMENT)));
+  *reinterpret_cast<std::size_t *>(memory) = sizeClass;
+  return memory + BufferPool::ALIGNMENT;
+}
+
+char *getMemory(void *buffer)
+{
+  return static_cast<char *>(buffer) - BufferPool::ALIGNMENT;
+}
+
+std::size_t getSizeClassOfBuffer(void *buffer)
+{
+  return *reinterpret_cast<std::size_t *>(getMemory(buffer));
+}
+
+void freeAligned(void *buffer)
+{
+  ::operator delete(getMemory(buffer), std::align_val_t(BufferPool::ALIGNMENT));
+}
+
+} // namespace
+
+BufferPool::~BufferPool()
+{
+  this->setMaxIdleBytes(0);
+}
+
+void *BufferPool::allocate(std::size_t nrBytes)
+{
+  const auto sizeClass = getSizeClass(nrBytes);
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto                        it = this->idleBuffers.find(sizeClass);
+    if (it != this->idleBuffers.end() && !it->second.empty())
+    {
+      auto buffer = it->second.back();
+      it->second.pop_back();
+      this->idleBytes -= sizeClass;
+      return buffer;
+    }
+  }
+  return allocateAligned(sizeClass);
+}
+
+void BufferPool::release(void *buffer)
+{
+  if (buffer == nullptr)
+    return;
+
+  const auto sizeClass = getSizeClassOfBuffer(buffer);
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->idleBytes + sizeClass <= this->maxIdleBytes)
+    {
+      this->idleBuffers[sizeClass].push_back(buffer);
+      this->idleBytes += sizeClass;
+      return;
+    }
+  }
+  freeAligned(buffer);
+}
+
+void BufferPool::setMaxIdleBytes(std::size_t maxIdleBytes)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->maxIdleBytes = maxIdleBytes;
+  this->trim();
+}
+
+std::size_t BufferPool::getIdleBytes() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->idleBytes;
+}
+
+std::size_t BufferPool::getSizeClass(std::size_t nrBytes)
+{
+  if (nrBytes <= SMALLEST_SIZE_CLASS)
+    return SMALLEST_SIZE_CLASS;
+
+  std::size_t step = SMALLEST_SIZE_CLASS / 8;
+  while (step * 16 <= nrBytes)
+    step *= 2;
+  return (nrBytes + step - 1) / step * step;
+}
+
+void BufferPool::trim()
+{
+  // Free the largest buffers first. These are the most likely to be of a frame size that is not
+  // used anymore.
+  for (auto it = this->idleBuffers.rbegin();
+       it != this->idleBuffers.rend() && this->idleBytes > this->maxIdleBytes;
+       it++)
+  {
+    auto &buffers = it->second;
+    while (!buffers.empty() && this->idleBytes > this->maxIdleBytes)
+    {
+      freeAligned(buffers.back());
+      buffers.pop_back();
+      this->idleBytes -= it->first;
+    }
+  }
+}
+
+BufferPool &getFrameBufferPool()
+{
+  // Never destroyed so that images which are freed during static destruction can still give back
+  // their buffers.
+  static auto pool = new BufferPool;
+  return *pool;
+}
@@ -0,0 +1,85 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+
+// A pool of aligned memory buffers for frames and images. Buffers are grouped in size classes
+// so that a released buffer can be reused for a frame of (almost) the same size without calling
+// the system allocator and page faulting the memory again. Released buffers are kept until the
+// idle memory would exceed the given maximum.
+// All functions are thread-safe.
+class BufferPool
+{
+public:
+  static constexpr std::size_t ALIGNMENT = 64;
+
+  BufferPool() = default;
+  ~BufferPool();
+  BufferPool(const BufferPool &) = delete;
+  BufferPool &operator=(const BufferPool &) = delete;
+
+  // Get a buffer of at least the given size that is aligned to ALIGNMENT. The buffer must be given
+  // back with release().
+  void *allocate(std::size_t nrBytes);
+  void  release(void *buffer);
+
+  // Released buffers are freed if they exceed this limit. Setting a lower limit frees buffers now.
+  void        setMaxIdleBytes(std::size_t maxIdleBytes);
+  std::size_t getIdleBytes() const;
+
+  // The size that is allocated for a buffer of the given size. Above 4096 bytes, the sizes are
+  // rounded up to an eighth of a power of two, so at most 12.5% of a buffer are unused.
+  static std::size_t getSizeClass(std::size_t nrBytes);
+
+  // The frame buffer pool may keep this part of the video cache threshold in idle buffers. The
+  // video cache does not use this part for frames.
+  static std::size_t getShareOfVideoCacheThreshold(std::size_t thresholdBytes)
+  {
+    return thresholdBytes / 16;
+  }
+
+private:
+  void trim();
+
+  mutable std::mutex                         mutex;
+  std::map<std::size_t, std::vector<void *>> idleBuffers;
+  std::size_t                                idleBytes{};
+  std::size_t                                maxIdleBytes{};
+};
+
+// The pool that all frame and image buffers of the application are allocated from
+BufferPool &getFrameBufferPool();
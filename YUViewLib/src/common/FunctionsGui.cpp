@@ -32,6 +32,7 @@
 
 #include "FunctionsGui.h"
 
+#include <common/BufferPool.h>
 #include <common/Functions.h>
 
 #include <QSettings>
@@ -57,6 +58,31 @@ QImage::Format functionsGui::pixmapImageFormat()
   return format;
 }
 
+QImage functionsGui::createPooledImage(const QSize &size, QImage::Format format)
+{
+  if (size.isEmpty())
+    return {};
+
+  const auto bytesPerLine  = size.width() * bytesPerPixel(format);
+  const auto nrBytes       = std::size_t(bytesPerLine) * std::size_t(size.height());
+  auto       buffer        = getFrameBufferPool().allocate(nrBytes);
+  auto       releaseBuffer = [](void *info) { getFrameBufferPool().release(info); };
+  return QImage(static_cast<uchar *>(buffer),
+                size.width(),
+                size.height(),
+                bytesPerLine,
+                format,
+                releaseBuffer,
+                buffer);
+}
+
+std::size_t functionsGui::getPooledImageBytes(const Size &size, QImage::Format format)
+{
+  const auto nrBytes = std::size_t(size.width) * std::size_t(size.height) *
+                       std::size_t(bytesPerPixel(format));
+  return nrBytes == 0 ? 0 : BufferPool::getSizeClass(nrBytes);
+}
+
 QIcon functionsGui::convertIcon(QString iconPath)
 {
   QSettings settings;
@@ -39,6 +39,8 @@
 #include <QIcon>
 #include <QImage>
 
+#include <cstddef>
+
 /*
   This functions class is called "GUI" because you must link to the gui module of QT
   in order to use it. (E.g. QColor is part of the GUI module)
@@ -104,6 +106,15 @@ inline int bytesPerPixel(QImage::Format format)
   return bytesPerPixel(QImage::toPixelFormat(format));
 }
 
+// Create an image with packed lines (bytesPerLine is width * bytesPerPixel) whose buffer is taken
+// from the frame buffer pool. The buffer goes back to the pool when the last copy of the image is
+// destroyed. The content of the image is not initialized.
+QImage createPooledImage(const QSize &size, QImage::Format format);
+
+// The number of bytes that the frame buffer pool allocates for a pooled image of the given size.
+// This is a bit more than the image itself (see BufferPool::getSizeClass).
+std::size_t getPooledImageBytes(const Size &size, QImage::Format format);
+
 void setupUi(void *ui, void (*setupUi)(void *ui, QWidget *widget));
 
 // Return the icon/pixmap from the given file path (inverted if necessary)
@@ -0,0 +1,64 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ParallelFor.h"
+
+#include <common/ThreadBudget.h>
+
+#include <QFuture>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace functions
+{
+
+void parallelFor(const unsigned nrJobs, const std::function<void(unsigned)> &job)
+{
+  std::atomic<unsigned> nextJob{0};
+  auto                  worker = [&]() {
+    for (auto index = nextJob++; index < nrJobs; index = nextJob++)
+      job(index);
+  };
+
+  const auto nrThreads = std::min(nrJobs, getThreadBudget().parallelForThreads);
+  std::vector<QFuture<void>> helpers;
+  for (unsigned i = 1; i < nrThreads; i++)
+    helpers.push_back(QtConcurrent::run(worker));
+  worker();
+  for (auto &helper : helpers)
+    helper.waitForFinished();
+}
+
+} // namespace functions
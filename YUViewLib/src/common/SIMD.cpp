@@ -0,0 +1,103 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SIMD.h"
+
+#if SIMD_X86 && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace simd
+{
+
+namespace
+{
+
+InstructionSet detectInstructionSet()
+{
+#if SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+  // For AVX, __builtin_cpu_supports also checks if the OS saves the YMM registers (XGETBV).
+  if (__builtin_cpu_supports("avx2"))
+    return InstructionSet::AVX2;
+  if (__builtin_cpu_supports("sse4.1"))
+    return InstructionSet::SSE4_1;
+#elif SIMD_X86 && defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  const auto maxLeaf = info[0];
+
+  __cpuid(info, 1);
+  const auto sse4_1  = (info[2] & (1 << 19)) != 0;
+  const auto osxsave = (info[2] & (1 << 27)) != 0;
+  const auto avx     = (info[2] & (1 << 28)) != 0;
+
+  auto avx2 = false;
+  if (maxLeaf >= 7 && osxsave && avx)
+  {
+    // Check that the OS saves the XMM and YMM registers on context switches
+    const auto xcr0 = _xgetbv(0);
+    if ((xcr0 & 0x6) == 0x6)
+    {
+      __cpuidex(info, 7, 0);
+      avx2 = (info[1] & (1 << 5)) != 0;
+    }
+  }
+
+  if (avx2)
+    return InstructionSet::AVX2;
+  if (sse4_1)
+    return InstructionSet::SSE4_1;
+#endif
+  return InstructionSet::None;
+}
+
+} // namespace
+
+InstructionSet getSupportedInstructionSet()
+{
+  static const auto supportedInstructionSet = detectInstructionSet();
+  return supportedInstructionSet;
+}
+
+std::vector<InstructionSet> getAllSupportedInstructionSets()
+{
+  std::vector<InstructionSet> instructionSets;
+  const auto                  supported = getSupportedInstructionSet();
+  for (const auto instructionSet : InstructionSetMapper.getValues())
+    if (instructionSet <= supported)
+      instructionSets.push_back(instructionSet);
+  return instructionSets;
+}
+
+} // namespace simd
@@ -0,0 +1,83 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/EnumMapper.h>
+
+#include <vector>
+
+// SIMD code paths are only compiled for x86. On all other architectures we fall back to the scalar
+// implementations.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_X86 1
+#else
+#define SIMD_X86 0
+#endif
+
+// We do not compile the whole library with -mavx2 since the binaries must still run on older
+// CPUs. Instead, only the functions that use the intrinsics are compiled for the given instruction
+// set and we select them at runtime. MSVC does not need (or support) these attributes.
+#if SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_TARGET_SSE4_1 __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SIMD_TARGET_SSE4_1
+#define SIMD_TARGET_AVX2
+#endif
+
+namespace simd
+{
+
+// The instruction sets that we have specialized code for. Every instruction set includes all the
+// ones before it.
+enum class InstructionSet
+{
+  None,
+  SSE4_1,
+  AVX2
+};
+
+constexpr auto InstructionSetMapper =
+    EnumMapper<InstructionSet, 3>(std::make_pair(InstructionSet::None, "None"sv),
+                                  std::make_pair(InstructionSet::SSE4_1, "SSE4.1"sv),
+                                  std::make_pair(InstructionSet::AVX2, "AVX2"sv));
+
+// Get the best instruction set that is supported by the CPU (and the OS) we are running on.
+// The detection is only performed once. This function is thread safe and inexpensive to call.
+InstructionSet getSupportedInstructionSet();
+
+// Get all instruction sets up to the supported one. Mainly used to test all code paths against
+// each other.
+std::vector<InstructionSet> getAllSupportedInstructionSets();
+
+} // namespace simd
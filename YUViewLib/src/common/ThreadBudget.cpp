@@ -0,0 +1,111 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThreadBudget.h"
+
+#include <QThread>
+
+#include <algorithm>
+#include <mutex>
+
+namespace functions
+{
+
+namespace
+{
+
+// The interactive loading can load two items at the same time (when the view is split)
+constexpr unsigned NR_INTERACTIVE_LOADERS = 2;
+
+unsigned getNrCores()
+{
+  return unsigned(std::max(1, QThread::idealThreadCount()));
+}
+
+std::mutex   budgetMutex;
+ThreadBudget currentBudget = calculateThreadBudget(getNrCores(), 0, false);
+
+} // namespace
+
+ThreadBudget calculateThreadBudget(unsigned nrCores, unsigned nrCachingWorkers, bool playing)
+{
+  nrCores = std::max(nrCores, 1u);
+
+  const auto coresWithoutCaching = nrCores > nrCachingWorkers ? nrCores - nrCachingWorkers : 0u;
+
+  // The cores that the caching workers do not use are shared by the interactive loaders and
+  // parallelFor. Each caching worker needs at least one core.
+  auto coresForInteractive = coresWithoutCaching;
+  if (!playing && nrCachingWorkers > 0)
+  {
+    // Frames are only loaded interactively when the user selects them. Keep some cores for this
+    // and leave the rest to caching.
+    coresForInteractive = std::min(std::max(nrCores / 4, 1u), coresWithoutCaching);
+  }
+
+  ThreadBudget budget;
+  budget.interactiveDecoderThreads = std::max(coresForInteractive / NR_INTERACTIVE_LOADERS, 1u);
+  budget.parallelForThreads        = std::max(coresForInteractive, 1u);
+  if (!playing && nrCachingWorkers > 0)
+    budget.cachingDecoderThreads =
+        std::max((nrCores - coresForInteractive) / nrCachingWorkers, 1u);
+  return budget;
+}
+
+void updateThreadBudget(unsigned nrCachingWorkers, bool playing)
+{
+  const auto budget = calculateThreadBudget(getNrCores(), nrCachingWorkers, playing);
+
+  std::lock_guard<std::mutex> lock(budgetMutex);
+  currentBudget = budget;
+}
+
+ThreadBudget getThreadBudget()
+{
+  std::lock_guard<std::mutex> lock(budgetMutex);
+  return currentBudget;
+}
+
+std::optional<unsigned> getFrameToRecreateDecoderAt(unsigned frameIdx,
+                                                    bool     frameIsRandomAccessPoint,
+                                                    bool     seek,
+                                                    unsigned seekPoint)
+{
+  // Starting at the requested frame does not decode any additional frames
+  if (frameIsRandomAccessPoint)
+    return frameIdx;
+  if (seek)
+    return seekPoint;
+  return {};
+}
+
+} // namespace functions
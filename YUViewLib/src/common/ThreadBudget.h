@@ -0,0 +1,79 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <optional>
+
+namespace functions
+{
+
+// The CPU threads that the decoders and the frame conversion may use. The interactive loading
+// (up to two items) and the caching workers share the available cores so that the libraries
+// do not all start one thread per core on their own.
+struct ThreadBudget
+{
+  // The number of threads for the decoder of each interactively loaded item
+  unsigned interactiveDecoderThreads{1};
+  // The number of threads for the decoder of each caching worker
+  unsigned cachingDecoderThreads{1};
+  // The number of threads that parallelFor may use for one call
+  unsigned parallelForThreads{1};
+
+  unsigned getDecoderThreads(bool cachingDecoder) const
+  {
+    return cachingDecoder ? this->cachingDecoderThreads : this->interactiveDecoderThreads;
+  }
+};
+
+// While playback is running, the interactive loading has priority and the (few) caching workers
+// that run during playback get one thread each. Otherwise the caching workers get most of the
+// cores. The caching workers and the interactive loading (decoders and parallelFor) never use more
+// than nrCores threads together, unless there are more caching workers than cores.
+ThreadBudget calculateThreadBudget(unsigned nrCores, unsigned nrCachingWorkers, bool playing);
+
+// The budget is calculated from the number of cores of the system. It is updated by the video
+// cache when the number of caching workers changes or when playback starts or stops. Decoders
+// that are already running keep their number of threads. Caching decoders are recreated with the
+// new budget at the next random access point.
+void         updateThreadBudget(unsigned nrCachingWorkers, bool playing);
+ThreadBudget getThreadBudget();
+
+// A caching decoder with an outdated budget is only recreated if decoding starts over at a random
+// access point anyway. This is the case if the decoder has to seek to seekPoint or if the requested
+// frame is a random access point itself. Returns the frame where the new decoder starts decoding.
+std::optional<unsigned> getFrameToRecreateDecoderAt(unsigned frameIdx,
+                                                    bool     frameIsRandomAccessPoint,
+                                                    bool     seek,
+                                                    unsigned seekPoint);
+
+} // namespace functions
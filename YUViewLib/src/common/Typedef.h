@@ -90,7 +90,6 @@ const bool is_Q_OS_LINUX = false;
 #if SSE_CONVERSION
 
 #define HAVE_SSE4_1 1
-#define SSE_CONVERSION_420_ALT 1 // Alternate method for SSE Conversion, Testing only
 
 #ifdef HAVE_MALLOC_H
 #include <malloc.h>
@@ -76,6 +76,31 @@ void decoderBase::resetDecoder()
   this->decoderState = DecoderState::NeedsMoreData;
 }
 
+void decoderBase::releaseOutputBuffer(QByteArray &outputBuffer)
+{
+  if (outputBuffer.isEmpty())
+    return;
+  std::swap(this->releasedOutputBuffer, outputBuffer);
+  outputBuffer.clear();
+}
+
+void decoderBase::prepareOutputBuffer(QByteArray &outputBuffer, int nrBytes)
+{
+  // The buffers reserve their capacity, so shrinking keeps the memory if nobody else references the
+  // released buffer. A shared buffer is detached by the resize and the new (empty) array has no
+  // capacity. The other references to the old frame are not touched.
+  this->releasedOutputBuffer.resize(0);
+  if (this->releasedOutputBuffer.capacity() >= nrBytes)
+    std::swap(this->releasedOutputBuffer, outputBuffer);
+  else
+  {
+    outputBuffer.clear();
+    outputBuffer.reserve(nrBytes);
+  }
+  this->releasedOutputBuffer.clear();
+  outputBuffer.resize(nrBytes);
+}
+
 bool decoderBase::isSignalDifference(int signalID) const
 {
   Q_UNUSED(signalID);
@@ -173,6 +173,17 @@ protected:
 
   // If set, fill it (if possible). The playlistItem has ownership of this.
   stats::StatisticsData *statisticsData{};
+
+  // The decoders copy each decoded frame into an output buffer which is then shared (not copied)
+  // with the playlist item and the cache. Release the buffer when a new frame is decoded. When the
+  // new frame is copied, prepare the output buffer. The released buffer is reused if nobody
+  // references it anymore. A buffer that is still shared is never written to, because that would
+  // copy (detach) the old frame first.
+  void releaseOutputBuffer(QByteArray &outputBuffer);
+  void prepareOutputBuffer(QByteArray &outputBuffer, int nrBytes);
+
+private:
+  QByteArray releasedOutputBuffer;
 };
 
 // This abstract base class extends the decoderBase class by the ability to load one single library
@@ -39,6 +39,7 @@
 #include <cstring>
 
 #include <common/Functions.h>
+#include <common/ThreadBudget.h>
 #include <common/Typedef.h>
 
 namespace decoder
@@ -246,6 +247,11 @@ void decoderDav1d::allocateNewDecoder()
 
   this->lib.dav1d_default_settings(&settings);
 
+  // Frame threads would delay the output of frames. Only use tile threads.
+  const auto nrThreads     = functions::getThreadBudget().getDecoderThreads(this->isCachingDecoder);
+  settings.n_frame_threads = 1;
+  settings.n_tile_threads  = int(nrThreads);
+
   // Create new decoder object
   int err = this->lib.dav1d_open(&decoder, &settings);
   if (err != 0)
@@ -283,7 +289,7 @@ void decoderDav1d::allocateNewDecoder()
 
   // The decoder is ready to receive data
   decoderBase::resetDecoder();
-  currentOutputBuffer.clear();
+  this->releaseOutputBuffer(this->currentOutputBuffer);
   decodedFrameWaiting = false;
   flushing            = false;
 }
@@ -345,7 +351,7 @@ bool decoderDav1d::decodeFrame()
     DEBUG_DAV1D("decoderDav1d::decodeFrame Picture decoded - switching to retrieve frame mode");
 
     decoderState = DecoderState::RetrieveFrames;
-    currentOutputBuffer.clear();
+    this->releaseOutputBuffer(this->currentOutputBuffer);
     return true;
   }
   else if (res != -EAGAIN)
@@ -500,8 +506,7 @@ void decoderDav1d::copyImgToByteArray(const Dav1dPictureWrapper &src, QByteArray
   DEBUG_DAV1D("decoderDav1d::copyImgToByteArray nrBytes %d", nrBytes);
 
   // Is the output big enough?
-  if (dst.capacity() < int(nrBytes))
-    dst.resize(int(nrBytes));
+  this->prepareOutputBuffer(dst, int(nrBytes));
 
   uint8_t *dst_c = (uint8_t *)dst.data();
 
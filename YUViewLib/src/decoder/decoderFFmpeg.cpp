@@ -33,6 +33,7 @@
 #include "decoderFFmpeg.h"
 
 #include <common/Functions.h>
+#include <common/ThreadBudget.h>
 
 #define DECODERFFMPEG_DEBUG_OUTPUT 0
 #if DECODERFFMPEG_DEBUG_OUTPUT && !NDEBUG
@@ -192,8 +193,7 @@ void decoderFFmpeg::copyCurImageToBuffer()
     const auto nrBytes = nrBytesY + 2 * nrBytesC;
 
     // Is the output big enough?
-    if (auto c = functions::clipToUnsigned(this->currentOutputBuffer.capacity()); c < nrBytes)
-      this->currentOutputBuffer.resize(nrBytes);
+    this->prepareOutputBuffer(this->currentOutputBuffer, int(nrBytes));
 
     // Copy line by line. The linesize of the source may be larger than the width of the frame.
     // This may be because the frame buffer is (8) byte aligned. Also the internal decoded
@@ -227,8 +227,7 @@ void decoderFFmpeg::copyCurImageToBuffer()
     const auto nrBytes = nrBytesPerComponent * pixFmt.nrChannels();
 
     // Is the output big enough?
-    if (auto c = functions::clipToUnsigned(this->currentOutputBuffer.capacity()); c < nrBytes)
-      this->currentOutputBuffer.resize(nrBytes);
+    this->prepareOutputBuffer(this->currentOutputBuffer, int(nrBytes));
 
     auto       dst  = this->currentOutputBuffer.data();
     const auto hDst = this->frameSize.height;
@@ -398,7 +397,7 @@ bool decoderFFmpeg::decodeFrame()
     // Checkt the size of the retrieved image
     if (this->frameSize != this->frame.getSize())
       return this->setErrorB("Received a frame of different size");
-    this->currentOutputBuffer.clear();
+    this->releaseOutputBuffer(this->currentOutputBuffer);
     return true;
   }
   else if (retRecieve < 0 && retRecieve != AVERROR(EAGAIN) && retRecieve != -35)
@@ -473,6 +472,12 @@ bool decoderFFmpeg::createDecoder(FFmpeg::AVCodecIDWrapper         codecID,
     return this->setErrorB(
         QStringLiteral("Could not request motion vector retrieval. Return code %1").arg(ret));
 
+  const auto nrThreads = functions::getThreadBudget().getDecoderThreads(this->isCachingDecoder);
+  ret = this->ff.dictSet(opts, "threads", std::to_string(nrThreads).c_str(), 0);
+  if (ret < 0)
+    return this->setErrorB(
+        QStringLiteral("Could not set the number of decoder threads. Return code %1").arg(ret));
+
   // Open codec
   ret = this->ff.avcodecOpen2(decCtx, videoCodec, opts);
   if (ret < 0)
@@ -339,7 +339,7 @@ bool decoderHM::pushData(QByteArray &data)
   {
     decodedFrameWaiting = true;
     decoderState        = DecoderState::RetrieveFrames;
-    currentOutputBuffer.clear();
+    this->releaseOutputBuffer(this->currentOutputBuffer);
   }
 
   // If bNewPicture is true, the decoder noticed that a new picture starts with this
@@ -405,8 +405,7 @@ void decoderHM::copyImgToByteArray(libHMDec_picture *src, QByteArray &dst)
   DEBUG_DECHM("decoderHM::copyImgToByteArray nrBytesOutput %d", nrBytesOutput);
 
   // Is the output big enough?
-  if (dst.capacity() < nrBytesOutput)
-    dst.resize(nrBytesOutput);
+  this->prepareOutputBuffer(dst, nrBytesOutput);
 
   // The source (from HM) is always short (16bit). The destination is a QByteArray so
   // we have to cast it right.
@@ -38,6 +38,7 @@
 #include <cstring>
 
 #include <common/Functions.h>
+#include <common/ThreadBudget.h>
 #include <common/Typedef.h>
 
 namespace decoder
@@ -295,14 +296,14 @@ void decoderLibde265::allocateNewDecoder()
   this->lib.de265_set_limit_TID(this->decoder, 100);
 
   // Set the number of decoder threads. Libde265 can use wavefronts to utilize these.
-  // TODO: We should add a setting for this maybe?
-  auto err = this->lib.de265_start_worker_threads(this->decoder, 8);
+  const auto nrThreads = functions::getThreadBudget().getDecoderThreads(this->isCachingDecoder);
+  auto       err       = this->lib.de265_start_worker_threads(this->decoder, int(nrThreads));
   if (err != DE265_OK)
     return setError("Error starting libde265 worker threads (de265_start_worker_threads)");
 
   // The decoder is ready to receive data
   decoderBase::resetDecoder();
-  this->currentOutputBuffer.clear();
+  this->releaseOutputBuffer(this->currentOutputBuffer);
   this->decodedFrameWaiting = false;
   this->flushing            = false;
 }
@@ -383,7 +384,7 @@ bool decoderLibde265::decodeFrame()
     DEBUG_LIBDE265("decoderLibde265::decodeFrame Picture decoded");
 
     this->decoderState = DecoderState::RetrieveFrames;
-    this->currentOutputBuffer.clear();
+    this->releaseOutputBuffer(this->currentOutputBuffer);
     return true;
   }
   return false;
@@ -489,8 +490,7 @@ void decoderLibde265::copyImgToByteArray(const de265_image *src, QByteArray &dst
   DEBUG_LIBDE265("decoderLibde265::copyImgToByteArray nrBytes %d", nrBytes);
 
   // Is the output big enough?
-  if (dst.capacity() < nrBytes)
-    dst.resize(nrBytes);
+  this->prepareOutputBuffer(dst, nrBytes);
 
   uint8_t *dst_c = (uint8_t *)dst.data();
 
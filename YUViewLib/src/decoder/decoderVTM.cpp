@@ -299,7 +299,7 @@ bool decoderVTM::getNextFrameFromDecoder()
 
   DEBUG_DECVTM("decoderVTM::getNextFrameFromDecoder got a valid frame wit POC %d",
                this->lib.libVTMDec_get_POC(currentVTMPic));
-  currentOutputBuffer.clear();
+  this->releaseOutputBuffer(this->currentOutputBuffer);
   return true;
 }
 
@@ -333,7 +333,7 @@ bool decoderVTM::pushData(QByteArray &data)
   {
     decodedFrameWaiting = true;
     decoderState        = DecoderState::RetrieveFrames;
-    currentOutputBuffer.clear();
+    this->releaseOutputBuffer(this->currentOutputBuffer);
   }
 
   // If bNewPicture is true, the decoder noticed that a new picture starts with this
@@ -395,8 +395,7 @@ void decoderVTM::copyImgToByteArray(libVTMDec_picture *src, QByteArray &dst)
   DEBUG_DECVTM("decoderVTM::copyImgToByteArray nrBytesOutput %d", nrBytesOutput);
 
   // Is the output big enough?
-  if (dst.capacity() < nrBytesOutput)
-    dst.resize(nrBytesOutput);
+  this->prepareOutputBuffer(dst, nrBytesOutput);
 
   // The source (from VTM) is always short (16bit). The destination is a QByteArray so
   // we have to cast it right.
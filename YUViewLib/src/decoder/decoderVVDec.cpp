@@ -32,6 +32,7 @@
 
 #include "decoderVVDec.h"
 
+#include <common/ThreadBudget.h>
 #include <common/Typedef.h>
 
 #include <QCoreApplication>
@@ -269,6 +270,7 @@ void decoderVVDec::allocateNewDecoder()
   this->lib.vvdec_params_default(&params);
 
   params.logLevel = VVDEC_INFO;
+  params.threads  = int(functions::getThreadBudget().getDecoderThreads(this->isCachingDecoder));
 
   this->decoder = this->lib.vvdec_decoder_open(&params);
   if (this->decoder == nullptr)
@@ -278,7 +280,7 @@ void decoderVVDec::allocateNewDecoder()
   }
 
   this->flushing = false;
-  this->currentOutputBuffer.clear();
+  this->releaseOutputBuffer(this->currentOutputBuffer);
   this->decoderState                  = DecoderState::NeedsMoreData;
   this->currentFrameReadyForRetrieval = false;
   this->currentFrame                  = nullptr;
@@ -331,7 +333,7 @@ bool decoderVVDec::decodeNextFrame()
       return false;
     }
 
-    this->currentOutputBuffer.clear();
+    this->releaseOutputBuffer(this->currentOutputBuffer);
     DEBUG_vvdec("decoderVVDec::decodeNextFrame Flushing - Invalidate buffer");
   }
   else
@@ -426,7 +428,7 @@ bool decoderVVDec::pushData(QByteArray &data)
     DEBUG_vvdec("decoderVVDec::pushData: Setting flushing mode");
     this->flushing     = true;
     this->decoderState = DecoderState::RetrieveFrames;
-    this->currentOutputBuffer.clear();
+    this->releaseOutputBuffer(this->currentOutputBuffer);
     return true;
   }
   else
@@ -458,7 +460,7 @@ bool decoderVVDec::pushData(QByteArray &data)
   if (this->getNextFrameFromDecoder())
   {
     this->decoderState = DecoderState::RetrieveFrames;
-    this->currentOutputBuffer.clear();
+    this->releaseOutputBuffer(this->currentOutputBuffer);
   }
 
   return true;
@@ -502,8 +504,7 @@ void decoderVVDec::copyImgToByteArray(QByteArray &dst)
   DEBUG_vvdec("decoderVVDec::copyImgToByteArray nrBytesOutput %d", nrBytesOutput);
 
   // Is the output big enough?
-  if (dst.capacity() < int(nrBytesOutput))
-    dst.resize(int(nrBytesOutput));
+  this->prepareOutputBuffer(dst, int(nrBytesOutput));
 
   for (unsigned c = 0; c < nrPlanes; c++)
   {
@@ -0,0 +1,296 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BitstreamIndex.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <optional>
+
+#define BITSTREAMINDEX_DEBUG_OUTPUT 0
+#if BITSTREAMINDEX_DEBUG_OUTPUT && !NDEBUG
+#include <QDebug>
+#define DEBUG_INDEX qDebug
+#else
+#define DEBUG_INDEX(fmt, ...) ((void)0)
+#endif
+
+namespace
+{
+
+constexpr char INDEX_MAGIC[] = {'Y', 'U', 'V', 'i', 'e', 'w', 'I', 'x'};
+
+// The values in the index are saved as variable length integers (7 bits per byte, LSB first). Most
+// values (POCs, frame numbers, small file offsets) fit into one to three bytes.
+void appendUInt(ByteVector &data, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    data.push_back(uint8_t(value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  data.push_back(uint8_t(value));
+}
+
+// Signed values are mapped to unsigned ones so that small negative values also stay small
+uint64_t zigZagEncode(int64_t value)
+{
+  return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+}
+
+int64_t zigZagDecode(uint64_t value)
+{
+  return int64_t(value >> 1) ^ -int64_t(value & 1);
+}
+
+void appendString(ByteVector &data, const QString &string)
+{
+  const auto utf8 = string.toUtf8();
+  appendUInt(data, uint64_t(utf8.size()));
+  data.insert(data.end(), utf8.begin(), utf8.end());
+}
+
+struct FileState
+{
+  QString absolutePath;
+  int64_t size{};
+  int64_t modificationTime{};
+};
+
+std::optional<FileState> getFileState(const QString &filePath)
+{
+  QFileInfo fileInfo(filePath);
+  if (!fileInfo.exists() || !fileInfo.isFile())
+    return {};
+  return FileState{
+      fileInfo.absoluteFilePath(), fileInfo.size(), fileInfo.lastModified().toMSecsSinceEpoch()};
+}
+
+} // namespace
+
+bool BitstreamIndex::isEnabled()
+{
+  QSettings settings;
+  return settings.value("CacheBitstreamIndex", true).toBool();
+}
+
+QString BitstreamIndex::getIndexFilePath(const QString &bitstreamFilePath)
+{
+  const auto absolutePath = QFileInfo(bitstreamFilePath).absoluteFilePath();
+  const auto hash = QCryptographicHash::hash(absolutePath.toUtf8(), QCryptographicHash::Sha1);
+  return QDir(getIndexDirectory()).filePath(QString(hash.toHex()) + ".idx");
+}
+
+QString BitstreamIndex::getIndexDirectory()
+{
+  const auto cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  return QDir(cacheDir).filePath("bitstreamIndex");
+}
+
+void BitstreamIndex::removeOldIndices(int64_t maxTotalBytes, int maxAgeDays)
+{
+  // Newest first
+  const auto indexFiles = QDir(getIndexDirectory())
+                              .entryInfoList(QStringList() << "*.idx", QDir::Files, QDir::Time);
+
+  const auto oldestAllowed = QDateTime::currentDateTime().addDays(-maxAgeDays);
+  int64_t    totalBytes    = 0;
+  for (const auto &fileInfo : indexFiles)
+  {
+    totalBytes += fileInfo.size();
+    if (fileInfo.lastModified() < oldestAllowed || totalBytes > maxTotalBytes)
+    {
+      DEBUG_INDEX("BitstreamIndex::removeOldIndices Removing %s",
+                  fileInfo.fileName().toLatin1().data());
+      QFile::remove(fileInfo.absoluteFilePath());
+    }
+  }
+}
+
+bool BitstreamIndex::load(const QString &bitstreamFilePath, const QString &format)
+{
+  this->indexFile.close();
+  this->mappedData = nullptr;
+  this->mappedSize = 0;
+  this->readPos    = 0;
+  this->valid      = true;
+
+  const auto fileState = getFileState(bitstreamFilePath);
+  if (!fileState)
+    return false;
+
+  this->indexFile.setFileName(getIndexFilePath(bitstreamFilePath));
+  if (!this->indexFile.open(QIODevice::ReadOnly))
+    return false;
+
+  const auto indexSize = this->indexFile.size();
+  if (indexSize < int64_t(sizeof(INDEX_MAGIC)))
+    return false;
+  this->mappedData = this->indexFile.map(0, indexSize);
+  if (this->mappedData == nullptr)
+    return false;
+  this->mappedSize = size_t(indexSize);
+
+  if (!std::equal(std::begin(INDEX_MAGIC), std::end(INDEX_MAGIC), this->mappedData))
+    return false;
+  this->readPos = sizeof(INDEX_MAGIC);
+
+  auto readString = [this]() {
+    const auto bytes = this->readBytes();
+    return QString::fromUtf8(reinterpret_cast<const char *>(bytes.data()), int(bytes.size()));
+  };
+
+  const auto version          = this->readUInt();
+  const auto indexFormat      = readString();
+  const auto absolutePath     = readString();
+  const auto size             = this->readInt();
+  const auto modificationTime = this->readInt();
+  if (!this->valid || version != INDEX_VERSION || indexFormat != format ||
+      absolutePath != fileState->absolutePath || size != fileState->size ||
+      modificationTime != fileState->modificationTime)
+  {
+    DEBUG_INDEX("BitstreamIndex::load Index for %s is outdated",
+                bitstreamFilePath.toLatin1().data());
+    return false;
+  }
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+  // The modification time of the index is used as the time when it was last used
+  this->indexFile.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+#endif
+
+  DEBUG_INDEX("BitstreamIndex::load Loaded index for %s", bitstreamFilePath.toLatin1().data());
+  return true;
+}
+
+bool BitstreamIndex::save(const QString &bitstreamFilePath, const QString &format) const
+{
+  const auto fileState = getFileState(bitstreamFilePath);
+  if (!fileState)
+    return false;
+
+  ByteVector header(std::begin(INDEX_MAGIC), std::end(INDEX_MAGIC));
+  appendUInt(header, INDEX_VERSION);
+  appendString(header, format);
+  appendString(header, fileState->absolutePath);
+  appendUInt(header, zigZagEncode(fileState->size));
+  appendUInt(header, zigZagEncode(fileState->modificationTime));
+
+  const auto indexFilePath = getIndexFilePath(bitstreamFilePath);
+  if (!QDir().mkpath(QFileInfo(indexFilePath).absolutePath()))
+    return false;
+
+  // Write to a temporary file first so that other instances never map a half written index
+  QSaveFile file(indexFilePath);
+  if (!file.open(QIODevice::WriteOnly))
+    return false;
+  file.write(reinterpret_cast<const char *>(header.data()), qint64(header.size()));
+  file.write(reinterpret_cast<const char *>(this->data.data()), qint64(this->data.size()));
+  const auto success = file.commit();
+
+  if (success)
+    removeOldIndices();
+
+  DEBUG_INDEX("BitstreamIndex::save Saved index for %s to %s (%s)",
+              bitstreamFilePath.toLatin1().data(),
+              indexFilePath.toLatin1().data(),
+              success ? "ok" : "failed");
+  return success;
+}
+
+void BitstreamIndex::writeUInt(uint64_t value)
+{
+  appendUInt(this->data, value);
+}
+
+void BitstreamIndex::writeInt(int64_t value)
+{
+  appendUInt(this->data, zigZagEncode(value));
+}
+
+void BitstreamIndex::writeBytes(const ByteVector &bytes)
+{
+  appendUInt(this->data, uint64_t(bytes.size()));
+  this->data.insert(this->data.end(), bytes.begin(), bytes.end());
+}
+
+uint64_t BitstreamIndex::readUInt()
+{
+  uint64_t value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7)
+  {
+    if (this->readPos >= this->mappedSize)
+      break;
+    const auto byte = this->mappedData[this->readPos++];
+    value |= uint64_t(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+      return value;
+  }
+  this->valid = false;
+  return 0;
+}
+
+int64_t BitstreamIndex::readInt()
+{
+  return zigZagDecode(this->readUInt());
+}
+
+ByteVector BitstreamIndex::readBytes()
+{
+  const auto size = this->readUInt();
+  if (!this->valid || size > this->mappedSize - this->readPos)
+  {
+    this->valid = false;
+    return {};
+  }
+  ByteVector bytes(this->mappedData + this->readPos, this->mappedData + this->readPos + size);
+  this->readPos += size;
+  return bytes;
+}
+
+uint64_t BitstreamIndex::readCount()
+{
+  const auto count = this->readUInt();
+  if (!this->valid || count > this->mappedSize - this->readPos)
+  {
+    this->valid = false;
+    return 0;
+  }
+  return count;
+}
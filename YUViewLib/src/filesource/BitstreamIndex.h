@@ -0,0 +1,109 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QString>
+
+#include <common/Typedef.h>
+
+/* A persistent index of a bitstream file. Finding all frames, random access points and parameter
+ * sets in a bitstream requires a scan of the whole file which can take minutes for big files. The
+ * result of the scan can be saved in an index file (in the cache directory) so that the scan can be
+ * skipped when the same file is opened again. An index is identified by the absolute path of the
+ * bitstream file and it is only valid as long as the size and the modification time of the file
+ * did not change.
+ *
+ * The content of the index is a plain sequence of values. When saving, the values are written one
+ * after another. When loading, the index file is mapped into memory and the values must be read
+ * back in the same order. If a read goes beyond the end of the index, isValid() returns false.
+ */
+class BitstreamIndex
+{
+public:
+  BitstreamIndex() = default;
+
+  // Is saving and loading of bitstream indices enabled in the settings?
+  static bool isEnabled();
+
+  // Load the index of the given bitstream file. The format identifies the writer of the index
+  // (e.g. the parser type). Return false if there is no index that is valid for the file in its
+  // current state.
+  bool load(const QString &bitstreamFilePath, const QString &format);
+  // Save all values that were written as the index of the given bitstream file.
+  bool save(const QString &bitstreamFilePath, const QString &format) const;
+
+  void writeUInt(uint64_t value);
+  void writeInt(int64_t value);
+  void writeBool(bool value) { this->writeUInt(value ? 1 : 0); }
+  void writeBytes(const ByteVector &data);
+  void writeCount(uint64_t count) { this->writeUInt(count); }
+
+  uint64_t   readUInt();
+  int64_t    readInt();
+  bool       readBool() { return this->readUInt() != 0; }
+  ByteVector readBytes();
+  // Read the number of entries of a list. Every entry takes at least one byte so this fails if
+  // there are not enough bytes left in the index.
+  uint64_t readCount();
+
+  // False if reading failed at some point (e.g. the index is truncated)
+  bool isValid() const { return this->valid; }
+  // True if all values of the index have been read
+  bool atEnd() const { return this->readPos >= this->mappedSize; }
+
+  static QString getIndexFilePath(const QString &bitstreamFilePath);
+  static QString getIndexDirectory();
+
+  // Remove indices that were not used for more than maxAgeDays. If the remaining indices are
+  // bigger than maxTotalBytes, the least recently used ones are removed. Loading an index marks it
+  // as used. This is called after an index was saved.
+  static void removeOldIndices(int64_t maxTotalBytes = MAX_TOTAL_INDEX_BYTES,
+                               int     maxAgeDays    = MAX_INDEX_AGE_DAYS);
+
+  static constexpr int64_t MAX_TOTAL_INDEX_BYTES = 256 * 1024 * 1024;
+  static constexpr int     MAX_INDEX_AGE_DAYS    = 90;
+
+  // Increase this whenever the layout of the index changes so that old indices are not used.
+  static constexpr uint64_t INDEX_VERSION = 1;
+
+private:
+  // The values that will be saved (the file header is only added when saving)
+  ByteVector data;
+
+  QFile          indexFile;
+  const uint8_t *mappedData{};
+  size_t         mappedSize{};
+  size_t         readPos{};
+  bool           valid{true};
+};
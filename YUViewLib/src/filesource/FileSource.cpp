@@ -34,13 +34,23 @@
 
 #include <common/Typedef.h>
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
 #include <QDateTime>
 #include <QDir>
 #include <QSettings>
 #include <QtGlobal>
 #ifdef Q_OS_WIN
+#include <io.h>
 #include <windows.h>
 #endif
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #define FILESOURCE_DEBUG_SIMULATESLOWLOADING 0
 #if FILESOURCE_DEBUG_SIMULATESLOWLOADING && !NDEBUG
@@ -62,14 +72,22 @@ bool FileSource::openFile(const QString &filePath)
   if (!this->fileInfo.exists() || !this->fileInfo.isFile())
     return false;
 
-  if (this->isFileOpened && this->srcFile.isOpen())
-    this->srcFile.close();
-
-  // open file for reading
-  this->srcFile.setFileName(filePath);
-  this->isFileOpened = this->srcFile.open(QIODevice::ReadOnly);
-  if (!this->isFileOpened)
-    return false;
+  {
+    QWriteLocker locker(&this->fileAccessLock);
+
+    // Closing the file also removes all mappings of it
+    if (this->isFileOpened && this->srcFile.isOpen())
+      this->srcFile.close();
+    this->mappedData        = nullptr;
+    this->mappedSize        = 0;
+    this->mappedFileChanged = false;
+
+    // open file for reading
+    this->srcFile.setFileName(filePath);
+    this->isFileOpened = this->srcFile.open(QIODevice::ReadOnly);
+    if (!this->isFileOpened)
+      return false;
+  }
 
   // Save the full file path
   this->fullFilePath = filePath;
@@ -91,8 +109,7 @@ void FileSource::readBytes(byteArrayAligned &targetBuffer, int64_t startPos, int
   if (targetBuffer.size() < nrBytes)
     targetBuffer.resize(nrBytes);
 
-  srcFile.seek(startPos);
-  srcFile.read(targetBuffer.data(), nrBytes);
+  this->readAt(targetBuffer.data(), startPos, nrBytes);
 }
 #endif
 
@@ -109,10 +126,178 @@ int64_t FileSource::readBytes(QByteArray &targetBuffer, int64_t startPos, int64_
   QThread::msleep(50);
 #endif
 
+  return this->readAt(targetBuffer.data(), startPos, nrBytes);
+}
+
+bool FileSource::mapFileToMemory()
+{
+  if (!this->isFileOpened)
+    return false;
+
+  QWriteLocker locker(&this->fileAccessLock);
+  if (this->mappedData != nullptr)
+    return true;
+
+  const auto fileSize = this->srcFile.size();
+  if (fileSize <= 0 || uint64_t(fileSize) > uint64_t(std::numeric_limits<size_t>::max()))
+    return false;
+
+  // Reading from a mapping of a file that is truncated by another process crashes (SIGBUS). A file
+  // that was modified recently may still be written to (e.g. by an encoder). Don't map it.
+  const auto lastModified = QFileInfo(this->srcFile).lastModified();
+  if (lastModified.secsTo(QDateTime::currentDateTime()) < MIN_SECONDS_SINCE_LAST_WRITE_FOR_MAPPING)
+    return false;
+
+  this->mappedData = this->srcFile.map(0, fileSize);
+  if (this->mappedData == nullptr)
+    return false;
+  this->mappedSize         = fileSize;
+  this->mappedLastModified = lastModified;
+  this->mappedFileChanged  = false;
+
+#ifdef Q_OS_UNIX
+  // We mostly read frame after frame
+  ::madvise(this->mappedData, size_t(this->mappedSize), MADV_SEQUENTIAL);
+#endif
+
+  return true;
+}
+
+bool FileSource::isMemoryMapped() const
+{
+  QReadLocker locker(&this->fileAccessLock);
+  return this->mappedData != nullptr;
+}
+
+void FileSource::unmapFileIfChanged()
+{
+  {
+    QReadLocker locker(&this->fileAccessLock);
+    if (this->mappedData == nullptr)
+      return;
+
+    // Copying from a mapping of a file that was truncated crashes (SIGBUS). Check the file first.
+    const QFileInfo currentFileInfo(this->srcFile.fileName());
+    if (!this->mappedFileChanged && currentFileInfo.size() == this->mappedSize &&
+        currentFileInfo.lastModified() == this->mappedLastModified)
+      return;
+  }
+
+  QWriteLocker locker(&this->fileAccessLock);
+  if (this->mappedData == nullptr)
+    return;
+  this->srcFile.unmap(this->mappedData);
+  this->mappedData = nullptr;
+  this->mappedSize = 0;
+}
+
+void FileSource::adviseWillNeed(int64_t startPos, int64_t nrBytes)
+{
+#ifdef Q_OS_UNIX
+  QReadLocker locker(&this->fileAccessLock);
+  if (this->mappedData == nullptr || startPos >= this->mappedSize || nrBytes <= 0)
+    return;
+
+  // madvise needs a page aligned start address
+  static const auto pageSize = int64_t(::sysconf(_SC_PAGESIZE));
+  const auto        start    = std::max(int64_t(0), startPos) / pageSize * pageSize;
+  const auto        end      = std::min(startPos + nrBytes, this->mappedSize);
+  ::madvise(this->mappedData + start, size_t(end - start), MADV_WILLNEED);
+#else
+  (void)startPos;
+  (void)nrBytes;
+#endif
+}
+
+int64_t FileSource::readAt(char *data, int64_t startPos, int64_t nrBytes)
+{
+  if (startPos < 0 || nrBytes <= 0)
+    return 0;
+
+  this->unmapFileIfChanged();
+
+  // The part of the range that is within the mapping is copied from there. The data is always
+  // copied so that the mapping can be released at any time.
+  int64_t bytesFromMapping = 0;
+  {
+    QReadLocker readLocker(&this->fileAccessLock);
+
+    if (this->mappedData != nullptr && startPos < this->mappedSize)
+    {
+      bytesFromMapping = std::min(nrBytes, this->mappedSize - startPos);
+      std::memcpy(data, this->mappedData + startPos, size_t(bytesFromMapping));
+      if (bytesFromMapping == nrBytes)
+        return bytesFromMapping;
+    }
+  }
+
+  return bytesFromMapping +
+         this->readAtFromFile(
+             data + bytesFromMapping, startPos + bytesFromMapping, nrBytes - bytesFromMapping);
+}
+
+int64_t FileSource::readAtFromFile(char *data, int64_t startPos, int64_t nrBytes)
+{
+  {
+    QReadLocker readLocker(&this->fileAccessLock);
+
+#if defined(Q_OS_UNIX)
+    const auto fileDescriptor = this->srcFile.handle();
+    if (fileDescriptor >= 0)
+    {
+      int64_t totalBytesRead = 0;
+      while (totalBytesRead < nrBytes)
+      {
+        const auto bytesRead = ::pread(fileDescriptor,
+                                       data + totalBytesRead,
+                                       size_t(nrBytes - totalBytesRead),
+                                       off_t(startPos + totalBytesRead));
+        if (bytesRead < 0 && errno == EINTR)
+          continue;
+        if (bytesRead <= 0)
+          break;
+        totalBytesRead += bytesRead;
+      }
+      return totalBytesRead;
+    }
+#elif defined(Q_OS_WIN)
+    const auto fileDescriptor = this->srcFile.handle();
+    const auto fileHandle =
+        (fileDescriptor >= 0) ? HANDLE(_get_osfhandle(fileDescriptor)) : INVALID_HANDLE_VALUE;
+    if (fileHandle != INVALID_HANDLE_VALUE)
+    {
+      int64_t totalBytesRead = 0;
+      while (totalBytesRead < nrBytes)
+      {
+        // For files that are not opened for asynchronous IO, the offset in the OVERLAPPED struct
+        // is used as the read position and the call blocks until the read is done.
+        const auto position   = startPos + totalBytesRead;
+        OVERLAPPED overlapped = {};
+        overlapped.Offset     = DWORD(position & 0xffffffff);
+        overlapped.OffsetHigh = DWORD(position >> 32);
+
+        const auto bytesToRead = DWORD(std::min(nrBytes - totalBytesRead, int64_t(1) << 30));
+        DWORD      bytesRead   = 0;
+        if (!ReadFile(fileHandle, data + totalBytesRead, bytesToRead, &bytesRead, &overlapped) ||
+            bytesRead == 0)
+          break;
+        totalBytesRead += bytesRead;
+      }
+      return totalBytesRead;
+    }
+#endif
+  }
+
   // lock the seek and read function
-  QMutexLocker locker(&this->readMutex);
+  QWriteLocker locker(&this->fileAccessLock);
   this->srcFile.seek(startPos);
-  return this->srcFile.read(targetBuffer.data(), nrBytes);
+  return this->srcFile.read(data, nrBytes);
+}
+
+void FileSource::fileSystemWatcherFileChanged(const QString &)
+{
+  this->fileChanged       = true;
+  this->mappedFileChanged = true;
 }
 
 QList<InfoItem> FileSource::getFileInfoList() const
@@ -192,8 +377,11 @@ void FileSource::clearFileCache()
   // We will close the QFile, open it using the FILE_FLAG_NO_BUFFERING flags, close it and reopen
   // the QFile. Suggested:
   // http://stackoverflow.com/questions/478340/clear-file-cache-to-repeat-performance-testing
-  QMutexLocker locker(&this->readMutex);
+  QWriteLocker locker(&this->fileAccessLock);
+  // Closing the file also removes the mapping. Reading falls back to the file afterwards.
   this->srcFile.close();
+  this->mappedData = nullptr;
+  this->mappedSize = 0;
 
   LPCWSTR file = (const wchar_t *)this->fullFilePath.utf16();
   HANDLE  hFile =
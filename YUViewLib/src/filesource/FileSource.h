@@ -32,17 +32,21 @@
 
 #pragma once
 
+#include <QDateTime>
 #include <QFile>
 #include <QFileInfo>
 #include <QFileSystemWatcher>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QReadWriteLock>
 #include <QString>
 
 #include <common/FileInfo.h>
 #include <common/EnumMapper.h>
 #include <common/Typedef.h>
 
+#include <atomic>
+
 enum class InputFormat
 {
   Invalid = -1,
@@ -85,17 +89,35 @@ public:
   virtual bool atEnd() const { return !this->isFileOpened ? true : this->srcFile.atEnd(); }
   QByteArray   readLine() { return !this->isFileOpened ? QByteArray() : this->srcFile.readLine(); }
   virtual bool seek(int64_t pos) { return !this->isFileOpened ? false : this->srcFile.seek(pos); }
-  int64_t      pos() { return !this->isFileOpened ? 0 : this->srcFile.pos(); }
+
+  virtual int64_t pos() { return !this->isFileOpened ? 0 : this->srcFile.pos(); }
 
   // Get the file size in bytes
 
   // Read the given number of bytes starting at startPos into the QByteArray out
   // Resize the QByteArray if necessary. Return how many bytes were read.
+  // This is thread safe. The read is positional (it does not use or change the current position
+  // in the file) so multiple threads can read from the same file at the same time.
   int64_t readBytes(QByteArray &targetBuffer, int64_t startPos, int64_t nrBytes);
 #if SSE_CONVERSION
   void readBytes(byteArrayAligned &data, int64_t startPos, int64_t nrBytes);
 #endif
 
+  // Map the whole file into memory. While the file is mapped, readBytes copies from the mapping.
+  // Mapping fails if the file does not fit into the address space (e.g. big files in 32 bit
+  // builds) or if it was modified in the last MIN_SECONDS_SINCE_LAST_WRITE_FOR_MAPPING seconds (it
+  // may still be written to). In this case, reading falls back to the normal file access. Data
+  // that was appended to the file after it was mapped is read from the file. If the file changes
+  // (the file watcher reports it or the size or modification time differ), the mapping is released
+  // before the next read. No references to the mapped data are handed out, so this is safe.
+  // The mapping is also released when the file is (re)opened.
+  bool mapFileToMemory();
+  bool isMemoryMapped() const;
+
+  // Tell the OS that the given range of the mapped file will be needed soon so that it can
+  // start reading it in the background. Only supported for mapped files on unix.
+  void adviseWillNeed(int64_t startPos, int64_t nrBytes);
+
   static QString getAbsPathFromAbsAndRel(const QString &currentPath,
                                          const QString &absolutePath,
                                          const QString &relativePath);
@@ -104,7 +126,7 @@ public:
   void clearFileCache();
 
 private slots:
-  void fileSystemWatcherFileChanged(const QString &) { fileChanged = true; }
+  void fileSystemWatcherFileChanged(const QString &);
 
 protected:
   QString   fullFilePath{};
@@ -113,8 +135,25 @@ protected:
   bool      isFileOpened{};
 
 private:
+  static constexpr int64_t MIN_SECONDS_SINCE_LAST_WRITE_FOR_MAPPING = 60;
+
+  // Read from the mapping (if the range is mapped) or the file
+  int64_t readAt(char *data, int64_t startPos, int64_t nrBytes);
+  // Release the mapping if the file was changed since it was mapped
+  void unmapFileIfChanged();
+  // Positional read (pread on unix, ReadFile with an offset on windows). If this is not available,
+  // fall back to seek and read (which has to be locked).
+  int64_t readAtFromFile(char *data, int64_t startPos, int64_t nrBytes);
+
   QFileSystemWatcher fileWatcher{};
   bool               fileChanged{};
 
-  QMutex readMutex;
+  // Positional reads can run in parallel (read lock). Reopening the file or the seek and read
+  // fallback need exclusive access (write lock).
+  mutable QReadWriteLock fileAccessLock;
+
+  uchar            *mappedData{};
+  int64_t           mappedSize{};
+  QDateTime         mappedLastModified{};
+  std::atomic<bool> mappedFileChanged{};
 };
@@ -32,6 +32,12 @@
 
 #include "FileSourceAnnexBFile.h"
 
+#include <QSettings>
+
+#if SIMD_X86
+#include <immintrin.h>
+#endif
+
 #define ANNEXBFILE_DEBUG_OUTPUT 0
 #if ANNEXBFILE_DEBUG_OUTPUT && !NDEBUG
 #include <QDebug>
@@ -41,11 +47,103 @@
 #endif
 
 const auto BUFFERSIZE = 500000;
-const auto STARTCODE = QByteArrayLiteral("\x00\x00\x01");
+
+namespace
+{
+
+int64_t findStartCodeScalar(const char *data, int64_t startPos, int64_t size)
+{
+  for (auto pos = startPos; pos + 2 < size; pos++)
+  {
+    // Most bytes are not zero. Skip two bytes if the third byte can not be the end of a start code.
+    if (static_cast<unsigned char>(data[pos + 2]) > 1)
+      pos += 2;
+    else if (data[pos] == 0 && data[pos + 1] == 0 && data[pos + 2] == 1)
+      return pos;
+  }
+  return -1;
+}
+
+#if SIMD_X86
+
+inline unsigned countTrailingZeros(unsigned value)
+{
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, value);
+  return unsigned(index);
+#else
+  return unsigned(__builtin_ctz(value));
+#endif
+}
+
+// Compare 16 (or 32) positions at once. For every position, the three loads contain the byte at
+// that position and the two following bytes.
+SIMD_TARGET_SSE4_1 int64_t findStartCodeSSE4_1(const char *data, int64_t size)
+{
+  const auto zero = _mm_setzero_si128();
+  const auto one  = _mm_set1_epi8(1);
+
+  int64_t pos = 0;
+  for (; pos + 18 <= size; pos += 16)
+  {
+    const auto byte0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+    const auto byte1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos + 1));
+    const auto byte2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos + 2));
+    const auto isStartCode =
+        _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(byte0, zero), _mm_cmpeq_epi8(byte1, zero)),
+                      _mm_cmpeq_epi8(byte2, one));
+    const auto mask = unsigned(_mm_movemask_epi8(isStartCode));
+    if (mask != 0)
+      return pos + countTrailingZeros(mask);
+  }
+  return findStartCodeScalar(data, pos, size);
+}
+
+SIMD_TARGET_AVX2 int64_t findStartCodeAVX2(const char *data, int64_t size)
+{
+  const auto zero = _mm256_setzero_si256();
+  const auto one  = _mm256_set1_epi8(1);
+
+  int64_t pos = 0;
+  for (; pos + 34 <= size; pos += 32)
+  {
+    const auto byte0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos));
+    const auto byte1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos + 1));
+    const auto byte2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos + 2));
+    const auto isStartCode = _mm256_and_si256(
+        _mm256_and_si256(_mm256_cmpeq_epi8(byte0, zero), _mm256_cmpeq_epi8(byte1, zero)),
+        _mm256_cmpeq_epi8(byte2, one));
+    const auto mask = unsigned(_mm256_movemask_epi8(isStartCode));
+    if (mask != 0)
+      return pos + countTrailingZeros(mask);
+  }
+  return findStartCodeScalar(data, pos, size);
+}
+
+#endif
+
+} // namespace
 
 FileSourceAnnexBFile::FileSourceAnnexBFile()
 {
-  this->fileBuffer.resize(BUFFERSIZE);
+  QSettings settings;
+  this->useMemoryMapping = settings.value("MemoryMapRawFiles", false).toBool();
+}
+
+int64_t FileSourceAnnexBFile::findStartCode(const char                *data,
+                                            int64_t                    size,
+                                            const simd::InstructionSet instructionSet)
+{
+#if SIMD_X86
+  if (instructionSet == simd::InstructionSet::AVX2)
+    return findStartCodeAVX2(data, size);
+  if (instructionSet == simd::InstructionSet::SSE4_1)
+    return findStartCodeSSE4_1(data, size);
+#else
+  (void)instructionSet;
+#endif
+  return findStartCodeScalar(data, 0, size);
 }
 
 // Open the file and fill the read buffer. 
@@ -53,11 +151,19 @@ bool FileSourceAnnexBFile::openFile(const QString &fileName)
 {
   DEBUG_ANNEXBFILE("FileSourceAnnexBFile::openFile fileName " << fileName);
 
+  this->bufferStartPosInFile = 0;
+  this->posInBuffer          = 0;
+
   // Open the input file (again)
   FileSource::openFile(fileName);
 
+  // If the file is mapped, the buffer is copied from the mapping instead of reading it
+  if (this->useMemoryMapping)
+    this->mapFileToMemory();
+
   // Fill the buffer
-  this->fileBufferSize = srcFile.read(this->fileBuffer.data(), BUFFERSIZE);
+  this->fileBuffer.resize(BUFFERSIZE);
+  this->fileBufferSize = uint64_t(this->readBytes(this->fileBuffer, 0, BUFFERSIZE));
   if (this->fileBufferSize == 0)
     // The file is empty of there was an error reading from the file.
     return false;
@@ -69,12 +175,22 @@ bool FileSourceAnnexBFile::openFile(const QString &fileName)
 
 bool FileSourceAnnexBFile::atEnd() const
 { 
-  return this->fileBufferSize < BUFFERSIZE && this->posInBuffer >= int64_t(this->fileBufferSize);
+  return this->isLastBuffer() && this->posInBuffer >= int64_t(this->fileBufferSize);
+}
+
+int64_t FileSourceAnnexBFile::pos()
+{
+  return int64_t(this->bufferStartPosInFile) + std::max(this->posInBuffer, int64_t(0));
+}
+
+bool FileSourceAnnexBFile::isLastBuffer() const
+{
+  return this->fileBufferSize < BUFFERSIZE;
 }
 
 void FileSourceAnnexBFile::seekToFirstNAL()
 {
-  auto nextStartCodePos = this->fileBuffer.indexOf(STARTCODE);
+  auto nextStartCodePos = findStartCode(this->fileBuffer.constData(), this->fileBufferSize);
   if (nextStartCodePos < 0)
     // The first buffer does not contain a start code. This is very unusual. Use the normal getNextNALUnit to seek
     this->getNextNALUnit();
@@ -91,6 +207,16 @@ void FileSourceAnnexBFile::seekToFirstNAL()
   this->nrBytesBeforeFirstNAL = this->bufferStartPosInFile + uint64_t(this->posInBuffer);
 }
 
+void FileSourceAnnexBFile::appendToReturnArray(int64_t startPos, int64_t endPos)
+{
+  // The start position may be negative if the start code was in the last buffer
+  startPos = std::max(startPos, int64_t(0));
+  if (endPos <= startPos)
+    return;
+
+  this->lastReturnArray.append(this->fileBuffer.constData() + startPos, int(endPos - startPos));
+}
+
 QByteArray FileSourceAnnexBFile::getNextNALUnit(bool getLastDataAgain, pairUint64 *startEndPosInFile)
 {
   if (getLastDataAgain)
@@ -101,7 +227,7 @@ QByteArray FileSourceAnnexBFile::getNextNALUnit(bool getLastDataAgain, pairUint6
   if (startEndPosInFile)
     startEndPosInFile->first = this->bufferStartPosInFile + uint64_t(this->posInBuffer);
 
-  int nextStartCodePos = -1;
+  int64_t nextStartCodePos = -1;
   int searchOffset = 3;
   bool startCodeFound = false;
   while (!startCodeFound)
@@ -112,18 +238,27 @@ QByteArray FileSourceAnnexBFile::getNextNALUnit(bool getLastDataAgain, pairUint6
       const auto nrZeroBytesMissing = std::abs(this->posInBuffer);
       this->lastReturnArray.append(nrZeroBytesMissing, char(0));
     }
-    nextStartCodePos = this->fileBuffer.indexOf(STARTCODE, this->posInBuffer + searchOffset);
 
-    if (nextStartCodePos < 0 || (uint64_t)nextStartCodePos > this->fileBufferSize)
+    nextStartCodePos     = -1;
+    const auto searchPos = this->posInBuffer + searchOffset;
+    if (searchPos < int64_t(this->fileBufferSize))
+    {
+      const auto startCodeOffset = findStartCode(this->fileBuffer.constData() + searchPos,
+                                                 int64_t(this->fileBufferSize) - searchPos);
+      if (startCodeOffset >= 0)
+        nextStartCodePos = searchPos + startCodeOffset;
+    }
+
+    if (nextStartCodePos < 0)
     {
       // No start code found ... append all data in the current buffer.
-      this->lastReturnArray += this->fileBuffer.mid(this->posInBuffer, this->fileBufferSize - this->posInBuffer);
+      this->appendToReturnArray(this->posInBuffer, this->fileBufferSize);
       DEBUG_ANNEXBFILE("FileSourceHEVCAnnexBFile::getNextNALUnit no start code found - ret size " << this->lastReturnArray.size());
 
-      if (this->fileBufferSize < BUFFERSIZE)
+      if (this->isLastBuffer())
       {
         // We are out of file and could not find a next position
-        this->posInBuffer = BUFFERSIZE;
+        this->posInBuffer = this->fileBufferSize;
         if (startEndPosInFile)
           startEndPosInFile->second = this->bufferStartPosInFile + this->fileBufferSize - 1;
         return this->lastReturnArray;
@@ -170,7 +305,7 @@ QByteArray FileSourceAnnexBFile::getNextNALUnit(bool getLastDataAgain, pairUint6
     {
       // Start code found. Check if the start code is 001 or 0001
       startCodeFound = true;
-      if (this->fileBuffer.at(nextStartCodePos - 1) == (char)0)
+      if (nextStartCodePos > 0 && this->fileBuffer.at(nextStartCodePos - 1) == (char)0)
         nextStartCodePos--;
     }
   }
@@ -178,8 +313,7 @@ QByteArray FileSourceAnnexBFile::getNextNALUnit(bool getLastDataAgain, pairUint6
   // Position found
   if (startEndPosInFile)
     startEndPosInFile->second = this->bufferStartPosInFile + nextStartCodePos;
-  if (nextStartCodePos > int(this->posInBuffer))
-    this->lastReturnArray += this->fileBuffer.mid(this->posInBuffer, nextStartCodePos - this->posInBuffer);
+  this->appendToReturnArray(this->posInBuffer, nextStartCodePos);
   this->posInBuffer = nextStartCodePos;
   DEBUG_ANNEXBFILE("FileSourceAnnexBFile::getNextNALUnit start code found - ret size " << this->lastReturnArray.size());
   return this->lastReturnArray;
@@ -227,7 +361,8 @@ bool FileSourceAnnexBFile::updateBuffer()
   // Save the position of the first byte in this new buffer
   this->bufferStartPosInFile += this->fileBufferSize;
 
-  this->fileBufferSize = srcFile.read(this->fileBuffer.data(), BUFFERSIZE);
+  this->fileBufferSize =
+      uint64_t(this->readBytes(this->fileBuffer, int64_t(this->bufferStartPosInFile), BUFFERSIZE));
   this->posInBuffer = 0;
 
   DEBUG_ANNEXBFILE("FileSourceAnnexBFile::updateBuffer this->fileBufferSize " << this->fileBufferSize);
@@ -240,9 +375,8 @@ bool FileSourceAnnexBFile::seek(int64_t pos)
     return false;
 
   DEBUG_ANNEXBFILE("FileSourceAnnexBFile::seek to " << pos);
-  // Seek the file and update the buffer
-  srcFile.seek(pos);
-  this->fileBufferSize = srcFile.read(this->fileBuffer.data(), BUFFERSIZE);
+  // Update the buffer
+  this->fileBufferSize = uint64_t(this->readBytes(this->fileBuffer, pos, BUFFERSIZE));
   if (this->fileBufferSize == 0)
     // The file is empty of there was an error reading from the file.
     return false;
@@ -254,9 +388,11 @@ bool FileSourceAnnexBFile::seek(int64_t pos)
   else
   {
     // Check if we are at a start code position (001 or 0001)
-    if (this->fileBuffer.at(0) == (char)0 && this->fileBuffer.at(1) == (char)0 && this->fileBuffer.at(2) == (char)0 && this->fileBuffer.at(3) == (char)1)
+    const auto remainingBytes = int64_t(this->fileBufferSize) - this->posInBuffer;
+    const auto data = this->fileBuffer.constData() + this->posInBuffer;
+    if (remainingBytes >= 4 && data[0] == (char)0 && data[1] == (char)0 && data[2] == (char)0 && data[3] == (char)1)
       return true;
-    if (this->fileBuffer.at(0) == (char)0 && this->fileBuffer.at(1) == (char)0 && this->fileBuffer.at(2) == (char)1)
+    if (remainingBytes >= 3 && data[0] == (char)0 && data[1] == (char)0 && data[2] == (char)1)
       return true;
 
     DEBUG_ANNEXBFILE("FileSourceAnnexBFile::seek could not find start code at seek position");
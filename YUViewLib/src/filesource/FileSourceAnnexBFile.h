@@ -32,14 +32,15 @@
 
 #pragma once
 
+#include <common/SIMD.h>
 #include <common/Typedef.h>
 #include <filesource/FileSource.h>
 
 /* This class is a normal FileSource for opening of raw AnnexBFiles.
  * Basically it understands that this is a binary file where each unit starts with a start code
  * (0x0000001)
- * TODO: The reading / parsing could be performed in a background thread in order to increase the
- * performance
+ * The file is read in blocks. If enabled in the settings, the file is mapped into memory and the
+ * blocks are copied from the mapping.
  */
 class FileSourceAnnexBFile : public FileSource
 {
@@ -52,9 +53,16 @@ public:
 
   bool openFile(const QString &filePath) override;
 
+  // Override the memory mapping setting ("MemoryMapRawFiles"). Must be called before opening the
+  // file.
+  void setUseMemoryMapping(bool useMapping) { this->useMemoryMapping = useMapping; }
+
   // Is the file at the end?
   bool atEnd() const override;
 
+  // The position in the file of the next NAL unit
+  int64_t pos() override;
+
   // --- Retrieving of data from the file ---
   // You can either read a file NAL by NAL or frame by frame. Do not mix the two interfaces.
   // TODO: We could always use the second option, right? Also for the libde265 and HM decoder this
@@ -76,6 +84,13 @@ public:
 
   uint64_t getNrBytesBeforeFirstNAL() const { return this->nrBytesBeforeFirstNAL; }
 
+  // Get the position of the first start code (0x000001) in the given data. Return -1 if there is
+  // none. The search uses the given instruction set (if there is code for it in this build).
+  static int64_t
+  findStartCode(const char                *data,
+                int64_t                    size,
+                const simd::InstructionSet instructionSet = simd::getSupportedInstructionSet());
+
 protected:
   QByteArray fileBuffer;
   uint64_t   fileBufferSize{0}; ///< How many of the bytes are used? We don't resize the fileBuffer
@@ -91,6 +106,12 @@ protected:
   // load the next buffer
   bool updateBuffer();
 
+  // Is the end of the file in the current buffer?
+  bool isLastBuffer() const;
+
+  // Append the given range of the buffer to the lastReturnArray
+  void appendToReturnArray(int64_t startPos, int64_t endPos);
+
   // Seek to the first NAL header in the bitstream
   void seekToFirstNAL();
 
@@ -98,4 +119,6 @@ protected:
   QByteArray lastReturnArray;
 
   uint64_t nrBytesBeforeFirstNAL{0};
+
+  bool useMemoryMapping{false};
 };
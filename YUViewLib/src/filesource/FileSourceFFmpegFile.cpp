@@ -38,6 +38,7 @@
 
 #include <common/Formatting.h>
 #include <ffmpeg/AVCodecContextWrapper.h>
+#include <filesource/BitstreamIndex.h>
 #include <parser/AV1/obu_header.h>
 #include <parser/common/SubByteReaderLogging.h>
 
@@ -402,7 +403,8 @@ FileSourceFFmpegFile::~FileSourceFFmpegFile()
 bool FileSourceFFmpegFile::openFile(const QString &       filePath,
                                     QWidget *             mainWindow,
                                     FileSourceFFmpegFile *other,
-                                    bool                  parseFile)
+                                    bool                  parseFile,
+                                    const ScanResult *    scanResult)
 {
   // Check if the file exists
   this->fileInfo.setFile(filePath);
@@ -435,8 +437,12 @@ bool FileSourceFFmpegFile::openFile(const QString &       filePath,
   }
   else if (parseFile)
   {
-    if (!this->scanBitstream(mainWindow))
-      return false;
+    if ((scanResult == nullptr || !this->useScanResult(*scanResult)) && !this->loadBitstreamIndex())
+    {
+      if (!this->scanBitstreamWithProgressDialog(mainWindow))
+        return false;
+      this->saveBitstreamIndex();
+    }
 
     this->seekFileToBeginning();
   }
@@ -478,25 +484,54 @@ std::pair<int64_t, size_t> FileSourceFFmpegFile::getClosestSeekableFrameBefore(i
   return {bestSeekDTS, seekToFrameIdx};
 }
 
-bool FileSourceFFmpegFile::scanBitstream(QWidget *mainWindow)
+std::vector<size_t> FileSourceFFmpegFile::getKeyFrameIndices() const
+{
+  std::vector<size_t> keyFrames;
+  for (const auto &pic : this->keyFrameList)
+    keyFrames.push_back(pic.frame);
+  return keyFrames;
+}
+
+std::optional<FileSourceFFmpegFile::ScanResult>
+FileSourceFFmpegFile::scanFile(const QString &             filePath,
+                               const ScanProgressCallback &progressCallback)
+{
+  FileSourceFFmpegFile file;
+  file.openFileAndFindVideoStream(filePath);
+  if (!file.isFileOpened)
+    return {};
+  file.fullFilePath = filePath;
+
+  if (!file.loadBitstreamIndex())
+  {
+    if (!file.scanBitstream(progressCallback))
+      return {};
+    file.saveBitstreamIndex();
+  }
+
+  return ScanResult{file.video_stream.getIndex(), file.nrFrames, file.keyFrameList};
+}
+
+bool FileSourceFFmpegFile::useScanResult(const ScanResult &scanResult)
+{
+  // The video stream that is used depends on the ffmpeg version
+  if (scanResult.videoStreamIndex != this->video_stream.getIndex() ||
+      scanResult.keyFrameList.isEmpty())
+    return false;
+
+  this->nrFrames     = scanResult.nrFrames;
+  this->keyFrameList = scanResult.keyFrameList;
+  return true;
+}
+
+bool FileSourceFFmpegFile::scanBitstream(const ScanProgressCallback &progressCallback)
 {
   if (!this->isFileOpened)
     return false;
 
-  // Create the dialog (if the given pointer is not null)
   auto maxPTS = this->getMaxTS();
-  // Updating the dialog (setValue) is quite slow. Only do this if the percent value changes.
-  int                              curPercentValue = 0;
-  std::unique_ptr<QProgressDialog> progress;
-  if (mainWindow != nullptr)
-  {
-    progress.reset(
-        new QProgressDialog("Parsing (indexing) bitstream...", "Cancel", 0, 100, mainWindow));
-    progress->setMinimumDuration(1000); // Show after 1s
-    progress->setAutoClose(false);
-    progress->setAutoReset(false);
-    progress->setWindowModality(Qt::WindowModal);
-  }
+  // Only report the progress if the percent value changes.
+  int curPercentValue = 0;
 
   this->nrFrames = 0;
   while (this->goToNextPacket(true))
@@ -510,16 +545,13 @@ bool FileSourceFFmpegFile::scanBitstream(QWidget *mainWindow)
     if (this->currentPacket.getFlagKeyframe())
       this->keyFrameList.append(pictureIdx(this->nrFrames, this->currentPacket.getDTS()));
 
-    if (progress && progress->wasCanceled())
-      return false;
-
     int newPercentValue = 0;
     if (maxPTS != 0)
       newPercentValue = functions::clip(int(this->currentPacket.getPTS() * 100 / maxPTS), 0, 100);
     if (newPercentValue != curPercentValue)
     {
-      if (progress)
-        progress->setValue(newPercentValue);
+      if (progressCallback && !progressCallback(newPercentValue))
+        return false;
       curPercentValue = newPercentValue;
     }
 
@@ -529,7 +561,74 @@ bool FileSourceFFmpegFile::scanBitstream(QWidget *mainWindow)
   DEBUG_FFMPEG("FileSourceFFmpegFile::scanBitstream: Scan done. Found %d frames and %d keyframes.",
                this->nrFrames,
                this->keyFrameList.length());
-  return !progress->wasCanceled();
+  return true;
+}
+
+bool FileSourceFFmpegFile::scanBitstreamWithProgressDialog(QWidget *mainWindow)
+{
+  if (mainWindow == nullptr)
+    return this->scanBitstream({});
+
+  QProgressDialog progress("Parsing (indexing) bitstream...", "Cancel", 0, 100, mainWindow);
+  progress.setMinimumDuration(1000); // Show after 1s
+  progress.setAutoClose(false);
+  progress.setAutoReset(false);
+  progress.setWindowModality(Qt::WindowModal);
+
+  // Updating the dialog (setValue) is quite slow. This is only called if the percent value changes.
+  return this->scanBitstream([&progress](int percent) {
+    progress.setValue(percent);
+    return !progress.wasCanceled();
+  });
+}
+
+bool FileSourceFFmpegFile::loadBitstreamIndex()
+{
+  if (!BitstreamIndex::isEnabled())
+    return false;
+
+  BitstreamIndex index;
+  if (!index.load(this->fullFilePath, "FFmpeg"))
+    return false;
+
+  // The video stream that is used depends on the ffmpeg version
+  if (index.readInt() != this->video_stream.getIndex())
+    return false;
+
+  const auto        nrFrames = size_t(index.readUInt());
+  QList<pictureIdx> keyFrames;
+  const auto        nrKeyFrames = index.readCount();
+  for (uint64_t i = 0; i < nrKeyFrames && index.isValid(); i++)
+  {
+    const auto frame = size_t(index.readUInt());
+    keyFrames.append(pictureIdx(frame, index.readInt()));
+  }
+  if (!index.isValid() || !index.atEnd() || keyFrames.isEmpty())
+    return false;
+
+  this->nrFrames     = nrFrames;
+  this->keyFrameList = keyFrames;
+  DEBUG_FFMPEG("FileSourceFFmpegFile::loadBitstreamIndex Loaded %d frames and %d keyframes.",
+               this->nrFrames,
+               this->keyFrameList.length());
+  return true;
+}
+
+void FileSourceFFmpegFile::saveBitstreamIndex()
+{
+  if (!BitstreamIndex::isEnabled() || this->keyFrameList.isEmpty())
+    return;
+
+  BitstreamIndex index;
+  index.writeInt(this->video_stream.getIndex());
+  index.writeUInt(this->nrFrames);
+  index.writeCount(uint64_t(this->keyFrameList.size()));
+  for (const auto &pic : this->keyFrameList)
+  {
+    index.writeUInt(pic.frame);
+    index.writeInt(pic.dts);
+  }
+  index.save(this->fullFilePath, "FFmpeg");
 }
 
 void FileSourceFFmpegFile::openFileAndFindVideoStream(QString fileName)
@@ -41,6 +41,9 @@
 #include <video/rgb/videoHandlerRGB.h>
 #include <video/yuv/videoHandlerYUV.h>
 
+#include <functional>
+#include <optional>
+
 /* This class can use the ffmpeg libraries (libavcodec) to read from any packetized file.
  */
 class FileSourceFFmpegFile : public QObject
@@ -52,12 +55,41 @@ public:
   FileSourceFFmpegFile(const QString &filePath) : FileSourceFFmpegFile() { openFile(filePath); }
   ~FileSourceFFmpegFile();
 
+  // Struct for navigation. We index frames by frame number and FFMpeg uses the pts.
+  // This connects both values.
+  struct pictureIdx
+  {
+    pictureIdx(size_t frame, int64_t dts) : frame(frame), dts(dts) {}
+    size_t  frame;
+    int64_t dts;
+  };
+
+  // The result of scanning the bitstream (number of frames and key frames)
+  struct ScanResult
+  {
+    int               videoStreamIndex{-1};
+    size_t            nrFrames{};
+    QList<pictureIdx> keyFrameList;
+  };
+
   // Load the ffmpeg libraries and try to open the file. The FileSource will install a watcher for
-  // the file. Return false if anything goes wrong.
+  // the file. If a scan result (see scanFile) is given, it is used instead of scanning the
+  // bitstream. Return false if anything goes wrong.
   bool openFile(const QString &       filePath,
                 QWidget *             mainWindow = nullptr,
                 FileSourceFFmpegFile *other      = nullptr,
-                bool                  parseFile  = true);
+                bool                  parseFile  = true,
+                const ScanResult *    scanResult = nullptr);
+
+  // Progress (in percent) of scanning the bitstream. Scanning is aborted if false is returned.
+  using ScanProgressCallback = std::function<bool(int)>;
+
+  // Scan the bitstream of the file (or load the bitstream index if there is one) so that opening
+  // the file does not have to scan it again. The bitstream index is saved if this is enabled. This
+  // can be called from any thread. Return nothing if the file could not be opened or the scan was
+  // aborted.
+  static std::optional<ScanResult> scanFile(const QString &             filePath,
+                                            const ScanProgressCallback &progressCallback);
 
   // Is the file at the end?
   // TODO: How do we do this?
@@ -123,6 +155,8 @@ public:
   // the given frameIdx where we can start decoding
   // Return: POC and frame index
   std::pair<int64_t, size_t> getClosestSeekableFrameBefore(int frameIdx) const;
+  // Get the frame indices of all key frames (the frames that we can seek to)
+  std::vector<size_t> getKeyFrameIndices() const;
 
   QStringList getFFmpegLoadingLog() const { return ff.getLog(); }
 
@@ -177,19 +211,19 @@ protected:
 
   // In order to translate from frames to PTS, we need to count the frames and keep a list of
   // the PTS values of keyframes that we can start decoding at.
-  // If a mainWindow pointer is given, open a progress dialog. Return true on success. False if the
-  // process was canceled.
-  bool   scanBitstream(QWidget *mainWindow);
+  // Return true on success. False if the process was canceled.
+  bool   scanBitstream(const ScanProgressCallback &progressCallback);
+  // If a mainWindow pointer is given, open a progress dialog while scanning.
+  bool   scanBitstreamWithProgressDialog(QWidget *mainWindow);
   size_t nrFrames{0};
 
-  // Private struct for navigation. We index frames by frame number and FFMpeg uses the pts.
-  // This connects both values.
-  struct pictureIdx
-  {
-    pictureIdx(size_t frame, int64_t dts) : frame(frame), dts(dts) {}
-    size_t  frame;
-    int64_t dts;
-  };
+  // The result of scanBitstream (number of frames and key frames) can be saved in a BitstreamIndex.
+  // If a valid index exists for the file, it is loaded and the scan is skipped.
+  bool loadBitstreamIndex();
+  void saveBitstreamIndex();
+
+  // Use the result of scanFile if it is valid for this file
+  bool useScanResult(const ScanResult &scanResult);
 
   FFmpeg::PacketDataFormat packetDataFormat{FFmpeg::PacketDataFormat::Unknown};
 
@@ -220,16 +220,13 @@ ParserAnnexBAVC::parseAndAddNALUnit(int
   // Use the given tree item. If it is not set, use the nalUnitMode (if active).
   // We don't set data (a name) for this item yet.
   // We want to parse the item and then set a good description.
-  std::shared_ptr<TreeItem> nalRoot;
-  if (parent)
-    nalRoot = parent->createChildItem();
-  else if (packetModel->rootItem)
-    nalRoot = packetModel->rootItem->createChildItem();
+  auto nalRoot    = this->createNALRootItem(parent);
+  auto syntaxRoot = this->getNALSyntaxItem(nalRoot);
 
-  if (nalRoot)
-    ParserAnnexB::logNALSize(data, nalRoot, nalStartEndPosFile);
+  if (syntaxRoot)
+    ParserAnnexB::logNALSize(data, syntaxRoot, nalStartEndPosFile);
 
-  reader::SubByteReaderLogging reader(data, nalRoot, "", getStartCodeOffset(data));
+  reader::SubByteReaderLogging reader(data, syntaxRoot, "", getStartCodeOffset(data));
 
   std::string specificDescription;
   auto        nalAVC = std::make_shared<NalUnitAVC>(nalID, nalStartEndPosFile);
@@ -587,7 +584,37 @@ ParserAnnexBAVC::parseAndAddNALUnit(int
   return parseResult;
 }
 
-std::optional<ParserAnnexB::SeekData> ParserAnnexBAVC::getSeekData(int iFrameNr)
+std::unique_ptr<ParserAnnexB> ParserAnnexBAVC::createParserWithCurrentState() const
+{
+  // SEI messages that are waiting for their parameter sets are logged when they are reparsed
+  if (!this->reparse_sei.empty())
+    return {};
+
+  auto parser                              = std::make_unique<ParserAnnexBAVC>();
+  parser->pocOfFirstRandomAccessFrame      = this->pocOfFirstRandomAccessFrame;
+  parser->firstPOCRandomAccess             = this->firstPOCRandomAccess;
+  parser->activeParameterSets              = this->activeParameterSets;
+  parser->last_picture_first_slice         = this->last_picture_first_slice;
+  parser->lastBufferingPeriodSEI           = this->lastBufferingPeriodSEI;
+  parser->lastPicTimingSEI                 = this->lastPicTimingSEI;
+  parser->newBufferingPeriodSEI            = this->newBufferingPeriodSEI;
+  parser->newPicTimingSEI                  = this->newPicTimingSEI;
+  parser->currentAUAssociatedSPS           = this->currentAUAssociatedSPS;
+  parser->currentAUPartitionASPS           = this->currentAUPartitionASPS;
+  parser->nextAUIsFirstAUInBufferingPeriod = this->nextAUIsFirstAUInBufferingPeriod;
+  parser->CpbDpbDelaysPresentFlag          = this->CpbDpbDelaysPresentFlag;
+  parser->curFrameData                     = this->curFrameData;
+  parser->auDelimiterDetector              = this->auDelimiterDetector;
+  parser->sizeCurrentAU                    = this->sizeCurrentAU;
+  parser->lastFramePOC                     = this->lastFramePOC;
+  parser->counterAU                        = this->counterAU;
+  parser->currentAUAllSlicesIntra          = this->currentAUAllSlicesIntra;
+  parser->currentAUSliceTypes              = this->currentAUSliceTypes;
+  parser->hrd                              = this->hrd;
+  return parser;
+}
+
+std::optional<ParserAnnexB::SeekData> ParserAnnexBAVC::getSeekDataFromNALUnits(int iFrameNr)
 {
   if (iFrameNr >= int(this->getNumberPOCs()) || iFrameNr < 0)
     return {};
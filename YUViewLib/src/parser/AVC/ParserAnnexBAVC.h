@@ -87,12 +87,14 @@ public:
                                  std::optional<pairUint64> nalStartEndPosFile = {},
                                  std::shared_ptr<TreeItem> parent             = nullptr) override;
 
-  std::optional<SeekData> getSeekData(int iFrameNr) override;
+  std::optional<SeekData> getSeekDataFromNALUnits(int iFrameNr) override;
   QByteArray              getExtradata() override;
   IntPair                 getProfileLevel() override;
   Ratio                   getSampleAspectRatio() override;
 
 protected:
+  std::unique_ptr<ParserAnnexB> createParserWithCurrentState() const override;
+
   // When we start to parse the bitstream we will remember the first RAP POC
   // so that we can disregard any possible RASL pictures.
   int firstPOCRandomAccess{INT_MAX};
@@ -157,7 +157,7 @@ video::yuv::PixelFormatYUV ParserAnnexBHEVC::getPixelFormat() const
   return {};
 }
 
-std::optional<ParserAnnexB::SeekData> ParserAnnexBHEVC::getSeekData(int iFrameNr)
+std::optional<ParserAnnexB::SeekData> ParserAnnexBHEVC::getSeekDataFromNALUnits(int iFrameNr)
 {
   if (iFrameNr >= int(this->getNumberPOCs()) || iFrameNr < 0)
     return {};
@@ -321,16 +321,13 @@ ParserAnnexBHEVC::parseAndAddNALUnit(int
   // Use the given tree item. If it is not set, use the nalUnitMode (if active).
   // Create a new TreeItem root for the NAL unit. We don't set data (a name) for this item
   // yet. We want to parse the item and then set a good description.
-  std::shared_ptr<TreeItem> nalRoot;
-  if (parent)
-    nalRoot = parent->createChildItem();
-  else if (packetModel->rootItem)
-    nalRoot = packetModel->rootItem->createChildItem();
+  auto nalRoot    = this->createNALRootItem(parent);
+  auto syntaxRoot = this->getNALSyntaxItem(nalRoot);
 
-  if (nalRoot)
-    ParserAnnexB::logNALSize(data, nalRoot, nalStartEndPosFile);
+  if (syntaxRoot)
+    ParserAnnexB::logNALSize(data, syntaxRoot, nalStartEndPosFile);
 
-  reader::SubByteReaderLogging reader(data, nalRoot, "", getStartCodeOffset(data));
+  reader::SubByteReaderLogging reader(data, syntaxRoot, "", getStartCodeOffset(data));
 
   std::stringstream specificDescription;
   auto              nalHEVC = std::make_shared<NalUnitHEVC>(nalID, nalStartEndPosFile);
@@ -664,4 +661,40 @@ ParserAnnexBHEVC::parseAndAddNALUnit(int
   return parseResult;
 }
 
+std::unique_ptr<ParserAnnexB> ParserAnnexBHEVC::createParserWithCurrentState() const
+{
+  // SEI messages that are waiting for their parameter sets are logged when they are reparsed
+  if (!this->reparse_sei.empty())
+    return {};
+
+  auto parser                              = std::make_unique<ParserAnnexBHEVC>();
+  parser->pocOfFirstRandomAccessFrame      = this->pocOfFirstRandomAccessFrame;
+  parser->maxPOCCount                      = this->maxPOCCount;
+  parser->pocCounterOffset                 = this->pocCounterOffset;
+  parser->firstAUInDecodingOrder           = this->firstAUInDecodingOrder;
+  parser->prevTid0PicSlicePicOrderCntLsb   = this->prevTid0PicSlicePicOrderCntLsb;
+  parser->prevTid0PicPicOrderCntMsb        = this->prevTid0PicPicOrderCntMsb;
+  parser->isRandomAccessSkip               = this->isRandomAccessSkip;
+  parser->firstPOCRandomAccess             = this->firstPOCRandomAccess;
+  parser->activeParameterSets              = this->activeParameterSets;
+  parser->lastFirstSliceSegmentInPic       = this->lastFirstSliceSegmentInPic;
+  parser->currentAUAssociatedSPS           = this->currentAUAssociatedSPS;
+  parser->lastBufferingPeriodSEI           = this->lastBufferingPeriodSEI;
+  parser->lastPicTimingSEI                 = this->lastPicTimingSEI;
+  parser->newBufferingPeriodSEI            = this->newBufferingPeriodSEI;
+  parser->newPicTimingSEI                  = this->newPicTimingSEI;
+  parser->nextAUIsFirstAUInBufferingPeriod = this->nextAUIsFirstAUInBufferingPeriod;
+  parser->curFrameFileStartEndPos          = this->curFrameFileStartEndPos;
+  parser->curFramePOC                      = this->curFramePOC;
+  parser->curFrameIsRandomAccess           = this->curFrameIsRandomAccess;
+  parser->curFrameLayerID                  = this->curFrameLayerID;
+  parser->auDelimiterDetector              = this->auDelimiterDetector;
+  parser->sizeCurrentAU                    = this->sizeCurrentAU;
+  parser->lastFramePOC                     = this->lastFramePOC;
+  parser->counterAU                        = this->counterAU;
+  parser->currentAUAllSlicesIntra          = this->currentAUAllSlicesIntra;
+  parser->currentAUSliceTypes              = this->currentAUSliceTypes;
+  return parser;
+}
+
 } // namespace parser
@@ -72,7 +72,7 @@ public:
   Size                       getSequenceSizeSamples() const override;
   video::yuv::PixelFormatYUV getPixelFormat() const override;
 
-  std::optional<SeekData> getSeekData(int iFrameNr) override;
+  std::optional<SeekData> getSeekDataFromNALUnits(int iFrameNr) override;
   QByteArray              getExtradata() override;
   IntPair                 getProfileLevel() override;
   Ratio                   getSampleAspectRatio() override;
@@ -84,6 +84,8 @@ public:
                                  std::shared_ptr<TreeItem> parent             = nullptr) override;
 
 protected:
+  std::unique_ptr<ParserAnnexB> createParserWithCurrentState() const override;
+
   // ----- Some nested classes that are only used in the scope of this file handler class
 
   // The PicOrderCntMsb may be reset to zero for IDR frames. In order to count the global POC, we
@@ -97,7 +99,7 @@ protected:
 
   // Is this NAL skipped because it is RASL (can not be decoded because of slicing/merging of the
   // bitstream)
-  bool isRandomAccessSkip;
+  bool isRandomAccessSkip{false};
 
   // When we start to parse the bitstream we will remember the first RAP POC
   // so that we can disregard any possible RASL pictures.
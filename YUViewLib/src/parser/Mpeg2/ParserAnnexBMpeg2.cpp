@@ -86,17 +86,14 @@ ParserAnnexBMpeg2::parseAndAddNALUnit(int
   // Use the given tree item. If it is not set, use the nalUnitMode (if active).
   // We don't set data (a name) for this item yet.
   // We want to parse the item and then set a good description.
-  std::string               specificDescription;
-  std::shared_ptr<TreeItem> nalRoot;
-  if (parent)
-    nalRoot = parent->createChildItem();
-  else if (packetModel->rootItem)
-    nalRoot = packetModel->rootItem->createChildItem();
+  std::string specificDescription;
+  auto        nalRoot    = this->createNALRootItem(parent);
+  auto        syntaxRoot = this->getNALSyntaxItem(nalRoot);
 
-  reader::SubByteReaderLogging reader(data, nalRoot, "", readOffset);
+  reader::SubByteReaderLogging reader(data, syntaxRoot, "", readOffset);
 
-  if (nalRoot)
-    ParserAnnexB::logNALSize(data, nalRoot, nalStartEndPosFile);
+  if (syntaxRoot)
+    ParserAnnexB::logNALSize(data, syntaxRoot, nalStartEndPosFile);
 
   // Create a nal_unit and read the header
   NalUnitMpeg2 nal_mpeg2(nalID, nalStartEndPosFile);
@@ -242,6 +239,24 @@ ParserAnnexBMpeg2::parseAndAddNALUnit(int
   return parseResult;
 }
 
+std::unique_ptr<ParserAnnexB> ParserAnnexBMpeg2::createParserWithCurrentState() const
+{
+  auto parser                         = std::make_unique<ParserAnnexBMpeg2>();
+  parser->pocOfFirstRandomAccessFrame = this->pocOfFirstRandomAccessFrame;
+  parser->firstSequenceExtension      = this->firstSequenceExtension;
+  parser->firstSequenceHeader         = this->firstSequenceHeader;
+  parser->sizeCurrentAU               = this->sizeCurrentAU;
+  parser->pocOffset                   = this->pocOffset;
+  parser->curFramePOC                 = this->curFramePOC;
+  parser->lastFramePOC                = this->lastFramePOC;
+  parser->counterAU                   = this->counterAU;
+  parser->lastAUStartBySequenceHeader = this->lastAUStartBySequenceHeader;
+  parser->currentAUAllSlicesIntra     = this->currentAUAllSlicesIntra;
+  parser->currentAUSliceCounts        = this->currentAUSliceCounts;
+  parser->lastPictureHeader           = this->lastPictureHeader;
+  return parser;
+}
+
 IntPair ParserAnnexBMpeg2::getProfileLevel()
 {
   if (firstSequenceExtension)
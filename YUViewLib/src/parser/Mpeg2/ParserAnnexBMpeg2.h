@@ -65,7 +65,7 @@ public:
                                  std::shared_ptr<TreeItem> parent             = {}) override;
 
   // TODO: Reading from raw mpeg2 streams not supported (yet? Is this even defined / possible?)
-  virtual std::optional<SeekData> getSeekData(int iFrameNr) override
+  virtual std::optional<SeekData> getSeekDataFromNALUnits(int iFrameNr) override
   {
     (void)iFrameNr;
     return {};
@@ -75,6 +75,8 @@ public:
   Ratio      getSampleAspectRatio() override;
 
 private:
+  std::unique_ptr<ParserAnnexB> createParserWithCurrentState() const override;
+
   // We will keep a pointer to the first sequence extension to be able to retrive some data
   std::shared_ptr<mpeg2::sequence_extension> firstSequenceExtension;
   std::shared_ptr<mpeg2::sequence_header>    firstSequenceHeader;
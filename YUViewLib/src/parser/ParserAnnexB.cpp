@@ -33,12 +33,19 @@
 #include "ParserAnnexB.h"
 
 #include <common/Formatting.h>
+#include <filesource/BitstreamIndex.h>
 #include <parser/common/SubByteReaderLogging.h>
 
 #include <QElapsedTimer>
 #include <QProgressDialog>
+#include <algorithm>
 #include <assert.h>
 
+// Frames are only reordered within a limited window (the decoded picture buffer holds at most 16
+// frames in AVC, HEVC and VVC). A frame which is parsed later can not be sorted before a frame
+// which is this many frames before it in coding order.
+#define MAX_REORDER_DISTANCE 32
+
 #define PARSERANNEXB_DEBUG_OUTPUT 0
 #if PARSERANNEXB_DEBUG_OUTPUT && !NDEBUG
 #include <QDebug>
@@ -50,6 +57,47 @@
 namespace parser
 {
 
+namespace
+{
+
+// The number of NAL units in one chunk (see ParserAnnexB::NALUnitChunk). A new chunk is only
+// started where the parser can create a copy of itself.
+constexpr auto NAL_UNITS_PER_CHUNK = 128u;
+
+// The number of NAL units whose syntax is kept in the packet model after it was loaded
+constexpr auto MAX_NR_LOADED_NAL_UNITS = 256u;
+
+struct NALUnitToParse
+{
+  int        nalID{};
+  ByteVector data;
+  pairUint64 startEndPosFile;
+};
+
+// Parse the NAL unit with logging. The item of the NAL unit is appended to the root item.
+void parseNALUnitWithLogging(ParserAnnexB &            parser,
+                             const NALUnitToParse &    nal,
+                             std::shared_ptr<TreeItem> rootItem)
+{
+  try
+  {
+    parser.parseAndAddNALUnit(nal.nalID, nal.data, {}, nal.startEndPosFile, rootItem);
+  }
+  catch (...)
+  {
+    // Just like in parseAnnexBFile, continue with the next NAL unit
+  }
+}
+
+} // namespace
+
+ParserAnnexB::ParserAnnexB(QObject *parent) : Parser(parent)
+{
+  this->packetModel->setChildItemLoader(
+      [this](size_t itemRow, TreeItem &item) { return this->loadNALUnitSyntax(itemRow, item); },
+      MAX_NR_LOADED_NAL_UNITS);
+}
+
 std::string ParserAnnexB::getShortStreamDescription(const int) const
 {
   std::ostringstream info;
@@ -65,8 +113,19 @@ bool ParserAnnexB::addFrameToList(int                       poc,
                                   bool                      randomAccessPoint,
                                   unsigned                  layerID)
 {
-  for (const auto &f : this->frameListCodingOrder)
-    if (f.poc == poc && f.layerID == layerID)
+  AnnexBFrame newFrame;
+  newFrame.poc               = poc;
+  newFrame.fileStartEndPos   = fileStartEndPos;
+  newFrame.randomAccessPoint = randomAccessPoint;
+  newFrame.layerID           = layerID;
+
+  // Frames are mostly added in increasing POC order so the search in the sorted list and the
+  // insertion are fast.
+  this->updateFrameListDisplayOrder();
+  const auto [samePOCBegin, samePOCEnd] = std::equal_range(
+      this->frameListDisplayOder.begin(), this->frameListDisplayOder.end(), newFrame);
+  for (auto it = samePOCBegin; it != samePOCEnd; it++)
+    if (it->layerID == layerID)
       return false;
 
   if (!this->pocOfFirstRandomAccessFrame && randomAccessPoint)
@@ -74,17 +133,91 @@ bool ParserAnnexB::addFrameToList(int                       poc,
   if (poc >= this->pocOfFirstRandomAccessFrame.value())
   {
     // We don't add frames which we can not decode because they are before the first RA (I) frame
-    AnnexBFrame newFrame;
-    newFrame.poc               = poc;
-    newFrame.fileStartEndPos   = fileStartEndPos;
-    newFrame.randomAccessPoint = randomAccessPoint;
-    newFrame.layerID           = layerID;
     this->frameListCodingOrder.push_back(newFrame);
-    this->frameListDisplayOder.clear();
+    this->frameListDisplayOder.insert(samePOCEnd, newFrame);
   }
   return true;
 }
 
+std::shared_ptr<TreeItem> ParserAnnexB::createNALRootItem(std::shared_ptr<TreeItem> parent) const
+{
+  if (parent)
+    return parent->createChildItem();
+  if (this->packetModel->rootItem)
+    return this->packetModel->rootItem->createChildItem();
+  return {};
+}
+
+std::shared_ptr<TreeItem> ParserAnnexB::getNALSyntaxItem(std::shared_ptr<TreeItem> nalRoot) const
+{
+  if (this->skipNALUnitSyntax)
+    return {};
+  return nalRoot;
+}
+
+bool ParserAnnexB::loadNALUnitSyntax(size_t itemRow, TreeItem &item)
+{
+  std::unique_lock<std::mutex> lock(this->syntaxMutex);
+
+  // Find the chunk of the NAL unit. If a chunk added no items, the next chunk starts at the same
+  // row, so take the last chunk that starts before (or at) the row.
+  auto chunkIt = std::upper_bound(this->nalUnitChunks.begin(),
+                                  this->nalUnitChunks.end(),
+                                  itemRow,
+                                  [](size_t row, const NALUnitChunk &chunk)
+                                  { return row < chunk.firstItemRow; });
+  if (chunkIt == this->nalUnitChunks.begin())
+    return false;
+  chunkIt--;
+
+  // Parse with a copy of the chunk parser so that the chunk can be parsed again later
+  auto parser = chunkIt->parser->createParserWithCurrentState();
+  if (!parser)
+    return false;
+
+  if (!this->syntaxFile)
+  {
+    this->syntaxFile = std::make_unique<FileSourceAnnexBFile>(this->syntaxFilePath);
+    if (!this->syntaxFile->isOk())
+    {
+      this->syntaxFile.reset();
+      return false;
+    }
+  }
+
+  // Parse the chunk just like a chunk parser would until the item of the NAL unit was created. The
+  // items of the NAL units before it are dropped.
+  auto chunkRoot   = std::make_shared<TreeItem>();
+  auto itemsToSkip = itemRow - chunkIt->firstItemRow;
+  for (const auto &nal : chunkIt->nalUnits)
+  {
+    if (!this->syntaxFile->seek(int64_t(nal.startEndPosFile.first)))
+      return false;
+    ByteVector nalData;
+    try
+    {
+      nalData =
+          reader::SubByteReaderLogging::convertToByteVector(this->syntaxFile->getNextNALUnit());
+    }
+    catch (...)
+    {
+      return false;
+    }
+    parseNALUnitWithLogging(*parser, {nal.nalID, nalData, nal.startEndPosFile}, chunkRoot);
+
+    if (chunkRoot->getNrChildItems() == 0)
+      continue;
+    if (itemsToSkip == 0)
+    {
+      item.appendChildItemsOf(*chunkRoot->getChild(0));
+      return true;
+    }
+    itemsToSkip--;
+    chunkRoot->clearChildItems();
+  }
+  return false;
+}
+
 void ParserAnnexB::logNALSize(const ByteVector &        data,
                               std::shared_ptr<TreeItem> root,
                               std::optional<pairUint64> nalStartEndPos)
@@ -103,9 +236,74 @@ void ParserAnnexB::logNALSize(const ByteVector &        data,
     root->createChildItem("Start/End pos", to_string(*nalStartEndPos));
 }
 
+size_t ParserAnnexB::getNumberPOCs() const
+{
+  auto lock = this->lockParsedData();
+  return this->frameListCodingOrder.size();
+}
+
+std::unique_lock<std::recursive_mutex> ParserAnnexB::lockParsedData() const
+{
+  return std::unique_lock<std::recursive_mutex>(this->parsedDataMutex);
+}
+
+size_t ParserAnnexB::getNumberFramesIndexed() const
+{
+  auto lock = this->lockParsedData();
+  if (this->parsingFinished)
+    return this->frameListCodingOrder.size();
+  if (this->frameListCodingOrder.size() <= MAX_REORDER_DISTANCE)
+    return 0;
+
+  // All frames parsed from now on will have a higher POC than the lowest POC of the last frames
+  // in coding order. So the frames before that in display order will not move anymore.
+  AnnexBFrame lowestRecentFrame;
+  lowestRecentFrame.poc = std::min_element(this->frameListCodingOrder.end() - MAX_REORDER_DISTANCE,
+                                           this->frameListCodingOrder.end())
+                              ->poc;
+  const auto &displayOrder = this->frameListDisplayOder;
+  return size_t(std::distance(
+      displayOrder.begin(),
+      std::lower_bound(displayOrder.begin(), displayOrder.end(), lowestRecentFrame)));
+}
+
+bool ParserAnnexB::isParsingFinished() const
+{
+  auto lock = this->lockParsedData();
+  return this->parsingFinished;
+}
+
+bool ParserAnnexB::waitForFrameIndexed(FrameIndexDisplayOrder frameIdx)
+{
+  auto lock = this->lockParsedData();
+  this->framesParsedCondition.wait(lock, [this, frameIdx]() {
+    return this->parsingFinished || frameIdx < this->getNumberFramesIndexed();
+  });
+  return frameIdx < this->frameListCodingOrder.size();
+}
+
+bool ParserAnnexB::waitForFrameParsed(FrameIndexCodingOrder frameIdx)
+{
+  auto lock = this->lockParsedData();
+  this->framesParsedCondition.wait(lock, [this, frameIdx]() {
+    return this->parsingFinished || frameIdx < this->frameListCodingOrder.size();
+  });
+  return frameIdx < this->frameListCodingOrder.size();
+}
+
+void ParserAnnexB::setParsingFinished()
+{
+  {
+    auto lock             = this->lockParsedData();
+    this->parsingFinished = true;
+  }
+  this->framesParsedCondition.notify_all();
+}
+
 auto ParserAnnexB::getClosestSeekPoint(FrameIndexDisplayOrder targetFrame,
                                        FrameIndexDisplayOrder currentFrame) -> SeekPointInfo
 {
+  auto lock = this->lockParsedData();
   if (targetFrame >= this->frameListCodingOrder.size())
     return {};
 
@@ -142,8 +340,33 @@ auto ParserAnnexB::getClosestSeekPoint(FrameIndexDisplayOrder targetFrame,
   return seekPointInfo;
 }
 
+std::vector<FrameIndexDisplayOrder> ParserAnnexB::getRandomAccessPointsDisplayOrder()
+{
+  auto lock = this->lockParsedData();
+  this->updateFrameListDisplayOrder();
+
+  std::vector<FrameIndexDisplayOrder> randomAccessPoints;
+  for (size_t i = 0; i < this->frameListDisplayOder.size(); i++)
+    if (this->frameListDisplayOder[i].randomAccessPoint)
+      randomAccessPoints.push_back(FrameIndexDisplayOrder(i));
+  return randomAccessPoints;
+}
+
+std::optional<ParserAnnexB::SeekData> ParserAnnexB::getSeekData(int iFrameNr)
+{
+  auto lock = this->lockParsedData();
+  if (this->seekDataFromIndex.empty())
+    return this->getSeekDataFromNALUnits(iFrameNr);
+
+  auto it = this->seekDataFromIndex.find(FrameIndexDisplayOrder(iFrameNr));
+  if (iFrameNr < 0 || it == this->seekDataFromIndex.end())
+    return {};
+  return it->second;
+}
+
 std::optional<pairUint64> ParserAnnexB::getFrameStartEndPos(FrameIndexCodingOrder idx)
 {
+  auto lock = this->lockParsedData();
   if (idx >= this->frameListCodingOrder.size())
     return {};
   this->updateFrameListDisplayOrder();
@@ -171,10 +394,56 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
     progressDialog->setWindowModality(Qt::WindowModal);
   }
 
-  stream_info.file_size = file->getFileSize();
-  stream_info.parsing   = true;
+  {
+    auto lock                   = this->lockParsedData();
+    this->stream_info.file_size = file->getFileSize();
+    this->stream_info.parsing   = true;
+    this->parsingFinished       = false;
+  }
   emit streamInfoUpdated();
 
+  // The bitstream index only contains what is needed for decoding. If the packet model is enabled
+  // (bitstream analysis), we have to parse everything.
+  const auto filePath = file->getAbsoluteFilePath();
+  const auto useIndex = !this->packetModel->rootItem && BitstreamIndex::isEnabled();
+  unsigned   nrNalUnitsFromIndex{};
+  if (useIndex && this->loadBitstreamIndex(filePath, nrNalUnitsFromIndex))
+  {
+    this->setParsingFinished();
+    DEBUG_ANNEXB("ParserAnnexB::parseAnnexBFile Loaded bitstream index with "
+                 << this->frameListCodingOrder.size() << " POCs");
+    {
+      auto lock                      = this->lockParsedData();
+      this->stream_info.parsing      = false;
+      this->stream_info.nr_nal_units = nrNalUnitsFromIndex;
+      this->stream_info.nr_frames    = unsigned(this->frameListCodingOrder.size());
+    }
+    emit streamInfoUpdated();
+    emit backgroundParsingDone("");
+    return true;
+  }
+
+  // For the packet model, creating the tree items of all syntax elements takes the most time and
+  // memory. The NAL units are split into chunks which can be parsed with logging by a copy of this
+  // parser. This parser only parses the NAL units (for the frame list, the bitrate and the HRD) and
+  // adds one item per NAL unit. The chunks are kept and the syntax of a NAL unit is loaded from its
+  // chunk when it is needed.
+  bool keepChunks = false;
+  if (this->packetModel->rootItem && !mainWindow && this->loadNALUnitSyntaxOnDemand)
+  {
+    if (auto chunkParser = this->createParserWithCurrentState())
+    {
+      std::unique_lock<std::mutex> lock(this->syntaxMutex);
+      this->nalUnitChunks.clear();
+      this->nalUnitChunks.push_back({0, std::move(chunkParser), {}});
+      this->syntaxFile.reset();
+      this->syntaxFilePath    = filePath;
+      this->skipNALUnitSyntax = true;
+      keepChunks              = true;
+    }
+  }
+  size_t nrNALUnitsInChunk = 0;
+
   // Just push all NAL units from the annexBFile into the annexBParser
   int           nalID = 0;
   pairUint64    nalStartEndPosFile;
@@ -185,15 +454,40 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
   {
     // Update the progress dialog
     int64_t pos = file->pos();
-    if (stream_info.file_size > 0)
-      progressPercentValue = functions::clip((int)(pos * 100 / stream_info.file_size), 0, 100);
+    if (maxPos > 0)
+      progressPercentValue = functions::clip((int)(pos * 100 / maxPos), 0, 100);
 
     try
     {
       auto nalData = reader::SubByteReaderLogging::convertToByteVector(
           file->getNextNALUnit(false, &nalStartEndPosFile));
-      auto parsingResult =
-          this->parseAndAddNALUnit(nalID, nalData, {}, nalStartEndPosFile, nullptr);
+
+      if (keepChunks)
+      {
+        std::unique_ptr<ParserAnnexB> chunkParser;
+        if (nrNALUnitsInChunk >= NAL_UNITS_PER_CHUNK)
+          chunkParser = this->createParserWithCurrentState();
+        if (chunkParser)
+          nrNALUnitsInChunk = 0;
+        nrNALUnitsInChunk++;
+
+        std::unique_lock<std::mutex> lock(this->syntaxMutex);
+        if (chunkParser)
+          this->nalUnitChunks.push_back(
+              {this->packetModel->rootItem->getNrChildItems(), std::move(chunkParser), {}});
+        this->nalUnitChunks.back().nalUnits.push_back({nalID, nalStartEndPosFile});
+      }
+
+      ParseResult parsingResult;
+      bool        newFrameParsed;
+      {
+        auto       lock           = this->lockParsedData();
+        const auto nrFramesBefore = this->frameListCodingOrder.size();
+        parsingResult  = this->parseAndAddNALUnit(nalID, nalData, {}, nalStartEndPosFile, nullptr);
+        newFrameParsed = this->frameListCodingOrder.size() != nrFramesBefore;
+      }
+      if (newFrameParsed)
+        this->framesParsedCondition.notify_all();
       if (!parsingResult.success)
       {
         DEBUG_ANNEXB("ParserAnnexB::parseAndAddNALUnit Error parsing NAL " << nalID);
@@ -222,7 +516,10 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
     {
       // Updating the dialog (setValue) is quite slow. Only do this if the percent value changes.
       if (progressDialog->wasCanceled())
+      {
+        this->setParsingFinished();
         return false;
+      }
 
       int newPercentValue = 0;
       if (maxPos > 0)
@@ -253,8 +550,11 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
     }
   }
 
+  this->skipNALUnitSyntax = false;
+
   try
   {
+    auto lock        = this->lockParsedData();
     auto parseResult = this->parseAndAddNALUnit(-1, {}, {}, {});
     if (!parseResult.success)
       DEBUG_ANNEXB(
@@ -272,15 +572,158 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
   if (packetModel)
     emit modelDataUpdated();
 
-  stream_info.parsing      = false;
-  stream_info.nr_nal_units = nalID;
-  stream_info.nr_frames    = unsigned(this->frameListCodingOrder.size());
+  this->setParsingFinished();
+
+  {
+    auto lock                      = this->lockParsedData();
+    this->stream_info.parsing      = false;
+    this->stream_info.nr_nal_units = nalID;
+    this->stream_info.nr_frames    = unsigned(this->frameListCodingOrder.size());
+  }
   emit streamInfoUpdated();
   emit backgroundParsingDone("");
 
+  // Only save an index of the complete file
+  if (useIndex && !abortParsing)
+    this->saveBitstreamIndex(filePath);
+
   return !cancelBackgroundParser;
 }
 
+void ParserAnnexB::saveBitstreamIndex(const QString &filePath)
+{
+  auto lock = this->lockParsedData();
+
+  // Most seek points use the same parameter sets. Save each parameter set only once and reference
+  // it from the seek points.
+  std::vector<ByteVector>                                   parameterSets;
+  std::map<ByteVector, size_t>                              parameterSetIndices;
+  std::vector<std::pair<FrameIndexDisplayOrder, SeekData>> seekPoints;
+  for (auto frameIdx : this->getRandomAccessPointsDisplayOrder())
+  {
+    auto seekData = this->getSeekDataFromNALUnits(int(frameIdx));
+    if (!seekData)
+      continue;
+    for (const auto &parameterSet : seekData->parameterSets)
+    {
+      if (parameterSetIndices.count(parameterSet) == 0)
+      {
+        parameterSetIndices[parameterSet] = parameterSets.size();
+        parameterSets.push_back(parameterSet);
+      }
+    }
+    seekPoints.push_back({frameIdx, *seekData});
+  }
+
+  // Without parameter sets, the properties of the stream can not be restored from the index
+  if (parameterSets.empty())
+    return;
+
+  BitstreamIndex index;
+  index.writeCount(parameterSets.size());
+  for (const auto &parameterSet : parameterSets)
+    index.writeBytes(parameterSet);
+
+  index.writeCount(this->frameListCodingOrder.size());
+  for (const auto &frame : this->frameListCodingOrder)
+  {
+    index.writeInt(frame.poc);
+    index.writeBool(frame.fileStartEndPos.has_value());
+    if (frame.fileStartEndPos)
+    {
+      index.writeUInt(frame.fileStartEndPos->first);
+      index.writeUInt(frame.fileStartEndPos->second);
+    }
+    index.writeBool(frame.randomAccessPoint);
+    index.writeUInt(frame.layerID);
+  }
+
+  index.writeCount(seekPoints.size());
+  for (const auto &[frameIdx, seekData] : seekPoints)
+  {
+    index.writeUInt(frameIdx);
+    index.writeBool(seekData.filePos.has_value());
+    if (seekData.filePos)
+      index.writeUInt(*seekData.filePos);
+    index.writeCount(seekData.parameterSets.size());
+    for (const auto &parameterSet : seekData.parameterSets)
+      index.writeUInt(parameterSetIndices[parameterSet]);
+  }
+
+  index.writeUInt(stream_info.nr_nal_units);
+  index.save(filePath, this->metaObject()->className());
+}
+
+bool ParserAnnexB::loadBitstreamIndex(const QString &filePath, unsigned &nrNalUnits)
+{
+  BitstreamIndex index;
+  if (!index.load(filePath, this->metaObject()->className()))
+    return false;
+
+  std::vector<ByteVector> parameterSets(index.readCount());
+  for (auto &parameterSet : parameterSets)
+    parameterSet = index.readBytes();
+
+  vector<AnnexBFrame> frameList(index.readCount());
+  for (auto &frame : frameList)
+  {
+    frame.poc = int(index.readInt());
+    if (index.readBool())
+    {
+      const auto start      = index.readUInt();
+      frame.fileStartEndPos = pairUint64(start, index.readUInt());
+    }
+    frame.randomAccessPoint = index.readBool();
+    frame.layerID           = unsigned(index.readUInt());
+  }
+
+  std::map<FrameIndexDisplayOrder, SeekData> seekPoints;
+  const auto                                 nrSeekPoints = index.readCount();
+  for (uint64_t i = 0; i < nrSeekPoints && index.isValid(); i++)
+  {
+    const auto frameIdx = FrameIndexDisplayOrder(index.readUInt());
+    SeekData   seekData;
+    if (index.readBool())
+      seekData.filePos = index.readUInt();
+    const auto nrParameterSets = index.readCount();
+    for (uint64_t j = 0; j < nrParameterSets && index.isValid(); j++)
+    {
+      const auto parameterSetIdx = index.readUInt();
+      if (parameterSetIdx >= parameterSets.size())
+        return false;
+      seekData.parameterSets.push_back(parameterSets[parameterSetIdx]);
+    }
+    seekPoints[frameIdx] = seekData;
+  }
+
+  nrNalUnits = unsigned(index.readUInt());
+  if (!index.isValid() || !index.atEnd() || frameList.empty())
+    return false;
+
+  // Parse the parameter sets again. All properties of the stream (size, format, extradata ...) are
+  // derived from them.
+  auto lock  = this->lockParsedData();
+  int  nalID = 0;
+  for (const auto &parameterSet : parameterSets)
+  {
+    try
+    {
+      if (!this->parseAndAddNALUnit(nalID++, parameterSet, {}).success)
+        return false;
+    }
+    catch (...)
+    {
+      DEBUG_ANNEXB("ParserAnnexB::loadBitstreamIndex Error parsing parameter set from index");
+      return false;
+    }
+  }
+
+  this->frameListCodingOrder = std::move(frameList);
+  this->frameListDisplayOder.clear();
+  this->seekDataFromIndex = std::move(seekPoints);
+  return true;
+}
+
 bool ParserAnnexB::runParsingOfFile(QString compressedFilePath)
 {
   DEBUG_ANNEXB("playlistItemCompressedVideo::runParsingOfFile");
@@ -288,6 +731,12 @@ bool ParserAnnexB::runParsingOfFile(QString compressedFilePath)
   return this->parseAnnexBFile(file);
 }
 
+vector<QTreeWidgetItem *> ParserAnnexB::getStreamInfo()
+{
+  auto lock = this->lockParsedData();
+  return this->stream_info.getStreamInfo();
+}
+
 vector<QTreeWidgetItem *> ParserAnnexB::stream_info_type::getStreamInfo()
 {
   vector<QTreeWidgetItem *> infoList;
@@ -313,6 +762,7 @@ vector<QTreeWidgetItem *> ParserAnnexB::stream_info_type::getStreamInfo()
 
 int ParserAnnexB::getFramePOC(FrameIndexDisplayOrder frameIdx)
 {
+  auto lock = this->lockParsedData();
   this->updateFrameListDisplayOrder();
   return this->frameListDisplayOder[frameIdx].poc;
 }
@@ -35,6 +35,9 @@
 #include <QList>
 #include <QTreeWidgetItem>
 
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <optional>
 #include <set>
 
@@ -58,16 +61,34 @@ class ParserAnnexB : public Parser
   Q_OBJECT
 
 public:
-  ParserAnnexB(QObject *parent = nullptr) : Parser(parent){};
+  ParserAnnexB(QObject *parent = nullptr);
   virtual ~ParserAnnexB(){};
 
   // How many POC's have been found in the file
-  size_t getNumberPOCs() const { return this->frameListCodingOrder.size(); }
+  size_t getNumberPOCs() const;
+
+  // The file can be parsed in a background thread (parseAnnexBFile) while the frames that were
+  // already parsed are used. All functions of this class that access the list of frames or the seek
+  // points lock the parsed data. The properties of the stream (getFramerate, getExtradata ...) are
+  // implemented by the specific parsers and do not lock. While parsing is running, lock the parsed
+  // data when calling these.
+  std::unique_lock<std::recursive_mutex> lockParsedData() const;
+
+  // The number of frames (in display order) whose index in display order is final. While parsing,
+  // frames that are parsed later can still be sorted in between the last frames that were parsed.
+  // When parsing is finished, this is the same as getNumberPOCs().
+  size_t getNumberFramesIndexed() const;
+  bool   isParsingFinished() const;
+
+  // Block until the given frame was indexed/parsed or until parsing ended. Return false if there
+  // is no such frame. Do not call these while the parsed data is locked.
+  bool waitForFrameIndexed(FrameIndexDisplayOrder frameIdx);
+  bool waitForFrameParsed(FrameIndexCodingOrder frameIdx);
 
   // Clear all knowledge about the bitstream.
   void clearData();
 
-  vector<QTreeWidgetItem *> getStreamInfo() override { return this->stream_info.getStreamInfo(); }
+  vector<QTreeWidgetItem *> getStreamInfo() override;
   unsigned int              getNrStreams() override { return 1; }
   std::string               getShortStreamDescription(const int streamIndex) const override;
 
@@ -107,7 +128,7 @@ public:
     std::vector<ByteVector> parameterSets;
     std::optional<uint64_t> filePos;
   };
-  virtual std::optional<SeekData> getSeekData(int iFrameNr) = 0;
+  std::optional<SeekData> getSeekData(int iFrameNr);
 
   // Look through the random access points and find the closest one before (or equal)
   // the given frameIdx where we can start decoding
@@ -120,6 +141,9 @@ public:
   auto getClosestSeekPoint(FrameIndexDisplayOrder targetFrame, FrameIndexDisplayOrder currentFrame)
       -> SeekPointInfo;
 
+  // Get the indices (in display order) of all random access points
+  std::vector<FrameIndexDisplayOrder> getRandomAccessPointsDisplayOrder();
+
   // Get the parameters sets as extradata. The format of this depends on the underlying codec.
   virtual QByteArray getExtradata() = 0;
   // Get some other properties of the bitstream in order to configure the FFMpegDecoder
@@ -128,11 +152,19 @@ public:
 
   std::optional<pairUint64> getFrameStartEndPos(FrameIndexCodingOrder idx);
 
+  // Parse the whole file. If the packet model is not enabled (we only need the frame list and the
+  // seek points) and an index of the file is available, the index is loaded instead. After a
+  // successfull parsing, an index is saved for the next time.
   bool parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file, QWidget *mainWindow = nullptr);
 
   // Called from the bitstream analyzer. This function can run in a background process.
   bool runParsingOfFile(QString compressedFilePath) override;
 
+  // When parsing a file for the packet model, the syntax of the NAL units is only loaded when a NAL
+  // unit is expanded (the default). If this is disabled, the syntax of all NAL units is logged
+  // while parsing the file (serially, by this parser).
+  void setLoadNALUnitSyntaxOnDemand(bool onDemand) { this->loadNALUnitSyntaxOnDemand = onDemand; }
+
 protected:
   struct AnnexBFrame
   {
@@ -156,9 +188,23 @@ protected:
                          std::shared_ptr<TreeItem> root,
                          std::optional<pairUint64> nalStartEndPos);
 
+  // Create the tree item for a new NAL unit as a child of the given parent. If no parent is given,
+  // the item is added to the packet model (if enabled).
+  std::shared_ptr<TreeItem> createNALRootItem(std::shared_ptr<TreeItem> parent) const;
+  // The item where the syntax of the NAL unit is logged. If the syntax is loaded on demand, this is
+  // empty while parsing the file because the syntax is only loaded when the NAL unit is expanded.
+  std::shared_ptr<TreeItem> getNALSyntaxItem(std::shared_ptr<TreeItem> nalRoot) const;
+
+  // Create a new parser of the same type which continues parsing with the current state (parameter
+  // sets, POC counters, the current AU ...). It can parse the following NAL units in another thread
+  // or again later while this parser continues. Return nothing if parsing can not be continued in
+  // another parser at the current position.
+  virtual std::unique_ptr<ParserAnnexB> createParserWithCurrentState() const { return {}; }
+
   std::optional<int> pocOfFirstRandomAccessFrame{};
 
-  // Save general information about the file here
+  // Save general information about the file here. This is written by the background parser. Lock
+  // the parsed data when accessing it.
   struct stream_info_type
   {
     vector<QTreeWidgetItem *> getStreamInfo();
@@ -172,13 +218,55 @@ protected:
 
   int getFramePOC(FrameIndexDisplayOrder frameIdx);
 
+  // Get the seek data from the NAL units that were parsed. This is implemented by the specific
+  // parsers. If the bitstream index was loaded, getSeekData returns the seek data from the index.
+  virtual std::optional<SeekData> getSeekDataFromNALUnits(int iFrameNr) = 0;
+
 private:
+  // Save/load the frame list, the seek points and the parameter sets to/from a BitstreamIndex. When
+  // loading, the parameter sets are parsed again so that all properties of the stream are known.
+  void saveBitstreamIndex(const QString &filePath);
+  bool loadBitstreamIndex(const QString &filePath, unsigned &nrNalUnits);
+
+  // If the bitstream index was loaded, the seek data for all random access points (in display
+  // order) is taken from there.
+  std::map<FrameIndexDisplayOrder, SeekData> seekDataFromIndex;
+
+  // While parsing a file for the packet model, the NAL units are split into chunks. Every chunk
+  // starts with a copy of the parser (createParserWithCurrentState) so that the syntax of the chunk
+  // can be parsed independently of the other chunks. Only one item per NAL unit is added to the
+  // packet model while parsing. When a NAL unit is expanded, its chunk is parsed again up to the
+  // NAL unit (loadNALUnitSyntax).
+  struct NALUnitPosition
+  {
+    int        nalID{};
+    pairUint64 startEndPosFile;
+  };
+  struct NALUnitChunk
+  {
+    size_t                        firstItemRow{};
+    std::unique_ptr<ParserAnnexB> parser;
+    std::vector<NALUnitPosition>  nalUnits;
+  };
+  bool                                  loadNALUnitSyntaxOnDemand{true};
+  bool                                  skipNALUnitSyntax{false};
+  std::vector<NALUnitChunk>             nalUnitChunks;
+  QString                               syntaxFilePath;
+  std::unique_ptr<FileSourceAnnexBFile> syntaxFile;
+  std::mutex                            syntaxMutex;
+  bool loadNALUnitSyntax(size_t itemRow, TreeItem &item);
+
+  mutable std::recursive_mutex parsedDataMutex;
+  std::condition_variable_any  framesParsedCondition;
+  bool                         parsingFinished{false};
+  void                         setParsingFinished();
+
   // A list of all frames in the sequence (in coding order) with POC and the file positions of all
   // slice NAL units associated with a frame. POC's don't have to be consecutive, so the only way to
   // know how many pictures are in a sequences is to keep a list of all POCs.
   vector<AnnexBFrame> frameListCodingOrder;
-  // The same list of frames but sorted in display order. Generated from the list above whenever
-  // needed.
+  // The same list of frames but sorted in display order. New frames are inserted at their position
+  // while parsing. If it is empty, it is generated from the list above when needed.
   vector<AnnexBFrame> frameListDisplayOder;
   void                updateFrameListDisplayOrder();
 };
@@ -152,7 +152,7 @@ video::yuv::PixelFormatYUV ParserAnnexBVVC::getPixelFormat() const
   return {};
 }
 
-std::optional<ParserAnnexB::SeekData> ParserAnnexBVVC::getSeekData(int iFrameNr)
+std::optional<ParserAnnexB::SeekData> ParserAnnexBVVC::getSeekDataFromNALUnits(int iFrameNr)
 {
   if (iFrameNr >= int(this->getNumberPOCs()) || iFrameNr < 0)
     return {};
@@ -302,16 +302,13 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
   // Use the given tree item. If it is not set, use the nalUnitMode (if active).
   // Create a new TreeItem root for the NAL unit. We don't set data (a name) for this item
   // yet. We want to parse the item and then set a good description.
-  std::shared_ptr<TreeItem> nalRoot;
-  if (parent)
-    nalRoot = parent->createChildItem();
-  else if (packetModel->rootItem)
-    nalRoot = packetModel->rootItem->createChildItem();
+  auto nalRoot    = this->createNALRootItem(parent);
+  auto syntaxRoot = this->getNALSyntaxItem(nalRoot);
 
-  if (nalRoot)
-    ParserAnnexB::logNALSize(data, nalRoot, nalStartEndPosFile);
+  if (syntaxRoot)
+    ParserAnnexB::logNALSize(data, syntaxRoot, nalStartEndPosFile);
 
-  reader::SubByteReaderLogging reader(data, nalRoot, "", readOffset);
+  reader::SubByteReaderLogging reader(data, syntaxRoot, "", readOffset);
 
   std::stringstream specificDescription;
   auto              nalVVC = std::make_shared<vvc::NalUnitVVC>(nalID, nalStartEndPosFile);
@@ -584,6 +581,18 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
   return parseResult;
 }
 
+std::unique_ptr<ParserAnnexB> ParserAnnexBVVC::createParserWithCurrentState() const
+{
+  auto parser                         = std::make_unique<ParserAnnexBVVC>();
+  parser->pocOfFirstRandomAccessFrame = this->pocOfFirstRandomAccessFrame;
+  parser->maxPOCCount                 = this->maxPOCCount;
+  parser->pocCounterOffset            = this->pocCounterOffset;
+  parser->activeParameterSets         = this->activeParameterSets;
+  parser->parsingState                = this->parsingState;
+  parser->auDelimiterDetector         = this->auDelimiterDetector;
+  return parser;
+}
+
 int ParserAnnexBVVC::calculateAndUpdateGlobalPOC(bool isIRAP, unsigned PicOrderCntVal)
 {
   if (isIRAP && this->maxPOCCount > 0 && PicOrderCntVal == 0)
@@ -91,7 +91,7 @@ public:
   Size                       getSequenceSizeSamples() const override;
   video::yuv::PixelFormatYUV getPixelFormat() const override;
 
-  virtual std::optional<SeekData> getSeekData(int iFrameNr) override;
+  virtual std::optional<SeekData> getSeekDataFromNALUnits(int iFrameNr) override;
   QByteArray                      getExtradata() override;
   IntPair                         getProfileLevel() override;
   Ratio                           getSampleAspectRatio() override;
@@ -103,6 +103,8 @@ public:
                                  std::shared_ptr<TreeItem> parent             = {}) override;
 
 protected:
+  std::unique_ptr<ParserAnnexB> createParserWithCurrentState() const override;
+
   // The PicOrderCntMsb may be reset to zero for IDR frames. In order to count the global POC, we
   // store the maximum POC.
   uint64_t maxPOCCount{0};
@@ -43,6 +43,14 @@
 
 #include <common/Functions.h>
 
+namespace
+{
+
+// The average plot averages the bitrate of this many points left and right of a point
+constexpr unsigned AVERAGE_RANGE = 10;
+
+} // namespace
+
 unsigned BitratePlotModel::getNrStreams() const
 {
   return this->dataPerStream.size();
@@ -75,7 +83,13 @@ PlotModel::Point
 BitratePlotModel::getPlotPoint(unsigned streamIndex, unsigned plotIndex, unsigned pointIndex) const
 {
   QMutexLocker locker(&this->dataMutex);
+  return this->getPlotPointLocked(streamIndex, plotIndex, pointIndex);
+}
 
+PlotModel::Point BitratePlotModel::getPlotPointLocked(unsigned streamIndex,
+                                                      unsigned plotIndex,
+                                                      unsigned pointIndex) const
+{
   if (!this->dataPerStream.contains(streamIndex))
     return {};
 
@@ -162,6 +176,27 @@ std::optional<unsigned> BitratePlotModel::getReasonabelRangeToShowOnXAxisPer100P
   return range;
 }
 
+std::vector<PlotPointSummary> BitratePlotModel::getPointSummaries(unsigned      streamIndex,
+                                                                  unsigned      plotIndex,
+                                                                  Range<double> xRange,
+                                                                  double        xPerSummary) const
+{
+  QMutexLocker locker(&this->dataMutex);
+
+  if (!this->dataPerStream.contains(streamIndex) || plotIndex > 1)
+    return {};
+
+  const auto isAveragePlot = (plotIndex == 1);
+  auto &     pyramid       = this->pyramidsPerStream[streamIndex][plotIndex];
+  pyramid.update(size_t(this->dataPerStream[streamIndex].size()), [&](size_t pointIndex) {
+    const auto point = this->getPlotPointLocked(streamIndex, plotIndex, unsigned(pointIndex));
+    if (isAveragePlot)
+      return PlotPointSummary::fromPoint(point.x, point.y, 0.0, false);
+    return PlotPointSummary::fromPoint(point.x, point.y, point.width, point.intra);
+  });
+  return pyramid.getSummaries(xRange, xPerSummary);
+}
+
 QString BitratePlotModel::formatValue(Axis axis, double value) const
 {
   if (axis == Axis::X)
@@ -223,7 +258,13 @@ void BitratePlotModel::addBitratePoint(int streamIndex, BitrateEntry &entry)
                                          this->dataPerStream[streamIndex].end(),
                                          entry,
                                          compareFunctionLessThen);
+  const auto insertIndex = unsigned(insertIterator - this->dataPerStream[streamIndex].begin());
   this->dataPerStream[streamIndex].insert(insertIterator, entry);
+
+  // The average values around the new entry change as well
+  auto &pyramids = this->pyramidsPerStream[streamIndex];
+  pyramids[0].invalidateFrom(insertIndex);
+  pyramids[1].invalidateFrom(insertIndex > AVERAGE_RANGE ? insertIndex - AVERAGE_RANGE : 0);
   this->eventSubsampler.postEvent();
   if (newStream)
     emit nrStreamsChanged();
@@ -248,16 +289,18 @@ void BitratePlotModel::setBitrateSortingIndex(int index)
   QMutexLocker locker(&this->dataMutex);
   for (auto &list : this->dataPerStream)
     std::sort(list.begin(), list.end(), compareFunctionLessThen);
+  for (auto &pyramids : this->pyramidsPerStream)
+    for (auto &pyramid : pyramids)
+      pyramid.invalidateFrom(0);
 }
 
 unsigned int BitratePlotModel::calculateAverageValue(unsigned streamIndex,
                                                      unsigned pointIndex) const
 {
-  const unsigned int averageRange   = 10;
-  unsigned           averageBitrate = 0;
-  const unsigned     start          = std::max(unsigned(0), pointIndex - averageRange);
-  const unsigned     end =
-      std::min(pointIndex + averageRange, unsigned(this->dataPerStream[streamIndex].size()));
+  unsigned       averageBitrate = 0;
+  const unsigned start          = std::max(unsigned(0), pointIndex - AVERAGE_RANGE);
+  const unsigned end =
+      std::min(pointIndex + AVERAGE_RANGE, unsigned(this->dataPerStream[streamIndex].size()));
   for (unsigned i = start; i < end; i++)
     averageBitrate += unsigned(this->dataPerStream[streamIndex][i].bitrate);
   return averageBitrate / (end - start);
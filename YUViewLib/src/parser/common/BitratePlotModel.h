@@ -36,6 +36,8 @@
 #include <QMutex>
 #include <QString>
 
+#include <array>
+
 #include <common/Typedef.h>
 #include <ui/views/PlotModel.h>
 
@@ -52,6 +54,10 @@ public:
   QString
                           getPointInfo(unsigned streamIndex, unsigned plotIndex, unsigned pointIndex) const override;
   std::optional<unsigned> getReasonabelRangeToShowOnXAxisPer100Pixels() const override;
+  std::vector<PlotPointSummary> getPointSummaries(unsigned      streamIndex,
+                                                  unsigned      plotIndex,
+                                                  Range<double> xRange,
+                                                  double        xPerSummary) const override;
   QString                 formatValue(Axis axis, double value) const override;
   Range<double>           getYRange() const override { return yMaxStreamRange; }
   QString                 getItemInfoText(int index);
@@ -81,6 +87,12 @@ private:
   mutable QMutex                          dataMutex;
 
   unsigned int calculateAverageValue(unsigned streamIndex, unsigned pointIndex) const;
+  PlotModel::Point
+  getPlotPointLocked(unsigned streamIndex, unsigned plotIndex, unsigned pointIndex) const;
+
+  // The min/max pyramids of the bitrate (bar) plot and the average (line) plot per stream. They are
+  // updated when the summaries are requested.
+  mutable QMap<unsigned int, std::array<PlotPointPyramid, 2>> pyramidsPerStream;
 
   Range<int>                     rangeDts;
   Range<int>                     rangePts;
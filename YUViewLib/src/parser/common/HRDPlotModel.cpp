@@ -98,6 +98,29 @@ PlotModel::Point HRDPlotModel::getPlotPoint(unsigned streamIndex, unsigned, unsi
   return point;
 }
 
+std::vector<PlotPointSummary> HRDPlotModel::getPointSummaries(unsigned      streamIndex,
+                                                              unsigned      plotIndex,
+                                                              Range<double> xRange,
+                                                              double        xPerSummary) const
+{
+  if (streamIndex > 0 || plotIndex > 0)
+    return {};
+
+  QMutexLocker locker(&this->dataMutex);
+
+  if (this->data.empty())
+    return {};
+
+  // The first point of the line is always (0, 0). After that, there is one point per entry.
+  this->pyramid.update(size_t(this->data.size()) + 1, [this](size_t pointIndex) {
+    if (pointIndex == 0)
+      return PlotPointSummary::fromPoint(0, 0, 0, false);
+    const auto &entry = this->data[int(pointIndex) - 1];
+    return PlotPointSummary::fromPoint(entry.time_offset_end, entry.cbp_fullness_end, 0, false);
+  });
+  return this->pyramid.getSummaries(xRange, xPerSummary);
+}
+
 QString HRDPlotModel::getPointInfo(unsigned streamIndex, unsigned, unsigned pointIndex) const
 {
   if (streamIndex > 0)
@@ -166,6 +189,7 @@ void HRDPlotModel::addHRDEntry(HRDPlotModel::HRDEntry &entry)
   QMutexLocker locker(&this->dataMutex);
 
   this->data.append(entry);
+  this->pyramid.invalidateFrom(size_t(this->data.size()));
 
   if (entry.time_offset_end > this->time_offset_max)
     this->time_offset_max = entry.time_offset_end;
@@ -52,6 +52,10 @@ public:
   QString
                           getPointInfo(unsigned streamIndex, unsigned plotIndex, unsigned pointIndex) const override;
   std::optional<unsigned> getReasonabelRangeToShowOnXAxisPer100Pixels() const override { return 1; }
+  std::vector<PlotPointSummary> getPointSummaries(unsigned      streamIndex,
+                                                  unsigned      plotIndex,
+                                                  Range<double> xRange,
+                                                  double        xPerSummary) const override;
   QString                 formatValue(Axis axis, double value) const override;
   Range<double>           getYRange() const override { return getStreamParameter(0).yRange; }
   QString                 getItemInfoText(int index);
@@ -84,6 +88,9 @@ private:
   QList<HRDEntry> data;
   mutable QMutex  dataMutex;
 
+  // Updated when the summaries are requested
+  mutable PlotPointPyramid pyramid;
+
   int        cpb_buffer_size{0};
   double     time_offset_max{0};
   Range<int> bufferLevelLimits{0, 0};
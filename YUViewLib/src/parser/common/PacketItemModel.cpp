@@ -37,6 +37,7 @@
 #include <common/Typedef.h>
 
 #include <QBrush>
+#include <algorithm>
 
 #if PARSERCOMMON_DEBUG_FILTER_OUTPUT && !NDEBUG
 #include <QDebug>
@@ -170,6 +171,71 @@ int PacketItemModel::rowCount(const QModelIndex &parent) const
   return (p == nullptr) ? 0 : int(p->getNrChildItems());
 }
 
+bool PacketItemModel::hasChildren(const QModelIndex &parent) const
+{
+  if (this->isFirstLevelItemWithLoader(parent))
+    return true;
+  return QAbstractItemModel::hasChildren(parent);
+}
+
+bool PacketItemModel::canFetchMore(const QModelIndex &parent) const
+{
+  if (!this->isFirstLevelItemWithLoader(parent))
+    return false;
+  auto item = static_cast<TreeItem *>(parent.internalPointer());
+  return item->getNrChildItems() == 0;
+}
+
+void PacketItemModel::fetchMore(const QModelIndex &parent)
+{
+  if (!this->canFetchMore(parent))
+    return;
+
+  const auto row        = size_t(parent.row());
+  auto       loadedItem = std::make_shared<TreeItem>();
+  if (!this->childItemLoader(row, *loadedItem) || loadedItem->getNrChildItems() == 0)
+    return;
+
+  auto item = static_cast<TreeItem *>(parent.internalPointer());
+  this->beginInsertRows(parent, 0, int(loadedItem->getNrChildItems()) - 1);
+  item->appendChildItemsOf(*loadedItem);
+  this->endInsertRows();
+
+  this->loadedRows.push_back(row);
+  while (this->loadedRows.size() > this->maxNrLoadedItems)
+  {
+    this->unloadChildItems(this->loadedRows.front());
+    this->loadedRows.pop_front();
+  }
+}
+
+void PacketItemModel::setChildItemLoader(ChildItemLoader loader, size_t maxNrLoadedItems)
+{
+  this->childItemLoader  = loader;
+  this->maxNrLoadedItems = std::max(maxNrLoadedItems, size_t(1));
+  this->loadedRows.clear();
+}
+
+bool PacketItemModel::isFirstLevelItemWithLoader(const QModelIndex &index) const
+{
+  if (!this->childItemLoader || !index.isValid() || index.column() > 0)
+    return false;
+  auto item = static_cast<TreeItem *>(index.internalPointer());
+  return item->getParentItem().lock() == this->rootItem;
+}
+
+void PacketItemModel::unloadChildItems(size_t row)
+{
+  auto item = this->rootItem->getChild(unsigned(row));
+  if (!item || item->getNrChildItems() == 0)
+    return;
+
+  this->beginRemoveRows(
+      this->createIndex(int(row), 0, item.get()), 0, int(item->getNrChildItems()) - 1);
+  item->clearChildItems();
+  this->endRemoveRows();
+}
+
 size_t PacketItemModel::getNumberFirstLevelChildren() const
 {
   if (this->rootItem)
@@ -37,6 +37,9 @@
 
 #include "TreeItem.h"
 
+#include <deque>
+#include <functional>
+
 // The item model which is used to display packets from the bitstream. This can be AVPackets or other units from the bitstream (NAL units e.g.)
 class PacketItemModel : public QAbstractItemModel
 {
@@ -53,6 +56,9 @@ public:
   virtual QModelIndex parent(const QModelIndex &index) const override;
   virtual int rowCount(const QModelIndex &parent = QModelIndex()) const override;
   virtual int columnCount(const QModelIndex &parent = QModelIndex()) const override { (void)parent; return 5; }
+  virtual bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+  virtual bool canFetchMore(const QModelIndex &parent) const override;
+  virtual void fetchMore(const QModelIndex &parent) override;
 
   // The root of the tree
   std::shared_ptr<TreeItem> rootItem;
@@ -61,6 +67,14 @@ public:
   void setShowVideoStreamOnly(bool showVideoOnly);
 
   void updateNumberModelItems();
+
+  // If a loader is set, the child items of the first level items are not created when parsing.
+  // They are loaded (by the loader) when the item is expanded. The loader gets the row of the first
+  // level item and appends the child items to the given item. To limit the memory usage, only the
+  // child items of the last maxNrLoadedItems items which were loaded are kept.
+  using ChildItemLoader = std::function<bool(size_t row, TreeItem &item)>;
+  void setChildItemLoader(ChildItemLoader loader, size_t maxNrLoadedItems);
+
 private:
   // This is the current number of first level child items which we show right now.
   // The brackground parser will add more items and it will notify the bitstreamAnalysisWindow
@@ -71,6 +85,13 @@ private:
 
   bool useColorCoding { true };
   bool showVideoOnly  { false };
+
+  bool isFirstLevelItemWithLoader(const QModelIndex &index) const;
+  void unloadChildItems(size_t row);
+
+  ChildItemLoader    childItemLoader;
+  size_t             maxNrLoadedItems {0};
+  std::deque<size_t> loadedRows;
 };
 
 class FilterByStreamIndexProxyModel : public QSortFilterProxyModel
@@ -40,20 +40,97 @@
 namespace parser
 {
 
-SubByteReader::SubByteReader(const ByteVector &inArr, size_t inArrOffset)
-    : byteVector(inArr), posInBufferBytes(inArrOffset), initialPosInBuffer(inArrOffset){};
+namespace
+{
+
+void appendBitsToCode(std::string *code, uint64_t value, size_t nrBits)
+{
+  if (code == nullptr)
+    return;
+  for (auto i = nrBits; i > 0; i--)
+    code->push_back((value & (uint64_t(1) << (i - 1))) ? '1' : '0');
+}
+
+} // namespace
 
-std::tuple<uint64_t, std::string> SubByteReader::readBits(size_t nrBits)
+SubByteReader::SubByteReader(const ByteVector &inArr, size_t inArrOffset)
+    : byteVector(inArr), posInBufferBytes(inArrOffset), initialPosInBuffer(inArrOffset)
 {
-  uint64_t out        = 0;
-  auto     nrBitsRead = nrBits;
+  // An emulation prevention 3 byte follows two zero bytes. The zero bytes are counted from the
+  // initial position on and the counter is reset after each emulation prevention byte.
+  unsigned nrZeroBytes = 0;
+  for (auto pos = inArrOffset; pos < this->byteVector.size(); pos++)
+  {
+    const auto c = this->byteVector[pos];
+    if (nrZeroBytes == 2 && c == 3)
+    {
+      this->emulationPreventionBytePositions.push_back(pos);
+      nrZeroBytes = 0;
+      // The byte after an emulation prevention byte is never skipped
+      pos++;
+      if (pos < this->byteVector.size() && this->byteVector[pos] == 0)
+        nrZeroBytes = 1;
+    }
+    else if (c == 0)
+      nrZeroBytes++;
+    else
+      nrZeroBytes = 0;
+  }
+};
 
+uint64_t SubByteReader::readBits(size_t nrBits, std::string *code)
+{
   // The return unsigned int is of depth 64 bits
   if (nrBits > 64)
     throw std::logic_error("Trying to read more than 64 bits at once from the bitstream.");
   if (nrBits == 0)
-    return {0, ""};
+    return 0;
 
+  if (this->posInBufferBits == 8)
+  {
+    if (!this->gotoNextByte())
+      throw std::logic_error("Error while reading annexB file. Trying to "
+                             "read over buffer boundary.");
+  }
+  if (this->posInBufferBytes >= this->byteVector.size())
+    throw std::logic_error("Error while reading annexB file. Trying to "
+                           "read over buffer boundary.");
+
+  // Fast path: If the bits are in the next 8 bytes and there is no emulation prevention byte in
+  // between, we can get all bits from one 64 bit word.
+  const auto endBit          = this->posInBufferBits + nrBits;
+  const auto nrBytesWithBits = (endBit + 7) / 8;
+  const auto emulationPreventionByteInRange =
+      this->skipEmulationPrevention &&
+      this->nextEmulationPreventionByte < this->emulationPreventionBytePositions.size() &&
+      this->emulationPreventionBytePositions[this->nextEmulationPreventionByte] <
+          this->posInBufferBytes + nrBytesWithBits;
+  if (endBit <= 64 && this->posInBufferBytes + 8 <= this->byteVector.size() &&
+      !emulationPreventionByteInRange)
+  {
+    uint64_t word = 0;
+    for (unsigned i = 0; i < 8; i++)
+      word = (word << 8) | this->byteVector[this->posInBufferBytes + i];
+
+    const auto value = (word << this->posInBufferBits) >> (64 - nrBits);
+
+    // Just like when reading bit by bit, we stay in the last byte if it was read completely
+    const auto lastByteOffset = (endBit - 1) / 8;
+    this->posInBufferBytes += lastByteOffset;
+    this->posInBufferBits = endBit - lastByteOffset * 8;
+
+    appendBitsToCode(code, value, nrBits);
+    return value;
+  }
+
+  const auto value = this->readBitsBytewise(nrBits);
+  appendBitsToCode(code, value, nrBits);
+  return value;
+}
+
+uint64_t SubByteReader::readBitsBytewise(size_t nrBits)
+{
+  uint64_t out = 0;
   while (nrBits > 0)
   {
     if (this->posInBufferBits == 8 && nrBits != 0)
@@ -100,20 +177,10 @@ std::tuple<uint64_t, std::string> SubByteReader::readBits(size_t nrBits)
     this->posInBufferBits += readBits;
   }
 
-  std::string bitsRead;
-  assert(nrBitsRead > 0);
-  for (auto i = nrBitsRead; i > 0; i--)
-  {
-    if (out & (uint64_t(1) << (i - 1)))
-      bitsRead.push_back('1');
-    else
-      bitsRead.push_back('0');
-  }
-
-  return {out, bitsRead};
+  return out;
 }
 
-std::tuple<ByteVector, std::string> SubByteReader::readBytes(size_t nrBytes)
+ByteVector SubByteReader::readBytes(size_t nrBytes, std::string *code)
 {
   if (this->posInBufferBits != 0 && this->posInBufferBits != 8)
     throw std::logic_error("When reading bytes from the bitstream, it must be byte aligned.");
@@ -124,13 +191,14 @@ std::tuple<ByteVector, std::string> SubByteReader::readBytes(size_t nrBytes)
       throw std::logic_error("Error while reading annexB file. Trying to read "
                              "over buffer boundary.");
 
-  ByteVector  retVector;
-  std::string code;
+  ByteVector retVector;
+  retVector.reserve(nrBytes);
   for (unsigned i = 0; i < nrBytes; i++)
   {
     auto c = this->byteVector[this->posInBufferBytes];
     retVector.push_back(c);
-    code += std::bitset<8>(c).to_string();
+    if (code != nullptr)
+      *code += std::bitset<8>(c).to_string();
 
     if (!this->gotoNextByte())
     {
@@ -140,89 +208,64 @@ std::tuple<ByteVector, std::string> SubByteReader::readBytes(size_t nrBytes)
     }
   }
 
-  return {retVector, code};
+  return retVector;
 }
 
-std::tuple<uint64_t, std::string> SubByteReader::readUE_V()
+uint64_t SubByteReader::readUE_V(std::string *code)
 {
-  std::string coding;
-  {
-    auto [firstBit, firstBitCoding] = this->readBits(1);
-    if (firstBit == 1)
-      return {0, firstBitCoding};
-    coding += firstBitCoding;
-  }
+  if (this->readBits(1, code) == 1)
+    return 0;
 
   // Get the length of the golomb
-  unsigned golLength = 0;
-  while (true)
-  {
-    auto [readBit, readCoding] = this->readBits(1);
-    coding += readCoding;
+  unsigned golLength = 1;
+  while (this->readBits(1, code) == 0)
     golLength++;
-    if (readBit == 1)
-      break;
-  }
 
-  auto [golBits, golCoding] = this->readBits(golLength);
-  coding += golCoding;
+  auto golBits = this->readBits(golLength, code);
   // Exponential part
-  auto val = golBits + (uint64_t(1) << golLength) - 1;
-
-  return {val, coding};
+  return golBits + (uint64_t(1) << golLength) - 1;
 }
 
-std::tuple<int64_t, std::string> SubByteReader::readSE_V()
+int64_t SubByteReader::readSE_V(std::string *code)
 {
-  auto [val, coding] = this->readUE_V();
+  auto val = this->readUE_V(code);
   if (val % 2 == 0)
-    return {-int64_t((val + 1) / 2), coding};
+    return -int64_t((val + 1) / 2);
   else
-    return {int64_t((val + 1) / 2), coding};
+    return int64_t((val + 1) / 2);
 }
 
-std::tuple<uint64_t, std::string> SubByteReader::readLEB128()
+uint64_t SubByteReader::readLEB128(std::string *code)
 {
   // We will read full bytes (up to 8)
   // The highest bit indicates if we need to read another bit. The rest of the
   // bits is added to the counter (shifted accordingly) See the AV1 reading
   // specification
-  uint64_t    value = 0;
-  std::string coding;
+  uint64_t value = 0;
   for (unsigned i = 0; i < 8; i++)
   {
-    auto [leb128_byte, leb128_byte_coding] = this->readBits(8);
-    coding += leb128_byte_coding;
+    auto leb128_byte = this->readBits(8, code);
     value |= ((leb128_byte & 0x7f) << (i * 7));
     if (!(leb128_byte & 0x80))
       break;
   }
-  return {value, coding};
+  return value;
 }
 
-std::tuple<uint64_t, std::string> SubByteReader::readUVLC()
+uint64_t SubByteReader::readUVLC(std::string *code)
 {
-  auto        leadingZeros = 0u;
-  std::string coding;
-
-  while (1)
-  {
-    auto [done, done_coding] = this->readBits(1);
-    coding += done_coding;
-    if (done > 0)
-      break;
+  auto leadingZeros = 0u;
+  while (this->readBits(1, code) == 0)
     leadingZeros++;
-  }
 
   if (leadingZeros >= 32)
-    return {((uint64_t)1 << 32) - 1, coding};
-  auto [value, value_coding] = this->readBits(leadingZeros);
-  coding += value_coding;
+    return ((uint64_t)1 << 32) - 1;
+  auto value = this->readBits(leadingZeros, code);
 
-  return {value + ((uint64_t)1 << leadingZeros) - 1, coding};
+  return value + ((uint64_t)1 << leadingZeros) - 1;
 }
 
-std::tuple<uint64_t, std::string> SubByteReader::readNS(uint64_t maxVal)
+uint64_t SubByteReader::readNS(uint64_t maxVal, std::string *code)
 {
   if (maxVal == 0)
     return {};
@@ -243,24 +286,21 @@ std::tuple<uint64_t, std::string> SubByteReader::readNS(uint64_t maxVal)
   auto w = floorVal + 1;
   auto m = (uint64_t(1) << w) - maxVal;
 
-  auto [v, coding] = this->readBits(w - 1);
+  auto v = this->readBits(w - 1, code);
   if (v < m)
-    return {v, coding};
+    return v;
 
-  auto [extra_bit, extra_bit_coding] = this->readBits(1);
-  return {(v << 1) - m + extra_bit, coding + extra_bit_coding};
+  auto extra_bit = this->readBits(1, code);
+  return (v << 1) - m + extra_bit;
 }
 
-std::tuple<int64_t, std::string> SubByteReader::readSU(unsigned nrBits)
+int64_t SubByteReader::readSU(unsigned nrBits, std::string *code)
 {
-  auto [value, coding] = readBits(nrBits);
-  int signMask         = 1 << (nrBits - 1);
+  auto value    = readBits(nrBits, code);
+  int  signMask = 1 << (nrBits - 1);
   if (value & signMask)
-  {
-    auto subValue = int64_t(value) - 2 * signMask;
-    return {subValue, coding};
-  }
-  return {int64_t(value), coding};
+    return int64_t(value) - 2 * signMask;
+  return int64_t(value);
 }
 
 /* Is there more data? There is no more data if the next bit is the terminating
@@ -375,12 +415,8 @@ ByteVector SubByteReader::peekBytes(unsigned nrBytes) const
 
 bool SubByteReader::gotoNextByte()
 {
-  // Before we go to the neyt byte, check if the last (current) byte is a zero
-  // byte.
   if (this->posInBufferBytes >= unsigned(this->byteVector.size()))
     throw std::out_of_range("Reading out of bounds");
-  if (this->byteVector[this->posInBufferBytes] == (char)0)
-    this->numEmuPrevZeroBytes++;
 
   // Skip the remaining sub-byte-bits
   this->posInBufferBits = 0;
@@ -391,28 +427,23 @@ bool SubByteReader::gotoNextByte()
     // The next byte is outside of the current buffer. Error.
     return false;
 
-  if (this->skipEmulationPrevention)
+  if (this->nextEmulationPreventionByte < this->emulationPreventionBytePositions.size() &&
+      this->emulationPreventionBytePositions[this->nextEmulationPreventionByte] ==
+          this->posInBufferBytes)
   {
-    if (this->numEmuPrevZeroBytes == 2 && this->byteVector[this->posInBufferBytes] == (char)3)
+    this->nextEmulationPreventionByte++;
+    if (this->skipEmulationPrevention)
     {
       // The current byte is an emulation prevention 3 byte. Skip it.
       this->posInBufferBytes++; // Skip byte
 
       if (this->posInBufferBytes >= (unsigned int)this->byteVector.size())
-      {
         // The next byte is outside of the current buffer. Error
         return false;
-      }
-
-      // Reset counter
-      this->numEmuPrevZeroBytes = 0;
     }
-    else if (this->byteVector[this->posInBufferBytes] != (char)0)
-      // No zero byte. No emulation prevention 3 byte
-      this->numEmuPrevZeroBytes = 0;
   }
 
   return true;
 }
 
-} // namespace parser
\ No newline at end of file
+} // namespace parser
@@ -35,6 +35,7 @@
 #include <algorithm>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include <common/Typedef.h>
 
@@ -44,6 +45,9 @@ namespace parser
 /* This class provides the ability to read a byte array bit wise. Reading of ue(v) symbols is also
  * supported. This class can "read out" the emulation prevention bytes. This is enabled by default
  * but can be disabled if needed.
+ * All reading functions can optionally return the bits that were read as a string (e.g. "0010").
+ * If no code string is given, no strings are created and whenever possible up to 64 bits are read
+ * from the buffer at once.
  */
 class SubByteReader
 {
@@ -66,15 +70,15 @@ public:
   void disableEmulationPrevention() { skipEmulationPrevention = false; }
 
 protected:
-  std::tuple<uint64_t, std::string>   readBits(size_t nrBits);
-  std::tuple<ByteVector, std::string> readBytes(size_t nrBytes);
+  uint64_t   readBits(size_t nrBits, std::string *code = nullptr);
+  ByteVector readBytes(size_t nrBytes, std::string *code = nullptr);
 
-  std::tuple<uint64_t, std::string> readUE_V();
-  std::tuple<int64_t, std::string>  readSE_V();
-  std::tuple<uint64_t, std::string> readLEB128();
-  std::tuple<uint64_t, std::string> readUVLC();
-  std::tuple<uint64_t, std::string> readNS(uint64_t maxVal);
-  std::tuple<int64_t, std::string>  readSU(unsigned nrBits);
+  uint64_t readUE_V(std::string *code = nullptr);
+  int64_t  readSE_V(std::string *code = nullptr);
+  uint64_t readLEB128(std::string *code = nullptr);
+  uint64_t readUVLC(std::string *code = nullptr);
+  uint64_t readNS(uint64_t maxVal, std::string *code = nullptr);
+  int64_t  readSU(unsigned nrBits, std::string *code = nullptr);
 
   ByteVector byteVector;
 
@@ -84,10 +88,21 @@ protected:
   // found. This function is just used by the internal reading functions.
   bool gotoNextByte();
 
-  size_t posInBufferBytes{0};    // The byte position in the buffer
-  size_t posInBufferBits{0};     // The sub byte (bit) position in the buffer (0...7)
-  size_t numEmuPrevZeroBytes{0}; // The number of emulation prevention three bytes that were found
-  size_t initialPosInBuffer{0};  // The position that was given when creating the sub reader
+  size_t posInBufferBytes{0};   // The byte position in the buffer
+  size_t posInBufferBits{0};    // The sub byte (bit) position in the buffer (0...7)
+  size_t initialPosInBuffer{0}; // The position that was given when creating the sub reader
+
+private:
+  // Read the bits byte by byte. This also works at the end of the buffer and across emulation
+  // prevention bytes.
+  uint64_t readBitsBytewise(size_t nrBits);
+
+  // The positions of all emulation prevention 3 bytes in the buffer. This is filled once when
+  // creating the reader so that we don't have to check every byte while reading.
+  std::vector<size_t> emulationPreventionBytePositions;
+  // The index of the next emulation prevention byte in emulationPreventionBytePositions that is
+  // after the current read position.
+  size_t nextEmulationPreventionByte{0};
 };
 
 } // namespace parser
\ No newline at end of file
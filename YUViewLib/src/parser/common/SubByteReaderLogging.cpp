@@ -111,24 +111,14 @@ void checkAndLog(std::shared_ptr<TreeItem> item,
 
 } // namespace
 
-ByteVector SubByteReaderLogging::convertToByteVector(QByteArray data)
+ByteVector SubByteReaderLogging::convertToByteVector(const QByteArray &data)
 {
-  ByteVector ret;
-  for (auto i = 0u; i < unsigned(data.size()); i++)
-  {
-    ret.push_back(data.at(i));
-  }
-  return ret;
+  return ByteVector(data.constBegin(), data.constEnd());
 }
 
-QByteArray SubByteReaderLogging::convertToQByteArray(ByteVector data)
+QByteArray SubByteReaderLogging::convertToQByteArray(const ByteVector &data)
 {
-  QByteArray ret;
-  for (auto i = 0u; i < unsigned(data.size()); i++)
-  {
-    ret.append(data.at(i));
-  }
-  return ret;
+  return QByteArray(reinterpret_cast<const char *>(data.data()), int(data.size()));
 }
 
 SubByteReaderLogging::SubByteReaderLogging(SubByteReader &           reader,
@@ -160,6 +150,13 @@ SubByteReaderLogging::SubByteReaderLogging(const ByteVector &        inArr,
   }
 }
 
+std::string *SubByteReaderLogging::codeIfLogging(std::string &code, const Options &options) const
+{
+  if (!this->currentTreeLevel || options.loggingDisabled)
+    return nullptr;
+  return &code;
+}
+
 void SubByteReaderLogging::addLogSubLevel(const std::string &name)
 {
   if (!this->currentTreeLevel)
@@ -191,7 +188,8 @@ uint64_t SubByteReaderLogging::readBits(const std::string &symbolName,
 {
   try
   {
-    auto [value, code] = SubByteReader::readBits(numBits);
+    std::string code;
+    auto        value = SubByteReader::readBits(numBits, this->codeIfLogging(code, options));
     checkAndLog(this->currentTreeLevel, "u(v)", symbolName, options, value, code);
     return value;
   }
@@ -205,7 +203,8 @@ bool SubByteReaderLogging::readFlag(const std::string &symbolName, const Options
 {
   try
   {
-    auto [value, code] = SubByteReader::readBits(1);
+    std::string code;
+    auto        value = SubByteReader::readBits(1, this->codeIfLogging(code, options));
     checkAndLog(this->currentTreeLevel, "u(1)", symbolName, options, value, code);
     return (value != 0);
   }
@@ -219,7 +218,8 @@ uint64_t SubByteReaderLogging::readUEV(const std::string &symbolName, const Opti
 {
   try
   {
-    auto [value, code] = SubByteReader::readUE_V();
+    std::string code;
+    auto        value = SubByteReader::readUE_V(this->codeIfLogging(code, options));
     checkAndLog(this->currentTreeLevel, "ue(v)", symbolName, options, value, code);
     return value;
   }
@@ -233,7 +233,8 @@ int64_t SubByteReaderLogging::readSEV(const std::string &symbolName, const Optio
 {
   try
   {
-    auto [value, code] = SubByteReader::readSE_V();
+    std::string code;
+    auto        value = SubByteReader::readSE_V(this->codeIfLogging(code, options));
     checkAndLog(this->currentTreeLevel, "se(v)", symbolName, options, value, code);
     return value;
   }
@@ -247,7 +248,8 @@ uint64_t SubByteReaderLogging::readLEB128(const std::string &symbolName, const O
 {
   try
   {
-    auto [value, code] = SubByteReader::readLEB128();
+    std::string code;
+    auto        value = SubByteReader::readLEB128(this->codeIfLogging(code, options));
     checkAndLog(this->currentTreeLevel, "leb128(v)", symbolName, options, value, code);
     return value;
   }
@@ -262,7 +264,8 @@ SubByteReaderLogging::readNS(const std::string &symbolName, uint64_t maxVal, con
 {
   try
   {
-    auto [value, code] = SubByteReader::readNS(maxVal);
+    std::string code;
+    auto        value = SubByteReader::readNS(maxVal, this->codeIfLogging(code, options));
     checkAndLog(this->currentTreeLevel, "ns(n)", symbolName, options, value, code);
     return value;
   }
@@ -277,7 +280,8 @@ SubByteReaderLogging::readSU(const std::string &symbolName, unsigned nrBits, con
 {
   try
   {
-    auto [value, code] = SubByteReader::readSU(nrBits);
+    std::string code;
+    auto        value = SubByteReader::readSU(nrBits, this->codeIfLogging(code, options));
     checkAndLog(this->currentTreeLevel, "su(n)", symbolName, options, value, code);
     return value;
   }
@@ -296,7 +300,8 @@ ByteVector SubByteReaderLogging::readBytes(const std::string &symbolName,
     if (!this->byte_aligned())
       throw std::logic_error("Trying to read bytes while not byte aligned.");
 
-    auto [value, code] = SubByteReader::readBytes(nrBytes);
+    std::string code;
+    auto        value = SubByteReader::readBytes(nrBytes, this->codeIfLogging(code, options));
     checkAndLog(this->currentTreeLevel, symbolName, options, value, code);
     return value;
   }
@@ -65,8 +65,8 @@ public:
 
   // DEPRECATED. This is just for backwards compatibility and will be removed once
   // everything is using std types.
-  static ByteVector convertToByteVector(QByteArray data);
-  static QByteArray convertToQByteArray(ByteVector data);
+  static ByteVector convertToByteVector(const QByteArray &data);
+  static QByteArray convertToQByteArray(const ByteVector &data);
 
   uint64_t readBits(const std::string &symbolName, size_t numBits, const Options &options = {});
   bool     readFlag(const std::string &symbolName, const Options &options = {});
@@ -97,6 +97,9 @@ private:
   void updateCurrentLevelName(const std::string &name);
   void removeLogSubLevel();
 
+  // If nothing is logged, there is no need for the reader to create the code strings.
+  std::string *codeIfLogging(std::string &code, const Options &options) const;
+
   void logExceptionAndThrowError [[noreturn]] (const std::exception &ex, const std::string &when);
 
   std::stack<std::shared_ptr<TreeItem>> itemHierarchy;
@@ -113,6 +113,19 @@ public:
     return newItem;
   }
 
+  // Move all child items of the other item to the end of the child items of this item
+  void appendChildItemsOf(TreeItem &other)
+  {
+    for (auto &child : other.childItems)
+    {
+      child->parent = this->weak_from_this();
+      this->childItems.push_back(child);
+    }
+    other.childItems.clear();
+  }
+
+  void clearChildItems() { this->childItems.clear(); }
+
   size_t getNrChildItems() const { return this->childItems.size(); }
 
   std::string getData(unsigned idx) const
@@ -214,12 +214,20 @@ public:
   // Is there a limit on the number of threads that can cache from this item at the same time? (-1 =
   // no limit)
   virtual int cachingThreadLimit() { return -1; }
+  // If frames of the item can only be cached efficiently in order (e.g. compressed video), the item
+  // may split the given range into segments that can be cached independently (e.g. GOPs). Return
+  // the first frame of every segment within the range (excluding range.first). Each segment is
+  // then cached by one thread in order. By default, the range is not split.
+  virtual std::vector<int> getCachingSegmentStarts(indexRange) const { return {}; }
   // Tag the item as "to be deleted"
   void tagItemForDeletion() { itemTaggedForDeletion = true; }
   // Cache the given frame. This function is thread save. So multiple instances of this function can
   // run at the same time. In test mode, we don't check if the frame is already cached and don't
   // cache it. We just convert it and return.
   virtual void cacheFrame(int, bool) {}
+  // The given range of frames was scheduled for caching. Items can use this to start reading the
+  // data in the background (e.g. read ahead in the file).
+  virtual void prefetchFramesForCaching(indexRange) {}
   // Get a list of all cached frames (just the frame indices)
   virtual QList<int> getCachedFrames() const { return QList<int>(); }
   virtual int        getNumberCachedFrames() const { return 0; }
@@ -35,11 +35,14 @@
 #include <QInputDialog>
 #include <QPlainTextEdit>
 #include <QThread>
+#include <QtConcurrent>
 
+#include <algorithm>
 #include <inttypes.h>
 
 #include <common/Functions.h>
 #include <common/FunctionsGui.h>
+#include <common/ThreadBudget.h>
 #include <common/YUViewDomElement.h>
 #include <decoder/decoderDav1d.h>
 #include <decoder/decoderFFmpeg.h>
@@ -82,6 +85,18 @@ bool isInputFormatTypeFFmpeg(InputFormat format)
   return format == InputFormat::Libav;
 }
 
+InputFormat getInputFormatFromFileExtension(const QString &filePath)
+{
+  const auto ext = QFileInfo(filePath).suffix();
+  if (ext == "hevc" || ext == "h265" || ext == "265")
+    return InputFormat::AnnexBHEVC;
+  if (ext == "vvc" || ext == "h266" || ext == "266")
+    return InputFormat::AnnexBVVC;
+  if (ext == "avc" || ext == "h264" || ext == "264")
+    return InputFormat::AnnexBAVC;
+  return InputFormat::Libav;
+}
+
 enum class Codec
 {
   AV1,
@@ -99,10 +114,12 @@ enum class Codec
 // by lower than this threshold, we will not seek.
 #define FORWARD_SEEK_THRESHOLD 5
 
-playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compressedFilePath,
-                                                         int            displayComponent,
-                                                         InputFormat    input,
-                                                         DecoderEngine  decoder)
+playlistItemCompressedVideo::playlistItemCompressedVideo(
+    const QString &                         compressedFilePath,
+    int                                     displayComponent,
+    InputFormat                             input,
+    DecoderEngine                           decoder,
+    const FileSourceFFmpegFile::ScanResult *ffmpegScanResult)
     : playlistItemWithVideo(compressedFilePath)
 {
   // Set the properties of the playlistItem
@@ -116,19 +133,35 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
   // An compressed file can be cached if nothing goes wrong
   this->cachingEnabled = true;
 
-  // Open the input file and get some properties (size, bit depth, subsampling) from the file
-  if (input == InputFormat::Invalid)
+  // Keep the statistics of recently decoded frames
+  this->statisticsData.updateSettings();
+
+  // The decoders run in the loading and caching threads. Their errors are applied in the GUI
+  // thread.
+  connect(this,
+          &playlistItemCompressedVideo::signalDecodingError,
+          this,
+          &playlistItemCompressedVideo::slotDecodingError,
+          Qt::QueuedConnection);
+  connect(this,
+          &playlistItemCompressedVideo::signalDecodingNotPossibleAfter,
+          this,
+          &playlistItemCompressedVideo::slotDecodingNotPossibleAfter,
+          Qt::QueuedConnection);
+
+  // How many decoders should be used for caching?
   {
-    QString ext = QFileInfo(compressedFilePath).suffix();
-    if (ext == "hevc" || ext == "h265" || ext == "265")
-      this->inputFormat = InputFormat::AnnexBHEVC;
-    else if (ext == "vvc" || ext == "h266" || ext == "266")
-      this->inputFormat = InputFormat::AnnexBVVC;
-    else if (ext == "avc" || ext == "h264" || ext == "264")
-      this->inputFormat = InputFormat::AnnexBAVC;
-    else
-      this->inputFormat = InputFormat::Libav;
+    QSettings settings;
+    settings.beginGroup("VideoCache");
+    const auto nrCachingDecoders = std::max(settings.value("NrCachingDecoders", 1).toInt(), 1);
+    settings.endGroup();
+    for (int i = 0; i < nrCachingDecoders; i++)
+      this->cachingContexts.push_back(std::make_unique<DecodingContext>());
   }
+
+  // Open the input file and get some properties (size, bit depth, subsampling) from the file
+  if (input == InputFormat::Invalid)
+    this->inputFormat = getInputFormatFromFileExtension(compressedFilePath);
   else
     this->inputFormat = input;
 
@@ -142,9 +175,10 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
   {
     // Open file
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Open annexB file");
-    this->inputFileAnnexBLoading = std::make_unique<FileSourceAnnexBFile>(compressedFilePath);
-    if (this->cachingEnabled)
-      this->inputFileAnnexBCaching = std::make_unique<FileSourceAnnexBFile>(compressedFilePath);
+    this->loadingContext.inputFileAnnexB =
+        std::make_unique<FileSourceAnnexBFile>(compressedFilePath);
+    for (auto &context : this->cachingContexts)
+      context->inputFileAnnexB = std::make_unique<FileSourceAnnexBFile>(compressedFilePath);
     // inputFormatType a parser
     if (this->inputFormat == InputFormat::AnnexBHEVC)
     {
@@ -167,9 +201,18 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
       codec = Codec::Other;
     }
 
+    // Parse the file in the background. We only wait until the first picture (in coding order)
+    // was parsed. The parameter sets are in front of it so that we know all properties of the
+    // stream then. The frame range is set from the frames whose position in display order is final
+    // and grows while parsing is running.
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::playlistItemCompressedVideo Start parsing of file");
-    this->inputFileAnnexBParser->parseAnnexBFile(this->inputFileAnnexBLoading, mainWindow);
+    this->indexingFile   = std::make_unique<FileSourceAnnexBFile>(compressedFilePath);
+    this->indexingFuture = QtConcurrent::run(
+        [this]() { this->inputFileAnnexBParser->parseAnnexBFile(this->indexingFile); });
+    this->inputFileAnnexBParser->waitForFrameParsed(0);
+
+    auto lock = this->inputFileAnnexBParser->lockParsedData();
 
     // Get the frame size and the pixel format
     frameSize = this->inputFileAnnexBParser->getSequenceSizeSamples();
@@ -182,9 +225,10 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
     this->prop.frameRate = this->inputFileAnnexBParser->getFramerate();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo framerate "
                      << this->prop.frameRate);
-    this->prop.startEndRange = indexRange(0, int(this->inputFileAnnexBParser->getNumberPOCs() - 1));
+    this->prop.startEndRange =
+        indexRange(0, int(this->inputFileAnnexBParser->getNumberFramesIndexed()) - 1);
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo startEndRange (0,"
-                     << this->inputFileAnnexBParser->getNumberPOCs() << ")");
+                     << this->inputFileAnnexBParser->getNumberFramesIndexed() << ")");
     this->prop.sampleAspectRatio = this->inputFileAnnexBParser->getSampleAspectRatio();
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::playlistItemCompressedVideo sample aspect ratio ("
@@ -195,42 +239,42 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
     // Try ffmpeg to open the file
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::playlistItemCompressedVideo Open file using ffmpeg");
-    this->inputFileFFmpegLoading = std::make_unique<FileSourceFFmpegFile>();
-    if (!this->inputFileFFmpegLoading->openFile(compressedFilePath, mainWindow))
+    this->loadingContext.inputFileFFmpeg = std::make_unique<FileSourceFFmpegFile>();
+    auto inputFileFFmpeg                 = this->loadingContext.inputFileFFmpeg.get();
+    if (!inputFileFFmpeg->openFile(compressedFilePath, mainWindow, nullptr, true, ffmpegScanResult))
     {
       this->setError("Error opening file using libavcodec.");
       return;
     }
     // Is this file RGB or YUV?
-    this->rawFormat = this->inputFileFFmpegLoading->getRawFormat();
+    this->rawFormat = inputFileFFmpeg->getRawFormat();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Raw format "
                      << (this->rawFormat == video::RawFormat::YUV   ? "YUV"
                          : this->rawFormat == video::RawFormat::RGB ? "RGB"
                                                                     : "Unknown"));
     if (this->rawFormat == video::RawFormat::YUV)
-      formatYuv = this->inputFileFFmpegLoading->getPixelFormatYUV();
+      formatYuv = inputFileFFmpeg->getPixelFormatYUV();
     else if (this->rawFormat == video::RawFormat::RGB)
-      formatRgb = this->inputFileFFmpegLoading->getPixelFormatRGB();
+      formatRgb = inputFileFFmpeg->getPixelFormatRGB();
     else
     {
       this->setError("Unknown raw format.");
       return;
     }
-    frameSize = this->inputFileFFmpegLoading->getSequenceSizeSamples();
+    frameSize = inputFileFFmpeg->getSequenceSizeSamples();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Frame size "
                      << frameSize.width << "x" << frameSize.height);
-    this->prop.frameRate = this->inputFileFFmpegLoading->getFramerate();
+    this->prop.frameRate = inputFileFFmpeg->getFramerate();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo framerate "
                      << this->prop.frameRate);
-    this->prop.startEndRange = this->inputFileFFmpegLoading->getDecodableFrameLimits();
+    this->prop.startEndRange = inputFileFFmpeg->getDecodableFrameLimits();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo startEndRange ("
                      << this->prop.startEndRange.first << "x" << this->prop.startEndRange.second
                      << ")");
-    this->ffmpegCodec = inputFileFFmpegLoading->getVideoStreamCodecID();
+    this->ffmpegCodec = inputFileFFmpeg->getVideoStreamCodecID();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo ffmpeg codec "
                      << this->ffmpegCodec.getCodecName());
-    this->prop.sampleAspectRatio =
-        this->inputFileFFmpegLoading->getVideoCodecPar().getSampleAspectRatio();
+    this->prop.sampleAspectRatio = inputFileFFmpeg->getVideoCodecPar().getSampleAspectRatio();
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::playlistItemCompressedVideo sample aspect ratio ("
         << this->prop.sampleAspectRatio.num << "x" << this->prop.sampleAspectRatio.den << ")");
@@ -241,12 +285,11 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
     if (this->ffmpegCodec.isAV1())
       codec = Codec::AV1;
 
-    if (this->cachingEnabled)
+    for (auto &context : this->cachingContexts)
     {
       // Open the file again for caching
-      this->inputFileFFmpegCaching = std::make_unique<FileSourceFFmpegFile>();
-      if (!this->inputFileFFmpegCaching->openFile(
-              compressedFilePath, mainWindow, this->inputFileFFmpegLoading.get()))
+      context->inputFileFFmpeg = std::make_unique<FileSourceFFmpegFile>();
+      if (!context->inputFileFFmpeg->openFile(compressedFilePath, mainWindow, inputFileFFmpeg))
       {
         this->setError("Error opening file a second time using libavcodec for caching.");
         return;
@@ -350,8 +393,8 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
   if (this->rawFormat == video::RawFormat::YUV)
   {
     auto yuvVideo = this->getYUVVideo();
-    yuvVideo->showPixelValuesAsDiff =
-        loadingDecoder->isSignalDifference(loadingDecoder->getDecodeSignal());
+    yuvVideo->showPixelValuesAsDiff = this->loadingContext.decoder->isSignalDifference(
+        this->loadingContext.decoder->getDecodeSignal());
   }
 
   // Fill the list of statistics that we can provide
@@ -364,25 +407,76 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
     // No frames to decode
     return;
 
-  // Seek both decoders to the start of the bitstream (this will also push the parameter sets /
+  // Seek all decoders to the start of the bitstream (this will also push the parameter sets /
   // extradata to the decoder)
   DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Seek decoders to 0");
-  this->seekToPosition(0, 0, false);
-  if (this->cachingEnabled)
-    this->seekToPosition(0, 0, true);
+  this->seekToPosition(this->loadingContext, 0, 0);
+  for (auto &context : this->cachingContexts)
+    this->seekToPosition(*context, 0, 0);
+
+  if (this->indexingFuture.isRunning())
+    // Update the frame range regularly. The caching segments are set when parsing is done.
+    this->indexingTimer.start(1000, this);
+  else
+    this->updateCachingSegmentStarts();
 
-  // Connect signals for requesting data and statistics
+  // Connect signals for requesting data and statistics. The caching decoders are used directly
+  // from the caching threads.
   this->connect(video.get(),
                 &video::videoHandler::signalRequestRawData,
                 this,
                 &playlistItemCompressedVideo::loadRawData,
                 Qt::DirectConnection);
+  this->video->setRawDataLoader([this](int frameIdx, QByteArray &targetBuffer) {
+    return this->loadRawDataForCaching(frameIdx, targetBuffer);
+  });
   this->connect(&this->statisticsUIHandler,
                 &stats::StatisticUIHandler::updateItem,
                 this,
                 &playlistItemCompressedVideo::updateStatSource);
 }
 
+playlistItemCompressedVideo::~playlistItemCompressedVideo()
+{
+  this->stopIndexing();
+}
+
+void playlistItemCompressedVideo::stopIndexing()
+{
+  if (this->indexingFuture.isRunning())
+  {
+    this->inputFileAnnexBParser->setAbortParsing();
+    this->indexingFuture.waitForFinished();
+  }
+  this->indexingTimer.stop();
+}
+
+// This timer is running while the file is parsed in the background
+void playlistItemCompressedVideo::timerEvent(QTimerEvent *event)
+{
+  if (event->timerId() != this->indexingTimer.timerId())
+    return playlistItemWithVideo::timerEvent(event);
+
+  const auto indexingDone = !this->indexingFuture.isRunning();
+  if (indexingDone)
+  {
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::timerEvent Background parsing done");
+    this->indexingTimer.stop();
+  }
+
+  // When the first frames are indexed, the current frame may have to be drawn now
+  const auto noFramesBefore = this->prop.startEndRange.second < 0;
+  {
+    QMutexLocker locker(&this->startEndRangeMutex);
+    this->prop.startEndRange =
+        indexRange(0, int(this->inputFileAnnexBParser->getNumberFramesIndexed()) - 1);
+  }
+  const auto redraw = noFramesBefore && this->prop.startEndRange.second >= 0;
+  if (indexingDone)
+    this->updateCachingSegmentStarts();
+  emit SignalItemChanged(redraw, indexingDone ? RECACHE_UPDATE : RECACHE_NONE);
+}
+
 void playlistItemCompressedVideo::savePlaylist(QDomElement &root, const QDir &playlistDir) const
 {
   auto filename = this->properties().name;
@@ -401,14 +495,14 @@ void playlistItemCompressedVideo::savePlaylist(QDomElement &root, const QDir &pl
   d.appendProperiteChild("absolutePath", fileURL.toString());
   d.appendProperiteChild("relativePath", relativePath);
   d.appendProperiteChild("displayComponent",
-                         QString::number(loadingDecoder ? loadingDecoder->getDecodeSignal() : -1));
+                         QString::number(this->loadingContext.decoder ? this->loadingContext.decoder->getDecodeSignal() : -1));
 
   d.appendProperiteChild("inputFormat", InputFormatMapper.getName(this->inputFormat));
   d.appendProperiteChild("decoder", DecoderEngineMapper.getName(this->decoderEngine));
 
   if (this->video)
     this->video->savePlaylist(d);
-  if (this->loadingDecoder && loadingDecoder->statisticsSupported())
+  if (this->loadingContext.decoder && this->loadingContext.decoder->statisticsSupported())
   {
     auto newChild = YUViewDomElement(d.ownerDocument().createElement("StatisticsData"));
     this->statisticsData.savePlaylist(newChild);
@@ -419,8 +513,10 @@ void playlistItemCompressedVideo::savePlaylist(QDomElement &root, const QDir &pl
 }
 
 playlistItemCompressedVideo *
-playlistItemCompressedVideo::newPlaylistItemCompressedVideo(const YUViewDomElement &root,
-                                                            const QString &playlistFilePath)
+playlistItemCompressedVideo::newPlaylistItemCompressedVideo(
+    const YUViewDomElement &                root,
+    const QString &                         playlistFilePath,
+    const FileSourceFFmpegFile::ScanResult *ffmpegScanResult)
 {
   // Parse the DOM element. It should have all values of a playlistItemRawCodedVideo
   auto absolutePath  = root.findChildValue("absolutePath");
@@ -442,7 +538,8 @@ playlistItemCompressedVideo::newPlaylistItemCompressedVideo(const YUViewDomEleme
     decoder = *readDec;
 
   // We can still not be sure that the file really exists, but we gave our best to try to find it.
-  auto newFile = new playlistItemCompressedVideo(filePath, displaySignal, input, decoder);
+  auto newFile =
+      new playlistItemCompressedVideo(filePath, displaySignal, input, decoder, ffmpegScanResult);
 
   newFile->video->loadPlaylist(root);
   auto n = root.firstChild();
@@ -470,9 +567,14 @@ InfoData playlistItemCompressedVideo::getInfo() const
 
   info.items.append(InfoItem(
       "Reader", QString::fromStdString(std::string(InputFormatMapper.getName(this->inputFormat)))));
-  if (this->inputFileFFmpegLoading)
+  if (this->indexingFuture.isRunning())
+    info.items.append(InfoItem(
+        "Parsing:",
+        QString("%1%...").arg(this->inputFileAnnexBParser->getParsingProgressPercent()),
+        "The file is parsed in the background. The number of frames grows while parsing."));
+  if (this->loadingContext.inputFileFFmpeg)
   {
-    auto l = this->inputFileFFmpegLoading->getLibraryPaths();
+    auto l = this->loadingContext.inputFileFFmpeg->getLibraryPaths();
     if (l.length() % 3 == 0)
     {
       for (int i = 0; i < l.length() / 3; i++)
@@ -491,20 +593,20 @@ InfoData playlistItemCompressedVideo::getInfo() const
         InfoItem("Num POCs", QString::number(nrFrames), "The number of pictures in the stream."));
     if (this->decodingEnabled)
     {
-      auto l = loadingDecoder->getLibraryPaths();
+      auto l = this->loadingContext.decoder->getLibraryPaths();
       if (l.length() % 3 == 0)
       {
         for (int i = 0; i < l.length() / 3; i++)
           info.items.append(InfoItem(l[i * 3], l[i * 3 + 1], l[i * 3 + 2]));
       }
-      info.items.append(InfoItem("Decoder", this->loadingDecoder->getDecoderName()));
-      info.items.append(InfoItem("Decoder", this->loadingDecoder->getCodecName()));
+      info.items.append(InfoItem("Decoder", this->loadingContext.decoder->getDecoderName()));
+      info.items.append(InfoItem("Decoder", this->loadingContext.decoder->getCodecName()));
       info.items.append(InfoItem("Statistics",
-                                 this->loadingDecoder->statisticsSupported() ? "Yes" : "No",
+                                 this->loadingContext.decoder->statisticsSupported() ? "Yes" : "No",
                                  "Is the decoder able to provide internals (statistics)?"));
       info.items.append(
           InfoItem("Stat Parsing",
-                   this->loadingDecoder->statisticsEnabled() ? "Yes" : "No",
+                   this->loadingContext.decoder->statisticsEnabled() ? "Yes" : "No",
                    "Are the statistics of the sequence currently extracted from the stream?"));
     }
   }
@@ -533,9 +635,9 @@ void playlistItemCompressedVideo::infoListButtonPressed(int buttonID)
     uiDialog.ffmpegLogEdit->setPlainText(logFFmpegString);
 
     // Get the loading log
-    if (this->inputFileFFmpegLoading)
+    if (this->loadingContext.inputFileFFmpeg)
     {
-      auto    logLoading = this->inputFileFFmpegLoading->getFFmpegLoadingLog();
+      auto    logLoading = this->loadingContext.inputFileFFmpeg->getFFmpegLoadingLog();
       QString logLoadingString;
       for (const auto &l : logLoading)
         logLoadingString.append(l + "\n");
@@ -551,9 +653,10 @@ ItemLoadingState playlistItemCompressedVideo::needsLoading(int frameIdx, bool lo
   if (this->unresolvableError || !this->decodingEnabled)
     return ItemLoadingState::LoadingNotNeeded;
 
-  auto videoState = this->video->needsLoading(frameIdx, loadRawData);
-  if (videoState == ItemLoadingState::LoadingNeeded && this->decodingNotPossibleAfter >= 0 &&
-      frameIdx >= this->decodingNotPossibleAfter && frameIdx >= this->currentFrameIdx[0])
+  auto       videoState               = this->video->needsLoading(frameIdx, loadRawData);
+  const auto decodingNotPossibleAfter = this->loadingContext.decodingNotPossibleAfter.load();
+  if (videoState == ItemLoadingState::LoadingNeeded && decodingNotPossibleAfter >= 0 &&
+      frameIdx >= decodingNotPossibleAfter && frameIdx >= this->loadingContext.currentFrameIdx)
     // The decoder can not decode this frame.
     return ItemLoadingState::LoadingNotNeeded;
   if (videoState == ItemLoadingState::LoadingNeeded ||
@@ -567,8 +670,9 @@ void playlistItemCompressedVideo::drawItem(QPainter *painter,
                                            double    zoomFactor,
                                            bool      drawRawData)
 {
-  const auto range = this->properties().startEndRange;
-  if (this->decodingNotPossibleAfter >= 0 && frameIdx >= this->decodingNotPossibleAfter)
+  const auto range                    = this->properties().startEndRange;
+  const auto decodingNotPossibleAfter = this->loadingContext.decodingNotPossibleAfter.load();
+  if (decodingNotPossibleAfter >= 0 && frameIdx >= decodingNotPossibleAfter)
   {
     this->infoText = "Decoding of the frame not possible:\n";
     this->infoText +=
@@ -580,7 +684,7 @@ void playlistItemCompressedVideo::drawItem(QPainter *painter,
   {
     playlistItem::drawItem(painter, -1, zoomFactor, drawRawData);
   }
-  else if (!this->loadingDecoder)
+  else if (!this->loadingContext.decoder)
   {
     this->infoText = "No decoder allocated.\n";
     playlistItem::drawItem(painter, -1, zoomFactor, drawRawData);
@@ -594,37 +698,86 @@ void playlistItemCompressedVideo::drawItem(QPainter *painter,
 
 void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
 {
-  if (caching && !this->cachingEnabled)
+  if (caching)
+  {
+    // The caching decoders are normally used through the raw data loader. Just in case.
+    QByteArray data;
+    if (this->loadRawDataForCaching(frameIdx, data))
+    {
+      this->video->rawData            = data;
+      this->video->rawData_frameIndex = frameIdx;
+    }
     return;
-  if (!caching && this->loadingDecoder->state() == decoder::DecoderState::Error)
+  }
+
+  const auto newFrameDecoded = frameIdx != this->loadingContext.currentFrameIdx;
+  if (this->decodeFrame(this->loadingContext, frameIdx, false))
+  {
+    if (this->loadingContext.decoder->statisticsEnabled())
+    {
+      // The decoder adds all statistics of a newly decoded frame. Statistics of this frame that
+      // were restored from the cache must not be added to.
+      if (newFrameDecoded)
+        this->statisticsData.resetFrame(frameIdx);
+      else
+        this->statisticsData.setFrameIndex(frameIdx);
+    }
+    this->video->rawData            = this->loadingContext.decoder->getRawFrameData();
+    this->video->rawData_frameIndex = frameIdx;
+  }
+  else if (this->loadingContext.decodingNotPossibleAfter >= 0 &&
+           frameIdx >= this->loadingContext.decodingNotPossibleAfter)
+    // Just set the frame number of the buffer to the current frame so that it will trigger a
+    // reload when the frame number changes.
+    this->video->rawData_frameIndex = frameIdx;
+}
+
+bool playlistItemCompressedVideo::decodeFrame(DecodingContext &context, int frameIdx, bool caching)
+{
+  auto dec = context.decoder.get();
+  if (!dec)
+    return false;
+  if (!caching && dec->state() == decoder::DecoderState::Error)
   {
-    if (frameIdx < this->currentFrameIdx[0])
+    if (frameIdx < context.currentFrameIdx)
     {
       // There was an error in the loading decoder but we will seek backwards so maybe this will
       // work again
     }
     else
-      return;
+      return false;
   }
-  if (caching && this->cachingDecoder->state() == decoder::DecoderState::Error)
-    return;
+  if (caching && dec->state() == decoder::DecoderState::Error)
+    return false;
 
-  DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData " << frameIdx
+  DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame " << frameIdx
                                                                << (caching ? " caching" : ""));
 
-  if (frameIdx > this->properties().startEndRange.second || frameIdx < 0)
+  if (frameIdx > this->getStartEndRange().second || frameIdx < 0)
   {
-    DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData Invalid frame index");
-    return;
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame Invalid frame index");
+    return false;
+  }
+
+  // While the file is parsed in the background, we can only seek to frames that were parsed
+  if (isInputFormatTypeAnnexB(this->inputFormat) &&
+      !this->inputFileAnnexBParser->waitForFrameIndexed(unsigned(frameIdx)))
+  {
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame Frame not in bitstream");
+    return false;
   }
 
-  // Get the right decoder
-  const auto dec         = caching ? this->cachingDecoder.get() : this->loadingDecoder.get();
-  const auto curFrameIdx = caching ? this->currentFrameIdx[1] : this->currentFrameIdx[0];
+  const auto curFrameIdx = context.currentFrameIdx;
+
+  // The thread budget changes when playback starts or stops. A caching decoder that was created
+  // with a different budget is recreated at the next random access point.
+  const auto budgetChanged =
+      caching &&
+      context.decoderThreads != functions::getThreadBudget().getDecoderThreads(caching);
 
   // Should we seek?
   if (curFrameIdx == -1 || frameIdx < curFrameIdx ||
-      frameIdx > curFrameIdx + FORWARD_SEEK_THRESHOLD)
+      frameIdx > curFrameIdx + FORWARD_SEEK_THRESHOLD || budgetChanged)
   {
     // Definitely seek when we have to go backwards
     bool seek = curFrameIdx == -1 || (frameIdx < curFrameIdx);
@@ -642,12 +795,8 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
     }
     else
     {
-      if (caching)
-        std::tie(seekToDTS, seekToFrame) =
-            this->inputFileFFmpegCaching->getClosestSeekableFrameBefore(frameIdx);
-      else
-        std::tie(seekToDTS, seekToFrame) =
-            this->inputFileFFmpegLoading->getClosestSeekableFrameBefore(frameIdx);
+      std::tie(seekToDTS, seekToFrame) =
+          context.inputFileFFmpeg->getClosestSeekableFrameBefore(frameIdx);
 
       // The distance in the display order unfortunately does not tell us
       // too much about the number of frames that must be decoded to seek
@@ -656,48 +805,72 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
         seek = true;
     }
 
+    if (budgetChanged)
+    {
+      // The closest seek point of the AnnexB parser is always before the requested frame, so a
+      // random access point at the requested frame is looked up directly.
+      auto frameIsRandomAccessPoint = seekToFrame == size_t(frameIdx);
+      if (isInputFormatTypeAnnexB(this->inputFormat))
+      {
+        const auto randomAccessPoints =
+            this->inputFileAnnexBParser->getRandomAccessPointsDisplayOrder();
+        frameIsRandomAccessPoint =
+            std::find(randomAccessPoints.begin(),
+                      randomAccessPoints.end(),
+                      parser::FrameIndexDisplayOrder(frameIdx)) != randomAccessPoints.end();
+      }
+
+      if (const auto startFrame = functions::getFrameToRecreateDecoderAt(
+              unsigned(frameIdx), frameIsRandomAccessPoint, seek, unsigned(seekToFrame)))
+      {
+        DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame recreating caching decoder");
+        context.decoder = this->createDecoder(dec->getDecodeSignal(), true, context);
+        dec             = context.decoder.get();
+        if (!dec)
+          return false;
+        seek        = true;
+        seekToFrame = *startFrame;
+      }
+    }
+
     if (seek)
     {
       // Seek and update the frame counters. The seekToPosition function will update the
-      // currentFrameIdx[] indices
-      this->readAnnexBFrameCounterCodingOrder = int(seekToFrame);
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData seeking to frame "
+      // currentFrameIdx of the context.
+      context.readAnnexBFrameCounterCodingOrder = int(seekToFrame);
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame seeking to frame "
                        << seekToFrame << " PTS " << seekToDTS << " AnnexBCnt "
-                       << this->readAnnexBFrameCounterCodingOrder);
-      this->seekToPosition(this->readAnnexBFrameCounterCodingOrder, seekToDTS, caching);
+                       << context.readAnnexBFrameCounterCodingOrder);
+      this->seekToPosition(context, context.readAnnexBFrameCounterCodingOrder, seekToDTS);
     }
   }
 
   // Decode until we get the right frame from the decoder
-  bool rightFrame =
-      caching ? this->currentFrameIdx[1] == frameIdx : this->currentFrameIdx[0] == frameIdx;
+  bool rightFrame = context.currentFrameIdx == frameIdx;
   while (!rightFrame)
   {
     while (dec->state() == decoder::DecoderState::NeedsMoreData)
     {
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData decoder needs more data");
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame decoder needs more data");
       if (isInputFormatTypeFFmpeg(this->inputFormat) &&
           this->decoderEngine == DecoderEngine::FFMpeg)
       {
         // In this scenario, we can read and push AVPackets
         // from the FFmpeg file and pass them to the FFmpeg decoder directly.
-        auto pkt   = caching ? this->inputFileFFmpegCaching->getNextPacket(repushData)
-                             : this->inputFileFFmpegLoading->getNextPacket(repushData);
-        repushData = false;
+        auto pkt           = context.inputFileFFmpeg->getNextPacket(context.repushData);
+        context.repushData = false;
         if (pkt)
-          DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData retrieved packet PTS "
+          DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame retrieved packet PTS "
                            << pkt.getPTS());
         else
-          DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData retrieved empty packet");
-        auto ffmpegDec =
-            (caching ? dynamic_cast<decoder::decoderFFmpeg *>(this->cachingDecoder.get())
-                     : dynamic_cast<decoder::decoderFFmpeg *>(this->loadingDecoder.get()));
+          DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame retrieved empty packet");
+        auto ffmpegDec = dynamic_cast<decoder::decoderFFmpeg *>(dec);
         if (!ffmpegDec->pushAVPacket(pkt))
         {
           if (ffmpegDec->state() != decoder::DecoderState::RetrieveFrames)
             // The decoder did not switch to decoding frame mode. Error.
-            return;
-          this->repushData = true;
+            return false;
+          context.repushData = true;
         }
       }
       else if (isInputFormatTypeAnnexB(this->inputFormat) &&
@@ -705,28 +878,27 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
       {
         // We are reading from a raw annexB file and use ffmpeg for decoding
         QByteArray data;
-        if (this->readAnnexBFrameCounterCodingOrder >= 0 &&
-            unsigned(this->readAnnexBFrameCounterCodingOrder) >=
-                this->inputFileAnnexBParser->getNumberPOCs())
+        if (context.readAnnexBFrameCounterCodingOrder >= 0 &&
+            !this->inputFileAnnexBParser->waitForFrameParsed(
+                unsigned(context.readAnnexBFrameCounterCodingOrder)))
         {
-          DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData EOF");
+          DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame EOF");
         }
         else
         {
           // Get the data of the next frame (which might be multiple NAL units)
           auto frameStartEndFilePos = this->inputFileAnnexBParser->getFrameStartEndPos(
-              this->readAnnexBFrameCounterCodingOrder);
+              context.readAnnexBFrameCounterCodingOrder);
           Q_ASSERT_X(frameStartEndFilePos,
-                     "playlistItemCompressedVideo::loadRawData",
+                     "playlistItemCompressedVideo::decodeFrame",
                      "frameStartEndFilePos could not be retrieved. This should always work for a "
                      "raw AnnexB file.");
 
-          data = caching ? this->inputFileAnnexBCaching->getFrameData(*frameStartEndFilePos)
-                         : this->inputFileAnnexBLoading->getFrameData(*frameStartEndFilePos);
+          data = context.inputFileAnnexB->getFrameData(*frameStartEndFilePos);
           DEBUG_COMPRESSED(
-              "playlistItemCompressedVideo::loadRawData retrieved frame data from file "
+              "playlistItemCompressedVideo::decodeFrame retrieved frame data from file "
               "- AnnexBCnt "
-              << this->readAnnexBFrameCounterCodingOrder << " startEnd "
+              << context.readAnnexBFrameCounterCodingOrder << " startEnd "
               << frameStartEndFilePos->first << "-" << frameStartEndFilePos->second << " - size "
               << data.size());
         }
@@ -735,9 +907,9 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
         {
           if (dec->state() != decoder::DecoderState::RetrieveFrames)
           {
-            DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData The decoder did not switch "
+            DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame The decoder did not switch "
                              "to decoding frame mode. Error.");
-            this->decodingNotPossibleAfter = frameIdx;
+            context.decodingNotPossibleAfter = frameIdx;
             break;
           }
           // Pushing the data failed because the ffmpeg decoder wants us to read frames first.
@@ -745,28 +917,26 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
           // again.
         }
         else
-          this->readAnnexBFrameCounterCodingOrder++;
+          context.readAnnexBFrameCounterCodingOrder++;
       }
       else if (isInputFormatTypeAnnexB(this->inputFormat) &&
                this->decoderEngine != DecoderEngine::FFMpeg)
       {
-        auto data = caching ? this->inputFileAnnexBCaching->getNextNALUnit(repushData)
-                            : this->inputFileAnnexBLoading->getNextNALUnit(repushData);
+        auto data = context.inputFileAnnexB->getNextNALUnit(context.repushData);
         DEBUG_COMPRESSED(
-            "playlistItemCompressedVideo::loadRawData retrieved nal unit from file - size "
+            "playlistItemCompressedVideo::decodeFrame retrieved nal unit from file - size "
             << data.size());
-        this->repushData = !dec->pushData(data);
+        context.repushData = !dec->pushData(data);
       }
       else if (isInputFormatTypeFFmpeg(this->inputFormat) &&
                this->decoderEngine != DecoderEngine::FFMpeg)
       {
         // Get the next unit (NAL or OBU) form ffmepg and push it to the decoder
-        auto data = caching ? this->inputFileFFmpegCaching->getNextUnit(repushData)
-                            : this->inputFileFFmpegLoading->getNextUnit(repushData);
+        auto data = context.inputFileFFmpeg->getNextUnit(context.repushData);
         DEBUG_COMPRESSED(
-            "playlistItemCompressedVideo::loadRawData retrieved nal unit from file - size "
+            "playlistItemCompressedVideo::decodeFrame retrieved nal unit from file - size "
             << data.size());
-        this->repushData = !dec->pushData(data);
+        context.repushData = !dec->pushData(data);
       }
       else
         assert(false);
@@ -776,64 +946,117 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
     {
       if (dec->decodeNextFrame())
       {
-        if (caching)
-          this->currentFrameIdx[1]++;
-        else
-          this->currentFrameIdx[0]++;
-
-        DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData decoded frame "
-                         << (caching ? this->currentFrameIdx[1] : this->currentFrameIdx[0]));
-        rightFrame =
-            caching ? this->currentFrameIdx[1] == frameIdx : this->currentFrameIdx[0] == frameIdx;
-        if (rightFrame)
-        {
-          if (dec->statisticsEnabled())
-            this->statisticsData.setFrameIndex(frameIdx);
-          this->video->rawData            = dec->getRawFrameData();
-          this->video->rawData_frameIndex = frameIdx;
-        }
+        context.currentFrameIdx++;
+        DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame decoded frame "
+                         << context.currentFrameIdx);
+        rightFrame = context.currentFrameIdx == frameIdx;
       }
     }
 
     if (dec->state() != decoder::DecoderState::NeedsMoreData &&
         dec->state() != decoder::DecoderState::RetrieveFrames)
     {
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData decoder neither needs more data "
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame decoder neither needs more data "
                        "nor can decode frames");
-      this->decodingNotPossibleAfter = frameIdx;
+      context.decodingNotPossibleAfter = frameIdx;
       break;
     }
   }
 
-  if (this->decodingNotPossibleAfter >= 0 && frameIdx >= this->decodingNotPossibleAfter)
+  if (!rightFrame && context.decodingNotPossibleAfter >= 0 &&
+      frameIdx >= context.decodingNotPossibleAfter)
   {
     // The specified frame (which is thoretically in the bitstream) can not be decoded.
     // Maybe the bitstream was cut at a position that it was not supposed to be cut at.
-    if (caching)
-      this->currentFrameIdx[1] = frameIdx;
-    else
-      this->currentFrameIdx[0] = frameIdx;
-    // Just set the frame number of the buffer to the current frame so that it will trigger a
-    // reload when the frame number changes.
-    this->video->rawData_frameIndex = frameIdx;
+    context.currentFrameIdx = frameIdx;
+    if (!caching)
+      emit signalDecodingNotPossibleAfter(frameIdx);
+    return false;
   }
-  else if (this->loadingDecoder->state() == decoder::DecoderState::Error)
-  {
-    this->infoText = "There was an error in the decoder: \n";
-    this->infoText += this->loadingDecoder->decoderErrorString();
-    this->infoText += "\n";
+  if (!caching && dec->state() == decoder::DecoderState::Error)
+    emit signalDecodingError("There was an error in the decoder: \n" + dec->decoderErrorString() +
+                             "\n");
 
-    this->decodingEnabled = false;
+  return rightFrame;
+}
+
+void playlistItemCompressedVideo::slotDecodingError(QString error)
+{
+  if (!this->decodingEnabled)
+    // Keep the first error
+    return;
+
+  this->setDecodingError(error);
+  emit SignalItemChanged(true, RECACHE_NONE);
+}
+
+void playlistItemCompressedVideo::slotDecodingNotPossibleAfter(int frameIdx)
+{
+  // The loading context keeps the failure until it seeks. Redraw to show the error.
+  DEBUG_COMPRESSED("playlistItemCompressedVideo::slotDecodingNotPossibleAfter " << frameIdx);
+  emit SignalItemChanged(true, RECACHE_NONE);
+}
+
+indexRange playlistItemCompressedVideo::getStartEndRange() const
+{
+  QMutexLocker locker(&this->startEndRangeMutex);
+  return this->prop.startEndRange;
+}
+
+playlistItemCompressedVideo::DecodingContext *
+playlistItemCompressedVideo::lockCachingContext(int frameIdx)
+{
+  if (this->cachingContexts.empty())
+    return nullptr;
+
+  // Is there a context that just decoded a frame shortly before the requested one?
+  for (auto &context : this->cachingContexts)
+  {
+    const auto curFrameIdx = context->currentFrameIdx;
+    if (curFrameIdx >= 0 && frameIdx > curFrameIdx &&
+        frameIdx <= curFrameIdx + FORWARD_SEEK_THRESHOLD && context->mutex.tryLock())
+    {
+      // The context could have been used by another thread before we locked it
+      if (context->currentFrameIdx == curFrameIdx)
+        return context.get();
+      context->mutex.unlock();
+    }
   }
+
+  // Use any context that is free. There are not more caching threads for this item than caching
+  // contexts but in the conversion speed test, there may be.
+  for (auto &context : this->cachingContexts)
+    if (context->mutex.tryLock())
+      return context.get();
+
+  auto context = this->cachingContexts.front().get();
+  context->mutex.lock();
+  return context;
+}
+
+bool playlistItemCompressedVideo::loadRawDataForCaching(int frameIdx, QByteArray &targetBuffer)
+{
+  auto context = this->lockCachingContext(frameIdx);
+  if (context == nullptr)
+    return false;
+
+  const auto frameDecoded = this->decodeFrame(*context, frameIdx, true);
+  if (frameDecoded)
+    targetBuffer = context->decoder->getRawFrameData();
+
+  context->mutex.unlock();
+  return frameDecoded;
 }
 
-void playlistItemCompressedVideo::seekToPosition(int seekToFrame, int64_t seekToDTS, bool caching)
+void playlistItemCompressedVideo::seekToPosition(DecodingContext &context,
+                                                 int              seekToFrame,
+                                                 int64_t          seekToDTS)
 {
   // Do the seek
-  auto dec = caching ? this->cachingDecoder.get() : this->loadingDecoder.get();
+  auto dec = context.decoder.get();
   dec->resetDecoder();
-  this->repushData               = false;
-  this->decodingNotPossibleAfter = -1;
+  context.repushData               = false;
+  context.decodingNotPossibleAfter = -1;
 
   // Retrieval of the raw metadata is only required if the the reader or the decoder is not ffmpeg
   const bool bothFFmpeg =
@@ -862,22 +1085,15 @@ void playlistItemCompressedVideo::seekToPosition(int seekToFrame, int64_t seekTo
     }
     DEBUG_COMPRESSED("playlistItemCompressedVideo::seekToPosition seeking annexB file to filePos "
                      << filePos);
-    if (caching)
-      this->inputFileAnnexBCaching->seek(filePos);
-    else
-      this->inputFileAnnexBLoading->seek(filePos);
+    context.inputFileAnnexB->seek(filePos);
   }
   else
   {
     if (!bothFFmpeg)
-      parametersets = caching ? this->inputFileFFmpegCaching->getParameterSets()
-                              : this->inputFileFFmpegLoading->getParameterSets();
+      parametersets = context.inputFileFFmpeg->getParameterSets();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::seekToPosition seeking ffmpeg file to pts "
                      << seekToDTS);
-    if (caching)
-      this->inputFileFFmpegCaching->seekToDTS(seekToDTS);
-    else
-      this->inputFileFFmpegLoading->seekToDTS(seekToDTS);
+    context.inputFileFFmpeg->seekToDTS(seekToDTS);
   }
 
   // In case of using ffmpeg for decoding, we don't need to push the parameter sets (the
@@ -891,14 +1107,42 @@ void playlistItemCompressedVideo::seekToPosition(int seekToFrame, int64_t seekTo
     for (QByteArray d : parametersets)
       if (!dec->pushData(d))
       {
-        setDecodingError("Error when seeking in file.");
+        emit signalDecodingError("Error when seeking in file.");
         return;
       }
   }
-  if (caching)
-    this->currentFrameIdx[1] = seekToFrame - 1;
-  else
-    this->currentFrameIdx[0] = seekToFrame - 1;
+  context.currentFrameIdx = seekToFrame - 1;
+}
+
+void playlistItemCompressedVideo::updateCachingSegmentStarts()
+{
+  this->cachingSegmentStarts.clear();
+  if (this->cachingContexts.size() <= 1)
+    return;
+
+  if (isInputFormatTypeAnnexB(this->inputFormat))
+  {
+    // When seeking to a frame, the parser returns the last random access point before it. So the
+    // first frame after a random access point is the first frame that is decoded from there.
+    for (auto rapIdx : this->inputFileAnnexBParser->getRandomAccessPointsDisplayOrder())
+      if (rapIdx > 0 && int(rapIdx) + 1 <= this->properties().startEndRange.second)
+        this->cachingSegmentStarts.push_back(int(rapIdx) + 1);
+  }
+  else if (this->loadingContext.inputFileFFmpeg)
+  {
+    for (auto keyFrameIdx : this->loadingContext.inputFileFFmpeg->getKeyFrameIndices())
+      if (keyFrameIdx > 0 && int(keyFrameIdx) <= this->properties().startEndRange.second)
+        this->cachingSegmentStarts.push_back(int(keyFrameIdx));
+  }
+}
+
+std::vector<int> playlistItemCompressedVideo::getCachingSegmentStarts(indexRange range) const
+{
+  std::vector<int> starts;
+  for (auto start : this->cachingSegmentStarts)
+    if (start > range.first && start <= range.second)
+      starts.push_back(start);
+  return starts;
 }
 
 void playlistItemCompressedVideo::createPropertiesWidget()
@@ -934,10 +1178,10 @@ void playlistItemCompressedVideo::createPropertiesWidget()
       6, this->statisticsUIHandler.createStatisticsHandlerControls(), 1);
 
   // Set the components that we can display
-  if (loadingDecoder)
+  if (this->loadingContext.decoder)
   {
-    ui.comboBoxDisplaySignal->addItems(loadingDecoder->getSignalNames());
-    ui.comboBoxDisplaySignal->setCurrentIndex(loadingDecoder->getDecodeSignal());
+    ui.comboBoxDisplaySignal->addItems(this->loadingContext.decoder->getSignalNames());
+    ui.comboBoxDisplaySignal->setCurrentIndex(this->loadingContext.decoder->getDecodeSignal());
   }
   // Add decoders we can use
   for (auto e : possibleDecoders)
@@ -960,136 +1204,105 @@ void playlistItemCompressedVideo::createPropertiesWidget()
 bool playlistItemCompressedVideo::allocateDecoder(int displayComponent)
 {
   // Reset (existing) decoders
-  this->loadingDecoder.reset();
-  this->cachingDecoder.reset();
+  this->loadingContext.decoder.reset();
+  for (auto &context : this->cachingContexts)
+    context->decoder.reset();
+
+  this->loadingContext.decoder = this->createDecoder(displayComponent, false, this->loadingContext);
+  if (!this->loadingContext.decoder)
+  {
+    this->infoText        = "No valid decoder was selected.";
+    this->decodingEnabled = false;
+    return false;
+  }
+  for (auto &context : this->cachingContexts)
+    context->decoder = this->createDecoder(displayComponent, true, *context);
+
+  this->decodingEnabled = this->loadingContext.decoder->state() != decoder::DecoderState::Error;
+  if (!decodingEnabled)
+  {
+    this->infoText = "There was an error allocating the new decoder: \n";
+    this->infoText += this->loadingContext.decoder->decoderErrorString();
+    this->infoText += "\n";
+    return false;
+  }
+
+  return true;
+}
 
+std::unique_ptr<decoder::decoderBase> playlistItemCompressedVideo::createDecoder(
+    int displayComponent, bool cachingDecoder, DecodingContext &context)
+{
+  context.decoderThreads = functions::getThreadBudget().getDecoderThreads(cachingDecoder);
   if (this->decoderEngine == DecoderEngine::Libde265)
   {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive libde265 decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderLibde265>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder Initializing caching libde265 decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderLibde265>(displayComponent, true);
-    }
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                     << (cachingDecoder ? "caching" : "interactive") << " libde265 decoder");
+    return std::make_unique<decoder::decoderLibde265>(displayComponent, cachingDecoder);
   }
-  else if (this->decoderEngine == DecoderEngine::HM)
+  if (this->decoderEngine == DecoderEngine::HM)
   {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive HM decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderHM>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder caching interactive HM decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderHM>(displayComponent, true);
-    }
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                     << (cachingDecoder ? "caching" : "interactive") << " HM decoder");
+    return std::make_unique<decoder::decoderHM>(displayComponent, cachingDecoder);
   }
-  else if (this->decoderEngine == DecoderEngine::VTM)
+  if (this->decoderEngine == DecoderEngine::VTM)
   {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive VTM decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderVTM>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder caching interactive VTM decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderVTM>(displayComponent, true);
-    }
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                     << (cachingDecoder ? "caching" : "interactive") << " VTM decoder");
+    return std::make_unique<decoder::decoderVTM>(displayComponent, cachingDecoder);
   }
-  else if (this->decoderEngine == DecoderEngine::VVDec)
+  if (this->decoderEngine == DecoderEngine::VVDec)
   {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive VVDec decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderVVDec>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder caching interactive VVDec decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderVVDec>(displayComponent, true);
-    }
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                     << (cachingDecoder ? "caching" : "interactive") << " VVDec decoder");
+    return std::make_unique<decoder::decoderVVDec>(displayComponent, cachingDecoder);
   }
-  else if (this->decoderEngine == DecoderEngine::Dav1d)
+  if (this->decoderEngine == DecoderEngine::Dav1d)
   {
-    DEBUG_COMPRESSED(
-        "playlistItemCompressedVideo::allocateDecoder Initializing interactive dav1d decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderDav1d>(displayComponent);
-    if (this->cachingEnabled)
-    {
-      DEBUG_COMPRESSED(
-          "playlistItemCompressedVideo::allocateDecoder caching interactive dav1d decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderDav1d>(displayComponent, true);
-    }
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                     << (cachingDecoder ? "caching" : "interactive") << " dav1d decoder");
+    return std::make_unique<decoder::decoderDav1d>(displayComponent, cachingDecoder);
   }
-  else if (this->decoderEngine == DecoderEngine::FFMpeg)
+  if (this->decoderEngine == DecoderEngine::FFMpeg)
   {
     if (isInputFormatTypeAnnexB(this->inputFormat))
     {
+      // The file may still be parsed in the background
+      auto lock         = this->inputFileAnnexBParser->lockParsedData();
       auto frameSize    = this->inputFileAnnexBParser->getSequenceSizeSamples();
       auto extradata    = this->inputFileAnnexBParser->getExtradata();
       auto fmt          = this->inputFileAnnexBParser->getPixelFormat();
       auto profileLevel = this->inputFileAnnexBParser->getProfileLevel();
       auto ratio        = this->inputFileAnnexBParser->getSampleAspectRatio();
 
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing interactive "
-                       "ffmpeg decoder from raw anexB stream. frameSize "
-                       << frameSize.width << "x" << frameSize.height << " extradata length "
-                       << extradata.length() << " PixelFormatYUV "
-                       << QString::fromStdString(fmt.getName()) << " profile/level "
-                       << profileLevel.first << "/" << profileLevel.second << ", aspect raio "
-                       << ratio.num << "/" << ratio.den);
-      this->loadingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-          ffmpegCodec, frameSize, extradata, fmt, profileLevel, ratio);
-      if (this->cachingEnabled)
-      {
-        DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing caching ffmpeg "
-                         "decoder from raw anexB stream. Same settings.");
-        this->cachingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-            ffmpegCodec, frameSize, extradata, fmt, profileLevel, ratio, true);
-      }
-    }
-    else
-    {
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing interactive "
-                       "ffmpeg decoder using ffmpeg as parser");
-      this->loadingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-          this->inputFileFFmpegLoading->getVideoCodecPar());
-      if (this->cachingEnabled)
-      {
-        DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing caching ffmpeg "
-                         "decoder using ffmpeg as parser");
-        this->cachingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-            this->inputFileFFmpegCaching->getVideoCodecPar());
-      }
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                       << (cachingDecoder ? "caching" : "interactive")
+                       << " ffmpeg decoder from raw anexB stream. frameSize " << frameSize.width
+                       << "x" << frameSize.height << " extradata length " << extradata.length()
+                       << " PixelFormatYUV " << QString::fromStdString(fmt.getName())
+                       << " profile/level " << profileLevel.first << "/" << profileLevel.second
+                       << ", aspect raio " << ratio.num << "/" << ratio.den);
+      return std::make_unique<decoder::decoderFFmpeg>(
+          ffmpegCodec, frameSize, extradata, fmt, profileLevel, ratio, cachingDecoder);
     }
-  }
-  else
-  {
-    this->infoText        = "No valid decoder was selected.";
-    this->decodingEnabled = false;
-    return false;
-  }
 
-  this->decodingEnabled = this->loadingDecoder->state() != decoder::DecoderState::Error;
-  if (!decodingEnabled)
-  {
-    this->infoText = "There was an error allocating the new decoder: \n";
-    this->infoText += loadingDecoder->decoderErrorString();
-    this->infoText += "\n";
-    return false;
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::createDecoder Initializing "
+                     << (cachingDecoder ? "caching" : "interactive")
+                     << " ffmpeg decoder using ffmpeg as parser");
+    return std::make_unique<decoder::decoderFFmpeg>(context.inputFileFFmpeg->getVideoCodecPar(),
+                                                    cachingDecoder);
   }
 
-  return true;
+  return {};
 }
 
 void playlistItemCompressedVideo::fillStatisticList()
 {
-  if (!this->loadingDecoder || !this->loadingDecoder->statisticsSupported())
+  if (!this->loadingContext.decoder || !this->loadingContext.decoder->statisticsSupported())
     return;
 
-  this->loadingDecoder->fillStatisticList(this->statisticsData);
+  this->loadingContext.decoder->fillStatisticList(this->statisticsData);
 }
 
 void playlistItemCompressedVideo::loadStatistics(int frameIdx)
@@ -1097,26 +1310,30 @@ void playlistItemCompressedVideo::loadStatistics(int frameIdx)
   DEBUG_COMPRESSED("playlistItemCompressedVideo::loadStatisticToCache Request statistics for frame "
                    << frameIdx);
 
-  if (!this->loadingDecoder->statisticsSupported())
+  if (!this->loadingContext.decoder->statisticsSupported())
     return;
-  if (!this->loadingDecoder->statisticsEnabled())
+  if (!this->loadingContext.decoder->statisticsEnabled())
   {
     // We have to enable collecting of statistics in the decoder. By default (for speed reasons)
     // this is off. Enabeling works like this: Enable collection, reset the decoder and decode the
     // current frame again. Statisitcs are always retrieved for the loading decoder.
-    this->loadingDecoder->enableStatisticsRetrieval(&this->statisticsData);
+    this->loadingContext.decoder->enableStatisticsRetrieval(&this->statisticsData);
     DEBUG_COMPRESSED("playlistItemCompressedVideo::loadStatistics Enable loading of stats frame "
                      << frameIdx);
 
     // Reload the current frame (force a seek and decode operation)
-    int frameToLoad          = this->currentFrameIdx[0];
-    this->currentFrameIdx[0] = -1;
+    int frameToLoad          = this->loadingContext.currentFrameIdx;
+    this->loadingContext.currentFrameIdx = -1;
     this->loadRawData(frameToLoad, false);
 
     // The statistics should now be loaded
   }
-  else if (frameIdx != this->currentFrameIdx[0])
+  else if (frameIdx != this->loadingContext.currentFrameIdx)
   {
+    // The statistics of recently decoded frames are cached
+    if (this->statisticsData.restoreFrameFromCache(frameIdx))
+      return;
+
     // If the requested frame is not currently decoded, decode it.
     // This can happen if the picture was gotten from the cache.
     DEBUG_COMPRESSED(
@@ -1131,7 +1348,7 @@ ValuePairListSets playlistItemCompressedVideo::getPixelValues(const QPoint &pixe
   ValuePairListSets newSet;
 
   newSet.append("YUV", this->video->getPixelValues(pixelPos, frameIdx));
-  if (this->loadingDecoder->statisticsSupported() && this->loadingDecoder->statisticsEnabled())
+  if (this->loadingContext.decoder->statisticsSupported() && this->loadingContext.decoder->statisticsEnabled())
     newSet.append("Stats", this->statisticsData.getValuesAt(pixelPos));
 
   return newSet;
@@ -1200,6 +1417,20 @@ void playlistItemCompressedVideo::getSupportedFileExtensions(QStringList &allExt
   filters.append(filtersString);
 }
 
+std::optional<FileSourceFFmpegFile::ScanResult> playlistItemCompressedVideo::prepareFile(
+    const QString &                                   compressedFilePath,
+    InputFormat                                       input,
+    const FileSourceFFmpegFile::ScanProgressCallback &progressCallback)
+{
+  if (input == InputFormat::Invalid)
+    input = getInputFormatFromFileExtension(compressedFilePath);
+
+  // AnnexB files are parsed in the background after the item was created
+  if (!isInputFormatTypeFFmpeg(input))
+    return {};
+  return FileSourceFFmpegFile::scanFile(compressedFilePath, progressCallback);
+}
+
 void playlistItemCompressedVideo::reloadItemSource()
 {
   // TODO: The caching decoder must also be reloaded
@@ -1222,10 +1453,9 @@ void playlistItemCompressedVideo::cacheFrame(int frameIdx, bool testMode)
   if (!this->cachingEnabled)
     return;
 
-  // Cache a certain frame. This is always called in a separate thread.
-  this->cachingMutex.lock();
+  // Cache a certain frame. This is always called in a separate thread. The video handler will get
+  // the raw data from one of the caching decoders (see loadRawDataForCaching).
   this->video->cacheFrame(frameIdx, testMode);
-  this->cachingMutex.unlock();
 }
 
 void playlistItemCompressedVideo::loadFrame(int  frameIdx,
@@ -1266,7 +1496,7 @@ void playlistItemCompressedVideo::loadFrame(int  frameIdx,
   {
     // Load the next frame into the double buffer
     int nextFrameIdx = frameIdx + 1;
-    if (nextFrameIdx <= this->properties().startEndRange.second)
+    if (nextFrameIdx <= this->getStartEndRange().second)
     {
       DEBUG_COMPRESSED("playlistItplaylistItemCompressedVideoemRawFile::loadFrame loading frame "
                        "into double buffer "
@@ -1282,26 +1512,33 @@ void playlistItemCompressedVideo::loadFrame(int  frameIdx,
 
 void playlistItemCompressedVideo::displaySignalComboBoxChanged(int idx)
 {
-  if (this->loadingDecoder && idx != this->loadingDecoder->getDecodeSignal())
+  if (this->loadingContext.decoder && idx != this->loadingContext.decoder->getDecodeSignal())
   {
     bool resetDecoder = false;
-    this->loadingDecoder->setDecodeSignal(idx, resetDecoder);
-    this->cachingDecoder->setDecodeSignal(idx, resetDecoder);
-
+    this->loadingContext.decoder->setDecodeSignal(idx, resetDecoder);
     if (resetDecoder)
     {
-      this->loadingDecoder->resetDecoder();
-      this->cachingDecoder->resetDecoder();
+      this->loadingContext.decoder->resetDecoder();
+      // Reset the decoded frame index so that decoding of the current frame is triggered
+      this->loadingContext.currentFrameIdx = -1;
+    }
 
-      // Reset the decoded frame indices so that decoding of the current frame is triggered
-      this->currentFrameIdx[0] = -1;
-      this->currentFrameIdx[1] = -1;
+    for (auto &context : this->cachingContexts)
+    {
+      QMutexLocker locker(&context->mutex);
+      bool         resetCachingDecoder = false;
+      context->decoder->setDecodeSignal(idx, resetCachingDecoder);
+      if (resetCachingDecoder)
+      {
+        context->decoder->resetDecoder();
+        context->currentFrameIdx = -1;
+      }
     }
 
     // A different display signal was chosen. Invalidate the cache and signal that we will need a
     // redraw.
     auto yuvVideo = dynamic_cast<video::yuv::videoHandlerYUV *>(this->video.get());
-    yuvVideo->showPixelValuesAsDiff = this->loadingDecoder->isSignalDifference(idx);
+    yuvVideo->showPixelValuesAsDiff = this->loadingContext.decoder->isSignalDifference(idx);
     yuvVideo->invalidateAllBuffers();
 
     emit SignalItemChanged(true, RECACHE_CLEAR);
@@ -1320,23 +1557,26 @@ void playlistItemCompressedVideo::decoderComboxBoxChanged(int idx)
     // A different display signal was chosen. Invalidate the cache and signal that we will need a
     // redraw.
     auto yuvVideo = dynamic_cast<video::yuv::videoHandlerYUV *>(this->video.get());
-    if (this->loadingDecoder)
-      yuvVideo->showPixelValuesAsDiff = this->loadingDecoder->isSignalDifference(idx);
+    if (this->loadingContext.decoder)
+      yuvVideo->showPixelValuesAsDiff = this->loadingContext.decoder->isSignalDifference(idx);
     yuvVideo->invalidateAllBuffers();
 
     // Reset the decoded frame indices so that decoding of the current frame is triggered
-    this->currentFrameIdx[0] = -1;
-    this->currentFrameIdx[1] = -1;
-
-    this->decodingNotPossibleAfter = -1;
+    this->loadingContext.currentFrameIdx          = -1;
+    this->loadingContext.decodingNotPossibleAfter = -1;
+    for (auto &context : this->cachingContexts)
+    {
+      context->currentFrameIdx          = -1;
+      context->decodingNotPossibleAfter = -1;
+    }
 
     // Update the list of display signals
-    if (this->loadingDecoder)
+    if (this->loadingContext.decoder)
     {
       QSignalBlocker block(ui.comboBoxDisplaySignal);
       ui.comboBoxDisplaySignal->clear();
-      ui.comboBoxDisplaySignal->addItems(this->loadingDecoder->getSignalNames());
-      ui.comboBoxDisplaySignal->setCurrentIndex(this->loadingDecoder->getDecodeSignal());
+      ui.comboBoxDisplaySignal->addItems(this->loadingContext.decoder->getSignalNames());
+      ui.comboBoxDisplaySignal->setCurrentIndex(this->loadingContext.decoder->getDecodeSignal());
     }
 
     // Update the statistics list with what the new decoder can provide
@@ -32,6 +32,9 @@
 
 #pragma once
 
+#include <QBasicTimer>
+#include <QFuture>
+
 #include <common/Typedef.h>
 #include <decoder/decoderBase.h>
 #include <filesource/FileSourceFFmpegFile.h>
@@ -42,6 +45,8 @@
 
 #include "playlistItemWithVideo.h"
 
+#include <atomic>
+
 class videoHandler;
 
 /* This playlist item encapsulates all compressed video sequences.
@@ -56,19 +61,25 @@ public:
   /* The default constructor requires the user to set a name that will be displayed in the
    * treeWidget and provide a pointer to the widget stack for the properties panels. The constructor
    * will then call addPropertiesWidget to add the custom properties panel. 'displayComponent'
-   * initializes the component to display (reconstruction/prediction/residual/trCoeff).
+   * initializes the component to display (reconstruction/prediction/residual/trCoeff). The result
+   * of prepareFile can be given so that a file that is read using libav is not scanned again.
    */
-  playlistItemCompressedVideo(const QString &        fileName,
-                              int                    displayComponent = 0,
-                              InputFormat            input            = InputFormat::Invalid,
-                              decoder::DecoderEngine decoder = decoder::DecoderEngine::Invalid);
+  playlistItemCompressedVideo(
+      const QString &                         fileName,
+      int                                     displayComponent = 0,
+      InputFormat                             input            = InputFormat::Invalid,
+      decoder::DecoderEngine                  decoder          = decoder::DecoderEngine::Invalid,
+      const FileSourceFFmpegFile::ScanResult *ffmpegScanResult = nullptr);
+  ~playlistItemCompressedVideo();
 
   // Save the compressed file element to the given XML structure.
   virtual void savePlaylist(QDomElement &root, const QDir &playlistDir) const override;
   // Create a new playlistItemHEVCFile from the playlist file entry. Return nullptr if parsing
   // failed.
-  static playlistItemCompressedVideo *
-  newPlaylistItemCompressedVideo(const YUViewDomElement &root, const QString &playlistFilePath);
+  static playlistItemCompressedVideo *newPlaylistItemCompressedVideo(
+      const YUViewDomElement &                root,
+      const QString &                         playlistFilePath,
+      const FileSourceFFmpegFile::ScanResult *ffmpegScanResult = nullptr);
 
   // Return the info title and info list to be shown in the fileInfo groupBox.
   virtual InfoData getInfo() const override;
@@ -86,6 +97,15 @@ public:
   // Add the file type filters and the extensions of files that we can load.
   static void getSupportedFileExtensions(QStringList &allExtensions, QStringList &filters);
 
+  // Prepare opening the file before the item is created. This can be called from any thread. Files
+  // that are read using libav are scanned. The result can be given to the constructor so that the
+  // item does not have to scan them again. If no input format is given, it is guessed from the
+  // extension.
+  static std::optional<FileSourceFFmpegFile::ScanResult>
+  prepareFile(const QString &                                   compressedFilePath,
+              InputFormat                                       input,
+              const FileSourceFFmpegFile::ScanProgressCallback &progressCallback);
+
   // ----- Detection of source/file change events -----
   virtual bool isSourceChanged() override
   { /* TODO */
@@ -94,6 +114,8 @@ public:
   virtual void reloadItemSource() override;
   virtual void updateSettings() override
   { /* TODO loadingDecoder->updateFileWatchSetting(); statSource.updateSettings(); */
+    playlistItemWithVideo::updateSettings();
+    this->statisticsData.updateSettings();
   }
 
   // Do we need to load the given frame first?
@@ -106,25 +128,71 @@ public:
   virtual bool isLoadingDoubleBuffer() const override { return isFrameLoadingDoubleBuffer; }
 
   // Cache the frame with the given index.
-  // For all compressed items, a mutex must be locked when caching a frame (only one frame can be
-  // cached at a time because we only have one decoder).
+  // Each caching decoder can only cache one frame at a time. The frames are requested from the
+  // caching decoders using the raw data loader of the video handler.
   void cacheFrame(int idx, bool testMode) override;
 
-  // We only have one caching decoder so it is better if only one thread caches frames from this
-  // item. This way, the frames will always be cached in the right order and no unnecessary decoding
-  // is performed.
-  virtual int cachingThreadLimit() override { return 1; }
+  // Every caching decoder can be used by one thread. If there is more than one caching decoder,
+  // each thread caches a segment (a GOP) of the sequence. This way, the frames within a segment
+  // will always be cached in the right order and no unnecessary decoding is performed.
+  virtual int cachingThreadLimit() override { return int(this->cachingContexts.size()); }
+  virtual std::vector<int> getCachingSegmentStarts(indexRange range) const override;
 
   InputFormat getInputFormat() const { return this->inputFormat; }
 
 protected:
   virtual void createPropertiesWidget() override;
 
-  // We allocate two decoder: One for loading images in the foreground and one for caching in the
+  // Everything that is needed to decode from one position in the bitstream: A decoder and the
+  // file source that the data is read from (the file is opened once per decoder).
+  struct DecodingContext
+  {
+    std::unique_ptr<decoder::decoderBase> decoder;
+    // Depending on the input format, one of these is used
+    std::unique_ptr<FileSourceAnnexBFile> inputFileAnnexB;
+    std::unique_ptr<FileSourceFFmpegFile> inputFileFFmpeg;
+
+    // The current frame index of the decoder
+    int currentFrameIdx{-1};
+    // When reading annex B data using the FileSourceAnnexBFile::getFrameData function, we need to
+    // count how many frames we already read.
+    int readAnnexBFrameCounterCodingOrder{-1};
+    // For certain decoders (FFmpeg or HM), pushing data may fail. The decoder may or may not switch
+    // to retrieveing mode. In this case, we must re-push the packet for which pushing failed.
+    bool repushData{};
+    // If the bitstream is invalid (for example it was cut at a position that it should not be cut
+    // at), this decoder might be unable to decode the frames from this index on. Reset on a seek.
+    // The GUI thread reads it from the loading context to show the error.
+    std::atomic<int> decodingNotPossibleAfter{-1};
+    // The number of threads from the thread budget when the decoder was created
+    unsigned decoderThreads{};
+
+    // A caching context can only be used by one caching thread at a time
+    QMutex mutex;
+  };
+
+  // The frame range grows in the GUI thread while the file is indexed in the background. The
+  // loading and caching threads get a copy with getStartEndRange.
+  indexRange     getStartEndRange() const;
+  mutable QMutex startEndRangeMutex;
+
+  // We allocate separate decoders for loading images in the foreground and for caching in the
   // background. This is better if random access and linear decoding (caching) is performed at the
-  // same time.
-  std::unique_ptr<decoder::decoderBase> loadingDecoder;
-  std::unique_ptr<decoder::decoderBase> cachingDecoder;
+  // same time. With more than one caching decoder, multiple segments of the sequence can be
+  // cached in parallel (setting "VideoCache/NrCachingDecoders").
+  DecodingContext                               loadingContext;
+  std::vector<std::unique_ptr<DecodingContext>> cachingContexts;
+
+  // If there is more than one caching decoder, these are the frames where the segments that can
+  // be decoded independently start (the first frame whose closest seek point is a new one).
+  std::vector<int> cachingSegmentStarts;
+  void             updateCachingSegmentStarts();
+
+  // Lock and return the caching context that is best suited to decode the given frame. Prefer a
+  // context that can just keep on decoding without seeking.
+  DecodingContext *lockCachingContext(int frameIdx);
+  // This is set as the raw data loader of the video handler and called from the caching threads.
+  bool loadRawDataForCaching(int frameIdx, QByteArray &targetBuffer);
 
   // When opening the file, we will fill this list with the possible decoders
   std::vector<decoder::DecoderEngine> possibleDecoders;
@@ -132,36 +200,33 @@ protected:
   decoder::DecoderEngine decoderEngine{decoder::DecoderEngine::Invalid};
   // Delete existing decoders and allocate decoders for the type "decoderEngineType"
   bool allocateDecoder(int displayComponent = 0);
+  std::unique_ptr<decoder::decoderBase>
+  createDecoder(int displayComponent, bool cachingDecoder, DecodingContext &context);
 
   // In order to parse raw annexB files, we need a file reader (that can read NAL units)
-  // and a parser that can understand what the NAL units mean. We open the file source twice (once
-  // for interactive loading, once for the background caching). The parser is only needed once and
+  // and a parser that can understand what the NAL units mean. We open the file source once for
+  // interactive loading and once for every caching decoder. The parser is only needed once and
   // can be used for both loading and caching tasks.
-  std::unique_ptr<FileSourceAnnexBFile> inputFileAnnexBLoading;
-  std::unique_ptr<FileSourceAnnexBFile> inputFileAnnexBCaching;
   std::unique_ptr<parser::ParserAnnexB> inputFileAnnexBParser;
-  // When reading annex B data using the FileSourceAnnexBFile::getFrameData function, we need to
-  // count how many frames we already read.
-  int readAnnexBFrameCounterCodingOrder{-1};
+
+  // The parser runs in the background with its own file source. The item can be used as soon as
+  // the first frame was parsed.
+  std::unique_ptr<FileSourceAnnexBFile> indexingFile;
+  QFuture<void>                         indexingFuture;
+  void                                  stopIndexing();
+
+  // A timer is used to update the frame range while the file is parsed (every second)
+  QBasicTimer indexingTimer;
+  void        timerEvent(QTimerEvent *event) override;
 
   // Which type is the input?
   InputFormat              inputFormat;
   FFmpeg::AVCodecIDWrapper ffmpegCodec;
 
-  // For FFMpeg files we don't need a reader to parse them. But if the container contains a
-  // supported format, we can read the NAL units from the compressed file.
-  std::unique_ptr<FileSourceFFmpegFile> inputFileFFmpegLoading;
-  std::unique_ptr<FileSourceFFmpegFile> inputFileFFmpegCaching;
-
   // Is the loadFrame function currently loading?
   bool isFrameLoading{};
   bool isFrameLoadingDoubleBuffer{};
 
-  // Only cache one frame at a time. Caching should also always be done in display order of the
-  // frames.
-  // TODO: Could we somehow make shure that caching is always performed in display order?
-  QMutex cachingMutex;
-
   stats::StatisticUIHandler statisticsUIHandler;
   stats::StatisticsData     statisticsData;
 
@@ -170,19 +235,17 @@ protected:
 
   SafeUi<Ui::playlistItemCompressedFile_Widget> ui;
 
-  // The current frame index of the decoders (interactive/caching)
-  int currentFrameIdx[2]{-1, -1};
-
   // Seek the input file to the given position, reset the decoder and prepare it to start decoding
   // from the given position.
-  void seekToPosition(int seekToFrame, int64_t seekToDTS, bool caching);
+  void seekToPosition(DecodingContext &context, int seekToFrame, int64_t seekToDTS);
 
-  // For certain decoders (FFmpeg or HM), pushing data may fail. The decoder may or may not switch
-  // to retrieveing mode. In this case, we must re-push the packet for which pushing failed.
-  bool repushData{};
+  // Decode (and seek if necessary) until the given frame was decoded by the decoder of the given
+  // context. Returns true if the frame can be retrieved from the decoder.
+  bool decodeFrame(DecodingContext &context, int frameIdx, bool caching);
 
   // Besides the normal stats (error / no error) this item might be able to parse the file but not
-  // to decode it.
+  // to decode it. Only call this from the GUI thread. The decoding functions run in the loading and
+  // caching threads and report errors with signalDecodingError instead.
   void setDecodingError(QString err)
   {
     infoText        = err;
@@ -190,11 +253,16 @@ protected:
   }
   bool decodingEnabled{};
 
-  // If the bitstream is invalid (for example it was cut at a position that it should not be cut
-  // at), we might be unable to decode some of the frames at the end of the sequence.
-  int decodingNotPossibleAfter{-1};
+signals:
+  // These are emitted from the loading and caching threads and are connected queued
+  void signalDecodingError(QString error);
+  // Only emitted for the loading context. Caching decoders keep their failures to themselves.
+  void signalDecodingNotPossibleAfter(int frameIdx);
 
 private slots:
+  void slotDecodingError(QString error);
+  void slotDecodingNotPossibleAfter(int frameIdx);
+
   // Load the raw (YUV or RGN) data for the given frame index from file. This slot is called by the
   // videoHandler if the frame that is requested to be drawn has not been loaded yet.
   virtual void loadRawData(int frameIdx, bool forceDecodingNow);
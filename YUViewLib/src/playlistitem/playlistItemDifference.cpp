@@ -60,6 +60,7 @@ playlistItemDifference::playlistItemDifference() : playlistItemContainer("Differ
   this->maxItemCount   = 2;
   this->frameLimitsMax = false;
   this->infoText       = DIFFERENCE_INFO_TEXT;
+  this->cachingEnabled = true;
 
   connect(&difference,
           &video::videoHandlerDifference::signalHandlerChanged,
@@ -60,6 +60,33 @@ public:
   virtual bool isLoading() const override;
   virtual bool isLoadingDoubleBuffer() const override;
 
+  // -- Caching
+  // The difference can be cached if it is calculated from the YUV values of two YUV items.
+  virtual bool isCachable() const override
+  {
+    return playlistItem::isCachable() && childCount() == 2 && difference.isDifferenceCachable();
+  }
+  // Cache the given frame
+  virtual void cacheFrame(int frameIdx, bool testMode) override
+  {
+    if (isCachable())
+      difference.cacheFrame(frameIdx, testMode);
+  }
+  // Get a list of all cached frames (just the frame indices)
+  virtual QList<int> getCachedFrames() const override { return difference.getCachedFrames(); }
+  virtual int getNumberCachedFrames() const override { return difference.getNumberCachedFrames(); }
+  // How many bytes will caching one frame use (in bytes)?
+  virtual unsigned int getCachingFrameSize() const override
+  {
+    return difference.getCachingFrameSize();
+  }
+  // Remove the given frame from the cache
+  virtual void removeFrameFromCache(int frameIdx) override
+  {
+    difference.removeFrameFromCache(frameIdx);
+  }
+  virtual void removeAllFramesFromCache() override { difference.removeAllFrameFromCache(); }
+
   // Overload from playlistItem. Save the playlist item to playlist.
   virtual void savePlaylist(QDomElement &root, const QDir &playlistDir) const override;
   // Create a new playlistItemDifference from the playlist file entry. Return nullptr if parsing
@@ -32,7 +32,9 @@
 
 #include "playlistItemRawFile.h"
 
+#include <QFile>
 #include <QPainter>
+#include <QSettings>
 #include <QUrl>
 #include <QVBoxLayout>
 
@@ -58,6 +60,10 @@ constexpr auto RGBA_EXTENSIONS = {"rgba", "gbra", "bgra", "brga", "argb", "agbr"
 constexpr auto RAW_BAYER_EXTENSIONS = {"raw"};
 constexpr auto CMYK_EXTENSIONS      = {"cmyk"};
 
+// The number of bytes that are read to get the format from the correlation. The biggest format
+// that is tested is 1080p YUV 4:2:2 8 bit.
+constexpr auto FORMAT_DETECTION_BYTES = 24883200;
+
 bool isInExtensions(const QString &testValue, const std::initializer_list<const char *> &extensions)
 {
   const auto it =
@@ -72,7 +78,8 @@ bool isInExtensions(const QString &testValue, const std::initializer_list<const
 playlistItemRawFile::playlistItemRawFile(const QString &rawFilePath,
                                          const QSize    qFrameSize,
                                          const QString &sourcePixelFormat,
-                                         const QString &fmt)
+                                         const QString &fmt,
+                                         const QString &detectedFormat)
     : playlistItemWithVideo(rawFilePath)
 {
   this->setIcon(0, functionsGui::convertIcon(":img_video.png"));
@@ -81,7 +88,7 @@ playlistItemRawFile::playlistItemRawFile(const QString &rawFilePath,
   this->prop.isFileSource          = true;
   this->prop.propertiesWidgetTitle = "Raw File Properties";
 
-  this->dataSource.openFile(rawFilePath);
+  this->openDataSource(rawFilePath);
 
   if (!this->dataSource.isOk())
   {
@@ -130,11 +137,13 @@ playlistItemRawFile::playlistItemRawFile(const QString &rawFilePath,
     // Try to get the frame format from the file name. The FileSource can guess this.
     setFormatFromFileName();
 
-    if (!this->video->isFormatValid())
+    if (!this->video->isFormatValid() && !detectedFormat.isEmpty())
+      this->video->setFormatFromString(detectedFormat);
+    else if (!this->video->isFormatValid())
     {
-      // Load 24883200 bytes from the input and try to get the format from the correlation.
+      // Load the beginning of the input and try to get the format from the correlation.
       QByteArray rawData;
-      this->dataSource.readBytes(rawData, 0, 24883200);
+      this->dataSource.readBytes(rawData, 0, FORMAT_DETECTION_BYTES);
       this->video->setFormatFromCorrelation(rawData, this->dataSource.getFileSize());
     }
   }
@@ -156,6 +165,10 @@ playlistItemRawFile::playlistItemRawFile(const QString &rawFilePath,
           this,
           &playlistItemRawFile::loadRawData,
           Qt::DirectConnection);
+  // The caching threads can read from the file in parallel
+  this->video->setRawDataLoader([this](int frameIdx, QByteArray &targetBuffer) {
+    return this->loadRawDataToBuffer(frameIdx, targetBuffer);
+  });
 
   // Connect the basic signals from the video
   playlistItemWithVideo::connectVideo();
@@ -170,6 +183,29 @@ playlistItemRawFile::playlistItemRawFile(const QString &rawFilePath,
   this->cachingEnabled = true;
 }
 
+QString playlistItemRawFile::detectFormatFromContent(const QString &rawFilePath)
+{
+  const QFileInfo fileInfo(rawFilePath);
+  const auto      ext = fileInfo.suffix().toLower();
+
+  // Only the format of YUV files is detected from the correlation
+  if (!isInExtensions(ext, YUV_EXTENSIONS) && !isInExtensions(ext, RAW_BAYER_EXTENSIONS))
+    return {};
+  if (ext == "y4m" || !itemMemoryHandler::itemMemoryGetFormat(rawFilePath).isEmpty() ||
+      guessFormatFromFilename(fileInfo).frameSize.isValid())
+    return {};
+
+  QFile file(rawFilePath);
+  if (!file.open(QIODevice::ReadOnly))
+    return {};
+
+  video::yuv::videoHandlerYUV video;
+  video.setFormatFromCorrelation(file.read(FORMAT_DETECTION_BYTES), file.size());
+  if (!video.isFormatValid())
+    return {};
+  return video.getFormatAsString();
+}
+
 void playlistItemRawFile::updateStartEndRange()
 {
   if (!this->dataSource.isOk() || !this->video->isFormatValid())
@@ -523,7 +559,11 @@ playlistItemRawFile *playlistItemRawFile::newplaylistItemRawFile(const YUViewDom
     return nullptr;
 
   // We can still not be sure that the file really exists, but we gave our best to try to find it.
-  auto newFile = new playlistItemRawFile(filePath, {}, {}, type);
+  // The format is loaded from the playlist. Don't detect it from the file content.
+  const auto frameSize =
+      QSize(root.findChildValue("width").toInt(), root.findChildValue("height").toInt());
+  auto newFile =
+      new playlistItemRawFile(filePath, frameSize, root.findChildValue("pixelFormat"), type);
 
   newFile->video->loadPlaylist(root);
   playlistItem::loadPropertiesFromPlaylist(root, newFile);
@@ -536,22 +576,73 @@ void playlistItemRawFile::loadRawData(int frameIdx)
   if (!this->video->isFormatValid())
     return;
 
-  auto nrBytes = this->video->getBytesPerFrame();
-
-  // Load the raw data for the given frameIdx from file and set it in the video
-  int64_t fileStartPos;
-  if (this->isY4MFile)
-    fileStartPos = this->y4mFrameIndices.at(frameIdx);
-  else
-    fileStartPos = frameIdx * nrBytes;
+  const auto fileStartPos = this->getFrameStartPosInFile(frameIdx);
+  if (fileStartPos < 0)
+    return;
 
-  DEBUG_RAWFILE("playlistItemRawFile::loadRawData Start loading frame " << frameIdx << " bytes "
-                                                                        << int(nrBytes));
-  if (this->dataSource.readBytes(this->video->rawData, fileStartPos, nrBytes) < nrBytes)
+  if (!this->loadRawDataToBuffer(frameIdx, this->video->rawData))
     return; // Error
+
   this->video->rawData_frameIndex = frameIdx;
+}
 
-  DEBUG_RAWFILE("playlistItemRawFile::loadRawData Frame " << frameIdx << " loaded");
+int64_t playlistItemRawFile::getFrameStartPosInFile(int frameIdx) const
+{
+  if (frameIdx < 0)
+    return -1;
+  if (this->isY4MFile)
+  {
+    if (frameIdx >= this->y4mFrameIndices.size())
+      return -1;
+    return int64_t(this->y4mFrameIndices.at(frameIdx));
+  }
+  return int64_t(frameIdx) * this->video->getBytesPerFrame();
+}
+
+void playlistItemRawFile::openDataSource(const QString &filePath)
+{
+  this->dataSource.openFile(filePath);
+
+  QSettings settings;
+  if (this->dataSource.isOk() && settings.value("MemoryMapRawFiles", false).toBool())
+  {
+    if (!this->dataSource.mapFileToMemory())
+      DEBUG_RAWFILE("playlistItemRawFile::openDataSource Mapping the file failed");
+  }
+}
+
+void playlistItemRawFile::prefetchFramesForCaching(indexRange range)
+{
+  if (!this->dataSource.isMemoryMapped() || !this->video->isFormatValid())
+    return;
+
+  const auto startPos = this->getFrameStartPosInFile(range.first);
+  const auto endPos   = this->getFrameStartPosInFile(range.second);
+  if (startPos < 0 || endPos < startPos)
+    return;
+
+  this->dataSource.adviseWillNeed(startPos, endPos - startPos + this->video->getBytesPerFrame());
+}
+
+bool playlistItemRawFile::loadRawDataToBuffer(int frameIdx, QByteArray &targetBuffer)
+{
+  if (!this->video->isFormatValid())
+    return false;
+
+  const auto nrBytes = this->video->getBytesPerFrame();
+
+  // Load the raw data for the given frameIdx from file
+  const auto fileStartPos = this->getFrameStartPosInFile(frameIdx);
+  if (fileStartPos < 0)
+    return false;
+
+  DEBUG_RAWFILE("playlistItemRawFile::loadRawDataToBuffer Start loading frame "
+                << frameIdx << " bytes " << int(nrBytes));
+  if (this->dataSource.readBytes(targetBuffer, fileStartPos, nrBytes) < nrBytes)
+    return false;
+
+  DEBUG_RAWFILE("playlistItemRawFile::loadRawDataToBuffer Frame " << frameIdx << " loaded");
+  return true;
 }
 
 void playlistItemRawFile::slotVideoPropertiesChanged()
@@ -588,13 +679,16 @@ void playlistItemRawFile::getSupportedFileExtensions(QStringList &allExtensions,
 
 void playlistItemRawFile::reloadItemSource()
 {
+  // The buffers may reference the memory mapped file. Invalidate them before the file is reopened.
+  this->video->invalidateAllBuffers();
+  this->video->rawData.clear();
+
   // Reopen the file
-  this->dataSource.openFile(this->properties().name);
+  this->openDataSource(this->properties().name);
   if (!this->dataSource.isOk())
     // Opening the file failed.
     return;
 
-  this->video->invalidateAllBuffers();
   this->updateStartEndRange();
 
   // Emit that the item needs redrawing and the cache changed.
@@ -48,11 +48,20 @@ public:
   // Create a new raw file. The format (RGB or YUV) will be gotten from the extension. If the
   // extension is not one of the supported extensions (getSupportedFileExtensions), set the format
   // "fmt" to either "rgb" or "yuv". If you already know the frame size and/or sourcePixelFormat,
-  // you can set them as well.
+  // you can set them as well. If the format was detected from the file content before (see
+  // detectFormatFromContent), it is used instead of detecting it again.
   playlistItemRawFile(const QString &rawFilePath,
                       const QSize    frameSize         = {},
                       const QString &sourcePixelFormat = {},
-                      const QString &fmt               = {});
+                      const QString &fmt               = {},
+                      const QString &detectedFormat    = {});
+
+  // Detect the format of a raw file from the correlation of the data in the file. This reads up to
+  // 24MB from the file and can be called from any thread. The detection is skipped (an empty
+  // string is returned) if the format can be gotten otherwise (y4m header, file name or the format
+  // that was used for the file before). The format is returned as from
+  // videoHandler::getFormatAsString.
+  static QString detectFormatFromContent(const QString &rawFilePath);
 
   // Overload from playlistItem. Save the raw file item to playlist.
   virtual void savePlaylist(QDomElement &root, const QDir &playlistDir) const override;
@@ -76,7 +85,13 @@ public:
   // ----- Detection of source/file change events -----
   virtual bool isSourceChanged() override { return this->dataSource.getAndResetFileChangedFlag(); }
   virtual void reloadItemSource() override;
-  virtual void updateSettings() override { this->dataSource.updateFileWatchSetting(); }
+  virtual void updateSettings() override
+  {
+    this->dataSource.updateFileWatchSetting();
+    playlistItemWithVideo::updateSettings();
+  }
+
+  virtual void prefetchFramesForCaching(indexRange range) override;
 
   // Cache the given frame
   virtual void cacheFrame(int idx, bool testMode) override
@@ -99,6 +114,15 @@ protected:
   void setFormatFromFileName();
 
 private:
+  // Load the raw data for the given frame index from file into the given buffer. This is thread
+  // safe and used by the caching threads (each with its own buffer).
+  bool loadRawDataToBuffer(int frameIdx, QByteArray &targetBuffer);
+  // Get the position of the given frame in the file. Returns -1 if the frame index is not valid.
+  int64_t getFrameStartPosInFile(int frameIdx) const;
+
+  // Open the file and map it into memory if this is enabled in the settings
+  void openDataSource(const QString &filePath);
+
   // Overload from playlistItem. Create a properties widget custom to the RawFile
   // and set propertiesWidget to point to it.
   virtual void createPropertiesWidget() override;
@@ -56,6 +56,7 @@ playlistItemResample::playlistItemResample() : playlistItemContainer("Resample I
   this->maxItemCount   = 1;
   this->frameLimitsMax = false;
   this->infoText       = RESAMPLE_INFO_TEXT;
+  this->cachingEnabled = true;
 
   this->connect(&this->video,
                 &video::FrameHandler::signalHandlerChanged,
@@ -145,10 +146,7 @@ void playlistItemResample::drawItem(QPainter *painter,
         }
 
         this->video.setScaledSize(this->scaledSize);
-        auto interpolation = (this->interpolationIndex == 0)
-                                 ? video::videoHandlerResample::Interpolation::Bilinear
-                                 : video::videoHandlerResample::Interpolation::Fast;
-        this->video.setInterpolation(interpolation);
+        this->video.setInterpolation(this->getInterpolation());
         this->video.setCutAndSample(this->cutRange, this->sampling);
         auto nrFrames            = (this->cutRange.second - this->cutRange.first) / this->sampling;
         this->prop.startEndRange = indexRange(0, nrFrames);
@@ -193,7 +191,9 @@ void playlistItemResample::createPropertiesWidget()
   ui.setupUi();
 
   ui.comboBoxInterpolation->addItems(QStringList() << "Bilinear"
-                                                   << "Linear");
+                                                   << "Linear"
+                                                   << "Bicubic"
+                                                   << "Lanczos");
   ui.comboBoxInterpolation->setCurrentIndex(this->interpolationIndex);
 
   ui.labelSAR->setEnabled(false);
@@ -277,7 +277,8 @@ playlistItemResample *playlistItemResample::newPlaylistItemResample(const YUView
 
 ValuePairListSets playlistItemResample::getPixelValues(const QPoint &pixelPos, int frameIdx)
 {
-  return ValuePairListSets("RGB", this->video.getPixelValues(pixelPos, frameIdx));
+  const auto title = this->video.isResamplingYUV() ? "YUV" : "RGB";
+  return ValuePairListSets(title, this->video.getPixelValues(pixelPos, frameIdx));
 }
 
 ItemLoadingState playlistItemResample::needsLoading(int frameIdx, bool loadRawData)
@@ -347,10 +348,23 @@ void playlistItemResample::slotResampleControlChanged(int)
 void playlistItemResample::slotInterpolationModeChanged(int)
 {
   this->interpolationIndex = ui.comboBoxInterpolation->currentIndex();
-  auto interpolation       = (this->interpolationIndex == 0)
-                                 ? video::videoHandlerResample::Interpolation::Bilinear
-                                 : video::videoHandlerResample::Interpolation::Fast;
-  this->video.setInterpolation(interpolation);
+  this->video.setInterpolation(this->getInterpolation());
+}
+
+video::videoHandlerResample::Interpolation playlistItemResample::getInterpolation() const
+{
+  // The index of the entry in the interpolation combo box
+  switch (this->interpolationIndex)
+  {
+  case 1:
+    return video::videoHandlerResample::Interpolation::Fast;
+  case 2:
+    return video::videoHandlerResample::Interpolation::Bicubic;
+  case 3:
+    return video::videoHandlerResample::Interpolation::Lanczos;
+  default:
+    return video::videoHandlerResample::Interpolation::Bilinear;
+  }
 }
 
 void playlistItemResample::slotCutAndSampleControlChanged(int)
@@ -61,6 +61,27 @@ public:
   virtual bool isLoading() const override { return this->isFrameLoading; }
   virtual bool isLoadingDoubleBuffer() const override { return this->isFrameLoadingDoubleBuffer; }
 
+  // -- Caching
+  // The resampled frames can be cached if they are resampled from the YUV values of a YUV item.
+  virtual bool isCachable() const override
+  {
+    return playlistItem::isCachable() && childCount() == 1 && video.isResamplingYUV();
+  }
+  // Cache the given frame
+  virtual void cacheFrame(int frameIdx, bool testMode) override
+  {
+    if (isCachable())
+      video.cacheFrame(frameIdx, testMode);
+  }
+  // Get a list of all cached frames (just the frame indices)
+  virtual QList<int> getCachedFrames() const override { return video.getCachedFrames(); }
+  virtual int getNumberCachedFrames() const override { return video.getNumberCachedFrames(); }
+  // How many bytes will caching one frame use (in bytes)?
+  virtual unsigned int getCachingFrameSize() const override { return video.getCachingFrameSize(); }
+  // Remove the given frame from the cache
+  virtual void removeFrameFromCache(int frameIdx) override { video.removeFrameFromCache(frameIdx); }
+  virtual void removeAllFramesFromCache() override { video.removeAllFrameFromCache(); }
+
   // Overload from playlistItem. Save the playlist item to playlist.
   virtual void savePlaylist(QDomElement &root, const QDir &playlistDir) const override;
   // Create a new playlistItemResample from the playlist file entry. Return nullptr if parsing failed.
@@ -88,6 +109,8 @@ private:
   // and set propertiesWidget to point to it.
   virtual void createPropertiesWidget() override;
 
+  video::videoHandlerResample::Interpolation getInterpolation() const;
+
   video::videoHandlerResample video;
 
   Size scaledSize {0, 0};
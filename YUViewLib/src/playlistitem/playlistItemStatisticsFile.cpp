@@ -33,6 +33,11 @@
 #include "playlistItemStatisticsFile.h"
 
 #include <QDebug>
+#include <QFileDialog>
+#include <QFutureWatcher>
+#include <QMessageBox>
+#include <QProgressDialog>
+#include <QPushButton>
 #include <QTime>
 #include <QUrl>
 #include <QtConcurrent>
@@ -42,6 +47,7 @@
 #include <common/FunctionsGui.h>
 #include <common/YUViewDomElement.h>
 #include <statistics/StatisticsDataPainting.h>
+#include <statistics/StatisticsFileBinary.h>
 #include <statistics/StatisticsFileCSV.h>
 #include <statistics/StatisticsFileVTMBMS.h>
 
@@ -57,6 +63,30 @@
 // idea anyways)
 #define STAT_PARSING_BUFFER_SIZE 1048576
 
+namespace
+{
+
+std::unique_ptr<stats::StatisticsFileBase>
+createStatisticsFile(const QString &                      filename,
+                     playlistItemStatisticsFile::OpenMode openMode,
+                     stats::StatisticsData &              statisticsData)
+{
+  using OpenMode = playlistItemStatisticsFile::OpenMode;
+
+  auto suffix = QFileInfo(filename).suffix();
+  if (openMode == OpenMode::CSVFile || (openMode == OpenMode::Extension && suffix == "csv"))
+    return std::make_unique<stats::StatisticsFileCSV>(filename, statisticsData);
+  if (openMode == OpenMode::VTMBMSFile ||
+      (openMode == OpenMode::Extension && suffix == "vtmbmsstats"))
+    return std::make_unique<stats::StatisticsFileVTMBMS>(filename, statisticsData);
+  if (openMode == OpenMode::BinaryFile ||
+      (openMode == OpenMode::Extension && suffix == stats::StatisticsFileBinary::FILE_EXTENSION))
+    return std::make_unique<stats::StatisticsFileBinary>(filename, statisticsData);
+  return {};
+}
+
+} // namespace
+
 playlistItemStatisticsFile::playlistItemStatisticsFile(const QString &itemNameOrFileName,
                                                        OpenMode       openMode)
     : playlistItem(itemNameOrFileName, Type::Indexed), openMode(openMode)
@@ -69,14 +99,19 @@ playlistItemStatisticsFile::playlistItemStatisticsFile(const QString &itemNameOr
   this->prop.propertiesWidgetTitle = "Statistics File Properties";
   this->prop.providesStatistics    = true;
 
+  this->cachingEnabled = true;
+
   // Set statistics icon
   setIcon(0, functionsGui::convertIcon(":img_stats.png"));
 
   this->openStatisticsFile();
+  this->statisticsData.updateSettings(true);
   this->statisticsUIHandler.setStatisticsData(&this->statisticsData);
 
+  // If other types are rendered, other frames may have to be cached
   connect(&this->statisticsUIHandler, &stats::StatisticUIHandler::updateItem, [this](bool redraw) {
-    emit SignalItemChanged(redraw, RECACHE_NONE);
+    this->updateCachingStatisticsTypes();
+    emit SignalItemChanged(redraw, RECACHE_UPDATE);
   });
 }
 
@@ -186,7 +221,9 @@ void playlistItemStatisticsFile::loadFrame(int frameIdx, bool, bool, bool emitSi
   if (this->statisticsData.needsLoading(frameIdx) == ItemLoadingState::LoadingNeeded)
   {
     this->isStatisticsLoading = true;
+    if (!this->statisticsData.restoreFrameFromCache(frameIdx))
     {
+      std::unique_lock<std::mutex> lock(this->fileMutex);
       auto typesToLoad = this->statisticsData.getTypesThatNeedLoading(frameIdx);
       for (auto typeID : typesToLoad)
         this->file->loadStatisticData(this->statisticsData, frameIdx, typeID);
@@ -197,6 +234,80 @@ void playlistItemStatisticsFile::loadFrame(int frameIdx, bool, bool, bool emitSi
   }
 }
 
+bool playlistItemStatisticsFile::isCachable() const
+{
+  return playlistItem::isCachable() && this->file && !this->backgroundParserFuture.isRunning();
+}
+
+void playlistItemStatisticsFile::cacheFrame(int frameIdx, bool)
+{
+  if (!this->file)
+    return;
+
+  DEBUG_STAT("playlistItemStatisticsFile::cacheFrame frameIdx %d", frameIdx);
+
+  // Load into separate statistics data so that the currently shown frame is not changed. The types
+  // of the statistics data are changed in the GUI thread so a copy is used.
+  stats::StatisticsData frameData;
+  {
+    std::unique_lock<std::mutex> lock(this->cachingTypesMutex);
+    frameData.setFrameSize(this->cachingFrameSize);
+    for (const auto &type : this->cachingStatisticsTypes)
+      frameData.addStatType(type);
+  }
+
+  auto &cache = this->statisticsData.getCache();
+
+  std::vector<int> typesToLoad;
+  for (auto typeID : frameData.getTypesThatNeedLoading(frameIdx))
+    if (!cache.contains(frameIdx, typeID))
+      typesToLoad.push_back(typeID);
+
+  {
+    std::unique_lock<std::mutex> lock(this->fileMutex);
+    for (auto typeID : typesToLoad)
+      this->file->loadStatisticData(frameData, frameIdx, typeID);
+  }
+
+  for (auto typeID : typesToLoad)
+    cache.insert(frameIdx, typeID, std::move(frameData[typeID]));
+}
+
+void playlistItemStatisticsFile::updateCachingStatisticsTypes()
+{
+  std::unique_lock<std::mutex> lock(this->cachingTypesMutex);
+  this->cachingFrameSize       = this->statisticsData.getFrameSize();
+  this->cachingStatisticsTypes = this->statisticsData.getStatisticsTypes();
+}
+
+QList<int> playlistItemStatisticsFile::getCachedFrames() const
+{
+  QList<int> cachedFrames;
+  for (auto frameIdx : this->statisticsData.getCachedFrames())
+    cachedFrames.append(frameIdx);
+  return cachedFrames;
+}
+
+int playlistItemStatisticsFile::getNumberCachedFrames() const
+{
+  return int(this->statisticsData.getCachedFrames().size());
+}
+
+unsigned int playlistItemStatisticsFile::getCachingFrameSize() const
+{
+  return unsigned(this->statisticsData.getCachedFrameSize());
+}
+
+void playlistItemStatisticsFile::removeFrameFromCache(int frameIdx)
+{
+  this->statisticsData.getCache().removeFrame(frameIdx);
+}
+
+void playlistItemStatisticsFile::removeAllFramesFromCache()
+{
+  this->statisticsData.getCache().clear();
+}
+
 ValuePairListSets playlistItemStatisticsFile::getPixelValues(const QPoint &pixelPos, int frameIdx)
 {
   (void)frameIdx;
@@ -211,6 +322,7 @@ bool playlistItemStatisticsFile::isSourceChanged()
 void playlistItemStatisticsFile::updateSettings()
 {
   this->statisticsUIHandler.updateSettings();
+  this->statisticsData.updateSettings(true);
   if (this->file)
     this->file->updateSettings();
 }
@@ -220,12 +332,17 @@ void playlistItemStatisticsFile::getSupportedFileExtensions(QStringList &allExte
 {
   allExtensions.append("vtmbmsstats");
   allExtensions.append("csv");
+  allExtensions.append(stats::StatisticsFileBinary::FILE_EXTENSION);
   filters.append("Statistics File (*.vtmbmsstats)");
   filters.append("Statistics File (*.csv)");
+  filters.append(QString("Binary Statistics File (*.%1)")
+                     .arg(stats::StatisticsFileBinary::FILE_EXTENSION));
 }
 
 void playlistItemStatisticsFile::onPOCTypeParsed(int poc, int typeID)
 {
+  // Statistics of the POC that were loaded before may be incomplete
+  this->statisticsData.getCache().removeFrame(poc);
   if (poc == this->currentDrawnFrameIdx && this->statisticsData.hasDataForTypeID(typeID))
   {
     this->statisticsData.eraseDataForTypeID(typeID);
@@ -239,6 +356,7 @@ void playlistItemStatisticsFile::onPOCParsed(int poc)
     emit SignalItemChanged(true, RECACHE_NONE);
 
   this->statisticsData.setFrameIndex(-1);
+  this->statisticsData.getCache().removeFrame(poc);
 }
 
 void playlistItemStatisticsFile::createPropertiesWidget()
@@ -256,6 +374,17 @@ void playlistItemStatisticsFile::createPropertiesWidget()
   line->setFrameShadow(QFrame::Sunken);
 
   vAllLaout->addLayout(createPlaylistItemControls());
+  if (!dynamic_cast<stats::StatisticsFileBinary *>(this->file.get()))
+  {
+    auto convertButton = new QPushButton("Convert to Binary Statistics File...");
+    convertButton->setToolTip("Binary statistics files do not have to be parsed. Loading the "
+                              "statistics of a frame is much faster.");
+    connect(convertButton,
+            &QPushButton::clicked,
+            this,
+            &playlistItemStatisticsFile::convertToBinaryFile);
+    vAllLaout->addWidget(convertButton);
+  }
   vAllLaout->addWidget(line);
   vAllLaout->addLayout(this->statisticsUIHandler.createStatisticsHandlerControls());
 
@@ -263,6 +392,56 @@ void playlistItemStatisticsFile::createPropertiesWidget()
   // expand to take up as much space as there is available
 }
 
+void playlistItemStatisticsFile::convertToBinaryFile()
+{
+  const QFileInfo fileInfo(this->prop.name);
+  const auto      extension = QString(stats::StatisticsFileBinary::FILE_EXTENSION);
+  const auto      binaryFilename =
+      QFileDialog::getSaveFileName(this->propertiesWidget.get(),
+                                   "Save Binary Statistics File",
+                                   fileInfo.path() + "/" + fileInfo.completeBaseName() + "." +
+                                       extension,
+                                   QString("Binary Statistics File (*.%1)").arg(extension));
+  if (binaryFilename.isEmpty())
+    return;
+
+  const auto answer = QMessageBox::question(
+      this->propertiesWidget.get(),
+      "Compress Statistics",
+      "Do you want to compress the statistics? The file will be smaller but loading is slower.",
+      QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel,
+      QMessageBox::No);
+  if (answer == QMessageBox::Cancel)
+    return;
+  const auto compressChunks = (answer == QMessageBox::Yes);
+
+  // The conversion uses its own reader so that it does not interfere with loading and drawing
+  std::atomic_bool abortConversion{false};
+  auto             future = QtConcurrent::run([&]() {
+    stats::StatisticsData statisticsData;
+    auto sourceFile = createStatisticsFile(this->prop.name, this->openMode, statisticsData);
+    return stats::convertToBinaryFile(
+        *sourceFile, statisticsData, binaryFilename, compressChunks, abortConversion);
+  });
+
+  QProgressDialog progressDialog(
+      "Converting statistics file...", "Cancel", 0, 0, this->propertiesWidget.get());
+  progressDialog.setWindowModality(Qt::WindowModal);
+  QFutureWatcher<bool> watcher;
+  connect(&watcher, &QFutureWatcher<bool>::finished, &progressDialog, &QProgressDialog::reset);
+  watcher.setFuture(future);
+  progressDialog.exec();
+
+  if (progressDialog.wasCanceled())
+    abortConversion.store(true);
+  future.waitForFinished();
+
+  if (!future.result() && !abortConversion.load())
+    QMessageBox::critical(this->propertiesWidget.get(),
+                          "Error converting statistics file",
+                          "The statistics file could not be converted to a binary file.");
+}
+
 void playlistItemStatisticsFile::openStatisticsFile()
 {
   // Is the background parser still running? If yes, abort it.
@@ -273,15 +452,8 @@ void playlistItemStatisticsFile::openStatisticsFile()
     this->backgroundParserFuture.waitForFinished();
   }
 
-  auto suffix = QFileInfo(this->prop.name).suffix();
-  if (this->openMode == OpenMode::CSVFile ||
-      (this->openMode == OpenMode::Extension && suffix == "csv"))
-    this->file.reset(new stats::StatisticsFileCSV(this->prop.name, this->statisticsData));
-  else if (this->openMode == OpenMode::VTMBMSFile ||
-           (this->openMode == OpenMode::Extension && suffix == "vtmbmsstats"))
-    this->file.reset(new stats::StatisticsFileVTMBMS(this->prop.name, this->statisticsData));
-  else
-    assert(false);
+  this->file = createStatisticsFile(this->prop.name, this->openMode, this->statisticsData);
+  assert(this->file);
 
   connect(this->file.get(),
           &stats::StatisticsFileBase::readPOC,
@@ -311,13 +483,17 @@ void playlistItemStatisticsFile::timerEvent(QTimerEvent *event)
   if (event->timerId() != timer.timerId())
     return playlistItem::timerEvent(event);
 
+  auto recache = RECACHE_NONE;
   if (!backgroundParserFuture.isRunning())
   {
     timer.stop();
     DEBUG_STAT("playlistItemStatisticsFile::timerEvent Background parsing done.");
+    // The item can be cached now
+    this->updateCachingStatisticsTypes();
+    recache = RECACHE_UPDATE;
   }
 
   if (this->file)
     this->prop.startEndRange = indexRange(0, this->file->getMaxPoc());
-  emit SignalItemChanged(false, RECACHE_NONE);
+  emit SignalItemChanged(false, recache);
 }
@@ -35,6 +35,7 @@
 #include <QBasicTimer>
 #include <QFuture>
 #include <memory>
+#include <mutex>
 
 #include "playlistItem.h"
 #include "statistics/StatisticsFileBase.h"
@@ -48,6 +49,7 @@ public:
   {
     CSVFile,
     VTMBMSFile,
+    BinaryFile,
     Extension
   };
 
@@ -84,6 +86,20 @@ public:
   // Are statistics currently being loaded?
   virtual bool isLoading() const override { return isStatisticsLoading; }
 
+  // ----- Caching -----
+  // The statistics of frames are cached in the background so that playback with statistics runs
+  // with the frame rate. Caching is possible when the file was parsed.
+  virtual bool isCachable() const override;
+
+  // All loading goes through the file so there is no benefit from multiple threads
+  virtual int          cachingThreadLimit() override { return 1; }
+  virtual void         cacheFrame(int frameIdx, bool testMode) override;
+  virtual QList<int>   getCachedFrames() const override;
+  virtual int          getNumberCachedFrames() const override;
+  virtual unsigned int getCachingFrameSize() const override;
+  virtual void         removeFrameFromCache(int frameIdx) override;
+  virtual void         removeAllFramesFromCache() override;
+
   // Override from playlistItem. Return the statistics values under the given pixel position.
   virtual ValuePairListSets getPixelValues(const QPoint &pixelPos, int frameIdx) override;
 
@@ -102,6 +118,8 @@ public:
 protected slots:
   void onPOCTypeParsed(int poc, int typeID);
   void onPOCParsed(int poc);
+  // Ask for a file name and convert the statistics file to a binary statistics file
+  void convertToBinaryFile();
 
 protected:
   // Overload from playlistItem. Create a properties widget custom to the statistics item
@@ -110,11 +128,22 @@ protected:
 
   void openStatisticsFile();
 
+  // Copy the statistics types and frame size for the caching threads. Called in the GUI thread
+  // when the file was parsed and when the types were changed in the controls.
+  void updateCachingStatisticsTypes();
+
   stats::StatisticUIHandler statisticsUIHandler;
   stats::StatisticsData     statisticsData;
 
   std::unique_ptr<stats::StatisticsFileBase> file;
   OpenMode                                   openMode;
+  // Loading from the file is not thread safe (interactive loading and caching)
+  std::mutex fileMutex;
+
+  // The copy of the statistics types and frame size that is used in cacheFrame
+  std::mutex                cachingTypesMutex;
+  stats::StatisticsTypesVec cachingStatisticsTypes;
+  Size                      cachingFrameSize;
 
   // Is the loadFrame function currently loading?
   bool isStatisticsLoading;
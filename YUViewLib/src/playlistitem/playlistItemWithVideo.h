@@ -93,6 +93,12 @@ public:
     if (video)
       video->removeAllFrameFromCache();
   }
+  // The video handler reads the caching related settings.
+  virtual void updateSettings() override
+  {
+    if (video)
+      video->updateSettings();
+  }
   // This item is cachable, if caching is enabled and if the raw format is valid (can be cached).
   virtual bool isCachable() const override
   {
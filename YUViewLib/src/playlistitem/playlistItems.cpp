@@ -44,8 +44,11 @@
 
 #include <QInputDialog>
 #include <QMessageBox>
+#include <QSettings>
 #include <QStringList>
 
+#include <filesource/FileSource.h>
+
 namespace
 {
 
@@ -76,24 +79,80 @@ playlistItem *openImageFileOrSequence(QWidget *parent, const QString &fileName)
     return new playlistItemImageFile(fileName);
 }
 
-playlistItem *guessFileTypeFromFileAndCreatePlaylistItem(QWidget *parent, const QString &fileName)
+template <typename GetExtensionsFunction>
+bool hasSupportedExtension(const QString &       fileName,
+                           GetExtensionsFunction getSupportedFileExtensions)
+{
+  QStringList allExtensions, filtersList;
+  getSupportedFileExtensions(allExtensions, filtersList);
+  return allExtensions.contains(QFileInfo(fileName).suffix().toLower());
+}
+
+bool isCompressedVideoTag(const QString &tag)
+{
+  // For backwards compability (playlistItemCompressedFile used to be called
+  // playlistItemRawCodedVideo or playlistItemHEVCFile)
+  return tag == "playlistItemCompressedVideo" || tag == "playlistItemCompressedFile" ||
+         tag == "playlistItemFFmpegFile" || tag == "playlistItemHEVCFile" ||
+         tag == "playlistItemRawCodedVideo";
+}
+
+QString getFilePathOfItem(const YUViewDomElement &item, const QString &playlistFilePath)
+{
+  return FileSource::getAbsPathFromAbsAndRel(
+      playlistFilePath, item.findChildValue("absolutePath"), item.findChildValue("relativePath"));
+}
+
+const FileSourceFFmpegFile::ScanResult *
+findFFmpegScanResult(const std::vector<playlistItems::PreparedFile> &preparedFiles,
+                     const QString &                                  fileName)
+{
+  for (const auto &preparedFile : preparedFiles)
+    if (preparedFile.fileName == fileName && preparedFile.ffmpegScanResult)
+      return &(*preparedFile.ffmpegScanResult);
+  return nullptr;
+}
+
+void appendFilesToPrepare(const QDomElement &elem,
+                          const QString &    playlistFilePath,
+                          QStringList &      files)
+{
+  const YUViewDomElement item(elem);
+  if (isCompressedVideoTag(elem.tagName()))
+  {
+    // Only files that are read using libav are scanned when opening them
+    const auto inputFormat = item.findChildValue("inputFormat");
+    const auto readFormat  = InputFormatMapper.getValue(inputFormat.toStdString());
+    if (inputFormat.isEmpty() || readFormat == InputFormat::Libav)
+    {
+      const auto filePath = getFilePathOfItem(item, playlistFilePath);
+      if (!filePath.isEmpty() && !files.contains(filePath))
+        files.append(filePath);
+    }
+  }
+
+  for (auto n = elem.firstChildElement(); !n.isNull(); n = n.nextSiblingElement())
+    appendFilesToPrepare(n, playlistFilePath, files);
+}
+
+playlistItem *
+guessFileTypeFromFileAndCreatePlaylistItem(QWidget *                          parent,
+                                           const playlistItems::PreparedFile &preparedFile)
 {
-  QFileInfo  fi(fileName);
-  const auto extension = fi.suffix().toLower();
-
-  auto checkForExtension = [&extension](auto getSupportedFileExtensions) {
-    QStringList allExtensions, filtersList;
-    getSupportedFileExtensions(allExtensions, filtersList);
-    return allExtensions.contains(extension);
-  };
-
-  if (checkForExtension(playlistItemRawFile::getSupportedFileExtensions))
-    return new playlistItemRawFile(fileName);
-  if (checkForExtension(playlistItemCompressedVideo::getSupportedFileExtensions))
-    return new playlistItemCompressedVideo(fileName);
-  if (checkForExtension(playlistItemImageFile::getSupportedFileExtensions))
+  const auto &fileName = preparedFile.fileName;
+  if (hasSupportedExtension(fileName, playlistItemRawFile::getSupportedFileExtensions))
+    return new playlistItemRawFile(fileName, {}, {}, {}, preparedFile.rawFormat);
+  if (hasSupportedExtension(fileName, playlistItemCompressedVideo::getSupportedFileExtensions))
+    return new playlistItemCompressedVideo(fileName,
+                                           0,
+                                           InputFormat::Invalid,
+                                           decoder::DecoderEngine::Invalid,
+                                           preparedFile.ffmpegScanResult
+                                               ? &(*preparedFile.ffmpegScanResult)
+                                               : nullptr);
+  if (hasSupportedExtension(fileName, playlistItemImageFile::getSupportedFileExtensions))
     return openImageFileOrSequence(parent, fileName);
-  if (checkForExtension(playlistItemStatisticsFile::getSupportedFileExtensions))
+  if (hasSupportedExtension(fileName, playlistItemStatisticsFile::getSupportedFileExtensions))
     return new playlistItemStatisticsFile(fileName);
 
   return {};
@@ -108,7 +167,8 @@ playlistItem *askUserForFileTypeAndCreatePlalistItem(QWidget *  parent,
                                    << "Compressed file"
                                    << "Image file"
                                    << "Statistics File CSV"
-                                   << "Statistics File VTMBMS";
+                                   << "Statistics File VTMBMS"
+                                   << "Statistics File Binary";
   bool    ok{};
   QString message = "Unable to detect file type from file extension.";
   if (!determineFileTypeAutomatically)
@@ -135,10 +195,13 @@ playlistItem *askUserForFileTypeAndCreatePlalistItem(QWidget *  parent,
     {
       return openImageFileOrSequence(parent, fileName);
     }
-    else if (asType == types[4] || asType == types[5])
+    else if (asType == types[4] || asType == types[5] || asType == types[6])
     {
-      auto openMode = (asType == types[3] ? playlistItemStatisticsFile::OpenMode::CSVFile
-                                          : playlistItemStatisticsFile::OpenMode::VTMBMSFile);
+      auto openMode = playlistItemStatisticsFile::OpenMode::BinaryFile;
+      if (asType == types[4])
+        openMode = playlistItemStatisticsFile::OpenMode::CSVFile;
+      else if (asType == types[5])
+        openMode = playlistItemStatisticsFile::OpenMode::VTMBMSFile;
       return new playlistItemStatisticsFile(fileName, openMode);
     }
   }
@@ -200,22 +263,57 @@ QStringList getSupportedNameFilters()
   return nameFilters;
 }
 
+PreparedFile prepareFile(const QString &fileName, const PrepareProgressCallback &progressCallback)
+{
+  PreparedFile preparedFile;
+  preparedFile.fileName = fileName;
+
+  // If the file type is not detected from the extension, the user is asked for it when the item is
+  // created. There is nothing we can prepare then.
+  QSettings settings;
+  if (!settings.value("AutodetectFileType", true).toBool())
+    return preparedFile;
+
+  if (hasSupportedExtension(fileName, playlistItemRawFile::getSupportedFileExtensions))
+    preparedFile.rawFormat = playlistItemRawFile::detectFormatFromContent(fileName);
+  else if (hasSupportedExtension(fileName, playlistItemCompressedVideo::getSupportedFileExtensions))
+    preparedFile.ffmpegScanResult =
+        playlistItemCompressedVideo::prepareFile(fileName, InputFormat::Invalid, progressCallback);
+
+  return preparedFile;
+}
+
+QStringList getFilesToPrepare(const QDomElement &root, const QString &playlistFilePath)
+{
+  QStringList files;
+  for (auto n = root.firstChildElement(); !n.isNull(); n = n.nextSiblingElement())
+    appendFilesToPrepare(n, playlistFilePath, files);
+  return files;
+}
+
 playlistItem *createPlaylistItemFromFile(QWidget *parent, const QString &fileName)
+{
+  return createPlaylistItemFromFile(parent, PreparedFile({fileName, {}}));
+}
+
+playlistItem *createPlaylistItemFromFile(QWidget *parent, const PreparedFile &preparedFile)
 {
   QSettings  settings;
   const auto determineFileTypeAutomatically = settings.value("AutodetectFileType", true).toBool();
 
   playlistItem *newPlaylistItem{};
   if (determineFileTypeAutomatically)
-    newPlaylistItem = guessFileTypeFromFileAndCreatePlaylistItem(parent, fileName);
+    newPlaylistItem = guessFileTypeFromFileAndCreatePlaylistItem(parent, preparedFile);
   if (!newPlaylistItem)
-    newPlaylistItem =
-        askUserForFileTypeAndCreatePlalistItem(parent, fileName, determineFileTypeAutomatically);
+    newPlaylistItem = askUserForFileTypeAndCreatePlalistItem(
+        parent, preparedFile.fileName, determineFileTypeAutomatically);
 
   return newPlaylistItem;
 }
 
-playlistItem *loadPlaylistItem(const QDomElement &elem, const QString &filePath)
+playlistItem *loadPlaylistItem(const QDomElement &              elem,
+                               const QString &                  filePath,
+                               const std::vector<PreparedFile> &preparedFiles)
 {
   playlistItem *newItem       = nullptr;
   bool          parseChildren = false;
@@ -225,13 +323,12 @@ playlistItem *loadPlaylistItem(const QDomElement &elem, const QString &filePath)
   {
     newItem = playlistItemRawFile::newplaylistItemRawFile(elem, filePath);
   }
-  // For backwards compability (playlistItemCompressedFile used to be called
-  // playlistItemRawCodedVideo or playlistItemHEVCFile)
-  else if (tag == "playlistItemCompressedVideo" || tag == "playlistItemCompressedFile" ||
-           tag == "playlistItemFFmpegFile" || tag == "playlistItemHEVCFile" ||
-           tag == "playlistItemRawCodedVideo")
+  else if (isCompressedVideoTag(tag))
   {
-    newItem = playlistItemCompressedVideo::newPlaylistItemCompressedVideo(elem, filePath);
+    const auto scanResult =
+        findFFmpegScanResult(preparedFiles, getFilePathOfItem(YUViewDomElement(elem), filePath));
+    newItem =
+        playlistItemCompressedVideo::newPlaylistItemCompressedVideo(elem, filePath, scanResult);
   }
   else if (tag == "playlistItemStatisticsFile" || tag == "playlistItemStatisticsCSVFile" ||
            tag == "playlistItemStatisticsVTMBMSFile")
@@ -279,7 +376,7 @@ playlistItem *loadPlaylistItem(const QDomElement &elem, const QString &filePath)
     for (int i = 0; i < children.length(); i++)
     {
       const auto childElement = children.item(i).toElement();
-      if (const auto childItem = loadPlaylistItem(childElement, filePath))
+      if (const auto childItem = loadPlaylistItem(childElement, filePath, preparedFiles))
         newItem->addChild(childItem);
     }
 
@@ -37,6 +37,12 @@
 #include <QStringList>
 #include <QWidget>
 
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include <filesource/FileSourceFFmpegFile.h>
+
 #include "playlistItem.h"
 
 /* This namespace contains all functions that are needed for creation of playlist Items. This way,
@@ -52,9 +58,35 @@ QStringList getSupportedFormatsFilters();
 // Get a list of all supported file extensions (["*.csv", "*.yuv" ...])
 QStringList getSupportedNameFilters();
 
+// The result of preparing a file for opening (see prepareFile)
+struct PreparedFile
+{
+  QString fileName;
+  // The format of a raw file that was detected from the file content
+  QString rawFormat;
+  // The result of scanning a file that is read using libav
+  std::optional<FileSourceFFmpegFile::ScanResult> ffmpegScanResult;
+};
+
+// Called with the progress in percent while a file is prepared. Return false to abort.
+using PrepareProgressCallback = std::function<bool(int)>;
+
+// Do the slow work that is needed to open the given file (scanning or format detection) without
+// creating the playlist item. This does not need the GUI and can be called from any thread for
+// multiple files in parallel. The results are used by createPlaylistItemFromFile.
+PreparedFile prepareFile(const QString &fileName, const PrepareProgressCallback &progressCallback);
+
+// Get the files of the items in the playlist that should be prepared before the items are loaded
+// from the playlist (see prepareFile).
+QStringList getFilesToPrepare(const QDomElement &root, const QString &playlistFilePath);
+
 // When given a file, this function will create the correct playlist item
 playlistItem *createPlaylistItemFromFile(QWidget *parent, const QString &fileName);
+playlistItem *createPlaylistItemFromFile(QWidget *parent, const PreparedFile &preparedFile);
 
-// Load a playlist item (and all of it's children) from the playlist.
-playlistItem *loadPlaylistItem(const QDomElement &elem, const QString &filePath);
+// Load a playlist item (and all of it's children) from the playlist. The prepared files of the
+// items (see getFilesToPrepare) are used if given.
+playlistItem *loadPlaylistItem(const QDomElement &              elem,
+                               const QString &                  filePath,
+                               const std::vector<PreparedFile> &preparedFiles = {});
 } // namespace playlistItems
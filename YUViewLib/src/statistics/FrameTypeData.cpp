@@ -32,9 +32,52 @@
 
 #include "FrameTypeData.h"
 
+#include <cstdlib>
+
 namespace stats
 {
 
+namespace
+{
+
+template <typename T> Area getBlockArea(const T &item)
+{
+  return {item.pos[0],
+          item.pos[1],
+          item.pos[0] + std::max(int(item.size[0]), 1) - 1,
+          item.pos[1] + std::max(int(item.size[1]), 1) - 1};
+}
+
+Area getBoundingArea(const Polygon &polygon)
+{
+  if (polygon.empty())
+    return {0, 0, -1, -1};
+
+  Area area{polygon.front().x, polygon.front().y, polygon.front().x, polygon.front().y};
+  for (const auto &point : polygon)
+  {
+    area.xMin = std::min(area.xMin, point.x);
+    area.yMin = std::min(area.yMin, point.y);
+    area.xMax = std::max(area.xMax, point.x);
+    area.yMax = std::max(area.yMax, point.y);
+  }
+  return area;
+}
+
+template <typename T, typename GetArea>
+std::vector<unsigned> getItemsInArea(SpatialIndex         &index,
+                                     const std::vector<T> &items,
+                                     const Area           &area,
+                                     GetArea               getArea)
+{
+  // Items are only ever added. So if the number of items did not change, the index is up to date.
+  if (!index.isBuilt() || index.getNrItems() != items.size())
+    index.build(items.size(), [&](size_t i) { return getArea(items[i]); });
+  return index.getItemsInArea(area);
+}
+
+} // namespace
+
 void FrameTypeData::addBlockValue(
     unsigned short x, unsigned short y, unsigned short w, unsigned short h, int val)
 {
@@ -131,4 +174,67 @@ void FrameTypeData::addPolygonVector(const Polygon &points, int vecX, int vecY)
   polygonVectorData.push_back(vec);
 }
 
+std::vector<unsigned> FrameTypeData::getValueItemsInArea(const Area &area) const
+{
+  return getItemsInArea(this->valueIndex, this->valueData, area, getBlockArea<StatsItemValue>);
+}
+
+std::vector<unsigned> FrameTypeData::getAffineTFItemsInArea(const Area &area) const
+{
+  return getItemsInArea(
+      this->affineTFIndex, this->affineTFData, area, getBlockArea<StatsItemAffineTF>);
+}
+
+std::vector<unsigned> FrameTypeData::getPolygonValueItemsInArea(const Area &area) const
+{
+  return getItemsInArea(
+      this->polygonValueIndex, this->polygonValueData, area, [](const StatsItemPolygonValue &item) {
+        return getBoundingArea(item.corners);
+      });
+}
+
+std::vector<unsigned> FrameTypeData::getPolygonVectorItemsInArea(const Area &area) const
+{
+  return getItemsInArea(this->polygonVectorIndex,
+                        this->polygonVectorData,
+                        area,
+                        [](const StatsItemPolygonVector &item) {
+                          return getBoundingArea(item.corners);
+                        });
+}
+
+std::vector<unsigned> FrameTypeData::getVectorItemsInArea(const Area &area, int vectorScale) const
+{
+  // Lines are indexed with their start and end point. For vectors, the length of the arrow depends
+  // on the vector scale. So these are indexed by their block and we search in a bigger area.
+  if (!this->vectorIndex.isBuilt() || this->vectorIndex.getNrItems() != this->vectorData.size())
+  {
+    this->maxVectorComponent = 0;
+    for (const auto &item : this->vectorData)
+      if (!item.isLine)
+        this->maxVectorComponent = std::max(
+            {this->maxVectorComponent, std::abs(item.point[0].x), std::abs(item.point[0].y)});
+
+    this->vectorIndex.build(this->vectorData.size(), [this](size_t i) {
+      const auto &item = this->vectorData[i];
+      auto        area = getBlockArea(item);
+      if (item.isLine)
+      {
+        for (const auto &point : item.point)
+        {
+          area.xMin = std::min(area.xMin, item.pos[0] + point.x);
+          area.yMin = std::min(area.yMin, item.pos[1] + point.y);
+          area.xMax = std::max(area.xMax, item.pos[0] + point.x);
+          area.yMax = std::max(area.yMax, item.pos[1] + point.y);
+        }
+      }
+      return area;
+    });
+  }
+
+  const auto margin = this->maxVectorComponent / std::max(std::abs(vectorScale), 1) + 1;
+  return this->vectorIndex.getItemsInArea(
+      {area.xMin - margin, area.yMin - margin, area.xMax + margin, area.yMax + margin});
+}
+
 } // namespace stats
@@ -34,6 +34,8 @@
 
 #include <common/Typedef.h>
 
+#include "SpatialIndex.h"
+
 namespace stats
 {
 
@@ -144,6 +146,16 @@ public:
   void addPolygonVector(const Polygon &points, int vecX, int vecY);
   void addPolygonValue(const Polygon &points, int val);
 
+  // Get the indices of the items that may be in the given area of the frame (in pixels). The
+  // indices are sorted. The spatial index for the items is built when this is called for the first
+  // time after items were added. Not thread safe (use the accessMutex of the StatisticsData).
+  std::vector<unsigned> getValueItemsInArea(const Area &area) const;
+  std::vector<unsigned> getAffineTFItemsInArea(const Area &area) const;
+  std::vector<unsigned> getPolygonValueItemsInArea(const Area &area) const;
+  std::vector<unsigned> getPolygonVectorItemsInArea(const Area &area) const;
+  // Vectors are included if the arrow may be in the area (when drawn with the given vectorScale)
+  std::vector<unsigned> getVectorItemsInArea(const Area &area, int vectorScale) const;
+
   std::vector<StatsItemValue>         valueData;
   std::vector<StatsItemVector>        vectorData;
   std::vector<StatsItemAffineTF>      affineTFData;
@@ -153,6 +165,16 @@ public:
   // What is the size (area) of the biggest block)? This is needed for scaling the blocks according
   // to their size.
   unsigned maxBlockSize;
+
+private:
+  mutable SpatialIndex valueIndex;
+  mutable SpatialIndex vectorIndex;
+  mutable SpatialIndex affineTFIndex;
+  mutable SpatialIndex polygonValueIndex;
+  mutable SpatialIndex polygonVectorIndex;
+
+  // The biggest x or y component of all vectors which are not lines
+  mutable int maxVectorComponent{};
 };
 
 } // namespace stats
@@ -0,0 +1,90 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SpatialIndex.h"
+
+#include <numeric>
+
+namespace stats
+{
+
+std::vector<unsigned> SpatialIndex::getItemsInArea(const Area &area) const
+{
+  std::vector<unsigned> items;
+  if (this->nrItems == 0)
+    return items;
+
+  // The whole frame is visible (e.g. when it is fit to the window). Don't go through the cells.
+  if (this->coversAllCells(area))
+  {
+    items.resize(this->nrItems);
+    std::iota(items.begin(), items.end(), 0u);
+    return items;
+  }
+
+  auto nrCells = 0u;
+  this->forEachCell(area, [&](size_t cell) {
+    items.insert(items.end(),
+                 this->itemIndices.begin() + this->cellStart[cell],
+                 this->itemIndices.begin() + this->cellStart[cell + 1]);
+    nrCells++;
+  });
+  if (nrCells <= 1)
+    return items;
+
+  // Items that are bigger than a cell are in multiple cells. Also, the caller expects the items in
+  // the order in which they were added. For big areas, marking the items is faster than sorting.
+  if (items.size() < this->nrItems / 16)
+  {
+    std::sort(items.begin(), items.end());
+    items.erase(std::unique(items.begin(), items.end()), items.end());
+    return items;
+  }
+
+  std::vector<bool> itemInArea(this->nrItems);
+  for (const auto item : items)
+    itemInArea[item] = true;
+  items.clear();
+  for (unsigned item = 0; item < unsigned(this->nrItems); item++)
+    if (itemInArea[item])
+      items.push_back(item);
+  return items;
+}
+
+bool SpatialIndex::coversAllCells(const Area &area) const
+{
+  return area.xMin <= area.xMax && area.yMin <= area.yMax && area.xMin < CELL_SIZE &&
+         area.yMin < CELL_SIZE && area.xMax >= (this->nrColumns - 1) * CELL_SIZE &&
+         area.yMax >= (this->nrRows - 1) * CELL_SIZE;
+}
+
+} // namespace stats
@@ -0,0 +1,142 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace stats
+{
+
+// An area in the frame (in pixels). All borders are inclusive.
+struct Area
+{
+  int xMin{};
+  int yMin{};
+  int xMax{};
+  int yMax{};
+};
+
+/* A uniform grid over the frame which stores for each cell (CTU sized) which items overlap it.
+ * With this we can get the items at a certain position or in the visible part of the frame
+ * without going through all items. The index does not know the items themselves, only their
+ * indices and their areas at the time the index was built.
+ */
+class SpatialIndex
+{
+public:
+  SpatialIndex() = default;
+
+  // Build the index for nrItems items. getArea(i) must return the Area of item i.
+  template <typename GetArea> void build(size_t nrItems, GetArea getArea);
+
+  // Get the (sorted) indices of all items that may overlap the given area. Items are returned if
+  // they overlap one of the grid cells that the area overlaps. So the caller still has to check
+  // if the item is really in the area.
+  std::vector<unsigned> getItemsInArea(const Area &area) const;
+
+  bool   isBuilt() const { return this->built; }
+  size_t getNrItems() const { return this->nrItems; }
+
+private:
+  static constexpr int CELL_SIZE = 64;
+
+  // Does the area overlap all cells of the grid? Then all items may be in the area.
+  bool coversAllCells(const Area &area) const;
+
+  // Call function(cellIndex) for all cells that the area overlaps
+  template <typename Function> void forEachCell(const Area &area, Function function) const;
+
+  bool   built{};
+  size_t nrItems{};
+  int    nrColumns{};
+  int    nrRows{};
+
+  // The item indices of cell c are itemIndices[cellStart[c]] to itemIndices[cellStart[c + 1] - 1]
+  std::vector<unsigned> cellStart;
+  std::vector<unsigned> itemIndices;
+};
+
+template <typename Function>
+void SpatialIndex::forEachCell(const Area &area, Function function) const
+{
+  if (area.xMin > area.xMax || area.yMin > area.yMax)
+    return;
+
+  // Everything outside of the grid is in the border cells
+  const auto getColumn = [this](int x) { return std::clamp(x / CELL_SIZE, 0, this->nrColumns - 1); };
+  const auto getRow    = [this](int y) { return std::clamp(y / CELL_SIZE, 0, this->nrRows - 1); };
+
+  const auto firstColumn = getColumn(area.xMin);
+  const auto lastColumn  = getColumn(area.xMax);
+  const auto firstRow    = getRow(area.yMin);
+  const auto lastRow     = getRow(area.yMax);
+  for (auto row = firstRow; row <= lastRow; row++)
+    for (auto column = firstColumn; column <= lastColumn; column++)
+      function(size_t(row) * size_t(this->nrColumns) + size_t(column));
+}
+
+template <typename GetArea> void SpatialIndex::build(size_t nrItems, GetArea getArea)
+{
+  this->built   = true;
+  this->nrItems = nrItems;
+  this->cellStart.clear();
+  this->itemIndices.clear();
+
+  int maxX = 0;
+  int maxY = 0;
+  for (size_t i = 0; i < nrItems; i++)
+  {
+    const auto area = getArea(i);
+    maxX            = std::max(maxX, area.xMax);
+    maxY            = std::max(maxY, area.yMax);
+  }
+  this->nrColumns = maxX / CELL_SIZE + 1;
+  this->nrRows    = maxY / CELL_SIZE + 1;
+
+  // Count the items per cell first so that we can put all indices in one vector
+  const auto nrCells = size_t(this->nrColumns) * size_t(this->nrRows);
+  this->cellStart.assign(nrCells + 1, 0);
+  for (size_t i = 0; i < nrItems; i++)
+    this->forEachCell(getArea(i), [this](size_t cell) { this->cellStart[cell + 1]++; });
+  for (size_t cell = 0; cell < nrCells; cell++)
+    this->cellStart[cell + 1] += this->cellStart[cell];
+
+  this->itemIndices.resize(this->cellStart[nrCells]);
+  auto nextPosInCell = std::vector<unsigned>(this->cellStart.begin(), this->cellStart.end() - 1);
+  for (size_t i = 0; i < nrItems; i++)
+    this->forEachCell(getArea(i),
+                      [&](size_t cell) { this->itemIndices[nextPosInCell[cell]++] = unsigned(i); });
+}
+
+} // namespace stats
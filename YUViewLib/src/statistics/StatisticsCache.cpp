@@ -0,0 +1,181 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "StatisticsCache.h"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+
+namespace stats
+{
+
+void StatisticsCache::setMemoryLimit(size_t bytes)
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  this->memoryLimit = bytes;
+  this->removeEntriesOverLimit();
+}
+
+size_t StatisticsCache::getMemoryLimit() const
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  return this->memoryLimit;
+}
+
+void StatisticsCache::insert(int poc, int typeID, FrameTypeData &&data)
+{
+  const auto memoryUsage = estimateMemoryUsage(data);
+
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+
+  const auto key = Key(poc, typeID);
+  if (auto it = this->entryMap.find(key); it != this->entryMap.end())
+    this->removeEntry(it->second);
+
+  if (memoryUsage > this->memoryLimit)
+    return;
+
+  this->entries.push_front(Entry{key, std::move(data), memoryUsage});
+  this->entryMap[key] = this->entries.begin();
+  this->memoryUsage += memoryUsage;
+  this->removeEntriesOverLimit();
+}
+
+std::optional<FrameTypeData> StatisticsCache::get(int poc, int typeID)
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+
+  auto it = this->entryMap.find(Key(poc, typeID));
+  if (it == this->entryMap.end())
+    return {};
+
+  this->entries.splice(this->entries.begin(), this->entries, it->second);
+  return it->second->data;
+}
+
+bool StatisticsCache::contains(int poc, int typeID) const
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  return this->entryMap.count(Key(poc, typeID)) > 0;
+}
+
+void StatisticsCache::removeFrame(int poc)
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+
+  auto it = this->entryMap.lower_bound(Key(poc, std::numeric_limits<int>::min()));
+  while (it != this->entryMap.end() && it->first.first == poc)
+  {
+    auto entry = it->second;
+    it++;
+    this->removeEntry(entry);
+  }
+}
+
+void StatisticsCache::clear()
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  this->entries.clear();
+  this->entryMap.clear();
+  this->memoryUsage = 0;
+}
+
+std::vector<int> StatisticsCache::getCachedFrames(const std::vector<int> &typeIDs) const
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+
+  std::vector<int> frames;
+  if (typeIDs.empty())
+    return frames;
+
+  // The map is sorted by POC so all types of a POC are next to each other
+  auto it = this->entryMap.begin();
+  while (it != this->entryMap.end())
+  {
+    const auto    poc = it->first.first;
+    std::set<int> cachedTypes;
+    for (; it != this->entryMap.end() && it->first.first == poc; it++)
+      cachedTypes.insert(it->first.second);
+
+    if (std::all_of(typeIDs.begin(), typeIDs.end(), [&cachedTypes](int typeID) {
+          return cachedTypes.count(typeID) > 0;
+        }))
+      frames.push_back(poc);
+  }
+  return frames;
+}
+
+size_t StatisticsCache::getNumberCachedFrames() const
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+
+  std::set<int> pocs;
+  for (const auto &entry : this->entryMap)
+    pocs.insert(entry.first.first);
+  return pocs.size();
+}
+
+size_t StatisticsCache::getMemoryUsage() const
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  return this->memoryUsage;
+}
+
+size_t StatisticsCache::estimateMemoryUsage(const FrameTypeData &data)
+{
+  auto memoryUsage = sizeof(FrameTypeData);
+  memoryUsage += data.valueData.size() * sizeof(StatsItemValue);
+  memoryUsage += data.vectorData.size() * sizeof(StatsItemVector);
+  memoryUsage += data.affineTFData.size() * sizeof(StatsItemAffineTF);
+  for (const auto &polygonValue : data.polygonValueData)
+    memoryUsage += sizeof(StatsItemPolygonValue) + polygonValue.corners.size() * sizeof(Point);
+  for (const auto &polygonVector : data.polygonVectorData)
+    memoryUsage += sizeof(StatsItemPolygonVector) + polygonVector.corners.size() * sizeof(Point);
+  return memoryUsage;
+}
+
+void StatisticsCache::removeEntry(std::list<Entry>::iterator entry)
+{
+  this->memoryUsage -= entry->memoryUsage;
+  this->entryMap.erase(entry->key);
+  this->entries.erase(entry);
+}
+
+void StatisticsCache::removeEntriesOverLimit()
+{
+  while (this->memoryUsage > this->memoryLimit && !this->entries.empty())
+    this->removeEntry(std::prev(this->entries.end()));
+}
+
+} // namespace stats
@@ -0,0 +1,108 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "FrameTypeData.h"
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace stats
+{
+
+/* A cache for the statistics of multiple frames. The data is kept per POC and type ID so that the
+ * statistics of a frame can be shown again without loading (parsing or decoding) them again. When
+ * the memory of all cached entries exceeds the limit, the least recently used entries are removed.
+ * All functions are thread safe.
+ */
+class StatisticsCache
+{
+public:
+  StatisticsCache() = default;
+
+  // A limit of 0 disables the cache. Entries are removed if the new limit is exceeded.
+  void   setMemoryLimit(size_t bytes);
+  size_t getMemoryLimit() const;
+
+  // Insert (or replace) the data for the POC/type. Entries which need more memory than the limit
+  // are not inserted.
+  void insert(int poc, int typeID, FrameTypeData &&data);
+
+  // Get a copy of the data for the POC/type and mark it as recently used
+  std::optional<FrameTypeData> get(int poc, int typeID);
+  bool                         contains(int poc, int typeID) const;
+
+  void removeFrame(int poc);
+  void clear();
+
+  // Get all POCs for which the data of all the given types is cached (sorted)
+  std::vector<int> getCachedFrames(const std::vector<int> &typeIDs) const;
+  size_t           getNumberCachedFrames() const;
+  size_t           getMemoryUsage() const;
+
+  // Statistics that are not cached by the video cache (e.g. those of compressed files which are
+  // decoded together with the frames) get this part of the video cache threshold. The video cache
+  // does not use this part for frames.
+  static size_t getShareOfVideoCacheThreshold(size_t thresholdBytes) { return thresholdBytes / 16; }
+
+  // An estimate of the memory that the data needs. Items in the vectors are counted with their
+  // size, the spatial indices are not counted.
+  static size_t estimateMemoryUsage(const FrameTypeData &data);
+
+private:
+  using Key = std::pair<int, int>; // POC, type ID
+
+  struct Entry
+  {
+    Key           key;
+    FrameTypeData data;
+    size_t        memoryUsage{};
+  };
+
+  void removeEntry(std::list<Entry>::iterator entry);
+  void removeEntriesOverLimit();
+
+  mutable std::mutex accessMutex;
+
+  // The most recently used entry is in the front
+  std::list<Entry>                          entries;
+  std::map<Key, std::list<Entry>::iterator> entryMap;
+  size_t                                    memoryUsage{};
+  size_t                                    memoryLimit{};
+};
+
+} // namespace stats
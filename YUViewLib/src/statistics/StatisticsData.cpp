@@ -34,6 +34,9 @@
 
 #include <common/Functions.h>
 
+#include <QSettings>
+#include <algorithm>
+
 // Activate this if you want to know when what is loaded.
 #define STATISTICS_DEBUG_LOADING 0
 #if STATISTICS_DEBUG_LOADING && !NDEBUG
@@ -209,10 +212,14 @@ QStringPairList StatisticsData::getValuesAt(const QPoint &pos) const
       // no active statistics data
       continue;
 
+    const auto &frameTypeData = this->frameCache.at(it->typeID);
+    const auto  area          = Area{pos.x(), pos.y(), pos.x(), pos.y()};
+
     // Get all value data entries
     bool foundStats = false;
-    for (const auto &valueItem : this->frameCache.at(it->typeID).valueData)
+    for (const auto i : frameTypeData.getValueItemsInArea(area))
     {
+      const auto &valueItem = frameTypeData.valueData[i];
       auto rect = QRect(valueItem.pos[0], valueItem.pos[1], valueItem.size[0], valueItem.size[1]);
       if (rect.contains(pos))
       {
@@ -226,8 +233,9 @@ QStringPairList StatisticsData::getValuesAt(const QPoint &pos) const
       }
     }
 
-    for (const auto &vectorItem : this->frameCache.at(it->typeID).vectorData)
+    for (const auto i : frameTypeData.getVectorItemsInArea(area, it->vectorScale))
     {
+      const auto &vectorItem = frameTypeData.vectorData[i];
       auto rect =
           QRect(vectorItem.pos[0], vectorItem.pos[1], vectorItem.size[0], vectorItem.size[1]);
       if (rect.contains(pos))
@@ -250,8 +258,9 @@ QStringPairList StatisticsData::getValuesAt(const QPoint &pos) const
       }
     }
 
-    for (const auto &affineTFItem : this->frameCache.at(it->typeID).affineTFData)
+    for (const auto i : frameTypeData.getAffineTFItemsInArea(area))
     {
+      const auto &affineTFItem = frameTypeData.affineTFData[i];
       const auto rect = QRect(
           affineTFItem.pos[0], affineTFItem.pos[1], affineTFItem.size[0], affineTFItem.size[1]);
       if (rect.contains(pos))
@@ -269,8 +278,9 @@ QStringPairList StatisticsData::getValuesAt(const QPoint &pos) const
       }
     }
 
-    for (const auto &valueItem : this->frameCache.at(it->typeID).polygonValueData)
+    for (const auto i : frameTypeData.getPolygonValueItemsInArea(area))
     {
+      const auto &valueItem = frameTypeData.polygonValueData[i];
       if (valueItem.corners.size() < 3)
         continue; // need at least triangle -- or more corners
       if (stats::polygonContainsPoint(valueItem.corners, Point(pos.x(), pos.y())))
@@ -282,8 +292,9 @@ QStringPairList StatisticsData::getValuesAt(const QPoint &pos) const
       }
     }
 
-    for (const auto &polygonVectorItem : this->frameCache.at(it->typeID).polygonVectorData)
+    for (const auto i : frameTypeData.getPolygonVectorItemsInArea(area))
     {
+      const auto &polygonVectorItem = frameTypeData.polygonVectorData[i];
       if (polygonVectorItem.corners.size() < 3)
         continue; // need at least triangle -- or more corners
       if (stats::polygonContainsPoint(polygonVectorItem.corners, Point(pos.x(), pos.y())))
@@ -315,6 +326,7 @@ void StatisticsData::clear()
   this->frameIdx  = -1;
   this->frameSize = {};
   this->statsTypes.clear();
+  this->cache.clear();
 }
 
 void StatisticsData::setFrameIndex(int frameIndex)
@@ -324,11 +336,80 @@ void StatisticsData::setFrameIndex(int frameIndex)
   {
     DEBUG_STATDATA("StatisticsData::getTypesThatNeedLoading New frame index set "
                    << this->frameIdx << "->" << frameIndex);
+    if (this->frameIdx >= 0)
+      for (auto &typeData : this->frameCache)
+        this->cache.insert(this->frameIdx, typeData.first, std::move(typeData.second));
     this->frameCache.clear();
     this->frameIdx = frameIndex;
   }
 }
 
+void StatisticsData::resetFrame(int frameIndex)
+{
+  this->setFrameIndex(frameIndex);
+
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  this->frameCache.clear();
+}
+
+bool StatisticsData::restoreFrameFromCache(int frameIndex)
+{
+  this->setFrameIndex(frameIndex);
+
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  auto                         allTypesCached = true;
+  for (const auto &statsType : this->statsTypes)
+  {
+    if (!statsType.render || this->frameCache.count(statsType.typeID) > 0)
+      continue;
+    if (auto data = this->cache.get(frameIndex, statsType.typeID))
+      this->frameCache[statsType.typeID] = std::move(*data);
+    else
+      allTypesCached = false;
+  }
+
+  DEBUG_STATDATA("StatisticsData::restoreFrameFromCache " << frameIndex << " all types cached "
+                                                          << allTypesCached);
+  return allTypesCached;
+}
+
+std::vector<int> StatisticsData::getCachedFrames() const
+{
+  std::vector<int> renderedTypeIDs;
+  for (const auto &statsType : this->statsTypes)
+    if (statsType.render)
+      renderedTypeIDs.push_back(statsType.typeID);
+  return this->cache.getCachedFrames(renderedTypeIDs);
+}
+
+size_t StatisticsData::getCachedFrameSize() const
+{
+  if (const auto nrCachedFrames = this->cache.getNumberCachedFrames(); nrCachedFrames > 0)
+    return std::max(this->cache.getMemoryUsage() / nrCachedFrames, size_t(1));
+
+  // Assume one value per 8x8 block for every rendered type
+  const auto nrRenderedTypes = std::count_if(this->statsTypes.begin(),
+                                             this->statsTypes.end(),
+                                             [](const StatisticsType &type) { return type.render; });
+  const auto nrBlocks = size_t(this->frameSize.width) * size_t(this->frameSize.height) / 64;
+  return std::max(nrBlocks * sizeof(StatsItemValue) * size_t(nrRenderedTypes), size_t(1));
+}
+
+void StatisticsData::updateSettings(bool cachedByVideoCache)
+{
+  QSettings settings;
+  settings.beginGroup("VideoCache");
+  size_t memoryLimit = 0;
+  if (settings.value("Enabled", true).toBool())
+  {
+    const auto threshold = size_t(settings.value("ThresholdValueMB", 49).toUInt()) * 1000 * 1000;
+    memoryLimit          = StatisticsCache::getShareOfVideoCacheThreshold(threshold);
+    if (cachedByVideoCache)
+      memoryLimit = threshold - memoryLimit;
+  }
+  this->cache.setMemoryLimit(memoryLimit);
+}
+
 void StatisticsData::addStatType(const StatisticsType &type)
 {
   if (type.typeID == -1)
@@ -33,6 +33,7 @@
 #pragma once
 
 #include "FrameTypeData.h"
+#include "StatisticsCache.h"
 #include "StatisticsType.h"
 
 #include <map>
@@ -61,9 +62,27 @@ public:
 
   void clear();
   void setFrameSize(Size size) { this->frameSize = size; }
+  // When the frame index changes, the data of the previous frame is moved to the cache
   void setFrameIndex(int frameIndex);
+  // Set the frame index and start with empty data for it. Data of the same frame index (e.g.
+  // restored from the cache) is discarded. Use this if all data of the frame is added again.
+  void resetFrame(int frameIndex);
+  // Set the frame index and take the data of the rendered types from the cache. Return true if the
+  // data of all rendered types was cached so that nothing has to be loaded.
+  bool restoreFrameFromCache(int frameIndex);
   void addStatType(const StatisticsType &type);
 
+  // Get the frames for which the data of all rendered types is cached
+  std::vector<int> getCachedFrames() const;
+  // The average memory of a cached frame. If nothing is cached yet, this is a rough estimate.
+  size_t           getCachedFrameSize() const;
+  StatisticsCache &getCache() { return this->cache; }
+
+  // Update the memory limit of the cache from the video cache settings. If the cached frames are
+  // accounted for by the video cache (cacheFrame of the item), the cache can use the whole
+  // threshold. Otherwise only the share of the threshold that is reserved for statistics is used.
+  void updateSettings(bool cachedByVideoCache = false);
+
   void savePlaylist(YUViewDomElement &root) const;
   void loadPlaylist(const YUViewDomElement &root);
 
@@ -77,6 +96,10 @@ private:
   std::map<int, FrameTypeData> frameCache;
   int                          frameIdx{-1};
 
+  // The data of other frames [POC, statsTypeID]. The cache is disabled until updateSettings is
+  // called.
+  StatisticsCache cache;
+
   Size frameSize;
 
   StatisticsTypesVec statsTypes;
@@ -284,6 +284,12 @@ void stats::paintStatisticsData(QPainter *             painter,
   int  xMax           = statRect.width() / 2 - (worldTransform.dx() - viewport.width());
   int  yMax           = statRect.height() / 2 - (worldTransform.dy() - viewport.height());
 
+  // The visible area in pixels of the frame. Only the items in this area have to be checked.
+  const auto visibleArea = Area{int(std::floor(xMin / zoomFactor)) - 1,
+                                int(std::floor(yMin / zoomFactor)) - 1,
+                                int(std::ceil(xMax / zoomFactor)) + 1,
+                                int(std::ceil(yMax / zoomFactor)) + 1};
+
   painter->translate(statRect.topLeft());
 
   auto &statsTypes = statisticsData.getStatisticsTypes();
@@ -320,8 +326,11 @@ void stats::paintStatisticsData(QPainter *             painter,
     if (!it->render || !statisticsData.hasDataForTypeID(it->typeID))
       continue;
 
-    for (const auto &valueItem : statisticsData[it->typeID].valueData)
+    const auto &frameTypeData = statisticsData[it->typeID];
+    for (const auto i : frameTypeData.getValueItemsInArea(visibleArea))
     {
+      const auto &valueItem = frameTypeData.valueData[i];
+
       // Calculate the size and position of the rectangle to draw (zoomed in)
       auto rect = QRect(valueItem.pos[0], valueItem.pos[1], valueItem.size[0], valueItem.size[1]);
       auto displayRect = QRect(rect.left() * zoomFactor,
@@ -407,8 +416,11 @@ void stats::paintStatisticsData(QPainter *             painter,
       continue;
 
     // Go through all the value data
-    for (const auto &valueItem : statisticsData[it->typeID].polygonValueData)
+    const auto &frameTypeData = statisticsData[it->typeID];
+    for (const auto i : frameTypeData.getPolygonValueItemsInArea(visibleArea))
     {
+      const auto &valueItem = frameTypeData.polygonValueData[i];
+
       // Calculate the size and position of the rectangle to draw (zoomed in)
       auto valuePoly           = convertToQPolygon(valueItem.corners);
       auto boundingRect        = valuePoly.boundingRect();
@@ -507,8 +519,11 @@ void stats::paintStatisticsData(QPainter *             painter,
       continue;
 
     // Go through all the vector data
-    for (const auto &vectorItem : statisticsData[it->typeID].vectorData)
+    const auto &frameTypeData = statisticsData[it->typeID];
+    for (const auto i : frameTypeData.getVectorItemsInArea(visibleArea, it->vectorScale))
     {
+      const auto &vectorItem = frameTypeData.vectorData[i];
+
       // Calculate the size and position of the rectangle to draw (zoomed in)
       const auto rect =
           QRect(vectorItem.pos[0], vectorItem.pos[1], vectorItem.size[0], vectorItem.size[1]);
@@ -714,8 +729,10 @@ void stats::paintStatisticsData(QPainter *             painter,
     }
 
     // Go through all the affine transform data
-    for (const auto &affineTFItem : statisticsData[it->typeID].affineTFData)
+    for (const auto i : frameTypeData.getAffineTFItemsInArea(visibleArea))
     {
+      const auto &affineTFItem = frameTypeData.affineTFData[i];
+
       // Calculate the size and position of the rectangle to draw (zoomed in)
       const auto rect = QRect(
           affineTFItem.pos[0], affineTFItem.pos[1], affineTFItem.size[0], affineTFItem.size[1]);
@@ -827,8 +844,11 @@ void stats::paintStatisticsData(QPainter *             painter,
       continue;
 
     // Go through all the vector data
-    for (const auto &vectorItem : statisticsData[it->typeID].polygonVectorData)
+    const auto &frameTypeData = statisticsData[it->typeID];
+    for (const auto i : frameTypeData.getPolygonVectorItemsInArea(visibleArea))
     {
+      const auto &vectorItem = frameTypeData.polygonVectorData[i];
+
       if (vectorItem.corners.size() < 3)
         continue; // need at least triangle -- or more corners
 
@@ -0,0 +1,615 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut f�r Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StatisticsFileBinary.h"
+
+#include <QDataStream>
+#include <QSettings>
+#include <QtEndian>
+
+#include <algorithm>
+#include <iostream>
+#include <type_traits>
+
+namespace stats
+{
+
+namespace
+{
+
+// The header at the start of the file is the magic followed by the version (uint32). The file
+// ends with the position of the footer (uint64) followed by the magic again. All values are
+// little endian.
+constexpr char     FILE_MAGIC[]   = "YUVSTATS";
+constexpr int      MAGIC_SIZE     = 8;
+constexpr uint32_t FILE_VERSION   = 2;
+constexpr int      HEADER_SIZE    = MAGIC_SIZE + 4;
+constexpr int      TRAILER_SIZE   = 8 + MAGIC_SIZE;
+constexpr auto     STREAM_VERSION = QDataStream::Qt_5_0;
+
+// The items are written field by field. These are their sizes in the file.
+constexpr size_t POINT_SIZE          = 8;
+constexpr size_t POS_AND_SIZE_SIZE   = 8;
+constexpr size_t VALUE_ITEM_SIZE     = POS_AND_SIZE_SIZE + 4;
+constexpr size_t VECTOR_ITEM_SIZE    = POS_AND_SIZE_SIZE + 1 + 2 * POINT_SIZE;
+constexpr size_t AFFINE_TF_ITEM_SIZE = POS_AND_SIZE_SIZE + 3 * POINT_SIZE;
+
+template <typename T> void appendValue(QByteArray &chunk, T value)
+{
+  static_assert(std::is_integral_v<T>);
+  const auto littleEndianValue = qToLittleEndian(value);
+  chunk.append(reinterpret_cast<const char *>(&littleEndianValue), sizeof(T));
+}
+
+void appendPosAndSize(QByteArray &chunk, const unsigned short pos[2], const unsigned short size[2])
+{
+  appendValue(chunk, uint16_t(pos[0]));
+  appendValue(chunk, uint16_t(pos[1]));
+  appendValue(chunk, uint16_t(size[0]));
+  appendValue(chunk, uint16_t(size[1]));
+}
+
+void appendItem(QByteArray &chunk, const Point &point)
+{
+  appendValue(chunk, int32_t(point.x));
+  appendValue(chunk, int32_t(point.y));
+}
+
+void appendItem(QByteArray &chunk, const StatsItemValue &item)
+{
+  appendPosAndSize(chunk, item.pos, item.size);
+  appendValue(chunk, int32_t(item.value));
+}
+
+void appendItem(QByteArray &chunk, const StatsItemVector &item)
+{
+  appendPosAndSize(chunk, item.pos, item.size);
+  appendValue(chunk, uint8_t(item.isLine ? 1 : 0));
+  appendItem(chunk, item.point[0]);
+  appendItem(chunk, item.point[1]);
+}
+
+void appendItem(QByteArray &chunk, const StatsItemAffineTF &item)
+{
+  appendPosAndSize(chunk, item.pos, item.size);
+  for (const auto &point : item.point)
+    appendItem(chunk, point);
+}
+
+template <typename T> void appendItems(QByteArray &chunk, const std::vector<T> &items)
+{
+  for (const auto &item : items)
+    appendItem(chunk, item);
+}
+
+QByteArray serializeFrameTypeData(const FrameTypeData &data)
+{
+  QByteArray chunk;
+  appendValue(chunk, uint32_t(data.valueData.size()));
+  appendValue(chunk, uint32_t(data.vectorData.size()));
+  appendValue(chunk, uint32_t(data.affineTFData.size()));
+  appendValue(chunk, uint32_t(data.polygonValueData.size()));
+  appendValue(chunk, uint32_t(data.polygonVectorData.size()));
+
+  appendItems(chunk, data.valueData);
+  appendItems(chunk, data.vectorData);
+  appendItems(chunk, data.affineTFData);
+  for (const auto &polygonValue : data.polygonValueData)
+  {
+    appendValue(chunk, uint32_t(polygonValue.corners.size()));
+    appendItems(chunk, polygonValue.corners);
+    appendValue(chunk, int32_t(polygonValue.value));
+  }
+  for (const auto &polygonVector : data.polygonVectorData)
+  {
+    appendValue(chunk, uint32_t(polygonVector.corners.size()));
+    appendItems(chunk, polygonVector.corners);
+    appendItem(chunk, polygonVector.point);
+  }
+  return chunk;
+}
+
+// Read the items from a chunk. Throws if the chunk is too short or contains invalid values.
+class ChunkReader
+{
+public:
+  ChunkReader(const QByteArray &chunk) : chunk(chunk) {}
+
+  template <typename T> T readValue()
+  {
+    static_assert(std::is_integral_v<T>);
+    return qFromLittleEndian<T>(this->getData(sizeof(T)));
+  }
+
+  void readItem(Point &point)
+  {
+    point.x = this->readValue<int32_t>();
+    point.y = this->readValue<int32_t>();
+  }
+
+  void readItem(StatsItemValue &item)
+  {
+    this->readPosAndSize(item.pos, item.size);
+    item.value = this->readValue<int32_t>();
+  }
+
+  void readItem(StatsItemVector &item)
+  {
+    this->readPosAndSize(item.pos, item.size);
+    const auto isLine = this->readValue<uint8_t>();
+    if (isLine > 1)
+      throw "Invalid vector item in the statistics chunk";
+    item.isLine = (isLine == 1);
+    this->readItem(item.point[0]);
+    this->readItem(item.point[1]);
+  }
+
+  void readItem(StatsItemAffineTF &item)
+  {
+    this->readPosAndSize(item.pos, item.size);
+    for (auto &point : item.point)
+      this->readItem(point);
+  }
+
+  template <typename T> void readItems(std::vector<T> &items, size_t nrItems, size_t itemSize)
+  {
+    // Check the size first so that a corrupt number of items does not allocate huge vectors
+    if (nrItems > (size_t(this->chunk.size()) - this->pos) / itemSize)
+      throw "The statistics chunk is shorter than indicated";
+    items.resize(nrItems);
+    for (auto &item : items)
+      this->readItem(item);
+  }
+
+private:
+  void readPosAndSize(unsigned short pos[2], unsigned short size[2])
+  {
+    pos[0]  = this->readValue<uint16_t>();
+    pos[1]  = this->readValue<uint16_t>();
+    size[0] = this->readValue<uint16_t>();
+    size[1] = this->readValue<uint16_t>();
+  }
+
+  const char *getData(size_t nrBytes)
+  {
+    if (nrBytes > size_t(this->chunk.size()) - this->pos)
+      throw "The statistics chunk is shorter than indicated";
+    auto data = this->chunk.constData() + this->pos;
+    this->pos += nrBytes;
+    return data;
+  }
+
+  const QByteArray &chunk;
+  size_t            pos{};
+};
+
+FrameTypeData parseFrameTypeData(const QByteArray &chunk)
+{
+  ChunkReader reader(chunk);
+
+  const auto nrValues         = reader.readValue<uint32_t>();
+  const auto nrVectors        = reader.readValue<uint32_t>();
+  const auto nrAffineTF       = reader.readValue<uint32_t>();
+  const auto nrPolygonValues  = reader.readValue<uint32_t>();
+  const auto nrPolygonVectors = reader.readValue<uint32_t>();
+
+  FrameTypeData data;
+  reader.readItems(data.valueData, nrValues, VALUE_ITEM_SIZE);
+  reader.readItems(data.vectorData, nrVectors, VECTOR_ITEM_SIZE);
+  reader.readItems(data.affineTFData, nrAffineTF, AFFINE_TF_ITEM_SIZE);
+
+  for (uint32_t i = 0; i < nrPolygonValues; i++)
+  {
+    StatsItemPolygonValue polygonValue;
+    reader.readItems(polygonValue.corners, reader.readValue<uint32_t>(), POINT_SIZE);
+    polygonValue.value = reader.readValue<int32_t>();
+    data.polygonValueData.push_back(std::move(polygonValue));
+  }
+  for (uint32_t i = 0; i < nrPolygonVectors; i++)
+  {
+    StatsItemPolygonVector polygonVector;
+    reader.readItems(polygonVector.corners, reader.readValue<uint32_t>(), POINT_SIZE);
+    reader.readItem(polygonVector.point);
+    data.polygonVectorData.push_back(std::move(polygonVector));
+  }
+
+  for (const auto &value : data.valueData)
+    data.maxBlockSize = std::max(data.maxBlockSize, unsigned(value.size[0]) * value.size[1]);
+
+  return data;
+}
+
+QDataStream &operator<<(QDataStream &stream, const Color &color)
+{
+  return stream << qint32(color.R()) << qint32(color.G()) << qint32(color.B())
+                << qint32(color.A());
+}
+
+QDataStream &operator>>(QDataStream &stream, Color &color)
+{
+  qint32 r, g, b, a;
+  stream >> r >> g >> b >> a;
+  color = Color(r, g, b, a);
+  return stream;
+}
+
+QDataStream &operator<<(QDataStream &stream, const LineDrawStyle &style)
+{
+  const auto patternIt = std::find(AllPatterns.begin(), AllPatterns.end(), style.pattern);
+  return stream << style.color << style.width
+                << qint32(std::distance(AllPatterns.begin(), patternIt));
+}
+
+QDataStream &operator>>(QDataStream &stream, LineDrawStyle &style)
+{
+  qint32 patternIdx;
+  stream >> style.color >> style.width >> patternIdx;
+  if (patternIdx >= 0 && unsigned(patternIdx) < AllPatterns.size())
+    style.pattern = AllPatterns[patternIdx];
+  return stream;
+}
+
+template <typename T, std::size_t N>
+void writeEnum(QDataStream &stream, const EnumMapper<T, N> &mapper, T value)
+{
+  stream << QString::fromStdString(std::string(mapper.getName(value)));
+}
+
+template <typename T, std::size_t N>
+void readEnum(QDataStream &stream, const EnumMapper<T, N> &mapper, T &value)
+{
+  QString name;
+  stream >> name;
+  if (auto newValue = mapper.getValue(name.toStdString()))
+    value = *newValue;
+}
+
+QDataStream &operator<<(QDataStream &stream, const color::ColorMapper &colorMapper)
+{
+  writeEnum(stream, color::MappingTypeMapper, colorMapper.mappingType);
+  stream << qint32(colorMapper.valueRange.min) << qint32(colorMapper.valueRange.max);
+  stream << colorMapper.gradientColorStart << colorMapper.gradientColorEnd;
+  stream << quint32(colorMapper.colorMap.size());
+  for (const auto &[value, color] : colorMapper.colorMap)
+    stream << qint32(value) << color;
+  stream << colorMapper.colorMapOther;
+  writeEnum(stream, color::PredefinedTypeMapper, colorMapper.predefinedType);
+  return stream;
+}
+
+QDataStream &operator>>(QDataStream &stream, color::ColorMapper &colorMapper)
+{
+  readEnum(stream, color::MappingTypeMapper, colorMapper.mappingType);
+  qint32 min, max;
+  stream >> min >> max;
+  colorMapper.valueRange = {min, max};
+  stream >> colorMapper.gradientColorStart >> colorMapper.gradientColorEnd;
+  quint32 colorMapSize;
+  stream >> colorMapSize;
+  for (quint32 i = 0; i < colorMapSize && stream.status() == QDataStream::Ok; i++)
+  {
+    qint32 value;
+    Color  color;
+    stream >> value >> color;
+    colorMapper.colorMap[value] = color;
+  }
+  stream >> colorMapper.colorMapOther;
+  readEnum(stream, color::PredefinedTypeMapper, colorMapper.predefinedType);
+  return stream;
+}
+
+QDataStream &operator<<(QDataStream &stream, const StatisticsType &type)
+{
+  stream << qint32(type.typeID) << type.typeName << type.description;
+  stream << type.render << qint32(type.alphaFactor);
+  stream << type.hasValueData << type.renderValueData << type.scaleValueToBlockSize
+         << type.colorMapper;
+  stream << type.hasVectorData << type.hasAffineTFData << type.renderVectorData
+         << type.renderVectorDataValues << type.scaleVectorToZoom << type.vectorStyle
+         << qint32(type.vectorScale) << type.mapVectorToColor << qint32(type.arrowHead);
+  stream << type.renderGrid << type.gridStyle << type.scaleGridToZoom << type.isPolygon;
+  return stream;
+}
+
+QDataStream &operator>>(QDataStream &stream, StatisticsType &type)
+{
+  qint32 typeID, alphaFactor, vectorScale, arrowHead;
+  stream >> typeID >> type.typeName >> type.description;
+  stream >> type.render >> alphaFactor;
+  stream >> type.hasValueData >> type.renderValueData >> type.scaleValueToBlockSize >>
+      type.colorMapper;
+  stream >> type.hasVectorData >> type.hasAffineTFData >> type.renderVectorData >>
+      type.renderVectorDataValues >> type.scaleVectorToZoom >> type.vectorStyle >> vectorScale >>
+      type.mapVectorToColor >> arrowHead;
+  stream >> type.renderGrid >> type.gridStyle >> type.scaleGridToZoom >> type.isPolygon;
+
+  type.typeID      = typeID;
+  type.alphaFactor = alphaFactor;
+  type.vectorScale = vectorScale;
+  if (arrowHead >= 0 && arrowHead <= int(StatisticsType::ArrowHead::none))
+    type.arrowHead = StatisticsType::ArrowHead(arrowHead);
+  return stream;
+}
+
+} // namespace
+
+StatisticsFileBinary::StatisticsFileBinary(const QString &filename, StatisticsData &statisticsData)
+    : StatisticsFileBase(filename)
+{
+  if (!this->file.isOk())
+    return;
+
+  this->fileSortedByPOC = true;
+  this->readFooterFromFile(statisticsData);
+
+  QSettings settings;
+  if (!this->error && settings.value("MemoryMapRawFiles", false).toBool())
+    this->file.mapFileToMemory();
+}
+
+void StatisticsFileBinary::readFrameAndTypePositionsFromFile(std::atomic_bool &)
+{
+  this->parsingProgress = 100.0;
+}
+
+void StatisticsFileBinary::loadStatisticData(StatisticsData &statisticsData, int poc, int typeID)
+{
+  if (!this->file.isOk() || this->error)
+    return;
+
+  try
+  {
+    statisticsData.setFrameIndex(poc);
+
+    std::unique_lock<std::mutex> lock(statisticsData.accessMutex);
+
+    if (this->pocTypeChunkMap.count(poc) == 0 || this->pocTypeChunkMap[poc].count(typeID) == 0)
+    {
+      // There are no statistics in the file for the given frame and index.
+      statisticsData[typeID] = {};
+      return;
+    }
+
+    const auto &chunk = this->pocTypeChunkMap[poc][typeID];
+
+    QByteArray chunkData;
+    if (this->file.readBytes(chunkData, chunk.filePos, chunk.size) != chunk.size)
+      chunkData.clear();
+    if (chunkData.size() != int(chunk.size))
+      throw "Error reading the statistics chunk from file";
+
+    if (chunk.uncompressedSize > 0)
+    {
+      chunkData = qUncompress(chunkData);
+      if (chunkData.size() != int(chunk.uncompressedSize))
+        throw "Error decompressing the statistics chunk";
+    }
+
+    statisticsData[typeID] = parseFrameTypeData(chunkData);
+  }
+  catch (const char *str)
+  {
+    std::cerr << "Error while loading statistics: " << str << '\n';
+    this->errorMessage = QString("Error while loading statistics: ") + QString(str);
+    this->error        = true;
+  }
+}
+
+void StatisticsFileBinary::readFooterFromFile(StatisticsData &statisticsData)
+{
+  try
+  {
+    statisticsData.clear();
+
+    const auto fileSize = this->file.getFileSize();
+    if (fileSize < HEADER_SIZE + TRAILER_SIZE)
+      throw "The file is too short";
+
+    QByteArray header;
+    this->file.readBytes(header, 0, HEADER_SIZE);
+    QByteArray trailer;
+    this->file.readBytes(trailer, fileSize - TRAILER_SIZE, TRAILER_SIZE);
+    if (!header.startsWith(FILE_MAGIC) || !trailer.endsWith(FILE_MAGIC))
+      throw "The file is not a binary statistics file";
+
+    const auto version = qFromLittleEndian<uint32_t>(header.constData() + MAGIC_SIZE);
+    if (version != FILE_VERSION)
+      throw "Unsupported version of the binary statistics file";
+
+    const auto footerPos = qFromLittleEndian<int64_t>(trailer.constData());
+    if (footerPos < HEADER_SIZE || footerPos > fileSize - TRAILER_SIZE)
+      throw "Invalid position of the footer";
+
+    QByteArray footer;
+    this->file.readBytes(footer, footerPos, fileSize - TRAILER_SIZE - footerPos);
+
+    QDataStream stream(footer);
+    stream.setVersion(STREAM_VERSION);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    quint32 width, height, nrTypes;
+    qint32  maxPOC;
+    stream >> width >> height >> maxPOC >> this->framerate >> nrTypes;
+    statisticsData.setFrameSize(Size(width, height));
+    this->maxPOC = maxPOC;
+
+    for (quint32 i = 0; i < nrTypes && stream.status() == QDataStream::Ok; i++)
+    {
+      StatisticsType type;
+      stream >> type;
+      type.setInitialState();
+      statisticsData.addStatType(type);
+    }
+
+    quint32 nrChunks;
+    stream >> nrChunks;
+    for (quint32 i = 0; i < nrChunks && stream.status() == QDataStream::Ok; i++)
+    {
+      qint32  poc, typeID;
+      qint64  filePos;
+      quint32 size, uncompressedSize;
+      stream >> poc >> typeID >> filePos >> size >> uncompressedSize;
+      if (filePos < HEADER_SIZE || filePos + size > footerPos)
+        throw "Invalid position of a statistics chunk";
+      this->pocTypeChunkMap[poc][typeID] = {filePos, size, uncompressedSize};
+    }
+
+    if (stream.status() != QDataStream::Ok)
+      throw "The footer of the file is corrupt";
+  }
+  catch (const char *str)
+  {
+    std::cerr << "Error while parsing meta data: " << str << '\n';
+    this->errorMessage = QString("Error while parsing meta data: ") + QString(str);
+    this->error        = true;
+  }
+}
+
+bool StatisticsFileBinaryWriter::open(const QString &filename, bool compressChunks)
+{
+  this->file.setFileName(filename);
+  if (!this->file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    return false;
+
+  this->compressChunks = compressChunks;
+  this->chunks.clear();
+
+  QByteArray header(FILE_MAGIC, MAGIC_SIZE);
+  appendValue(header, FILE_VERSION);
+  return this->file.write(header) == header.size();
+}
+
+bool StatisticsFileBinaryWriter::writeFrameTypeData(int poc, int typeID, const FrameTypeData &data)
+{
+  if (data.valueData.empty() && data.vectorData.empty() && data.affineTFData.empty() &&
+      data.polygonValueData.empty() && data.polygonVectorData.empty())
+    return true;
+
+  ChunkEntry entry;
+  entry.poc     = poc;
+  entry.typeID  = typeID;
+  entry.filePos = this->file.pos();
+
+  auto chunk = serializeFrameTypeData(data);
+  if (this->compressChunks)
+  {
+    entry.uncompressedSize = uint32_t(chunk.size());
+    chunk                  = qCompress(chunk);
+  }
+  entry.size = uint32_t(chunk.size());
+
+  if (this->file.write(chunk) != chunk.size())
+    return false;
+
+  this->chunks.push_back(entry);
+  return true;
+}
+
+bool StatisticsFileBinaryWriter::finish(const StatisticsTypesVec &types,
+                                        Size                      frameSize,
+                                        int                       maxPOC,
+                                        double                    framerate)
+{
+  const auto footerPos = this->file.pos();
+
+  QByteArray  footer;
+  QDataStream stream(&footer, QIODevice::WriteOnly);
+  stream.setVersion(STREAM_VERSION);
+  stream.setByteOrder(QDataStream::LittleEndian);
+
+  stream << quint32(frameSize.width) << quint32(frameSize.height) << qint32(maxPOC) << framerate;
+  stream << quint32(types.size());
+  for (const auto &type : types)
+    stream << type;
+
+  stream << quint32(this->chunks.size());
+  for (const auto &chunk : this->chunks)
+    stream << qint32(chunk.poc) << qint32(chunk.typeID) << qint64(chunk.filePos)
+           << quint32(chunk.size) << quint32(chunk.uncompressedSize);
+
+  appendValue(footer, int64_t(footerPos));
+  footer.append(FILE_MAGIC, MAGIC_SIZE);
+
+  const auto ok = (this->file.write(footer) == footer.size());
+  this->file.close();
+  return ok;
+}
+
+bool convertToBinaryFile(StatisticsFileBase &sourceFile,
+                         StatisticsData &    statisticsData,
+                         const QString &     binaryFilename,
+                         bool                compressChunks,
+                         std::atomic_bool &  breakFunction)
+{
+  if (!sourceFile)
+    return false;
+
+  // Get the positions of all POCs/types in the source file first
+  sourceFile.readFrameAndTypePositionsFromFile(breakFunction);
+  if (!sourceFile || breakFunction.load())
+    return false;
+
+  auto writeAllStatistics = [&](StatisticsFileBinaryWriter &writer) {
+    for (int poc = 0; poc <= sourceFile.getMaxPoc(); poc++)
+    {
+      if (breakFunction.load() || !sourceFile)
+        return false;
+
+      statisticsData.setFrameIndex(poc);
+      for (const auto &type : statisticsData.getStatisticsTypes())
+      {
+        // Interleaved files may load the data of multiple types at once
+        if (!statisticsData.hasDataForTypeID(type.typeID))
+          sourceFile.loadStatisticData(statisticsData, poc, type.typeID);
+        if (!writer.writeFrameTypeData(poc, type.typeID, statisticsData[type.typeID]))
+          return false;
+      }
+    }
+    return writer.finish(statisticsData.getStatisticsTypes(),
+                         statisticsData.getFrameSize(),
+                         sourceFile.getMaxPoc(),
+                         sourceFile.getFramerate());
+  };
+
+  bool success;
+  {
+    StatisticsFileBinaryWriter writer;
+    success = writer.open(binaryFilename, compressChunks) && writeAllStatistics(writer);
+  }
+
+  // Do not leave an incomplete file behind
+  if (!success)
+    QFile::remove(binaryFilename);
+  return success;
+}
+
+} // namespace stats
@@ -0,0 +1,130 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut f�r Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "StatisticsFileBase.h"
+
+#include <QFile>
+
+#include <map>
+#include <vector>
+
+namespace stats
+{
+
+/* A binary statistics file. Other than the text formats, this file does not have to be parsed.
+ * The file starts with a short header. Then the statistics of all POC/type combinations follow in
+ * chunks. Each chunk contains the arrays of items (StatsItemValue, StatsItemVector, ...) written
+ * field by field in a fixed little endian layout. Chunks can optionally be compressed. At the end
+ * of the file there is a footer with the statistics types and a table with the position of every
+ * chunk. So loading the statistics of a POC/type is a seek and a simple copy of the fields.
+ * Binary files can be created from the other statistics files using convertToBinaryFile.
+ */
+class StatisticsFileBinary : public StatisticsFileBase
+{
+public:
+  StatisticsFileBinary(const QString &filename, StatisticsData &statisticsData);
+  virtual ~StatisticsFileBinary() = default;
+
+  double getFramerate() const override { return this->framerate; }
+
+  // The positions of all POCs/types are known from the footer. There is nothing to parse.
+  void readFrameAndTypePositionsFromFile(std::atomic_bool &breakFunction) override;
+
+  // Load the statistics for "poc/type" from file and put it into the statisticsData.
+  void loadStatisticData(StatisticsData &statisticsData, int poc, int typeID) override;
+
+  // Map the file into memory. This is done in the constructor if enabled in the settings.
+  bool mapFileToMemory() { return this->file.mapFileToMemory(); }
+
+  static constexpr auto FILE_EXTENSION = "yuviewstats";
+
+private:
+  // Read the footer: The frame size, all types and the positions of the chunks
+  void readFooterFromFile(StatisticsData &statisticsData);
+
+  double framerate{-1};
+
+  struct Chunk
+  {
+    int64_t  filePos{};
+    uint32_t size{};
+    // If the chunk is compressed this is the size after decompression. Otherwise 0.
+    uint32_t uncompressedSize{};
+  };
+
+  // Chunk positions pocTypeChunkMap[poc][typeID]
+  std::map<int, std::map<int, Chunk>> pocTypeChunkMap;
+};
+
+/* Write a binary statistics file (see StatisticsFileBinary). First open the file, then write the
+ * data of all POCs/types (in any order) and then write the footer by calling finish().
+ */
+class StatisticsFileBinaryWriter
+{
+public:
+  StatisticsFileBinaryWriter() = default;
+
+  // Open the file for writing. If compressChunks is set, every chunk is compressed using zlib.
+  bool open(const QString &filename, bool compressChunks);
+  // Write the statistics of one POC/type. Nothing is written if there are no items.
+  bool writeFrameTypeData(int poc, int typeID, const FrameTypeData &data);
+  // Write the footer and close the file
+  bool finish(const StatisticsTypesVec &types, Size frameSize, int maxPOC, double framerate);
+
+private:
+  QFile file;
+  bool  compressChunks{};
+
+  struct ChunkEntry
+  {
+    int      poc{};
+    int      typeID{};
+    int64_t  filePos{};
+    uint32_t size{};
+    uint32_t uncompressedSize{};
+  };
+  std::vector<ChunkEntry> chunks;
+};
+
+// Read all statistics from the given statistics file (e.g. CSV or VTMBMS) and write them to a
+// binary statistics file. The statisticsData must be the one that was passed to the sourceFile
+// on creation. This parses the whole source file so it can take a while. Returns false if writing
+// failed or if the conversion was aborted using breakFunction.
+bool convertToBinaryFile(StatisticsFileBase &sourceFile,
+                         StatisticsData &    statisticsData,
+                         const QString &     binaryFilename,
+                         bool                compressChunks,
+                         std::atomic_bool &  breakFunction);
+
+} // namespace stats
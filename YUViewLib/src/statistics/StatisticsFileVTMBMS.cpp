@@ -33,18 +33,250 @@
 #include "StatisticsFileVTMBMS.h"
 
 #include <QRegularExpression>
-#include <QTextStream>
 
+#include <algorithm>
+#include <cctype>
 #include <iostream>
+#include <limits>
+#include <optional>
+#include <string_view>
 
 namespace stats
 {
 
-// The internal buffer for parsing the starting positions. The buffer must not be larger than 2GB
-// so that we can address all the positions in it with int (using such a large buffer is not a good
-// idea anyways)
-constexpr unsigned STAT_PARSING_BUFFER_SIZE = 1048576u;
-constexpr unsigned STAT_MAX_STRING_SIZE     = 1u << 28;
+namespace
+{
+
+// The internal buffer for parsing. Lines that are longer than the buffer are read again with a
+// bigger buffer (up to STAT_MAX_STRING_SIZE).
+constexpr int64_t STAT_PARSING_BUFFER_SIZE = 1048576;
+constexpr int64_t STAT_MAX_STRING_SIZE     = 1 << 28;
+
+// The regular expressions that were used before would allow polygons with 3 to 5 corners
+constexpr int MAX_POLYGON_CORNERS = 5;
+constexpr int MAX_VALUES          = 6;
+
+/* A minimal tokenizer for the lines of a VTMBMS file. It works directly on the bytes from the file
+ * (no QString conversion, no regular expressions, no allocations). All functions skip leading
+ * spaces.
+ */
+class LineTokenizer
+{
+public:
+  explicit LineTokenizer(std::string_view line) : line(line) {}
+
+  // Skip the given text if it follows. Return false if not.
+  bool skip(std::string_view text)
+  {
+    this->skipSpaces();
+    if (this->line.compare(this->pos, text.size(), text) != 0)
+      return false;
+    this->pos += text.size();
+    return true;
+  }
+
+  std::optional<int> readInt()
+  {
+    this->skipSpaces();
+    const auto negative = (this->pos < this->line.size() && this->line[this->pos] == '-');
+    if (negative)
+      this->pos++;
+
+    // The magnitude of the smallest int is one bigger than the biggest int
+    const auto maxValue = int64_t(std::numeric_limits<int>::max()) + (negative ? 1 : 0);
+
+    const auto start = this->pos;
+    int64_t    value = 0;
+    while (this->pos < this->line.size() && this->line[this->pos] >= '0' &&
+           this->line[this->pos] <= '9')
+    {
+      if (value <= maxValue)
+        value = value * 10 + (this->line[this->pos] - '0');
+      this->pos++;
+    }
+    if (this->pos == start || value > maxValue)
+      return {};
+    return int(negative ? -value : value);
+  }
+
+  std::string_view readName()
+  {
+    this->skipSpaces();
+    const auto start = this->pos;
+    while (this->pos < this->line.size() &&
+           (std::isalnum(static_cast<unsigned char>(this->line[this->pos])) ||
+            this->line[this->pos] == '_'))
+      this->pos++;
+    return this->line.substr(start, this->pos - start);
+  }
+
+private:
+  void skipSpaces()
+  {
+    while (this->pos < this->line.size() &&
+           (this->line[this->pos] == ' ' || this->line[this->pos] == '\t'))
+      this->pos++;
+  }
+
+  std::string_view line;
+  size_t           pos{};
+};
+
+// One "BlockStat" line. Either a block or a polygon with a value or with values in braces:
+// BlockStat: POC 1 @( 112,  88) [ 8x 8] PredMode=0
+// BlockStat: POC 1 @( 120,  80) [ 8x 8] MVL0={ -24,  -2}
+// BlockStat: POC 2 @[(505, 384)--(511, 384)--(511, 415)--] GeoPUInterIntraFlag=0
+struct BlockStatLine
+{
+  int      poc{};
+  bool     isPolygon{};
+  int      x{};
+  int      y{};
+  unsigned width{};
+  unsigned height{};
+
+  Point corners[MAX_POLYGON_CORNERS];
+  int   nrCorners{};
+
+  std::string_view typeName;
+
+  bool valuesInBraces{};
+  int  values[MAX_VALUES]{};
+  int  nrValues{};
+};
+
+std::optional<int> parsePOC(std::string_view line)
+{
+  constexpr std::string_view POC_START = "BlockStat: POC ";
+  const auto                 start     = line.find(POC_START);
+  if (start == std::string_view::npos)
+    return {};
+  LineTokenizer tokenizer(line.substr(start + POC_START.size()));
+  return tokenizer.readInt();
+}
+
+bool parseBlockStatLine(std::string_view line, BlockStatLine &blockStat)
+{
+  LineTokenizer tokenizer(line);
+  if (!tokenizer.skip("BlockStat:") || !tokenizer.skip("POC"))
+    return false;
+
+  auto assignInt = [&tokenizer](auto &target) {
+    const auto value = tokenizer.readInt();
+    if (!value)
+      return false;
+    target = *value;
+    return true;
+  };
+  auto assignSize = [&tokenizer](unsigned &target) {
+    const auto value = tokenizer.readInt();
+    if (!value || *value < 0)
+      return false;
+    target = unsigned(*value);
+    return true;
+  };
+
+  if (!assignInt(blockStat.poc))
+    return false;
+
+  blockStat.nrCorners = 0;
+  if (tokenizer.skip("@("))
+  {
+    blockStat.isPolygon = false;
+    if (!assignInt(blockStat.x) || !tokenizer.skip(",") || !assignInt(blockStat.y) ||
+        !tokenizer.skip(")") || !tokenizer.skip("[") || !assignSize(blockStat.width) ||
+        !tokenizer.skip("x") || !assignSize(blockStat.height) || !tokenizer.skip("]"))
+      return false;
+  }
+  else if (tokenizer.skip("@["))
+  {
+    blockStat.isPolygon = true;
+    while (tokenizer.skip("("))
+    {
+      if (blockStat.nrCorners == MAX_POLYGON_CORNERS)
+        return false;
+      auto &corner = blockStat.corners[blockStat.nrCorners++];
+      if (!assignInt(corner.x) || !tokenizer.skip(",") || !assignInt(corner.y) ||
+          !tokenizer.skip(")") || !tokenizer.skip("--"))
+        return false;
+    }
+    if (!tokenizer.skip("]"))
+      return false;
+  }
+  else
+    return false;
+
+  blockStat.typeName = tokenizer.readName();
+  if (blockStat.typeName.empty() || !tokenizer.skip("="))
+    return false;
+
+  blockStat.nrValues       = 0;
+  blockStat.valuesInBraces = tokenizer.skip("{");
+  do
+  {
+    if (blockStat.nrValues == MAX_VALUES || !assignInt(blockStat.values[blockStat.nrValues++]))
+      return false;
+  } while (blockStat.valuesInBraces && tokenizer.skip(","));
+
+  return !blockStat.valuesInBraces || tokenizer.skip("}");
+}
+
+/* Call parseLine(line, lineStartPos) for all lines in the file starting at startPos until
+ * parseLine returns false or the end of the file is reached. The lines are views into the read
+ * buffer (without the newline) and only valid during the call.
+ */
+template <typename ParseLine>
+void forEachLineInFile(FileSource &file, int64_t startPos, ParseLine parseLine)
+{
+  QByteArray buffer;
+  auto       bufferStartPos = startPos;
+  auto       readSize       = STAT_PARSING_BUFFER_SIZE;
+
+  while (true)
+  {
+    const auto bufferSize = file.readBytes(buffer, bufferStartPos, readSize);
+    if (bufferSize < 0)
+      throw "Error reading bytes";
+    if (bufferSize == 0)
+      return;
+
+    // Less bytes than requested were read. The file is at the end.
+    const auto fileAtEnd = (bufferSize < readSize);
+
+    const std::string_view data(buffer.constData(), size_t(bufferSize));
+    size_t                 lineStart = 0;
+    while (lineStart < data.size())
+    {
+      auto lineEnd = data.find('\n', lineStart);
+      if (lineEnd == std::string_view::npos)
+      {
+        if (!fileAtEnd)
+          // The rest of the line is read with the next buffer
+          break;
+        lineEnd = data.size();
+      }
+
+      if (!parseLine(data.substr(lineStart, lineEnd - lineStart),
+                     bufferStartPos + int64_t(lineStart)))
+        return;
+      lineStart = lineEnd + 1;
+    }
+
+    if (fileAtEnd)
+      return;
+
+    if (lineStart == 0)
+    {
+      // Not even one line fit into the buffer
+      if (readSize >= STAT_MAX_STRING_SIZE)
+        throw "Line in statistics file is too long";
+      readSize *= 2;
+    }
+    bufferStartPos += int64_t(lineStart);
+  }
+}
+
+} // namespace
 
 StatisticsFileVTMBMS::StatisticsFileVTMBMS(const QString &filename, StatisticsData &statisticsData)
     : StatisticsFileBase(filename)
@@ -70,96 +302,32 @@ void StatisticsFileVTMBMS::readFrameAndTypePositionsFromFile(std::atomic_bool &b
     if (!inputFile.openFile(this->file.getAbsoluteFilePath()))
       return;
 
-    // We perform reading using an input buffer
-    QByteArray inputBuffer;
-    bool       fileAtEnd      = false;
-    uint64_t   bufferStartPos = 0;
+    int lastPOC = INT_INVALID;
 
-    QString  lineBuffer;
-    uint64_t lineBufferStartPos = 0;
-    int      lastPOC            = INT_INVALID;
-    bool     sortingFixed       = false;
+    forEachLineInFile(inputFile, 0, [&](std::string_view line, int64_t lineStartPos) {
+      if (breakFunction.load() || this->abortParsingDestroy)
+        return false;
 
-    while (!fileAtEnd && !breakFunction.load() && !this->abortParsingDestroy)
-    {
-      // Fill the buffer
-      auto bufferSize = inputFile.readBytes(inputBuffer, bufferStartPos, STAT_PARSING_BUFFER_SIZE);
-      if (bufferSize < 0)
-        throw "Error reading bytes";
-      if (bufferSize < STAT_PARSING_BUFFER_SIZE)
-        // Less bytes than the maximum buffer size were read. The file is at the end.
-        // This is the last run of the loop.
-        fileAtEnd = true;
-      // a corrupted file may contain an arbitrary amount of non-\n symbols
-      // prevent lineBuffer overflow by dumping it for such cases
-      if (unsigned(lineBuffer.size()) > STAT_MAX_STRING_SIZE)
-        lineBuffer.clear(); // prevent an overflow here
-      for (size_t i = 0; i < size_t(bufferSize); i++)
-      {
-        // Search for '\n' newline characters
-        if (inputBuffer.at(int(i)) == 10)
-        {
-          // We found a newline character
-          if (lineBuffer.size() > 0)
-          {
-            // Parse the previous line
-            // get components of this line
-            // get poc using regular expression
-            // need to match this:
-            // BlockStat: POC 1 @( 120,  80) [ 8x 8] MVL0={ -24,  -2}
-            // BlockStat: POC 1 @( 112,  88) [ 8x 8] PredMode=0
-            QRegularExpression pocRegex("BlockStat: POC ([0-9]+)");
-            auto               match = pocRegex.match(lineBuffer);
-            // ignore not matching lines
-            if (match.hasMatch())
-            {
-              auto poc = match.captured(1).toInt();
-
-              if (lastPOC == -1)
-              {
-                // First POC
-                this->pocStartList[poc] = lineBufferStartPos;
-                emit readPOC(poc);
-
-                lastPOC = poc;
-
-                // update number of frames
-                if (poc > this->maxPOC)
-                  this->maxPOC = poc;
-              }
-              else if (poc != lastPOC)
-              {
-                // this is apparently not sorted by POCs and we will not check it further
-                if (!sortingFixed)
-                  sortingFixed = true;
-
-                lastPOC                 = poc;
-                this->pocStartList[poc] = lineBufferStartPos;
-                emit readPOC(poc);
-
-                // update number of frames
-                if (poc > this->maxPOC)
-                  this->maxPOC = poc;
-
-                // Update percent of file parsed
-                this->parsingProgress =
-                    ((double)lineBufferStartPos * 100 / (double)inputFile.getFileSize());
-              }
-            }
-          }
+      // need to match this:
+      // BlockStat: POC 1 @( 120,  80) [ 8x 8] MVL0={ -24,  -2}
+      // BlockStat: POC 1 @( 112,  88) [ 8x 8] PredMode=0
+      // ignore not matching lines
+      const auto poc = parsePOC(line);
+      if (!poc || *poc == lastPOC)
+        return true;
 
-          lineBuffer.clear();
-          lineBufferStartPos = bufferStartPos + i + 1;
-        }
-        else
-        {
-          // No newline character found
-          lineBuffer.append(inputBuffer.at(int(i)));
-        }
-      }
+      lastPOC                  = *poc;
+      this->pocStartList[*poc] = uint64_t(lineStartPos);
+      emit readPOC(*poc);
 
-      bufferStartPos += bufferSize;
-    }
+      // update number of frames
+      if (*poc > this->maxPOC)
+        this->maxPOC = *poc;
+
+      // Update percent of file parsed
+      this->parsingProgress = ((double)lineStartPos * 100 / (double)inputFile.getFileSize());
+      return true;
+    });
 
     // Parsing complete
     this->parsingProgress = 100.0;
@@ -182,6 +350,9 @@ void StatisticsFileVTMBMS::readFrameAndTypePositionsFromFile(std::atomic_bool &b
   return;
 }
 
+/* Parsing a POC is expensive, so all types that need loading for the POC are loaded in one pass
+ * over the lines of the POC. The following calls for these types return without parsing again.
+ */
 void StatisticsFileVTMBMS::loadStatisticData(StatisticsData &statisticsData, int poc, int typeID)
 {
   if (!this->file.isOk())
@@ -193,6 +364,11 @@ void StatisticsFileVTMBMS::loadStatisticData(StatisticsData &statisticsData, int
 
     std::unique_lock<std::mutex> lock(statisticsData.accessMutex);
 
+    if (poc == this->prefetchedPOC && this->prefetchedTypeIDs.erase(typeID) > 0 &&
+        statisticsData.hasDataForTypeID(typeID))
+      // Already loaded together with another type
+      return;
+
     if (this->pocStartList.count(poc) == 0)
     {
       // There are no statistics in the file for the given frame and index.
@@ -200,202 +376,125 @@ void StatisticsFileVTMBMS::loadStatisticData(StatisticsData &statisticsData, int
       return;
     }
 
-    auto startPos = this->pocStartList[poc];
-
-    QTextStream in(this->file.getQFile());
-    in.seek(startPos);
+    // All types that we load in this pass by their name
+    struct TypeToLoad
+    {
+      const StatisticsType *type{};
+      FrameTypeData *       data{};
+    };
+    std::map<std::string, TypeToLoad, std::less<>> typesToLoad;
 
-    QRegularExpression pocRegex("BlockStat: POC ([0-9]+)");
+    auto typeIDsToLoad = statisticsData.getTypesThatNeedLoading(poc);
+    typeIDsToLoad.push_back(typeID);
 
-    // prepare regex for selected type
-    auto &statTypes = statisticsData.getStatisticsTypes();
-    auto  statIt    = std::find_if(statTypes.begin(), statTypes.end(), [typeID](StatisticsType &t) {
-      return t.typeID == typeID;
-    });
-    Q_ASSERT_X(statIt != statTypes.end(), Q_FUNC_INFO, "Stat type not found.");
-    QRegularExpression typeRegex(" " + statIt->typeName + "="); // for catching lines of the type
-
-    // for extracting scalar value statistics, need to match:
-    // BlockStat: POC 1 @( 112,  88) [ 8x 8] PredMode=0
-    QRegularExpression scalarRegex(
-        "POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x *([0-9]+)\\] *\\w+=([0-9\\-]+)");
-    // for extracting vector value statistics, need to match:
-    // BlockStat: POC 1 @( 120,  80) [ 8x 8] MVL0={ -24,  -2}
-    QRegularExpression vectorRegex("POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x "
-                                   "*([0-9]+)\\] *\\w+={ *([0-9\\-]+), *([0-9\\-]+)}");
-    // for extracting affine transform value statistics, need to match:
-    // BlockStat: POC 2 @( 192,  96) [64x32] AffineMVL0={-324,-116,-276,-116,-324, -92}
-    QRegularExpression affineTFRegex(
-        "POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x *([0-9]+)\\] *\\w+={ "
-        "*([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+)}");
-    // for extracting scalar polygon  statistics, need to match:
-    // BlockStat: POC 2 @[(505, 384)--(511, 384)--(511, 415)--] GeoPUInterIntraFlag=0
-    // BlockStat: POC 2 @[(416, 448)--(447, 448)--(447, 478)--(416, 463)--] GeoPUInterIntraFlag=0
-    // will capture 3-5 points. other polygons are not supported
-    QRegularExpression scalarPolygonRegex(
-        "POC ([0-9]+) @\\[((?:\\( *[0-9]+, *[0-9]+\\)--){3,5})\\] *\\w+=([0-9\\-]+)");
-    // for extracting vector polygon statistics:
-    QRegularExpression vectorPolygonRegex(
-        "POC ([0-9]+) @\\[((?:\\( *[0-9]+, *[0-9]+\\)--){3,5})\\] *\\w+={ *([0-9\\-]+), "
-        "*([0-9\\-]+)}");
-    // for extracting the partitioning line, we extract
-    // BlockStat: POC 2 @( 192,  96) [64x32] Line={0,0,31,31}
-    QRegularExpression lineRegex(
-        "POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x *([0-9]+)\\] *\\w+={ "
-        "*([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+)}");
-
-    while (!in.atEnd())
+    this->prefetchedPOC = poc;
+    this->prefetchedTypeIDs.clear();
+    for (const auto &statType : statisticsData.getStatisticsTypes())
     {
-      // read one line
-      auto aLine    = in.readLine();
-      auto pocMatch = pocRegex.match(aLine);
+      if (std::find(typeIDsToLoad.begin(), typeIDsToLoad.end(), statType.typeID) ==
+          typeIDsToLoad.end())
+        continue;
+
+      auto &data = statisticsData[statType.typeID];
+      data       = {};
+      typesToLoad[statType.typeName.toStdString()] = {&statType, &data};
+      if (statType.typeID != typeID)
+        this->prefetchedTypeIDs.insert(statType.typeID);
+    }
+    Q_ASSERT_X(!typesToLoad.empty(), Q_FUNC_INFO, "Stat type not found.");
+
+    const auto frameSize = statisticsData.getFrameSize();
+
+    BlockStatLine blockStat;
+    forEachLineInFile(this->file, this->pocStartList[poc], [&](std::string_view line, int64_t) {
       // ignore not matching lines
-      if (pocMatch.hasMatch())
+      const auto pocRow = parsePOC(line);
+      if (!pocRow)
+        return true;
+      // if there is a new POC, we are done here!
+      if (*pocRow != poc)
+        return false;
+
+      if (!parseBlockStatLine(line, blockStat))
       {
-        auto pocRow = pocMatch.captured(1).toInt();
-        if (poc != pocRow)
-          break;
+        this->errorMessage = QString("Error while parsing statistic: ") +
+                             QString::fromUtf8(line.data(), int(line.size()));
+        return true;
+      }
 
-        // filter lines of different types
-        auto typeMatch = typeRegex.match(aLine);
-        if (typeMatch.hasMatch())
+      // filter lines of different types
+      const auto typeIt = typesToLoad.find(blockStat.typeName);
+      if (typeIt == typesToLoad.end())
+        return true;
+      const auto &statType = *typeIt->second.type;
+      auto &      data     = *typeIt->second.data;
+
+      const auto nrValues        = blockStat.nrValues;
+      const auto inBraces        = blockStat.valuesInBraces;
+      auto       lineMatchesType = false;
+      if (!statType.isPolygon && !blockStat.isPolygon)
+      {
+        // Check if block is within the image range
+        if (this->blockOutsideOfFramePOC == -1 &&
+            (blockStat.x + int(blockStat.width) > int(frameSize.width) ||
+             blockStat.y + int(blockStat.height) > int(frameSize.height)))
+          // Block not in image. Warn about this.
+          this->blockOutsideOfFramePOC = poc;
+
+        const auto x      = blockStat.x;
+        const auto y      = blockStat.y;
+        const auto width  = blockStat.width;
+        const auto height = blockStat.height;
+        const auto v      = blockStat.values;
+        if (statType.hasValueData && !inBraces)
         {
-          int      posX, posY, scalar, vecX, vecY;
-          unsigned width, height;
-
-          QRegularExpressionMatch statisitcMatch;
-          // extract statistics info
-          // try block types
-          if (statIt->isPolygon == false)
-          {
-            if (statIt->hasValueData)
-              statisitcMatch = scalarRegex.match(aLine);
-            else if (statIt->hasVectorData)
-            {
-              statisitcMatch = vectorRegex.match(aLine);
-              if (!statisitcMatch.hasMatch())
-                statisitcMatch = lineRegex.match(aLine);
-            }
-            else if (statIt->hasAffineTFData)
-              statisitcMatch = affineTFRegex.match(aLine);
-          }
-          else
-          // try polygons
-          {
-            if (statIt->hasValueData)
-              statisitcMatch = scalarPolygonRegex.match(aLine);
-            else if (statIt->hasVectorData)
-              statisitcMatch = vectorPolygonRegex.match(aLine);
-          }
-          if (!statisitcMatch.hasMatch())
-          {
-            this->errorMessage = QString("Error while parsing statistic: ") + QString(aLine);
-            continue;
-          }
-
-          // useful for debugging:
-          //        QStringList all_captured = statisitcMatch.capturedTexts();
+          data.addBlockValue(x, y, width, height, v[0]);
+          lineMatchesType = true;
+        }
+        else if (statType.hasVectorData && inBraces && nrValues == 2)
+        {
+          data.addBlockVector(x, y, width, height, v[0], v[1]);
+          lineMatchesType = true;
+        }
+        else if (statType.hasVectorData && inBraces && nrValues == 4)
+        {
+          data.addLine(x, y, width, height, v[0], v[1], v[2], v[3]);
+          lineMatchesType = true;
+        }
+        else if (statType.hasAffineTFData && inBraces && nrValues == 6)
+        {
+          data.addBlockAffineTF(x, y, width, height, v[0], v[1], v[2], v[3], v[4], v[5]);
+          lineMatchesType = true;
+        }
+      }
+      else if (statType.isPolygon && blockStat.isPolygon && blockStat.nrCorners >= 3)
+      {
+        const Polygon points(blockStat.corners, blockStat.corners + blockStat.nrCorners);
 
-          pocRow = statisitcMatch.captured(1).toInt();
-          width  = statisitcMatch.captured(4).toUInt();
-          height = statisitcMatch.captured(5).toUInt();
-          // if there is a new POC, we are done here!
-          if (poc != pocRow)
-            break;
+        // Check if polygon is within the image range
+        for (const auto &point : points)
+          if (this->blockOutsideOfFramePOC == -1 &&
+              (point.x > int(frameSize.width) || point.y > int(frameSize.height)))
+            // Polygon not in image. Warn about this.
+            this->blockOutsideOfFramePOC = poc;
 
-          // process block statistics
-          if (statIt->isPolygon == false)
-          {
-            posX = statisitcMatch.captured(2).toInt();
-            posY = statisitcMatch.captured(3).toInt();
-
-            // Check if block is within the image range
-            if (blockOutsideOfFramePOC == -1 &&
-                (posX + int(width) > int(statisticsData.getFrameSize().width) ||
-                 posY + int(height) > int(statisticsData.getFrameSize().height)))
-              // Block not in image. Warn about this.
-              blockOutsideOfFramePOC = poc;
-
-            if (statIt->hasVectorData)
-            {
-              vecX = statisitcMatch.captured(6).toInt();
-              vecY = statisitcMatch.captured(7).toInt();
-              if (statisitcMatch.lastCapturedIndex() > 7)
-              {
-                auto vecX1 = statisitcMatch.captured(8).toInt();
-                auto vecY1 = statisitcMatch.captured(9).toInt();
-                statisticsData[typeID].addLine(posX, posY, width, height, vecX, vecY, vecX1, vecY1);
-              }
-              else
-              {
-                statisticsData[typeID].addBlockVector(posX, posY, width, height, vecX, vecY);
-              }
-            }
-            else if (statIt->hasAffineTFData)
-            {
-              auto vecX0 = statisitcMatch.captured(6).toInt();
-              auto vecY0 = statisitcMatch.captured(7).toInt();
-              auto vecX1 = statisitcMatch.captured(8).toInt();
-              auto vecY1 = statisitcMatch.captured(9).toInt();
-              auto vecX2 = statisitcMatch.captured(10).toInt();
-              auto vecY2 = statisitcMatch.captured(11).toInt();
-              statisticsData[typeID].addBlockAffineTF(
-                  posX, posY, width, height, vecX0, vecY0, vecX1, vecY1, vecX2, vecY2);
-            }
-            else
-            {
-              scalar = statisitcMatch.captured(6).toInt();
-              statisticsData[typeID].addBlockValue(posX, posY, width, height, scalar);
-            }
-          }
-          else
-          // process polygon statistics
-          {
-            auto               corners    = statisitcMatch.captured(2);
-            auto               cornerList = corners.split("--");
-            QRegularExpression cornerRegex("\\( *([0-9]+), *([0-9]+)\\)");
-            stats::Polygon     points;
-            for (const auto &corner : cornerList)
-            {
-              auto cornerMatch = cornerRegex.match(corner);
-              if (cornerMatch.hasMatch())
-              {
-                auto x = cornerMatch.captured(1).toInt();
-                auto y = cornerMatch.captured(2).toInt();
-                points.push_back({x, y});
-
-                // Check if polygon is within the image range
-                if (this->blockOutsideOfFramePOC == -1 &&
-                    (x + width > statisticsData.getFrameSize().width ||
-                     y + height > statisticsData.getFrameSize().height))
-                  // Block not in image. Warn about this.
-                  this->blockOutsideOfFramePOC = poc;
-              }
-            }
-
-            if (statIt->hasVectorData)
-            {
-              vecX = statisitcMatch.captured(3).toInt();
-              vecY = statisitcMatch.captured(4).toInt();
-              statisticsData[typeID].addPolygonVector(points, vecX, vecY);
-            }
-            else if (statIt->hasValueData)
-            {
-              scalar = statisitcMatch.captured(3).toInt();
-              statisticsData[typeID].addPolygonValue(points, scalar);
-            }
-          }
+        if (statType.hasValueData && !inBraces)
+        {
+          data.addPolygonValue(points, blockStat.values[0]);
+          lineMatchesType = true;
+        }
+        else if (statType.hasVectorData && inBraces && nrValues == 2)
+        {
+          data.addPolygonVector(points, blockStat.values[0], blockStat.values[1]);
+          lineMatchesType = true;
         }
       }
-    }
-
-    if (!statisticsData.hasDataForTypeID(typeID))
-    {
-      // There are no statistics in the file for the given frame and index.
-      statisticsData[typeID] = {};
-      return;
-    }
 
+      if (!lineMatchesType)
+        this->errorMessage = QString("Error while parsing statistic: ") +
+                             QString::fromUtf8(line.data(), int(line.size()));
+      return true;
+    });
   } // try
   catch (const char *str)
   {
@@ -34,6 +34,8 @@
 
 #include "StatisticsFileBase.h"
 
+#include <set>
+
 namespace stats
 {
 
@@ -57,6 +59,10 @@ private:
   void readHeaderFromFile(StatisticsData &statisticsData);
   
   std::map<int, uint64_t> pocStartList;
+
+  // The types that were loaded together with another type in the last call of loadStatisticData
+  int           prefetchedPOC{-1};
+  std::set<int> prefetchedTypeIDs;
 };
 
 } // namespace parser
\ No newline at end of file
@@ -0,0 +1,103 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FramePacer.h"
+
+#include <algorithm>
+
+void FramePacer::start(Clock::time_point now, Clock::duration frameInterval)
+{
+  this->frameInterval    = std::max(frameInterval, Clock::duration(1));
+  this->nextFrameDueTime = now + this->frameInterval;
+  this->waitingForFrame  = false;
+}
+
+void FramePacer::resume(Clock::time_point now)
+{
+  this->nextFrameDueTime = now;
+  this->waitingForFrame  = false;
+}
+
+unsigned FramePacer::getFramesToDrop(Clock::time_point now, unsigned maxFramesToDrop) const
+{
+  const auto behind = now - this->nextFrameDueTime;
+  if (!this->dropFrames || behind < this->frameInterval)
+    return 0;
+
+  const auto framesBehind = static_cast<unsigned>(behind / this->frameInterval);
+  return std::min(framesBehind, maxFramesToDrop);
+}
+
+unsigned FramePacer::presentFrame(Clock::time_point now, unsigned maxFramesToDrop)
+{
+  this->waitingForFrame = false;
+  this->counters.presentedFrames++;
+
+  const auto behind = now - this->nextFrameDueTime;
+  if (behind < this->frameInterval)
+  {
+    this->nextFrameDueTime += this->frameInterval;
+    return 0;
+  }
+
+  this->counters.lateFrames++;
+  if (!this->dropFrames)
+  {
+    // Do not try to catch up by presenting the next frames faster
+    this->nextFrameDueTime = now + this->frameInterval;
+    return 0;
+  }
+
+  // The frames that were due in the meantime are skipped. The clock stays the same, even if less
+  // frames can be dropped.
+  const auto framesBehind = static_cast<unsigned>(behind / this->frameInterval);
+  const auto framesToDrop = this->getFramesToDrop(now, maxFramesToDrop);
+
+  this->nextFrameDueTime += (framesBehind + 1) * this->frameInterval;
+  this->counters.droppedFrames += framesToDrop;
+  return framesToDrop;
+}
+
+void FramePacer::frameNotReady()
+{
+  this->waitingForFrame = true;
+}
+
+FramePacer::Clock::time_point FramePacer::getNextDueTime(Clock::time_point now) const
+{
+  if (!this->waitingForFrame || now < this->nextFrameDueTime)
+    return this->nextFrameDueTime;
+
+  // Check again when the next frame after now is due
+  const auto framesBehind = (now - this->nextFrameDueTime) / this->frameInterval;
+  return this->nextFrameDueTime + (framesBehind + 1) * this->frameInterval;
+}
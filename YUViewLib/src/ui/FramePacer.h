@@ -0,0 +1,93 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+
+// The clock for the presentation of frames during playback. Frame n after the start is due at
+// start + n * frameInterval. The due times are not derived from the time when the previous frame
+// was presented, so timer inaccuracies do not add up and the frame rate does not drift.
+//
+// If a frame is presented more than one frame interval after it was due, the pacer either
+// continues from the current time (the video plays slower) or, if dropping of frames is enabled,
+// reports how many frames must be skipped to stay on the wall clock.
+class FramePacer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Counters
+  {
+    unsigned presentedFrames{};
+    unsigned droppedFrames{};
+    // Frames that were presented at least one frame interval after they were due
+    unsigned lateFrames{};
+  };
+
+  void setDropFrames(bool dropFrames) { this->dropFrames = dropFrames; }
+  bool isDropFramesEnabled() const { return this->dropFrames; }
+
+  // Start the clock. The first frame is due one frame interval after now.
+  void            start(Clock::time_point now, Clock::duration frameInterval);
+  Clock::duration getFrameInterval() const { return this->frameInterval; }
+
+  // Continue after the playback waited for a frame. The next frame is due now.
+  void resume(Clock::time_point now);
+
+  // The number of frames that must be skipped (at most maxFramesToDrop) if the next frame is
+  // presented now. This is always 0 if dropping is disabled. The state of the pacer is not changed.
+  unsigned getFramesToDrop(Clock::time_point now, unsigned maxFramesToDrop) const;
+
+  // The next frame is presented now. Returns the number of frames that must be skipped before it
+  // (see getFramesToDrop) to stay on the wall clock.
+  unsigned presentFrame(Clock::time_point now, unsigned maxFramesToDrop);
+
+  // The next frame was due but it is not ready yet. The frame is not skipped.
+  void frameNotReady();
+  bool isWaitingForFrame() const { return this->waitingForFrame; }
+
+  // The time when the next frame is due. If the playback is waiting for a frame, this is the next
+  // due time of a frame after now.
+  Clock::time_point getNextDueTime(Clock::time_point now) const;
+
+  const Counters &getCounters() const { return this->counters; }
+  void            resetCounters() { this->counters = {}; }
+
+private:
+  Clock::duration   frameInterval{};
+  Clock::time_point nextFrameDueTime{};
+  bool              waitingForFrame{};
+  bool              dropFrames{};
+
+  Counters counters;
+};
@@ -57,6 +57,44 @@ constexpr EnumMapper<PlaybackController::RepeatMode, 3>
                      std::make_pair(PlaybackController::RepeatMode::One, "One"sv),
                      std::make_pair(PlaybackController::RepeatMode::All, "All"sv));
 
+QString formatDurationStatistics(const PlaybackStatistics::DurationStatistics &duration)
+{
+  if (duration.count == 0)
+    return "-";
+
+  const auto averageMs = duration.getAverage().count() / 1000.0;
+  const auto maxMs     = duration.max.count() / 1000.0;
+  return QString("%1 ms (max %2 ms)").arg(averageMs, 0, 'f', 1).arg(maxMs, 0, 'f', 1);
+}
+
+QString formatPlaybackStatistics(const PlaybackStatistics &statistics)
+{
+  QStringList lines;
+  lines << QString("Presented frames: %1").arg(statistics.frames.presentedFrames);
+  lines << QString("Dropped frames: %1").arg(statistics.frames.droppedFrames);
+  lines << QString("Late frames: %1").arg(statistics.frames.lateFrames);
+  lines << QString("Stalls: %1").arg(statistics.stalls);
+  lines << QString("Cached frames ahead: %1").arg(statistics.cachedFramesAhead);
+  lines << QString("Loading: %1").arg(formatDurationStatistics(statistics.loading));
+  lines << QString("Waiting: %1").arg(formatDurationStatistics(statistics.waiting));
+  lines << QString("Drawing: %1").arg(formatDurationStatistics(statistics.drawing));
+  return lines.join("\n");
+}
+
+}
+
+void PlaybackStatistics::DurationStatistics::add(std::chrono::microseconds duration)
+{
+  this->count++;
+  this->sum += duration;
+  this->max = std::max(this->max, duration);
+}
+
+std::chrono::microseconds PlaybackStatistics::DurationStatistics::getAverage() const
+{
+  if (this->count == 0)
+    return {};
+  return this->sum / this->count;
 }
 
 CountDown::CountDown(const int ticks)
@@ -202,6 +240,9 @@ void PlaybackController::on_playPauseButton_clicked()
 
     emit(signalPlaybackStarting());
 
+    this->statistics = {};
+    this->framePacer.resetCounters();
+
     if (this->waitForCachingOfItem)
     {
       DEBUG_PLAYBACK("PlaybackController::on_playPauseButton_clicked waiting for caching...");
@@ -250,26 +291,37 @@ void PlaybackController::startOrUpdateTimer()
 {
   if (this->anyItemIndexedByFrame())
   {
-    const auto frameRate = this->getCurrentItemsFrameRate();
-    this->timerInterval = std::chrono::duration_cast<std::chrono::milliseconds>(1000ms / frameRate);
+    const auto frameRate               = this->getCurrentItemsFrameRate();
     const auto ticksToUpdateEachSecond = static_cast<int>(frameRate);
     this->countdownForFPSUpdate        = CountDown(ticksToUpdateEachSecond);
+    this->framePacer.start(FramePacer::Clock::now(), this->getCurrentItemsFrameInterval());
+    this->scheduleNextFrame();
     DEBUG_PLAYBACK("PlaybackController::startOrUpdateTimer framerate %f", frameRate);
   }
   else
   {
-    this->timerInterval = 100ms;
     const auto ticksForStaticItem =
         static_cast<int>(this->currentItem[0]->properties().duration * 10);
     this->countDownForStaticItem = CountDown(ticksForStaticItem);
-    DEBUG_PLAYBACK("PlaybackController::startOrUpdateTimer duration %d", this->timerInterval);
+    this->timer.start(100, Qt::PreciseTimer, this);
+    DEBUG_PLAYBACK("PlaybackController::startOrUpdateTimer static item ticks %d",
+                   ticksForStaticItem);
   }
 
-  this->timer.start(this->timerInterval.count(), Qt::PreciseTimer, this);
   this->playbackMode       = PlaybackMode::Running;
   this->fpsUpdateStopWatch = StopWatch();
 }
 
+void PlaybackController::scheduleNextFrame()
+{
+  // The timer is restarted for every frame so that the frames are presented at the times given by
+  // the frame pacer. A fixed timer interval in ms can not represent most frame rates exactly.
+  const auto now       = FramePacer::Clock::now();
+  const auto timeToDue = this->framePacer.getNextDueTime(now) - now;
+  const auto msToDue   = std::max(std::chrono::ceil<std::chrono::milliseconds>(timeToDue), 0ms);
+  this->timer.start(static_cast<int>(msToDue.count()), Qt::PreciseTimer, this);
+}
+
 void PlaybackController::nextFrame()
 {
   this->pausePlayback();
@@ -438,6 +490,8 @@ void PlaybackController::selectionPropertiesChanged(bool redraw)
 void PlaybackController::updateSettings()
 {
   QSettings settings;
+  this->framePacer.setDropFrames(settings.value("PlaybackDropFrames", false).toBool());
+
   settings.beginGroup("VideoCache");
   auto caching               = settings.value("Enabled", true).toBool();
   auto wait                  = settings.value("PlaybackPauseCaching", false).toBool();
@@ -529,54 +583,98 @@ void PlaybackController::goToNextItem()
 
 void PlaybackController::goToNextFrame(const int nextFrameIndex)
 {
+  // If frames are dropped, the frame that is due now is determined before anything is checked or
+  // loaded. It is the frame that is loaded and presented, not the next frame after the current one.
+  const auto now             = FramePacer::Clock::now();
+  const auto maxFramesToDrop = std::max(this->ui.frameSlider->maximum() - nextFrameIndex, 0);
+  const auto framesToDrop    = this->framePacer.getFramesToDrop(now, unsigned(maxFramesToDrop));
+  const auto frameIndex      = nextFrameIndex + int(framesToDrop);
+
   this->waitingForItem[0] =
       this->currentItem[0]->isLoading() || this->currentItem[0]->isLoadingDoubleBuffer();
   this->waitingForItem[1] =
       this->splitViewPrimary->isSplitting() && this->currentItem[1] &&
       (this->currentItem[1]->isLoading() || this->currentItem[1]->isLoadingDoubleBuffer());
-  if (this->waitingForItem[0] || this->waitingForItem[1])
+  const auto isWaitingForItem = this->waitingForItem[0] || this->waitingForItem[1];
+
+  // While dropping frames, the items may still be loading the double buffer with the next frame
+  // after the current one. If that frame is not due anymore, there is no point in waiting for it.
+  // The frame that is due is loaded instead.
+  if (isWaitingForItem && frameIndex == nextFrameIndex)
   {
+    // A stall is counted once when it starts and not for every check while waiting for the frame
+    if (!this->framePacer.isWaitingForFrame())
+    {
+      this->statistics.stalls++;
+      this->stallStartTime = now;
+    }
+    this->playbackWasStalled = true;
+
+    if (this->framePacer.isDropFramesEnabled())
+    {
+      // Do not wait for the frame. Check again when the next frame is due. The frames that were
+      // due in the meantime are skipped then.
+      this->framePacer.frameNotReady();
+      this->scheduleNextFrame();
+      DEBUG_PLAYBACK("PlaybackController::goToNextFrame frame not ready");
+      return;
+    }
+
     // The double buffer of the current item or the second item is still loading. Playback is not
     // fast enough. We must wait until the next frame was loaded (in both items) successfully
     // until we can display it. We must pause the timer until this happens.
     this->timer.stop();
-    this->playbackMode       = PlaybackMode::Stalled;
-    this->playbackWasStalled = true;
+    this->playbackMode = PlaybackMode::Stalled;
     DEBUG_PLAYBACK("PlaybackController::goToNextFrame playback stalled");
     return;
   }
 
-  DEBUG_PLAYBACK("PlaybackController::goToNextFrame next frame %d", nextFrameIndex);
-  this->setCurrentFrameAndUpdate(nextFrameIndex);
+  if (this->framePacer.isWaitingForFrame())
+    this->statistics.waiting.add(
+        std::chrono::duration_cast<std::chrono::microseconds>(now - this->stallStartTime));
+  this->framePacer.presentFrame(now, unsigned(maxFramesToDrop));
+
+  DEBUG_PLAYBACK(
+      "PlaybackController::goToNextFrame next frame %d (%d dropped)", frameIndex, framesToDrop);
+  this->setCurrentFrameAndUpdate(frameIndex);
 
   if (this->countdownForFPSUpdate.tickAndGetIsExpired())
-  {
-    const auto msecsSinceLastUpdate = this->fpsUpdateStopWatch.getMsSinceCreation();
-
-    // Print the frames per second as float with one digit after the decimal dot.
-    const auto actualFramesPerSec = (static_cast<double>(this->countdownForFPSUpdate.getTicks()) /
-                                     (msecsSinceLastUpdate / 1000.0));
-    if (actualFramesPerSec > 0)
-      this->ui.fpsLabel->setText(QString::number(actualFramesPerSec, 'f', 1));
-    if (this->playbackWasStalled)
-      this->ui.fpsLabel->setStyleSheet("QLabel { background-color: yellow }");
-    else
-      this->ui.fpsLabel->setStyleSheet("");
-    this->playbackWasStalled = false;
+    this->updateFPSLabel();
 
-    this->fpsUpdateStopWatch = StopWatch();
-  }
+  // Check if the frame interval changed (the user changed the rate of the item)
+  if (this->getCurrentItemsFrameInterval() != this->framePacer.getFrameInterval())
+    this->startOrUpdateTimer();
+  else
+    this->scheduleNextFrame();
+}
 
-  // Check if the time interval changed (the user changed the rate of the item)
-  if (this->anyItemIndexedByFrame())
-  {
-    const auto frameRate = this->getCurrentItemsFrameRate();
+void PlaybackController::updateFPSLabel()
+{
+  const auto msecsSinceLastUpdate = this->fpsUpdateStopWatch.getMsSinceCreation();
 
-    const auto newtimerInterval =
-        std::chrono::duration_cast<std::chrono::milliseconds>(1000ms / frameRate);
-    if (this->timerInterval != newtimerInterval)
-      this->startOrUpdateTimer();
+  // Print the frames per second as float with one digit after the decimal dot.
+  const auto actualFramesPerSec = (static_cast<double>(this->countdownForFPSUpdate.getTicks()) /
+                                   (msecsSinceLastUpdate / 1000.0));
+  if (actualFramesPerSec > 0)
+    this->ui.fpsLabel->setText(QString::number(actualFramesPerSec, 'f', 1));
+  if (this->playbackWasStalled)
+    this->ui.fpsLabel->setStyleSheet("QLabel { background-color: yellow }");
+  else
+    this->ui.fpsLabel->setStyleSheet("");
+  this->playbackWasStalled = false;
+
+  // Count the frames after the current frame that can be presented without waiting for loading
+  this->statistics.cachedFramesAhead = 0;
+  if (this->currentItem[0] && this->currentItem[0]->properties().isIndexedByFrame())
+  {
+    const auto cachedFrames = this->currentItem[0]->getCachedFrames();
+    auto       frameIndex   = this->currentFrameIdx + 1;
+    while (cachedFrames.contains(frameIndex++))
+      this->statistics.cachedFramesAhead++;
   }
+  this->ui.fpsLabel->setToolTip(formatPlaybackStatistics(this->getPlaybackStatistics()));
+
+  this->fpsUpdateStopWatch = StopWatch();
 }
 
 void PlaybackController::enableControls(bool enable)
@@ -591,6 +689,7 @@ void PlaybackController::enableControls(bool enable)
     const QSignalBlocker blocker(this->ui.frameSlider);
     this->ui.fpsLabel->setText("0");
     this->ui.fpsLabel->setStyleSheet("");
+    this->ui.fpsLabel->setToolTip("");
     this->playbackWasStalled = false;
   }
 
@@ -649,16 +748,36 @@ void PlaybackController::currentSelectedItemsDoubleBufferLoad(int itemID)
     this->waitingForItem[itemID] = false;
     if (!this->waitingForItem[0] && !this->waitingForItem[1])
     {
-      DEBUG_PLAYBACK(
-          "PlaybackController::currentSelectedItemsDoubleBufferLoad - timer interval %dms",
-          this->timerInterval.count());
-      this->timer.start(this->timerInterval.count(), Qt::PreciseTimer, this);
-      this->timerEvent(nullptr);
+      DEBUG_PLAYBACK("PlaybackController::currentSelectedItemsDoubleBufferLoad - resume");
+      const auto now = FramePacer::Clock::now();
+      this->statistics.waiting.add(
+          std::chrono::duration_cast<std::chrono::microseconds>(now - this->stallStartTime));
+
+      // Show the frame now and continue from here with the frame rate
+      this->framePacer.resume(now);
       this->playbackMode = PlaybackMode::Running;
+      this->timerEvent(nullptr);
     }
   }
 }
 
+void PlaybackController::reportFrameLoadingDuration(std::chrono::microseconds duration)
+{
+  this->statistics.loading.add(duration);
+}
+
+void PlaybackController::reportFrameDrawingDuration(std::chrono::microseconds duration)
+{
+  this->statistics.drawing.add(duration);
+}
+
+PlaybackStatistics PlaybackController::getPlaybackStatistics() const
+{
+  auto statistics   = this->statistics;
+  statistics.frames = this->framePacer.getCounters();
+  return statistics;
+}
+
 bool PlaybackController::setCurrentFrameAndUpdate(int frame, bool updateView)
 {
   if (frame == this->currentFrameIdx)
@@ -712,3 +831,9 @@ double PlaybackController::getCurrentItemsFrameRate() const
     frameRate = lowestPossibleFps;
   return frameRate;
 }
+
+FramePacer::Clock::duration PlaybackController::getCurrentItemsFrameInterval() const
+{
+  const auto frameInterval = std::chrono::duration<double>(1.0 / this->getCurrentItemsFrameRate());
+  return std::chrono::duration_cast<FramePacer::Clock::duration>(frameInterval);
+}
@@ -35,6 +35,7 @@
 #include <chrono>
 
 #include <common/Typedef.h>
+#include <ui/FramePacer.h>
 #include <ui/views/SplitViewWidget.h>
 #include <ui/widgets/PlaylistTreeWidget.h>
 
@@ -72,6 +73,29 @@ private:
   std::chrono::high_resolution_clock::time_point creationTimePoint{};
 };
 
+// Statistics of the current playback. These are reset when playback starts.
+struct PlaybackStatistics
+{
+  struct DurationStatistics
+  {
+    void                      add(std::chrono::microseconds duration);
+    std::chrono::microseconds getAverage() const;
+
+    unsigned                  count{};
+    std::chrono::microseconds sum{};
+    std::chrono::microseconds max{};
+  };
+
+  FramePacer::Counters frames;
+  unsigned             stalls{};
+  // The number of frames after the current frame that are already in the cache
+  unsigned cachedFramesAhead{};
+
+  DurationStatistics loading;
+  DurationStatistics waiting;
+  DurationStatistics drawing;
+};
+
 class PlaybackController : public QWidget
 {
   Q_OBJECT
@@ -90,6 +114,13 @@ public:
 
   bool setCurrentFrameAndUpdate(int frame, bool updateView = true);
 
+  // Called while playing by the video cache when a frame was loaded by the interactive loader and
+  // by the split views when a frame was drawn.
+  void reportFrameLoadingDuration(std::chrono::microseconds duration);
+  void reportFrameDrawingDuration(std::chrono::microseconds duration);
+
+  PlaybackStatistics getPlaybackStatistics() const;
+
   enum class RepeatMode
   {
     Off,
@@ -156,6 +187,8 @@ private:
 
   void startOrUpdateTimer();
   void startPlayback();
+  void scheduleNextFrame();
+  void updateFPSLabel();
 
   RepeatMode repeatMode{RepeatMode::Off};
   void       setRepeatModeAndUpdateIcons(const RepeatMode mode);
@@ -184,17 +217,23 @@ private:
   bool playbackWasStalled{false};
   bool waitForCachingOfItem{};
 
-  QBasicTimer               timer;
-  std::chrono::milliseconds timerInterval{};
-  CountDown                 countdownForFPSUpdate;
-  StopWatch                 fpsUpdateStopWatch;
-  CountDown                 countDownForStaticItem;
+  // For indexed items, the timer is restarted for each frame with the time until the frame is due
+  // according to the frame pacer. For static items it fires every 100ms.
+  QBasicTimer timer;
+  FramePacer  framePacer;
+  CountDown   countdownForFPSUpdate;
+  StopWatch   fpsUpdateStopWatch;
+  CountDown   countDownForStaticItem;
+
+  PlaybackStatistics            statistics;
+  FramePacer::Clock::time_point stallStartTime{};
   virtual void
   timerEvent(QTimerEvent *event) override; // Overloaded from QObject. Called when the timer fires.
 
-  QPointer<playlistItem> currentItem[2];
-  bool                   anyItemIndexedByFrame() const;
-  double                 getCurrentItemsFrameRate() const;
+  QPointer<playlistItem>      currentItem[2];
+  bool                        anyItemIndexedByFrame() const;
+  double                      getCurrentItemsFrameRate() const;
+  FramePacer::Clock::duration getCurrentItemsFrameInterval() const;
 
   // The playback controller has a pointer to the split view so it can toggle a redraw event when a
   // new frame is selected. This could also be done using signals/slots but the problem is that
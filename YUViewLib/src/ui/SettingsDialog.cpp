@@ -32,6 +32,7 @@
 
 #include "SettingsDialog.h"
 
+#include <common/BufferPool.h>
 #include <common/Functions.h>
 #include <common/Typedef.h>
 #include <decoder/decoderDav1d.h>
@@ -40,6 +41,7 @@
 #include <decoder/decoderVTM.h>
 #include <decoder/decoderVVDec.h>
 #include <ffmpeg/FFmpegVersionHandler.h>
+#include <statistics/StatisticsCache.h>
 
 #include <QColorDialog>
 #include <QFileDialog>
@@ -62,9 +64,12 @@ SettingsDialog::SettingsDialog(QWidget *parent) : QDialog(parent)
 
   // "Generals" tab
   ui.checkBoxWatchFiles->setChecked(settings.value("WatchFiles", true).toBool());
+  ui.checkBoxMemoryMapRawFiles->setChecked(settings.value("MemoryMapRawFiles", false).toBool());
+  ui.checkBoxCacheBitstreamIndex->setChecked(settings.value("CacheBitstreamIndex", true).toBool());
   ui.checkBoxAskToSave->setChecked(settings.value("AskToSaveOnExit", true).toBool());
   ui.checkBoxContinuePlaybackNewSelection->setChecked(
       settings.value("ContinuePlaybackOnSequenceSelection", false).toBool());
+  ui.checkBoxDropFramesInPlayback->setChecked(settings.value("PlaybackDropFrames", false).toBool());
   ui.checkBoxSavePositionPerItem->setChecked(
       settings.value("SavePositionAndZoomPerItem", false).toBool());
   ui.checkBoxAutodetectFileType->setChecked(settings.value("AutodetectFileType", true).toBool());
@@ -119,13 +124,16 @@ SettingsDialog::SettingsDialog(QWidget *parent) : QDialog(parent)
   settings.beginGroup("VideoCache");
   ui.groupBoxCaching->setChecked(settings.value("Enabled", true).toBool());
   ui.sliderThreshold->setValue(settings.value("ThresholdValue", 49).toInt());
+  on_sliderThreshold_valueChanged(ui.sliderThreshold->value());
   ui.checkBoxNrThreads->setChecked(settings.value("SetNrThreads", false).toBool());
+  ui.checkBoxCacheRawFrames->setChecked(settings.value("CacheRawFrames", false).toBool());
   if (ui.checkBoxNrThreads->isChecked())
     ui.spinBoxNrThreads->setValue(
         settings.value("NrThreads", functions::getOptimalThreadCount()).toInt());
   else
     ui.spinBoxNrThreads->setValue(functions::getOptimalThreadCount());
   ui.spinBoxNrThreads->setEnabled(ui.checkBoxNrThreads->isChecked());
+  ui.spinBoxNrCachingDecoders->setValue(settings.value("NrCachingDecoders", 1).toInt());
   // Playback
   ui.checkBoxPausPlaybackForCaching->setChecked(
       settings.value("PlaybackPauseCaching", true).toBool());
@@ -428,9 +436,12 @@ void SettingsDialog::on_pushButtonSave_clicked()
 
   // "General" tab
   settings.setValue("WatchFiles", ui.checkBoxWatchFiles->isChecked());
+  settings.setValue("MemoryMapRawFiles", ui.checkBoxMemoryMapRawFiles->isChecked());
+  settings.setValue("CacheBitstreamIndex", ui.checkBoxCacheBitstreamIndex->isChecked());
   settings.setValue("AskToSaveOnExit", ui.checkBoxAskToSave->isChecked());
   settings.setValue("ContinuePlaybackOnSequenceSelection",
                     ui.checkBoxContinuePlaybackNewSelection->isChecked());
+  settings.setValue("PlaybackDropFrames", ui.checkBoxDropFramesInPlayback->isChecked());
   settings.setValue("SavePositionAndZoomPerItem", ui.checkBoxSavePositionPerItem->isChecked());
   settings.setValue("AutodetectFileType", ui.checkBoxAutodetectFileType->isChecked());
 
@@ -464,6 +475,8 @@ void SettingsDialog::on_pushButtonSave_clicked()
   settings.setValue("ThresholdValueMB", getCacheSizeInMB());
   settings.setValue("SetNrThreads", ui.checkBoxNrThreads->isChecked());
   settings.setValue("NrThreads", ui.spinBoxNrThreads->value());
+  settings.setValue("CacheRawFrames", ui.checkBoxCacheRawFrames->isChecked());
+  settings.setValue("NrCachingDecoders", ui.spinBoxNrCachingDecoders->value());
   settings.setValue("PlaybackPauseCaching", ui.checkBoxPausPlaybackForCaching->isChecked());
   settings.setValue("PlaybackCachingEnabled", ui.checkBoxEnablePlaybackCaching->isChecked());
   settings.setValue("PlaybackCachingThreadLimit", ui.spinBoxThreadLimit->value());
@@ -493,6 +506,15 @@ void SettingsDialog::on_pushButtonSave_clicked()
 
 void SettingsDialog::on_sliderThreshold_valueChanged(int value)
 {
-  ui.labelThreshold->setText(
-      QString("Threshold (%1 MB)").arg(functions::systemMemorySizeInMB() * (value + 1) / 100));
+  const auto thresholdMB = functions::systemMemorySizeInMB() * (value + 1) / 100;
+  ui.labelThreshold->setText(QString("Threshold (%1 MB)").arg(thresholdMB));
+
+  // The video cache does not use all of the threshold for frames (see VideoCache::updateSettings)
+  const auto statisticsMB = stats::StatisticsCache::getShareOfVideoCacheThreshold(thresholdMB);
+  const auto bufferPoolMB = BufferPool::getShareOfVideoCacheThreshold(thresholdMB);
+  ui.labelThresholdSplit->setText(
+      QString("Frames: %1 MB, statistics: %2 MB, reusable frame buffers: %3 MB")
+          .arg(thresholdMB - statisticsMB - bufferPoolMB)
+          .arg(statisticsMB)
+          .arg(bufferPoolMB));
 }
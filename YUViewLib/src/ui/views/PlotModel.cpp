@@ -119,3 +119,38 @@ std::optional<unsigned> PlotModel::getPointIndex(unsigned streamIndex, unsigned
   }
   return {};
 }
+
+std::vector<PlotPointSummary> PlotModel::getPointSummaries(unsigned      streamIndex,
+                                                           unsigned      plotIndex,
+                                                           Range<double> xRange,
+                                                           double        xPerSummary) const
+{
+  const auto streamParam = this->getStreamParameter(streamIndex);
+  if (plotIndex >= unsigned(streamParam.plotParameters.size()))
+    return {};
+  const auto plotParam = streamParam.plotParameters[plotIndex];
+  const auto isBarPlot = (plotParam.type == PlotType::Bar);
+
+  std::vector<PlotPointSummary>   summaries;
+  std::optional<PlotPointSummary> summaryBeforeRange;
+  for (unsigned pointIndex = 0; pointIndex < plotParam.nrpoints; pointIndex++)
+  {
+    const auto point   = this->getPlotPoint(streamIndex, plotIndex, pointIndex);
+    const auto summary = PlotPointSummary::fromPoint(
+        point.x, point.y, isBarPlot ? point.width : 0.0, isBarPlot && point.intra);
+    if (summary.x.max < xRange.min)
+    {
+      summaryBeforeRange = summary;
+      continue;
+    }
+    if (summaryBeforeRange)
+    {
+      summaries.push_back(*summaryBeforeRange);
+      summaryBeforeRange.reset();
+    }
+    appendToSummaryBuckets(summaries, summary, xRange, xPerSummary);
+    if (summary.x.min > xRange.max)
+      break;
+  }
+  return summaries;
+}
@@ -34,6 +34,7 @@
 
 #include <common/EventSubsampler.h>
 #include <common/Typedef.h>
+#include <ui/views/PlotPointPyramid.h>
 
 #include <QObject>
 #include <QTimer>
@@ -104,6 +105,15 @@ public:
   std::optional<unsigned>
   getPointIndex(unsigned streamIndex, unsigned plotIndex, QPointF point) const;
 
+  // Get summaries of the points of a plot in the given range on the x axis so that each summary
+  // covers about xPerSummary. This way, at most about one bar/line segment per pixel is drawn. The
+  // default implementation goes through all points. Models with many points should override this
+  // (e.g. using a PlotPointPyramid).
+  virtual std::vector<PlotPointSummary> getPointSummaries(unsigned      streamIndex,
+                                                          unsigned      plotIndex,
+                                                          Range<double> xRange,
+                                                          double        xPerSummary) const;
+
 protected:
   EventSubsampler eventSubsampler;
 };
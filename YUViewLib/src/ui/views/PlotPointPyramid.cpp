@@ -0,0 +1,156 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlotPointPyramid.h"
+
+#include <algorithm>
+#include <cmath>
+
+PlotPointSummary PlotPointSummary::fromPoint(double x, double y, double width, bool intra)
+{
+  PlotPointSummary summary;
+  summary.x        = {x - width / 2, x + width / 2};
+  summary.y        = {y, y};
+  summary.firstY   = y;
+  summary.lastY    = y;
+  summary.intra    = intra;
+  summary.nrPoints = 1;
+  return summary;
+}
+
+void PlotPointSummary::merge(const PlotPointSummary &next)
+{
+  this->x.min = std::min(this->x.min, next.x.min);
+  this->x.max = std::max(this->x.max, next.x.max);
+  this->y.min = std::min(this->y.min, next.y.min);
+  this->y.max = std::max(this->y.max, next.y.max);
+  this->lastY = next.lastY;
+  this->intra = this->intra || next.intra;
+  this->nrPoints += next.nrPoints;
+}
+
+void appendToSummaryBuckets(std::vector<PlotPointSummary> &summaries,
+                            const PlotPointSummary &       summary,
+                            Range<double>                  xRange,
+                            double                         xPerBucket)
+{
+  auto getBucket = [&xRange, &xPerBucket](const PlotPointSummary &s) {
+    return std::floor((s.x.min - xRange.min) / xPerBucket);
+  };
+
+  if (!summaries.empty() && xPerBucket > 0 && getBucket(summaries.back()) == getBucket(summary))
+    summaries.back().merge(summary);
+  else
+    summaries.push_back(summary);
+}
+
+void PlotPointPyramid::invalidateFrom(size_t pointIndex)
+{
+  this->firstInvalidPoint = std::min(this->firstInvalidPoint, pointIndex);
+}
+
+void PlotPointPyramid::update(size_t nrPoints, const GetPointSummary &getPointSummary)
+{
+  if (this->levels.empty())
+    this->levels.resize(1);
+
+  auto firstChanged = std::min(this->firstInvalidPoint, this->levels[0].size());
+  if (firstChanged == nrPoints && this->levels[0].size() == nrPoints)
+    return;
+
+  this->levels[0].resize(nrPoints);
+  for (auto i = firstChanged; i < nrPoints; i++)
+    this->levels[0][i] = getPointSummary(i);
+
+  size_t level = 0;
+  while (this->levels[level].size() > 1)
+  {
+    if (this->levels.size() == level + 1)
+      this->levels.emplace_back();
+
+    const auto &lower = this->levels[level];
+    auto &      upper = this->levels[level + 1];
+
+    firstChanged = firstChanged / 2;
+    upper.resize((lower.size() + 1) / 2);
+    for (auto i = firstChanged; i < upper.size(); i++)
+    {
+      upper[i] = lower[2 * i];
+      if (2 * i + 1 < lower.size())
+        upper[i].merge(lower[2 * i + 1]);
+    }
+    level++;
+  }
+  this->levels.resize(level + 1);
+  this->firstInvalidPoint = nrPoints;
+}
+
+std::vector<PlotPointSummary> PlotPointPyramid::getSummaries(Range<double> xRange,
+                                                             double        xPerSummary) const
+{
+  if (this->levels.empty() || this->levels[0].empty())
+    return {};
+
+  // The range of points [first, last) to summarize
+  const auto &points  = this->levels[0];
+  const auto  firstIt = std::lower_bound(
+      points.begin(), points.end(), xRange.min, [](const PlotPointSummary &s, double x) {
+        return s.x.max < x;
+      });
+  const auto lastIt = std::upper_bound(
+      points.begin(), points.end(), xRange.max, [](double x, const PlotPointSummary &s) {
+        return x < s.x.min;
+      });
+  auto first = size_t(firstIt - points.begin());
+  auto last  = size_t(lastIt - points.begin());
+  if (first > 0)
+    first--;
+  if (last < points.size())
+    last++;
+  if (first >= last)
+    return {};
+
+  // Go up in the pyramid as long as a summary in the level contains fewer points than we want
+  // to summarize per bucket.
+  const auto xRangeWidth = xRange.max - xRange.min;
+  const auto pointsPerSummary =
+      (xRangeWidth > 0) ? double(last - first) * xPerSummary / xRangeWidth : 0.0;
+  size_t level = 0;
+  while (level + 1 < this->levels.size() && double(size_t(2) << level) <= pointsPerSummary)
+    level++;
+
+  std::vector<PlotPointSummary> summaries;
+  const auto &                  levelSummaries = this->levels[level];
+  for (auto i = first >> level; i <= (last - 1) >> level; i++)
+    appendToSummaryBuckets(summaries, levelSummaries[i], xRange, xPerSummary);
+  return summaries;
+}
@@ -0,0 +1,83 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/Typedef.h>
+
+#include <functional>
+#include <vector>
+
+// A summary of one or more consecutive points of a plot
+struct PlotPointSummary
+{
+  static PlotPointSummary fromPoint(double x, double y, double width, bool intra);
+
+  // Add the summary of the points which follow the points of this summary
+  void merge(const PlotPointSummary &next);
+
+  Range<double> x{};
+  Range<double> y{};
+  double        firstY{};
+  double        lastY{};
+  bool          intra{false};
+  unsigned      nrPoints{};
+};
+
+// Append the summary to the list of summaries. If the summary starts in the same bucket on the
+// x axis as the last summary in the list, the two are merged.
+void appendToSummaryBuckets(std::vector<PlotPointSummary> &summaries,
+                            const PlotPointSummary &       summary,
+                            Range<double>                  xRange,
+                            double                         xPerBucket);
+
+// A min/max pyramid of the points of a plot which must be sorted by their x value. The first
+// level contains one summary per point. Each summary in the next level summarizes two summaries
+// of the level below. With this, any range of points can be summarized in a few steps.
+class PlotPointPyramid
+{
+public:
+  using GetPointSummary = std::function<PlotPointSummary(size_t pointIndex)>;
+
+  // The points from this index on were changed or added. Only the summaries of these points are
+  // updated in the next call to update(). If points are mostly appended, this is fast.
+  void invalidateFrom(size_t pointIndex);
+  void update(size_t nrPoints, const GetPointSummary &getPointSummary);
+
+  // Get summaries of the points in the given range so that each summary covers about xPerSummary
+  // on the x axis. One more point left and right of the range is also included.
+  std::vector<PlotPointSummary> getSummaries(Range<double> xRange, double xPerSummary) const;
+
+private:
+  std::vector<std::vector<PlotPointSummary>> levels;
+  size_t                                     firstInvalidPoint{0};
+};
@@ -620,6 +620,10 @@ void PlotViewWidget::drawPlot(QPainter &painter) const
   const auto plotXMin = this->convertPixelPosToPlotPos(this->plotRect.bottomLeft()).x() - 0.5;
   const auto plotXMax = this->convertPixelPosToPlotPos(this->plotRect.bottomRight()).x() + 0.5;
 
+  // The model summarizes all points within one pixel so that we draw at most about one bar or
+  // line segment per pixel.
+  const auto xPerPixel = 1.0 / (this->zoomToPixelsPerValueX * this->zoomFactor);
+
   DEBUG_PLOT("PlotViewWidget::drawPlot start");
   for (auto streamIndex : this->showStreamList)
   {
@@ -635,6 +639,11 @@ void PlotViewWidget::drawPlot(QPainter &painter) const
           detailedPainting = true;
       }
 
+      std::optional<unsigned> hoveredPointIndex;
+      if (this->currentlyHoveredPointPerStreamAndPlot.contains(streamIndex) &&
+          this->currentlyHoveredPointPerStreamAndPlot[streamIndex].contains(plotIndex))
+        hoveredPointIndex = this->currentlyHoveredPointPerStreamAndPlot[streamIndex][plotIndex];
+
       if (plotParam.type == PlotModel::PlotType::Bar)
       {
         auto setPainterColor = [&painter, &detailedPainting](bool isIntra, bool isHighlight) {
@@ -650,37 +659,18 @@ void PlotViewWidget::drawPlot(QPainter &painter) const
 
         QVector<QRectF> normalBars;
         QVector<QRectF> intraBars;
-        for (unsigned int i = 0; i < plotParam.nrpoints; i++)
+        for (const auto &summary : this->model->getPointSummaries(
+                 streamIndex, plotIndex, {plotXMin, plotXMax}, xPerPixel))
         {
-          const auto value = model->getPlotPoint(streamIndex, plotIndex, i);
-
-          if (value.x < plotXMin || value.x > plotXMax)
-            continue;
-
-          const auto halfWidth = value.width / 2;
           const auto barTopLeft =
-              this->convertPlotPosToPixelPos(QPointF(value.x - halfWidth, value.y));
-          const auto barBottomRight =
-              this->convertPlotPosToPixelPos(QPointF(value.x + halfWidth, 0));
-
-          const bool isHoveredBar =
-              this->currentlyHoveredPointPerStreamAndPlot.contains(streamIndex) &&
-              this->currentlyHoveredPointPerStreamAndPlot[streamIndex].contains(plotIndex) &&
-              this->currentlyHoveredPointPerStreamAndPlot[streamIndex][plotIndex] == i;
+              this->convertPlotPosToPixelPos(QPointF(summary.x.min, summary.y.max));
+          const auto barBottomRight = this->convertPlotPosToPixelPos(QPointF(summary.x.max, 0));
 
           const auto r = QRectF(barTopLeft, barBottomRight);
-          if (isHoveredBar)
-          {
-            setPainterColor(value.intra, true);
-            painter.drawRect(r);
-          }
+          if (summary.intra)
+            intraBars.append(r);
           else
-          {
-            if (value.intra)
-              intraBars.append(r);
-            else
-              normalBars.append(r);
-          }
+            normalBars.append(r);
         }
 
         DEBUG_PLOT("PlotViewWidget::drawPlot Start drawing " << normalBars.size() << " bars");
@@ -690,59 +680,37 @@ void PlotViewWidget::drawPlot(QPainter &painter) const
         DEBUG_PLOT("PlotViewWidget::drawPlot Start drawing " << intraBars.size() << " intra bars");
         setPainterColor(true, false);
         painter.drawRects(intraBars);
+
+        if (hoveredPointIndex)
+        {
+          const auto value     = model->getPlotPoint(streamIndex, plotIndex, *hoveredPointIndex);
+          const auto halfWidth = value.width / 2;
+          const auto barTopLeft =
+              this->convertPlotPosToPixelPos(QPointF(value.x - halfWidth, value.y));
+          const auto barBottomRight =
+              this->convertPlotPosToPixelPos(QPointF(value.x + halfWidth, 0));
+
+          setPainterColor(value.intra, true);
+          painter.drawRect(QRectF(barTopLeft, barBottomRight));
+        }
       }
       else if (plotParam.type == PlotModel::PlotType::Line)
       {
-        // We can assume that the points are sorted (i.e. there is not graph that suddenly goes
-        // back)
-        auto getStartIndexBinarySearch = [](unsigned   nrpoints,
-                                            PlotModel *model,
-                                            unsigned   streamIndex,
-                                            unsigned   plotIndex,
-                                            double     plotXMin) {
-          unsigned intervalLeft  = 0;
-          unsigned intervalRight = nrpoints;
-          if (nrpoints == 0)
-            return intervalLeft;
-          while (true)
-          {
-            unsigned pointToCheck = intervalLeft + (intervalRight - intervalLeft) / 2;
-            auto     valuePoint   = model->getPlotPoint(streamIndex, plotIndex, pointToCheck);
-            if (valuePoint.x < plotXMin) // Choose right interval
-              intervalLeft = pointToCheck;
-            else // Left interval
-              intervalRight = pointToCheck;
-            if (intervalLeft + 1 == intervalRight)
-              return intervalLeft;
-          }
-        };
-
-        QPolygonF  linePoints;
-        QPointF    lastPoint;
-        const auto startIndex = getStartIndexBinarySearch(
-            plotParam.nrpoints, this->model, streamIndex, plotIndex, plotXMin);
-        for (unsigned i = startIndex; i < plotParam.nrpoints; i++)
+        // For a summary of multiple points, draw a vertical line from the minimum to the maximum
+        // in the middle.
+        QPolygonF linePoints;
+        for (const auto &summary : this->model->getPointSummaries(
+                 streamIndex, plotIndex, {plotXMin, plotXMax}, xPerPixel))
         {
-          const auto valueStart = this->model->getPlotPoint(streamIndex, plotIndex, i);
-          const auto linePointStart =
-              this->convertPlotPosToPixelPos(QPointF(valueStart.x, valueStart.y));
-
-          if (valueStart.x < plotXMin)
+          linePoints.append(this->convertPlotPosToPixelPos(QPointF(summary.x.min, summary.firstY)));
+          if (summary.nrPoints > 1)
           {
-            lastPoint = linePointStart;
-            continue;
+            const auto centerX = (summary.x.min + summary.x.max) / 2;
+            linePoints.append(this->convertPlotPosToPixelPos(QPointF(centerX, summary.y.min)));
+            linePoints.append(this->convertPlotPosToPixelPos(QPointF(centerX, summary.y.max)));
+            linePoints.append(
+                this->convertPlotPosToPixelPos(QPointF(summary.x.max, summary.lastY)));
           }
-
-          if (linePoints.size() == 0 && i > 0)
-            linePoints.append(lastPoint);
-          linePoints.append(linePointStart);
-
-          if (valueStart.x > plotXMax)
-            // This means that no graph can "go back" on the x-axis. That is ok for now.
-            // If we ever need this, this needs to be smarter here.
-            break;
-
-          lastPoint = linePointStart;
         }
 
         DEBUG_PLOT("PlotViewWidget::drawPlot Start drawing line with " << linePoints.size()
@@ -753,29 +721,22 @@ void PlotViewWidget::drawPlot(QPainter &painter) const
         painter.drawPolyline(linePoints);
 
         // Draw the currently hovered line in a different color
-        if (this->currentlyHoveredPointPerStreamAndPlot.contains(streamIndex) &&
-            this->currentlyHoveredPointPerStreamAndPlot[streamIndex].contains(plotIndex))
+        if (hoveredPointIndex && *hoveredPointIndex > 0)
         {
-          const auto index = this->currentlyHoveredPointPerStreamAndPlot[streamIndex][plotIndex];
-          if (index > 0)
-          {
-            const auto valueStart = model->getPlotPoint(streamIndex, plotIndex, index - 1);
-            const auto linePointStart =
-                this->convertPlotPosToPixelPos(QPointF(valueStart.x, valueStart.y));
-            const auto valueEnd = model->getPlotPoint(streamIndex, plotIndex, index);
-            const auto linePointEnd =
-                this->convertPlotPosToPixelPos(QPointF(valueEnd.x, valueEnd.y));
-
-            DEBUG_PLOT("PlotViewWidget::drawPlot Draw hovered line");
-            QPen linePen(QColor(50, 50, 200));
-            linePen.setWidthF(detailedPainting ? 2.0 : 1.0);
-            painter.setPen(linePen);
-            painter.drawLine(linePointStart, linePointEnd);
-          }
+          const auto index      = *hoveredPointIndex;
+          const auto valueStart = model->getPlotPoint(streamIndex, plotIndex, index - 1);
+          const auto linePointStart =
+              this->convertPlotPosToPixelPos(QPointF(valueStart.x, valueStart.y));
+          const auto valueEnd = model->getPlotPoint(streamIndex, plotIndex, index);
+          const auto linePointEnd =
+              this->convertPlotPosToPixelPos(QPointF(valueEnd.x, valueEnd.y));
+
+          DEBUG_PLOT("PlotViewWidget::drawPlot Draw hovered line");
+          QPen linePen(QColor(50, 50, 200));
+          linePen.setWidthF(detailedPainting ? 2.0 : 1.0);
+          painter.setPen(linePen);
+          painter.drawLine(linePointStart, linePointEnd);
         }
-
-        // if (detailedPainting)
-        //   painter.drawEllipse(linePointStart, 2.0, 2.0);
       }
     }
   }
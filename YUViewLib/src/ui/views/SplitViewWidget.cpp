@@ -51,6 +51,8 @@
 #include <QSettings>
 #include <QTextDocument>
 
+#include <chrono>
+
 // The splitter can be grabbed with a certain margin of pixels to the left and right. The margin
 // in pixels is calculated depending on the logical DPI of the user using:
 //    logicalDPI() / SPLITVIEWWIDGET_SPLITTER_MARGIN_DPI_DIV
@@ -194,6 +196,8 @@ void splitViewWidget::paintEvent(QPaintEvent *)
   DEBUG_LOAD_DRAW("splitViewWidget::paintEvent drawing "
                   << (isMasterView ? " separate widget" : ""));
 
+  const auto drawingStart = std::chrono::steady_clock::now();
+
   // Get the current frame to draw
   const auto frame = playback->getCurrentFrame();
 
@@ -515,6 +519,10 @@ void splitViewWidget::paintEvent(QPaintEvent *)
 
   MoveAndZoomableView::updateMouseCursor();
 
+  if (playing)
+    playback->reportFrameDrawingDuration(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - drawingStart));
+
   if (testMode)
   {
     if (testLoopCount < 0)
@@ -36,6 +36,7 @@
 
 #include <QBuffer>
 #include <QDragMoveEvent>
+#include <QEventLoop>
 #include <QFileDialog>
 #include <QHeaderView>
 #include <QInputDialog>
@@ -43,9 +44,14 @@
 #include <QMessageBox>
 #include <QMimeData>
 #include <QPainter>
+#include <QProgressDialog>
 #include <QScopedValueRollback>
 #include <QSettings>
 #include <QTextStream>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <atomic>
 
 #include "playlistitem/playlistItemCompressedVideo.h"
 #include "playlistitem/playlistItemContainer.h"
@@ -744,6 +750,16 @@ void PlaylistTreeWidget::loadFiles(const QStringList &files)
       filesToOpen.append(fileName);
   }
 
+  // Prepare opening all files (except playlists) in parallel
+  QStringList filesToPrepare;
+  for (const auto &filePath : filesToOpen)
+    if (QFileInfo(filePath).suffix().toLower() != "yuvplaylist")
+      filesToPrepare.append(filePath);
+  const auto preparedFiles = this->prepareFiles(filesToPrepare);
+  if (!preparedFiles)
+    return;
+  auto preparedFile = preparedFiles->begin();
+
   // Open all files that are in filesToOpen
   for (auto filePath : filesToOpen)
   {
@@ -760,7 +776,7 @@ void PlaylistTreeWidget::loadFiles(const QStringList &files)
     else
     {
       // Try to open the file
-      playlistItem *newItem = playlistItems::createPlaylistItemFromFile(this, filePath);
+      playlistItem *newItem = playlistItems::createPlaylistItemFromFile(this, *(preparedFile++));
       if (newItem)
       {
         appendNewItem(newItem, false);
@@ -785,6 +801,70 @@ void PlaylistTreeWidget::loadFiles(const QStringList &files)
   }
 }
 
+std::optional<std::vector<playlistItems::PreparedFile>>
+PlaylistTreeWidget::prepareFiles(const QStringList &files)
+{
+  // Each file is prepared in its own thread. The threads report their progress here.
+  std::vector<std::atomic_int> progress(files.size());
+  std::atomic_bool             abort{false};
+
+  std::vector<QFuture<playlistItems::PreparedFile>> futures;
+  for (int i = 0; i < files.size(); i++)
+    futures.push_back(QtConcurrent::run([&files, &progress, &abort, i]() {
+      return playlistItems::prepareFile(files[i], [&progress, &abort, i](int percent) {
+        progress[i] = percent;
+        return !abort;
+      });
+    }));
+
+  auto allFinished = [&futures]() {
+    return std::all_of(
+        futures.begin(), futures.end(), [](const auto &future) { return future.isFinished(); });
+  };
+
+  if (!allFinished())
+  {
+    // Show the combined progress of all files. The dialog is only shown if this takes a while.
+    QProgressDialog progressDialog(
+        "Opening files...", "Cancel", 0, 100 * int(files.size()), this->parentWidget());
+    progressDialog.setMinimumDuration(1000);
+    progressDialog.setAutoClose(false);
+    progressDialog.setAutoReset(false);
+    progressDialog.setWindowModality(Qt::WindowModal);
+
+    QEventLoop loop;
+    QTimer     updateTimer;
+    connect(&updateTimer, &QTimer::timeout, &loop, [&]() {
+      if (allFinished())
+      {
+        loop.quit();
+        return;
+      }
+      int totalProgress = 0;
+      for (size_t i = 0; i < futures.size(); i++)
+        totalProgress += futures[i].isFinished() ? 100 : progress[i].load();
+      progressDialog.setValue(totalProgress);
+    });
+    connect(&progressDialog, &QProgressDialog::canceled, &loop, [&]() {
+      abort = true;
+      loop.quit();
+    });
+    updateTimer.start(50);
+    loop.exec();
+  }
+
+  // The threads use the progress and abort values. Wait for them even if the user aborted.
+  for (auto &future : futures)
+    future.waitForFinished();
+  if (abort)
+    return {};
+
+  std::vector<playlistItems::PreparedFile> preparedFiles;
+  for (auto &future : futures)
+    preparedFiles.push_back(future.result());
+  return preparedFiles;
+}
+
 void PlaylistTreeWidget::addFileToRecentFileSetting(const QString &fileName)
 {
   QSettings   settings;
@@ -929,12 +1009,19 @@ bool PlaylistTreeWidget::loadPlaylistFromByteArray(QByteArray data, QString file
     return false;
   }
 
+  // Scan the files of the items in parallel before the items are created. The items will then
+  // use the results of the scans.
+  const auto preparedFiles = this->prepareFiles(playlistItems::getFilesToPrepare(root, filePath));
+  if (!preparedFiles)
+    return false;
+
   // Iterate over all items in the playlist
   auto n = root.firstChild();
   while (!n.isNull())
   {
     if (n.isElement())
-      this->appendNewItem(playlistItems::loadPlaylistItem(n.toElement(), filePath), false);
+      this->appendNewItem(
+          playlistItems::loadPlaylistItem(n.toElement(), filePath, *preparedFiles), false);
     n = n.nextSibling();
   }
 
@@ -34,12 +34,14 @@
 
 #include <common/Typedef.h>
 #include <playlistitem/playlistItem.h>
+#include <playlistitem/playlistItems.h>
 #include <ui/ViewStateHandler.h>
 
 #include <QPointer>
 #include <QTimer>
 #include <QTreeWidget>
 #include <array>
+#include <optional>
 
 class QDomElement;
 
@@ -184,6 +186,10 @@ protected slots:
 private:
   playlistItem *getDropTarget(const QPoint &pos) const;
 
+  // Prepare opening the given files in parallel (see playlistItems::prepareFile) while showing
+  // the combined progress in one progress dialog. Returns nothing if the user aborted.
+  std::optional<std::vector<playlistItems::PreparedFile>> prepareFiles(const QStringList &files);
+
   bool    loadPlaylistFile(const QString &filePath);
   bool    loadPlaylistFromByteArray(QByteArray data, QString filePath);
   QString getPlaylistString(QDir dirName);
@@ -268,7 +268,7 @@ void FrameHandler::drawFrame(QPainter *painter, double zoomFactor, bool drawRawV
   videoRect.moveCenter(QPoint(0, 0));
 
   // Draw the current image (currentFrame)
-  painter->drawImage(videoRect, this->currentImage);
+  this->drawCurrentImage(painter, videoRect);
 
   if (drawRawValues && zoomFactor >= SPLITVIEW_DRAW_VALUES_ZOOMFACTOR)
   {
@@ -277,6 +277,11 @@ void FrameHandler::drawFrame(QPainter *painter, double zoomFactor, bool drawRawV
   }
 }
 
+void FrameHandler::drawCurrentImage(QPainter *painter, const QRect &videoRect)
+{
+  this->currentImagePyramid.drawImage(painter, videoRect, this->currentImage);
+}
+
 void FrameHandler::drawPixelValues(QPainter *painter,
                                    const int,
                                    const QRect & videoRect,
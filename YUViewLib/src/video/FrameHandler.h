@@ -36,6 +36,7 @@
 #include <common/SaveUi.h>
 #include <common/Typedef.h>
 #include <common/YUViewDomElement.h>
+#include <video/ImagePyramid.h>
 
 #include <QImage>
 #include <QObject>
@@ -140,6 +141,11 @@ protected:
   QImage currentImage;
   Size   frameSize;
 
+  // Draw currentImage scaled to the video rect. Only the visible part is drawn from the closest
+  // level of the pyramid. This must only be called from the GUI thread while currentImage is not
+  // changed.
+  void drawCurrentImage(QPainter *painter, const QRect &videoRect);
+
   // Get the pixel value from currentImage. Make sure that currentImage is the correct image.
   QRgb         getPixelVal(const QPoint &pos) { return getPixelVal(pos.x(), pos.y()); }
   virtual QRgb getPixelVal(int x, int y) { return currentImage.pixel(x, y); }
@@ -158,6 +164,8 @@ private:
 
   SafeUi<Ui::FrameHandler> ui;
 
+  ImagePyramid currentImagePyramid;
+
 protected slots:
 
   // All the valueChanged() signals from the controls are connected here.
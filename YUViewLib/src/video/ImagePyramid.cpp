@@ -0,0 +1,214 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ImagePyramid.h"
+
+#include <common/Functions.h>
+#include <common/ParallelFor.h>
+
+#include <QPainter>
+
+#include <algorithm>
+#include <cmath>
+
+namespace video
+{
+
+namespace
+{
+
+// The number of output lines of downscaleImageByTwo that are processed in one job
+constexpr int STRIPE_HEIGHT = 64;
+
+// The average of the four pixels, calculated per 8 bit channel with rounding. Two channels are
+// processed in one 32 bit value. The sum of four channels fits into the 16 bit lane.
+inline uint32_t
+averageOfFour(const uint32_t a, const uint32_t b, const uint32_t c, const uint32_t d)
+{
+  constexpr uint32_t mask     = 0x00ff00ff;
+  constexpr uint32_t rounding = 0x00020002;
+
+  const auto low  = (a & mask) + (b & mask) + (c & mask) + (d & mask) + rounding;
+  const auto high = ((a >> 8) & mask) + ((b >> 8) & mask) + ((c >> 8) & mask) + ((d >> 8) & mask) +
+                    rounding;
+  return ((low >> 2) & mask) | (((high >> 2) & mask) << 8);
+}
+
+} // namespace
+
+QImage downscaleImageByTwo(const QImage &image)
+{
+  if (image.isNull() ||
+      (image.format() != QImage::Format_RGB32 &&
+       image.format() != QImage::Format_ARGB32_Premultiplied))
+    return {};
+
+  const auto srcWidth  = image.width();
+  const auto srcHeight = image.height();
+  const auto width     = (srcWidth + 1) / 2;
+  const auto height    = (srcHeight + 1) / 2;
+
+  QImage scaled(width, height, image.format());
+  if (scaled.isNull())
+    return {};
+
+  auto processStripe = [&](const unsigned stripe) {
+    const auto yBegin = int(stripe) * STRIPE_HEIGHT;
+    const auto yEnd   = std::min(yBegin + STRIPE_HEIGHT, height);
+    for (int y = yBegin; y < yEnd; y++)
+    {
+      // For an odd size, the last line/column is used twice
+      const auto y1   = std::min(2 * y + 1, srcHeight - 1);
+      const auto src0 = reinterpret_cast<const uint32_t *>(image.constScanLine(2 * y));
+      const auto src1 = reinterpret_cast<const uint32_t *>(image.constScanLine(y1));
+      auto       dst  = reinterpret_cast<uint32_t *>(scaled.scanLine(y));
+
+      const auto evenWidth = srcWidth / 2;
+      for (int x = 0; x < evenWidth; x++)
+        dst[x] = averageOfFour(src0[2 * x], src0[2 * x + 1], src1[2 * x], src1[2 * x + 1]);
+      if (evenWidth < width)
+        dst[evenWidth] = averageOfFour(
+            src0[srcWidth - 1], src0[srcWidth - 1], src1[srcWidth - 1], src1[srcWidth - 1]);
+    }
+  };
+
+  const auto nrStripes = unsigned((height + STRIPE_HEIGHT - 1) / STRIPE_HEIGHT);
+  functions::parallelFor(nrStripes, processStripe);
+
+  return scaled;
+}
+
+unsigned getPyramidLevel(const double scale, const QSize &imageSize)
+{
+  unsigned level = 0;
+  while (scale * double(2 << level) <= 1.0 && (imageSize.width() >> (level + 1)) > 0 &&
+         (imageSize.height() >> (level + 1)) > 0)
+    level++;
+  return level;
+}
+
+std::optional<VisibleImagePart>
+getVisibleImagePart(const QRectF &targetRect, const QSize &imageSize, const QRectF &visibleRect)
+{
+  const auto drawRect = visibleRect & targetRect;
+  if (drawRect.isEmpty() || imageSize.isEmpty())
+    return {};
+
+  const auto pixelWidth  = targetRect.width() / imageSize.width();
+  const auto pixelHeight = targetRect.height() / imageSize.height();
+
+  const auto left = functions::clip(
+      int(std::floor((drawRect.left() - targetRect.left()) / pixelWidth)), 0, imageSize.width());
+  const auto right = functions::clip(
+      int(std::ceil((drawRect.right() - targetRect.left()) / pixelWidth)), 0, imageSize.width());
+  const auto top = functions::clip(
+      int(std::floor((drawRect.top() - targetRect.top()) / pixelHeight)), 0, imageSize.height());
+  const auto bottom = functions::clip(
+      int(std::ceil((drawRect.bottom() - targetRect.top()) / pixelHeight)), 0, imageSize.height());
+  if (left >= right || top >= bottom)
+    return {};
+
+  VisibleImagePart part;
+  part.sourceRect = QRect(left, top, right - left, bottom - top);
+  part.targetRect = QRectF(targetRect.left() + left * pixelWidth,
+                           targetRect.top() + top * pixelHeight,
+                           (right - left) * pixelWidth,
+                           (bottom - top) * pixelHeight);
+  return part;
+}
+
+void ImagePyramid::drawImage(QPainter *painter, const QRect &targetRect, const QImage &image)
+{
+  if (image.isNull() || targetRect.isEmpty())
+    return;
+
+  // The visible part of the target rect in the coordinates of the painter
+  const auto transform   = painter->worldTransform();
+  auto       visibleRect = transform.inverted().mapRect(QRectF(painter->window()));
+  if (painter->hasClipping())
+    visibleRect &= painter->clipBoundingRect();
+
+  const auto target = QRectF(targetRect);
+  if ((visibleRect & target).isEmpty())
+    return;
+
+  // The size of one image pixel on the device
+  const auto devicePixelRatio = painter->device() ? painter->device()->devicePixelRatioF() : 1.0;
+  const auto scaleX = target.width() * std::abs(transform.m11()) * devicePixelRatio / image.width();
+  const auto scaleY =
+      target.height() * std::abs(transform.m22()) * devicePixelRatio / image.height();
+
+  const auto  level      = getPyramidLevel(std::max(scaleX, scaleY), image.size());
+  const auto &levelImage = this->getLevel(image, level);
+  if (levelImage.isNull())
+  {
+    painter->drawImage(targetRect, image);
+    return;
+  }
+
+  if (const auto part = getVisibleImagePart(target, levelImage.size(), visibleRect))
+    painter->drawImage(part->targetRect, levelImage, part->sourceRect);
+}
+
+const QImage &ImagePyramid::getLevel(const QImage &image, const unsigned level)
+{
+  if (image.cacheKey() != this->imageCacheKey)
+  {
+    this->levels.clear();
+    this->imageCacheKey = image.cacheKey();
+  }
+
+  if (level == 0)
+    return image;
+
+  while (this->levels.size() < level)
+  {
+    if (this->levels.empty())
+    {
+      if (image.format() == QImage::Format_RGB32 ||
+          image.format() == QImage::Format_ARGB32_Premultiplied)
+        this->levels.push_back(downscaleImageByTwo(image));
+      else
+      {
+        // The averaging needs 32 bit pixels with premultiplied alpha
+        const auto format = image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                    : QImage::Format_RGB32;
+        this->levels.push_back(downscaleImageByTwo(image.convertToFormat(format)));
+      }
+    }
+    else
+      this->levels.push_back(downscaleImageByTwo(this->levels.back()));
+  }
+  return this->levels[level - 1];
+}
+
+} // namespace video
@@ -0,0 +1,88 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QImage>
+#include <QRect>
+
+#include <optional>
+#include <vector>
+
+class QPainter;
+
+namespace video
+{
+
+// Downscale the image to half of the width and height (rounded up). Each output pixel is the
+// average of the 2x2 input pixels that it covers. The image must be in Format_RGB32 or
+// Format_ARGB32_Premultiplied. The output has the same format.
+QImage downscaleImageByTwo(const QImage &image);
+
+// The level of the pyramid of an image with the given size that is drawn if one pixel of the image
+// covers scale device pixels. This is the smallest level that still has at least one pixel per
+// device pixel.
+unsigned getPyramidLevel(const double scale, const QSize &imageSize);
+
+// The pixels of an image with the given size which cover the visible part of the target rect and
+// the rect that these pixels cover in the target. The source rect is aligned to whole pixels so
+// that the pixels are not shifted. Nothing is returned if no pixel is visible.
+struct VisibleImagePart
+{
+  QRect  sourceRect;
+  QRectF targetRect;
+};
+std::optional<VisibleImagePart>
+getVisibleImagePart(const QRectF &targetRect, const QSize &imageSize, const QRectF &visibleRect);
+
+// A mip pyramid of the image that is drawn by a frame handler. Each level has half the width and
+// height of the level below. The levels are created when they are first needed and are dropped
+// when a different image is drawn.
+class ImagePyramid
+{
+public:
+  // Draw the image scaled to targetRect. Only the part of the image that is visible in the painter
+  // (the window and the clip region) is drawn. If the image is drawn smaller than its size, the
+  // smallest level that is not smaller than the drawn size is used. This is much faster than
+  // letting the painter scale the full image.
+  void drawImage(QPainter *painter, const QRect &targetRect, const QImage &image);
+
+private:
+  const QImage &getLevel(const QImage &image, const unsigned level);
+
+  // The QImage::cacheKey of the image that the levels were created from
+  qint64 imageCacheKey{};
+  // The levels 1, 2, ... (level 0 is the image itself)
+  std::vector<QImage> levels;
+};
+
+} // namespace video
@@ -38,9 +38,13 @@
 #include <QSettings>
 #include <QThread>
 #include <algorithm>
+#include <chrono>
 
+#include <common/BufferPool.h>
 #include <common/Functions.h>
+#include <common/ThreadBudget.h>
 #include <playlistitem/playlistItem.h>
+#include <statistics/StatisticsCache.h>
 #include <ui/PlaybackController.h>
 
 namespace video
@@ -90,6 +94,8 @@ public:
   void          setJob(playlistItem *item, int frame, bool test = false);
   void          setWorking(bool state) { working = state; }
   bool          isWorking() { return working; }
+  // The time that the last loading job took to load and convert the frame
+  std::chrono::microseconds getLastLoadingDuration() const { return lastLoadingDuration; }
   QString       getStatus()
   {
     return QString("T%1: %2").arg(id).arg(working ? QString::number(currentFrame) : QString("-"));
@@ -111,6 +117,8 @@ private:
   bool          testMode;
   int           id; // A static ID of the thread. Only used in getStatus().
   static int    id_counter;
+
+  std::chrono::microseconds lastLoadingDuration{};
 };
 // Initially this is 0. The threads will number themselves so that there are never two threads with
 // the same id
@@ -169,7 +177,10 @@ void loadingWorker::processLoadingJobInternal(bool playing, bool loadRawData)
 
   // Load the frame of the item that was given to us.
   // This is performed in the thread (the loading thread with higher priority.
+  const auto loadingStart = std::chrono::steady_clock::now();
   currentCacheItem->loadFrame(currentFrame, playing, loadRawData);
+  lastLoadingDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - loadingStart);
 
   currentCacheItem = nullptr;
   emit loadingFinished();
@@ -333,6 +344,18 @@ void VideoCache::updateSettings()
   cachingEnabled = settings.value("Enabled", true).toBool();
   cacheLevelMax  = (int64_t)settings.value("ThresholdValueMB", 49).toUInt() * 1000 * 1000;
 
+  // A part of the memory budget is used to keep released frame buffers for reuse. Lowering the
+  // threshold frees idle buffers right away.
+  const auto bufferPoolMax =
+      int64_t(BufferPool::getShareOfVideoCacheThreshold(std::size_t(cacheLevelMax)));
+  getFrameBufferPool().setMaxIdleBytes(std::size_t(bufferPoolMax));
+
+  // Another part is reserved for the statistics that items keep besides the cached frames. The
+  // settings dialog shows this split next to the threshold.
+  const auto statisticsMax =
+      int64_t(stats::StatisticsCache::getShareOfVideoCacheThreshold(size_t(cacheLevelMax)));
+  cacheLevelMax -= bufferPoolMax + statisticsMax;
+
   // See if the user changed the number of threads
   int targetNrThreads = functions::getOptimalThreadCount();
   if (settings.value("SetNrThreads", false).toBool())
@@ -380,6 +403,8 @@ void VideoCache::updateSettings()
     }
   }
 
+  updateThreadBudget();
+
   // Also update the cache status and schedule an update of the caching.
   emit updateCacheStatus();
   scheduleCachingListUpdate();
@@ -387,6 +412,16 @@ void VideoCache::updateSettings()
   settings.endGroup();
 }
 
+void VideoCache::updateThreadBudget()
+{
+  const auto playing          = playback->playing();
+  const auto nrCachingThreads = std::max(cachingThreadList.count() - deleteNrThreads, 0);
+  const auto nrCachingWorkers = playing ? std::min(nrThreadsPlayback, nrCachingThreads)
+                                        : nrCachingThreads;
+  DEBUG_CACHING("VideoCache::updateThreadBudget %d caching workers", nrCachingWorkers);
+  functions::updateThreadBudget(unsigned(nrCachingWorkers), playing);
+}
+
 void VideoCache::loadFrame(playlistItem *item, int frameIndex, int loadingSlot)
 {
   if (item == nullptr || item->taggedForDeletion() ||
@@ -430,6 +465,9 @@ void VideoCache::interactiveLoaderFinished()
   int            threadID = (interactiveThread[0]->worker() == worker) ? 0 : 1;
   assert(worker == interactiveThread[0]->worker() || worker == interactiveThread[1]->worker());
 
+  if (playback->playing())
+    playback->reportFrameLoadingDuration(worker->getLastLoadingDuration());
+
   // Check the list of items that are scheduled for deletion. Because a loading thread finished,
   // maybe now we can delete the item(s).
   for (auto it = itemsToDelete.begin(); it != itemsToDelete.end();)
@@ -539,6 +577,7 @@ void VideoCache::updateCacheQueue()
 
   const bool play = playback->playing();
   DEBUG_CACHING("VideoCache::updateCacheQueue Playback is %srunning", play ? "" : "not ");
+  updateThreadBudget();
 
   // Our caching priority list is like this:
   // 1: Cache all the frames in the item that is currently selected. In order to achieve this, we
@@ -962,8 +1001,26 @@ void VideoCache::enqueueCacheJob(playlistItem *item, indexRange range)
   int        i            = range.first;
   while (cachedFrames.contains(i) && i < range.second)
     range.first = ++i;
-  if (range.first != range.second)
+  if (range.first == range.second)
+    return;
+
+  item->prefetchFramesForCaching(range);
+
+  // If the item can be cached in independent segments, add one job per segment. The segments can
+  // then be cached in parallel.
+  auto segmentStarts = item->getCachingSegmentStarts(range);
+  if (segmentStarts.empty())
+  {
     cacheQueue.append(cacheJob(item, range));
+    return;
+  }
+  auto segmentStart = range.first;
+  for (auto nextSegmentStart : segmentStarts)
+  {
+    cacheQueue.append(cacheJob(item, indexRange(segmentStart, nextSegmentStart - 1), true));
+    segmentStart = nextSegmentStart;
+  }
+  cacheQueue.append(cacheJob(item, indexRange(segmentStart, range.second), true));
 }
 
 void VideoCache::startCaching()
@@ -987,6 +1044,9 @@ void VideoCache::startCaching()
 
 void VideoCache::watchItemForCachingFinished(playlistItem *item)
 {
+  // This is also called when playback stops
+  updateThreadBudget();
+
   watchingItem = item;
   if (watchingItem)
   {
@@ -1056,6 +1116,16 @@ void VideoCache::threadCachingFinished()
       // We are not going to start any new threads. Wait for the remaining threads to finish.
       if (jobsRunning)
         DEBUG_CACHING("VideoCache::threadCachingFinished Test over - Waiting for jobs to finish");
+      else if (workersState != workersIntReqStop && testNrThreads == 1 && getTestNrPasses() > 1)
+      {
+        // The pass with one thread is over. Repeat the test with all caching threads.
+        DEBUG_CACHING("VideoCache::threadCachingFinished Test single thread pass over");
+        testSingleThreadMsec = testDuration.elapsed();
+        testNrThreads        = cachingThreadList.count();
+        testLoopCount        = 1000;
+        testDuration.start();
+        startCaching();
+      }
       else
       {
         // Report the results of the test
@@ -1222,6 +1292,10 @@ bool VideoCache::pushNextJobToCachingThread(loadingThread *thread)
 
   if (testMode)
   {
+    if (cachingThreadList.indexOf(thread) >= testNrThreads)
+      // This thread is not used in the current pass of the test
+      return false;
+
     Q_ASSERT_X(testItem, Q_FUNC_INFO, "Test item invalid");
     auto range = testItem->properties().startEndRange;
     int  frameNr =
@@ -1279,6 +1353,12 @@ bool VideoCache::pushNextJobToCachingThread(loadingThread *thread)
     }
   }
 
+  // If the thread is caching a segment, it continues with the next frame of it
+  const auto threadHasSegment =
+      std::any_of(cacheQueue.begin(), cacheQueue.end(), [thread](const cacheJob &job) {
+        return job.isSegment && job.segmentThread == thread && job.plItem->isCachable();
+      });
+
   QMutableListIterator<cacheJob> j(cacheQueue);
   playlistItem *                 plItem = nullptr;
   indexRange                     range;
@@ -1288,6 +1368,12 @@ bool VideoCache::pushNextJobToCachingThread(loadingThread *thread)
     if (!job.plItem->isCachable())
       // Remove the item from the list
       j.remove();
+    else if (threadHasSegment && job.segmentThread != thread)
+      continue;
+    else if (job.isSegment && job.segmentThread != thread && job.segmentThread != nullptr &&
+             cachingThreadList.contains(job.segmentThread))
+      // Another thread is caching this segment
+      continue;
     else
     {
       // We might be able to cache from this item. Check if there is a thread limit for the item.
@@ -1307,6 +1393,8 @@ bool VideoCache::pushNextJobToCachingThread(loadingThread *thread)
       // We can start another thread for this item
       plItem = job.plItem;
       range  = job.frameRange;
+      if (job.isSegment)
+        job.segmentThread = thread;
 
       // Check if this is the last frame to cache in the item
       if (range.first == range.second)
@@ -1475,12 +1563,14 @@ void VideoCache::testConversionSpeed()
 
   assert(parentWidget != nullptr);
   assert(testProgressDialog.isNull());
-  testProgressDialog =
-      new QProgressDialog("Running conversion test...", "Cancel", 0, 1000, parentWidget);
+  testProgressDialog = new QProgressDialog(
+      "Running conversion test...", "Cancel", 0, 1000 * getTestNrPasses(), parentWidget);
   testProgressDialog->setWindowModality(Qt::WindowModal);
 
-  testLoopCount = 1000;
-  testMode      = true;
+  testLoopCount        = 1000;
+  testNrThreads        = 1;
+  testSingleThreadMsec = -1;
+  testMode             = true;
   testProgrssUpdateTimer.start(200);
 
   if (workersState == workersIdle)
@@ -1503,6 +1593,8 @@ QStringList VideoCache::getCacheStatusText()
   txt.append("Caching:");
   for (loadingThread *t : cachingThreadList)
     txt.append(t->worker()->getStatus());
+  txt.append(QString("Buffer pool: %1 MB idle")
+                 .arg(double(getFrameBufferPool().getIdleBytes()) / 1000 / 1000, 0, 'f', 1));
   return txt;
 }
 
@@ -1516,7 +1608,8 @@ void VideoCache::updateTestProgress()
     workersState = workersIntReqStop;
 
   // Update the dialog progress
-  testProgressDialog->setValue(1000 - testLoopCount);
+  const auto finishedPassesFrames = (testSingleThreadMsec < 0) ? 0 : 1000;
+  testProgressDialog->setValue(finishedPassesFrames + 1000 - testLoopCount);
 }
 
 void VideoCache::testFinished()
@@ -1536,12 +1629,22 @@ void VideoCache::testFinished()
   // Calculate and report the time
   int64_t msec = testDuration.elapsed();
   double  rate = 1000.0 * 1000 / msec;
-  QMessageBox::information(
-      parentWidget,
-      "Test results",
-      QString("We cached 1000 frames in %1 msec. The conversion rate is %2 frames per second.")
+  auto    text =
+      QString("We cached 1000 frames in %1 msec using %2 thread(s). The conversion rate is %3 "
+              "frames per second.")
           .arg(msec)
-          .arg(rate));
+          .arg(testNrThreads)
+          .arg(rate);
+  if (testSingleThreadMsec > 0)
+  {
+    double singleThreadRate = 1000.0 * 1000 / testSingleThreadMsec;
+    text += QString("\nWith one thread, it took %1 msec (%2 frames per second). The speedup of "
+                    "caching in parallel is %3.")
+                .arg(testSingleThreadMsec)
+                .arg(singleThreadRate)
+                .arg(rate / singleThreadRate, 0, 'f', 2);
+  }
+  QMessageBox::information(parentWidget, "Test results", text);
 }
 
 #include "VideoCache.moc"
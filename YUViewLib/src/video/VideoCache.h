@@ -109,23 +109,36 @@ private slots:
   void updateCacheQueue();
 
 private:
+  // A simple QObject (to move to threads) that gets a pointer to a playlist item and loads a frame
+  // in that item.
+  class loadingThread;
+
   // A cache job. Has a pointer to a playlist item and a range of frames to be cached.
+  // If the job is a segment (see playlistItem::getCachingSegmentStarts), all frames of it are
+  // cached in order by the same thread (segmentThread).
   struct cacheJob
   {
     cacheJob() {}
-    cacheJob(playlistItem *item, indexRange range)
+    cacheJob(playlistItem *item, indexRange range, bool isSegment = false)
     {
-      plItem     = item;
-      frameRange = range;
+      plItem          = item;
+      frameRange      = range;
+      this->isSegment = isSegment;
     }
     QPointer<playlistItem> plItem;
     indexRange             frameRange;
+    bool                   isSegment{false};
+    loadingThread *        segmentThread{nullptr};
   };
   typedef QPair<QPointer<playlistItem>, int> plItemFrame;
 
   // When the cache queue is updated, this function will start the background caching.
   void startCaching();
 
+  // Share the cores between the interactive loading and the caching workers that are active in
+  // the current playback state (see functions::ThreadBudget).
+  void updateThreadBudget();
+
   QPointer<PlaylistTreeWidget> playlist;
   QPointer<PlaybackController> playback;
   QPointer<splitViewWidget>    splitView;
@@ -178,10 +191,6 @@ private:
   // The cache of these items will be cleared when caching has halted.
   QList<playlistItem *> itemsToClearCache;
 
-  // A simple QObject (to move to threads) that gets a pointer to a playlist item and loads a frame
-  // in that item.
-  class loadingThread;
-
   // A list of caching threads that process caching of frames in parallel in the background
   QList<loadingThread *> cachingThreadList;
 
@@ -215,6 +224,11 @@ private:
   void   updateTestProgress();
   QElapsedTimer testDuration;   //< Used to obtain the duration of the test
   void          testFinished(); //< Report the test results and stop the testProgrssUpdateTimer
+  // The test first runs with one caching thread and then with all caching threads so that the
+  // speedup of caching in parallel can be reported.
+  int     testNrThreads{1};         //< The number of caching threads used in the current pass
+  int64_t testSingleThreadMsec{-1}; //< The duration of the pass with one thread
+  int     getTestNrPasses() const { return (cachingThreadList.count() > 1) ? 2 : 1; }
 };
 
 } // namespace video
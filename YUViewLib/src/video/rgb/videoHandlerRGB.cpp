@@ -109,16 +109,16 @@ videoHandlerRGB::videoHandlerRGB() : videoHandler()
 
 videoHandlerRGB::~videoHandlerRGB()
 {
-  // This will cause a "QMutex: destroying locked mutex" warning by Qt.
+  // This will cause a "QReadWriteLock: destroying locked QReadWriteLock" warning by Qt.
   // However, here this is on purpose.
-  rgbFormatMutex.lock();
+  rgbFormatLock.lockForWrite();
 }
 
 unsigned videoHandlerRGB::getCachingFrameSize() const
 {
   auto hasAlpha = this->srcPixelFormat.hasAlpha();
-  auto bytes    = functionsGui::bytesPerPixel(functionsGui::platformImageFormat(hasAlpha));
-  return this->frameSize.width * this->frameSize.height * bytes;
+  const auto format = functionsGui::platformImageFormat(hasAlpha);
+  return unsigned(functionsGui::getPooledImageBytes(this->frameSize, format));
 }
 
 QStringPairList videoHandlerRGB::getPixelValues(const QPoint &pixelPos,
@@ -514,27 +514,20 @@ void videoHandlerRGB::loadFrameForCaching(int frameIndex, QImage &frameToCache)
 {
   DEBUG_RGB("videoHandlerRGB::loadFrameForCaching %d", frameIndex);
 
-  // Lock the mutex for the rgbFormat. The main thread has to wait until caching is done
+  // Lock the rgbFormat for reading. The main thread has to wait until caching is done
   // before the RGB format can change.
-  rgbFormatMutex.lock();
+  QReadLocker formatLock(&this->rgbFormatLock);
 
-  requestDataMutex.lock();
-  emit signalRequestRawData(frameIndex, true);
-  tmpBufferRawRGBDataCaching = rawData;
-  requestDataMutex.unlock();
-
-  if (frameIndex != rawData_frameIndex)
+  QByteArray tmpBufferRawRGBDataCaching;
+  if (!this->loadRawDataForCaching(frameIndex, tmpBufferRawRGBDataCaching))
   {
     // Loading failed
     currentImageIndex = -1;
-    rgbFormatMutex.unlock();
     return;
   }
 
   // Convert RGB to image. This can then be cached.
   convertRGBToImage(tmpBufferRawRGBDataCaching, frameToCache);
-
-  rgbFormatMutex.unlock();
 }
 
 // Load the raw RGB data for the given frame index into currentFrameRawData.
@@ -608,7 +601,7 @@ void videoHandlerRGB::convertRGBToImage(const QByteArray &sourceBuffer, QImage &
     return;
   }
 
-  outputImage = QImage(curFrameSize, format);
+  outputImage = functionsGui::createPooledImage(curFrameSize, format);
 
   // Check the image buffer size before we write to it
 #if QT_VERSION < QT_VERSION_CHECK(5, 10, 0)
@@ -624,10 +617,10 @@ void videoHandlerRGB::convertRGBToImage(const QByteArray &sourceBuffer, QImage &
 
 void videoHandlerRGB::setSrcPixelFormat(const PixelFormatRGB &newFormat)
 {
-  this->rgbFormatMutex.lock();
+  this->rgbFormatLock.lockForWrite();
   this->srcPixelFormat = newFormat;
   this->updateControlsForNewPixelFormat();
-  this->rgbFormatMutex.unlock();
+  this->rgbFormatLock.unlock();
 }
 
 // Convert the data in "sourceBuffer" from the format "srcPixelFormat" to RGB 888. While doing so,
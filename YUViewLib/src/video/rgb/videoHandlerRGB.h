@@ -35,6 +35,8 @@
 #include <video/rgb/PixelFormatRGB.h>
 #include <video/videoHandler.h>
 
+#include <QReadWriteLock>
+
 #include "ui_videoHandlerRGB.h"
 
 namespace video::rgb
@@ -194,11 +196,10 @@ private:
   void       convertSourceToRGBA32Bit(const QByteArray &sourceBuffer,
                                       unsigned char *   targetBuffer,
                                       QImage::Format    imageFormat);
-  QByteArray tmpBufferRawRGBDataCaching;
-
-  // When a caching job is running in the background it will lock this mutex, so that
-  // the main thread does not change the RGB format while this is happening.
-  QMutex rgbFormatMutex;
+  // When a caching job is running in the background it will lock this for reading, so that
+  // the main thread does not change the RGB format while this is happening. Multiple caching jobs
+  // can run at the same time.
+  QReadWriteLock rgbFormatLock;
 
   SafeUi<Ui::videoHandlerRGB> ui;
 
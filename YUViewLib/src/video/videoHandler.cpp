@@ -33,6 +33,7 @@
 #include "videoHandler.h"
 
 #include <QPainter>
+#include <QSettings>
 
 #include <common/FunctionsGui.h>
 
@@ -49,6 +50,30 @@ namespace video
 
 videoHandler::videoHandler()
 {
+  QSettings settings;
+  this->cacheRawData = settings.value("VideoCache/CacheRawFrames", false).toBool();
+}
+
+bool videoHandler::isRawDataCacheActive() const
+{
+  return this->cacheRawData && this->supportsRawDataCaching();
+}
+
+void videoHandler::updateSettings()
+{
+  QSettings  settings;
+  const auto newCacheRawData = settings.value("VideoCache/CacheRawFrames", false).toBool();
+  if (newCacheRawData == this->cacheRawData)
+    return;
+
+  this->cacheRawData = newCacheRawData;
+  if (this->supportsRawDataCaching())
+  {
+    // Everything in the cache was cached in the other mode. Frames that are being cached right now
+    // would also end up in the wrong cache.
+    this->setCacheInvalid();
+    emit signalHandlerChanged(false, RECACHE_CLEAR);
+  }
 }
 
 void videoHandler::slotVideoControlChanged()
@@ -143,8 +168,8 @@ ItemLoadingState videoHandler::needsLoading(int frameIdx, bool loadRawValues)
     }
   }
 
-  // Check the cache
-  if (cacheValid && imageCache.contains(frameIdx))
+  // Check the cache. Frames from the raw data cache are converted when they are drawn.
+  if (cacheValid && (imageCache.contains(frameIdx) || rawDataCache.contains(frameIdx)))
   {
     // What about the next frame? Is it also in the cache or in the double buffer?
     if (doubleBufferImageFrameIndex == frameIdx + 1)
@@ -198,6 +223,19 @@ void videoHandler::drawFrame(QPainter *painter, int frameIdx, double zoomFactor,
         currentImageIndex = frameIdx;
         DEBUG_VIDEO("videoHandler::drawFrame %d loaded from cache", frameIdx);
       }
+      else if (cacheValid && rawDataCache.contains(frameIdx))
+      {
+        const auto rawData = rawDataCache[frameIdx];
+        lock.unlock();
+        auto newImage = this->convertRawDataToImage(rawData);
+        if (!newImage.isNull())
+        {
+          QMutexLocker imageLock(&currentImageSetMutex);
+          currentImage      = newImage;
+          currentImageIndex = frameIdx;
+          DEBUG_VIDEO("videoHandler::drawFrame %d converted from raw data cache", frameIdx);
+        }
+      }
     }
   }
 
@@ -211,7 +249,7 @@ void videoHandler::drawFrame(QPainter *painter, int frameIdx, double zoomFactor,
 
   // Draw the current image (currentImage)
   currentImageSetMutex.lock();
-  painter->drawImage(videoRect, currentImage);
+  this->drawCurrentImage(painter, videoRect);
   currentImageSetMutex.unlock();
 
   if (drawRawValues && zoomFactor >= SPLITVIEW_DRAW_VALUES_ZOOMFACTOR)
@@ -262,7 +300,7 @@ QRgb videoHandler::getPixelVal(int x, int y)
 int videoHandler::getNrFramesCached() const
 {
   QMutexLocker lock(&imageCacheAccess);
-  return imageCache.size();
+  return imageCache.size() + rawDataCache.size();
 }
 
 // Put the frame into the cache (if it is not already in there)
@@ -277,6 +315,22 @@ void videoHandler::cacheFrame(int frameIdx, bool testMode)
     return;
   }
 
+  if (this->isRawDataCacheActive())
+  {
+    QByteArray rawDataToCache;
+    if (!this->loadRawDataForCaching(frameIdx, rawDataToCache))
+    {
+      DEBUG_VIDEO("videoHandler::cacheFrame loading raw data of frame %i failed", frameIdx);
+      return;
+    }
+
+    DEBUG_VIDEO("videoHandler::cacheFrame insert raw data of frame %i into cache", frameIdx);
+    QMutexLocker imageCacheLock(&imageCacheAccess);
+    if (cacheValid && !testMode)
+      rawDataCache.insert(frameIdx, rawDataToCache);
+    return;
+  }
+
   // Load the frame. While this is happening in the background the frame size must not change.
   QImage cacheImage;
   loadFrameForCaching(frameIdx, cacheImage);
@@ -296,26 +350,26 @@ void videoHandler::cacheFrame(int frameIdx, bool testMode)
 unsigned videoHandler::getCachingFrameSize() const
 {
   const auto hasAlpha = false;
-  auto       bytes    = functionsGui::bytesPerPixel(functionsGui::platformImageFormat(hasAlpha));
-  return this->frameSize.width * this->frameSize.height * bytes;
+  const auto format = functionsGui::platformImageFormat(hasAlpha);
+  return unsigned(functionsGui::getPooledImageBytes(this->frameSize, format));
 }
 
 QList<int> videoHandler::getCachedFrames() const
 {
   QMutexLocker lock(&imageCacheAccess);
-  return imageCache.keys();
+  return imageCache.keys() + rawDataCache.keys();
 }
 
 int videoHandler::getNumberCachedFrames() const
 {
   QMutexLocker lock(&imageCacheAccess);
-  return imageCache.size();
+  return imageCache.size() + rawDataCache.size();
 }
 
 bool videoHandler::isInCache(int idx) const
 {
   QMutexLocker lock(&imageCacheAccess);
-  return imageCache.contains(idx);
+  return imageCache.contains(idx) || rawDataCache.contains(idx);
 }
 
 void videoHandler::removeFrameFromCache(int frameIdx)
@@ -323,6 +377,7 @@ void videoHandler::removeFrameFromCache(int frameIdx)
   DEBUG_VIDEO("removeFrameFromCache %d", frameIdx);
   QMutexLocker lock(&imageCacheAccess);
   imageCache.remove(frameIdx);
+  rawDataCache.remove(frameIdx);
   lock.unlock();
 }
 
@@ -331,6 +386,7 @@ void videoHandler::removeAllFrameFromCache()
   DEBUG_VIDEO("removeAllFrameFromCache");
   QMutexLocker lock(&imageCacheAccess);
   imageCache.clear();
+  rawDataCache.clear();
   cacheValid = true;
   lock.unlock();
 }
@@ -385,10 +441,34 @@ void videoHandler::loadFrameForCaching(int frameIndex, QImage &frameToCache)
   frameToCache = requestedFrame;
 }
 
+bool videoHandler::loadRawDataForCaching(int frameIndex, QByteArray &rawDataToCache)
+{
+  DEBUG_VIDEO("videoHandler::loadRawDataForCaching %d", frameIndex);
+
+  if (this->rawDataLoader)
+    return this->rawDataLoader(frameIndex, rawDataToCache);
+
+  QMutexLocker lock(&this->requestDataMutex);
+  emit signalRequestRawData(frameIndex, true);
+
+  if (frameIndex != this->rawData_frameIndex || this->rawData.isEmpty())
+    // Loading failed
+    return false;
+
+  rawDataToCache = this->rawData;
+  return true;
+}
+
+QImage videoHandler::convertRawDataToImage(const QByteArray &) const
+{
+  return {};
+}
+
 void videoHandler::invalidateAllBuffers()
 {
   currentFrameRawData_frameIndex = -1;
-  rawData_frameIndex             = -1;
+  currentFrameRawData.clear();
+  rawData_frameIndex = -1;
 
   // Set the current frame in the buffer to be invalid
   currentImageIndex       = -1;
@@ -399,6 +479,7 @@ void videoHandler::invalidateAllBuffers()
   requestedFrame_idx = -1;
 
   imageCache.clear();
+  rawDataCache.clear();
   cacheValid = true;
 }
 
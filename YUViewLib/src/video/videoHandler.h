@@ -39,6 +39,8 @@
 #include <QFileInfo>
 #include <QMutex>
 
+#include <functional>
+
 namespace video
 {
 
@@ -66,10 +68,26 @@ public:
   virtual void     removeFrameFromCache(int frameIndex);
   virtual void     removeAllFrameFromCache();
 
+  // Load the raw data of the given frame for caching into rawDataToCache. If a rawDataLoader is
+  // set, it is used directly. Otherwise signalRequestRawData is emitted and the data is copied
+  // from rawData (one thread at a time). Return false if loading failed. This is called from a
+  // background thread (also by the difference handler that caches the difference of two items).
+  virtual bool loadRawDataForCaching(int frameIndex, QByteArray &rawDataToCache);
+
   // Get the number of bytes for one frame (RGB or YUV) with the current format (if this video
   // handler uses raw data)
   virtual int64_t getBytesPerFrame() const { return -1; }
 
+  // Can this handler cache the raw data of frames instead of the converted images? If it can and
+  // raw data caching is enabled in the settings, the raw data is cached and only converted when
+  // a frame is drawn. This uses less memory and changing the conversion settings does not
+  // invalidate the cache.
+  virtual bool supportsRawDataCaching() const { return false; }
+  bool         isRawDataCacheActive() const;
+
+  // Read the settings (raw data caching). If the caching mode changes, the cache is cleared.
+  virtual void updateSettings();
+
   // The Frame size is about to change. If this happens, our local buffers all need updating.
   virtual void setFrameSize(Size size) override;
 
@@ -144,6 +162,13 @@ public:
   // up to date for the given frame index
   virtual ItemLoadingState needsLoadingRawValues(int frameIndex);
 
+  // Some sources can load the raw data of any frame into a given buffer from multiple threads at
+  // the same time (e.g. a raw file). Such a source can set a loader function which is then used
+  // for caching instead of signalRequestRawData. The caching threads do not have to share the
+  // rawData buffer (and the requestDataMutex) then. The function must be thread safe.
+  using RawDataLoader = std::function<bool(int frameIndex, QByteArray &targetBuffer)>;
+  void setRawDataLoader(RawDataLoader loader) { this->rawDataLoader = loader; }
+
 signals:
 
   // The video handler requests a certain frame to be loaded. After this signal is emitted, the
@@ -173,9 +198,14 @@ protected:
   // background thread.
   virtual void loadFrameForCaching(int frameIndex, QImage &frameToCache);
 
+  // Convert raw data (from the raw data cache) to an image using the current settings.
+  virtual QImage convertRawDataToImage(const QByteArray &rawData) const;
+
   // Only one thread at a time should request something to be loaded.
   QMutex requestDataMutex;
 
+  RawDataLoader rawDataLoader;
+
   // We might need to update the currentImage
   int currentImage_frameIndex{-1};
 
@@ -198,6 +228,10 @@ protected:
   // --- Caching
   QMutex mutable imageCacheAccess;
   QMap<int, QImage> imageCache;
+  // If raw data caching is active, the raw frame data is cached here instead of the images in
+  // imageCache. Only one of the two is used at a time.
+  QMap<int, QByteArray> rawDataCache;
+  bool                  cacheRawData{false};
   // Is the cache valid? The cache can be ivalid in the following scenario:
   // Somethign about how an item is shown changes (e.g. the resolution) but caching of the item is
   // currently performed. If we just cleared the cache, the wrong (currently being cached) frames
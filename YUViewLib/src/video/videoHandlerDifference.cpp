@@ -81,6 +81,11 @@ void videoHandlerDifference::drawDifferenceFrame(QPainter *painter,
       {
         currentImage      = imageCache[frameIdx];
         currentImageIndex = frameIdx;
+
+        const auto info                 = this->differenceInfoCache.value(frameIdx);
+        this->differenceInfoList        = info.infoList;
+        this->firstDifferenceCalculated = true;
+        this->firstDifference           = info.firstDifference;
         DEBUG_VIDEO("videoHandler::drawFrame %d loaded from cache", frameIdx);
       }
     }
@@ -93,7 +98,7 @@ void videoHandlerDifference::drawDifferenceFrame(QPainter *painter,
 
   // Draw the current image (currentImage)
   currentImageSetMutex.lock();
-  painter->drawImage(videoRect, currentImage);
+  this->drawCurrentImage(painter, videoRect);
   currentImageSetMutex.unlock();
 
   if (drawRawValues && zoomFactor >= SPLITVIEW_DRAW_VALUES_ZOOMFACTOR)
@@ -127,6 +132,12 @@ void videoHandlerDifference::loadFrameDifference(int frameIndex, bool)
                                                        amplificationFactor,
                                                        markDifference);
 
+  // If the difference was calculated from the YUV values, we also got the first difference.
+  auto videoYUV0                  = dynamic_cast<yuv::videoHandlerYUV *>(inputVideo[0].data());
+  this->firstDifferenceCalculated = (videoYUV0 != nullptr && videoYUV0->isDiffReady());
+  this->firstDifference =
+      this->firstDifferenceCalculated ? videoYUV0->getDiffFirstDifference() : std::nullopt;
+
   if (!newFrame.isNull())
   {
     // The new difference frame is ready
@@ -229,9 +240,10 @@ void videoHandlerDifference::slotDifferenceControlChanged()
     markDifference = ui.markDifferenceCheckBox->isChecked();
 
     // Set the current frame in the buffer to be invalid and emit the signal that something has
-    // changed
+    // changed. The cached difference images are also invalid.
     currentImageIndex = -1;
-    emit signalHandlerChanged(true, RECACHE_NONE);
+    setCacheInvalid();
+    emit signalHandlerChanged(true, RECACHE_CLEAR);
   }
   else if (sender == ui.codingOrderComboBox)
   {
@@ -245,9 +257,10 @@ void videoHandlerDifference::slotDifferenceControlChanged()
     amplificationFactor = ui.amplificationFactorSpinBox->value();
 
     // Set the current frame in the buffer to be invalid and emit the signal that something has
-    // changed
+    // changed. The cached difference images are also invalid.
     currentImageIndex = -1;
-    emit signalHandlerChanged(true, RECACHE_NONE);
+    setCacheInvalid();
+    emit signalHandlerChanged(true, RECACHE_CLEAR);
   }
 }
 
@@ -270,36 +283,27 @@ void videoHandlerDifference::reportFirstDifferencePosition(QList<InfoItem> &info
     int widthLCU  = (frameSize.width + 63) / 64; // Round up
     int heightLCU = (frameSize.height + 63) / 64;
 
-    for (int y = 0; y < heightLCU; y++)
+    if (this->firstDifferenceCalculated)
     {
-      for (int x = 0; x < widthLCU; x++)
+      // The first difference was found while calculating the difference from the YUV values. This
+      // also works for small differences in high bit depth videos which vanish in the 8 bit image.
+      if (this->firstDifference)
       {
-        // Now take the tree approach
-        int firstX, firstY, partIndex = 0;
-
-        auto videoYUV0 = dynamic_cast<yuv::videoHandlerYUV *>(inputVideo[0].data());
-        if (videoYUV0 != NULL && videoYUV0->isDiffReady())
-        {
-          // find first difference using YUV instead of QImage. The latter does not work for 10bit
-          // videos and very small differences, since it only supports 8bit
-          if (hierarchicalPositionYUV(x * 64,
-                                      y * 64,
-                                      64,
-                                      firstX,
-                                      firstY,
-                                      partIndex,
-                                      videoYUV0->getDiffYUV(),
-                                      videoYUV0->getDiffYUVFormat()))
-          {
-            // We found a difference in this block
-            infoList.append(InfoItem("First diff LCU", QString::number(y * widthLCU + x)));
-            infoList.append(InfoItem("First diff X,Y", QString("%1,%2").arg(firstX).arg(firstY)));
-            infoList.append(InfoItem("First diff partIndex", QString::number(partIndex)));
-            return;
-          }
-        }
-        else
+        const auto &diff = *this->firstDifference;
+        infoList.append(InfoItem("First diff LCU", QString::number(diff.ctuIndex)));
+        infoList.append(InfoItem("First diff X,Y", QString("%1,%2").arg(diff.x).arg(diff.y)));
+        infoList.append(InfoItem("First diff partIndex", QString::number(diff.partIndex)));
+        return;
+      }
+    }
+    else
+    {
+      for (int y = 0; y < heightLCU; y++)
+      {
+        for (int x = 0; x < widthLCU; x++)
         {
+          // Now take the tree approach
+          int firstX, firstY, partIndex = 0;
           if (hierarchicalPosition(x * 64, y * 64, 64, firstX, firstY, partIndex, currentImage))
           {
             // We found a difference in this block
@@ -339,6 +343,65 @@ void videoHandlerDifference::loadPlaylist(const YUViewDomElement &element)
     this->markDifference = true;
 }
 
+bool videoHandlerDifference::isDifferenceCachable() const
+{
+  if (!inputsValid())
+    return false;
+
+  auto videoYUV0 = dynamic_cast<const yuv::videoHandlerYUV *>(inputVideo[0].data());
+  auto videoYUV1 = dynamic_cast<const yuv::videoHandlerYUV *>(inputVideo[1].data());
+  return videoYUV0 != nullptr && videoYUV1 != nullptr &&
+         videoYUV0->isDifferenceYUVSupported(videoYUV1);
+}
+
+void videoHandlerDifference::removeFrameFromCache(int frameIndex)
+{
+  videoHandler::removeFrameFromCache(frameIndex);
+  QMutexLocker lock(&imageCacheAccess);
+  this->differenceInfoCache.remove(frameIndex);
+}
+
+void videoHandlerDifference::removeAllFrameFromCache()
+{
+  videoHandler::removeAllFrameFromCache();
+  QMutexLocker lock(&imageCacheAccess);
+  this->differenceInfoCache.clear();
+}
+
+void videoHandlerDifference::loadFrameForCaching(int frameIndex, QImage &frameToCache)
+{
+  DEBUG_VIDEO("videoHandlerDifference::loadFrameForCaching %d", frameIndex);
+
+  if (!this->isDifferenceCachable())
+    return;
+
+  auto videoYUV0 = dynamic_cast<yuv::videoHandlerYUV *>(inputVideo[0].data());
+  auto videoYUV1 = dynamic_cast<yuv::videoHandlerYUV *>(inputVideo[1].data());
+
+  // Load the raw data of both inputs. This does not touch the current buffers of the inputs.
+  QByteArray rawData[2];
+  if (!videoYUV0->loadRawDataForCaching(frameIndex, rawData[0]) ||
+      !videoYUV1->loadRawDataForCaching(frameIndex, rawData[1]))
+  {
+    DEBUG_VIDEO("videoHandlerDifference::loadFrameForCaching loading failed");
+    return;
+  }
+
+  CachedDifferenceInfo info;
+  frameToCache = videoYUV0->calculateDifferenceFromRawData(rawData[0],
+                                                           videoYUV1,
+                                                           rawData[1],
+                                                           info.infoList,
+                                                           this->amplificationFactor,
+                                                           this->markDifference,
+                                                           info.firstDifference);
+  if (frameToCache.isNull())
+    return;
+
+  QMutexLocker lock(&imageCacheAccess);
+  this->differenceInfoCache.insert(frameIndex, info);
+}
+
 ItemLoadingState videoHandlerDifference::needsLoadingRawValues(int frameIndex)
 {
   if (auto video = dynamic_cast<videoHandler *>(inputVideo[0].data()))
@@ -424,137 +487,4 @@ bool videoHandlerDifference::hierarchicalPosition(int           x,
   return false;
 }
 
-inline int
-getValueFromSource(const unsigned char *src, const int idx, const int bps, const bool bigEndian)
-{
-  if (bps > 8)
-    // Read two bytes in the right order
-    return (bigEndian) ? src[idx * 2] << 8 | src[idx * 2 + 1]
-                       : src[idx * 2] | src[idx * 2 + 1] << 8;
-  else
-    // Just read one byte
-    return src[idx];
-}
-
-bool videoHandlerDifference::hierarchicalPositionYUV(int                        x,
-                                                     int                        y,
-                                                     int                        blockSize,
-                                                     int                       &firstX,
-                                                     int                       &firstY,
-                                                     int                       &partIndex,
-                                                     const QByteArray          &diffYUV,
-                                                     const yuv::PixelFormatYUV &diffYUVFormat) const
-{
-  if (x >= int(frameSize.width) || y >= int(frameSize.height))
-    // This block is entirely outside of the picture
-    return false;
-
-  // The items can be of different size (we then calculate the difference of the top left aligned
-  // part)
-  const int w_in = frameSize.width;
-  const int h_in = frameSize.height;
-
-  // Get subsampling modes (they are identical for both inputs and the output)
-  const int subH = diffYUVFormat.getSubsamplingHor();
-  const int subV = diffYUVFormat.getSubsamplingVer();
-
-  // Get the endianness of the inputs
-  const bool bigEndian = diffYUVFormat.isBigEndian();
-
-  // Get/Set the bit depth of the input
-  const int bps_in   = diffYUVFormat.getBitsPerSample();
-  const int diffZero = 128 << (bps_in - 8);
-
-  // Get pointers to the inputs
-  const int componentSizeLuma_In   = w_in * h_in;
-  const int componentSizeChroma_In = (w_in / subH) * (h_in / subV);
-  const int nrBytesLumaPlane_In    = bps_in > 8 ? 2 * componentSizeLuma_In : componentSizeLuma_In;
-  const int nrBytesChromaPlane_In =
-      bps_in > 8 ? 2 * componentSizeChroma_In : componentSizeChroma_In;
-  // Current item
-
-  // Calculate Luma sample difference
-  const int stride_in = bps_in > 8 ? w_in * 2 : w_in; // How many bytes to the next y line?
-  const int strideC_in =
-      w_in / subH * (bps_in > 8 ? 2 : 1); // How many bytes to the next U/V y line
-
-  if (blockSize == 4)
-  {
-    const unsigned char *srcY1 = (unsigned char *)diffYUV.data();
-    const unsigned char *srcU1 = (diffYUVFormat.getPlaneOrder() == yuv::PlaneOrder::YUV ||
-                                  diffYUVFormat.getPlaneOrder() == yuv::PlaneOrder::YUVA)
-                                     ? srcY1 + nrBytesLumaPlane_In
-                                     : srcY1 + nrBytesLumaPlane_In + nrBytesChromaPlane_In;
-    const unsigned char *srcV1 = (diffYUVFormat.getPlaneOrder() == yuv::PlaneOrder::YUV ||
-                                  diffYUVFormat.getPlaneOrder() == yuv::PlaneOrder::YUVA)
-                                     ? srcY1 + nrBytesLumaPlane_In + nrBytesChromaPlane_In
-                                     : srcY1 + nrBytesLumaPlane_In;
-
-    // adjust source pointer according to block position
-    srcY1 += y * stride_in;
-    srcU1 += y / subV * strideC_in;
-    srcV1 += y / subV * strideC_in;
-
-    // Check for a difference
-    for (int subY = y; subY < y + 4; subY++)
-    {
-
-      for (int subX = x; subX < x + 4; subX++)
-      {
-
-        int val1 = getValueFromSource(srcY1, subX, bps_in, bigEndian);
-        if (val1 != diffZero)
-        {
-          firstX = x;
-          firstY = y;
-          return true;
-        }
-
-        // is this a position at which we have a chroma sample?
-        if (subX % subH == 0 && subY % subV == 0 && subX * subV < w_in)
-        {
-          int valU1 = getValueFromSource(srcU1, subX, bps_in, bigEndian);
-          int valV1 = getValueFromSource(srcV1, subX, bps_in, bigEndian);
-          if (valU1 != diffZero || valV1 != diffZero)
-          {
-            firstX = x * subV;
-            firstY = y;
-            return true;
-          }
-        }
-      }
-
-      // Goto the next y line
-      srcY1 += stride_in;
-
-      // is this a position at which we have a chroma line?
-      if (subY % subV == 0)
-      {
-        // Goto the next y line
-        srcU1 += strideC_in;
-        srcV1 += strideC_in;
-      }
-    }
-
-    // No difference found in this block. Count the number of 4x4 blocks scanned (that is the
-    // partIndex)
-    partIndex++;
-  }
-  else
-  {
-    // Walk further into the hierarchy
-    const int b2 = blockSize / 2;
-    if (hierarchicalPositionYUV(x, y, b2, firstX, firstY, partIndex, diffYUV, diffYUVFormat))
-      return true;
-    if (hierarchicalPositionYUV(x + b2, y, b2, firstX, firstY, partIndex, diffYUV, diffYUVFormat))
-      return true;
-    if (hierarchicalPositionYUV(x, y + b2, b2, firstX, firstY, partIndex, diffYUV, diffYUVFormat))
-      return true;
-    if (hierarchicalPositionYUV(
-            x + b2, y + b2, b2, firstX, firstY, partIndex, diffYUV, diffYUVFormat))
-      return true;
-  }
-  return false;
-}
-
 } // namespace video
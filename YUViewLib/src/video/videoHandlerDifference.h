@@ -83,6 +83,12 @@ public:
   // Calculate the position of the first difference and add the info to the list
   void reportFirstDifferencePosition(QList<InfoItem> &infoList) const;
 
+  // The difference can be cached if it is calculated from the YUV values of two YUV items. The
+  // info of the cached frames (MSE/PSNR and the first difference) is cached with the images.
+  bool isDifferenceCachable() const;
+  void removeFrameFromCache(int frameIndex) override;
+  void removeAllFrameFromCache() override;
+
   virtual void savePlaylist(YUViewDomElement &root) const override;
   virtual void loadPlaylist(const YUViewDomElement &root) override;
 
@@ -92,6 +98,9 @@ private slots:
 protected:
   ItemLoadingState needsLoadingRawValues(int frameIndex) override;
 
+  // Calculate the difference of the given frame of the two YUV inputs for caching.
+  void loadFrameForCaching(int frameIndex, QImage &frameToCache) override;
+
   bool markDifference{}; // Mark differences?
   int  amplificationFactor{1};
 
@@ -105,6 +114,20 @@ private:
   // The two videos that the difference will be calculated from
   QPointer<FrameHandler> inputVideo[2];
 
+  // If the difference of the current frame was calculated from the YUV values, the position of the
+  // first difference was found while calculating the difference. Otherwise it is searched in the
+  // difference image.
+  bool                                firstDifferenceCalculated{};
+  std::optional<yuv::FirstDifference> firstDifference;
+
+  struct CachedDifferenceInfo
+  {
+    QList<InfoItem>                     infoList;
+    std::optional<yuv::FirstDifference> firstDifference;
+  };
+  // The info for all frames in the imageCache (protected by the imageCacheAccess mutex)
+  QMap<int, CachedDifferenceInfo> differenceInfoCache;
+
   // Recursively scan the LCU
   bool hierarchicalPosition(int           x,
                             int           y,
@@ -113,14 +136,6 @@ private:
                             int &         firstY,
                             int &         partIndex,
                             const QImage &diffImg) const;
-  bool hierarchicalPositionYUV(int                        x,
-                               int                        y,
-                               int                        blockSize,
-                               int &                      firstX,
-                               int &                      firstY,
-                               int &                      partIndex,
-                               const QByteArray &         diffYUV,
-                               const yuv::PixelFormatYUV &diffYUVFormat) const;
 
   SafeUi<Ui::videoHandlerDifference> ui;
 };
@@ -49,21 +49,48 @@ namespace video
 #define DEBUG_RESAMPLE(fmt, ...) ((void)0)
 #endif
 
-videoHandlerResample::videoHandlerResample() : videoHandler()
+namespace
+{
+
+QStringPairList getYUVPixelValues(const QByteArray          &rawData,
+                                  const yuv::PixelFormatYUV &format,
+                                  const Size                &frameSize,
+                                  const QPoint              &pixelPos,
+                                  const int                  formatBase)
 {
+  if (rawData.size() < format.bytesPerFrame(frameSize))
+    return {};
+
+  auto getValue = [&](const unsigned planeIndex, const int subsamplingX, const int subsamplingY) {
+    const auto layout = yuv::getPlaneLayout(format, frameSize, planeIndex);
+    const auto line   = reinterpret_cast<const unsigned char *>(rawData.constData()) +
+                      layout.offset + (pixelPos.y() / subsamplingY) * layout.stride;
+    const auto value = yuv::getValueFromSource(
+        line, pixelPos.x() / subsamplingX, format.getBitsPerSample(), format.isBigEndian());
+    return QString::number(value, formatBase);
+  };
+
+  QStringPairList values;
+  values.append(QStringPair("Y", getValue(0, 1, 1)));
+  if (format.getSubsampling() != yuv::Subsampling::YUV_400)
+  {
+    const auto subsamplingHor = format.getSubsamplingHor();
+    const auto subsamplingVer = format.getSubsamplingVer();
+    values.append(QStringPair("U", getValue(1, subsamplingHor, subsamplingVer)));
+    values.append(QStringPair("V", getValue(2, subsamplingHor, subsamplingVer)));
+  }
+  if (format.hasAlpha())
+    values.append(QStringPair("A", getValue(3, 1, 1)));
+  return values;
 }
 
-void videoHandlerResample::drawFrame(QPainter *painter,
-                                     int       frameIndex,
-                                     double    zoomFactor,
-                                     bool      drawRawValues)
+} // namespace
+
+videoHandlerResample::videoHandlerResample() : videoHandler()
 {
-  auto mappedIndex = this->mapFrameIndex(frameIndex);
-  DEBUG_RESAMPLE("videoHandlerResample::drawFrame idx %d", mappedIndex);
-  videoHandler::drawFrame(painter, mappedIndex, zoomFactor, drawRawValues);
 }
 
-QImage videoHandlerResample::calculateDifference(FrameHandler *   item2,
+QImage videoHandlerResample::calculateDifference(FrameHandler    *item2,
                                                  const int        frameIndex0,
                                                  const int        frameIndex1,
                                                  QList<InfoItem> &differenceInfoList,
@@ -73,15 +100,39 @@ QImage videoHandlerResample::calculateDifference(FrameHandler *   item2,
   if (!this->inputValid())
     return {};
 
-  auto mappedIndex = this->mapFrameIndex(frameIndex0);
+  if (this->currentImageIndex != frameIndex0)
+    this->loadResampledFrame(frameIndex0);
   return videoHandler::calculateDifference(
-      item2, mappedIndex, frameIndex1, differenceInfoList, amplificationFactor, markDifference);
+      item2, frameIndex0, frameIndex1, differenceInfoList, amplificationFactor, markDifference);
 }
 
-ItemLoadingState videoHandlerResample::needsLoading(int frameIndex, bool loadRawValues)
+QStringPairList videoHandlerResample::getPixelValues(const QPoint &pixelPos,
+                                                     int           frameIndex,
+                                                     FrameHandler *item2,
+                                                     const int     frameIndex1)
 {
-  auto mappedIndex = this->mapFrameIndex(frameIndex);
-  return videoHandler::needsLoading(mappedIndex, loadRawValues);
+  auto videoYUV = dynamic_cast<yuv::videoHandlerYUV *>(this->inputVideo.data());
+  if (item2 != nullptr || videoYUV == nullptr)
+    return videoHandler::getPixelValues(pixelPos, frameIndex, item2, frameIndex1);
+
+  if (pixelPos.x() < 0 || pixelPos.x() >= int(this->frameSize.width) || pixelPos.y() < 0 ||
+      pixelPos.y() >= int(this->frameSize.height))
+    return {};
+
+  QMutexLocker lock(&this->currentImageSetMutex);
+  if (this->currentFrameRawData_frameIndex != frameIndex || this->currentFrameRawData.isEmpty())
+  {
+    // The frame was not resampled from the YUV values (or is not loaded yet)
+    lock.unlock();
+    return videoHandler::getPixelValues(pixelPos, frameIndex, item2, frameIndex1);
+  }
+
+  const int formatBase = this->settings.value("ShowPixelValuesHex").toBool() ? 16 : 10;
+  return getYUVPixelValues(this->currentFrameRawData,
+                           videoYUV->getPixelFormatYUV(),
+                           this->frameSize,
+                           pixelPos,
+                           formatBase);
 }
 
 void videoHandlerResample::loadResampledFrame(int frameIndex, bool loadToDoubleBuffer)
@@ -91,17 +142,35 @@ void videoHandlerResample::loadResampledFrame(int frameIndex, bool loadToDoubleB
 
   auto mappedIndex = this->mapFrameIndex(frameIndex);
 
-  auto video = dynamic_cast<videoHandler *>(this->inputVideo.data());
-  if (video && video->getCurrentImageIndex() != mappedIndex)
-    video->loadFrame(mappedIndex);
+  QImage     newFrame;
+  QByteArray resampledRawData;
 
-  auto interpolationMode = (this->interpolation == Interpolation::Bilinear)
-                               ? Qt::SmoothTransformation
-                               : Qt::FastTransformation;
+  if (this->isResamplingYUV())
+  {
+    // Resample the raw YUV data. The current buffers of the input are not touched by this.
+    auto       videoYUV = dynamic_cast<yuv::videoHandlerYUV *>(this->inputVideo.data());
+    QByteArray rawData;
+    if (videoYUV->loadRawDataForCaching(mappedIndex, rawData))
+      newFrame = videoYUV->resampleRawData(
+          rawData, this->getFrameSize(), this->getResampleFilter(), resampledRawData);
+  }
 
-  auto qFrameSize = QSize(this->getFrameSize().width, this->getFrameSize().height);
-  auto newFrame   = this->inputVideo->getCurrentFrameAsImage().scaled(
-      qFrameSize, Qt::IgnoreAspectRatio, interpolationMode);
+  if (newFrame.isNull())
+  {
+    // Resample the RGB image of the input
+    auto video = dynamic_cast<videoHandler *>(this->inputVideo.data());
+    if (video && video->getCurrentImageIndex() != mappedIndex)
+      video->loadFrame(mappedIndex);
+
+    auto interpolationMode = (this->interpolation == Interpolation::Fast)
+                                 ? Qt::FastTransformation
+                                 : Qt::SmoothTransformation;
+
+    auto qFrameSize = QSize(this->getFrameSize().width, this->getFrameSize().height);
+    newFrame        = this->inputVideo->getCurrentFrameAsImage().scaled(
+        qFrameSize, Qt::IgnoreAspectRatio, interpolationMode);
+    resampledRawData.clear();
+  }
 
   if (newFrame.isNull())
     return;
@@ -109,19 +178,42 @@ void videoHandlerResample::loadResampledFrame(int frameIndex, bool loadToDoubleB
   if (loadToDoubleBuffer)
   {
     doubleBufferImage           = newFrame;
-    doubleBufferImageFrameIndex = mappedIndex;
+    doubleBufferImageFrameIndex = frameIndex;
     DEBUG_RESAMPLE("videoHandlerResample::loadResampledFrame Loaded frame %d to double buffer",
-                   mappedIndex);
+                   frameIndex);
   }
   else
   {
     // The new difference frame is ready
     QMutexLocker lock(&this->currentImageSetMutex);
-    currentImage      = newFrame;
-    currentImageIndex = mappedIndex;
+    currentImage                   = newFrame;
+    currentImageIndex              = frameIndex;
+    currentFrameRawData            = resampledRawData;
+    currentFrameRawData_frameIndex = frameIndex;
     DEBUG_RESAMPLE("videoHandlerResample::loadResampledFrame Loaded frame %d to current buffer",
-                   mappedIndex);
+                   frameIndex);
+  }
+}
+
+void videoHandlerResample::loadFrameForCaching(int frameIndex, QImage &frameToCache)
+{
+  DEBUG_RESAMPLE("videoHandlerResample::loadFrameForCaching %d", frameIndex);
+
+  if (!this->isResamplingYUV())
+    return;
+
+  auto videoYUV = dynamic_cast<yuv::videoHandlerYUV *>(this->inputVideo.data());
+
+  QByteArray rawData;
+  if (!videoYUV->loadRawDataForCaching(this->mapFrameIndex(frameIndex), rawData))
+  {
+    DEBUG_RESAMPLE("videoHandlerResample::loadFrameForCaching loading failed");
+    return;
   }
+
+  QByteArray resampledRawData;
+  frameToCache = videoYUV->resampleRawData(
+      rawData, this->getFrameSize(), this->getResampleFilter(), resampledRawData);
 }
 
 bool videoHandlerResample::inputValid() const
@@ -129,6 +221,15 @@ bool videoHandlerResample::inputValid() const
   return (!this->inputVideo.isNull() && this->inputVideo->isFormatValid());
 }
 
+bool videoHandlerResample::isResamplingYUV() const
+{
+  if (!this->inputValid())
+    return false;
+
+  auto videoYUV = dynamic_cast<const yuv::videoHandlerYUV *>(this->inputVideo.data());
+  return videoYUV != nullptr && videoYUV->isResamplingSupported(this->getFrameSize());
+}
+
 void videoHandlerResample::setInputVideo(FrameHandler *childVideo)
 {
   if (this->inputVideo == childVideo)
@@ -151,14 +252,14 @@ void videoHandlerResample::setScaledSize(Size scaledSize)
   this->scaledSize = scaledSize;
   this->setFrameSize(scaledSize);
 
-  this->invalidateAllBuffers();
+  this->invalidateResampledFrames();
   emit signalHandlerChanged(true, RECACHE_CLEAR);
 }
 
 void videoHandlerResample::setInterpolation(Interpolation interpolation)
 {
   this->interpolation = interpolation;
-  this->invalidateAllBuffers();
+  this->invalidateResampledFrames();
   emit signalHandlerChanged(true, RECACHE_CLEAR);
 }
 
@@ -170,7 +271,7 @@ void videoHandlerResample::setCutAndSample(indexRange startEnd, int sampling)
   this->cutRange = startEnd;
   this->sampling = sampling;
 
-  this->invalidateAllBuffers();
+  this->invalidateResampledFrames();
   emit signalHandlerChanged(true, RECACHE_CLEAR);
 }
 
@@ -180,7 +281,7 @@ void videoHandlerResample::setFormatFromSizeAndName(
   assert(false);
 }
 
-int videoHandlerResample::mapFrameIndex(int frameIndex)
+int videoHandlerResample::mapFrameIndex(int frameIndex) const
 {
   auto mappedIndex = (frameIndex * this->sampling) + this->cutRange.first;
   DEBUG_RESAMPLE(
@@ -188,4 +289,28 @@ int videoHandlerResample::mapFrameIndex(int frameIndex)
   return mappedIndex;
 }
 
+void videoHandlerResample::invalidateResampledFrames()
+{
+  this->invalidateAllBuffers();
+  this->doubleBufferImageFrameIndex = -1;
+  // Frames that are currently being cached were resampled with the old parameters
+  this->setCacheInvalid();
+}
+
+yuv::ResampleFilter videoHandlerResample::getResampleFilter() const
+{
+  switch (this->interpolation)
+  {
+  case Interpolation::Fast:
+    return yuv::ResampleFilter::Nearest;
+  case Interpolation::Bicubic:
+    return yuv::ResampleFilter::Bicubic;
+  case Interpolation::Lanczos:
+    return yuv::ResampleFilter::Lanczos3;
+  case Interpolation::Bilinear:
+    break;
+  }
+  return yuv::ResampleFilter::Bilinear;
+}
+
 } // namespace video
@@ -47,27 +47,40 @@ class videoHandlerResample : public videoHandler
   Q_OBJECT
 
 public:
+  // The order corresponds to the entries in the interpolation combo box
   enum class Interpolation
   {
     Bilinear,
-    Fast
+    Fast,
+    Bicubic,
+    Lanczos
   };
 
   explicit videoHandlerResample();
 
-  // We need to override these videoHandler functions in order to map the frameIndex
-  void drawFrame(QPainter *painter, int frameIndex, double zoomFactor, bool drawRawValues) override;
-  QImage           calculateDifference(FrameHandler *   item2,
-                                       const int        frameIndex0,
-                                       const int        frameIndex1,
-                                       QList<InfoItem> &differenceInfoList,
-                                       const int        amplificationFactor,
-                                       const bool       markDifference) override;
-  ItemLoadingState needsLoading(int frameIndex, bool loadRawValues) override;
+  // The buffers and the cache of this handler use the frame indices of the resampled video. Only
+  // the loading functions map the frame index to the input video.
+  QImage calculateDifference(FrameHandler    *item2,
+                             const int        frameIndex0,
+                             const int        frameIndex1,
+                             QList<InfoItem> &differenceInfoList,
+                             const int        amplificationFactor,
+                             const bool       markDifference) override;
+
+  // If the input is a YUV video, the resampled YUV values are returned. Otherwise the RGB values of
+  // the resampled image are returned.
+  QStringPairList getPixelValues(const QPoint &pixelPos,
+                                 int           frameIndex,
+                                 FrameHandler *item2       = nullptr,
+                                 const int     frameIndex1 = 0) override;
 
   void loadResampledFrame(int frameIndex, bool loadToDoubleBuffer = false);
   bool inputValid() const;
 
+  // Is the raw YUV data of the input resampled? In this case, the bit depth of the input is
+  // preserved and the resampled frames can be cached.
+  bool isResamplingYUV() const;
+
   // Set the video input. This will also update the number frames, the controls and the frame size.
   // The signal signalHandlerChanged will be emitted if a redraw is required.
   void setInputVideo(FrameHandler *childVideo);
@@ -84,8 +97,17 @@ public:
 
   QList<InfoItem> resampleInfoList;
 
+protected:
+  // Resample the given frame of the YUV input for caching.
+  void loadFrameForCaching(int frameIndex, QImage &frameToCache) override;
+
 private:
-  int mapFrameIndex(int frameIndex);
+  int mapFrameIndex(int frameIndex) const;
+
+  // Invalidate all buffers and the cache after a change of the resampling parameters
+  void invalidateResampledFrames();
+
+  yuv::ResampleFilter getResampleFilter() const;
 
   // The input video we will resample
   QPointer<FrameHandler> inputVideo;
@@ -0,0 +1,1645 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ConversionYUV.h"
+
+#include <video/LimitedRangeToFullRange.h>
+#include <video/yuv/ConversionYUVSIMD.h>
+
+namespace video::yuv
+{
+
+// Restrict is basically a promise to the compiler that for the scope of the pointer, the target of
+// the pointer will only be accessed through that pointer (and pointers copied from it).
+#if __STDC__ != 1
+#define restrict __restrict /* use implementation __ format */
+#else
+#ifndef __STDC_VERSION__
+#define restrict __restrict /* use implementation __ format */
+#else
+#if __STDC_VERSION__ < 199901L
+#define restrict __restrict /* use implementation __ format */
+#else
+#/* all ok */
+#endif
+#endif
+#endif
+
+namespace
+{
+
+inline int clip8Bit(int val)
+{
+  if (val < 0)
+    return 0;
+  if (val > 255)
+    return 255;
+  return val;
+}
+
+inline void convertYUVToRGB8Bit(const unsigned int valY,
+                                const unsigned int valU,
+                                const unsigned int valV,
+                                int               &valR,
+                                int               &valG,
+                                int               &valB,
+                                const int          RGBConv[5],
+                                const bool         fullRange,
+                                const int          bps)
+{
+  if (bps > 14)
+  {
+    // The bit depth of an int (32) is not enough to perform a YUV -> RGB conversion for a bit depth
+    // > 14 bits. We could use 64 bit values but for what? We are clipping the result to 8 bit
+    // anyways so let's just get rid of 2 of the bits for the YUV values.
+    const int yOffset = (fullRange ? 0 : 16 << (bps - 10));
+    const int cZero   = 128 << (bps - 10);
+
+    const int Y_tmp = ((valY >> 2) - yOffset) * RGBConv[0];
+    const int U_tmp = (valU >> 2) - cZero;
+    const int V_tmp = (valV >> 2) - cZero;
+
+    const int R_tmp = (Y_tmp + V_tmp * RGBConv[1]) >>
+                      (16 + bps - 10); // 32 to 16 bit conversion by right shifting
+    const int G_tmp = (Y_tmp + U_tmp * RGBConv[2] + V_tmp * RGBConv[3]) >> (16 + bps - 10);
+    const int B_tmp = (Y_tmp + U_tmp * RGBConv[4]) >> (16 + bps - 10);
+
+    valR = (R_tmp < 0) ? 0 : (R_tmp > 255) ? 255 : R_tmp;
+    valG = (G_tmp < 0) ? 0 : (G_tmp > 255) ? 255 : G_tmp;
+    valB = (B_tmp < 0) ? 0 : (B_tmp > 255) ? 255 : B_tmp;
+  }
+  else
+  {
+    const int yOffset = (fullRange ? 0 : 16 << (bps - 8));
+    const int cZero   = 128 << (bps - 8);
+
+    const int Y_tmp = (valY - yOffset) * RGBConv[0];
+    const int U_tmp = valU - cZero;
+    const int V_tmp = valV - cZero;
+
+    const int R_tmp =
+        (Y_tmp + V_tmp * RGBConv[1]) >> (16 + bps - 8); // 32 to 16 bit conversion by right shifting
+    const int G_tmp = (Y_tmp + U_tmp * RGBConv[2] + V_tmp * RGBConv[3]) >> (16 + bps - 8);
+    const int B_tmp = (Y_tmp + U_tmp * RGBConv[4]) >> (16 + bps - 8);
+
+    valR = (R_tmp < 0) ? 0 : (R_tmp > 255) ? 255 : R_tmp;
+    valG = (G_tmp < 0) ? 0 : (G_tmp > 255) ? 255 : G_tmp;
+    valB = (B_tmp < 0) ? 0 : (B_tmp > 255) ? 255 : B_tmp;
+  }
+}
+
+// For every input sample in src, apply YUV transformation, (scale to 8 bit if required) and set the
+// value as RGB (monochrome). inValSkip: skip this many values in the input for every value. For
+// pure planar formats, this 1. If the UV components are interleaved, this is 2 or 3.
+inline void YUVPlaneToRGBMonochrome_444(const int            componentSize,
+                                        const MathParameters math,
+                                        const unsigned char *restrict src,
+                                        unsigned char *restrict dst,
+                                        const int  inMax,
+                                        const int  bps,
+                                        const bool bigEndian,
+                                        const int  inValSkip,
+                                        const bool fullRange)
+{
+  const bool applyMath   = math.mathRequired();
+  const int  shiftTo8Bit = bps - 8;
+  for (int i = 0; i < componentSize; ++i)
+  {
+    int newVal = getValueFromSource(src, i * inValSkip, bps, bigEndian);
+    if (applyMath)
+      newVal = transformYUV(math.invert, math.scale, math.offset, newVal, inMax);
+
+    if (shiftTo8Bit > 0)
+      newVal = clip8Bit(newVal >> shiftTo8Bit);
+    if (!fullRange)
+      newVal = LimitedRangeToFullRange.at(newVal);
+
+    // Set the value for R, G and B (BGRA)
+    dst[i * 4]     = (unsigned char)newVal;
+    dst[i * 4 + 1] = (unsigned char)newVal;
+    dst[i * 4 + 2] = (unsigned char)newVal;
+    dst[i * 4 + 3] = (unsigned char)255;
+  }
+}
+
+// For every input sample in the YZV 422 src, apply interpolation (sample and hold), apply YUV
+// transformation, (scale to 8 bit if required) and set the value as RGB (monochrome).
+inline void YUVPlaneToRGBMonochrome_422(const int            componentSize,
+                                        const MathParameters math,
+                                        const unsigned char *restrict src,
+                                        unsigned char *restrict dst,
+                                        const int  inMax,
+                                        const int  bps,
+                                        const bool bigEndian,
+                                        const int  inValSkip,
+                                        const bool fullRange)
+{
+  const bool applyMath   = math.mathRequired();
+  const int  shiftTo8Bit = bps - 8;
+  for (int i = 0; i < componentSize; ++i)
+  {
+    int newVal = getValueFromSource(src, i * inValSkip, bps, bigEndian);
+    if (applyMath)
+      newVal = transformYUV(math.invert, math.scale, math.offset, newVal, inMax);
+
+    if (shiftTo8Bit > 0)
+      newVal = clip8Bit(newVal >> shiftTo8Bit);
+    if (!fullRange)
+      newVal = LimitedRangeToFullRange.at(newVal);
+
+    // Set the value for R, G and B of 2 pixels (BGRA)
+    dst[i * 8]     = (unsigned char)newVal;
+    dst[i * 8 + 1] = (unsigned char)newVal;
+    dst[i * 8 + 2] = (unsigned char)newVal;
+    dst[i * 8 + 3] = (unsigned char)255;
+    dst[i * 8 + 4] = (unsigned char)newVal;
+    dst[i * 8 + 5] = (unsigned char)newVal;
+    dst[i * 8 + 6] = (unsigned char)newVal;
+    dst[i * 8 + 7] = (unsigned char)255;
+  }
+}
+
+inline void YUVPlaneToRGBMonochrome_420(const int            w,
+                                        const int            h,
+                                        const MathParameters math,
+                                        const unsigned char *restrict src,
+                                        unsigned char *restrict dst,
+                                        const int  inMax,
+                                        const int  bps,
+                                        const bool bigEndian,
+                                        const int  inValSkip,
+                                        const bool fullRange)
+{
+  const bool applyMath   = math.mathRequired();
+  const int  shiftTo8Bit = bps - 8;
+  for (int y = 0; y < h / 2; y++)
+    for (int x = 0; x < w / 2; x++)
+    {
+      const int srcIdx = y * (w / 2) + x;
+      int       newVal = getValueFromSource(src, srcIdx * inValSkip, bps, bigEndian);
+      if (applyMath)
+        newVal = transformYUV(math.invert, math.scale, math.offset, newVal, inMax);
+
+      if (shiftTo8Bit > 0)
+        newVal = clip8Bit(newVal >> shiftTo8Bit);
+      if (!fullRange)
+        newVal = LimitedRangeToFullRange.at(newVal);
+
+      // Set the value for R, G and B of 4 pixels (BGRA)
+      int o      = (y * 2 * w + x * 2) * 4;
+      dst[o]     = (unsigned char)newVal;
+      dst[o + 1] = (unsigned char)newVal;
+      dst[o + 2] = (unsigned char)newVal;
+      dst[o + 3] = (unsigned char)255;
+      dst[o + 4] = (unsigned char)newVal;
+      dst[o + 5] = (unsigned char)newVal;
+      dst[o + 6] = (unsigned char)newVal;
+      dst[o + 7] = (unsigned char)255;
+      o += w * 4; // Goto next line
+      dst[o]     = (unsigned char)newVal;
+      dst[o + 1] = (unsigned char)newVal;
+      dst[o + 2] = (unsigned char)newVal;
+      dst[o + 3] = (unsigned char)255;
+      dst[o + 4] = (unsigned char)newVal;
+      dst[o + 5] = (unsigned char)newVal;
+      dst[o + 6] = (unsigned char)newVal;
+      dst[o + 7] = (unsigned char)255;
+    }
+}
+
+inline void YUVPlaneToRGBMonochrome_440(const int            w,
+                                        const int            h,
+                                        const MathParameters math,
+                                        const unsigned char *restrict src,
+                                        unsigned char *restrict dst,
+                                        const int  inMax,
+                                        const int  bps,
+                                        const bool bigEndian,
+                                        const int  inValSkip,
+                                        const bool fullRange)
+{
+  const bool applyMath   = math.mathRequired();
+  const int  shiftTo8Bit = bps - 8;
+  for (int y = 0; y < h / 2; y++)
+    for (int x = 0; x < w; x++)
+    {
+      const int srcIdx = y * w + x;
+      int       newVal = getValueFromSource(src, srcIdx * inValSkip, bps, bigEndian);
+      if (applyMath)
+        newVal = transformYUV(math.invert, math.scale, math.offset, newVal, inMax);
+
+      if (shiftTo8Bit > 0)
+        newVal = clip8Bit(newVal >> shiftTo8Bit);
+      if (!fullRange)
+        newVal = LimitedRangeToFullRange.at(newVal);
+
+      // Set the value for R, G and B of 2 pixels (BGRA)
+      const int pos1 = (y * 2 * w + x) * 4;
+      const int pos2 = pos1 + w * 4; // Next line
+      dst[pos1]      = (unsigned char)newVal;
+      dst[pos1 + 1]  = (unsigned char)newVal;
+      dst[pos1 + 2]  = (unsigned char)newVal;
+      dst[pos1 + 3]  = (unsigned char)255;
+      dst[pos2]      = (unsigned char)newVal;
+      dst[pos2 + 1]  = (unsigned char)newVal;
+      dst[pos2 + 2]  = (unsigned char)newVal;
+      dst[pos2 + 3]  = (unsigned char)255;
+    }
+}
+
+inline void YUVPlaneToRGBMonochrome_410(const int            w,
+                                        const int            h,
+                                        const MathParameters math,
+                                        const unsigned char *restrict src,
+                                        unsigned char *restrict dst,
+                                        const int  inMax,
+                                        const int  bps,
+                                        const bool bigEndian,
+                                        const int  inValSkip,
+                                        const bool fullRange)
+{
+  // Horizontal subsampling by 4, vertical subsampling by 4
+  const bool applyMath   = math.mathRequired();
+  const int  shiftTo8Bit = bps - 8;
+  for (int y = 0; y < h / 4; y++)
+    for (int x = 0; x < w / 4; x++)
+    {
+      const int srcIdx = y * (w / 4) + x;
+      int       newVal = getValueFromSource(src, srcIdx * inValSkip, bps, bigEndian);
+
+      if (applyMath)
+        newVal = transformYUV(math.invert, math.scale, math.offset, newVal, inMax);
+
+      if (shiftTo8Bit > 0)
+        newVal = clip8Bit(newVal >> shiftTo8Bit);
+      if (!fullRange)
+        newVal = LimitedRangeToFullRange.at(newVal);
+
+      // Set the value as RGB for 4 pixels in this line and the next 3 lines (BGRA)
+      for (int yo = 0; yo < 4; yo++)
+        for (int xo = 0; xo < 4; xo++)
+        {
+          const int pos = ((y * 4 + yo) * w + (x * 4 + xo)) * 4;
+          dst[pos]      = (unsigned char)newVal;
+          dst[pos + 1]  = (unsigned char)newVal;
+          dst[pos + 2]  = (unsigned char)newVal;
+          dst[pos + 3]  = (unsigned char)255;
+        }
+    }
+}
+
+inline void YUVPlaneToRGBMonochrome_411(const int            componentSize,
+                                        const MathParameters math,
+                                        const unsigned char *restrict src,
+                                        unsigned char *restrict dst,
+                                        const int  inMax,
+                                        const int  bps,
+                                        const bool bigEndian,
+                                        const int  inValSkip,
+                                        const bool fullRange)
+{
+  // Horizontally U and V are subsampled by 4
+  const bool applyMath   = math.mathRequired();
+  const int  shiftTo8Bit = bps - 8;
+  for (int i = 0; i < componentSize; ++i)
+  {
+    int newVal = getValueFromSource(src, i * inValSkip, bps, bigEndian);
+    if (applyMath)
+      newVal = transformYUV(math.invert, math.scale, math.offset, newVal, inMax);
+
+    if (shiftTo8Bit > 0)
+      newVal = clip8Bit(newVal >> shiftTo8Bit);
+    if (!fullRange)
+      newVal = LimitedRangeToFullRange.at(newVal);
+
+    // Set the value for R, G and B of 4 pixels (BGRA)
+    dst[i * 16]      = (unsigned char)newVal;
+    dst[i * 16 + 1]  = (unsigned char)newVal;
+    dst[i * 16 + 2]  = (unsigned char)newVal;
+    dst[i * 16 + 3]  = (unsigned char)255;
+    dst[i * 16 + 4]  = (unsigned char)newVal;
+    dst[i * 16 + 5]  = (unsigned char)newVal;
+    dst[i * 16 + 6]  = (unsigned char)newVal;
+    dst[i * 16 + 7]  = (unsigned char)255;
+    dst[i * 16 + 8]  = (unsigned char)newVal;
+    dst[i * 16 + 9]  = (unsigned char)newVal;
+    dst[i * 16 + 10] = (unsigned char)newVal;
+    dst[i * 16 + 11] = (unsigned char)255;
+    dst[i * 16 + 12] = (unsigned char)newVal;
+    dst[i * 16 + 13] = (unsigned char)newVal;
+    dst[i * 16 + 14] = (unsigned char)newVal;
+    dst[i * 16 + 15] = (unsigned char)255;
+  }
+}
+
+inline int interpolateUVSample(const ChromaInterpolation mode, const int sample1, const int sample2)
+{
+  if (mode == ChromaInterpolation::Bilinear)
+    // Interpolate linearly between sample1 and sample2
+    return ((sample1 + sample2) + 1) >> 1;
+  return sample1; // Sample and hold
+}
+
+inline int interpolateUVSampleQ(const ChromaInterpolation mode,
+                                const int                 sample1,
+                                const int                 sample2,
+                                const int                 quarterPos)
+{
+  if (mode == ChromaInterpolation::Bilinear)
+  {
+    // Interpolate linearly between sample1 and sample2
+    if (quarterPos == 0)
+      return sample1;
+    if (quarterPos == 1)
+      return ((sample1 * 3 + sample2) + 1) >> 2;
+    if (quarterPos == 2)
+      return ((sample1 + sample2) + 1) >> 1;
+    if (quarterPos == 3)
+      return ((sample1 + sample2 * 3) + 1) >> 2;
+  }
+  return sample1; // Sample and hold
+}
+
+// TODO: Consider sample position
+inline int interpolateUVSample2D(const ChromaInterpolation mode,
+                                 const int                 sample1,
+                                 const int                 sample2,
+                                 const int                 sample3,
+                                 const int                 sample4)
+{
+  if (mode == ChromaInterpolation::Bilinear)
+    // Interpolate linearly between sample1 - sample 4
+    return ((sample1 + sample2 + sample3 + sample4) + 2) >> 2;
+  return sample1; // Sample and hold
+}
+
+// Depending on offsetX8 (which can be 1 to 7), interpolate one of the 6 given positions between
+// prev and cur.
+inline int interpolateUV8Pos(int prev, int cur, const int offsetX8)
+{
+  if (offsetX8 == 4)
+    return (prev + cur + 1) / 2;
+  if (offsetX8 == 2)
+    return (prev + cur * 3 + 2) / 4;
+  if (offsetX8 == 6)
+    return (prev * 3 + cur + 2) / 4;
+  if (offsetX8 == 1)
+    return (prev + cur * 7 + 4) / 8;
+  if (offsetX8 == 3)
+    return (prev * 3 + cur * 5 + 4) / 8;
+  if (offsetX8 == 5)
+    return (prev * 5 + cur * 3 + 4) / 8;
+  if (offsetX8 == 7)
+    return (prev * 7 + cur + 4) / 8;
+  Q_ASSERT(false); // offsetX8 should always be between 1 and 7 (inclusive)
+  return 0;
+}
+
+// Re-sample the chroma component so that the chroma samples and the luma samples are aligned after
+// this operation.
+inline void UVPlaneResamplingChromaOffset(const PixelFormatYUV format,
+                                          const int            w,
+                                          const int            h,
+                                          const unsigned char *restrict srcU,
+                                          const unsigned char *restrict srcV,
+                                          const int inValSkip,
+                                          unsigned char *restrict dstU,
+                                          unsigned char *restrict dstV)
+{
+  // We can perform linear interpolation for 7 positions (6 in between) two pixels.
+  // Which of these position is needed depends on the chromaOffset and the subsampling.
+  const int possibleValsX = getMaxPossibleChromaOffsetValues(true, format.getSubsampling());
+  const int possibleValsY = getMaxPossibleChromaOffsetValues(false, format.getSubsampling());
+  const int offsetX8      = (possibleValsX == 1)   ? format.getChromaOffset().x * 4
+                            : (possibleValsX == 3) ? format.getChromaOffset().x * 2
+                                                   : format.getChromaOffset().x;
+  const int offsetY8      = (possibleValsY == 1)   ? format.getChromaOffset().y * 4
+                            : (possibleValsY == 3) ? format.getChromaOffset().y * 2
+                                                   : format.getChromaOffset().y;
+
+  // The format to use for input/output
+  const bool bigEndian = format.isBigEndian();
+  const int  bps       = format.getBitsPerSample();
+
+  const int stride = bps > 8 ? w * 2 : w;
+  if (offsetX8 != 0)
+  {
+    // Perform horizontal re-sampling
+    for (int y = 0; y < h; y++)
+    {
+      // On the left side, there is no previous sample, so the first value is never changed.
+      const int srcIdx = y * stride * inValSkip;
+      int       prevU  = getValueFromSource(srcU, srcIdx, bps, bigEndian);
+      int       prevV  = getValueFromSource(srcV, srcIdx, bps, bigEndian);
+      setValueInBuffer(dstU, prevU, y * stride, bps, bigEndian);
+      setValueInBuffer(dstV, prevV, y * stride, bps, bigEndian);
+
+      for (int x = 0; x < w - 1; x++)
+      {
+        // Calculate the new current value using the previous and the current value
+        const int srcIdxInLine = srcIdx + (x + 1) * inValSkip;
+        int       curU         = getValueFromSource(srcU, srcIdxInLine, bps, bigEndian);
+        int       curV         = getValueFromSource(srcV, srcIdxInLine, bps, bigEndian);
+
+        // Perform interpolation and save the value for the current UV value. Goto next value.
+        int newU = interpolateUV8Pos(prevU, curU, offsetX8);
+        int newV = interpolateUV8Pos(prevV, curV, offsetX8);
+        setValueInBuffer(dstU, newU, y * stride + x, bps, bigEndian);
+        setValueInBuffer(dstV, newV, y * stride + x, bps, bigEndian);
+
+        prevU = curU;
+        prevV = curV;
+      }
+    }
+  }
+
+  // For the second step, use the filtered values (or the source if no filtering was applied)
+  const unsigned char *srcUStep2    = (offsetX8 == 0) ? srcU : dstU;
+  const unsigned char *srcVStep2    = (offsetX8 == 0) ? srcV : dstV;
+  const int            valSkipStep2 = (offsetX8 == 0) ? inValSkip : 1;
+
+  if (offsetY8 != 0)
+  {
+    // Perform vertical re-sampling. It works exactly like horizontal up-sampling but x and y are
+    // switched.
+    for (int x = 0; x < w; x++)
+    {
+      // On the top, there is no previous sample, so the first value is never changed.
+      int prevU = getValueFromSource(srcUStep2, x * valSkipStep2, bps, bigEndian);
+      int prevV = getValueFromSource(srcVStep2, x * valSkipStep2, bps, bigEndian);
+      setValueInBuffer(dstU, prevU, x, bps, bigEndian);
+      setValueInBuffer(dstV, prevV, x, bps, bigEndian);
+
+      for (int y = 0; y < h - 1; y++)
+      {
+        // Calculate the new current value using the previous and the current value
+        const int srcIdx = (y + 1) * w + x;
+        int       curU   = getValueFromSource(srcUStep2, srcIdx * valSkipStep2, bps, bigEndian);
+        int       curV   = getValueFromSource(srcVStep2, srcIdx * valSkipStep2, bps, bigEndian);
+
+        // Perform interpolation and save the value for the current UV value. Goto next value.
+        int newU = interpolateUV8Pos(prevU, curU, offsetY8);
+        int newV = interpolateUV8Pos(prevV, curV, offsetY8);
+        setValueInBuffer(dstU, newU, srcIdx, bps, bigEndian);
+        setValueInBuffer(dstV, newV, srcIdx, bps, bigEndian);
+
+        prevU = curU;
+        prevV = curV;
+      }
+    }
+  }
+}
+
+inline void YUVPlaneToRGB_444(const int            componentSize,
+                              const MathParameters mathY,
+                              const MathParameters mathC,
+                              const unsigned char *restrict srcY,
+                              const unsigned char *restrict srcU,
+                              const unsigned char *restrict srcV,
+                              unsigned char *restrict dst,
+                              const int  RGBConv[5],
+                              const bool fullRange,
+                              const int  inMax,
+                              const int  bps,
+                              const bool bigEndian,
+                              const int  inValSkip)
+{
+  const bool applyMathLuma   = mathY.mathRequired();
+  const bool applyMathChroma = mathC.mathRequired();
+
+  for (int i = 0; i < componentSize; ++i)
+  {
+    unsigned int valY = getValueFromSource(srcY, i, bps, bigEndian);
+    unsigned int valU = getValueFromSource(srcU, i * inValSkip, bps, bigEndian);
+    unsigned int valV = getValueFromSource(srcV, i * inValSkip, bps, bigEndian);
+
+    if (applyMathLuma)
+      valY = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY, inMax);
+    if (applyMathChroma)
+    {
+      valU = transformYUV(mathC.invert, mathC.scale, mathC.offset, valU, inMax);
+      valV = transformYUV(mathC.invert, mathC.scale, mathC.offset, valV, inMax);
+    }
+
+    // Get the RGB values for this sample
+    int valR, valG, valB;
+    convertYUVToRGB8Bit(valY, valU, valV, valR, valG, valB, RGBConv, fullRange, bps);
+
+    // Save the RGB values
+    dst[i * 4]     = valB;
+    dst[i * 4 + 1] = valG;
+    dst[i * 4 + 2] = valR;
+    dst[i * 4 + 3] = 255;
+  }
+}
+
+inline void YUVPlaneToRGB_422(const int            w,
+                              const int            h,
+                              const MathParameters mathY,
+                              const MathParameters mathC,
+                              const unsigned char *restrict srcY,
+                              const unsigned char *restrict srcU,
+                              const unsigned char *restrict srcV,
+                              unsigned char *restrict dst,
+                              const int                 RGBConv[5],
+                              const bool                fullRange,
+                              const int                 inMax,
+                              const ChromaInterpolation interpolation,
+                              const int                 bps,
+                              const bool                bigEndian,
+                              const int                 inValSkip)
+{
+  const bool applyMathLuma   = mathY.mathRequired();
+  const bool applyMathChroma = mathC.mathRequired();
+  // Horizontal up-sampling is required. Process two Y values at a time
+  for (int y = 0; y < h; y++)
+  {
+    const int srcIdxUV   = y * w / 2;
+    int       curUSample = getValueFromSource(srcU, srcIdxUV * inValSkip, bps, bigEndian);
+    int       curVSample = getValueFromSource(srcV, srcIdxUV * inValSkip, bps, bigEndian);
+    if (applyMathChroma)
+    {
+      curUSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, curUSample, inMax);
+      curVSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, curVSample, inMax);
+    }
+
+    for (int x = 0; x < (w / 2) - 1; x++)
+    {
+      // Get the next U/V sample
+      const int srcPosLineUV = srcIdxUV + x + 1;
+      int       nextUSample  = getValueFromSource(srcU, srcPosLineUV * inValSkip, bps, bigEndian);
+      int       nextVSample  = getValueFromSource(srcV, srcPosLineUV * inValSkip, bps, bigEndian);
+      if (applyMathChroma)
+      {
+        nextUSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextUSample, inMax);
+        nextVSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextVSample, inMax);
+      }
+
+      // From the current and the next U/V sample, interpolate the UV sample in between
+      int interpolatedU = interpolateUVSample(interpolation, curUSample, nextUSample);
+      int interpolatedV = interpolateUVSample(interpolation, curVSample, nextVSample);
+
+      // Get the 2 Y samples
+      int valY1 = getValueFromSource(srcY, y * w + x * 2, bps, bigEndian);
+      int valY2 = getValueFromSource(srcY, y * w + x * 2 + 1, bps, bigEndian);
+      if (applyMathLuma)
+      {
+        valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
+        valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
+      }
+
+      // Convert to 2 RGB values and save them (BGRA)
+      int valR1, valR2, valG1, valG2, valB1, valB2;
+      convertYUVToRGB8Bit(
+          valY1, curUSample, curVSample, valR1, valG1, valB1, RGBConv, fullRange, bps);
+      convertYUVToRGB8Bit(
+          valY2, interpolatedU, interpolatedV, valR2, valG2, valB2, RGBConv, fullRange, bps);
+      const int pos = (y * w + x * 2) * 4;
+      dst[pos]      = valB1;
+      dst[pos + 1]  = valG1;
+      dst[pos + 2]  = valR1;
+      dst[pos + 3]  = 255;
+      dst[pos + 4]  = valB2;
+      dst[pos + 5]  = valG2;
+      dst[pos + 6]  = valR2;
+      dst[pos + 7]  = 255;
+
+      // The next one is now the current one
+      curUSample = nextUSample;
+      curVSample = nextVSample;
+    }
+
+    // For the last row, there is no next sample. Just reuse the current one again. No interpolation
+    // required either.
+
+    // Get the 2 Y samples
+    int valY1 = getValueFromSource(srcY, (y + 1) * w - 2, bps, bigEndian);
+    int valY2 = getValueFromSource(srcY, (y + 1) * w - 1, bps, bigEndian);
+    if (applyMathLuma)
+    {
+      valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
+      valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
+    }
+
+    // Convert to 2 RGB values and save them
+    int valR1, valR2, valG1, valG2, valB1, valB2;
+    convertYUVToRGB8Bit(
+        valY1, curUSample, curVSample, valR1, valG1, valB1, RGBConv, fullRange, bps);
+    convertYUVToRGB8Bit(
+        valY2, curUSample, curVSample, valR2, valG2, valB2, RGBConv, fullRange, bps);
+    const int pos = ((y + 1) * w) * 4;
+    dst[pos - 8]  = valB1;
+    dst[pos - 7]  = valG1;
+    dst[pos - 6]  = valR1;
+    dst[pos - 5]  = 255;
+    dst[pos - 4]  = valB2;
+    dst[pos - 3]  = valG2;
+    dst[pos - 2]  = valR2;
+    dst[pos - 1]  = 255;
+  }
+}
+
+inline void YUVPlaneToRGB_440(const int            w,
+                              const int            h,
+                              const MathParameters mathY,
+                              const MathParameters mathC,
+                              const unsigned char *restrict srcY,
+                              const unsigned char *restrict srcU,
+                              const unsigned char *restrict srcV,
+                              unsigned char *restrict dst,
+                              const int                 RGBConv[5],
+                              const bool                fullRange,
+                              const int                 inMax,
+                              const ChromaInterpolation interpolation,
+                              const int                 bps,
+                              const bool                bigEndian,
+                              const int                 inValSkip)
+{
+  const bool applyMathLuma   = mathY.mathRequired();
+  const bool applyMathChroma = mathC.mathRequired();
+  // Vertical up-sampling is required. Process two Y values at a time
+
+  for (int x = 0; x < w; x++)
+  {
+    int curUSample = getValueFromSource(srcU, x * inValSkip, bps, bigEndian);
+    int curVSample = getValueFromSource(srcV, x * inValSkip, bps, bigEndian);
+    if (applyMathChroma)
+    {
+      curUSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, curUSample, inMax);
+      curVSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, curVSample, inMax);
+    }
+
+    for (int y = 0; y < (h / 2) - 1; y++)
+    {
+      // Get the next U/V sample (from the next chroma line)
+      const int srcIdxUV    = (y + 1) * w + x;
+      int       nextUSample = getValueFromSource(srcU, srcIdxUV * inValSkip, bps, bigEndian);
+      int       nextVSample = getValueFromSource(srcV, srcIdxUV * inValSkip, bps, bigEndian);
+      if (applyMathChroma)
+      {
+        nextUSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextUSample, inMax);
+        nextVSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextVSample, inMax);
+      }
+
+      // From the current and the next U/V sample, interpolate the UV sample in between
+      int interpolatedU = interpolateUVSample(interpolation, curUSample, nextUSample);
+      int interpolatedV = interpolateUVSample(interpolation, curVSample, nextVSample);
+
+      // Get the 2 Y samples
+      int valY1 = getValueFromSource(srcY, y * 2 * w + x, bps, bigEndian);
+      int valY2 = getValueFromSource(srcY, (y * 2 + 1) * w + x, bps, bigEndian);
+      if (applyMathLuma)
+      {
+        valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
+        valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
+      }
+
+      // Convert to 2 RGB values and save them
+      int valR1, valR2, valG1, valG2, valB1, valB2;
+      convertYUVToRGB8Bit(
+          valY1, curUSample, curVSample, valR1, valG1, valB1, RGBConv, fullRange, bps);
+      convertYUVToRGB8Bit(
+          valY2, interpolatedU, interpolatedV, valR2, valG2, valB2, RGBConv, fullRange, bps);
+      const int pos1 = (y * 2 * w + x) * 4;
+      const int pos2 = pos1 + 4 * w;
+      dst[pos1]      = valB1;
+      dst[pos1 + 1]  = valG1;
+      dst[pos1 + 2]  = valR1;
+      dst[pos1 + 3]  = 255;
+      dst[pos2]      = valB2;
+      dst[pos2 + 1]  = valG2;
+      dst[pos2 + 2]  = valR2;
+      dst[pos2 + 3]  = 255;
+
+      // The next one is now the current one
+      curUSample = nextUSample;
+      curVSample = nextVSample;
+    }
+
+    // For the last column, there is no next sample. Just reuse the current one again. No
+    // interpolation required either.
+
+    // Get the 2 Y samples
+    int valY1 = getValueFromSource(srcY, (h - 2) * w + x, bps, bigEndian);
+    int valY2 = getValueFromSource(srcY, (h - 1) * w + x, bps, bigEndian);
+    if (applyMathLuma)
+    {
+      valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
+      valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
+    }
+
+    // Convert to 2 RGB values and save them
+    int valR1, valR2, valG1, valG2, valB1, valB2;
+    convertYUVToRGB8Bit(
+        valY1, curUSample, curVSample, valR1, valG1, valB1, RGBConv, fullRange, bps);
+    convertYUVToRGB8Bit(
+        valY2, curUSample, curVSample, valR2, valG2, valB2, RGBConv, fullRange, bps);
+    const int pos1 = ((h - 2) * w + x) * 4;
+    const int pos2 = pos1 + w * 4;
+    dst[pos1]      = valB1;
+    dst[pos1 + 1]  = valG1;
+    dst[pos1 + 2]  = valR1;
+    dst[pos1 + 3]  = 255;
+    dst[pos2]      = valB2;
+    dst[pos2 + 1]  = valG2;
+    dst[pos2 + 2]  = valR2;
+    dst[pos2 + 3]  = 255;
+  }
+}
+
+inline void YUVPlaneToRGB_420(const int            w,
+                              const int            h,
+                              const MathParameters mathY,
+                              const MathParameters mathC,
+                              const unsigned char *restrict srcY,
+                              const unsigned char *restrict srcU,
+                              const unsigned char *restrict srcV,
+                              unsigned char *restrict dst,
+                              const int                 RGBConv[5],
+                              const bool                fullRange,
+                              const int                 inMax,
+                              const ChromaInterpolation interpolation,
+                              const int                 bps,
+                              const bool                bigEndian,
+                              const int                 inValSkip)
+{
+  const bool applyMathLuma   = mathY.mathRequired();
+  const bool applyMathChroma = mathC.mathRequired();
+  // Format is YUV 4:2:0. Horizontal and vertical up-sampling is required. Process 4 Y positions at
+  // a time
+  const int hh = h / 2; // The half values
+  const int wh = w / 2;
+  for (int y = 0; y < hh - 1; y++)
+  {
+    // Get the current U/V samples for this y line and the next one (_NL)
+    const int srcIdxUV0 = y * wh;
+    const int srcIdxUV1 = (y + 1) * wh;
+    int       curU      = getValueFromSource(srcU, srcIdxUV0 * inValSkip, bps, bigEndian);
+    int       curV      = getValueFromSource(srcV, srcIdxUV0 * inValSkip, bps, bigEndian);
+    int       curU_NL   = getValueFromSource(srcU, srcIdxUV1 * inValSkip, bps, bigEndian);
+    int       curV_NL   = getValueFromSource(srcV, srcIdxUV1 * inValSkip, bps, bigEndian);
+    if (applyMathChroma)
+    {
+      curU    = transformYUV(mathC.invert, mathC.scale, mathC.offset, curU, inMax);
+      curV    = transformYUV(mathC.invert, mathC.scale, mathC.offset, curV, inMax);
+      curU_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, curU_NL, inMax);
+      curV_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, curV_NL, inMax);
+    }
+
+    for (int x = 0; x < wh - 1; x++)
+    {
+      // Get the next U/V sample for this line and the next one
+      const int srcIdxUVLine0 = srcIdxUV0 + x + 1;
+      const int srcIdxUVLine1 = srcIdxUV1 + x + 1;
+      int       nextU         = getValueFromSource(srcU, srcIdxUVLine0 * inValSkip, bps, bigEndian);
+      int       nextV         = getValueFromSource(srcV, srcIdxUVLine0 * inValSkip, bps, bigEndian);
+      int       nextU_NL      = getValueFromSource(srcU, srcIdxUVLine1 * inValSkip, bps, bigEndian);
+      int       nextV_NL      = getValueFromSource(srcV, srcIdxUVLine1 * inValSkip, bps, bigEndian);
+      if (applyMathChroma)
+      {
+        nextU    = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextU, inMax);
+        nextV    = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextV, inMax);
+        nextU_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextU_NL, inMax);
+        nextV_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextV_NL, inMax);
+      }
+
+      // From the current and the next U/V sample, interpolate the 3 UV samples in between
+      int interpolatedU_Hor =
+          interpolateUVSample(interpolation, curU, nextU); // Horizontal interpolation
+      int interpolatedV_Hor = interpolateUVSample(interpolation, curV, nextV);
+      int interpolatedU_Ver =
+          interpolateUVSample(interpolation, curU, curU_NL); // Vertical interpolation
+      int interpolatedV_Ver = interpolateUVSample(interpolation, curV, curV_NL);
+      int interpolatedU_Bi =
+          interpolateUVSample2D(interpolation, curU, nextU, curU_NL, nextU_NL); // 2D interpolation
+      int interpolatedV_Bi =
+          interpolateUVSample2D(interpolation, curV, nextV, curV_NL, nextV_NL); // 2D interpolation
+
+      // Get the 4 Y samples
+      int valY1 = getValueFromSource(srcY, (y * w + x) * 2, bps, bigEndian);
+      int valY2 = getValueFromSource(srcY, (y * w + x) * 2 + 1, bps, bigEndian);
+      int valY3 = getValueFromSource(srcY, (y * 2 + 1) * w + x * 2, bps, bigEndian);
+      int valY4 = getValueFromSource(srcY, (y * 2 + 1) * w + x * 2 + 1, bps, bigEndian);
+      if (applyMathLuma)
+      {
+        valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
+        valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
+        valY3 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY3, inMax);
+        valY4 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY4, inMax);
+      }
+
+      // Convert to 4 RGB values and save them
+      int valR1, valR2, valG1, valG2, valB1, valB2;
+      convertYUVToRGB8Bit(valY1, curU, curV, valR1, valG1, valB1, RGBConv, fullRange, bps);
+      convertYUVToRGB8Bit(valY2,
+                          interpolatedU_Hor,
+                          interpolatedV_Hor,
+                          valR2,
+                          valG2,
+                          valB2,
+                          RGBConv,
+                          fullRange,
+                          bps);
+      const int pos1 = (y * 2 * w + x * 2) * 4;
+      dst[pos1]      = valB1;
+      dst[pos1 + 1]  = valG1;
+      dst[pos1 + 2]  = valR1;
+      dst[pos1 + 3]  = 255;
+      dst[pos1 + 4]  = valB2;
+      dst[pos1 + 5]  = valG2;
+      dst[pos1 + 6]  = valR2;
+      dst[pos1 + 7]  = 255;
+      convertYUVToRGB8Bit(valY3,
+                          interpolatedU_Ver,
+                          interpolatedV_Ver,
+                          valR1,
+                          valG1,
+                          valB1,
+                          RGBConv,
+                          fullRange,
+                          bps); // Second line
+      convertYUVToRGB8Bit(
+          valY4, interpolatedU_Bi, interpolatedV_Bi, valR2, valG2, valB2, RGBConv, fullRange, bps);
+      const int pos2 = pos1 + w * 4; // Next line
+      dst[pos2]      = valB1;
+      dst[pos2 + 1]  = valG1;
+      dst[pos2 + 2]  = valR1;
+      dst[pos2 + 3]  = 255;
+      dst[pos2 + 4]  = valB2;
+      dst[pos2 + 5]  = valG2;
+      dst[pos2 + 6]  = valR2;
+      dst[pos2 + 7]  = 255;
+
+      // The next one is now the current one
+      curU    = nextU;
+      curV    = nextV;
+      curU_NL = nextU_NL;
+      curV_NL = nextV_NL;
+    }
+
+    // For the last x value (the right border), there is no next value. Just sample and hold. Only
+    // vertical interpolation is required.
+    int interpolatedU_Ver =
+        interpolateUVSample(interpolation, curU, curU_NL); // Vertical interpolation
+    int interpolatedV_Ver = interpolateUVSample(interpolation, curV, curV_NL);
+
+    // Get the 4 Y samples
+    int valY1 = getValueFromSource(srcY, (y * 2 + 1) * w - 2, bps, bigEndian);
+    int valY2 = getValueFromSource(srcY, (y * 2 + 1) * w - 1, bps, bigEndian);
+    int valY3 = getValueFromSource(srcY, (y * 2 + 2) * w - 2, bps, bigEndian);
+    int valY4 = getValueFromSource(srcY, (y * 2 + 2) * w - 1, bps, bigEndian);
+    if (applyMathLuma)
+    {
+      valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
+      valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
+      valY3 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY3, inMax);
+      valY4 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY4, inMax);
+    }
+
+    // Convert to 4 RGB values and save them
+    int valR1, valR2, valG1, valG2, valB1, valB2;
+    convertYUVToRGB8Bit(valY1, curU, curV, valR1, valG1, valB1, RGBConv, fullRange, bps);
+    convertYUVToRGB8Bit(valY2, curU, curV, valR2, valG2, valB2, RGBConv, fullRange, bps);
+    const int pos1 = ((y * 2 + 1) * w) * 4;
+    dst[pos1 - 8]  = valB1;
+    dst[pos1 - 7]  = valG1;
+    dst[pos1 - 6]  = valR1;
+    dst[pos1 - 5]  = 255;
+    dst[pos1 - 4]  = valB2;
+    dst[pos1 - 3]  = valG2;
+    dst[pos1 - 2]  = valR2;
+    dst[pos1 - 1]  = 255;
+    convertYUVToRGB8Bit(valY3,
+                        interpolatedU_Ver,
+                        interpolatedV_Ver,
+                        valR1,
+                        valG1,
+                        valB1,
+                        RGBConv,
+                        fullRange,
+                        bps); // Second line
+    convertYUVToRGB8Bit(
+        valY4, interpolatedU_Ver, interpolatedV_Ver, valR2, valG2, valB2, RGBConv, fullRange, bps);
+    const int pos2 = pos1 + w * 4; // Next line
+    dst[pos2 - 8]  = valB1;
+    dst[pos2 - 7]  = valG1;
+    dst[pos2 - 6]  = valR1;
+    dst[pos2 - 5]  = 255;
+    dst[pos2 - 4]  = valB2;
+    dst[pos2 - 3]  = valG2;
+    dst[pos2 - 2]  = valR2;
+    dst[pos2 - 1]  = 255;
+  }
+
+  // At the last Y line (the bottom line) a similar scenario occurs. There is no next Y line. Just
+  // sample and hold. Only horizontal interpolation is required.
+
+  // Get the current U/V samples for this y line
+  const int y  = hh - 1; // Just process the last y line
+  const int y2 = (hh - 1) * 2;
+
+  // Get 2 chroma samples from this line
+  const int srcIdxUV = y * wh;
+  int       curU     = getValueFromSource(srcU, srcIdxUV * inValSkip, bps, bigEndian);
+  int       curV     = getValueFromSource(srcV, srcIdxUV * inValSkip, bps, bigEndian);
+  if (applyMathChroma)
+  {
+    curU = transformYUV(mathC.invert, mathC.scale, mathC.offset, curU, inMax);
+    curV = transformYUV(mathC.invert, mathC.scale, mathC.offset, curV, inMax);
+  }
+
+  for (int x = 0; x < (w / 2) - 1; x++)
+  {
+    // Get the next U/V sample for this line and the next one
+    const int srcIdxLineUV = srcIdxUV + x + 1;
+    int       nextU        = getValueFromSource(srcU, srcIdxLineUV * inValSkip, bps, bigEndian);
+    int       nextV        = getValueFromSource(srcV, srcIdxLineUV * inValSkip, bps, bigEndian);
+    if (applyMathChroma)
+    {
+      nextU = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextU, inMax);
+      nextV = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextV, inMax);
+    }
+
+    // From the current and the next U/V sample, interpolate the 3 UV samples in between
+    int interpolatedU_Hor =
+        interpolateUVSample(interpolation, curU, nextU); // Horizontal interpolation
+    int interpolatedV_Hor = interpolateUVSample(interpolation, curV, nextV);
+
+    // Get the 4 Y samples
+    int valY1 = getValueFromSource(srcY, (y * w + x) * 2, bps, bigEndian);
+    int valY2 = getValueFromSource(srcY, (y * w + x) * 2 + 1, bps, bigEndian);
+    int valY3 = getValueFromSource(srcY, (y2 + 1) * w + x * 2, bps, bigEndian);
+    int valY4 = getValueFromSource(srcY, (y2 + 1) * w + x * 2 + 1, bps, bigEndian);
+    if (applyMathLuma)
+    {
+      valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
+      valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
+      valY3 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY3, inMax);
+      valY4 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY4, inMax);
+    }
+
+    // Convert to 4 RGB values and save them
+    int valR1, valR2, valG1, valG2, valB1, valB2;
+    convertYUVToRGB8Bit(valY1, curU, curV, valR1, valG1, valB1, RGBConv, fullRange, bps);
+    convertYUVToRGB8Bit(
+        valY2, interpolatedU_Hor, interpolatedV_Hor, valR2, valG2, valB2, RGBConv, fullRange, bps);
+    const int pos1 = (y2 * w + x * 2) * 4;
+    dst[pos1]      = valB1;
+    dst[pos1 + 1]  = valG1;
+    dst[pos1 + 2]  = valR1;
+    dst[pos1 + 3]  = 255;
+    dst[pos1 + 4]  = valB2;
+    dst[pos1 + 5]  = valG2;
+    dst[pos1 + 6]  = valR2;
+    dst[pos1 + 7]  = 255;
+    convertYUVToRGB8Bit(
+        valY3, curU, curV, valR1, valG1, valB1, RGBConv, fullRange, bps); // Second line
+    convertYUVToRGB8Bit(
+        valY4, interpolatedU_Hor, interpolatedV_Hor, valR2, valG2, valB2, RGBConv, fullRange, bps);
+    const int pos2 = pos1 + w * 4; // Next line
+    dst[pos2]      = valB1;
+    dst[pos2 + 1]  = valG1;
+    dst[pos2 + 2]  = valR1;
+    dst[pos2 + 3]  = 255;
+    dst[pos2 + 4]  = valB2;
+    dst[pos2 + 5]  = valG2;
+    dst[pos2 + 6]  = valR2;
+    dst[pos2 + 7]  = 255;
+
+    // The next one is now the current one
+    curU = nextU;
+    curV = nextV;
+  }
+
+  // For the last x value in the last y row (the right bottom), there is no next value in neither
+  // direction. Just sample and hold. No interpolation is required.
+
+  // Get the 4 Y samples
+  int valY1 = getValueFromSource(srcY, (y2 + 1) * w - 2, bps, bigEndian);
+  int valY2 = getValueFromSource(srcY, (y2 + 1) * w - 1, bps, bigEndian);
+  int valY3 = getValueFromSource(srcY, (y2 + 2) * w - 2, bps, bigEndian);
+  int valY4 = getValueFromSource(srcY, (y2 + 2) * w - 1, bps, bigEndian);
+  if (applyMathLuma)
+  {
+    valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
+    valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
+    valY3 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY3, inMax);
+    valY4 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY4, inMax);
+  }
+
+  // Convert to 4 RGB values and save them
+  int valR1, valR2, valG1, valG2, valB1, valB2;
+  convertYUVToRGB8Bit(valY1, curU, curV, valR1, valG1, valB1, RGBConv, fullRange, bps);
+  convertYUVToRGB8Bit(valY2, curU, curV, valR2, valG2, valB2, RGBConv, fullRange, bps);
+  const int pos1 = (y2 + 1) * w * 4;
+  dst[pos1 - 8]  = valB1;
+  dst[pos1 - 7]  = valG1;
+  dst[pos1 - 6]  = valR1;
+  dst[pos1 - 5]  = 255;
+  dst[pos1 - 4]  = valB2;
+  dst[pos1 - 3]  = valG2;
+  dst[pos1 - 2]  = valR2;
+  dst[pos1 - 1]  = 255;
+  convertYUVToRGB8Bit(
+      valY3, curU, curV, valR1, valG1, valB1, RGBConv, fullRange, bps); // Second line
+  convertYUVToRGB8Bit(valY4, curU, curV, valR2, valG2, valB2, RGBConv, fullRange, bps);
+  const int pos2 = pos1 + w * 4; // Next line
+  dst[pos2 - 8]  = valB1;
+  dst[pos2 - 7]  = valG1;
+  dst[pos2 - 6]  = valR1;
+  dst[pos2 - 5]  = 255;
+  dst[pos2 - 4]  = valB2;
+  dst[pos2 - 3]  = valG2;
+  dst[pos2 - 2]  = valR2;
+  dst[pos2 - 1]  = 255;
+}
+
+inline void YUVPlaneToRGB_410(const int            w,
+                              const int            h,
+                              const MathParameters mathY,
+                              const MathParameters mathC,
+                              const unsigned char *restrict srcY,
+                              const unsigned char *restrict srcU,
+                              const unsigned char *restrict srcV,
+                              unsigned char *restrict dst,
+                              const int                 RGBConv[5],
+                              const bool                fullRange,
+                              const int                 inMax,
+                              const ChromaInterpolation interpolation,
+                              const int                 bps,
+                              const bool                bigEndian,
+                              const int                 inValSkip)
+{
+  const bool applyMathLuma   = mathY.mathRequired();
+  const bool applyMathChroma = mathC.mathRequired();
+  // Format is YUV 4:1:0. Horizontal and vertical up-sampling is required. Process 4 Y positions of
+  // 2 lines at a time Horizontal subsampling by 4, vertical subsampling by 2
+  const int hq = h / 4; // The quarter values
+  const int wq = w / 4;
+
+  for (int y = 0; y < hq; y++)
+  {
+    // Get the current U/V samples for this y line and the next one (_NL)
+    const int srcIdxUV0 = y * wq;
+    const int srcIdxUV1 = (y + 1) * wq;
+    int       curU      = getValueFromSource(srcU, srcIdxUV0 * inValSkip, bps, bigEndian);
+    int       curV      = getValueFromSource(srcV, srcIdxUV0 * inValSkip, bps, bigEndian);
+    int       curU_NL =
+        (y < hq - 1) ? getValueFromSource(srcU, srcIdxUV1 * inValSkip, bps, bigEndian) : curU;
+    int curV_NL =
+        (y < hq - 1) ? getValueFromSource(srcV, srcIdxUV1 * inValSkip, bps, bigEndian) : curV;
+    if (applyMathChroma)
+    {
+      curU    = transformYUV(mathC.invert, mathC.scale, mathC.offset, curU, inMax);
+      curV    = transformYUV(mathC.invert, mathC.scale, mathC.offset, curV, inMax);
+      curU_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, curU_NL, inMax);
+      curV_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, curV_NL, inMax);
+    }
+
+    for (int x = 0; x < wq; x++)
+    {
+      // We process 4*4 values per U/V value
+
+      // Get the next U/V sample for this line and the next one. On the right border and in the
+      // last line, there are no next samples. Just hold the current values. The held values were
+      // already transformed, so only apply the math to the values that we read.
+      int nextU    = curU;
+      int nextV    = curV;
+      int nextU_NL = curU_NL;
+      int nextV_NL = curV_NL;
+      if (x < wq - 1)
+      {
+        const int srcIdxUVLine0 = srcIdxUV0 + x + 1;
+        nextU = getValueFromSource(srcU, srcIdxUVLine0 * inValSkip, bps, bigEndian);
+        nextV = getValueFromSource(srcV, srcIdxUVLine0 * inValSkip, bps, bigEndian);
+        if (applyMathChroma)
+        {
+          nextU = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextU, inMax);
+          nextV = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextV, inMax);
+        }
+        nextU_NL = nextU;
+        nextV_NL = nextV;
+        if (y < hq - 1)
+        {
+          const int srcIdxUVLine1 = srcIdxUV1 + x + 1;
+          nextU_NL = getValueFromSource(srcU, srcIdxUVLine1 * inValSkip, bps, bigEndian);
+          nextV_NL = getValueFromSource(srcV, srcIdxUVLine1 * inValSkip, bps, bigEndian);
+          if (applyMathChroma)
+          {
+            nextU_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextU_NL, inMax);
+            nextV_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextV_NL, inMax);
+          }
+        }
+      }
+
+      // Now we interpolate and set the RGB values for the 4x4 pixels
+      for (int yo = 0; yo < 4; yo++)
+      {
+        // Interpolate vertically
+        int curU_INT  = interpolateUVSampleQ(interpolation, curU, curU_NL, yo);
+        int curV_INT  = interpolateUVSampleQ(interpolation, curV, curV_NL, yo);
+        int nextU_INT = interpolateUVSampleQ(interpolation, nextU, nextU_NL, yo);
+        int nextV_INT = interpolateUVSampleQ(interpolation, nextV, nextV_NL, yo);
+
+        for (int xo = 0; xo < 4; xo++)
+        {
+          // Interpolate horizontally
+          int U = interpolateUVSampleQ(interpolation, curU_INT, nextU_INT, xo);
+          int V = interpolateUVSampleQ(interpolation, curV_INT, nextV_INT, xo);
+          // Get the Y sample
+          int Y = getValueFromSource(srcY, (y * 4 + yo) * w + x * 4 + xo, bps, bigEndian);
+          if (applyMathLuma)
+            Y = transformYUV(mathY.invert, mathY.scale, mathY.offset, Y, inMax);
+
+          // Convert to RGB and save (BGRA)
+          int       R, G, B;
+          const int pos = ((y * 4 + yo) * w + x * 4 + xo) * 4;
+          convertYUVToRGB8Bit(Y, U, V, R, G, B, RGBConv, fullRange, bps);
+          dst[pos]     = B;
+          dst[pos + 1] = G;
+          dst[pos + 2] = R;
+          dst[pos + 3] = 255;
+        }
+      }
+
+      curU    = nextU;
+      curV    = nextV;
+      curU_NL = nextU_NL;
+      curV_NL = nextV_NL;
+    }
+  }
+}
+
+inline void YUVPlaneToRGB_411(const int            w,
+                              const int            h,
+                              const MathParameters mathY,
+                              const MathParameters mathC,
+                              const unsigned char *restrict srcY,
+                              const unsigned char *restrict srcU,
+                              const unsigned char *restrict srcV,
+                              unsigned char *restrict dst,
+                              const int                 RGBConv[5],
+                              const bool                fullRange,
+                              const int                 inMax,
+                              const ChromaInterpolation interpolation,
+                              const int                 bps,
+                              const bool                bigEndian,
+                              const int                 inValSkip)
+{
+  // Chroma: quarter horizontal resolution
+  const bool applyMathLuma   = mathY.mathRequired();
+  const bool applyMathChroma = mathC.mathRequired();
+
+  // Horizontal up-sampling is required. Process four Y values at a time.
+  for (int y = 0; y < h; y++)
+  {
+    const int srcIdxUV   = y * w / 4;
+    int       curUSample = getValueFromSource(srcU, srcIdxUV * inValSkip, bps, bigEndian);
+    int       curVSample = getValueFromSource(srcV, srcIdxUV * inValSkip, bps, bigEndian);
+    if (applyMathChroma)
+    {
+      curUSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, curUSample, inMax);
+      curVSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, curVSample, inMax);
+    }
+
+    for (int x = 0; x < (w / 4) - 1; x++)
+    {
+      // Get the next U/V sample
+      const int srcIdxUVLine = srcIdxUV + x + 1;
+      int       nextUSample  = getValueFromSource(srcU, srcIdxUVLine * inValSkip, bps, bigEndian);
+      int       nextVSample  = getValueFromSource(srcV, srcIdxUVLine * inValSkip, bps, bigEndian);
+      if (applyMathChroma)
+      {
+        nextUSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextUSample, inMax);
+        nextVSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextVSample, inMax);
+      }
+
+      // From the current and the next U/V sample, interpolate the UV sample in between
+      int interpolatedU1 = interpolateUVSampleQ(interpolation, curUSample, nextUSample, 1);
+      int interpolatedV1 = interpolateUVSampleQ(interpolation, curVSample, nextVSample, 1);
+      int interpolatedU2 = interpolateUVSample(interpolation, curUSample, nextUSample);
+      int interpolatedV2 = interpolateUVSample(interpolation, curVSample, nextVSample);
+      int interpolatedU3 = interpolateUVSampleQ(interpolation, curUSample, nextUSample, 3);
+      int interpolatedV3 = interpolateUVSampleQ(interpolation, curVSample, nextVSample, 3);
+
+      // Get the 4 Y samples
+      int valY1 = getValueFromSource(srcY, y * w + x * 4, bps, bigEndian);
+      int valY2 = getValueFromSource(srcY, y * w + x * 4 + 1, bps, bigEndian);
+      int valY3 = getValueFromSource(srcY, y * w + x * 4 + 2, bps, bigEndian);
+      int valY4 = getValueFromSource(srcY, y * w + x * 4 + 3, bps, bigEndian);
+      if (applyMathLuma)
+      {
+        valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
+        valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
+        valY3 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY3, inMax);
+        valY4 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY4, inMax);
+      }
+
+      // Convert to 4 RGB values and save them
+      int       valR, valG, valB;
+      const int pos = (y * w + x * 4) * 4;
+      convertYUVToRGB8Bit(valY1, curUSample, curVSample, valR, valG, valB, RGBConv, fullRange, bps);
+      dst[pos]     = valB;
+      dst[pos + 1] = valG;
+      dst[pos + 2] = valR;
+      dst[pos + 3] = 255;
+      convertYUVToRGB8Bit(
+          valY2, interpolatedU1, interpolatedV1, valR, valG, valB, RGBConv, fullRange, bps);
+      dst[pos + 4] = valB;
+      dst[pos + 5] = valG;
+      dst[pos + 6] = valR;
+      dst[pos + 7] = 255;
+      convertYUVToRGB8Bit(
+          valY3, interpolatedU2, interpolatedV2, valR, valG, valB, RGBConv, fullRange, bps);
+      dst[pos + 8]  = valB;
+      dst[pos + 9]  = valG;
+      dst[pos + 10] = valR;
+      dst[pos + 11] = 255;
+      convertYUVToRGB8Bit(
+          valY4, interpolatedU3, interpolatedV3, valR, valG, valB, RGBConv, fullRange, bps);
+      dst[pos + 12] = valB;
+      dst[pos + 13] = valG;
+      dst[pos + 14] = valR;
+      dst[pos + 15] = 255;
+
+      // The next one is now the current one
+      curUSample = nextUSample;
+      curVSample = nextVSample;
+    }
+
+    // For the last row, there is no next sample. Just reuse the current one again. No interpolation
+    // required either.
+
+    // Get the 2 Y samples
+    int valY1 = getValueFromSource(srcY, (y + 1) * w - 4, bps, bigEndian);
+    int valY2 = getValueFromSource(srcY, (y + 1) * w - 3, bps, bigEndian);
+    int valY3 = getValueFromSource(srcY, (y + 1) * w - 2, bps, bigEndian);
+    int valY4 = getValueFromSource(srcY, (y + 1) * w - 1, bps, bigEndian);
+    if (applyMathLuma)
+    {
+      valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
+      valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
+      valY3 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY3, inMax);
+      valY4 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY4, inMax);
+    }
+
+    // Convert to 4 RGB values and save them
+    int       valR, valG, valB;
+    const int pos = ((y + 1) * w) * 4;
+    convertYUVToRGB8Bit(valY1, curUSample, curVSample, valR, valG, valB, RGBConv, fullRange, bps);
+    dst[pos - 16] = valB;
+    dst[pos - 15] = valG;
+    dst[pos - 14] = valR;
+    dst[pos - 13] = 255;
+    convertYUVToRGB8Bit(valY2, curUSample, curVSample, valR, valG, valB, RGBConv, fullRange, bps);
+    dst[pos - 12] = valB;
+    dst[pos - 11] = valG;
+    dst[pos - 10] = valR;
+    dst[pos - 9]  = 255;
+    convertYUVToRGB8Bit(valY3, curUSample, curVSample, valR, valG, valB, RGBConv, fullRange, bps);
+    dst[pos - 8] = valB;
+    dst[pos - 7] = valG;
+    dst[pos - 6] = valR;
+    dst[pos - 5] = 255;
+    convertYUVToRGB8Bit(valY4, curUSample, curVSample, valR, valG, valB, RGBConv, fullRange, bps);
+    dst[pos - 4] = valB;
+    dst[pos - 3] = valG;
+    dst[pos - 2] = valR;
+    dst[pos - 1] = 255;
+  }
+}
+
+} // namespace
+
+bool isFullRange(const ColorConversion colorConversion)
+{
+  return colorConversion == ColorConversion::BT709_FullRange ||
+         colorConversion == ColorConversion::BT601_FullRange ||
+         colorConversion == ColorConversion::BT2020_FullRange;
+}
+
+bool convertYUVPlanarToARGB(const QByteArray          &sourceBuffer,
+                            unsigned char             *targetBuffer,
+                            const Size                 curFrameSize,
+                            const PixelFormatYUV      &sourceBufferFormat,
+                            const ConversionSettings  &conversionSettings,
+                            const simd::InstructionSet instructionSet)
+{
+  // These are constant for the runtime of this function. This way, the compiler can optimize the
+  // hell out of this function.
+  const auto format        = sourceBufferFormat;
+  const auto interpolation = conversionSettings.chromaInterpolation;
+  const auto component     = conversionSettings.componentDisplayMode;
+  const auto conversion    = conversionSettings.colorConversion;
+  const auto w             = curFrameSize.width;
+  const auto h             = curFrameSize.height;
+
+  // Do we have to apply YUV math?
+  const auto mathY = conversionSettings.mathParameters.at(Component::Luma);
+  const auto mathC = conversionSettings.mathParameters.at(Component::Chroma);
+  // const auto applyMathLuma   = mathY.mathRequired();
+  // const auto applyMathChroma = mathC.mathRequired();
+
+  const auto bps       = format.getBitsPerSample();
+  const bool fullRange = isFullRange(conversionSettings.colorConversion);
+  // const auto yOffset = 16<<(bps-8);
+  // const auto cZero = 128<<(bps-8);
+  const auto inputMax = (1 << bps) - 1;
+
+  // The luma component has full resolution. The size of each chroma components depends on the
+  // subsampling.
+  const auto componentSizeLuma = (w * h);
+  const auto componentSizeChroma =
+      (w / format.getSubsamplingHor()) * (h / format.getSubsamplingVer());
+
+  // How many bytes are in each component?
+  const auto nrBytesLumaPlane   = (bps > 8) ? componentSizeLuma * 2 : componentSizeLuma;
+  const auto nrBytesChromaPlane = (bps > 8) ? componentSizeChroma * 2 : componentSizeChroma;
+
+  // If the U and V (and A if present) components are interlevaed, we have to skip every nth value
+  // in the input when reading U and V
+  const auto inputValSkip = format.isUVInterleaved()
+                                ? ((format.getPlaneOrder() == PlaneOrder::YUV ||
+                                    format.getPlaneOrder() == PlaneOrder::YVU)
+                                       ? 2
+                                       : 3)
+                                : 1;
+
+  // A pointer to the output
+  unsigned char *restrict dst = targetBuffer;
+
+  if (component != ComponentDisplayMode::DisplayAll ||
+      format.getSubsampling() == Subsampling::YUV_400)
+  {
+    // We only display (or there is only) one of the color components (possibly with YUV math)
+    if (component == ComponentDisplayMode::DisplayY ||
+        format.getSubsampling() == Subsampling::YUV_400)
+    {
+      // Luma only. The chroma subsampling does not matter.
+      const unsigned char *restrict srcY = (unsigned char *)sourceBuffer.data();
+      YUVPlaneToRGBMonochrome_444(
+          componentSizeLuma, mathY, srcY, dst, inputMax, bps, format.isBigEndian(), 1, fullRange);
+    }
+    else
+    {
+      // Display only the U or V component
+      bool firstComponent = (((format.getPlaneOrder() == PlaneOrder::YUV ||
+                               format.getPlaneOrder() == PlaneOrder::YUVA) &&
+                              component == ComponentDisplayMode::DisplayCb) ||
+                             ((format.getPlaneOrder() == PlaneOrder::YVU ||
+                               format.getPlaneOrder() == PlaneOrder::YVUA) &&
+                              component == ComponentDisplayMode::DisplayCr));
+
+      int srcOffset = nrBytesLumaPlane;
+      if (!firstComponent)
+      {
+        if (format.isUVInterleaved())
+          srcOffset += (bps > 8) ? 2 : 1;
+        else
+          srcOffset += nrBytesChromaPlane;
+      }
+
+      const unsigned char *restrict srcC = (unsigned char *)sourceBuffer.data() + srcOffset;
+      if (format.getSubsampling() == Subsampling::YUV_444)
+        YUVPlaneToRGBMonochrome_444(componentSizeChroma,
+                                    mathC,
+                                    srcC,
+                                    dst,
+                                    inputMax,
+                                    bps,
+                                    format.isBigEndian(),
+                                    inputValSkip,
+                                    fullRange);
+      else if (format.getSubsampling() == Subsampling::YUV_422)
+        YUVPlaneToRGBMonochrome_422(componentSizeChroma,
+                                    mathC,
+                                    srcC,
+                                    dst,
+                                    inputMax,
+                                    bps,
+                                    format.isBigEndian(),
+                                    inputValSkip,
+                                    fullRange);
+      else if (format.getSubsampling() == Subsampling::YUV_420)
+        YUVPlaneToRGBMonochrome_420(
+            w, h, mathC, srcC, dst, inputMax, bps, format.isBigEndian(), inputValSkip, fullRange);
+      else if (format.getSubsampling() == Subsampling::YUV_440)
+        YUVPlaneToRGBMonochrome_440(
+            w, h, mathC, srcC, dst, inputMax, bps, format.isBigEndian(), inputValSkip, fullRange);
+      else if (format.getSubsampling() == Subsampling::YUV_410)
+        YUVPlaneToRGBMonochrome_410(
+            w, h, mathC, srcC, dst, inputMax, bps, format.isBigEndian(), inputValSkip, fullRange);
+      else if (format.getSubsampling() == Subsampling::YUV_411)
+        YUVPlaneToRGBMonochrome_411(componentSizeChroma,
+                                    mathC,
+                                    srcC,
+                                    dst,
+                                    inputMax,
+                                    bps,
+                                    format.isBigEndian(),
+                                    inputValSkip,
+                                    fullRange);
+      else
+        return false;
+    }
+  }
+  else
+  {
+    // Is the U plane the first or the second?
+    const bool uPlaneFirst =
+        (format.getPlaneOrder() == PlaneOrder::YUV || format.getPlaneOrder() == PlaneOrder::YUVA);
+
+    // In case the U and V (and A if present) components are interleaved, the skip to the next plane
+    // is just 1 (or 2) bytes
+    int nrBytesToNextChromaPlane = nrBytesChromaPlane;
+    if (format.isUVInterleaved())
+      nrBytesToNextChromaPlane = (bps > 8) ? 2 : 1;
+
+    // Get/set the parameters used for YUV -> RGB conversion
+    int RGBConv[5];
+    getColorConversionCoefficients(conversion, RGBConv);
+
+    // Get the pointers to the source planes (8 bit per sample)
+    const unsigned char *restrict srcY = (unsigned char *)sourceBuffer.data();
+    const unsigned char *restrict srcU =
+        uPlaneFirst ? srcY + nrBytesLumaPlane : srcY + nrBytesLumaPlane + nrBytesToNextChromaPlane;
+    const unsigned char *restrict srcV =
+        uPlaneFirst ? srcY + nrBytesLumaPlane + nrBytesToNextChromaPlane : srcY + nrBytesLumaPlane;
+    auto valSkipUV = inputValSkip;
+
+    // If there is a chroma offset, we must resample the chroma components before we convert them
+    // to RGB. If so, the resampled chroma values are saved in these arrays. We only ignore the
+    // chroma offset for other interpolations then nearest neighbor.
+    QByteArray uvPlaneChromaResampled[2];
+    if ((format.getChromaOffset().x != 0 || format.getChromaOffset().y != 0) &&
+        interpolation != ChromaInterpolation::NearestNeighbor)
+    {
+      uvPlaneChromaResampled[0].resize(nrBytesChromaPlane);
+      uvPlaneChromaResampled[1].resize(nrBytesChromaPlane);
+
+      // We have to perform pre-filtering for the U and V positions, because there is an offset
+      // between the pixel positions of Y and U/V
+      unsigned char *restrict dstU = (unsigned char *)uvPlaneChromaResampled[0].data();
+      unsigned char *restrict dstV = (unsigned char *)uvPlaneChromaResampled[1].data();
+
+      UVPlaneResamplingChromaOffset(format,
+                                    w / format.getSubsamplingHor(),
+                                    h / format.getSubsamplingVer(),
+                                    srcU,
+                                    srcV,
+                                    inputValSkip,
+                                    dstU,
+                                    dstV);
+
+      srcU      = dstU;
+      srcV      = dstV;
+      valSkipUV = 1;
+    }
+
+    if (instructionSet != simd::InstructionSet::None &&
+        convertYUVPlanarToARGBSIMD(srcY,
+                                   srcU,
+                                   srcV,
+                                   valSkipUV,
+                                   dst,
+                                   curFrameSize,
+                                   format,
+                                   mathY,
+                                   mathC,
+                                   interpolation,
+                                   RGBConv,
+                                   fullRange,
+                                   instructionSet))
+      return true;
+
+    if (format.getSubsampling() == Subsampling::YUV_444)
+      YUVPlaneToRGB_444(componentSizeLuma,
+                        mathY,
+                        mathC,
+                        srcY,
+                        srcU,
+                        srcV,
+                        dst,
+                        RGBConv,
+                        fullRange,
+                        inputMax,
+                        bps,
+                        format.isBigEndian(),
+                        valSkipUV);
+    else if (format.getSubsampling() == Subsampling::YUV_422)
+      YUVPlaneToRGB_422(w,
+                        h,
+                        mathY,
+                        mathC,
+                        srcY,
+                        srcU,
+                        srcV,
+                        dst,
+                        RGBConv,
+                        fullRange,
+                        inputMax,
+                        interpolation,
+                        bps,
+                        format.isBigEndian(),
+                        valSkipUV);
+    else if (format.getSubsampling() == Subsampling::YUV_420)
+      YUVPlaneToRGB_420(w,
+                        h,
+                        mathY,
+                        mathC,
+                        srcY,
+                        srcU,
+                        srcV,
+                        dst,
+                        RGBConv,
+                        fullRange,
+                        inputMax,
+                        interpolation,
+                        bps,
+                        format.isBigEndian(),
+                        valSkipUV);
+    else if (format.getSubsampling() == Subsampling::YUV_440)
+      YUVPlaneToRGB_440(w,
+                        h,
+                        mathY,
+                        mathC,
+                        srcY,
+                        srcU,
+                        srcV,
+                        dst,
+                        RGBConv,
+                        fullRange,
+                        inputMax,
+                        interpolation,
+                        bps,
+                        format.isBigEndian(),
+                        valSkipUV);
+    else if (format.getSubsampling() == Subsampling::YUV_410)
+      YUVPlaneToRGB_410(w,
+                        h,
+                        mathY,
+                        mathC,
+                        srcY,
+                        srcU,
+                        srcV,
+                        dst,
+                        RGBConv,
+                        fullRange,
+                        inputMax,
+                        interpolation,
+                        bps,
+                        format.isBigEndian(),
+                        valSkipUV);
+    else if (format.getSubsampling() == Subsampling::YUV_411)
+      YUVPlaneToRGB_411(w,
+                        h,
+                        mathY,
+                        mathC,
+                        srcY,
+                        srcU,
+                        srcV,
+                        dst,
+                        RGBConv,
+                        fullRange,
+                        inputMax,
+                        interpolation,
+                        bps,
+                        format.isBigEndian(),
+                        valSkipUV);
+    else
+      return false;
+  }
+
+  return true;
+}
+
+} // namespace video::yuv
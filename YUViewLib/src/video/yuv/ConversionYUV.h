@@ -0,0 +1,146 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/EnumMapper.h>
+#include <common/SIMD.h>
+#include <video/yuv/PixelFormatYUV.h>
+
+#include <QByteArray>
+
+#include <map>
+
+namespace video::yuv
+{
+
+enum class ComponentDisplayMode
+{
+  DisplayAll,
+  DisplayY,
+  DisplayCb,
+  DisplayCr
+};
+
+const EnumMapper<ComponentDisplayMode, 4>
+    ComponentDisplayModeMapper(std::make_pair(ComponentDisplayMode::DisplayAll, "Y'CbCr"sv),
+                               std::make_pair(ComponentDisplayMode::DisplayY, "Luma (Y) Only"sv),
+                               std::make_pair(ComponentDisplayMode::DisplayCb, "Cb only"sv),
+                               std::make_pair(ComponentDisplayMode::DisplayCr, "Cr only"sv));
+
+struct ConversionSettings
+{
+  ChromaInterpolation  chromaInterpolation{ChromaInterpolation::NearestNeighbor};
+  ComponentDisplayMode componentDisplayMode{ComponentDisplayMode::DisplayAll};
+  ColorConversion      colorConversion{ColorConversion::BT709_LimitedRange};
+  // Parameters for the YUV transformation (like scaling, invert, offset). For Luma ([0]) and
+  // chroma([1]).
+  std::map<Component, MathParameters> mathParameters;
+};
+
+bool isFullRange(const ColorConversion colorConversion);
+
+inline int getValueFromSource(const unsigned char *src,
+                              const int            idx,
+                              const int            bps,
+                              const bool           bigEndian)
+{
+  if (bps > 8)
+    // Read two bytes in the right order
+    return (bigEndian) ? src[idx * 2] << 8 | src[idx * 2 + 1]
+                       : src[idx * 2] | src[idx * 2 + 1] << 8;
+  else
+    // Just read one byte
+    return src[idx];
+}
+
+inline void setValueInBuffer(
+    unsigned char *dst, const int val, const int idx, const int bps, const bool bigEndian)
+{
+  if (bps > 8)
+  {
+    // Write two bytes
+    if (bigEndian)
+    {
+      dst[idx * 2]     = val >> 8;
+      dst[idx * 2 + 1] = val & 0xff;
+    }
+    else
+    {
+      dst[idx * 2]     = val & 0xff;
+      dst[idx * 2 + 1] = val >> 8;
+    }
+  }
+  else
+    // Write one byte
+    dst[idx] = val;
+}
+
+/* Apply the given transformation to the YUV sample. If invert is true, the sample is inverted at
+ * the value defined by offset. If the scale is greater one, the values will be amplified relative
+ * to the offset value. The input can be 8 to 16 bit. The output will be of the same bit depth. The
+ * output is clamped to (0...clipMax).
+ */
+inline int transformYUV(const bool         invert,
+                        const int          scale,
+                        const int          offset,
+                        const unsigned int value,
+                        const int          clipMax)
+{
+  int newValue = value;
+  if (invert)
+    newValue = -(newValue - offset) * scale + offset; // Scale + Offset + Invert
+  else
+    newValue = (newValue - offset) * scale + offset; // Scale + Offset
+
+  // Clip to 8 bit
+  if (newValue < 0)
+    newValue = 0;
+  if (newValue > clipMax)
+    newValue = clipMax;
+
+  return newValue;
+}
+
+// Convert the planar YUV data in sourceBuffer to 8 bit BGRA (the layout of a QImage with 32 bit
+// per pixel) in targetBuffer. Chroma up-sampling, YUV math and the display of single components
+// are applied according to the conversion settings. The instruction set selects the code path
+// for the color conversion. Independent of the instruction set, the output is identical.
+bool convertYUVPlanarToARGB(
+    const QByteArray         &sourceBuffer,
+    unsigned char            *targetBuffer,
+    const Size                frameSize,
+    const PixelFormatYUV     &sourceBufferFormat,
+    const ConversionSettings &conversionSettings,
+    const simd::InstructionSet instructionSet = simd::getSupportedInstructionSet());
+
+} // namespace video::yuv
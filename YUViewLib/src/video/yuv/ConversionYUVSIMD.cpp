@@ -0,0 +1,631 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ConversionYUVSIMD.h"
+
+#include <cstdint>
+#include <vector>
+
+#if SIMD_X86
+#include <immintrin.h>
+#endif
+
+#include <common/Functions.h>
+#include <video/yuv/ConversionYUV.h>
+
+namespace video::yuv
+{
+
+#if SIMD_X86
+
+namespace
+{
+
+// The conversion is performed line by line in three steps: Load (and transform) the YUV values of
+// the line into 32 bit integers, up-sample the chroma values to the luma resolution and convert
+// the line to RGB. Loading and the conversion to RGB are performed with SIMD instructions. All
+// steps use the exact same arithmetic as the scalar YUVPlaneToRGB_* functions.
+
+// The constants for the conversion to RGB. See convertYUVToRGB8Bit. For bit depths above 14 bit,
+// the values are reduced by 2 bit first so that the result of the multiplications fits into
+// 32 bit.
+struct ConversionParameters
+{
+  int preShift{};
+  int yOffset{};
+  int cZero{};
+  int shift{};
+  int coef[5]{};
+};
+
+ConversionParameters
+getConversionParameters(const int bps, const bool fullRange, const int RGBConv[5])
+{
+  ConversionParameters parameters;
+  const auto           bitDepth = (bps > 14) ? bps - 2 : bps;
+  parameters.preShift           = (bps > 14) ? 2 : 0;
+  parameters.yOffset            = fullRange ? 0 : 16 << (bitDepth - 8);
+  parameters.cZero              = 128 << (bitDepth - 8);
+  parameters.shift              = 16 + bitDepth - 8;
+  for (int i = 0; i < 5; i++)
+    parameters.coef[i] = RGBConv[i];
+  return parameters;
+}
+
+using LoadLineFunction    = void (*)(const unsigned char *src,
+                                  int32_t             *dst,
+                                  const int            n,
+                                  const int            bps,
+                                  const bool           bigEndian,
+                                  const MathParameters &math,
+                                  const int            inMax);
+using ConvertLineFunction = void (*)(const int32_t              *srcY,
+                                     const int32_t              *srcU,
+                                     const int32_t              *srcV,
+                                     unsigned char              *dst,
+                                     const int                   n,
+                                     const ConversionParameters &parameters);
+
+/// --- Scalar functions (used for interleaved chroma and for the remaining values of a line)
+
+void loadLineScalar(const unsigned char  *src,
+                    int32_t              *dst,
+                    const int             n,
+                    const int             inValSkip,
+                    const int             bps,
+                    const bool            bigEndian,
+                    const MathParameters &math,
+                    const int             inMax)
+{
+  const auto applyMath = math.mathRequired();
+  for (int i = 0; i < n; i++)
+  {
+    int value = getValueFromSource(src, i * inValSkip, bps, bigEndian);
+    if (applyMath)
+      value = transformYUV(math.invert, math.scale, math.offset, value, inMax);
+    dst[i] = value;
+  }
+}
+
+// Just like the scalar conversion, the sums may overflow for very high values and wrap around. We
+// calculate unsigned so that this is well defined and identical to what the SIMD code does.
+inline void convertPixelScalar(const int32_t               valY,
+                               const int32_t               valU,
+                               const int32_t               valV,
+                               const ConversionParameters &p,
+                               unsigned char              *dst)
+{
+  const auto Y_tmp = uint32_t((valY >> p.preShift) - p.yOffset) * uint32_t(p.coef[0]);
+  const auto U_tmp = uint32_t((valU >> p.preShift) - p.cZero);
+  const auto V_tmp = uint32_t((valV >> p.preShift) - p.cZero);
+
+  const auto R_tmp = int32_t(Y_tmp + V_tmp * uint32_t(p.coef[1])) >> p.shift;
+  const auto G_tmp =
+      int32_t(Y_tmp + U_tmp * uint32_t(p.coef[2]) + V_tmp * uint32_t(p.coef[3])) >> p.shift;
+  const auto B_tmp = int32_t(Y_tmp + U_tmp * uint32_t(p.coef[4])) >> p.shift;
+
+  dst[0] = (unsigned char)functions::clip(B_tmp, 0, 255);
+  dst[1] = (unsigned char)functions::clip(G_tmp, 0, 255);
+  dst[2] = (unsigned char)functions::clip(R_tmp, 0, 255);
+  dst[3] = 255;
+}
+
+/// --- SSE4.1
+
+SIMD_TARGET_SSE4_1 inline __m128i applyMathSSE4_1(__m128i       value,
+                                                  const __m128i offset,
+                                                  const __m128i scale,
+                                                  const bool    invert,
+                                                  const __m128i maxValue)
+{
+  value = _mm_mullo_epi32(_mm_sub_epi32(value, offset), scale);
+  if (invert)
+    value = _mm_sub_epi32(_mm_setzero_si128(), value);
+  value = _mm_add_epi32(value, offset);
+  return _mm_min_epi32(_mm_max_epi32(value, _mm_setzero_si128()), maxValue);
+}
+
+SIMD_TARGET_SSE4_1 void loadLineSSE4_1(const unsigned char  *src,
+                                       int32_t              *dst,
+                                       const int             n,
+                                       const int             bps,
+                                       const bool            bigEndian,
+                                       const MathParameters &math,
+                                       const int             inMax)
+{
+  const auto applyMath = math.mathRequired();
+  const auto offset    = _mm_set1_epi32(math.offset);
+  const auto scale     = _mm_set1_epi32(math.scale);
+  const auto maxValue  = _mm_set1_epi32(inMax);
+  const auto swapBytes = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    __m128i values[2];
+    if (bps > 8)
+    {
+      auto samples = _mm_loadu_si128((const __m128i *)(src + i * 2));
+      if (bigEndian)
+        samples = _mm_shuffle_epi8(samples, swapBytes);
+      values[0] = _mm_cvtepu16_epi32(samples);
+      values[1] = _mm_cvtepu16_epi32(_mm_srli_si128(samples, 8));
+    }
+    else
+    {
+      const auto samples = _mm_loadl_epi64((const __m128i *)(src + i));
+      values[0]          = _mm_cvtepu8_epi32(samples);
+      values[1]          = _mm_cvtepu8_epi32(_mm_srli_si128(samples, 4));
+    }
+    for (int k = 0; k < 2; k++)
+    {
+      if (applyMath)
+        values[k] = applyMathSSE4_1(values[k], offset, scale, math.invert, maxValue);
+      _mm_storeu_si128((__m128i *)(dst + i + k * 4), values[k]);
+    }
+  }
+
+  const auto bytesPerSample = (bps > 8) ? 2 : 1;
+  loadLineScalar(src + i * bytesPerSample, dst + i, n - i, 1, bps, bigEndian, math, inMax);
+}
+
+SIMD_TARGET_SSE4_1 void convertLineSSE4_1(const int32_t              *srcY,
+                                          const int32_t              *srcU,
+                                          const int32_t              *srcV,
+                                          unsigned char              *dst,
+                                          const int                   n,
+                                          const ConversionParameters &p)
+{
+  const auto preShift = _mm_cvtsi32_si128(p.preShift);
+  const auto shift    = _mm_cvtsi32_si128(p.shift);
+  const auto yOffset  = _mm_set1_epi32(p.yOffset);
+  const auto cZero    = _mm_set1_epi32(p.cZero);
+  const auto coefY    = _mm_set1_epi32(p.coef[0]);
+  const auto coefRV   = _mm_set1_epi32(p.coef[1]);
+  const auto coefGU   = _mm_set1_epi32(p.coef[2]);
+  const auto coefGV   = _mm_set1_epi32(p.coef[3]);
+  const auto coefBU   = _mm_set1_epi32(p.coef[4]);
+  const auto zero     = _mm_setzero_si128();
+  const auto max8Bit  = _mm_set1_epi32(255);
+  const auto alpha    = _mm_set1_epi16(short(0xff00));
+
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    __m128i valR[2], valG[2], valB[2];
+    for (int k = 0; k < 2; k++)
+    {
+      const auto offset = i + k * 4;
+      auto       Y_tmp  = _mm_srl_epi32(_mm_loadu_si128((const __m128i *)(srcY + offset)), preShift);
+      const auto U_tmp  = _mm_sub_epi32(
+          _mm_srl_epi32(_mm_loadu_si128((const __m128i *)(srcU + offset)), preShift), cZero);
+      const auto V_tmp = _mm_sub_epi32(
+          _mm_srl_epi32(_mm_loadu_si128((const __m128i *)(srcV + offset)), preShift), cZero);
+      Y_tmp = _mm_mullo_epi32(_mm_sub_epi32(Y_tmp, yOffset), coefY);
+
+      const auto R_tmp = _mm_add_epi32(Y_tmp, _mm_mullo_epi32(V_tmp, coefRV));
+      const auto G_tmp = _mm_add_epi32(
+          _mm_add_epi32(Y_tmp, _mm_mullo_epi32(U_tmp, coefGU)), _mm_mullo_epi32(V_tmp, coefGV));
+      const auto B_tmp = _mm_add_epi32(Y_tmp, _mm_mullo_epi32(U_tmp, coefBU));
+
+      valR[k] = _mm_min_epi32(_mm_max_epi32(_mm_sra_epi32(R_tmp, shift), zero), max8Bit);
+      valG[k] = _mm_min_epi32(_mm_max_epi32(_mm_sra_epi32(G_tmp, shift), zero), max8Bit);
+      valB[k] = _mm_min_epi32(_mm_max_epi32(_mm_sra_epi32(B_tmp, shift), zero), max8Bit);
+    }
+
+    // Pack to 16 bit values with B/G and R/A in the low/high byte and interleave them to BGRA
+    const auto R_16 = _mm_packs_epi32(valR[0], valR[1]);
+    const auto G_16 = _mm_packs_epi32(valG[0], valG[1]);
+    const auto B_16 = _mm_packs_epi32(valB[0], valB[1]);
+    const auto BG   = _mm_or_si128(B_16, _mm_slli_epi16(G_16, 8));
+    const auto RA   = _mm_or_si128(R_16, alpha);
+    _mm_storeu_si128((__m128i *)(dst + i * 4), _mm_unpacklo_epi16(BG, RA));
+    _mm_storeu_si128((__m128i *)(dst + i * 4 + 16), _mm_unpackhi_epi16(BG, RA));
+  }
+
+  for (; i < n; i++)
+    convertPixelScalar(srcY[i], srcU[i], srcV[i], p, dst + i * 4);
+}
+
+/// --- AVX2
+
+SIMD_TARGET_AVX2 inline __m256i applyMathAVX2(__m256i       value,
+                                              const __m256i offset,
+                                              const __m256i scale,
+                                              const bool    invert,
+                                              const __m256i maxValue)
+{
+  value = _mm256_mullo_epi32(_mm256_sub_epi32(value, offset), scale);
+  if (invert)
+    value = _mm256_sub_epi32(_mm256_setzero_si256(), value);
+  value = _mm256_add_epi32(value, offset);
+  return _mm256_min_epi32(_mm256_max_epi32(value, _mm256_setzero_si256()), maxValue);
+}
+
+SIMD_TARGET_AVX2 void loadLineAVX2(const unsigned char  *src,
+                                   int32_t              *dst,
+                                   const int             n,
+                                   const int             bps,
+                                   const bool            bigEndian,
+                                   const MathParameters &math,
+                                   const int             inMax)
+{
+  const auto applyMath = math.mathRequired();
+  const auto offset    = _mm256_set1_epi32(math.offset);
+  const auto scale     = _mm256_set1_epi32(math.scale);
+  const auto maxValue  = _mm256_set1_epi32(inMax);
+  const auto swapBytes = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    __m256i values;
+    if (bps > 8)
+    {
+      auto samples = _mm_loadu_si128((const __m128i *)(src + i * 2));
+      if (bigEndian)
+        samples = _mm_shuffle_epi8(samples, swapBytes);
+      values = _mm256_cvtepu16_epi32(samples);
+    }
+    else
+      values = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(src + i)));
+
+    if (applyMath)
+      values = applyMathAVX2(values, offset, scale, math.invert, maxValue);
+    _mm256_storeu_si256((__m256i *)(dst + i), values);
+  }
+
+  const auto bytesPerSample = (bps > 8) ? 2 : 1;
+  loadLineScalar(src + i * bytesPerSample, dst + i, n - i, 1, bps, bigEndian, math, inMax);
+}
+
+SIMD_TARGET_AVX2 void convertLineAVX2(const int32_t              *srcY,
+                                      const int32_t              *srcU,
+                                      const int32_t              *srcV,
+                                      unsigned char              *dst,
+                                      const int                   n,
+                                      const ConversionParameters &p)
+{
+  const auto preShift = _mm_cvtsi32_si128(p.preShift);
+  const auto shift    = _mm_cvtsi32_si128(p.shift);
+  const auto yOffset  = _mm256_set1_epi32(p.yOffset);
+  const auto cZero    = _mm256_set1_epi32(p.cZero);
+  const auto coefY    = _mm256_set1_epi32(p.coef[0]);
+  const auto coefRV   = _mm256_set1_epi32(p.coef[1]);
+  const auto coefGU   = _mm256_set1_epi32(p.coef[2]);
+  const auto coefGV   = _mm256_set1_epi32(p.coef[3]);
+  const auto coefBU   = _mm256_set1_epi32(p.coef[4]);
+  const auto zero     = _mm256_setzero_si256();
+  const auto max8Bit  = _mm256_set1_epi32(255);
+  const auto alpha    = _mm256_set1_epi16(short(0xff00));
+
+  int i = 0;
+  for (; i + 16 <= n; i += 16)
+  {
+    __m256i valR[2], valG[2], valB[2];
+    for (int k = 0; k < 2; k++)
+    {
+      const auto offset = i + k * 8;
+      auto Y_tmp = _mm256_srl_epi32(_mm256_loadu_si256((const __m256i *)(srcY + offset)), preShift);
+      const auto U_tmp = _mm256_sub_epi32(
+          _mm256_srl_epi32(_mm256_loadu_si256((const __m256i *)(srcU + offset)), preShift), cZero);
+      const auto V_tmp = _mm256_sub_epi32(
+          _mm256_srl_epi32(_mm256_loadu_si256((const __m256i *)(srcV + offset)), preShift), cZero);
+      Y_tmp = _mm256_mullo_epi32(_mm256_sub_epi32(Y_tmp, yOffset), coefY);
+
+      const auto R_tmp = _mm256_add_epi32(Y_tmp, _mm256_mullo_epi32(V_tmp, coefRV));
+      const auto G_tmp = _mm256_add_epi32(_mm256_add_epi32(Y_tmp, _mm256_mullo_epi32(U_tmp, coefGU)),
+                                          _mm256_mullo_epi32(V_tmp, coefGV));
+      const auto B_tmp = _mm256_add_epi32(Y_tmp, _mm256_mullo_epi32(U_tmp, coefBU));
+
+      valR[k] = _mm256_min_epi32(_mm256_max_epi32(_mm256_sra_epi32(R_tmp, shift), zero), max8Bit);
+      valG[k] = _mm256_min_epi32(_mm256_max_epi32(_mm256_sra_epi32(G_tmp, shift), zero), max8Bit);
+      valB[k] = _mm256_min_epi32(_mm256_max_epi32(_mm256_sra_epi32(B_tmp, shift), zero), max8Bit);
+    }
+
+    // The packing works within the 128 bit lanes. So after packing, the low lane contains the
+    // values 0-3 and 8-11 and the high lane the values 4-7 and 12-15. The unpacking also works
+    // per lane which puts everything back in order.
+    const auto R_16 = _mm256_packs_epi32(valR[0], valR[1]);
+    const auto G_16 = _mm256_packs_epi32(valG[0], valG[1]);
+    const auto B_16 = _mm256_packs_epi32(valB[0], valB[1]);
+    const auto BG   = _mm256_or_si256(B_16, _mm256_slli_epi16(G_16, 8));
+    const auto RA   = _mm256_or_si256(R_16, alpha);
+    _mm256_storeu_si256((__m256i *)(dst + i * 4), _mm256_unpacklo_epi16(BG, RA));
+    _mm256_storeu_si256((__m256i *)(dst + i * 4 + 32), _mm256_unpackhi_epi16(BG, RA));
+  }
+
+  for (; i < n; i++)
+    convertPixelScalar(srcY[i], srcU[i], srcV[i], p, dst + i * 4);
+}
+
+/// --- Chroma up-sampling
+
+// Same as interpolateUVSampleQ with bilinear interpolation
+inline int32_t interpolateQuarter(const int32_t sample1, const int32_t sample2, const int quarterPos)
+{
+  if (quarterPos == 1)
+    return ((sample1 * 3 + sample2) + 1) >> 2;
+  if (quarterPos == 2)
+    return ((sample1 + sample2) + 1) >> 1;
+  if (quarterPos == 3)
+    return ((sample1 + sample2 * 3) + 1) >> 2;
+  return sample1;
+}
+
+// Up-sample one line of chroma values horizontally by the given factor (2 or 4). On the right
+// border, there is no next value so the last value is held.
+template <int factor>
+void upsampleLineHorizontal(const int32_t *src,
+                            const int      chromaWidth,
+                            const bool     bilinear,
+                            int32_t       *dst)
+{
+  if (!bilinear)
+  {
+    for (int x = 0; x < chromaWidth; x++)
+      for (int k = 0; k < factor; k++)
+        dst[x * factor + k] = src[x];
+    return;
+  }
+
+  for (int x = 0; x < chromaWidth; x++)
+  {
+    const auto cur  = src[x];
+    const auto next = (x < chromaWidth - 1) ? src[x + 1] : cur;
+    for (int k = 0; k < factor; k++)
+      dst[x * factor + k] = interpolateQuarter(cur, next, k * 4 / factor);
+  }
+}
+
+// The odd lines of 4:2:0 with bilinear interpolation. The values between the four neighboring
+// chroma samples are interpolated in 2D (just like interpolateUVSample2D).
+void upsampleLine420Bilinear(const int32_t *line0,
+                             const int32_t *line1,
+                             const int      chromaWidth,
+                             int32_t       *dst)
+{
+  for (int x = 0; x < chromaWidth; x++)
+  {
+    const auto cur0  = line0[x];
+    const auto cur1  = line1[x];
+    const auto next0 = (x < chromaWidth - 1) ? line0[x + 1] : cur0;
+    const auto next1 = (x < chromaWidth - 1) ? line1[x + 1] : cur1;
+    dst[x * 2]       = ((cur0 + cur1) + 1) >> 1;
+    dst[x * 2 + 1]   = ((cur0 + next0 + cur1 + next1) + 2) >> 2;
+  }
+}
+
+void interpolateLinesVertical(const int32_t *line0,
+                              const int32_t *line1,
+                              const int      width,
+                              const int      quarterPos,
+                              int32_t       *dst)
+{
+  for (int x = 0; x < width; x++)
+    dst[x] = interpolateQuarter(line0[x], line1[x], quarterPos);
+}
+
+// Get the chroma values for one luma line. Depending on the subsampling, this is just the loaded
+// chroma line or the up-sampled values in dst.
+const int32_t *getUpsampledChromaLine(const Subsampling subsampling,
+                                      const bool        bilinear,
+                                      const int         phase,
+                                      const int32_t    *line0,
+                                      const int32_t    *line1,
+                                      const int         chromaWidth,
+                                      int32_t          *tmp,
+                                      int32_t          *dst)
+{
+  switch (subsampling)
+  {
+  case Subsampling::YUV_422:
+    upsampleLineHorizontal<2>(line0, chromaWidth, bilinear, dst);
+    return dst;
+  case Subsampling::YUV_411:
+    upsampleLineHorizontal<4>(line0, chromaWidth, bilinear, dst);
+    return dst;
+  case Subsampling::YUV_440:
+    if (!bilinear || phase == 0)
+      return line0;
+    interpolateLinesVertical(line0, line1, chromaWidth, 2, dst);
+    return dst;
+  case Subsampling::YUV_420:
+    if (bilinear && phase == 1)
+      upsampleLine420Bilinear(line0, line1, chromaWidth, dst);
+    else
+      upsampleLineHorizontal<2>(line0, chromaWidth, bilinear, dst);
+    return dst;
+  case Subsampling::YUV_410:
+    if (bilinear)
+    {
+      interpolateLinesVertical(line0, line1, chromaWidth, phase, tmp);
+      upsampleLineHorizontal<4>(tmp, chromaWidth, bilinear, dst);
+    }
+    else
+      upsampleLineHorizontal<4>(line0, chromaWidth, bilinear, dst);
+    return dst;
+  default:
+    return line0;
+  }
+}
+
+} // namespace
+
+#endif // SIMD_X86
+
+bool convertYUVPlanarToARGBSIMD(const unsigned char      *srcY,
+                                const unsigned char      *srcU,
+                                const unsigned char      *srcV,
+                                const int                 inValSkip,
+                                unsigned char            *dst,
+                                const Size                frameSize,
+                                const PixelFormatYUV     &format,
+                                const MathParameters     &mathY,
+                                const MathParameters     &mathC,
+                                const ChromaInterpolation interpolation,
+                                const int                 RGBConv[5],
+                                const bool                fullRange,
+                                const simd::InstructionSet instructionSet)
+{
+#if SIMD_X86
+  LoadLineFunction    loadLine;
+  ConvertLineFunction convertLine;
+  if (instructionSet == simd::InstructionSet::AVX2)
+  {
+    loadLine    = loadLineAVX2;
+    convertLine = convertLineAVX2;
+  }
+  else if (instructionSet == simd::InstructionSet::SSE4_1)
+  {
+    loadLine    = loadLineSSE4_1;
+    convertLine = convertLineSSE4_1;
+  }
+  else
+    return false;
+
+  const auto subsampling = format.getSubsampling();
+  if (subsampling == Subsampling::YUV_400 || subsampling == Subsampling::UNKNOWN)
+    return false;
+
+  const auto w              = int(frameSize.width);
+  const auto h              = int(frameSize.height);
+  const auto subsamplingVer = format.getSubsamplingVer();
+  const auto chromaWidth    = w / format.getSubsamplingHor();
+  const auto chromaHeight   = h / subsamplingVer;
+  const auto bps            = int(format.getBitsPerSample());
+  const auto bigEndian      = format.isBigEndian();
+  const auto inMax          = (1 << bps) - 1;
+  const auto bytesPerSample = (bps > 8) ? 2 : 1;
+  const auto bilinear       = (interpolation == ChromaInterpolation::Bilinear);
+  const auto parameters     = getConversionParameters(bps, fullRange, RGBConv);
+
+  std::vector<int32_t> lineY(w);
+  std::vector<int32_t> upsampledU(w);
+  std::vector<int32_t> upsampledV(w);
+  std::vector<int32_t> tmpU(chromaWidth);
+  std::vector<int32_t> tmpV(chromaWidth);
+
+  // For vertical interpolation we need the current and the next chroma line. Line n is always
+  // kept in slot n % 2 so a line is loaded only once.
+  std::vector<int32_t> chromaU[2] = {std::vector<int32_t>(chromaWidth),
+                                     std::vector<int32_t>(chromaWidth)};
+  std::vector<int32_t> chromaV[2] = {std::vector<int32_t>(chromaWidth),
+                                     std::vector<int32_t>(chromaWidth)};
+  int                  loadedChromaLine[2] = {-1, -1};
+
+  auto getChromaLine = [&](const int line) {
+    const auto slot = line % 2;
+    if (loadedChromaLine[slot] != line)
+    {
+      const auto offset = size_t(line) * chromaWidth * inValSkip * bytesPerSample;
+      if (inValSkip == 1)
+      {
+        loadLine(srcU + offset, chromaU[slot].data(), chromaWidth, bps, bigEndian, mathC, inMax);
+        loadLine(srcV + offset, chromaV[slot].data(), chromaWidth, bps, bigEndian, mathC, inMax);
+      }
+      else
+      {
+        loadLineScalar(srcU + offset,
+                       chromaU[slot].data(),
+                       chromaWidth,
+                       inValSkip,
+                       bps,
+                       bigEndian,
+                       mathC,
+                       inMax);
+        loadLineScalar(srcV + offset,
+                       chromaV[slot].data(),
+                       chromaWidth,
+                       inValSkip,
+                       bps,
+                       bigEndian,
+                       mathC,
+                       inMax);
+      }
+      loadedChromaLine[slot] = line;
+    }
+    return slot;
+  };
+
+  for (int y = 0; y < h; y++)
+  {
+    loadLine(srcY + size_t(y) * w * bytesPerSample, lineY.data(), w, bps, bigEndian, mathY, inMax);
+
+    // In the last chroma line, there is no next line. The current line is held.
+    const auto chromaLine = y / subsamplingVer;
+    const auto phase      = y % subsamplingVer;
+    const auto slot0      = getChromaLine(chromaLine);
+    auto       slot1      = slot0;
+    if (bilinear && subsamplingVer > 1 && chromaLine < chromaHeight - 1)
+      slot1 = getChromaLine(chromaLine + 1);
+
+    const auto lineU = getUpsampledChromaLine(subsampling,
+                                              bilinear,
+                                              phase,
+                                              chromaU[slot0].data(),
+                                              chromaU[slot1].data(),
+                                              chromaWidth,
+                                              tmpU.data(),
+                                              upsampledU.data());
+    const auto lineV = getUpsampledChromaLine(subsampling,
+                                              bilinear,
+                                              phase,
+                                              chromaV[slot0].data(),
+                                              chromaV[slot1].data(),
+                                              chromaWidth,
+                                              tmpV.data(),
+                                              upsampledV.data());
+
+    convertLine(lineY.data(), lineU, lineV, dst + size_t(y) * w * 4, w, parameters);
+  }
+
+  return true;
+#else
+  (void)srcY;
+  (void)srcU;
+  (void)srcV;
+  (void)inValSkip;
+  (void)dst;
+  (void)frameSize;
+  (void)format;
+  (void)mathY;
+  (void)mathC;
+  (void)interpolation;
+  (void)RGBConv;
+  (void)fullRange;
+  (void)instructionSet;
+  return false;
+#endif
+}
+
+} // namespace video::yuv
@@ -0,0 +1,60 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/SIMD.h>
+#include <video/yuv/PixelFormatYUV.h>
+
+namespace video::yuv
+{
+
+// Convert planar YUV (all components displayed) to 8 bit BGRA using the given instruction set.
+// The pointers and the value skip are the same as for the scalar conversion functions: srcU and
+// srcV point to the first U/V value and inValSkip is the distance between two chroma values (1 for
+// separate planes, 2 or 3 if U and V are interleaved). The output is bit exact with the scalar
+// conversion. Returns false if there is no code for the instruction set in this build.
+bool convertYUVPlanarToARGBSIMD(const unsigned char      *srcY,
+                                const unsigned char      *srcU,
+                                const unsigned char      *srcV,
+                                const int                 inValSkip,
+                                unsigned char            *dst,
+                                const Size                frameSize,
+                                const PixelFormatYUV     &format,
+                                const MathParameters     &mathY,
+                                const MathParameters     &mathC,
+                                const ChromaInterpolation interpolation,
+                                const int                 RGBConv[5],
+                                const bool                fullRange,
+                                const simd::InstructionSet instructionSet);
+
+} // namespace video::yuv
@@ -0,0 +1,320 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DifferenceYUV.h"
+
+#include <common/Functions.h>
+#include <common/ParallelFor.h>
+#include <video/yuv/ConversionYUV.h>
+#include <video/yuv/DifferenceYUVSIMD.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace video::yuv
+{
+
+namespace
+{
+
+// The stripes that are processed in parallel are one CTU row high. Since this is a multiple of the
+// block size (4) times any vertical subsampling, each stripe sets its own rows of the block map.
+constexpr unsigned STRIPE_HEIGHT  = 64;
+constexpr unsigned BLOCK_SIZE     = 4;
+constexpr unsigned BLOCKS_PER_CTU = STRIPE_HEIGHT / BLOCK_SIZE;
+constexpr unsigned MAX_NR_PLANES  = 3;
+
+struct InputFormat
+{
+  unsigned bitDepth{};
+  bool     bigEndian{};
+  unsigned shift{};
+};
+
+// The scalar calculation which supports different bit depths and byte orders of the inputs. It
+// performs the same steps as calculateDifferenceLineSIMD.
+void calculateDifferenceLineScalar(const unsigned char *src1,
+                                   const InputFormat   &format1,
+                                   const unsigned char *src2,
+                                   const InputFormat   &format2,
+                                   unsigned char       *dst,
+                                   const int            n,
+                                   const unsigned       bitDepthOut,
+                                   const int            amplificationFactor,
+                                   const unsigned       samplesPerGroup,
+                                   uint8_t             *groupDiffers,
+                                   int64_t             &sumSquaredDifferences)
+{
+  const auto bpsIn1   = int(format1.bitDepth);
+  const auto bpsIn2   = int(format2.bitDepth);
+  const auto bpsOut   = int(bitDepthOut);
+  const int  diffZero = 1 << (bpsOut - 1);
+  const int  maxValue = (1 << bpsOut) - 1;
+  for (int i = 0; i < n; i++)
+  {
+    const auto value1 = getValueFromSource(src1, i, bpsIn1, format1.bigEndian) << format1.shift;
+    const auto value2 = getValueFromSource(src2, i, bpsIn2, format2.bigEndian) << format2.shift;
+
+    auto diff = value1 - value2;
+    if (diff != 0)
+      groupDiffers[unsigned(i) / samplesPerGroup] = 1;
+    sumSquaredDifferences += int64_t(diff) * diff;
+    diff = functions::clip(diff * amplificationFactor + diffZero, 0, maxValue);
+    setValueInBuffer(dst, diff, i, bpsOut, true);
+  }
+}
+
+// Scan the 4x4 blocks of a CTU (in units of blocks) in a quad tree. Blocks outside of the frame
+// are skipped.
+bool findFirstDifferenceInQuadTree(const std::vector<uint8_t> &blockDiffers,
+                                   const unsigned              blocksWide,
+                                   const unsigned              blocksHigh,
+                                   const unsigned              blockX,
+                                   const unsigned              blockY,
+                                   const unsigned              size,
+                                   FirstDifference            &firstDifference)
+{
+  if (blockX >= blocksWide || blockY >= blocksHigh)
+    return false;
+
+  if (size == 1)
+  {
+    if (blockDiffers[size_t(blockY) * blocksWide + blockX])
+    {
+      firstDifference.x = blockX * BLOCK_SIZE;
+      firstDifference.y = blockY * BLOCK_SIZE;
+      return true;
+    }
+    firstDifference.partIndex++;
+    return false;
+  }
+
+  const auto half = size / 2;
+  for (const auto &[offsetX, offsetY] : {std::pair(0u, 0u),
+                                        std::pair(half, 0u),
+                                        std::pair(0u, half),
+                                        std::pair(half, half)})
+    if (findFirstDifferenceInQuadTree(blockDiffers,
+                                      blocksWide,
+                                      blocksHigh,
+                                      blockX + offsetX,
+                                      blockY + offsetY,
+                                      half,
+                                      firstDifference))
+      return true;
+  return false;
+}
+
+std::optional<FirstDifference> findFirstDifference(const std::vector<uint8_t> &blockDiffers,
+                                                   const unsigned              blocksWide,
+                                                   const unsigned              blocksHigh)
+{
+  const auto ctusWide = (blocksWide + BLOCKS_PER_CTU - 1) / BLOCKS_PER_CTU;
+  const auto ctusHigh = (blocksHigh + BLOCKS_PER_CTU - 1) / BLOCKS_PER_CTU;
+  for (unsigned ctuY = 0; ctuY < ctusHigh; ctuY++)
+  {
+    for (unsigned ctuX = 0; ctuX < ctusWide; ctuX++)
+    {
+      FirstDifference firstDifference;
+      firstDifference.ctuIndex = ctuY * ctusWide + ctuX;
+      if (findFirstDifferenceInQuadTree(blockDiffers,
+                                        blocksWide,
+                                        blocksHigh,
+                                        ctuX * BLOCKS_PER_CTU,
+                                        ctuY * BLOCKS_PER_CTU,
+                                        BLOCKS_PER_CTU,
+                                        firstDifference))
+        return firstDifference;
+    }
+  }
+  return {};
+}
+
+} // namespace
+
+bool canCalculateDifferenceYUV(const PixelFormatYUV &format1, const PixelFormatYUV &format2)
+{
+  for (const auto &format : {format1, format2})
+  {
+    if (!format.isValid() || format.getPredefinedFormat() || !format.isPlanar() ||
+        format.isUVInterleaved())
+      return false;
+    if (format.getBitsPerSample() < 8 || format.getBitsPerSample() > 16)
+      return false;
+  }
+  return format1.getSubsampling() == format2.getSubsampling();
+}
+
+std::optional<DifferenceYUV> calculateDifferenceYUV(const QByteArray          &frame1,
+                                                    const PixelFormatYUV      &format1,
+                                                    const Size                &frameSize1,
+                                                    const QByteArray          &frame2,
+                                                    const PixelFormatYUV      &format2,
+                                                    const Size                &frameSize2,
+                                                    const int                  amplificationFactor,
+                                                    const simd::InstructionSet instructionSet)
+{
+  if (!canCalculateDifferenceYUV(format1, format2))
+    return {};
+  if (frame1.size() < format1.bytesPerFrame(frameSize1) ||
+      frame2.size() < format2.bytesPerFrame(frameSize2))
+    return {};
+
+  const auto frameSize = Size(std::min(frameSize1.width, frameSize2.width),
+                              std::min(frameSize1.height, frameSize2.height));
+  if (!frameSize.isValid())
+    return {};
+
+  const auto bitDepthOut = std::max(format1.getBitsPerSample(), format2.getBitsPerSample());
+  const auto inputFormat1 = InputFormat({format1.getBitsPerSample(),
+                                         format1.isBigEndian(),
+                                         bitDepthOut - format1.getBitsPerSample()});
+  const auto inputFormat2 = InputFormat({format2.getBitsPerSample(),
+                                         format2.isBigEndian(),
+                                         bitDepthOut - format2.getBitsPerSample()});
+
+  DifferenceYUV difference;
+  difference.format =
+      PixelFormatYUV(format1.getSubsampling(), bitDepthOut, PlaneOrder::YUV, true);
+  difference.frameSize = frameSize;
+  difference.data.resize(difference.format.bytesPerFrame(frameSize));
+
+  // The SIMD code only supports inputs with the same format (without scaling) in little endian
+  const auto useSIMD = instructionSet != simd::InstructionSet::None &&
+                       inputFormat1.bitDepth == inputFormat2.bitDepth && bitDepthOut < 16 &&
+                       (bitDepthOut == 8 || (!inputFormat1.bigEndian && !inputFormat2.bigEndian));
+  const auto amplification = std::max(1, amplificationFactor);
+
+  const auto nrPlanes       = (format1.getSubsampling() == Subsampling::YUV_400) ? 1u : 3u;
+  const auto subH           = unsigned(format1.getSubsamplingHor());
+  const auto subV           = unsigned(format1.getSubsamplingVer());
+  const auto bytesPerSample = (bitDepthOut > 8) ? 2u : 1u;
+
+  struct Plane
+  {
+    const unsigned char *src1{};
+    size_t               stride1{};
+    const unsigned char *src2{};
+    size_t               stride2{};
+    unsigned char       *dst{};
+  };
+  Plane planes[MAX_NR_PLANES];
+  for (unsigned planeIndex = 0; planeIndex < nrPlanes; planeIndex++)
+  {
+    const auto layout1   = getPlaneLayout(format1, frameSize1, planeIndex);
+    const auto layout2   = getPlaneLayout(format2, frameSize2, planeIndex);
+    const auto layoutOut = getPlaneLayout(difference.format, frameSize, planeIndex);
+
+    auto &plane   = planes[planeIndex];
+    plane.src1    = reinterpret_cast<const unsigned char *>(frame1.constData()) + layout1.offset;
+    plane.stride1 = layout1.stride;
+    plane.src2    = reinterpret_cast<const unsigned char *>(frame2.constData()) + layout2.offset;
+    plane.stride2 = layout2.stride;
+    plane.dst     = reinterpret_cast<unsigned char *>(difference.data.data()) + layoutOut.offset;
+  }
+
+  // For each block of 4x4 luma samples, we note if there is a difference in any component. The
+  // first difference in coding order is searched in this map afterwards.
+  const auto           blocksWide = (frameSize.width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  const auto           blocksHigh = (frameSize.height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  std::vector<uint8_t> blockDiffers(size_t(blocksWide) * blocksHigh, 0);
+
+  const auto nrStripes = (frameSize.height + STRIPE_HEIGHT - 1) / STRIPE_HEIGHT;
+  std::vector<std::array<int64_t, MAX_NR_PLANES>> sumsPerStripe(nrStripes);
+
+  auto processStripe = [&](const unsigned stripe) {
+    auto      &sums       = sumsPerStripe[stripe];
+    const auto stripeEndY = std::min((stripe + 1) * STRIPE_HEIGHT, frameSize.height);
+
+    auto calculateLine = [&](const unsigned plane,
+                             const unsigned y,
+                             const unsigned width,
+                             const unsigned samplesPerGroup,
+                             uint8_t       *groupDiffers) {
+      const auto src1 = planes[plane].src1 + y * planes[plane].stride1;
+      const auto src2 = planes[plane].src2 + y * planes[plane].stride2;
+      const auto dst  = planes[plane].dst + size_t(y) * width * bytesPerSample;
+      if (useSIMD && calculateDifferenceLineSIMD(src1,
+                                                 src2,
+                                                 dst,
+                                                 int(width),
+                                                 bitDepthOut,
+                                                 amplification,
+                                                 samplesPerGroup,
+                                                 groupDiffers,
+                                                 sums[plane],
+                                                 instructionSet))
+        return;
+      calculateDifferenceLineScalar(src1,
+                                    inputFormat1,
+                                    src2,
+                                    inputFormat2,
+                                    dst,
+                                    int(width),
+                                    bitDepthOut,
+                                    amplification,
+                                    samplesPerGroup,
+                                    groupDiffers,
+                                    sums[plane]);
+    };
+
+    for (auto y = stripe * STRIPE_HEIGHT; y < stripeEndY; y++)
+      calculateLine(0,
+                    y,
+                    frameSize.width,
+                    BLOCK_SIZE,
+                    &blockDiffers[size_t(y / BLOCK_SIZE) * blocksWide]);
+
+    if (nrPlanes == 1)
+      return;
+
+    // A block of 4 luma samples is covered by 4 / subH chroma samples. So the groups of chroma
+    // samples directly map to the luma blocks in the same row of blocks.
+    const auto chromaWidth = frameSize.width / subH;
+    for (auto y = stripe * STRIPE_HEIGHT / subV; y < stripeEndY / subV; y++)
+    {
+      const auto blockRow = &blockDiffers[size_t(y * subV / BLOCK_SIZE) * blocksWide];
+      calculateLine(1, y, chromaWidth, BLOCK_SIZE / subH, blockRow);
+      calculateLine(2, y, chromaWidth, BLOCK_SIZE / subH, blockRow);
+    }
+  };
+  functions::parallelFor(nrStripes, processStripe);
+
+  for (const auto &sums : sumsPerStripe)
+    for (unsigned plane = 0; plane < MAX_NR_PLANES; plane++)
+      difference.sumSquaredDifferences[plane] += sums[plane];
+  difference.firstDifference = findFirstDifference(blockDiffers, blocksWide, blocksHigh);
+
+  return difference;
+}
+
+} // namespace video::yuv
@@ -0,0 +1,92 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/SIMD.h>
+#include <video/yuv/PixelFormatYUV.h>
+
+#include <QByteArray>
+
+#include <array>
+#include <optional>
+
+namespace video::yuv
+{
+
+// The position of the first difference in HEVC coding order. The frame is split into CTUs of
+// 64x64 samples which are scanned in raster order. Each CTU is scanned in a quad tree down to
+// blocks of 4x4 samples.
+struct FirstDifference
+{
+  unsigned ctuIndex{};
+  unsigned x{};
+  unsigned y{};
+  // The number of 4x4 blocks without a difference in the CTU before the first difference
+  unsigned partIndex{};
+};
+
+struct DifferenceYUV
+{
+  // The difference (amplified and offset by half the value range) in planar big endian YUV
+  QByteArray     data;
+  PixelFormatYUV format;
+  Size           frameSize;
+
+  // The sum of the squared (not amplified) differences of the Y, U and V plane
+  std::array<int64_t, 3> sumSquaredDifferences{};
+
+  // Not set if the frames are identical
+  std::optional<FirstDifference> firstDifference;
+};
+
+// The difference can be calculated in YUV for planar formats (with separate U and V planes) with
+// the same subsampling.
+bool canCalculateDifferenceYUV(const PixelFormatYUV &format1, const PixelFormatYUV &format2);
+
+// Calculate the difference (frame1 - frame2), the sum of the squared differences and the position
+// of the first difference in one pass over the data. If the frame sizes differ, the top left
+// aligned part that overlaps is compared. If the bit depths differ, the lower bit depth is scaled
+// up. The frame is split into stripes of 64 lines that are processed in parallel in the global
+// thread pool. This function does not depend on any state and can be called from any thread.
+std::optional<DifferenceYUV>
+calculateDifferenceYUV(const QByteArray          &frame1,
+                       const PixelFormatYUV      &format1,
+                       const Size                &frameSize1,
+                       const QByteArray          &frame2,
+                       const PixelFormatYUV      &format2,
+                       const Size                &frameSize2,
+                       const int                  amplificationFactor,
+                       const simd::InstructionSet instructionSet =
+                           simd::getSupportedInstructionSet());
+
+} // namespace video::yuv
@@ -0,0 +1,423 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DifferenceYUVSIMD.h"
+
+#if SIMD_X86
+#include <immintrin.h>
+#endif
+
+#include <common/Functions.h>
+#include <video/yuv/ConversionYUV.h>
+
+namespace video::yuv
+{
+
+#if SIMD_X86
+
+namespace
+{
+
+struct LineParameters
+{
+  unsigned bitDepth{};
+  int      amplificationFactor{};
+  unsigned samplesPerGroup{};
+};
+
+using DifferenceLineFunction = int (*)(const unsigned char  *src1,
+                                       const unsigned char  *src2,
+                                       unsigned char        *dst,
+                                       const int             n,
+                                       const LineParameters &parameters,
+                                       uint8_t              *groupDiffers,
+                                       int64_t              &sumSquaredDifferences);
+
+// The SIMD code calculates the same as the scalar code in calculateDifferenceYUV. In order to
+// multiply in 16 (8 bit) or 32 bit (above 8 bit) without overflows, the difference is limited
+// before the amplification. All differences beyond this limit are clipped to the same output value
+// anyway.
+int getAmplificationLimit(const LineParameters &parameters)
+{
+  return ((1 << parameters.bitDepth) + parameters.amplificationFactor - 1) /
+         parameters.amplificationFactor;
+}
+
+// The mask has one bit per byte of the compared samples. Set groupDiffers for each group of
+// samples that has a bit set in the mask.
+inline void markGroupsWithDifferences(const uint32_t differsMask,
+                                      const unsigned bitsPerGroup,
+                                      const unsigned nrBits,
+                                      uint8_t       *groupDiffers)
+{
+  const auto groupMask = uint32_t((uint64_t(1) << bitsPerGroup) - 1);
+  for (unsigned bit = 0; bit < nrBits; bit += bitsPerGroup)
+    if ((differsMask >> bit) & groupMask)
+      groupDiffers[bit / bitsPerGroup] = 1;
+}
+
+/// --- Scalar function for the remaining samples of a line
+
+void calculateDifferenceLineScalar(const unsigned char  *src1,
+                                   const unsigned char  *src2,
+                                   unsigned char        *dst,
+                                   const int             n,
+                                   const LineParameters &parameters,
+                                   uint8_t              *groupDiffers,
+                                   int64_t              &sumSquaredDifferences)
+{
+  const auto bps      = int(parameters.bitDepth);
+  const int  diffZero = 1 << (bps - 1);
+  const int  maxValue = (1 << bps) - 1;
+  for (int i = 0; i < n; i++)
+  {
+    auto diff = getValueFromSource(src1, i, bps, false) - getValueFromSource(src2, i, bps, false);
+    if (diff != 0)
+      groupDiffers[unsigned(i) / parameters.samplesPerGroup] = 1;
+    sumSquaredDifferences += int64_t(diff) * diff;
+    diff = functions::clip(diff * parameters.amplificationFactor + diffZero, 0, maxValue);
+    setValueInBuffer(dst, diff, i, bps, true);
+  }
+}
+
+/// --- SSE4.1
+
+SIMD_TARGET_SSE4_1 inline int64_t sumLanesSSE4_1(const __m128i sum32)
+{
+  return int64_t(uint32_t(_mm_extract_epi32(sum32, 0))) + uint32_t(_mm_extract_epi32(sum32, 1)) +
+         uint32_t(_mm_extract_epi32(sum32, 2)) + uint32_t(_mm_extract_epi32(sum32, 3));
+}
+
+SIMD_TARGET_SSE4_1 int calculateDifferenceLine8BitSSE4_1(const unsigned char  *src1,
+                                                         const unsigned char  *src2,
+                                                         unsigned char        *dst,
+                                                         const int             n,
+                                                         const LineParameters &parameters,
+                                                         uint8_t              *groupDiffers,
+                                                         int64_t &sumSquaredDifferences)
+{
+  const auto amplify       = parameters.amplificationFactor != 1;
+  const auto limit         = getAmplificationLimit(parameters);
+  const auto maxDiff       = _mm_set1_epi16(int16_t(limit));
+  const auto minDiff       = _mm_set1_epi16(int16_t(-limit));
+  const auto amplification = _mm_set1_epi16(int16_t(parameters.amplificationFactor));
+  const auto diffZero      = _mm_set1_epi16(128);
+
+  // Each 32 bit lane adds up to 4 * 255^2 per iteration. Move the sums to 64 bit before they
+  // can overflow.
+  constexpr int ITERATIONS_PER_SUM = 1024;
+  auto          sum32              = _mm_setzero_si128();
+  int           iterations         = 0;
+
+  int i = 0;
+  for (; i + 16 <= n; i += 16)
+  {
+    const auto samples1 = _mm_loadu_si128((const __m128i *)(src1 + i));
+    const auto samples2 = _mm_loadu_si128((const __m128i *)(src2 + i));
+
+    const auto equalMask = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(samples1, samples2)));
+    if (equalMask != 0xffff)
+      markGroupsWithDifferences(~equalMask & 0xffff,
+                                parameters.samplesPerGroup,
+                                16,
+                                groupDiffers + i / parameters.samplesPerGroup);
+
+    __m128i diff[2];
+    diff[0] = _mm_sub_epi16(_mm_cvtepu8_epi16(samples1), _mm_cvtepu8_epi16(samples2));
+    diff[1] = _mm_sub_epi16(_mm_cvtepu8_epi16(_mm_srli_si128(samples1, 8)),
+                            _mm_cvtepu8_epi16(_mm_srli_si128(samples2, 8)));
+
+    sum32 = _mm_add_epi32(sum32, _mm_madd_epi16(diff[0], diff[0]));
+    sum32 = _mm_add_epi32(sum32, _mm_madd_epi16(diff[1], diff[1]));
+    if (++iterations == ITERATIONS_PER_SUM)
+    {
+      sumSquaredDifferences += sumLanesSSE4_1(sum32);
+      sum32      = _mm_setzero_si128();
+      iterations = 0;
+    }
+
+    for (auto &d : diff)
+    {
+      if (amplify)
+        d = _mm_mullo_epi16(_mm_min_epi16(_mm_max_epi16(d, minDiff), maxDiff), amplification);
+      d = _mm_adds_epi16(d, diffZero);
+    }
+    _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(diff[0], diff[1]));
+  }
+  sumSquaredDifferences += sumLanesSSE4_1(sum32);
+  return i;
+}
+
+SIMD_TARGET_SSE4_1 int calculateDifferenceLineHighBitDepthSSE4_1(const unsigned char  *src1,
+                                                                 const unsigned char  *src2,
+                                                                 unsigned char        *dst,
+                                                                 const int             n,
+                                                                 const LineParameters &parameters,
+                                                                 uint8_t *groupDiffers,
+                                                                 int64_t &sumSquaredDifferences)
+{
+  const auto bitDepth      = parameters.bitDepth;
+  const auto amplify       = parameters.amplificationFactor != 1;
+  const auto limit         = getAmplificationLimit(parameters);
+  const auto maxDiff       = _mm_set1_epi32(limit);
+  const auto minDiff       = _mm_set1_epi32(-limit);
+  const auto amplification = _mm_set1_epi32(parameters.amplificationFactor);
+  const auto diffZero      = _mm_set1_epi32(1 << (bitDepth - 1));
+  const auto maxValue      = _mm_set1_epi32((1 << bitDepth) - 1);
+  const auto swapBytes = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+
+  // With up to 15 bit, the sum of two squared differences still fits into a 32 bit lane. The sums
+  // are moved to 64 bit in every iteration.
+  auto sum64 = _mm_setzero_si128();
+
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    const auto samples1 = _mm_loadu_si128((const __m128i *)(src1 + i * 2));
+    const auto samples2 = _mm_loadu_si128((const __m128i *)(src2 + i * 2));
+
+    const auto equalMask = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi16(samples1, samples2)));
+    if (equalMask != 0xffff)
+      markGroupsWithDifferences(~equalMask & 0xffff,
+                                parameters.samplesPerGroup * 2,
+                                16,
+                                groupDiffers + i / parameters.samplesPerGroup);
+
+    const auto diff    = _mm_sub_epi16(samples1, samples2);
+    const auto squared = _mm_madd_epi16(diff, diff);
+    sum64              = _mm_add_epi64(sum64, _mm_cvtepu32_epi64(squared));
+    sum64              = _mm_add_epi64(sum64, _mm_cvtepu32_epi64(_mm_srli_si128(squared, 8)));
+
+    __m128i diff32[2] = {_mm_cvtepi16_epi32(diff), _mm_cvtepi16_epi32(_mm_srli_si128(diff, 8))};
+    for (auto &d : diff32)
+    {
+      if (amplify)
+        d = _mm_mullo_epi32(_mm_min_epi32(_mm_max_epi32(d, minDiff), maxDiff), amplification);
+      d = _mm_add_epi32(d, diffZero);
+      d = _mm_min_epi32(_mm_max_epi32(d, _mm_setzero_si128()), maxValue);
+    }
+    const auto output = _mm_shuffle_epi8(_mm_packus_epi32(diff32[0], diff32[1]), swapBytes);
+    _mm_storeu_si128((__m128i *)(dst + i * 2), output);
+  }
+  sumSquaredDifferences += _mm_extract_epi64(sum64, 0) + _mm_extract_epi64(sum64, 1);
+  return i;
+}
+
+/// --- AVX2
+
+SIMD_TARGET_AVX2 inline int64_t sumLanesAVX2(const __m256i sum32)
+{
+  const auto sum64 = _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(sum32)),
+                                      _mm256_cvtepu32_epi64(_mm256_extracti128_si256(sum32, 1)));
+  return _mm256_extract_epi64(sum64, 0) + _mm256_extract_epi64(sum64, 1) +
+         _mm256_extract_epi64(sum64, 2) + _mm256_extract_epi64(sum64, 3);
+}
+
+SIMD_TARGET_AVX2 int calculateDifferenceLine8BitAVX2(const unsigned char  *src1,
+                                                     const unsigned char  *src2,
+                                                     unsigned char        *dst,
+                                                     const int             n,
+                                                     const LineParameters &parameters,
+                                                     uint8_t              *groupDiffers,
+                                                     int64_t              &sumSquaredDifferences)
+{
+  const auto amplify       = parameters.amplificationFactor != 1;
+  const auto limit         = getAmplificationLimit(parameters);
+  const auto maxDiff       = _mm256_set1_epi16(int16_t(limit));
+  const auto minDiff       = _mm256_set1_epi16(int16_t(-limit));
+  const auto amplification = _mm256_set1_epi16(int16_t(parameters.amplificationFactor));
+  const auto diffZero      = _mm256_set1_epi16(128);
+
+  constexpr int ITERATIONS_PER_SUM = 1024;
+  auto          sum32              = _mm256_setzero_si256();
+  int           iterations         = 0;
+
+  int i = 0;
+  for (; i + 32 <= n; i += 32)
+  {
+    const auto samples1 = _mm256_loadu_si256((const __m256i *)(src1 + i));
+    const auto samples2 = _mm256_loadu_si256((const __m256i *)(src2 + i));
+
+    const auto equalMask = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(samples1, samples2)));
+    if (equalMask != 0xffffffff)
+      markGroupsWithDifferences(~equalMask,
+                                parameters.samplesPerGroup,
+                                32,
+                                groupDiffers + i / parameters.samplesPerGroup);
+
+    __m256i diff[2];
+    diff[0] = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(samples1)),
+                               _mm256_cvtepu8_epi16(_mm256_castsi256_si128(samples2)));
+    diff[1] = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(samples1, 1)),
+                               _mm256_cvtepu8_epi16(_mm256_extracti128_si256(samples2, 1)));
+
+    sum32 = _mm256_add_epi32(sum32, _mm256_madd_epi16(diff[0], diff[0]));
+    sum32 = _mm256_add_epi32(sum32, _mm256_madd_epi16(diff[1], diff[1]));
+    if (++iterations == ITERATIONS_PER_SUM)
+    {
+      sumSquaredDifferences += sumLanesAVX2(sum32);
+      sum32      = _mm256_setzero_si256();
+      iterations = 0;
+    }
+
+    for (auto &d : diff)
+    {
+      if (amplify)
+        d = _mm256_mullo_epi16(_mm256_min_epi16(_mm256_max_epi16(d, minDiff), maxDiff),
+                               amplification);
+      d = _mm256_adds_epi16(d, diffZero);
+    }
+    // The pack works within the 128 bit lanes. Restore the order of the samples.
+    const auto output = _mm256_permute4x64_epi64(_mm256_packus_epi16(diff[0], diff[1]), 0xd8);
+    _mm256_storeu_si256((__m256i *)(dst + i), output);
+  }
+  sumSquaredDifferences += sumLanesAVX2(sum32);
+  return i;
+}
+
+SIMD_TARGET_AVX2 int calculateDifferenceLineHighBitDepthAVX2(const unsigned char  *src1,
+                                                             const unsigned char  *src2,
+                                                             unsigned char        *dst,
+                                                             const int             n,
+                                                             const LineParameters &parameters,
+                                                             uint8_t              *groupDiffers,
+                                                             int64_t &sumSquaredDifferences)
+{
+  const auto bitDepth      = parameters.bitDepth;
+  const auto amplify       = parameters.amplificationFactor != 1;
+  const auto limit         = getAmplificationLimit(parameters);
+  const auto maxDiff       = _mm256_set1_epi32(limit);
+  const auto minDiff       = _mm256_set1_epi32(-limit);
+  const auto amplification = _mm256_set1_epi32(parameters.amplificationFactor);
+  const auto diffZero      = _mm256_set1_epi32(1 << (bitDepth - 1));
+  const auto maxValue      = _mm256_set1_epi32((1 << bitDepth) - 1);
+  const auto swapBytes     = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                          1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+
+  auto sum64 = _mm256_setzero_si256();
+
+  int i = 0;
+  for (; i + 16 <= n; i += 16)
+  {
+    const auto samples1 = _mm256_loadu_si256((const __m256i *)(src1 + i * 2));
+    const auto samples2 = _mm256_loadu_si256((const __m256i *)(src2 + i * 2));
+
+    const auto equalMask =
+        uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi16(samples1, samples2)));
+    if (equalMask != 0xffffffff)
+      markGroupsWithDifferences(~equalMask,
+                                parameters.samplesPerGroup * 2,
+                                32,
+                                groupDiffers + i / parameters.samplesPerGroup);
+
+    const auto diff    = _mm256_sub_epi16(samples1, samples2);
+    const auto squared = _mm256_madd_epi16(diff, diff);
+    sum64 = _mm256_add_epi64(sum64, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(squared)));
+    sum64 = _mm256_add_epi64(sum64, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(squared, 1)));
+
+    __m256i diff32[2] = {_mm256_cvtepi16_epi32(_mm256_castsi256_si128(diff)),
+                         _mm256_cvtepi16_epi32(_mm256_extracti128_si256(diff, 1))};
+    for (auto &d : diff32)
+    {
+      if (amplify)
+        d = _mm256_mullo_epi32(_mm256_min_epi32(_mm256_max_epi32(d, minDiff), maxDiff),
+                               amplification);
+      d = _mm256_add_epi32(d, diffZero);
+      d = _mm256_min_epi32(_mm256_max_epi32(d, _mm256_setzero_si256()), maxValue);
+    }
+    auto output = _mm256_permute4x64_epi64(_mm256_packus_epi32(diff32[0], diff32[1]), 0xd8);
+    output      = _mm256_shuffle_epi8(output, swapBytes);
+    _mm256_storeu_si256((__m256i *)(dst + i * 2), output);
+  }
+  sumSquaredDifferences += _mm256_extract_epi64(sum64, 0) + _mm256_extract_epi64(sum64, 1) +
+                           _mm256_extract_epi64(sum64, 2) + _mm256_extract_epi64(sum64, 3);
+  return i;
+}
+
+} // namespace
+
+#endif // SIMD_X86
+
+bool calculateDifferenceLineSIMD(const unsigned char       *src1,
+                                 const unsigned char       *src2,
+                                 unsigned char             *dst,
+                                 const int                  n,
+                                 const unsigned             bitDepth,
+                                 const int                  amplificationFactor,
+                                 const unsigned             samplesPerGroup,
+                                 uint8_t                   *groupDiffers,
+                                 int64_t                   &sumSquaredDifferences,
+                                 const simd::InstructionSet instructionSet)
+{
+#if SIMD_X86
+  if (bitDepth < 8 || bitDepth > 15 || amplificationFactor < 1)
+    return false;
+
+  DifferenceLineFunction differenceLine;
+  if (instructionSet == simd::InstructionSet::AVX2)
+    differenceLine = (bitDepth == 8) ? calculateDifferenceLine8BitAVX2
+                                     : calculateDifferenceLineHighBitDepthAVX2;
+  else if (instructionSet == simd::InstructionSet::SSE4_1)
+    differenceLine = (bitDepth == 8) ? calculateDifferenceLine8BitSSE4_1
+                                     : calculateDifferenceLineHighBitDepthSSE4_1;
+  else
+    return false;
+
+  const auto parameters = LineParameters({bitDepth, amplificationFactor, samplesPerGroup});
+  const auto done =
+      differenceLine(src1, src2, dst, n, parameters, groupDiffers, sumSquaredDifferences);
+
+  const auto bytesPerSample = (bitDepth > 8) ? 2 : 1;
+  calculateDifferenceLineScalar(src1 + done * bytesPerSample,
+                                src2 + done * bytesPerSample,
+                                dst + done * bytesPerSample,
+                                n - done,
+                                parameters,
+                                groupDiffers + unsigned(done) / samplesPerGroup,
+                                sumSquaredDifferences);
+  return true;
+#else
+  (void)src1;
+  (void)src2;
+  (void)dst;
+  (void)n;
+  (void)bitDepth;
+  (void)amplificationFactor;
+  (void)samplesPerGroup;
+  (void)groupDiffers;
+  (void)sumSquaredDifferences;
+  (void)instructionSet;
+  return false;
+#endif
+}
+
+} // namespace video::yuv
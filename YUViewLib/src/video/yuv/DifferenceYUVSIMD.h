@@ -0,0 +1,60 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/SIMD.h>
+
+#include <cstdint>
+
+namespace video::yuv
+{
+
+// Calculate the difference (src1 - src2) of n samples of two lines with the same bit depth (8 bit
+// or 9 to 15 bit little endian). The difference is multiplied with the amplification factor,
+// offset by half the value range, clipped and written to dst (big endian above 8 bit). The sum of
+// the squared differences (not amplified) is added to sumSquaredDifferences. For every group of
+// samplesPerGroup (1, 2 or 4) samples with a difference, the corresponding entry in groupDiffers is
+// set to 1. The output is bit exact with the scalar calculation. Returns false if there is no code
+// for the instruction set or the bit depth in this build.
+bool calculateDifferenceLineSIMD(const unsigned char       *src1,
+                                 const unsigned char       *src2,
+                                 unsigned char             *dst,
+                                 const int                  n,
+                                 const unsigned             bitDepth,
+                                 const int                  amplificationFactor,
+                                 const unsigned             samplesPerGroup,
+                                 uint8_t                   *groupDiffers,
+                                 int64_t                   &sumSquaredDifferences,
+                                 const simd::InstructionSet instructionSet);
+
+} // namespace video::yuv
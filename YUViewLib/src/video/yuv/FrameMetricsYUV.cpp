@@ -0,0 +1,249 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrameMetricsYUV.h"
+
+#include <video/yuv/DifferenceYUV.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace video::yuv
+{
+
+namespace
+{
+
+constexpr unsigned SSIM_WINDOW_SIZE = 8;
+
+struct Plane
+{
+  std::vector<int> samples;
+  unsigned         width{};
+  unsigned         height{};
+};
+
+// Read the samples of the given plane (0: Y, 1: U, 2: V) and shift them left by the given amount
+Plane getPlane(const QByteArray &    frame,
+               const PixelFormatYUV &format,
+               const Size &          frameSize,
+               unsigned              planeIndex,
+               unsigned              shift)
+{
+  const auto bytesPerSample = (format.getBitsPerSample() > 8) ? 2u : 1u;
+  const auto bigEndian      = format.isBigEndian();
+  const auto layout         = getPlaneLayout(format, frameSize, planeIndex);
+
+  Plane plane;
+  plane.width  = unsigned(layout.stride / bytesPerSample);
+  plane.height = (planeIndex == 0) ? frameSize.height
+                                   : frameSize.height / unsigned(format.getSubsamplingVer());
+  plane.samples.resize(size_t(plane.width) * plane.height);
+
+  auto src = reinterpret_cast<const unsigned char *>(frame.constData()) + layout.offset;
+  for (auto &sample : plane.samples)
+  {
+    if (bytesPerSample == 1)
+      sample = src[0];
+    else if (bigEndian)
+      sample = (src[0] << 8) | src[1];
+    else
+      sample = (src[1] << 8) | src[0];
+    sample <<= shift;
+    src += bytesPerSample;
+  }
+  return plane;
+}
+
+// The sums over the samples of a window (or a column of a window)
+struct WindowSums
+{
+  int64_t sum1{};
+  int64_t sum2{};
+  int64_t sumSquared1{};
+  int64_t sumSquared2{};
+  int64_t sumProduct{};
+
+  void add(int64_t value1, int64_t value2)
+  {
+    this->sum1 += value1;
+    this->sum2 += value2;
+    this->sumSquared1 += value1 * value1;
+    this->sumSquared2 += value2 * value2;
+    this->sumProduct += value1 * value2;
+  }
+  void add(const WindowSums &other, int64_t sign)
+  {
+    this->sum1 += sign * other.sum1;
+    this->sum2 += sign * other.sum2;
+    this->sumSquared1 += sign * other.sumSquared1;
+    this->sumSquared2 += sign * other.sumSquared2;
+    this->sumProduct += sign * other.sumProduct;
+  }
+};
+
+double calculateWindowSSIM(const WindowSums &sums, double nrSamples, double c1, double c2)
+{
+  const auto mean1      = double(sums.sum1) / nrSamples;
+  const auto mean2      = double(sums.sum2) / nrSamples;
+  const auto variance1  = double(sums.sumSquared1) / nrSamples - mean1 * mean1;
+  const auto variance2  = double(sums.sumSquared2) / nrSamples - mean2 * mean2;
+  const auto covariance = double(sums.sumProduct) / nrSamples - mean1 * mean2;
+
+  return ((2 * mean1 * mean2 + c1) * (2 * covariance + c2)) /
+         ((mean1 * mean1 + mean2 * mean2 + c1) * (variance1 + variance2 + c2));
+}
+
+// The mean SSIM over all 8x8 windows (sliding by one sample). The sums of each column of the
+// windows in the current row are kept and updated when the windows move down by one line.
+double calculateSSIM(const Plane &plane1, const Plane &plane2, int maxValue)
+{
+  if (plane1.width == 0 || plane1.height == 0)
+    return 1.0;
+
+  const auto c1 = std::pow(0.01 * maxValue, 2);
+  const auto c2 = std::pow(0.03 * maxValue, 2);
+
+  // For planes smaller than a window, the window is as large as the plane
+  const auto windowWidth  = std::min(plane1.width, SSIM_WINDOW_SIZE);
+  const auto windowHeight = std::min(plane1.height, SSIM_WINDOW_SIZE);
+  const auto nrSamples    = double(windowWidth * windowHeight);
+
+  std::vector<WindowSums> columnSums(plane1.width);
+
+  auto updateColumnSums = [&](unsigned y, int64_t sign) {
+    const auto row1 = plane1.samples.data() + size_t(y) * plane1.width;
+    const auto row2 = plane2.samples.data() + size_t(y) * plane2.width;
+    for (unsigned x = 0; x < plane1.width; x++)
+    {
+      WindowSums sample;
+      sample.add(row1[x], row2[x]);
+      columnSums[x].add(sample, sign);
+    }
+  };
+
+  for (unsigned y = 0; y + 1 < windowHeight; y++)
+    updateColumnSums(y, 1);
+
+  double ssimSum   = 0.0;
+  size_t nrWindows = 0;
+  for (unsigned windowY = 0; windowY + windowHeight <= plane1.height; windowY++)
+  {
+    updateColumnSums(windowY + windowHeight - 1, 1);
+
+    WindowSums windowSums;
+    for (unsigned x = 0; x + 1 < windowWidth; x++)
+      windowSums.add(columnSums[x], 1);
+    for (unsigned windowX = 0; windowX + windowWidth <= plane1.width; windowX++)
+    {
+      windowSums.add(columnSums[windowX + windowWidth - 1], 1);
+      ssimSum += calculateWindowSSIM(windowSums, nrSamples, c1, c2);
+      nrWindows++;
+      windowSums.add(columnSums[windowX], -1);
+    }
+
+    updateColumnSums(windowY, -1);
+  }
+  return ssimSum / double(nrWindows);
+}
+
+} // namespace
+
+bool canCalculateFrameMetrics(const PixelFormatYUV &format1,
+                              const PixelFormatYUV &format2,
+                              std::string *         whyNot)
+{
+  auto setWhyNot = [whyNot](const std::string &reason) {
+    if (whyNot)
+      *whyNot = reason;
+    return false;
+  };
+
+  // The MSE is calculated from the difference (calculateDifferenceYUV) which supports these formats
+  for (const auto &format : {format1, format2})
+  {
+    if (!format.isValid())
+      return setWhyNot("The YUV format is invalid.");
+    if (format.getPredefinedFormat() || !format.isPlanar() || format.isUVInterleaved())
+      return setWhyNot("The YUV format " + format.getName() +
+                       " is not a planar format with separate U and V planes.");
+    if (format.getBitsPerSample() < 8 || format.getBitsPerSample() > 16)
+      return setWhyNot("Only bit depths from 8 to 16 bit are supported.");
+  }
+  if (format1.getSubsampling() != format2.getSubsampling())
+    return setWhyNot("The subsampling of the two formats differs.");
+  return canCalculateDifferenceYUV(format1, format2);
+}
+
+std::optional<FrameMetrics> calculateFrameMetrics(const QByteArray &    frame1,
+                                                  const PixelFormatYUV &format1,
+                                                  const QByteArray &    frame2,
+                                                  const PixelFormatYUV &format2,
+                                                  const Size &          frameSize)
+{
+  if (!canCalculateFrameMetrics(format1, format2))
+    return {};
+
+  const auto difference =
+      calculateDifferenceYUV(frame1, format1, frameSize, frame2, format2, frameSize, 1);
+  if (!difference)
+    return {};
+
+  const auto bitDepth1 = format1.getBitsPerSample();
+  const auto bitDepth2 = format2.getBitsPerSample();
+  const auto bitDepth  = std::max(bitDepth1, bitDepth2);
+  const auto maxValue  = (1 << bitDepth) - 1;
+
+  const auto nrPlanes = (format1.getSubsampling() == Subsampling::YUV_400) ? 1u : 3u;
+
+  FrameMetrics metrics;
+  for (unsigned planeIndex = 0; planeIndex < nrPlanes; planeIndex++)
+  {
+    const auto plane1 = getPlane(frame1, format1, frameSize, planeIndex, bitDepth - bitDepth1);
+    const auto plane2 = getPlane(frame2, format2, frameSize, planeIndex, bitDepth - bitDepth2);
+
+    PlaneMetrics planeMetrics;
+    if (!plane1.samples.empty())
+      planeMetrics.mse = double(difference->sumSquaredDifferences[planeIndex]) /
+                         double(plane1.samples.size());
+    if (planeMetrics.mse > 0)
+      planeMetrics.psnr = 10 * std::log10(double(maxValue) * maxValue / planeMetrics.mse);
+    else
+      planeMetrics.psnr = std::numeric_limits<double>::infinity();
+    planeMetrics.ssim = calculateSSIM(plane1, plane2, maxValue);
+    metrics.push_back(planeMetrics);
+  }
+  return metrics;
+}
+
+} // namespace video::yuv
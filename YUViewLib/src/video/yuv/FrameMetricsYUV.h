@@ -0,0 +1,72 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "PixelFormatYUV.h"
+
+#include <QByteArray>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace video::yuv
+{
+
+struct PlaneMetrics
+{
+  double mse{};
+  double psnr{}; // Infinite if the planes are identical
+  double ssim{};
+};
+
+// The metrics of the Y, U and V plane (only Y for 4:0:0)
+using FrameMetrics = std::vector<PlaneMetrics>;
+
+// Metrics can be calculated for planar formats (with separate U and V planes) with the same
+// subsampling and 8 to 16 bit. If the bit depths differ, the samples with the lower bit depth are
+// scaled up (like in the difference view).
+bool canCalculateFrameMetrics(const PixelFormatYUV &format1,
+                              const PixelFormatYUV &format2,
+                              std::string *         whyNot = nullptr);
+
+// Calculate the MSE, PSNR and SSIM for each plane of the two frames. The MSE is calculated from the
+// difference of the frames (calculateDifferenceYUV). SSIM is the mean over all 8x8 windows (sliding
+// by one sample). Return nothing if the formats are not supported or the data is too short.
+std::optional<FrameMetrics> calculateFrameMetrics(const QByteArray &    frame1,
+                                                  const PixelFormatYUV &format1,
+                                                  const QByteArray &    frame2,
+                                                  const PixelFormatYUV &format2,
+                                                  const Size &          frameSize);
+
+} // namespace video::yuv
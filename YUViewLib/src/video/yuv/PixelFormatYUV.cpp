@@ -643,4 +643,32 @@ bool PixelFormatYUV::isBytePacking() const
   return this->bytePacking;
 }
 
+PlaneLayout
+getPlaneLayout(const PixelFormatYUV &format, const Size &frameSize, const unsigned planeIndex)
+{
+  const auto bytesPerSample = (format.getBitsPerSample() > 8) ? 2u : 1u;
+  const auto chromaWidth    = frameSize.width / format.getSubsamplingHor();
+  const auto chromaHeight   = frameSize.height / format.getSubsamplingVer();
+  const auto lumaBytes      = size_t(frameSize.width) * frameSize.height * bytesPerSample;
+  const auto hasChroma      = (format.getSubsampling() != Subsampling::YUV_400);
+  const auto chromaBytes =
+      hasChroma ? size_t(chromaWidth) * chromaHeight * bytesPerSample : size_t(0);
+
+  const auto swapUV = (format.getPlaneOrder() == PlaneOrder::YVU ||
+                       format.getPlaneOrder() == PlaneOrder::YVUA);
+
+  PlaneLayout layout;
+  if (planeIndex == 1 || planeIndex == 2)
+  {
+    const auto chromaPlaneIndex = (planeIndex == 1) == swapUV ? 1 : 0;
+    layout.offset               = lumaBytes + chromaPlaneIndex * chromaBytes;
+  }
+  else if (planeIndex == 3)
+    layout.offset = lumaBytes + 2 * chromaBytes;
+
+  const auto isChroma = (planeIndex == 1 || planeIndex == 2);
+  layout.stride       = size_t(isChroma ? chromaWidth : frameSize.width) * bytesPerSample;
+  return layout;
+}
+
 } // namespace video::yuv
@@ -263,4 +263,15 @@ private:
   bool         bytePacking{};
 };
 
+// The position of a plane in a frame of a planar format (without interleaved U/V planes). The planes
+// are indexed as Y, U, V and A independent of the plane order of the format.
+struct PlaneLayout
+{
+  size_t offset{};
+  size_t stride{};
+};
+
+PlaneLayout
+getPlaneLayout(const PixelFormatYUV &format, const Size &frameSize, const unsigned planeIndex);
+
 } // namespace video::yuv
@@ -0,0 +1,423 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ResampleYUV.h"
+
+#include <common/Functions.h>
+#include <common/ParallelFor.h>
+#include <video/yuv/ConversionYUV.h>
+#include <video/yuv/ResampleYUVSIMD.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace video::yuv
+{
+
+namespace
+{
+
+// The stripes of output lines that are processed in parallel. This is a multiple of any vertical
+// subsampling so that each stripe contains whole chroma lines.
+constexpr unsigned STRIPE_HEIGHT = 32;
+
+// The filter coefficients are fixed point values with this precision (the sum of the coefficients
+// of one output sample is 1 << COEFFICIENT_BITS). The intermediate values (after the horizontal
+// filter) have 16 bit precision for any input bit depth. All sums fit into 32 bit.
+constexpr unsigned COEFFICIENT_BITS   = 14;
+constexpr unsigned INTERMEDIATE_BITS  = 16;
+constexpr int      COEFFICIENT_FACTOR = 1 << COEFFICIENT_BITS;
+
+constexpr double PI = 3.14159265358979323846;
+
+double getFilterRadius(const ResampleFilter filter)
+{
+  switch (filter)
+  {
+  case ResampleFilter::Nearest:
+    return 0.5;
+  case ResampleFilter::Bilinear:
+    return 1.0;
+  case ResampleFilter::Bicubic:
+    return 2.0;
+  case ResampleFilter::Lanczos3:
+    return 3.0;
+  }
+  return 1.0;
+}
+
+double sinc(const double x)
+{
+  if (x == 0.0)
+    return 1.0;
+  return std::sin(PI * x) / (PI * x);
+}
+
+double getFilterWeight(const ResampleFilter filter, const double distance)
+{
+  const auto d = std::abs(distance);
+  switch (filter)
+  {
+  case ResampleFilter::Nearest:
+    return (d < 0.5) ? 1.0 : 0.0;
+  case ResampleFilter::Bilinear:
+    return (d < 1.0) ? 1.0 - d : 0.0;
+  case ResampleFilter::Bicubic:
+  {
+    // Cubic convolution (Keys) with a = -0.5
+    constexpr double a = -0.5;
+    if (d < 1.0)
+      return ((a + 2.0) * d - (a + 3.0)) * d * d + 1.0;
+    if (d < 2.0)
+      return (((d - 5.0) * d + 8.0) * d - 4.0) * a;
+    return 0.0;
+  }
+  case ResampleFilter::Lanczos3:
+    return (d < 3.0) ? sinc(d) * sinc(d / 3.0) : 0.0;
+  }
+  return 0.0;
+}
+
+// The filter for one dimension of one plane. For each output position, the filter starts at the
+// input sample start[position]. All input positions outside of the plane are mapped to the first or
+// last sample, so that the filter always reads nrTaps samples from inside of the plane.
+struct FilterTable
+{
+  unsigned             nrTaps{};
+  std::vector<int32_t> start;
+  // The coefficients in the order [position * nrTaps + tap]
+  std::vector<int32_t> coefficients;
+};
+
+// The input sample positions are calculated in luma sample units. A chroma sample i is located at
+// the luma position i * subsampling + offset. The output samples are located in the same way in
+// the output plane.
+FilterTable createFilterTable(const ResampleFilter filter,
+                              const unsigned       inputSize,
+                              const unsigned       outputSize,
+                              const unsigned       subsampling,
+                              const double         offset)
+{
+  const auto scale   = double(inputSize) / double(outputSize);
+  const auto stretch = (filter == ResampleFilter::Nearest) ? 1.0 : std::max(scale, 1.0);
+  const auto radius  = getFilterRadius(filter) * stretch;
+  const auto windowSize =
+      (filter == ResampleFilter::Nearest) ? 1 : int(std::ceil(2.0 * radius)) + 1;
+
+  FilterTable table;
+  table.nrTaps = unsigned(std::min(windowSize, int(inputSize)));
+  table.start.resize(outputSize);
+  table.coefficients.resize(size_t(outputSize) * table.nrTaps);
+
+  std::vector<double> weights(table.nrTaps);
+  for (unsigned position = 0; position < outputSize; position++)
+  {
+    const auto outputPosition = position * subsampling + offset;
+    const auto inputPosition  = (outputPosition + 0.5) * scale - 0.5;
+    const auto center         = (inputPosition - offset) / subsampling;
+
+    const auto firstInput = (filter == ResampleFilter::Nearest)
+                                ? int(std::floor(center + 0.5))
+                                : int(std::floor(center - radius)) + 1;
+    const auto start      = functions::clip(firstInput, 0, int(inputSize - table.nrTaps));
+    table.start[position] = start;
+
+    std::fill(weights.begin(), weights.end(), 0.0);
+    double sum = 0.0;
+    for (int input = firstInput; input < firstInput + windowSize; input++)
+    {
+      const auto weight = getFilterWeight(filter, (input - center) / stretch);
+      weights[functions::clip(input, 0, int(inputSize) - 1) - start] += weight;
+      sum += weight;
+    }
+    if (sum <= 0.0)
+    {
+      // This can only happen for the nearest neighbor filter at the border
+      weights[functions::clip(firstInput, 0, int(inputSize) - 1) - start] = 1.0;
+      sum                                                                 = 1.0;
+    }
+
+    // Quantize the coefficients. The rounding error is added to the largest coefficient so that
+    // the sum is exactly COEFFICIENT_FACTOR.
+    auto     coefficients = &table.coefficients[size_t(position) * table.nrTaps];
+    int      total        = 0;
+    unsigned largest      = 0;
+    for (unsigned t = 0; t < table.nrTaps; t++)
+    {
+      coefficients[t] = int32_t(std::lround(weights[t] / sum * COEFFICIENT_FACTOR));
+      total += coefficients[t];
+      if (coefficients[t] > coefficients[largest])
+        largest = t;
+    }
+    coefficients[largest] += COEFFICIENT_FACTOR - total;
+  }
+  return table;
+}
+
+// For the horizontal filter, the coefficients are needed in the order [tap * outputSize + position]
+std::vector<int32_t> getCoefficientsByTap(const FilterTable &table)
+{
+  const auto           outputSize = table.start.size();
+  std::vector<int32_t> coefficientsByTap(table.coefficients.size());
+  for (size_t position = 0; position < outputSize; position++)
+    for (unsigned t = 0; t < table.nrTaps; t++)
+      coefficientsByTap[t * outputSize + position] =
+          table.coefficients[position * table.nrTaps + t];
+  return coefficientsByTap;
+}
+
+/// --- Scalar filters. They perform the same steps as the functions in ResampleYUVSIMD.
+
+void filterLineHorizontalScalar(const int32_t *src,
+                                const int32_t *start,
+                                const int32_t *coefficients,
+                                const unsigned nrTaps,
+                                const int      width,
+                                const unsigned shift,
+                                int32_t       *dst)
+{
+  const auto rounding = int32_t(1) << (shift - 1);
+  for (int x = 0; x < width; x++)
+  {
+    int32_t sum = 0;
+    for (unsigned t = 0; t < nrTaps; t++)
+      sum += src[start[x] + int(t)] * coefficients[t * width + x];
+    dst[x] = (sum + rounding) >> shift;
+  }
+}
+
+void filterLineVerticalScalar(const int32_t *const *lines,
+                              const int32_t        *coefficients,
+                              const unsigned        nrTaps,
+                              const int             width,
+                              const unsigned        shift,
+                              const int             maxValue,
+                              const int             bitDepth,
+                              const bool            bigEndian,
+                              unsigned char        *dst)
+{
+  const auto rounding = int32_t(1) << (shift - 1);
+  for (int x = 0; x < width; x++)
+  {
+    int32_t sum = 0;
+    for (unsigned t = 0; t < nrTaps; t++)
+      sum += lines[t][x] * coefficients[t];
+    const auto value = functions::clip((sum + rounding) >> shift, 0, maxValue);
+    setValueInBuffer(dst, value, x, bitDepth, bigEndian);
+  }
+}
+
+struct Plane
+{
+  const unsigned char *src{};
+  size_t               srcStride{};
+  unsigned             srcWidth{};
+  unsigned char       *dst{};
+  size_t               dstStride{};
+  unsigned             dstWidth{};
+  unsigned             dstHeight{};
+  // The number of output luma lines per output line of this plane
+  unsigned subsamplingVer{1};
+
+  FilterTable          horizontal;
+  std::vector<int32_t> horizontalCoefficientsByTap;
+  FilterTable          vertical;
+};
+
+} // namespace
+
+bool canResampleYUV(const PixelFormatYUV &format)
+{
+  if (!format.isValid() || format.getPredefinedFormat() || !format.isPlanar() ||
+      format.isUVInterleaved())
+    return false;
+  return format.getBitsPerSample() >= 8 && format.getBitsPerSample() <= 16;
+}
+
+QByteArray resampleYUV(const QByteArray          &frame,
+                       const PixelFormatYUV      &format,
+                       const Size                &frameSize,
+                       const Size                &targetSize,
+                       const ResampleFilter       filter,
+                       const simd::InstructionSet instructionSet)
+{
+  if (!canResampleYUV(format) || !frameSize.isValid() || !targetSize.isValid())
+    return {};
+  if (frame.size() < format.bytesPerFrame(frameSize))
+    return {};
+
+  const auto subH = unsigned(format.getSubsamplingHor());
+  const auto subV = unsigned(format.getSubsamplingVer());
+  if (frameSize.width % subH != 0 || frameSize.height % subV != 0 ||
+      targetSize.width % subH != 0 || targetSize.height % subV != 0)
+    return {};
+
+  const auto bitDepth       = format.getBitsPerSample();
+  const auto bigEndian      = format.isBigEndian();
+  const auto bytesPerSample = (bitDepth > 8) ? 2u : 1u;
+  const auto maxValue       = (1 << bitDepth) - 1;
+
+  // The intermediate values are scaled up to 16 bit and scaled back down after the vertical filter
+  const auto extraBits       = INTERMEDIATE_BITS - bitDepth;
+  const auto shiftHorizontal = COEFFICIENT_BITS - extraBits;
+  const auto shiftVertical   = COEFFICIENT_BITS + extraBits;
+
+  QByteArray output;
+  output.resize(format.bytesPerFrame(targetSize));
+
+  // The chroma offset is given in units of half luma samples
+  const auto chromaOffset = format.getChromaOffset();
+
+  std::vector<unsigned> planeIndices({0});
+  if (format.getSubsampling() != Subsampling::YUV_400)
+    planeIndices.insert(planeIndices.end(), {1, 2});
+  if (format.hasAlpha())
+    planeIndices.push_back(3);
+
+  std::vector<Plane> planes;
+  for (const auto planeIndex : planeIndices)
+  {
+    const auto isChroma  = (planeIndex == 1 || planeIndex == 2);
+    const auto planeSubH = isChroma ? subH : 1u;
+    const auto planeSubV = isChroma ? subV : 1u;
+    const auto offsetX   = isChroma ? chromaOffset.x / 2.0 : 0.0;
+    const auto offsetY   = isChroma ? chromaOffset.y / 2.0 : 0.0;
+
+    const auto layoutIn  = getPlaneLayout(format, frameSize, planeIndex);
+    const auto layoutOut = getPlaneLayout(format, targetSize, planeIndex);
+
+    Plane plane;
+    plane.src       = reinterpret_cast<const unsigned char *>(frame.constData()) + layoutIn.offset;
+    plane.srcStride = layoutIn.stride;
+    plane.srcWidth  = frameSize.width / planeSubH;
+    plane.dst       = reinterpret_cast<unsigned char *>(output.data()) + layoutOut.offset;
+    plane.dstStride = layoutOut.stride;
+    plane.dstWidth  = targetSize.width / planeSubH;
+    plane.dstHeight = targetSize.height / planeSubV;
+
+    plane.subsamplingVer = planeSubV;
+
+    plane.horizontal =
+        createFilterTable(filter, plane.srcWidth, plane.dstWidth, planeSubH, offsetX);
+    plane.horizontalCoefficientsByTap = getCoefficientsByTap(plane.horizontal);
+    plane.vertical                    = createFilterTable(
+        filter, frameSize.height / planeSubV, plane.dstHeight, planeSubV, offsetY);
+    planes.push_back(std::move(plane));
+  }
+
+  auto processStripe = [&](const unsigned stripe) {
+    std::vector<int32_t>         inputLine;
+    std::vector<int32_t>         intermediate;
+    std::vector<const int32_t *> lines;
+
+    for (const auto &plane : planes)
+    {
+      const auto outputBegin = stripe * STRIPE_HEIGHT / plane.subsamplingVer;
+      const auto outputEnd =
+          std::min((stripe + 1) * STRIPE_HEIGHT / plane.subsamplingVer, plane.dstHeight);
+      if (outputBegin >= outputEnd)
+        continue;
+
+      // Filter all input lines that are needed for this stripe horizontally. The start of the
+      // vertical filter is monotonic.
+      const auto &vertical   = plane.vertical;
+      const auto  inputBegin = unsigned(vertical.start[outputBegin]);
+      const auto  inputEnd   = unsigned(vertical.start[outputEnd - 1]) + vertical.nrTaps;
+      const auto  dstWidth   = int(plane.dstWidth);
+
+      inputLine.resize(plane.srcWidth);
+      intermediate.resize(size_t(inputEnd - inputBegin) * plane.dstWidth);
+      for (auto y = inputBegin; y < inputEnd; y++)
+      {
+        const auto src = plane.src + y * plane.srcStride;
+        for (unsigned x = 0; x < plane.srcWidth; x++)
+          inputLine[x] = getValueFromSource(src, int(x), int(bitDepth), bigEndian);
+
+        const auto intermediateLine = &intermediate[size_t(y - inputBegin) * plane.dstWidth];
+        if (filterLineHorizontalSIMD(inputLine.data(),
+                                     plane.horizontal.start.data(),
+                                     plane.horizontalCoefficientsByTap.data(),
+                                     plane.horizontal.nrTaps,
+                                     dstWidth,
+                                     shiftHorizontal,
+                                     intermediateLine,
+                                     instructionSet))
+          continue;
+        filterLineHorizontalScalar(inputLine.data(),
+                                   plane.horizontal.start.data(),
+                                   plane.horizontalCoefficientsByTap.data(),
+                                   plane.horizontal.nrTaps,
+                                   dstWidth,
+                                   shiftHorizontal,
+                                   intermediateLine);
+      }
+
+      lines.resize(vertical.nrTaps);
+      for (auto y = outputBegin; y < outputEnd; y++)
+      {
+        for (unsigned t = 0; t < vertical.nrTaps; t++)
+          lines[t] =
+              &intermediate[size_t(vertical.start[y] + t - inputBegin) * plane.dstWidth];
+        const auto coefficients = &vertical.coefficients[size_t(y) * vertical.nrTaps];
+        const auto dst          = plane.dst + y * plane.dstStride;
+        if (filterLineVerticalSIMD(lines.data(),
+                                   coefficients,
+                                   vertical.nrTaps,
+                                   dstWidth,
+                                   shiftVertical,
+                                   maxValue,
+                                   bytesPerSample,
+                                   bigEndian,
+                                   dst,
+                                   instructionSet))
+          continue;
+        filterLineVerticalScalar(lines.data(),
+                                 coefficients,
+                                 vertical.nrTaps,
+                                 dstWidth,
+                                 shiftVertical,
+                                 maxValue,
+                                 int(bitDepth),
+                                 bigEndian,
+                                 dst);
+      }
+    }
+  };
+
+  const auto nrStripes = (targetSize.height + STRIPE_HEIGHT - 1) / STRIPE_HEIGHT;
+  functions::parallelFor(nrStripes, processStripe);
+
+  return output;
+}
+
+} // namespace video::yuv
@@ -0,0 +1,69 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/SIMD.h>
+#include <video/yuv/PixelFormatYUV.h>
+
+#include <QByteArray>
+
+namespace video::yuv
+{
+
+enum class ResampleFilter
+{
+  Nearest,
+  Bilinear,
+  Bicubic,
+  Lanczos3
+};
+
+// Frames in planar formats (without interleaved U/V planes) with 8 to 16 bit can be resampled.
+bool canResampleYUV(const PixelFormatYUV &format);
+
+// Resample all planes of the frame to the target size using a separable filter. The filter
+// coefficients are calculated once for every output column and row. When downsampling, the filter
+// is stretched so that all input samples contribute to the output. The chroma planes are filtered
+// at the positions of the chroma samples (the chroma offset of the format). The output has the
+// same format as the input, so the bit depth is preserved. The frame is split into stripes of
+// output lines that are processed in parallel in the global thread pool. Returns an empty array if
+// the format is not supported or the target size is not a multiple of the subsampling.
+QByteArray
+resampleYUV(const QByteArray          &frame,
+            const PixelFormatYUV      &format,
+            const Size                &frameSize,
+            const Size                &targetSize,
+            const ResampleFilter       filter,
+            const simd::InstructionSet instructionSet = simd::getSupportedInstructionSet());
+
+} // namespace video::yuv
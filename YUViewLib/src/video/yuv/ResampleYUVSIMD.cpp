@@ -0,0 +1,296 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ResampleYUVSIMD.h"
+
+#if SIMD_X86
+#include <immintrin.h>
+#endif
+
+#include <common/Functions.h>
+#include <video/yuv/ConversionYUV.h>
+
+namespace video::yuv
+{
+
+#if SIMD_X86
+
+namespace
+{
+
+/// --- Scalar functions for the remaining samples of a line
+
+void filterLineHorizontalScalar(const int32_t *src,
+                                const int32_t *start,
+                                const int32_t *coefficients,
+                                const unsigned nrTaps,
+                                const int      begin,
+                                const int      width,
+                                const unsigned shift,
+                                int32_t       *dst)
+{
+  const auto rounding = int32_t(1) << (shift - 1);
+  for (int x = begin; x < width; x++)
+  {
+    int32_t sum = 0;
+    for (unsigned t = 0; t < nrTaps; t++)
+      sum += src[start[x] + int(t)] * coefficients[t * width + x];
+    dst[x] = (sum + rounding) >> shift;
+  }
+}
+
+void filterLineVerticalScalar(const int32_t *const *lines,
+                              const int32_t        *coefficients,
+                              const unsigned        nrTaps,
+                              const int             begin,
+                              const int             width,
+                              const unsigned        shift,
+                              const int             maxValue,
+                              const unsigned        bytesPerSample,
+                              const bool            bigEndian,
+                              unsigned char        *dst)
+{
+  const auto rounding = int32_t(1) << (shift - 1);
+  const auto bps      = (bytesPerSample == 2) ? 16 : 8;
+  for (int x = begin; x < width; x++)
+  {
+    int32_t sum = 0;
+    for (unsigned t = 0; t < nrTaps; t++)
+      sum += lines[t][x] * coefficients[t];
+    const auto value = functions::clip((sum + rounding) >> shift, 0, maxValue);
+    setValueInBuffer(dst, value, x, bps, bigEndian);
+  }
+}
+
+/// --- SSE4.1
+
+SIMD_TARGET_SSE4_1 int filterLineVerticalSSE4_1(const int32_t *const *lines,
+                                                const int32_t        *coefficients,
+                                                const unsigned        nrTaps,
+                                                const int             width,
+                                                const unsigned        shift,
+                                                const int             maxValue,
+                                                const unsigned        bytesPerSample,
+                                                const bool            bigEndian,
+                                                unsigned char        *dst)
+{
+  const auto rounding  = _mm_set1_epi32(1 << (shift - 1));
+  const auto shiftBits = _mm_cvtsi32_si128(int(shift));
+  const auto maxValues = _mm_set1_epi32(maxValue);
+  const auto swapBytes = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+
+  int x = 0;
+  for (; x + 8 <= width; x += 8)
+  {
+    __m128i sum[2] = {rounding, rounding};
+    for (unsigned t = 0; t < nrTaps; t++)
+    {
+      const auto coefficient = _mm_set1_epi32(coefficients[t]);
+      for (int i = 0; i < 2; i++)
+      {
+        const auto values = _mm_loadu_si128((const __m128i *)(lines[t] + x + i * 4));
+        sum[i]            = _mm_add_epi32(sum[i], _mm_mullo_epi32(values, coefficient));
+      }
+    }
+    for (auto &s : sum)
+      s = _mm_min_epi32(_mm_max_epi32(_mm_sra_epi32(s, shiftBits), _mm_setzero_si128()),
+                        maxValues);
+
+    const auto values16 = _mm_packus_epi32(sum[0], sum[1]);
+    if (bytesPerSample == 1)
+      _mm_storel_epi64((__m128i *)(dst + x), _mm_packus_epi16(values16, values16));
+    else
+      _mm_storeu_si128((__m128i *)(dst + x * 2),
+                       bigEndian ? _mm_shuffle_epi8(values16, swapBytes) : values16);
+  }
+  return x;
+}
+
+/// --- AVX2
+
+SIMD_TARGET_AVX2 int filterLineHorizontalAVX2(const int32_t *src,
+                                              const int32_t *start,
+                                              const int32_t *coefficients,
+                                              const unsigned nrTaps,
+                                              const int      width,
+                                              const unsigned shift,
+                                              int32_t       *dst)
+{
+  const auto rounding  = _mm256_set1_epi32(1 << (shift - 1));
+  const auto shiftBits = _mm_cvtsi32_si128(int(shift));
+
+  int x = 0;
+  for (; x + 8 <= width; x += 8)
+  {
+    const auto startIndex = _mm256_loadu_si256((const __m256i *)(start + x));
+    auto       sum        = rounding;
+    for (unsigned t = 0; t < nrTaps; t++)
+    {
+      const auto index  = _mm256_add_epi32(startIndex, _mm256_set1_epi32(int(t)));
+      const auto values = _mm256_i32gather_epi32((const int *)src, index, 4);
+      const auto coefficient =
+          _mm256_loadu_si256((const __m256i *)(coefficients + t * width + x));
+      sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(values, coefficient));
+    }
+    _mm256_storeu_si256((__m256i *)(dst + x), _mm256_sra_epi32(sum, shiftBits));
+  }
+  return x;
+}
+
+SIMD_TARGET_AVX2 int filterLineVerticalAVX2(const int32_t *const *lines,
+                                            const int32_t        *coefficients,
+                                            const unsigned        nrTaps,
+                                            const int             width,
+                                            const unsigned        shift,
+                                            const int             maxValue,
+                                            const unsigned        bytesPerSample,
+                                            const bool            bigEndian,
+                                            unsigned char        *dst)
+{
+  const auto rounding  = _mm256_set1_epi32(1 << (shift - 1));
+  const auto shiftBits = _mm_cvtsi32_si128(int(shift));
+  const auto maxValues = _mm256_set1_epi32(maxValue);
+  const auto swapBytes = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                          1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+
+  int x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    __m256i sum[2] = {rounding, rounding};
+    for (unsigned t = 0; t < nrTaps; t++)
+    {
+      const auto coefficient = _mm256_set1_epi32(coefficients[t]);
+      for (int i = 0; i < 2; i++)
+      {
+        const auto values = _mm256_loadu_si256((const __m256i *)(lines[t] + x + i * 8));
+        sum[i]            = _mm256_add_epi32(sum[i], _mm256_mullo_epi32(values, coefficient));
+      }
+    }
+    for (auto &s : sum)
+      s = _mm256_min_epi32(
+          _mm256_max_epi32(_mm256_sra_epi32(s, shiftBits), _mm256_setzero_si256()), maxValues);
+
+    // The pack works within the 128 bit lanes. Restore the order of the samples.
+    const auto values16 = _mm256_permute4x64_epi64(_mm256_packus_epi32(sum[0], sum[1]), 0xd8);
+    if (bytesPerSample == 1)
+      _mm_storeu_si128((__m128i *)(dst + x),
+                       _mm_packus_epi16(_mm256_castsi256_si128(values16),
+                                        _mm256_extracti128_si256(values16, 1)));
+    else
+      _mm256_storeu_si256((__m256i *)(dst + x * 2),
+                          bigEndian ? _mm256_shuffle_epi8(values16, swapBytes) : values16);
+  }
+  return x;
+}
+
+} // namespace
+
+#endif // SIMD_X86
+
+bool filterLineHorizontalSIMD(const int32_t             *src,
+                              const int32_t             *start,
+                              const int32_t             *coefficients,
+                              const unsigned             nrTaps,
+                              const int                  width,
+                              const unsigned             shift,
+                              int32_t                   *dst,
+                              const simd::InstructionSet instructionSet)
+{
+#if SIMD_X86
+  if (instructionSet != simd::InstructionSet::AVX2)
+    return false;
+
+  const auto done = filterLineHorizontalAVX2(src, start, coefficients, nrTaps, width, shift, dst);
+  filterLineHorizontalScalar(src, start, coefficients, nrTaps, done, width, shift, dst);
+  return true;
+#else
+  (void)src;
+  (void)start;
+  (void)coefficients;
+  (void)nrTaps;
+  (void)width;
+  (void)shift;
+  (void)dst;
+  (void)instructionSet;
+  return false;
+#endif
+}
+
+bool filterLineVerticalSIMD(const int32_t *const      *lines,
+                            const int32_t             *coefficients,
+                            const unsigned             nrTaps,
+                            const int                  width,
+                            const unsigned             shift,
+                            const int                  maxValue,
+                            const unsigned             bytesPerSample,
+                            const bool                 bigEndian,
+                            unsigned char             *dst,
+                            const simd::InstructionSet instructionSet)
+{
+#if SIMD_X86
+  int done;
+  if (instructionSet == simd::InstructionSet::AVX2)
+    done = filterLineVerticalAVX2(
+        lines, coefficients, nrTaps, width, shift, maxValue, bytesPerSample, bigEndian, dst);
+  else if (instructionSet == simd::InstructionSet::SSE4_1)
+    done = filterLineVerticalSSE4_1(
+        lines, coefficients, nrTaps, width, shift, maxValue, bytesPerSample, bigEndian, dst);
+  else
+    return false;
+
+  filterLineVerticalScalar(lines,
+                           coefficients,
+                           nrTaps,
+                           done,
+                           width,
+                           shift,
+                           maxValue,
+                           bytesPerSample,
+                           bigEndian,
+                           dst);
+  return true;
+#else
+  (void)lines;
+  (void)coefficients;
+  (void)nrTaps;
+  (void)width;
+  (void)shift;
+  (void)maxValue;
+  (void)bytesPerSample;
+  (void)bigEndian;
+  (void)dst;
+  (void)instructionSet;
+  return false;
+#endif
+}
+
+} // namespace video::yuv
@@ -0,0 +1,72 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/SIMD.h>
+
+#include <cstdint>
+
+namespace video::yuv
+{
+
+// Filter one line horizontally. For every output position x in [0, width):
+//   dst[x] = (sum(src[start[x] + t] * coefficients[t * width + x]) + rounding) >> shift
+// with t in [0, nrTaps). The result is bit exact with the scalar calculation. Returns false if
+// there is no code for the instruction set in this build. This needs a gather, so only AVX2 is
+// supported.
+bool filterLineHorizontalSIMD(const int32_t             *src,
+                              const int32_t             *start,
+                              const int32_t             *coefficients,
+                              const unsigned             nrTaps,
+                              const int                  width,
+                              const unsigned             shift,
+                              int32_t                   *dst,
+                              const simd::InstructionSet instructionSet);
+
+// Filter width samples vertically from nrTaps lines:
+//   value = (sum(lines[t][x] * coefficients[t]) + rounding) >> shift
+// The values are clipped to [0, maxValue] and written to dst with 1 or 2 bytes per sample (little
+// or big endian). The result is bit exact with the scalar calculation. Returns false if there is no
+// code for the instruction set in this build.
+bool filterLineVerticalSIMD(const int32_t *const      *lines,
+                            const int32_t             *coefficients,
+                            const unsigned             nrTaps,
+                            const int                  width,
+                            const unsigned             shift,
+                            const int                  maxValue,
+                            const unsigned             bytesPerSample,
+                            const bool                 bigEndian,
+                            unsigned char             *dst,
+                            const simd::InstructionSet instructionSet);
+
+} // namespace video::yuv
@@ -38,9 +38,6 @@
 #include <type_traits>
 #include <vector>
 
-#if SSE_CONVERSION_420_ALT
-#include <xmmintrin.h>
-#endif
 #include <QDir>
 #include <QPainter>
 
@@ -113,13 +110,6 @@ template <typename T> double computeMSE(T ptr, T ptr2, int numPixels)
   return (double)sad / numPixels;
 }
 
-bool isFullRange(const ColorConversion colorConversion)
-{
-  return colorConversion == ColorConversion::BT709_FullRange ||
-         colorConversion == ColorConversion::BT601_FullRange ||
-         colorConversion == ColorConversion::BT2020_FullRange;
-}
-
 std::pair<bool, PixelFormatYUV> convertYUVPackedToPlanar(const QByteArray     &sourceBuffer,
                                                          QByteArray           &targetBuffer,
                                                          const Size            curFrameSize,
@@ -441,103 +431,6 @@ bool convertYUV420ToRGB(const QByteArray         &sourceBuffer,
   Q_ASSERT(sourceBuffer.size() >= componentLenghtY + componentLengthUV +
                                       componentLengthUV); // YUV 420 must be (at least) 1.5*Y-area
 
-#if SSE_CONVERSION_420_ALT
-  quint8 *srcYRaw = (quint8 *)sourceBuffer.data();
-  quint8 *srcURaw = srcYRaw + componentLenghtY;
-  quint8 *srcVRaw = srcURaw + componentLengthUV;
-
-  quint8 *dstBuffer       = (quint8 *)targetBuffer.data();
-  quint32 dstBufferStride = frameWidth * 4;
-
-  yuv420_to_argb8888(srcYRaw,
-                     srcURaw,
-                     srcVRaw,
-                     frameWidth,
-                     frameWidth >> 1,
-                     frameWidth,
-                     frameHeight,
-                     dstBuffer,
-                     dstBufferStride);
-  return false;
-#endif
-
-#if SSE_CONVERSION
-  // Try to use SSE. If this fails use conventional algorithm
-
-  if (frameWidth % 32 == 0 && frameHeight % 2 == 0)
-  {
-    // We can use 16byte aligned read/write operations
-
-    quint8 *srcY = (quint8 *)sourceBuffer.data();
-    quint8 *srcU = srcY + componentLenghtY;
-    quint8 *srcV = srcU + componentLengthUV;
-
-    __m128i yMult  = _mm_set_epi16(75, 75, 75, 75, 75, 75, 75, 75);
-    __m128i ySub   = _mm_set_epi16(16, 16, 16, 16, 16, 16, 16, 16);
-    __m128i ugMult = _mm_set_epi16(25, 25, 25, 25, 25, 25, 25, 25);
-    //__m128i sub16  = _mm_set_epi8(16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16);
-    __m128i sub128 = _mm_set_epi8(
-        128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128);
-
-    //__m128i test = _mm_set_epi8(128, 0, 1, 2, 3, 245, 254, 255, 128, 128, 128, 128, 128, 128, 128,
-    // 128);
-
-    __m128i y, u, v, uMult, vMult;
-    __m128i RGBOut0, RGBOut1, RGBOut2;
-    __m128i tmp;
-
-    for (int yh = 0; yh < frameHeight / 2; yh++)
-    {
-      for (int x = 0; x < frameWidth / 32; x += 32)
-      {
-        // Load 16 bytes U/V
-        u = _mm_load_si128((__m128i *)&srcU[x / 2]);
-        v = _mm_load_si128((__m128i *)&srcV[x / 2]);
-        // Subtract 128 from each U/V value (16 values)
-        u = _mm_sub_epi8(u, sub128);
-        v = _mm_sub_epi8(v, sub128);
-
-        // Load 16 bytes Y from this line and the next one
-        y = _mm_load_si128((__m128i *)&srcY[x]);
-
-        // Get the lower 8 (8bit signed) Y values and put them into a 16bit register
-        tmp = _mm_srai_epi16(_mm_unpacklo_epi8(y, y), 8);
-        // Subtract 16 and multiply by 75
-        tmp = _mm_sub_epi16(tmp, ySub);
-        tmp = _mm_mullo_epi16(tmp, yMult);
-
-        // Now to add them to the 16 bit RGB output values
-        RGBOut0 = _mm_shuffle_epi32(tmp, _MM_SHUFFLE(1, 0, 1, 0));
-        RGBOut0 = _mm_shufflelo_epi16(RGBOut0, _MM_SHUFFLE(1, 0, 0, 0));
-        RGBOut0 = _mm_shufflehi_epi16(RGBOut0, _MM_SHUFFLE(2, 2, 1, 1));
-
-        RGBOut1 = _mm_shuffle_epi32(tmp, _MM_SHUFFLE(2, 1, 2, 1));
-        RGBOut1 = _mm_shufflelo_epi16(RGBOut1, _MM_SHUFFLE(1, 1, 1, 0));
-        RGBOut1 = _mm_shufflehi_epi16(RGBOut1, _MM_SHUFFLE(3, 2, 2, 2));
-
-        RGBOut2 = _mm_shuffle_epi32(tmp, _MM_SHUFFLE(3, 2, 3, 2));
-        RGBOut2 = _mm_shufflelo_epi16(RGBOut2, _MM_SHUFFLE(2, 2, 1, 1));
-        RGBOut2 = _mm_shufflehi_epi16(RGBOut2, _MM_SHUFFLE(3, 3, 3, 2));
-
-        // y2 = _mm_load_si128((__m128i *) &srcY[x + 16]);
-
-        // --- Start with the left 8 values from U/V
-
-        // Get the lower 8 (8bit signed) U/V values and put them into a 16bit register
-        uMult = _mm_srai_epi16(_mm_unpacklo_epi8(u, u), 8);
-        vMult = _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
-
-        // Multiply
-
-        /*y3 = _mm_load_si128((__m128i *) &srcY[x + frameWidth]);
-        y4 = _mm_load_si128((__m128i *) &srcY[x + frameWidth + 16]);*/
-      }
-    }
-
-    return true;
-  }
-#endif
-
   static unsigned char *clip_buf = clp_buf + 384;
   if (!clp_buf_initialized)
     initClippingTable();
@@ -643,1726 +536,6 @@ bool convertYUV420ToRGB(const QByteArray         &sourceBuffer,
   return true;
 }
 
-inline int clip8Bit(int val)
-{
-  if (val < 0)
-    return 0;
-  if (val > 255)
-    return 255;
-  return val;
-}
-
-/* Apply the given transformation to the YUV sample. If invert is true, the sample is inverted at
- * the value defined by offset. If the scale is greater one, the values will be amplified relative
- * to the offset value. The input can be 8 to 16 bit. The output will be of the same bit depth. The
- * output is clamped to (0...clipMax).
- */
-inline int transformYUV(const bool         invert,
-                        const int          scale,
-                        const int          offset,
-                        const unsigned int value,
-                        const int          clipMax)
-{
-  int newValue = value;
-  if (invert)
-    newValue = -(newValue - offset) * scale + offset; // Scale + Offset + Invert
-  else
-    newValue = (newValue - offset) * scale + offset; // Scale + Offset
-
-  // Clip to 8 bit
-  if (newValue < 0)
-    newValue = 0;
-  if (newValue > clipMax)
-    newValue = clipMax;
-
-  return newValue;
-}
-
-inline void convertYUVToRGB8Bit(const unsigned int valY,
-                                const unsigned int valU,
-                                const unsigned int valV,
-                                int               &valR,
-                                int               &valG,
-                                int               &valB,
-                                const int          RGBConv[5],
-                                const bool         fullRange,
-                                const int          bps)
-{
-  if (bps > 14)
-  {
-    // The bit depth of an int (32) is not enough to perform a YUV -> RGB conversion for a bit depth
-    // > 14 bits. We could use 64 bit values but for what? We are clipping the result to 8 bit
-    // anyways so let's just get rid of 2 of the bits for the YUV values.
-    const int yOffset = (fullRange ? 0 : 16 << (bps - 10));
-    const int cZero   = 128 << (bps - 10);
-
-    const int Y_tmp = ((valY >> 2) - yOffset) * RGBConv[0];
-    const int U_tmp = (valU >> 2) - cZero;
-    const int V_tmp = (valV >> 2) - cZero;
-
-    const int R_tmp = (Y_tmp + V_tmp * RGBConv[1]) >>
-                      (16 + bps - 10); // 32 to 16 bit conversion by right shifting
-    const int G_tmp = (Y_tmp + U_tmp * RGBConv[2] + V_tmp * RGBConv[3]) >> (16 + bps - 10);
-    const int B_tmp = (Y_tmp + U_tmp * RGBConv[4]) >> (16 + bps - 10);
-
-    valR = (R_tmp < 0) ? 0 : (R_tmp > 255) ? 255 : R_tmp;
-    valG = (G_tmp < 0) ? 0 : (G_tmp > 255) ? 255 : G_tmp;
-    valB = (B_tmp < 0) ? 0 : (B_tmp > 255) ? 255 : B_tmp;
-  }
-  else
-  {
-    const int yOffset = (fullRange ? 0 : 16 << (bps - 8));
-    const int cZero   = 128 << (bps - 8);
-
-    const int Y_tmp = (valY - yOffset) * RGBConv[0];
-    const int U_tmp = valU - cZero;
-    const int V_tmp = valV - cZero;
-
-    const int R_tmp =
-        (Y_tmp + V_tmp * RGBConv[1]) >> (16 + bps - 8); // 32 to 16 bit conversion by right shifting
-    const int G_tmp = (Y_tmp + U_tmp * RGBConv[2] + V_tmp * RGBConv[3]) >> (16 + bps - 8);
-    const int B_tmp = (Y_tmp + U_tmp * RGBConv[4]) >> (16 + bps - 8);
-
-    valR = (R_tmp < 0) ? 0 : (R_tmp > 255) ? 255 : R_tmp;
-    valG = (G_tmp < 0) ? 0 : (G_tmp > 255) ? 255 : G_tmp;
-    valB = (B_tmp < 0) ? 0 : (B_tmp > 255) ? 255 : B_tmp;
-  }
-}
-
-inline int getValueFromSource(const unsigned char *restrict src,
-                              const int  idx,
-                              const int  bps,
-                              const bool bigEndian)
-{
-  if (bps > 8)
-    // Read two bytes in the right order
-    return (bigEndian) ? src[idx * 2] << 8 | src[idx * 2 + 1]
-                       : src[idx * 2] | src[idx * 2 + 1] << 8;
-  else
-    // Just read one byte
-    return src[idx];
-}
-
-inline void setValueInBuffer(
-    unsigned char *restrict dst, const int val, const int idx, const int bps, const bool bigEndian)
-{
-  if (bps > 8)
-  {
-    // Write two bytes
-    if (bigEndian)
-    {
-      dst[idx * 2]     = val >> 8;
-      dst[idx * 2 + 1] = val & 0xff;
-    }
-    else
-    {
-      dst[idx * 2]     = val & 0xff;
-      dst[idx * 2 + 1] = val >> 8;
-    }
-  }
-  else
-    // Write one byte
-    dst[idx] = val;
-}
-
-// For every input sample in src, apply YUV transformation, (scale to 8 bit if required) and set the
-// value as RGB (monochrome). inValSkip: skip this many values in the input for every value. For
-// pure planar formats, this 1. If the UV components are interleaved, this is 2 or 3.
-inline void YUVPlaneToRGBMonochrome_444(const int            componentSize,
-                                        const MathParameters math,
-                                        const unsigned char *restrict src,
-                                        unsigned char *restrict dst,
-                                        const int  inMax,
-                                        const int  bps,
-                                        const bool bigEndian,
-                                        const int  inValSkip,
-                                        const bool fullRange)
-{
-  const bool applyMath   = math.mathRequired();
-  const int  shiftTo8Bit = bps - 8;
-  for (int i = 0; i < componentSize; ++i)
-  {
-    int newVal = getValueFromSource(src, i * inValSkip, bps, bigEndian);
-    if (applyMath)
-      newVal = transformYUV(math.invert, math.scale, math.offset, newVal, inMax);
-
-    if (shiftTo8Bit > 0)
-      newVal = clip8Bit(newVal >> shiftTo8Bit);
-    if (!fullRange)
-      newVal = LimitedRangeToFullRange.at(newVal);
-
-    // Set the value for R, G and B (BGRA)
-    dst[i * 4]     = (unsigned char)newVal;
-    dst[i * 4 + 1] = (unsigned char)newVal;
-    dst[i * 4 + 2] = (unsigned char)newVal;
-    dst[i * 4 + 3] = (unsigned char)255;
-  }
-}
-
-// For every input sample in the YZV 422 src, apply interpolation (sample and hold), apply YUV
-// transformation, (scale to 8 bit if required) and set the value as RGB (monochrome).
-inline void YUVPlaneToRGBMonochrome_422(const int            componentSize,
-                                        const MathParameters math,
-                                        const unsigned char *restrict src,
-                                        unsigned char *restrict dst,
-                                        const int  inMax,
-                                        const int  bps,
-                                        const bool bigEndian,
-                                        const int  inValSkip,
-                                        const bool fullRange)
-{
-  const bool applyMath   = math.mathRequired();
-  const int  shiftTo8Bit = bps - 8;
-  for (int i = 0; i < componentSize; ++i)
-  {
-    int newVal = getValueFromSource(src, i * inValSkip, bps, bigEndian);
-    if (applyMath)
-      newVal = transformYUV(math.invert, math.scale, math.offset, newVal, inMax);
-
-    if (shiftTo8Bit > 0)
-      newVal = clip8Bit(newVal >> shiftTo8Bit);
-    if (!fullRange)
-      newVal = LimitedRangeToFullRange.at(newVal);
-
-    // Set the value for R, G and B of 2 pixels (BGRA)
-    dst[i * 8]     = (unsigned char)newVal;
-    dst[i * 8 + 1] = (unsigned char)newVal;
-    dst[i * 8 + 2] = (unsigned char)newVal;
-    dst[i * 8 + 3] = (unsigned char)255;
-    dst[i * 8 + 4] = (unsigned char)newVal;
-    dst[i * 8 + 5] = (unsigned char)newVal;
-    dst[i * 8 + 6] = (unsigned char)newVal;
-    dst[i * 8 + 7] = (unsigned char)255;
-  }
-}
-
-inline void YUVPlaneToRGBMonochrome_420(const int            w,
-                                        const int            h,
-                                        const MathParameters math,
-                                        const unsigned char *restrict src,
-                                        unsigned char *restrict dst,
-                                        const int  inMax,
-                                        const int  bps,
-                                        const bool bigEndian,
-                                        const int  inValSkip,
-                                        const bool fullRange)
-{
-  const bool applyMath   = math.mathRequired();
-  const int  shiftTo8Bit = bps - 8;
-  for (int y = 0; y < h / 2; y++)
-    for (int x = 0; x < w / 2; x++)
-    {
-      const int srcIdx = y * (w / 2) + x;
-      int       newVal = getValueFromSource(src, srcIdx * inValSkip, bps, bigEndian);
-      if (applyMath)
-        newVal = transformYUV(math.invert, math.scale, math.offset, newVal, inMax);
-
-      if (shiftTo8Bit > 0)
-        newVal = clip8Bit(newVal >> shiftTo8Bit);
-      if (!fullRange)
-        newVal = LimitedRangeToFullRange.at(newVal);
-
-      // Set the value for R, G and B of 4 pixels (BGRA)
-      int o      = (y * 2 * w + x * 2) * 4;
-      dst[o]     = (unsigned char)newVal;
-      dst[o + 1] = (unsigned char)newVal;
-      dst[o + 2] = (unsigned char)newVal;
-      dst[o + 3] = (unsigned char)255;
-      dst[o + 4] = (unsigned char)newVal;
-      dst[o + 5] = (unsigned char)newVal;
-      dst[o + 6] = (unsigned char)newVal;
-      dst[o + 7] = (unsigned char)255;
-      o += w * 4; // Goto next line
-      dst[o]     = (unsigned char)newVal;
-      dst[o + 1] = (unsigned char)newVal;
-      dst[o + 2] = (unsigned char)newVal;
-      dst[o + 3] = (unsigned char)255;
-      dst[o + 4] = (unsigned char)newVal;
-      dst[o + 5] = (unsigned char)newVal;
-      dst[o + 6] = (unsigned char)newVal;
-      dst[o + 7] = (unsigned char)255;
-    }
-}
-
-inline void YUVPlaneToRGBMonochrome_440(const int            w,
-                                        const int            h,
-                                        const MathParameters math,
-                                        const unsigned char *restrict src,
-                                        unsigned char *restrict dst,
-                                        const int  inMax,
-                                        const int  bps,
-                                        const bool bigEndian,
-                                        const int  inValSkip,
-                                        const bool fullRange)
-{
-  const bool applyMath   = math.mathRequired();
-  const int  shiftTo8Bit = bps - 8;
-  for (int y = 0; y < h / 2; y++)
-    for (int x = 0; x < w; x++)
-    {
-      const int srcIdx = y * w + x;
-      int       newVal = getValueFromSource(src, srcIdx * inValSkip, bps, bigEndian);
-      if (applyMath)
-        newVal = transformYUV(math.invert, math.scale, math.offset, newVal, inMax);
-
-      if (shiftTo8Bit > 0)
-        newVal = clip8Bit(newVal >> shiftTo8Bit);
-      if (!fullRange)
-        newVal = LimitedRangeToFullRange.at(newVal);
-
-      // Set the value for R, G and B of 2 pixels (BGRA)
-      const int pos1 = (y * 2 * w + x) * 4;
-      const int pos2 = pos1 + w * 4; // Next line
-      dst[pos1]      = (unsigned char)newVal;
-      dst[pos1 + 1]  = (unsigned char)newVal;
-      dst[pos1 + 2]  = (unsigned char)newVal;
-      dst[pos1 + 3]  = (unsigned char)255;
-      dst[pos2]      = (unsigned char)newVal;
-      dst[pos2 + 1]  = (unsigned char)newVal;
-      dst[pos2 + 2]  = (unsigned char)newVal;
-      dst[pos2 + 3]  = (unsigned char)255;
-    }
-}
-
-inline void YUVPlaneToRGBMonochrome_410(const int            w,
-                                        const int            h,
-                                        const MathParameters math,
-                                        const unsigned char *restrict src,
-                                        unsigned char *restrict dst,
-                                        const int  inMax,
-                                        const int  bps,
-                                        const bool bigEndian,
-                                        const int  inValSkip,
-                                        const bool fullRange)
-{
-  // Horizontal subsampling by 4, vertical subsampling by 4
-  const bool applyMath   = math.mathRequired();
-  const int  shiftTo8Bit = bps - 8;
-  for (int y = 0; y < h / 4; y++)
-    for (int x = 0; x < w / 4; x++)
-    {
-      const int srcIdx = y * (w / 4) + x;
-      int       newVal = getValueFromSource(src, srcIdx * inValSkip, bps, bigEndian);
-
-      if (applyMath)
-        newVal = transformYUV(math.invert, math.scale, math.offset, newVal, inMax);
-
-      if (shiftTo8Bit > 0)
-        newVal = clip8Bit(newVal >> shiftTo8Bit);
-      if (!fullRange)
-        newVal = LimitedRangeToFullRange.at(newVal);
-
-      // Set the value as RGB for 4 pixels in this line and the next 3 lines (BGRA)
-      for (int yo = 0; yo < 4; yo++)
-        for (int xo = 0; xo < 4; xo++)
-        {
-          const int pos = ((y * 4 + yo) * w + (x * 4 + xo)) * 4;
-          dst[pos]      = (unsigned char)newVal;
-          dst[pos + 1]  = (unsigned char)newVal;
-          dst[pos + 2]  = (unsigned char)newVal;
-          dst[pos + 3]  = (unsigned char)255;
-        }
-    }
-}
-
-inline void YUVPlaneToRGBMonochrome_411(const int            componentSize,
-                                        const MathParameters math,
-                                        const unsigned char *restrict src,
-                                        unsigned char *restrict dst,
-                                        const int  inMax,
-                                        const int  bps,
-                                        const bool bigEndian,
-                                        const int  inValSkip,
-                                        const bool fullRange)
-{
-  // Horizontally U and V are subsampled by 4
-  const bool applyMath   = math.mathRequired();
-  const int  shiftTo8Bit = bps - 8;
-  for (int i = 0; i < componentSize; ++i)
-  {
-    int newVal = getValueFromSource(src, i * inValSkip, bps, bigEndian);
-    if (applyMath)
-      newVal = transformYUV(math.invert, math.scale, math.offset, newVal, inMax);
-
-    if (shiftTo8Bit > 0)
-      newVal = clip8Bit(newVal >> shiftTo8Bit);
-    if (!fullRange)
-      newVal = LimitedRangeToFullRange.at(newVal);
-
-    // Set the value for R, G and B of 4 pixels (BGRA)
-    dst[i * 16]      = (unsigned char)newVal;
-    dst[i * 16 + 1]  = (unsigned char)newVal;
-    dst[i * 16 + 2]  = (unsigned char)newVal;
-    dst[i * 16 + 3]  = (unsigned char)255;
-    dst[i * 16 + 4]  = (unsigned char)newVal;
-    dst[i * 16 + 5]  = (unsigned char)newVal;
-    dst[i * 16 + 6]  = (unsigned char)newVal;
-    dst[i * 16 + 7]  = (unsigned char)255;
-    dst[i * 16 + 8]  = (unsigned char)newVal;
-    dst[i * 16 + 9]  = (unsigned char)newVal;
-    dst[i * 16 + 10] = (unsigned char)newVal;
-    dst[i * 16 + 11] = (unsigned char)255;
-    dst[i * 16 + 12] = (unsigned char)newVal;
-    dst[i * 16 + 13] = (unsigned char)newVal;
-    dst[i * 16 + 14] = (unsigned char)newVal;
-    dst[i * 16 + 15] = (unsigned char)255;
-  }
-}
-
-inline int interpolateUVSample(const ChromaInterpolation mode, const int sample1, const int sample2)
-{
-  if (mode == ChromaInterpolation::Bilinear)
-    // Interpolate linearly between sample1 and sample2
-    return ((sample1 + sample2) + 1) >> 1;
-  return sample1; // Sample and hold
-}
-
-inline int interpolateUVSampleQ(const ChromaInterpolation mode,
-                                const int                 sample1,
-                                const int                 sample2,
-                                const int                 quarterPos)
-{
-  if (mode == ChromaInterpolation::Bilinear)
-  {
-    // Interpolate linearly between sample1 and sample2
-    if (quarterPos == 0)
-      return sample1;
-    if (quarterPos == 1)
-      return ((sample1 * 3 + sample2) + 1) >> 2;
-    if (quarterPos == 2)
-      return ((sample1 + sample2) + 1) >> 1;
-    if (quarterPos == 3)
-      return ((sample1 + sample2 * 3) + 1) >> 2;
-  }
-  return sample1; // Sample and hold
-}
-
-// TODO: Consider sample position
-inline int interpolateUVSample2D(const ChromaInterpolation mode,
-                                 const int                 sample1,
-                                 const int                 sample2,
-                                 const int                 sample3,
-                                 const int                 sample4)
-{
-  if (mode == ChromaInterpolation::Bilinear)
-    // Interpolate linearly between sample1 - sample 4
-    return ((sample1 + sample2 + sample3 + sample4) + 2) >> 2;
-  return sample1; // Sample and hold
-}
-
-// Depending on offsetX8 (which can be 1 to 7), interpolate one of the 6 given positions between
-// prev and cur.
-inline int interpolateUV8Pos(int prev, int cur, const int offsetX8)
-{
-  if (offsetX8 == 4)
-    return (prev + cur + 1) / 2;
-  if (offsetX8 == 2)
-    return (prev + cur * 3 + 2) / 4;
-  if (offsetX8 == 6)
-    return (prev * 3 + cur + 2) / 4;
-  if (offsetX8 == 1)
-    return (prev + cur * 7 + 4) / 8;
-  if (offsetX8 == 3)
-    return (prev * 3 + cur * 5 + 4) / 8;
-  if (offsetX8 == 5)
-    return (prev * 5 + cur * 3 + 4) / 8;
-  if (offsetX8 == 7)
-    return (prev * 7 + cur + 4) / 8;
-  Q_ASSERT(false); // offsetX8 should always be between 1 and 7 (inclusive)
-  return 0;
-}
-
-// Re-sample the chroma component so that the chroma samples and the luma samples are aligned after
-// this operation.
-inline void UVPlaneResamplingChromaOffset(const PixelFormatYUV format,
-                                          const int            w,
-                                          const int            h,
-                                          const unsigned char *restrict srcU,
-                                          const unsigned char *restrict srcV,
-                                          const int inValSkip,
-                                          unsigned char *restrict dstU,
-                                          unsigned char *restrict dstV)
-{
-  // We can perform linear interpolation for 7 positions (6 in between) two pixels.
-  // Which of these position is needed depends on the chromaOffset and the subsampling.
-  const int possibleValsX = getMaxPossibleChromaOffsetValues(true, format.getSubsampling());
-  const int possibleValsY = getMaxPossibleChromaOffsetValues(false, format.getSubsampling());
-  const int offsetX8      = (possibleValsX == 1)   ? format.getChromaOffset().x * 4
-                            : (possibleValsX == 3) ? format.getChromaOffset().x * 2
-                                                   : format.getChromaOffset().x;
-  const int offsetY8      = (possibleValsY == 1)   ? format.getChromaOffset().y * 4
-                            : (possibleValsY == 3) ? format.getChromaOffset().y * 2
-                                                   : format.getChromaOffset().y;
-
-  // The format to use for input/output
-  const bool bigEndian = format.isBigEndian();
-  const int  bps       = format.getBitsPerSample();
-
-  const int stride = bps > 8 ? w * 2 : w;
-  if (offsetX8 != 0)
-  {
-    // Perform horizontal re-sampling
-    for (int y = 0; y < h; y++)
-    {
-      // On the left side, there is no previous sample, so the first value is never changed.
-      const int srcIdx = y * stride * inValSkip;
-      int       prevU  = getValueFromSource(srcU, srcIdx, bps, bigEndian);
-      int       prevV  = getValueFromSource(srcV, srcIdx, bps, bigEndian);
-      setValueInBuffer(dstU, prevU, y * stride, bps, bigEndian);
-      setValueInBuffer(dstV, prevV, y * stride, bps, bigEndian);
-
-      for (int x = 0; x < w - 1; x++)
-      {
-        // Calculate the new current value using the previous and the current value
-        const int srcIdxInLine = srcIdx + (x + 1) * inValSkip;
-        int       curU         = getValueFromSource(srcU, srcIdxInLine, bps, bigEndian);
-        int       curV         = getValueFromSource(srcV, srcIdxInLine, bps, bigEndian);
-
-        // Perform interpolation and save the value for the current UV value. Goto next value.
-        int newU = interpolateUV8Pos(prevU, curU, offsetX8);
-        int newV = interpolateUV8Pos(prevV, curV, offsetX8);
-        setValueInBuffer(dstU, newU, y * stride + x, bps, bigEndian);
-        setValueInBuffer(dstV, newV, y * stride + x, bps, bigEndian);
-
-        prevU = curU;
-        prevV = curV;
-      }
-    }
-  }
-
-  // For the second step, use the filtered values (or the source if no filtering was applied)
-  const unsigned char *srcUStep2    = (offsetX8 == 0) ? srcU : dstU;
-  const unsigned char *srcVStep2    = (offsetX8 == 0) ? srcV : dstV;
-  const int            valSkipStep2 = (offsetX8 == 0) ? inValSkip : 1;
-
-  if (offsetY8 != 0)
-  {
-    // Perform vertical re-sampling. It works exactly like horizontal up-sampling but x and y are
-    // switched.
-    for (int x = 0; x < w; x++)
-    {
-      // On the top, there is no previous sample, so the first value is never changed.
-      int prevU = getValueFromSource(srcUStep2, x * valSkipStep2, bps, bigEndian);
-      int prevV = getValueFromSource(srcVStep2, x * valSkipStep2, bps, bigEndian);
-      setValueInBuffer(dstU, prevU, x, bps, bigEndian);
-      setValueInBuffer(dstV, prevV, x, bps, bigEndian);
-
-      for (int y = 0; y < h - 1; y++)
-      {
-        // Calculate the new current value using the previous and the current value
-        const int srcIdx = (y + 1) * w + x;
-        int       curU   = getValueFromSource(srcUStep2, srcIdx * valSkipStep2, bps, bigEndian);
-        int       curV   = getValueFromSource(srcVStep2, srcIdx * valSkipStep2, bps, bigEndian);
-
-        // Perform interpolation and save the value for the current UV value. Goto next value.
-        int newU = interpolateUV8Pos(prevU, curU, offsetY8);
-        int newV = interpolateUV8Pos(prevV, curV, offsetY8);
-        setValueInBuffer(dstU, newU, srcIdx, bps, bigEndian);
-        setValueInBuffer(dstV, newV, srcIdx, bps, bigEndian);
-
-        prevU = curU;
-        prevV = curV;
-      }
-    }
-  }
-}
-
-inline void YUVPlaneToRGB_444(const int            componentSize,
-                              const MathParameters mathY,
-                              const MathParameters mathC,
-                              const unsigned char *restrict srcY,
-                              const unsigned char *restrict srcU,
-                              const unsigned char *restrict srcV,
-                              unsigned char *restrict dst,
-                              const int  RGBConv[5],
-                              const bool fullRange,
-                              const int  inMax,
-                              const int  bps,
-                              const bool bigEndian,
-                              const int  inValSkip)
-{
-  const bool applyMathLuma   = mathY.mathRequired();
-  const bool applyMathChroma = mathC.mathRequired();
-
-  for (int i = 0; i < componentSize; ++i)
-  {
-    unsigned int valY = getValueFromSource(srcY, i, bps, bigEndian);
-    unsigned int valU = getValueFromSource(srcU, i * inValSkip, bps, bigEndian);
-    unsigned int valV = getValueFromSource(srcV, i * inValSkip, bps, bigEndian);
-
-    if (applyMathLuma)
-      valY = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY, inMax);
-    if (applyMathChroma)
-    {
-      valU = transformYUV(mathC.invert, mathC.scale, mathC.offset, valU, inMax);
-      valV = transformYUV(mathC.invert, mathC.scale, mathC.offset, valV, inMax);
-    }
-
-    // Get the RGB values for this sample
-    int valR, valG, valB;
-    convertYUVToRGB8Bit(valY, valU, valV, valR, valG, valB, RGBConv, fullRange, bps);
-
-    // Save the RGB values
-    dst[i * 4]     = valB;
-    dst[i * 4 + 1] = valG;
-    dst[i * 4 + 2] = valR;
-    dst[i * 4 + 3] = 255;
-  }
-}
-
-inline void YUVPlaneToRGB_422(const int            w,
-                              const int            h,
-                              const MathParameters mathY,
-                              const MathParameters mathC,
-                              const unsigned char *restrict srcY,
-                              const unsigned char *restrict srcU,
-                              const unsigned char *restrict srcV,
-                              unsigned char *restrict dst,
-                              const int                 RGBConv[5],
-                              const bool                fullRange,
-                              const int                 inMax,
-                              const ChromaInterpolation interpolation,
-                              const int                 bps,
-                              const bool                bigEndian,
-                              const int                 inValSkip)
-{
-  const bool applyMathLuma   = mathY.mathRequired();
-  const bool applyMathChroma = mathC.mathRequired();
-  // Horizontal up-sampling is required. Process two Y values at a time
-  for (int y = 0; y < h; y++)
-  {
-    const int srcIdxUV   = y * w / 2;
-    int       curUSample = getValueFromSource(srcU, srcIdxUV * inValSkip, bps, bigEndian);
-    int       curVSample = getValueFromSource(srcV, srcIdxUV * inValSkip, bps, bigEndian);
-    if (applyMathChroma)
-    {
-      curUSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, curUSample, inMax);
-      curVSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, curVSample, inMax);
-    }
-
-    for (int x = 0; x < (w / 2) - 1; x++)
-    {
-      // Get the next U/V sample
-      const int srcPosLineUV = srcIdxUV + x + 1;
-      int       nextUSample  = getValueFromSource(srcU, srcPosLineUV * inValSkip, bps, bigEndian);
-      int       nextVSample  = getValueFromSource(srcV, srcPosLineUV * inValSkip, bps, bigEndian);
-      if (applyMathChroma)
-      {
-        nextUSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextUSample, inMax);
-        nextVSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextVSample, inMax);
-      }
-
-      // From the current and the next U/V sample, interpolate the UV sample in between
-      int interpolatedU = interpolateUVSample(interpolation, curUSample, nextUSample);
-      int interpolatedV = interpolateUVSample(interpolation, curVSample, nextVSample);
-
-      // Get the 2 Y samples
-      int valY1 = getValueFromSource(srcY, y * w + x * 2, bps, bigEndian);
-      int valY2 = getValueFromSource(srcY, y * w + x * 2 + 1, bps, bigEndian);
-      if (applyMathLuma)
-      {
-        valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
-        valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
-      }
-
-      // Convert to 2 RGB values and save them (BGRA)
-      int valR1, valR2, valG1, valG2, valB1, valB2;
-      convertYUVToRGB8Bit(
-          valY1, curUSample, curVSample, valR1, valG1, valB1, RGBConv, fullRange, bps);
-      convertYUVToRGB8Bit(
-          valY2, interpolatedU, interpolatedV, valR2, valG2, valB2, RGBConv, fullRange, bps);
-      const int pos = (y * w + x * 2) * 4;
-      dst[pos]      = valB1;
-      dst[pos + 1]  = valG1;
-      dst[pos + 2]  = valR1;
-      dst[pos + 3]  = 255;
-      dst[pos + 4]  = valB2;
-      dst[pos + 5]  = valG2;
-      dst[pos + 6]  = valR2;
-      dst[pos + 7]  = 255;
-
-      // The next one is now the current one
-      curUSample = nextUSample;
-      curVSample = nextVSample;
-    }
-
-    // For the last row, there is no next sample. Just reuse the current one again. No interpolation
-    // required either.
-
-    // Get the 2 Y samples
-    int valY1 = getValueFromSource(srcY, (y + 1) * w - 2, bps, bigEndian);
-    int valY2 = getValueFromSource(srcY, (y + 1) * w - 1, bps, bigEndian);
-    if (applyMathLuma)
-    {
-      valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
-      valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
-    }
-
-    // Convert to 2 RGB values and save them
-    int valR1, valR2, valG1, valG2, valB1, valB2;
-    convertYUVToRGB8Bit(
-        valY1, curUSample, curVSample, valR1, valG1, valB1, RGBConv, fullRange, bps);
-    convertYUVToRGB8Bit(
-        valY2, curUSample, curVSample, valR2, valG2, valB2, RGBConv, fullRange, bps);
-    const int pos = ((y + 1) * w) * 4;
-    dst[pos - 8]  = valB1;
-    dst[pos - 7]  = valG1;
-    dst[pos - 6]  = valR1;
-    dst[pos - 5]  = 255;
-    dst[pos - 4]  = valB2;
-    dst[pos - 3]  = valG2;
-    dst[pos - 2]  = valR2;
-    dst[pos - 1]  = 255;
-  }
-}
-
-inline void YUVPlaneToRGB_440(const int            w,
-                              const int            h,
-                              const MathParameters mathY,
-                              const MathParameters mathC,
-                              const unsigned char *restrict srcY,
-                              const unsigned char *restrict srcU,
-                              const unsigned char *restrict srcV,
-                              unsigned char *restrict dst,
-                              const int                 RGBConv[5],
-                              const bool                fullRange,
-                              const int                 inMax,
-                              const ChromaInterpolation interpolation,
-                              const int                 bps,
-                              const bool                bigEndian,
-                              const int                 inValSkip)
-{
-  const bool applyMathLuma   = mathY.mathRequired();
-  const bool applyMathChroma = mathC.mathRequired();
-  // Vertical up-sampling is required. Process two Y values at a time
-
-  for (int x = 0; x < w; x++)
-  {
-    int curUSample = getValueFromSource(srcU, x * inValSkip, bps, bigEndian);
-    int curVSample = getValueFromSource(srcV, x * inValSkip, bps, bigEndian);
-    if (applyMathChroma)
-    {
-      curUSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, curUSample, inMax);
-      curVSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, curVSample, inMax);
-    }
-
-    for (int y = 0; y < (h / 2) - 1; y++)
-    {
-      // Get the next U/V sample
-      const int srcIdxUV    = y * w + x;
-      int       nextUSample = getValueFromSource(srcU, srcIdxUV * inValSkip, bps, bigEndian);
-      int       nextVSample = getValueFromSource(srcV, srcIdxUV * inValSkip, bps, bigEndian);
-      if (applyMathChroma)
-      {
-        nextUSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextUSample, inMax);
-        nextVSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextVSample, inMax);
-      }
-
-      // From the current and the next U/V sample, interpolate the UV sample in between
-      int interpolatedU = interpolateUVSample(interpolation, curUSample, nextUSample);
-      int interpolatedV = interpolateUVSample(interpolation, curVSample, nextVSample);
-
-      // Get the 2 Y samples
-      int valY1 = getValueFromSource(srcY, y * 2 * w + x, bps, bigEndian);
-      int valY2 = getValueFromSource(srcY, (y * 2 + 1) * w + x, bps, bigEndian);
-      if (applyMathLuma)
-      {
-        valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
-        valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
-      }
-
-      // Convert to 2 RGB values and save them
-      int valR1, valR2, valG1, valG2, valB1, valB2;
-      convertYUVToRGB8Bit(
-          valY1, curUSample, curVSample, valR1, valG1, valB1, RGBConv, fullRange, bps);
-      convertYUVToRGB8Bit(
-          valY2, interpolatedU, interpolatedV, valR2, valG2, valB2, RGBConv, fullRange, bps);
-      const int pos1 = (y * 2 * w + x) * 4;
-      const int pos2 = pos1 + 4 * w;
-      dst[pos1]      = valB1;
-      dst[pos1 + 1]  = valG1;
-      dst[pos1 + 2]  = valR1;
-      dst[pos1 + 3]  = 255;
-      dst[pos2]      = valB2;
-      dst[pos2 + 1]  = valG2;
-      dst[pos2 + 2]  = valR2;
-      dst[pos2 + 3]  = 255;
-
-      // The next one is now the current one
-      curUSample = nextUSample;
-      curVSample = nextVSample;
-    }
-
-    // For the last column, there is no next sample. Just reuse the current one again. No
-    // interpolation required either.
-
-    // Get the 2 Y samples
-    int valY1 = getValueFromSource(srcY, (h - 2) * w + x, bps, bigEndian);
-    int valY2 = getValueFromSource(srcY, (h - 1) * w + x, bps, bigEndian);
-    if (applyMathLuma)
-    {
-      valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
-      valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
-    }
-
-    // Convert to 2 RGB values and save them
-    int valR1, valR2, valG1, valG2, valB1, valB2;
-    convertYUVToRGB8Bit(
-        valY1, curUSample, curVSample, valR1, valG1, valB1, RGBConv, fullRange, bps);
-    convertYUVToRGB8Bit(
-        valY2, curUSample, curVSample, valR2, valG2, valB2, RGBConv, fullRange, bps);
-    const int pos1 = ((h - 2) * w + x) * 4;
-    const int pos2 = pos1 + w * 4;
-    dst[pos1]      = valB1;
-    dst[pos1 + 1]  = valG1;
-    dst[pos1 + 2]  = valR1;
-    dst[pos1 + 3]  = 255;
-    dst[pos2]      = valB2;
-    dst[pos2 + 1]  = valG2;
-    dst[pos2 + 2]  = valR2;
-    dst[pos2 + 3]  = 255;
-  }
-}
-
-inline void YUVPlaneToRGB_420(const int            w,
-                              const int            h,
-                              const MathParameters mathY,
-                              const MathParameters mathC,
-                              const unsigned char *restrict srcY,
-                              const unsigned char *restrict srcU,
-                              const unsigned char *restrict srcV,
-                              unsigned char *restrict dst,
-                              const int                 RGBConv[5],
-                              const bool                fullRange,
-                              const int                 inMax,
-                              const ChromaInterpolation interpolation,
-                              const int                 bps,
-                              const bool                bigEndian,
-                              const int                 inValSkip)
-{
-  const bool applyMathLuma   = mathY.mathRequired();
-  const bool applyMathChroma = mathC.mathRequired();
-  // Format is YUV 4:2:0. Horizontal and vertical up-sampling is required. Process 4 Y positions at
-  // a time
-  const int hh = h / 2; // The half values
-  const int wh = w / 2;
-  for (int y = 0; y < hh - 1; y++)
-  {
-    // Get the current U/V samples for this y line and the next one (_NL)
-    const int srcIdxUV0 = y * wh;
-    const int srcIdxUV1 = (y + 1) * wh;
-    int       curU      = getValueFromSource(srcU, srcIdxUV0 * inValSkip, bps, bigEndian);
-    int       curV      = getValueFromSource(srcV, srcIdxUV0 * inValSkip, bps, bigEndian);
-    int       curU_NL   = getValueFromSource(srcU, srcIdxUV1 * inValSkip, bps, bigEndian);
-    int       curV_NL   = getValueFromSource(srcV, srcIdxUV1 * inValSkip, bps, bigEndian);
-    if (applyMathChroma)
-    {
-      curU    = transformYUV(mathC.invert, mathC.scale, mathC.offset, curU, inMax);
-      curV    = transformYUV(mathC.invert, mathC.scale, mathC.offset, curV, inMax);
-      curU_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, curU_NL, inMax);
-      curV_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, curV_NL, inMax);
-    }
-
-    for (int x = 0; x < wh - 1; x++)
-    {
-      // Get the next U/V sample for this line and the next one
-      const int srcIdxUVLine0 = srcIdxUV0 + x + 1;
-      const int srcIdxUVLine1 = srcIdxUV1 + x + 1;
-      int       nextU         = getValueFromSource(srcU, srcIdxUVLine0 * inValSkip, bps, bigEndian);
-      int       nextV         = getValueFromSource(srcV, srcIdxUVLine0 * inValSkip, bps, bigEndian);
-      int       nextU_NL      = getValueFromSource(srcU, srcIdxUVLine1 * inValSkip, bps, bigEndian);
-      int       nextV_NL      = getValueFromSource(srcV, srcIdxUVLine1 * inValSkip, bps, bigEndian);
-      if (applyMathChroma)
-      {
-        nextU    = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextU, inMax);
-        nextV    = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextV, inMax);
-        nextU_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextU_NL, inMax);
-        nextV_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextV_NL, inMax);
-      }
-
-      // From the current and the next U/V sample, interpolate the 3 UV samples in between
-      int interpolatedU_Hor =
-          interpolateUVSample(interpolation, curU, nextU); // Horizontal interpolation
-      int interpolatedV_Hor = interpolateUVSample(interpolation, curV, nextV);
-      int interpolatedU_Ver =
-          interpolateUVSample(interpolation, curU, curU_NL); // Vertical interpolation
-      int interpolatedV_Ver = interpolateUVSample(interpolation, curV, curV_NL);
-      int interpolatedU_Bi =
-          interpolateUVSample2D(interpolation, curU, nextU, curU_NL, nextU_NL); // 2D interpolation
-      int interpolatedV_Bi =
-          interpolateUVSample2D(interpolation, curV, nextV, curV_NL, nextV_NL); // 2D interpolation
-
-      // Get the 4 Y samples
-      int valY1 = getValueFromSource(srcY, (y * w + x) * 2, bps, bigEndian);
-      int valY2 = getValueFromSource(srcY, (y * w + x) * 2 + 1, bps, bigEndian);
-      int valY3 = getValueFromSource(srcY, (y * 2 + 1) * w + x * 2, bps, bigEndian);
-      int valY4 = getValueFromSource(srcY, (y * 2 + 1) * w + x * 2 + 1, bps, bigEndian);
-      if (applyMathLuma)
-      {
-        valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
-        valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
-        valY3 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY3, inMax);
-        valY4 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY4, inMax);
-      }
-
-      // Convert to 4 RGB values and save them
-      int valR1, valR2, valG1, valG2, valB1, valB2;
-      convertYUVToRGB8Bit(valY1, curU, curV, valR1, valG1, valB1, RGBConv, fullRange, bps);
-      convertYUVToRGB8Bit(valY2,
-                          interpolatedU_Hor,
-                          interpolatedV_Hor,
-                          valR2,
-                          valG2,
-                          valB2,
-                          RGBConv,
-                          fullRange,
-                          bps);
-      const int pos1 = (y * 2 * w + x * 2) * 4;
-      dst[pos1]      = valB1;
-      dst[pos1 + 1]  = valG1;
-      dst[pos1 + 2]  = valR1;
-      dst[pos1 + 3]  = 255;
-      dst[pos1 + 4]  = valB2;
-      dst[pos1 + 5]  = valG2;
-      dst[pos1 + 6]  = valR2;
-      dst[pos1 + 7]  = 255;
-      convertYUVToRGB8Bit(valY3,
-                          interpolatedU_Ver,
-                          interpolatedV_Ver,
-                          valR1,
-                          valG1,
-                          valB1,
-                          RGBConv,
-                          fullRange,
-                          bps); // Second line
-      convertYUVToRGB8Bit(
-          valY4, interpolatedU_Bi, interpolatedV_Bi, valR2, valG2, valB2, RGBConv, fullRange, bps);
-      const int pos2 = pos1 + w * 4; // Next line
-      dst[pos2]      = valB1;
-      dst[pos2 + 1]  = valG1;
-      dst[pos2 + 2]  = valR1;
-      dst[pos2 + 3]  = 255;
-      dst[pos2 + 4]  = valB2;
-      dst[pos2 + 5]  = valG2;
-      dst[pos2 + 6]  = valR2;
-      dst[pos2 + 7]  = 255;
-
-      // The next one is now the current one
-      curU    = nextU;
-      curV    = nextV;
-      curU_NL = nextU_NL;
-      curV_NL = nextV_NL;
-    }
-
-    // For the last x value (the right border), there is no next value. Just sample and hold. Only
-    // vertical interpolation is required.
-    int interpolatedU_Ver =
-        interpolateUVSample(interpolation, curU, curU_NL); // Vertical interpolation
-    int interpolatedV_Ver = interpolateUVSample(interpolation, curV, curV_NL);
-
-    // Get the 4 Y samples
-    int valY1 = getValueFromSource(srcY, (y * 2 + 1) * w - 2, bps, bigEndian);
-    int valY2 = getValueFromSource(srcY, (y * 2 + 1) * w - 1, bps, bigEndian);
-    int valY3 = getValueFromSource(srcY, (y * 2 + 2) * w - 2, bps, bigEndian);
-    int valY4 = getValueFromSource(srcY, (y * 2 + 2) * w - 1, bps, bigEndian);
-    if (applyMathLuma)
-    {
-      valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
-      valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
-      valY3 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY3, inMax);
-      valY4 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY4, inMax);
-    }
-
-    // Convert to 4 RGB values and save them
-    int valR1, valR2, valG1, valG2, valB1, valB2;
-    convertYUVToRGB8Bit(valY1, curU, curV, valR1, valG1, valB1, RGBConv, fullRange, bps);
-    convertYUVToRGB8Bit(valY2, curU, curV, valR2, valG2, valB2, RGBConv, fullRange, bps);
-    const int pos1 = ((y * 2 + 1) * w) * 4;
-    dst[pos1 - 8]  = valB1;
-    dst[pos1 - 7]  = valG1;
-    dst[pos1 - 6]  = valR1;
-    dst[pos1 - 5]  = 255;
-    dst[pos1 - 4]  = valB2;
-    dst[pos1 - 3]  = valG2;
-    dst[pos1 - 2]  = valR2;
-    dst[pos1 - 1]  = 255;
-    convertYUVToRGB8Bit(valY3,
-                        interpolatedU_Ver,
-                        interpolatedV_Ver,
-                        valR1,
-                        valG1,
-                        valB1,
-                        RGBConv,
-                        fullRange,
-                        bps); // Second line
-    convertYUVToRGB8Bit(
-        valY4, interpolatedU_Ver, interpolatedV_Ver, valR2, valG2, valB2, RGBConv, fullRange, bps);
-    const int pos2 = pos1 + w * 4; // Next line
-    dst[pos2 - 8]  = valB1;
-    dst[pos2 - 7]  = valG1;
-    dst[pos2 - 6]  = valR1;
-    dst[pos2 - 5]  = 255;
-    dst[pos2 - 4]  = valB2;
-    dst[pos2 - 3]  = valG2;
-    dst[pos2 - 2]  = valR2;
-    dst[pos2 - 1]  = 255;
-  }
-
-  // At the last Y line (the bottom line) a similar scenario occurs. There is no next Y line. Just
-  // sample and hold. Only horizontal interpolation is required.
-
-  // Get the current U/V samples for this y line
-  const int y  = hh - 1; // Just process the last y line
-  const int y2 = (hh - 1) * 2;
-
-  // Get 2 chroma samples from this line
-  const int srcIdxUV = y * wh;
-  int       curU     = getValueFromSource(srcU, srcIdxUV * inValSkip, bps, bigEndian);
-  int       curV     = getValueFromSource(srcV, srcIdxUV * inValSkip, bps, bigEndian);
-  if (applyMathChroma)
-  {
-    curU = transformYUV(mathC.invert, mathC.scale, mathC.offset, curU, inMax);
-    curV = transformYUV(mathC.invert, mathC.scale, mathC.offset, curV, inMax);
-  }
-
-  for (int x = 0; x < (w / 2) - 1; x++)
-  {
-    // Get the next U/V sample for this line and the next one
-    const int srcIdxLineUV = srcIdxUV + x + 1;
-    int       nextU        = getValueFromSource(srcU, srcIdxLineUV * inValSkip, bps, bigEndian);
-    int       nextV        = getValueFromSource(srcV, srcIdxLineUV * inValSkip, bps, bigEndian);
-    if (applyMathChroma)
-    {
-      nextU = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextU, inMax);
-      nextV = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextV, inMax);
-    }
-
-    // From the current and the next U/V sample, interpolate the 3 UV samples in between
-    int interpolatedU_Hor =
-        interpolateUVSample(interpolation, curU, nextU); // Horizontal interpolation
-    int interpolatedV_Hor = interpolateUVSample(interpolation, curV, nextV);
-
-    // Get the 4 Y samples
-    int valY1 = getValueFromSource(srcY, (y * w + x) * 2, bps, bigEndian);
-    int valY2 = getValueFromSource(srcY, (y * w + x) * 2 + 1, bps, bigEndian);
-    int valY3 = getValueFromSource(srcY, (y2 + 1) * w + x * 2, bps, bigEndian);
-    int valY4 = getValueFromSource(srcY, (y2 + 1) * w + x * 2 + 1, bps, bigEndian);
-    if (applyMathLuma)
-    {
-      valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
-      valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
-      valY3 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY3, inMax);
-      valY4 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY4, inMax);
-    }
-
-    // Convert to 4 RGB values and save them
-    int valR1, valR2, valG1, valG2, valB1, valB2;
-    convertYUVToRGB8Bit(valY1, curU, curV, valR1, valG1, valB1, RGBConv, fullRange, bps);
-    convertYUVToRGB8Bit(
-        valY2, interpolatedU_Hor, interpolatedV_Hor, valR2, valG2, valB2, RGBConv, fullRange, bps);
-    const int pos1 = (y2 * w + x * 2) * 4;
-    dst[pos1]      = valB1;
-    dst[pos1 + 1]  = valG1;
-    dst[pos1 + 2]  = valR1;
-    dst[pos1 + 3]  = 255;
-    dst[pos1 + 4]  = valB2;
-    dst[pos1 + 5]  = valG2;
-    dst[pos1 + 6]  = valR2;
-    dst[pos1 + 7]  = 255;
-    convertYUVToRGB8Bit(
-        valY3, curU, curV, valR1, valG1, valB1, RGBConv, fullRange, bps); // Second line
-    convertYUVToRGB8Bit(
-        valY4, interpolatedU_Hor, interpolatedV_Hor, valR2, valG2, valB2, RGBConv, fullRange, bps);
-    const int pos2 = pos1 + w * 4; // Next line
-    dst[pos2]      = valB1;
-    dst[pos2 + 1]  = valG1;
-    dst[pos2 + 2]  = valR1;
-    dst[pos2 + 3]  = 255;
-    dst[pos2 + 4]  = valB2;
-    dst[pos2 + 5]  = valG2;
-    dst[pos2 + 6]  = valR2;
-    dst[pos2 + 7]  = 255;
-
-    // The next one is now the current one
-    curU = nextU;
-    curV = nextV;
-  }
-
-  // For the last x value in the last y row (the right bottom), there is no next value in neither
-  // direction. Just sample and hold. No interpolation is required.
-
-  // Get the 4 Y samples
-  int valY1 = getValueFromSource(srcY, (y2 + 1) * w - 2, bps, bigEndian);
-  int valY2 = getValueFromSource(srcY, (y2 + 1) * w - 1, bps, bigEndian);
-  int valY3 = getValueFromSource(srcY, (y2 + 2) * w - 2, bps, bigEndian);
-  int valY4 = getValueFromSource(srcY, (y2 + 2) * w - 1, bps, bigEndian);
-  if (applyMathLuma)
-  {
-    valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
-    valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
-    valY3 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY3, inMax);
-    valY4 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY4, inMax);
-  }
-
-  // Convert to 4 RGB values and save them
-  int valR1, valR2, valG1, valG2, valB1, valB2;
-  convertYUVToRGB8Bit(valY1, curU, curV, valR1, valG1, valB1, RGBConv, fullRange, bps);
-  convertYUVToRGB8Bit(valY2, curU, curV, valR2, valG2, valB2, RGBConv, fullRange, bps);
-  const int pos1 = (y2 + 1) * w * 4;
-  dst[pos1 - 8]  = valB1;
-  dst[pos1 - 7]  = valG1;
-  dst[pos1 - 6]  = valR1;
-  dst[pos1 - 5]  = 255;
-  dst[pos1 - 4]  = valB2;
-  dst[pos1 - 3]  = valG2;
-  dst[pos1 - 2]  = valR2;
-  dst[pos1 - 1]  = 255;
-  convertYUVToRGB8Bit(
-      valY3, curU, curV, valR1, valG1, valB1, RGBConv, fullRange, bps); // Second line
-  convertYUVToRGB8Bit(valY4, curU, curV, valR2, valG2, valB2, RGBConv, fullRange, bps);
-  const int pos2 = pos1 + w * 4; // Next line
-  dst[pos2 - 8]  = valB1;
-  dst[pos2 - 7]  = valG1;
-  dst[pos2 - 6]  = valR1;
-  dst[pos2 - 5]  = 255;
-  dst[pos2 - 4]  = valB2;
-  dst[pos2 - 3]  = valG2;
-  dst[pos2 - 2]  = valR2;
-  dst[pos2 - 1]  = 255;
-}
-
-inline void YUVPlaneToRGB_410(const int            w,
-                              const int            h,
-                              const MathParameters mathY,
-                              const MathParameters mathC,
-                              const unsigned char *restrict srcY,
-                              const unsigned char *restrict srcU,
-                              const unsigned char *restrict srcV,
-                              unsigned char *restrict dst,
-                              const int                 RGBConv[5],
-                              const bool                fullRange,
-                              const int                 inMax,
-                              const ChromaInterpolation interpolation,
-                              const int                 bps,
-                              const bool                bigEndian,
-                              const int                 inValSkip)
-{
-  const bool applyMathLuma   = mathY.mathRequired();
-  const bool applyMathChroma = mathC.mathRequired();
-  // Format is YUV 4:1:0. Horizontal and vertical up-sampling is required. Process 4 Y positions of
-  // 2 lines at a time Horizontal subsampling by 4, vertical subsampling by 2
-  const int hq = h / 4; // The quarter values
-  const int wq = w / 4;
-
-  for (int y = 0; y < hq; y++)
-  {
-    // Get the current U/V samples for this y line and the next one (_NL)
-    const int srcIdxUV0 = y * wq;
-    const int srcIdxUV1 = (y + 1) * wq;
-    int       curU      = getValueFromSource(srcU, srcIdxUV0 * inValSkip, bps, bigEndian);
-    int       curV      = getValueFromSource(srcV, srcIdxUV0 * inValSkip, bps, bigEndian);
-    int       curU_NL =
-        (y < hq - 1) ? getValueFromSource(srcU, srcIdxUV1 * inValSkip, bps, bigEndian) : curU;
-    int curV_NL =
-        (y < hq - 1) ? getValueFromSource(srcV, srcIdxUV1 * inValSkip, bps, bigEndian) : curV;
-    if (applyMathChroma)
-    {
-      curU    = transformYUV(mathC.invert, mathC.scale, mathC.offset, curU, inMax);
-      curV    = transformYUV(mathC.invert, mathC.scale, mathC.offset, curV, inMax);
-      curU_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, curU_NL, inMax);
-      curV_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, curV_NL, inMax);
-    }
-
-    for (int x = 0; x < wq; x++)
-    {
-      // We process 4*4 values per U/V value
-
-      // Get the next U/V sample for this line and the next one
-      const int srcIdxUVLine0 = srcIdxUV0 + x + 1;
-      const int srcIdxUVLine1 = srcIdxUV1 + x + 1;
-      int       nextU =
-          (x < wq - 1) ? getValueFromSource(srcU, srcIdxUVLine0 * inValSkip, bps, bigEndian) : curU;
-      int nextV =
-          (x < wq - 1) ? getValueFromSource(srcV, srcIdxUVLine0 * inValSkip, bps, bigEndian) : curV;
-      int nextU_NL = (x < wq - 1)
-                         ? getValueFromSource(srcU, srcIdxUVLine1 * inValSkip, bps, bigEndian)
-                         : curU_NL;
-      int nextV_NL = (x < wq - 1)
-                         ? getValueFromSource(srcV, srcIdxUVLine1 * inValSkip, bps, bigEndian)
-                         : curV_NL;
-      if (applyMathChroma)
-      {
-        nextU    = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextU, inMax);
-        nextV    = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextV, inMax);
-        nextU_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextU_NL, inMax);
-        nextV_NL = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextV_NL, inMax);
-      }
-
-      // Now we interpolate and set the RGB values for the 4x4 pixels
-      for (int yo = 0; yo < 4; yo++)
-      {
-        // Interpolate vertically
-        int curU_INT  = interpolateUVSampleQ(interpolation, curU, curU_NL, yo);
-        int curV_INT  = interpolateUVSampleQ(interpolation, curV, curV_NL, yo);
-        int nextU_INT = interpolateUVSampleQ(interpolation, nextU, nextU_NL, yo);
-        int nextV_INT = interpolateUVSampleQ(interpolation, nextV, nextV_NL, yo);
-
-        for (int xo = 0; xo < 4; xo++)
-        {
-          // Interpolate horizontally
-          int U = interpolateUVSampleQ(interpolation, curU_INT, nextU_INT, xo);
-          int V = interpolateUVSampleQ(interpolation, curV_INT, nextV_INT, xo);
-          // Get the Y sample
-          int Y = getValueFromSource(srcY, (y * 4 + yo) * w + x * 4 + xo, bps, bigEndian);
-          if (applyMathLuma)
-            Y = transformYUV(mathY.invert, mathY.scale, mathY.offset, Y, inMax);
-
-          // Convert to RGB and save (BGRA)
-          int       R, G, B;
-          const int pos = ((y * 4 + yo) * w + x * 4 + xo) * 4;
-          convertYUVToRGB8Bit(Y, U, V, R, G, B, RGBConv, fullRange, bps);
-          dst[pos]     = B;
-          dst[pos + 1] = G;
-          dst[pos + 2] = R;
-          dst[pos + 3] = 255;
-        }
-      }
-
-      curU    = nextU;
-      curV    = nextV;
-      curU_NL = nextU_NL;
-      curV_NL = nextV_NL;
-    }
-  }
-}
-
-inline void YUVPlaneToRGB_411(const int            w,
-                              const int            h,
-                              const MathParameters mathY,
-                              const MathParameters mathC,
-                              const unsigned char *restrict srcY,
-                              const unsigned char *restrict srcU,
-                              const unsigned char *restrict srcV,
-                              unsigned char *restrict dst,
-                              const int                 RGBConv[5],
-                              const bool                fullRange,
-                              const int                 inMax,
-                              const ChromaInterpolation interpolation,
-                              const int                 bps,
-                              const bool                bigEndian,
-                              const int                 inValSkip)
-{
-  // Chroma: quarter horizontal resolution
-  const bool applyMathLuma   = mathY.mathRequired();
-  const bool applyMathChroma = mathC.mathRequired();
-
-  // Horizontal up-sampling is required. Process four Y values at a time.
-  for (int y = 0; y < h; y++)
-  {
-    const int srcIdxUV   = y * w / 4;
-    int       curUSample = getValueFromSource(srcU, srcIdxUV * inValSkip, bps, bigEndian);
-    int       curVSample = getValueFromSource(srcV, srcIdxUV * inValSkip, bps, bigEndian);
-    if (applyMathChroma)
-    {
-      curUSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, curUSample, inMax);
-      curVSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, curVSample, inMax);
-    }
-
-    for (int x = 0; x < (w / 4) - 1; x++)
-    {
-      // Get the next U/V sample
-      const int srcIdxUVLine = srcIdxUV + x + 1;
-      int       nextUSample  = getValueFromSource(srcU, srcIdxUVLine * inValSkip, bps, bigEndian);
-      int       nextVSample  = getValueFromSource(srcV, srcIdxUVLine * inValSkip, bps, bigEndian);
-      if (applyMathChroma)
-      {
-        nextUSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextUSample, inMax);
-        nextVSample = transformYUV(mathC.invert, mathC.scale, mathC.offset, nextVSample, inMax);
-      }
-
-      // From the current and the next U/V sample, interpolate the UV sample in between
-      int interpolatedU1 = interpolateUVSampleQ(interpolation, curUSample, nextUSample, 1);
-      int interpolatedV1 = interpolateUVSampleQ(interpolation, curVSample, nextVSample, 1);
-      int interpolatedU2 = interpolateUVSample(interpolation, curUSample, nextUSample);
-      int interpolatedV2 = interpolateUVSample(interpolation, curVSample, nextVSample);
-      int interpolatedU3 = interpolateUVSampleQ(interpolation, curUSample, nextUSample, 3);
-      int interpolatedV3 = interpolateUVSampleQ(interpolation, curVSample, nextVSample, 3);
-
-      // Get the 4 Y samples
-      int valY1 = getValueFromSource(srcY, y * w + x * 4, bps, bigEndian);
-      int valY2 = getValueFromSource(srcY, y * w + x * 4 + 1, bps, bigEndian);
-      int valY3 = getValueFromSource(srcY, y * w + x * 4 + 2, bps, bigEndian);
-      int valY4 = getValueFromSource(srcY, y * w + x * 4 + 3, bps, bigEndian);
-      if (applyMathLuma)
-      {
-        valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
-        valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
-        valY3 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY3, inMax);
-        valY4 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY4, inMax);
-      }
-
-      // Convert to 4 RGB values and save them
-      int       valR, valG, valB;
-      const int pos = (y * w + x * 4) * 4;
-      convertYUVToRGB8Bit(valY1, curUSample, curVSample, valR, valG, valB, RGBConv, fullRange, bps);
-      dst[pos]     = valB;
-      dst[pos + 1] = valG;
-      dst[pos + 2] = valR;
-      dst[pos + 3] = 255;
-      convertYUVToRGB8Bit(
-          valY2, interpolatedU1, interpolatedV1, valR, valG, valB, RGBConv, fullRange, bps);
-      dst[pos + 4] = valB;
-      dst[pos + 5] = valG;
-      dst[pos + 6] = valR;
-      dst[pos + 7] = 255;
-      convertYUVToRGB8Bit(
-          valY3, interpolatedU2, interpolatedV2, valR, valG, valB, RGBConv, fullRange, bps);
-      dst[pos + 8]  = valB;
-      dst[pos + 9]  = valG;
-      dst[pos + 10] = valR;
-      dst[pos + 11] = 255;
-      convertYUVToRGB8Bit(
-          valY4, interpolatedU3, interpolatedV3, valR, valG, valB, RGBConv, fullRange, bps);
-      dst[pos + 12] = valB;
-      dst[pos + 13] = valG;
-      dst[pos + 14] = valR;
-      dst[pos + 15] = 255;
-
-      // The next one is now the current one
-      curUSample = nextUSample;
-      curVSample = nextVSample;
-    }
-
-    // For the last row, there is no next sample. Just reuse the current one again. No interpolation
-    // required either.
-
-    // Get the 2 Y samples
-    int valY1 = getValueFromSource(srcY, (y + 1) * w - 4, bps, bigEndian);
-    int valY2 = getValueFromSource(srcY, (y + 1) * w - 3, bps, bigEndian);
-    int valY3 = getValueFromSource(srcY, (y + 1) * w - 2, bps, bigEndian);
-    int valY4 = getValueFromSource(srcY, (y + 1) * w - 1, bps, bigEndian);
-    if (applyMathLuma)
-    {
-      valY1 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY1, inMax);
-      valY2 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY2, inMax);
-      valY3 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY3, inMax);
-      valY4 = transformYUV(mathY.invert, mathY.scale, mathY.offset, valY4, inMax);
-    }
-
-    // Convert to 4 RGB values and save them
-    int       valR, valG, valB;
-    const int pos = ((y + 1) * w) * 4;
-    convertYUVToRGB8Bit(valY1, curUSample, curVSample, valR, valG, valB, RGBConv, fullRange, bps);
-    dst[pos - 16] = valB;
-    dst[pos - 15] = valG;
-    dst[pos - 14] = valR;
-    dst[pos - 13] = 255;
-    convertYUVToRGB8Bit(valY2, curUSample, curVSample, valR, valG, valB, RGBConv, fullRange, bps);
-    dst[pos - 12] = valB;
-    dst[pos - 11] = valG;
-    dst[pos - 10] = valR;
-    dst[pos - 9]  = 255;
-    convertYUVToRGB8Bit(valY3, curUSample, curVSample, valR, valG, valB, RGBConv, fullRange, bps);
-    dst[pos - 8] = valB;
-    dst[pos - 7] = valG;
-    dst[pos - 6] = valR;
-    dst[pos - 5] = 255;
-    convertYUVToRGB8Bit(valY4, curUSample, curVSample, valR, valG, valB, RGBConv, fullRange, bps);
-    dst[pos - 4] = valB;
-    dst[pos - 3] = valG;
-    dst[pos - 2] = valR;
-    dst[pos - 1] = 255;
-  }
-}
-
-bool convertYUVPlanarToRGB(const QByteArray         &sourceBuffer,
-                           uchar                    *targetBuffer,
-                           const Size                curFrameSize,
-                           const PixelFormatYUV     &sourceBufferFormat,
-                           const ConversionSettings &conversionSettings)
-{
-  // These are constant for the runtime of this function. This way, the compiler can optimize the
-  // hell out of this function.
-  const auto format        = sourceBufferFormat;
-  const auto interpolation = conversionSettings.chromaInterpolation;
-  const auto component     = conversionSettings.componentDisplayMode;
-  const auto conversion    = conversionSettings.colorConversion;
-  const auto w             = curFrameSize.width;
-  const auto h             = curFrameSize.height;
-
-  // Do we have to apply YUV math?
-  const auto mathY = conversionSettings.mathParameters.at(Component::Luma);
-  const auto mathC = conversionSettings.mathParameters.at(Component::Chroma);
-  // const auto applyMathLuma   = mathY.mathRequired();
-  // const auto applyMathChroma = mathC.mathRequired();
-
-  const auto bps       = format.getBitsPerSample();
-  const bool fullRange = isFullRange(conversionSettings.colorConversion);
-  // const auto yOffset = 16<<(bps-8);
-  // const auto cZero = 128<<(bps-8);
-  const auto inputMax = (1 << bps) - 1;
-
-  // The luma component has full resolution. The size of each chroma components depends on the
-  // subsampling.
-  const auto componentSizeLuma = (w * h);
-  const auto componentSizeChroma =
-      (w / format.getSubsamplingHor()) * (h / format.getSubsamplingVer());
-
-  // How many bytes are in each component?
-  const auto nrBytesLumaPlane   = (bps > 8) ? componentSizeLuma * 2 : componentSizeLuma;
-  const auto nrBytesChromaPlane = (bps > 8) ? componentSizeChroma * 2 : componentSizeChroma;
-
-  // If the U and V (and A if present) components are interlevaed, we have to skip every nth value
-  // in the input when reading U and V
-  const auto inputValSkip = format.isUVInterleaved()
-                                ? ((format.getPlaneOrder() == PlaneOrder::YUV ||
-                                    format.getPlaneOrder() == PlaneOrder::YVU)
-                                       ? 2
-                                       : 3)
-                                : 1;
-
-  // A pointer to the output
-  unsigned char *restrict dst = targetBuffer;
-
-  if (component != ComponentDisplayMode::DisplayAll ||
-      format.getSubsampling() == Subsampling::YUV_400)
-  {
-    // We only display (or there is only) one of the color components (possibly with YUV math)
-    if (component == ComponentDisplayMode::DisplayY ||
-        format.getSubsampling() == Subsampling::YUV_400)
-    {
-      // Luma only. The chroma subsampling does not matter.
-      const unsigned char *restrict srcY = (unsigned char *)sourceBuffer.data();
-      YUVPlaneToRGBMonochrome_444(
-          componentSizeLuma, mathY, srcY, dst, inputMax, bps, format.isBigEndian(), 1, fullRange);
-    }
-    else
-    {
-      // Display only the U or V component
-      bool firstComponent = (((format.getPlaneOrder() == PlaneOrder::YUV ||
-                               format.getPlaneOrder() == PlaneOrder::YUVA) &&
-                              component == ComponentDisplayMode::DisplayCb) ||
-                             ((format.getPlaneOrder() == PlaneOrder::YVU ||
-                               format.getPlaneOrder() == PlaneOrder::YVUA) &&
-                              component == ComponentDisplayMode::DisplayCr));
-
-      int srcOffset = nrBytesLumaPlane;
-      if (!firstComponent)
-      {
-        if (format.isUVInterleaved())
-          srcOffset += (bps > 8) ? 2 : 1;
-        else
-          srcOffset += nrBytesChromaPlane;
-      }
-
-      const unsigned char *restrict srcC = (unsigned char *)sourceBuffer.data() + srcOffset;
-      if (format.getSubsampling() == Subsampling::YUV_444)
-        YUVPlaneToRGBMonochrome_444(componentSizeChroma,
-                                    mathC,
-                                    srcC,
-                                    dst,
-                                    inputMax,
-                                    bps,
-                                    format.isBigEndian(),
-                                    inputValSkip,
-                                    fullRange);
-      else if (format.getSubsampling() == Subsampling::YUV_422)
-        YUVPlaneToRGBMonochrome_422(componentSizeChroma,
-                                    mathC,
-                                    srcC,
-                                    dst,
-                                    inputMax,
-                                    bps,
-                                    format.isBigEndian(),
-                                    inputValSkip,
-                                    fullRange);
-      else if (format.getSubsampling() == Subsampling::YUV_420)
-        YUVPlaneToRGBMonochrome_420(
-            w, h, mathC, srcC, dst, inputMax, bps, format.isBigEndian(), inputValSkip, fullRange);
-      else if (format.getSubsampling() == Subsampling::YUV_440)
-        YUVPlaneToRGBMonochrome_440(
-            w, h, mathC, srcC, dst, inputMax, bps, format.isBigEndian(), inputValSkip, fullRange);
-      else if (format.getSubsampling() == Subsampling::YUV_410)
-        YUVPlaneToRGBMonochrome_410(
-            w, h, mathC, srcC, dst, inputMax, bps, format.isBigEndian(), inputValSkip, fullRange);
-      else if (format.getSubsampling() == Subsampling::YUV_411)
-        YUVPlaneToRGBMonochrome_411(componentSizeChroma,
-                                    mathC,
-                                    srcC,
-                                    dst,
-                                    inputMax,
-                                    bps,
-                                    format.isBigEndian(),
-                                    inputValSkip,
-                                    fullRange);
-      else
-        return false;
-    }
-  }
-  else
-  {
-    // Is the U plane the first or the second?
-    const bool uPlaneFirst =
-        (format.getPlaneOrder() == PlaneOrder::YUV || format.getPlaneOrder() == PlaneOrder::YUVA);
-
-    // In case the U and V (and A if present) components are interleaved, the skip to the next plane
-    // is just 1 (or 2) bytes
-    int nrBytesToNextChromaPlane = nrBytesChromaPlane;
-    if (format.isUVInterleaved())
-      nrBytesToNextChromaPlane = (bps > 8) ? 2 : 1;
-
-    // Get/set the parameters used for YUV -> RGB conversion
-    int RGBConv[5];
-    getColorConversionCoefficients(conversion, RGBConv);
-
-    // We are displaying all components, so we have to perform conversion to RGB (possibly including
-    // interpolation and YUV math)
-    if (format.getSubsampling() != Subsampling::YUV_400 &&
-        (format.getChromaOffset().x != 0 || format.getChromaOffset().y != 0) &&
-        interpolation != ChromaInterpolation::NearestNeighbor)
-    {
-      // If there is a chroma offset, we must resample the chroma components before we convert them
-      // to RGB. If so, the resampled chroma values are saved in these arrays. We only ignore the
-      // chroma offset for other interpolations then nearest neighbor.
-      QByteArray uvPlaneChromaResampled[2];
-      uvPlaneChromaResampled[0].resize(nrBytesChromaPlane);
-      uvPlaneChromaResampled[1].resize(nrBytesChromaPlane);
-
-      // We have to perform pre-filtering for the U and V positions, because there is an offset
-      // between the pixel positions of Y and U/V
-      unsigned char *restrict dstU = (unsigned char *)uvPlaneChromaResampled[0].data();
-      unsigned char *restrict dstV = (unsigned char *)uvPlaneChromaResampled[1].data();
-
-      unsigned char *restrict srcY = (unsigned char *)sourceBuffer.data();
-      unsigned char *restrict srcU = uPlaneFirst
-                                         ? srcY + nrBytesLumaPlane
-                                         : srcY + nrBytesLumaPlane + nrBytesToNextChromaPlane;
-      unsigned char *restrict srcV = uPlaneFirst
-                                         ? srcY + nrBytesLumaPlane + nrBytesToNextChromaPlane
-                                         : srcY + nrBytesLumaPlane;
-
-      UVPlaneResamplingChromaOffset(format,
-                                    w / format.getSubsamplingHor(),
-                                    h / format.getSubsamplingVer(),
-                                    srcU,
-                                    srcV,
-                                    inputValSkip,
-                                    dstU,
-                                    dstV);
-
-      if (format.getSubsampling() == Subsampling::YUV_444)
-        YUVPlaneToRGB_444(componentSizeLuma,
-                          mathY,
-                          mathC,
-                          srcY,
-                          dstU,
-                          dstV,
-                          dst,
-                          RGBConv,
-                          fullRange,
-                          inputMax,
-                          bps,
-                          format.isBigEndian(),
-                          1);
-      else if (format.getSubsampling() == Subsampling::YUV_422)
-        YUVPlaneToRGB_422(w,
-                          h,
-                          mathY,
-                          mathC,
-                          srcY,
-                          dstU,
-                          dstV,
-                          dst,
-                          RGBConv,
-                          fullRange,
-                          inputMax,
-                          interpolation,
-                          bps,
-                          format.isBigEndian(),
-                          1);
-      else if (format.getSubsampling() == Subsampling::YUV_420)
-        YUVPlaneToRGB_420(w,
-                          h,
-                          mathY,
-                          mathC,
-                          srcY,
-                          dstU,
-                          dstV,
-                          dst,
-                          RGBConv,
-                          fullRange,
-                          inputMax,
-                          interpolation,
-                          bps,
-                          format.isBigEndian(),
-                          1);
-      else if (format.getSubsampling() == Subsampling::YUV_440)
-        YUVPlaneToRGB_440(w,
-                          h,
-                          mathY,
-                          mathC,
-                          srcY,
-                          dstU,
-                          dstV,
-                          dst,
-                          RGBConv,
-                          fullRange,
-                          inputMax,
-                          interpolation,
-                          bps,
-                          format.isBigEndian(),
-                          1);
-      else if (format.getSubsampling() == Subsampling::YUV_410)
-        YUVPlaneToRGB_410(w,
-                          h,
-                          mathY,
-                          mathC,
-                          srcY,
-                          dstU,
-                          dstV,
-                          dst,
-                          RGBConv,
-                          fullRange,
-                          inputMax,
-                          interpolation,
-                          bps,
-                          format.isBigEndian(),
-                          1);
-      else if (format.getSubsampling() == Subsampling::YUV_411)
-        YUVPlaneToRGB_411(w,
-                          h,
-                          mathY,
-                          mathC,
-                          srcY,
-                          dstU,
-                          dstV,
-                          dst,
-                          RGBConv,
-                          fullRange,
-                          inputMax,
-                          interpolation,
-                          bps,
-                          format.isBigEndian(),
-                          1);
-      else
-        return false;
-    }
-    else
-    {
-      // Get the pointers to the source planes (8 bit per sample)
-      const unsigned char *restrict srcY = (unsigned char *)sourceBuffer.data();
-      const unsigned char *restrict srcU = uPlaneFirst
-                                               ? srcY + nrBytesLumaPlane
-                                               : srcY + nrBytesLumaPlane + nrBytesToNextChromaPlane;
-      const unsigned char *restrict srcV = uPlaneFirst
-                                               ? srcY + nrBytesLumaPlane + nrBytesToNextChromaPlane
-                                               : srcY + nrBytesLumaPlane;
-
-      if (format.getSubsampling() == Subsampling::YUV_444)
-        YUVPlaneToRGB_444(componentSizeLuma,
-                          mathY,
-                          mathC,
-                          srcY,
-                          srcU,
-                          srcV,
-                          dst,
-                          RGBConv,
-                          fullRange,
-                          inputMax,
-                          bps,
-                          format.isBigEndian(),
-                          inputValSkip);
-      else if (format.getSubsampling() == Subsampling::YUV_422)
-        YUVPlaneToRGB_422(w,
-                          h,
-                          mathY,
-                          mathC,
-                          srcY,
-                          srcU,
-                          srcV,
-                          dst,
-                          RGBConv,
-                          fullRange,
-                          inputMax,
-                          interpolation,
-                          bps,
-                          format.isBigEndian(),
-                          inputValSkip);
-      else if (format.getSubsampling() == Subsampling::YUV_420)
-        YUVPlaneToRGB_420(w,
-                          h,
-                          mathY,
-                          mathC,
-                          srcY,
-                          srcU,
-                          srcV,
-                          dst,
-                          RGBConv,
-                          fullRange,
-                          inputMax,
-                          interpolation,
-                          bps,
-                          format.isBigEndian(),
-                          inputValSkip);
-      else if (format.getSubsampling() == Subsampling::YUV_440)
-        YUVPlaneToRGB_440(w,
-                          h,
-                          mathY,
-                          mathC,
-                          srcY,
-                          srcU,
-                          srcV,
-                          dst,
-                          RGBConv,
-                          fullRange,
-                          inputMax,
-                          interpolation,
-                          bps,
-                          format.isBigEndian(),
-                          inputValSkip);
-      else if (format.getSubsampling() == Subsampling::YUV_410)
-        YUVPlaneToRGB_410(w,
-                          h,
-                          mathY,
-                          mathC,
-                          srcY,
-                          srcU,
-                          srcV,
-                          dst,
-                          RGBConv,
-                          fullRange,
-                          inputMax,
-                          interpolation,
-                          bps,
-                          format.isBigEndian(),
-                          inputValSkip);
-      else if (format.getSubsampling() == Subsampling::YUV_411)
-        YUVPlaneToRGB_411(w,
-                          h,
-                          mathY,
-                          mathC,
-                          srcY,
-                          srcU,
-                          srcV,
-                          dst,
-                          RGBConv,
-                          fullRange,
-                          inputMax,
-                          interpolation,
-                          bps,
-                          format.isBigEndian(),
-                          inputValSkip);
-      else if (format.getSubsampling() == Subsampling::YUV_400)
-        YUVPlaneToRGBMonochrome_444(
-            componentSizeLuma, mathY, srcY, dst, fullRange, inputMax, bps, format.isBigEndian(), 1);
-      else
-        return false;
-    }
-  }
-
-  return true;
-}
-
 // Convert the given raw YUV data in sourceBuffer (using srcPixelFormat) to image (RGB-888), using
 // the buffer tmpRGBBuffer for intermediate RGB values.
 void convertYUVToImage(const QByteArray         &sourceBuffer,
@@ -2381,20 +554,20 @@ void convertYUVToImage(const QByteArray         &sourceBuffer,
 
   // Create the output image in the right format.
   // In both cases, we will set the alpha channel to 255. The format of the raw buffer is: BGRA
-  // (each 8 bit). Internally, this is how QImage allocates the number of bytes per line (with depth
-  // = 32): const int bytes_per_line = ((width * depth + 31) >> 5) << 2; // bytes per scanline (must
-  // be multiple of 4)
+  // (each 8 bit). The image buffer is taken from the frame buffer pool so that the buffers of
+  // dropped frames are reused for the next converted frames. The lines of the image are packed
+  // (bytes per line = width * 4).
   auto qFrameSize          = QSize(int(curFrameSize.width), int(curFrameSize.height));
   auto platformImageFormat = functionsGui::platformImageFormat(yuvFormat.hasAlpha());
   if (is_Q_OS_WIN || is_Q_OS_MAC)
-    outputImage = QImage(qFrameSize, platformImageFormat);
+    outputImage = functionsGui::createPooledImage(qFrameSize, platformImageFormat);
   else if (is_Q_OS_LINUX)
   {
     if (platformImageFormat == QImage::Format_ARGB32_Premultiplied ||
         platformImageFormat == QImage::Format_ARGB32)
-      outputImage = QImage(qFrameSize, platformImageFormat);
+      outputImage = functionsGui::createPooledImage(qFrameSize, platformImageFormat);
     else
-      outputImage = QImage(qFrameSize, QImage::Format_RGB32);
+      outputImage = functionsGui::createPooledImage(qFrameSize, QImage::Format_RGB32);
   }
 
   // Check the image buffer size before we write to it
@@ -2409,7 +582,8 @@ void convertYUVToImage(const QByteArray         &sourceBuffer,
   auto convOK = false;
   if (yuvFormat.isPlanar())
   {
-    if ((yuvFormat.getBitsPerSample() == 8 || yuvFormat.getBitsPerSample() == 10) &&
+    if (simd::getSupportedInstructionSet() == simd::InstructionSet::None &&
+        (yuvFormat.getBitsPerSample() == 8 || yuvFormat.getBitsPerSample() == 10) &&
         yuvFormat.getSubsampling() == Subsampling::YUV_420 &&
         conversionSettings.chromaInterpolation == ChromaInterpolation::NearestNeighbor &&
         yuvFormat.getChromaOffset().x == 0 && yuvFormat.getChromaOffset().y == 1 &&
@@ -2418,7 +592,7 @@ void convertYUVToImage(const QByteArray         &sourceBuffer,
         !conversionSettings.mathParameters.at(Component::Luma).mathRequired() &&
         !conversionSettings.mathParameters.at(Component::Chroma).mathRequired())
     // 8/10 bit 4:2:0, nearest neighbor, chroma offset (0,1) (the default for 4:2:0), all components
-    // displayed and no yuv math. We can use a specialized function for this.
+    // displayed and no yuv math. Without SIMD support, we can use a specialized function for this.
     {
       if (yuvFormat.getBitsPerSample() == 8)
         convOK = convertYUV420ToRGB<8>(
@@ -2428,7 +602,7 @@ void convertYUVToImage(const QByteArray         &sourceBuffer,
             sourceBuffer, outputImage.bits(), curFrameSize, yuvFormat, conversionSettings);
     }
     else
-      convOK = convertYUVPlanarToRGB(
+      convOK = convertYUVPlanarToARGB(
           sourceBuffer, outputImage.bits(), curFrameSize, yuvFormat, conversionSettings);
   }
   else
@@ -2451,7 +625,7 @@ void convertYUVToImage(const QByteArray         &sourceBuffer,
           convertYUVPackedToPlanar(sourceBuffer, tmpPlanarYUVSource, curFrameSize, yuvFormat);
 
     if (convOK)
-      convOK &= convertYUVPlanarToRGB(
+      convOK &= convertYUVPlanarToARGB(
           tmpPlanarYUVSource, outputImage.bits(), curFrameSize, newPixelFormat, conversionSettings);
   }
 
@@ -2497,9 +671,12 @@ videoHandlerYUV::~videoHandlerYUV()
 
 unsigned videoHandlerYUV::getCachingFrameSize() const
 {
+  if (this->isRawDataCacheActive())
+    return unsigned(this->srcPixelFormat.bytesPerFrame(this->frameSize));
+
   auto hasAlpha = this->srcPixelFormat.hasAlpha();
-  auto bytes    = functionsGui::bytesPerPixel(functionsGui::platformImageFormat(hasAlpha));
-  return this->frameSize.width * this->frameSize.height * bytes;
+  const auto format = functionsGui::platformImageFormat(hasAlpha);
+  return unsigned(functionsGui::getPooledImageBytes(this->frameSize, format));
 }
 
 void videoHandlerYUV::loadValues(Size newFramesize, const QString &)
@@ -2535,156 +712,6 @@ void videoHandlerYUV::drawFrame(QPainter *painter,
 
 /// --- Convert from the current YUV input format to YUV 444
 
-#if SSE_CONVERSION_420_ALT
-void videoHandlerYUV::yuv420_to_argb8888(quint8 *yp,
-                                         quint8 *up,
-                                         quint8 *vp,
-                                         quint32 sy,
-                                         quint32 suv,
-                                         int     width,
-                                         int     height,
-                                         quint8 *rgb,
-                                         quint32 srgb)
-{
-  __m128i  y0r0, y0r1, u0, v0;
-  __m128i  y00r0, y01r0, y00r1, y01r1;
-  __m128i  u00, u01, v00, v01;
-  __m128i  rv00, rv01, gu00, gu01, gv00, gv01, bu00, bu01;
-  __m128i  r00, r01, g00, g01, b00, b01;
-  __m128i  rgb0123, rgb4567, rgb89ab, rgbcdef;
-  __m128i  gbgb;
-  __m128i  ysub, uvsub;
-  __m128i  zero, facy, facrv, facgu, facgv, facbu;
-  __m128i *srcy128r0, *srcy128r1;
-  __m128i *dstrgb128r0, *dstrgb128r1;
-  __m64   *srcu64, *srcv64;
-
-  //    Implement the following conversion:
-  //    B = 1.164(Y - 16)                   + 2.018(U - 128)
-  //    G = 1.164(Y - 16) - 0.813(V - 128)  - 0.391(U - 128)
-  //    R = 1.164(Y - 16) + 1.596(V - 128)
-
-  int x, y;
-  // constants
-  ysub  = _mm_set1_epi32(0x00100010); // value 16 for subtraction
-  uvsub = _mm_set1_epi32(0x00800080); // value 128
-
-  // multiplication factors bit shifted by 6
-  facy  = _mm_set1_epi32(0x004a004a);
-  facrv = _mm_set1_epi32(0x00660066);
-  facgu = _mm_set1_epi32(0x00190019);
-  facgv = _mm_set1_epi32(0x00340034);
-  facbu = _mm_set1_epi32(0x00810081);
-
-  zero = _mm_set1_epi32(0x00000000);
-
-  for (y = 0; y < height; y += 2)
-  {
-    srcy128r0 = (__m128i *)(yp + sy * y);
-    srcy128r1 = (__m128i *)(yp + sy * y + sy);
-    srcu64    = (__m64 *)(up + suv * (y / 2));
-    srcv64    = (__m64 *)(vp + suv * (y / 2));
-
-    // dst row 0 and row 1
-    dstrgb128r0 = (__m128i *)(rgb + srgb * y);
-    dstrgb128r1 = (__m128i *)(rgb + srgb * y + srgb);
-
-    for (x = 0; x < width; x += 16)
-    {
-      u0 = _mm_loadl_epi64((__m128i *)srcu64);
-      srcu64++;
-      v0 = _mm_loadl_epi64((__m128i *)srcv64);
-      srcv64++;
-
-      y0r0 = _mm_load_si128(srcy128r0++);
-      y0r1 = _mm_load_si128(srcy128r1++);
-
-      // expand to 16 bit, subtract and multiply constant y factors
-      y00r0 = _mm_mullo_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(y0r0, zero), ysub), facy);
-      y01r0 = _mm_mullo_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(y0r0, zero), ysub), facy);
-      y00r1 = _mm_mullo_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(y0r1, zero), ysub), facy);
-      y01r1 = _mm_mullo_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(y0r1, zero), ysub), facy);
-
-      // expand u and v so they're aligned with y values
-      u0  = _mm_unpacklo_epi8(u0, zero);
-      u00 = _mm_sub_epi16(_mm_unpacklo_epi16(u0, u0), uvsub);
-      u01 = _mm_sub_epi16(_mm_unpackhi_epi16(u0, u0), uvsub);
-
-      v0  = _mm_unpacklo_epi8(v0, zero);
-      v00 = _mm_sub_epi16(_mm_unpacklo_epi16(v0, v0), uvsub);
-      v01 = _mm_sub_epi16(_mm_unpackhi_epi16(v0, v0), uvsub);
-
-      // common factors on both rows.
-      rv00 = _mm_mullo_epi16(facrv, v00);
-      rv01 = _mm_mullo_epi16(facrv, v01);
-      gu00 = _mm_mullo_epi16(facgu, u00);
-      gu01 = _mm_mullo_epi16(facgu, u01);
-      gv00 = _mm_mullo_epi16(facgv, v00);
-      gv01 = _mm_mullo_epi16(facgv, v01);
-      bu00 = _mm_mullo_epi16(facbu, u00);
-      bu01 = _mm_mullo_epi16(facbu, u01);
-
-      // add together and bit shift to the right
-      r00 = _mm_srai_epi16(_mm_add_epi16(y00r0, rv00), 6);
-      r01 = _mm_srai_epi16(_mm_add_epi16(y01r0, rv01), 6);
-      g00 = _mm_srai_epi16(_mm_sub_epi16(_mm_sub_epi16(y00r0, gu00), gv00), 6);
-      g01 = _mm_srai_epi16(_mm_sub_epi16(_mm_sub_epi16(y01r0, gu01), gv01), 6);
-      b00 = _mm_srai_epi16(_mm_add_epi16(y00r0, bu00), 6);
-      b01 = _mm_srai_epi16(_mm_add_epi16(y01r0, bu01), 6);
-
-      r00 = _mm_packus_epi16(r00, r01);
-      g00 = _mm_packus_epi16(g00, g01);
-      b00 = _mm_packus_epi16(b00, b01);
-
-      // shuffle back together to lower 0rgb0rgb...
-      r01     = _mm_unpacklo_epi8(r00, zero);  // 0r0r...
-      gbgb    = _mm_unpacklo_epi8(b00, g00);   // gbgb...
-      rgb0123 = _mm_unpacklo_epi16(gbgb, r01); // lower 0rgb0rgb...
-      rgb4567 = _mm_unpackhi_epi16(gbgb, r01); // upper 0rgb0rgb...
-
-      // shuffle back together to upper 0rgb0rgb...
-      r01     = _mm_unpackhi_epi8(r00, zero);
-      gbgb    = _mm_unpackhi_epi8(b00, g00);
-      rgb89ab = _mm_unpacklo_epi16(gbgb, r01);
-      rgbcdef = _mm_unpackhi_epi16(gbgb, r01);
-
-      // write to dst
-      _mm_store_si128(dstrgb128r0++, rgb0123);
-      _mm_store_si128(dstrgb128r0++, rgb4567);
-      _mm_store_si128(dstrgb128r0++, rgb89ab);
-      _mm_store_si128(dstrgb128r0++, rgbcdef);
-
-      // row 1
-      r00 = _mm_srai_epi16(_mm_add_epi16(y00r1, rv00), 6);
-      r01 = _mm_srai_epi16(_mm_add_epi16(y01r1, rv01), 6);
-      g00 = _mm_srai_epi16(_mm_sub_epi16(_mm_sub_epi16(y00r1, gu00), gv00), 6);
-      g01 = _mm_srai_epi16(_mm_sub_epi16(_mm_sub_epi16(y01r1, gu01), gv01), 6);
-      b00 = _mm_srai_epi16(_mm_add_epi16(y00r1, bu00), 6);
-      b01 = _mm_srai_epi16(_mm_add_epi16(y01r1, bu01), 6);
-
-      r00 = _mm_packus_epi16(r00, r01);
-      g00 = _mm_packus_epi16(g00, g01);
-      b00 = _mm_packus_epi16(b00, b01);
-
-      r01     = _mm_unpacklo_epi8(r00, zero);
-      gbgb    = _mm_unpacklo_epi8(b00, g00);
-      rgb0123 = _mm_unpacklo_epi16(gbgb, r01);
-      rgb4567 = _mm_unpackhi_epi16(gbgb, r01);
-
-      r01     = _mm_unpackhi_epi8(r00, zero);
-      gbgb    = _mm_unpackhi_epi8(b00, g00);
-      rgb89ab = _mm_unpacklo_epi16(gbgb, r01);
-      rgbcdef = _mm_unpackhi_epi16(gbgb, r01);
-
-      _mm_store_si128(dstrgb128r1++, rgb0123);
-      _mm_store_si128(dstrgb128r1++, rgb4567);
-      _mm_store_si128(dstrgb128r1++, rgb89ab);
-      _mm_store_si128(dstrgb128r1++, rgbcdef);
-    }
-  }
-}
-#endif
-
 QLayout *videoHandlerYUV::createVideoHandlerControls(bool isSizeAndFormatFixed)
 {
   // Absolutely always only call this function once!
@@ -2917,12 +944,20 @@ void videoHandlerYUV::slotYUVControlChanged()
     this->conversionSettings.mathParameters[Component::Chroma].invert =
         ui.chromaInvertCheckBox->isChecked();
 
-    // Set the current frame in the buffer to be invalid and clear the cache.
-    // Emit that this item needs redraw and the cache needs updating.
-    this->currentImageIndex       = -1;
-    this->currentImage_frameIndex = -1;
-    this->setCacheInvalid();
-    emit signalHandlerChanged(true, RECACHE_CLEAR);
+    // Set the current frame in the buffer to be invalid.
+    this->currentImageIndex           = -1;
+    this->currentImage_frameIndex     = -1;
+    this->doubleBufferImageFrameIndex = -1;
+    if (this->isRawDataCacheActive())
+      // The raw data in the cache does not depend on the conversion settings. We just need a
+      // redraw.
+      emit signalHandlerChanged(true, RECACHE_NONE);
+    else
+    {
+      // Clear the cache. Emit that this item needs redraw and the cache needs updating.
+      this->setCacheInvalid();
+      emit signalHandlerChanged(true, RECACHE_CLEAR);
+    }
   }
   else if (sender == ui.yuvFormatComboBox)
   {
@@ -3480,14 +1515,9 @@ void videoHandlerYUV::loadFrameForCaching(int frameIndex, QImage &frameToCache)
   const auto curFrameSize       = this->frameSize;
   const auto conversionSettings = this->conversionSettings;
 
-  requestDataMutex.lock();
-  emit       signalRequestRawData(frameIndex, true);
-  QByteArray tmpBufferRawYUVDataCaching = rawData;
-  requestDataMutex.unlock();
-
-  if (frameIndex != rawData_frameIndex)
+  QByteArray tmpBufferRawYUVDataCaching;
+  if (!this->loadRawDataForCaching(frameIndex, tmpBufferRawYUVDataCaching))
   {
-    // Loading failed
     DEBUG_YUV("videoHandlerYUV::loadFrameForCaching Loading failed");
     return;
   }
@@ -3497,6 +1527,14 @@ void videoHandlerYUV::loadFrameForCaching(int frameIndex, QImage &frameToCache)
       tmpBufferRawYUVDataCaching, frameToCache, yuvFormat, curFrameSize, conversionSettings);
 }
 
+QImage videoHandlerYUV::convertRawDataToImage(const QByteArray &rawData) const
+{
+  QImage image;
+  convertYUVToImage(
+      rawData, image, this->srcPixelFormat, this->frameSize, this->conversionSettings);
+  return image;
+}
+
 // Load the raw YUV data for the given frame index into currentFrameRawData.
 bool videoHandlerYUV::loadRawYUVData(int frameIndex)
 {
@@ -3504,6 +1542,18 @@ bool videoHandlerYUV::loadRawYUVData(int frameIndex)
     // Buffer already up to date
     return true;
 
+  {
+    // If the raw data is in the cache, there is no need to load it again
+    QMutexLocker cacheLock(&this->imageCacheAccess);
+    if (this->cacheValid && this->rawDataCache.contains(frameIndex))
+    {
+      currentFrameRawData            = this->rawDataCache[frameIndex];
+      currentFrameRawData_frameIndex = frameIndex;
+      DEBUG_YUV("videoHandlerYUV::loadRawYUVData " << frameIndex << " from raw data cache");
+      return true;
+    }
+  }
+
   DEBUG_YUV("videoHandlerYUV::loadRawYUVData " << frameIndex);
 
   // The function loadFrameForCaching also uses the signalRequesRawYUVData to request raw data.
@@ -3796,19 +1846,10 @@ QImage videoHandlerYUV::calculateDifference(FrameHandler    *item2,
 {
   this->diffReady = false;
 
-  videoHandlerYUV *yuvItem2 = dynamic_cast<videoHandlerYUV *>(item2);
-  if (yuvItem2 == nullptr)
-    // The given item is not a YUV source. We cannot compare YUV values to non YUV values.
-    // Call the base class comparison function to compare the items using the RGB values.
-    return videoHandler::calculateDifference(item2,
-                                             frameIdxItem0,
-                                             frameIdxItem1,
-                                             differenceInfoList,
-                                             amplificationFactor,
-                                             markDifference);
-
-  if (srcPixelFormat.getSubsampling() != yuvItem2->srcPixelFormat.getSubsampling())
-    // The two items have different subsampling modes. Compare RGB values instead.
+  if (!this->isDifferenceYUVSupported(item2))
+    // The given item is not a YUV source or the YUV values can not be compared (e.g. different
+    // subsampling modes). Call the base class comparison function to compare the items using the
+    // RGB values.
     return videoHandler::calculateDifference(item2,
                                              frameIdxItem0,
                                              frameIdxItem1,
@@ -3816,29 +1857,7 @@ QImage videoHandlerYUV::calculateDifference(FrameHandler    *item2,
                                              amplificationFactor,
                                              markDifference);
 
-  // Get/Set the bit depth of the input and output
-  // If the bit depth if the two items is different, we will scale the item with the lower bit depth
-  // up.
-  const unsigned bps_in[2] = {srcPixelFormat.getBitsPerSample(),
-                              yuvItem2->srcPixelFormat.getBitsPerSample()};
-  const auto     bps_out   = std::max(bps_in[0], bps_in[1]);
-  // Which of the two input values has to be scaled up? Only one of these (or neither) can be set.
-  const bool bitDepthScaling[2] = {bps_in[0] != bps_out, bps_in[1] != bps_out};
-  // Scale the input up by this many bits
-  const auto depthScale = bps_out - (bitDepthScaling[0] ? bps_in[0] : bps_in[1]);
-  // Add a warning if the bit depths of the two inputs don't agree
-  if (bitDepthScaling[0] || bitDepthScaling[1])
-    differenceInfoList.append(
-        InfoItem("Warning",
-                 "The bit depth of the two items differs.",
-                 "The bit depth of the two input items is different. The lower bit depth will be "
-                 "scaled up and the difference is calculated."));
-  // What are the maximum and middle value for the output bit depth
-  const int diffZero = 128 << (bps_out - 8);
-  const int maxVal   = (1 << bps_out) - 1;
-
-  // Do we amplify the values?
-  const bool amplification = (amplificationFactor != 1 && !markDifference);
+  auto yuvItem2 = dynamic_cast<videoHandlerYUV *>(item2);
 
   // Load the right raw YUV data (if not already loaded).
   // This will just update the raw YUV data. No conversion to image (RGB) is performed. This is
@@ -3853,164 +1872,72 @@ QImage videoHandlerYUV::calculateDifference(FrameHandler    *item2,
   DEBUG_YUV("videoHandlerYUV::calculateDifference frame idx item 0 "
             << frameIdxItem0 << " - item 1 " << frameIdxItem1);
 
-  // The items can be of different size (we then calculate the difference of the top left aligned
-  // part)
-  const unsigned w_in[] = {frameSize.width, yuvItem2->frameSize.width};
-  const unsigned h_in[] = {frameSize.height, yuvItem2->frameSize.height};
-  const auto     w_out  = std::min(w_in[0], w_in[1]);
-  const auto     h_out  = std::min(h_in[0], h_in[1]);
-  // Append a warning if the frame sizes are different
-  if (frameSize != yuvItem2->frameSize)
+  auto outputImage = this->calculateDifferenceFromRawData(this->currentFrameRawData,
+                                                          yuvItem2,
+                                                          yuvItem2->currentFrameRawData,
+                                                          differenceInfoList,
+                                                          amplificationFactor,
+                                                          markDifference,
+                                                          this->diffFirstDifference);
+
+  // we have a yuv differance available
+  this->diffReady = !outputImage.isNull();
+  return outputImage;
+}
+
+bool videoHandlerYUV::isDifferenceYUVSupported(const FrameHandler *item2) const
+{
+  auto yuvItem2 = dynamic_cast<const videoHandlerYUV *>(item2);
+  if (yuvItem2 == nullptr)
+    return false;
+  return canCalculateDifferenceYUV(this->srcPixelFormat, yuvItem2->srcPixelFormat);
+}
+
+QImage videoHandlerYUV::calculateDifferenceFromRawData(
+    const QByteArray               &rawData,
+    const videoHandlerYUV          *item2,
+    const QByteArray               &rawData2,
+    QList<InfoItem>                &differenceInfoList,
+    const int                       amplificationFactor,
+    const bool                      markDifference,
+    std::optional<FirstDifference> &firstDifference) const
+{
+  // Get the formats here, so that the calculation does not crash if they change while a caching
+  // thread is running.
+  const auto format1    = this->srcPixelFormat;
+  const auto format2    = item2->srcPixelFormat;
+  const auto frameSize1 = this->frameSize;
+  const auto frameSize2 = item2->frameSize;
+
+  // Add a warning if the bit depths of the two inputs don't agree. The lower bit depth will be
+  // scaled up.
+  if (format1.getBitsPerSample() != format2.getBitsPerSample())
+    differenceInfoList.append(
+        InfoItem("Warning",
+                 "The bit depth of the two items differs.",
+                 "The bit depth of the two input items is different. The lower bit depth will be "
+                 "scaled up and the difference is calculated."));
+  // Append a warning if the frame sizes are different. We calculate the difference of the top
+  // left aligned part.
+  if (frameSize1 != frameSize2)
     differenceInfoList.append(
         InfoItem("Warning",
                  "The size of the two items differs.",
                  "The size of the two input items is different. The difference of the top left "
                  "aligned part that overlaps will be calculated."));
 
-  PixelFormatYUV tmpDiffYUVFormat(srcPixelFormat.getSubsampling(), bps_out, PlaneOrder::YUV, true);
-  diffYUVFormat = tmpDiffYUVFormat;
-
-  if (!tmpDiffYUVFormat.canConvertToRGB(Size(w_out, h_out)))
+  // The difference values are only amplified if they are shown.
+  const auto amplification = markDifference ? 1 : amplificationFactor;
+  const auto difference    = calculateDifferenceYUV(
+      rawData, format1, frameSize1, rawData2, format2, frameSize2, amplification);
+  if (!difference)
     return QImage();
 
-  // Get subsampling modes (they are identical for both inputs and the output)
-  const auto subH = srcPixelFormat.getSubsamplingHor();
-  const auto subV = srcPixelFormat.getSubsamplingVer();
-
-  // Get the endianness of the inputs
-  const bool bigEndian[2] = {srcPixelFormat.isBigEndian(), yuvItem2->srcPixelFormat.isBigEndian()};
-
-  // Get pointers to the inputs
-  const unsigned componentSizeLuma_In[2]   = {w_in[0] * h_in[0], w_in[1] * h_in[1]};
-  const unsigned componentSizeChroma_In[2] = {(w_in[0] / subH) * (h_in[0] / subV),
-                                              (w_in[1] / subH) * (h_in[1] / subV)};
-  const unsigned nrBytesLumaPlane_In[2]    = {
-      bps_in[0] > 8 ? 2 * componentSizeLuma_In[0] : componentSizeLuma_In[0],
-      bps_in[1] > 8 ? 2 * componentSizeLuma_In[1] : componentSizeLuma_In[1]};
-  const unsigned nrBytesChromaPlane_In[2] = {
-      bps_in[0] > 8 ? 2 * componentSizeChroma_In[0] : componentSizeChroma_In[0],
-      bps_in[1] > 8 ? 2 * componentSizeChroma_In[1] : componentSizeChroma_In[1]};
-  // Current item
-  const unsigned char *restrict srcY1 = (unsigned char *)currentFrameRawData.data();
-  const unsigned char *restrict srcU1 =
-      (srcPixelFormat.getPlaneOrder() == PlaneOrder::YUV ||
-       srcPixelFormat.getPlaneOrder() == PlaneOrder::YUVA)
-          ? srcY1 + nrBytesLumaPlane_In[0]
-          : srcY1 + nrBytesLumaPlane_In[0] + nrBytesChromaPlane_In[0];
-  const unsigned char *restrict srcV1 =
-      (srcPixelFormat.getPlaneOrder() == PlaneOrder::YUV ||
-       srcPixelFormat.getPlaneOrder() == PlaneOrder::YUVA)
-          ? srcY1 + nrBytesLumaPlane_In[0] + nrBytesChromaPlane_In[0]
-          : srcY1 + nrBytesLumaPlane_In[0];
-  // The other item
-  const unsigned char *restrict srcY2 = (unsigned char *)yuvItem2->currentFrameRawData.data();
-  const unsigned char *restrict srcU2 =
-      (yuvItem2->srcPixelFormat.getPlaneOrder() == PlaneOrder::YUV ||
-       yuvItem2->srcPixelFormat.getPlaneOrder() == PlaneOrder::YUVA)
-          ? srcY2 + nrBytesLumaPlane_In[1]
-          : srcY2 + nrBytesLumaPlane_In[1] + nrBytesChromaPlane_In[1];
-  const unsigned char *restrict srcV2 =
-      (yuvItem2->srcPixelFormat.getPlaneOrder() == PlaneOrder::YUV ||
-       yuvItem2->srcPixelFormat.getPlaneOrder() == PlaneOrder::YUVA)
-          ? srcY2 + nrBytesLumaPlane_In[1] + nrBytesChromaPlane_In[1]
-          : srcY2 + nrBytesLumaPlane_In[1];
-
-  // Get pointers to the output
-  const int componentSizeLuma_out   = w_out * h_out * (bps_out > 8 ? 2 : 1); // Size in bytes
-  const int componentSizeChroma_out = (w_out / subH) * (h_out / subV) * (bps_out > 8 ? 2 : 1);
-  // Resize the output buffer to the right size
-  diffYUV.resize(componentSizeLuma_out + 2 * componentSizeChroma_out);
-  unsigned char *restrict dstY = (unsigned char *)diffYUV.data();
-  unsigned char *restrict dstU = dstY + componentSizeLuma_out;
-  unsigned char *restrict dstV = dstU + componentSizeChroma_out;
-
-  // Also calculate the MSE while we're at it (Y,U,V)
-  // TODO: Bug: MSE is not scaled correctly in all YUV format cases
-  int64_t mseAdd[3] = {0, 0, 0};
-
-  // Calculate Luma sample difference
-  const unsigned stride_in[2] = {bps_in[0] > 8 ? w_in[0] * 2 : w_in[0],
-                                 bps_in[1] > 8 ? w_in[1] * 2
-                                               : w_in[1]}; // How many bytes to the next y line?
-  for (unsigned y = 0; y < h_out; y++)
-  {
-    for (unsigned x = 0; x < w_out; x++)
-    {
-      auto val1 = getValueFromSource(srcY1, x, bps_in[0], bigEndian[0]);
-      auto val2 = getValueFromSource(srcY2, x, bps_in[1], bigEndian[1]);
-
-      // Scale (if necessary)
-      if (bitDepthScaling[0])
-        val1 = val1 << depthScale;
-      else if (bitDepthScaling[1])
-        val2 = val2 << depthScale;
-
-      // Calculate the difference, add MSE, (amplify) and clip the difference value
-      auto diff = val1 - val2;
-      mseAdd[0] += diff * diff;
-      if (amplification)
-        diff *= amplificationFactor;
-      diff = functions::clip(diff + diffZero, 0, maxVal);
-
-      setValueInBuffer(dstY, diff, 0, bps_out, true);
-      dstY += (bps_out > 8) ? 2 : 1;
-    }
-
-    // Goto the next y line
-    srcY1 += stride_in[0];
-    srcY2 += stride_in[1];
-  }
-
-  // Next U/V
-  const unsigned strideC_in[2] = {
-      w_in[0] / subH * (bps_in[0] > 8 ? 2 : 1),
-      w_in[1] / subH * (bps_in[1] > 8 ? 2 : 1)}; // How many bytes to the next U/V y line
-  for (unsigned y = 0; y < h_out / subV; y++)
-  {
-    for (unsigned x = 0; x < w_out / subH; x++)
-    {
-      auto valU1 = getValueFromSource(srcU1, x, bps_in[0], bigEndian[0]);
-      auto valU2 = getValueFromSource(srcU2, x, bps_in[1], bigEndian[1]);
-      auto valV1 = getValueFromSource(srcV1, x, bps_in[0], bigEndian[0]);
-      auto valV2 = getValueFromSource(srcV2, x, bps_in[1], bigEndian[1]);
-
-      // Scale (if necessary)
-      if (bitDepthScaling[0])
-      {
-        valU1 = valU1 << depthScale;
-        valV1 = valV1 << depthScale;
-      }
-      else if (bitDepthScaling[1])
-      {
-        valU2 = valU2 << depthScale;
-        valV2 = valV2 << depthScale;
-      }
-
-      // Calculate the difference, add MSE, (amplify) and clip the difference value
-      auto diffU = valU1 - valU2;
-      auto diffV = valV1 - valV2;
-      mseAdd[1] += diffU * diffU;
-      mseAdd[2] += diffV * diffV;
-      if (amplification)
-      {
-        diffU *= amplificationFactor;
-        diffV *= amplificationFactor;
-      }
-      diffU = functions::clip(diffU + diffZero, 0, maxVal);
-      diffV = functions::clip(diffV + diffZero, 0, maxVal);
-
-      setValueInBuffer(dstU, diffU, 0, bps_out, true);
-      setValueInBuffer(dstV, diffV, 0, bps_out, true);
-      dstU += (bps_out > 8) ? 2 : 1;
-      dstV += (bps_out > 8) ? 2 : 1;
-    }
-
-    // Goto the next y line
-    srcU1 += strideC_in[0];
-    srcV1 += strideC_in[0];
-    srcU2 += strideC_in[1];
-    srcV2 += strideC_in[1];
-  }
+  const auto &diffYUVFormat = difference->format;
+  const auto  w_out         = difference->frameSize.width;
+  const auto  h_out         = difference->frameSize.height;
+  if (!diffYUVFormat.canConvertToRGB(difference->frameSize))
+    return QImage();
 
   // Next we convert the difference YUV image to RGB, either using the normal conversion function or
   // another function that only marks the difference values.
@@ -4025,7 +1952,7 @@ QImage videoHandlerYUV::calculateDifference(FrameHandler    *item2,
     outputImage = QImage(QSize(w_out, h_out), QImage::Format_RGB32);
   else if (is_Q_OS_LINUX)
   {
-    auto format = functionsGui::platformImageFormat(tmpDiffYUVFormat.hasAlpha());
+    auto format = functionsGui::platformImageFormat(diffYUVFormat.hasAlpha());
     if (format == QImage::Format_ARGB32_Premultiplied)
       outputImage = QImage(QSize(w_out, h_out), QImage::Format_ARGB32_Premultiplied);
     if (format == QImage::Format_ARGB32)
@@ -4037,66 +1964,103 @@ QImage videoHandlerYUV::calculateDifference(FrameHandler    *item2,
   if (markDifference)
     // We don't want to see the actual difference but just where differences are.
     markDifferencesYUVPlanarToRGB(
-        diffYUV, outputImage.bits(), Size(w_out, h_out), tmpDiffYUVFormat);
+        difference->data, outputImage.bits(), difference->frameSize, diffYUVFormat);
   else
   {
     // Get the format of the tmpDiffYUV buffer and convert it to RGB
     ConversionSettings conversionSettings;
     conversionSettings.mathParameters[Component::Luma]   = MathParameters(1, 125, false);
     conversionSettings.mathParameters[Component::Chroma] = MathParameters(1, 128, false);
-    convertYUVPlanarToRGB(
-        diffYUV, outputImage.bits(), Size(w_out, h_out), tmpDiffYUVFormat, conversionSettings);
+    convertYUVPlanarToARGB(difference->data,
+                           outputImage.bits(),
+                           difference->frameSize,
+                           diffYUVFormat,
+                           conversionSettings);
   }
 
-  differenceInfoList.append(
-      InfoItem("Difference Type",
-               QString("YUV %1").arg(QString::fromStdString(
-                   formatSubsamplingWithColons(srcPixelFormat.getSubsampling())))));
+  differenceInfoList.append(InfoItem(
+      "Difference Type",
+      QString("YUV %1").arg(
+          QString::fromStdString(formatSubsamplingWithColons(format1.getSubsampling())))));
 
   {
-    auto       nrPixelsLuma = w_out * h_out;
-    const auto maxSquared   = ((1 << bps_out) - 1) * ((1 << bps_out) - 1);
-    auto       mse          = double(mseAdd[0]) / nrPixelsLuma;
-    auto       psnr         = 10 * std::log10(maxSquared / mse);
+    const auto &sse          = difference->sumSquaredDifferences;
+    const auto  bps_out      = diffYUVFormat.getBitsPerSample();
+    const auto  nrPixelsLuma = double(w_out) * h_out;
+    const auto  maxSquared   = double((1 << bps_out) - 1) * double((1 << bps_out) - 1);
+    auto        mse          = double(sse[0]) / nrPixelsLuma;
+    auto        psnr         = 10 * std::log10(maxSquared / mse);
     differenceInfoList.append(
         InfoItem("MSE/PSNR Y", QString("%1 (%2dB)").arg(mse, 0, 'f', 1).arg(psnr, 0, 'f', 2)));
 
-    if (srcPixelFormat.getSubsampling() != Subsampling::YUV_400)
+    if (format1.getSubsampling() != Subsampling::YUV_400)
     {
-      auto nrPixelsChroma = w_out / subH * h_out / subV;
+      const auto nrPixelsChroma = double(w_out / diffYUVFormat.getSubsamplingHor()) *
+                                  (h_out / diffYUVFormat.getSubsamplingVer());
 
-      auto mseU  = double(mseAdd[1]) / nrPixelsChroma;
+      auto mseU  = double(sse[1]) / nrPixelsChroma;
       auto psnrU = 10 * std::log10(maxSquared / mseU);
       differenceInfoList.append(
           InfoItem("MSE/PSNR U", QString("%1 (%2dB)").arg(mseU, 0, 'f', 1).arg(psnrU, 0, 'f', 2)));
 
-      auto mseV  = double(mseAdd[2]) / nrPixelsChroma;
+      auto mseV  = double(sse[2]) / nrPixelsChroma;
       auto psnrV = 10 * std::log10(maxSquared / mseV);
       differenceInfoList.append(
           InfoItem("MSE/PSNR V", QString("%1 (%2dB)").arg(mseV, 0, 'f', 1).arg(psnrV, 0, 'f', 2)));
 
-      auto mseAvg = double(mseAdd[0] + mseAdd[1] + mseAdd[2]) / (nrPixelsLuma + 2 * nrPixelsChroma);
+      auto mseAvg  = double(sse[0] + sse[1] + sse[2]) / (nrPixelsLuma + 2 * nrPixelsChroma);
       auto psnrAvg = 10 * std::log10(maxSquared / mseAvg);
       differenceInfoList.append(InfoItem(
           "MSE/PSNR Avg", QString("%1 (%2dB)").arg(mseAvg, 0, 'f', 1).arg(psnrAvg, 0, 'f', 2)));
     }
   }
 
+  firstDifference = difference->firstDifference;
+
   if (is_Q_OS_LINUX)
   {
     // On linux, we may have to convert the image to the platform image format if it is not one of
     // the RGBA formats.
-    auto format = functionsGui::platformImageFormat(tmpDiffYUVFormat.hasAlpha());
+    auto format = functionsGui::platformImageFormat(diffYUVFormat.hasAlpha());
     if (format != QImage::Format_ARGB32_Premultiplied && format != QImage::Format_ARGB32 &&
         format != QImage::Format_RGB32)
       return outputImage.convertToFormat(format);
   }
 
-  // we have a yuv differance available
-  this->diffReady = true;
   return outputImage;
 }
 
+bool videoHandlerYUV::isResamplingSupported(const Size &targetSize) const
+{
+  const auto format = this->srcPixelFormat;
+  if (!canResampleYUV(format))
+    return false;
+
+  const auto subsamplingHor = unsigned(format.getSubsamplingHor());
+  const auto subsamplingVer = unsigned(format.getSubsamplingVer());
+  return this->frameSize.width % subsamplingHor == 0 &&
+         this->frameSize.height % subsamplingVer == 0 && targetSize.width % subsamplingHor == 0 &&
+         targetSize.height % subsamplingVer == 0;
+}
+
+QImage videoHandlerYUV::resampleRawData(const QByteArray    &rawData,
+                                        const Size          &targetSize,
+                                        const ResampleFilter filter,
+                                        QByteArray          &resampledRawData) const
+{
+  // Get the format and settings here, so that the resampling does not crash if they change while a
+  // caching thread is running.
+  const auto format     = this->srcPixelFormat;
+  const auto size       = this->frameSize;
+  const auto conversion = this->conversionSettings;
+
+  resampledRawData = resampleYUV(rawData, format, size, targetSize, filter);
+
+  QImage image;
+  convertYUVToImage(resampledRawData, image, format, targetSize, conversion);
+  return image;
+}
+
 void videoHandlerYUV::setPixelFormatYUV(const PixelFormatYUV &newFormat, bool emitSignal)
 {
   if (!newFormat.isValid())
@@ -34,12 +34,13 @@
 
 #include <common/EnumMapper.h>
 #include <video/videoHandler.h>
+#include <video/yuv/ConversionYUV.h>
+#include <video/yuv/DifferenceYUV.h>
 #include <video/yuv/PixelFormatYUV.h>
+#include <video/yuv/ResampleYUV.h>
 
 #include "ui_videoHandlerYUV.h"
 
-#include <map>
-
 namespace video::yuv
 {
 
@@ -48,30 +49,6 @@ struct yuv_t
   unsigned int Y, U, V;
 };
 
-enum class ComponentDisplayMode
-{
-  DisplayAll,
-  DisplayY,
-  DisplayCb,
-  DisplayCr
-};
-
-const EnumMapper<ComponentDisplayMode, 4>
-    ComponentDisplayModeMapper(std::make_pair(ComponentDisplayMode::DisplayAll, "Y'CbCr"sv),
-                               std::make_pair(ComponentDisplayMode::DisplayY, "Luma (Y) Only"sv),
-                               std::make_pair(ComponentDisplayMode::DisplayCb, "Cb only"sv),
-                               std::make_pair(ComponentDisplayMode::DisplayCr, "Cr only"sv));
-
-struct ConversionSettings
-{
-  ChromaInterpolation  chromaInterpolation{ChromaInterpolation::NearestNeighbor};
-  ComponentDisplayMode componentDisplayMode{ComponentDisplayMode::DisplayAll};
-  ColorConversion      colorConversion{ColorConversion::BT709_LimitedRange};
-  // Parameters for the YUV transformation (like scaling, invert, offset). For Luma ([0]) and
-  // chroma([1]).
-  std::map<Component, MathParameters> mathParameters;
-};
-
 /** The videoHandlerYUV can be used in any playlistItem to read/display YUV data. A playlistItem
  * could even provide multiple YUV videos. A videoHandlerYUV supports handling of YUV data and can
  * return a specific frame as a image by calling getOneFrame. All conversions from the various YUV
@@ -86,6 +63,7 @@ public:
   ~videoHandlerYUV();
 
   unsigned getCachingFrameSize() const override;
+  bool     supportsRawDataCaching() const override { return true; }
 
   // The format is valid if the frame width/height/pixel format are set
   virtual bool isFormatValid() const override
@@ -118,6 +96,35 @@ public:
                                      const int        amplificationFactor,
                                      const bool       markDifference) override;
 
+  // Can the difference to the given item be calculated from the YUV values? This requires two
+  // planar YUV items with the same subsampling.
+  bool isDifferenceYUVSupported(const FrameHandler *item2) const;
+
+  // Calculate the difference of the given raw data of this item and of item2. The difference
+  // image, the info (MSE/PSNR) and the position of the first difference are calculated in one pass
+  // over the frames. No state of the two items is changed, so this can also be used from a caching
+  // thread. Returns a null image if the difference could not be calculated.
+  QImage calculateDifferenceFromRawData(const QByteArray               &rawData,
+                                        const videoHandlerYUV          *item2,
+                                        const QByteArray               &rawData2,
+                                        QList<InfoItem>                &differenceInfoList,
+                                        const int                       amplificationFactor,
+                                        const bool                      markDifference,
+                                        std::optional<FirstDifference> &firstDifference) const;
+
+  // Can the raw data of this item be resampled to the target size? This requires a format that
+  // is supported by resampleYUV and frame sizes that are a multiple of the subsampling.
+  bool isResamplingSupported(const Size &targetSize) const;
+
+  // Resample the given raw data of this item to the target size. The resampled raw data has the
+  // same YUV format as this item. It is converted to an image with the conversion settings of this
+  // item. No state of the item is changed, so this can also be used from a caching thread. Returns
+  // a null image if the raw data could not be resampled.
+  QImage resampleRawData(const QByteArray    &rawData,
+                         const Size          &targetSize,
+                         const ResampleFilter filter,
+                         QByteArray          &resampledRawData) const;
+
   // Get the number of bytes for one YUV frame with the current format
   virtual int64_t getBytesPerFrame() const override
   {
@@ -149,6 +156,8 @@ public:
   // other sources might provide a fixed format which the user cannot change (HEVC file, ...)
   virtual QLayout *createVideoHandlerControls(bool isSizeAndFormatFixed = false) override;
 
+  PixelFormatYUV getPixelFormatYUV() const { return this->srcPixelFormat; }
+
   // Get the name of the currently selected YUV pixel format
   virtual QString getRawPixelFormatYUVName() const
   {
@@ -187,8 +196,12 @@ public:
   // -1.
   bool showPixelValuesAsDiff{false};
 
-  QByteArray     getDiffYUV() const { return this->diffYUV; };
-  PixelFormatYUV getDiffYUVFormat() const { return this->diffYUVFormat; }
+  // The position of the first difference from the last call to calculateDifference. Only valid
+  // if the difference was calculated from the YUV values (isDiffReady).
+  std::optional<FirstDifference> getDiffFirstDifference() const
+  {
+    return this->diffFirstDifference;
+  }
 
   bool isDiffReady() const { return this->diffReady; }
 
@@ -206,6 +219,7 @@ protected:
   // Load the given frame and return it for caching. The current buffers (currentFrameRawYUVData and
   // currentFrame) will not be modified.
   virtual void loadFrameForCaching(int frameIndex, QImage &frameToCache) override;
+  virtual QImage convertRawDataToImage(const QByteArray &rawData) const override;
 
 private:
   // Load the raw YUV data for the given frame index into currentFrameRawYUVData.
@@ -228,23 +242,10 @@ private:
                                      const Size            frameSize,
                                      const PixelFormatYUV &sourceBufferFormat) const;
 
-#if SSE_CONVERSION_420_ALT
-  void yuv420_to_argb8888(quint8 *yp,
-                          quint8 *up,
-                          quint8 *vp,
-                          quint32 sy,
-                          quint32 suv,
-                          int     width,
-                          int     height,
-                          quint8 *rgb,
-                          quint32 srgb);
-#endif
-
   SafeUi<Ui::videoHandlerYUV> ui;
 
-  bool           diffReady{};
-  QByteArray     diffYUV;
-  PixelFormatYUV diffYUVFormat{};
+  bool                           diffReady{};
+  std::optional<FirstDifference> diffFirstDifference;
 
   static std::vector<PixelFormatYUV> formatPresetList;
 
@@ -0,0 +1,41 @@
+QT += core gui widgets opengl xml concurrent network
+
+TARGET = YUViewMetrics
+TEMPLATE = app
+CONFIG += c++17 console
+CONFIG -= app_bundle debug_and_release
+
+SOURCES += $$files(src/*.cpp, false)
+HEADERS += $$files(src/*.h, false)
+
+INCLUDEPATH += $$top_srcdir/YUViewLib/src
+LIBS += -L$$top_builddir/YUViewLib -lYUViewLib
+
+win32-msvc* {
+    PRE_TARGETDEPS += $$top_builddir/YUViewLib/YUViewLib.lib
+} else {
+    PRE_TARGETDEPS += $$top_builddir/YUViewLib/libYUViewLib.a
+}
+
+unix:!mac {
+    isEmpty(PREFIX) {
+        PREFIX = /usr/local
+    }
+    isEmpty(BINDIR) {
+        BINDIR = bin
+    }
+
+    target.path = $$PREFIX/$$BINDIR/
+    INSTALLS += target
+}
+
+win32 {
+    DEFINES += NOMINMAX
+}
+
+SVNN = $$system("git describe --tags")
+isEmpty(SVNN) {
+    SVNN = 0
+}
+VERSTR = '\\"$${SVNN}\\"'
+DEFINES += YUVIEW_VERSION=$${VERSTR}
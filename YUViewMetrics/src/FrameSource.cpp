@@ -0,0 +1,208 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrameSource.h"
+
+#include <decoder/decoderFFmpeg.h>
+#include <filesource/FileSource.h>
+#include <filesource/FileSourceFFmpegFile.h>
+#include <filesource/GuessFormatFromName.h>
+#include <video/yuv/PixelFormatYUVGuess.h>
+
+#include <QFileInfo>
+
+namespace
+{
+
+// Raw files with these extensions are read directly. Everything else is opened with libavformat
+// (this includes y4m files).
+const auto RAW_YUV_EXTENSIONS = QStringList({"yuv"});
+
+class RawFrameSource : public FrameSource
+{
+public:
+  bool openFile(const QString &filePath, const RawFileSettings &settings)
+  {
+    if (!this->file.openFile(filePath))
+      return this->setError("Error opening raw file " + filePath);
+
+    const auto fileInfo = this->file.getFileInfo();
+    const auto fileSize = this->file.getFileSize();
+
+    this->frameSize   = settings.frameSize;
+    this->pixelFormat = settings.pixelFormat;
+    unsigned   bitDepth{};
+    auto       dataLayout = video::DataLayout::Planar;
+    const auto fileFormat = guessFormatFromFilename(fileInfo);
+    if (!this->frameSize.isValid())
+    {
+      this->frameSize = fileFormat.frameSize;
+      bitDepth        = fileFormat.bitDepth;
+      dataLayout      = fileFormat.packed ? video::DataLayout::Packed : video::DataLayout::Planar;
+    }
+    if (!this->frameSize.isValid())
+      return this->setError("The frame size of " + filePath +
+                            " could not be guessed from the file name. Please set it.");
+    if (!this->pixelFormat.isValid())
+      this->pixelFormat = video::yuv::guessFormatFromSizeAndName(
+          this->frameSize, bitDepth, dataLayout, fileSize, fileInfo);
+    if (!this->pixelFormat.isValid())
+      return this->setError("The pixel format of " + filePath +
+                            " could not be guessed from the file name. Please set it.");
+
+    this->bytesPerFrame = this->pixelFormat.bytesPerFrame(this->frameSize);
+    if (this->bytesPerFrame <= 0)
+      return this->setError("Invalid frame size or pixel format for " + filePath);
+
+    // Reading from the mapped file does not need a copy of the data
+    this->file.mapFileToMemory();
+    return true;
+  }
+
+  bool readNextFrame(Frame &frame) override
+  {
+    const auto startPos = this->nextFrameIndex * this->bytesPerFrame;
+    if (startPos + this->bytesPerFrame > this->file.getFileSize())
+      return false;
+
+    if (this->file.isMemoryMapped())
+      frame.data = this->file.getMappedBytes(startPos, this->bytesPerFrame);
+    else if (this->file.readBytes(frame.data, startPos, this->bytesPerFrame) < this->bytesPerFrame)
+      return this->setError("Error reading frame from raw file");
+
+    frame.frameSize   = this->frameSize;
+    frame.pixelFormat = this->pixelFormat;
+    this->nextFrameIndex++;
+    return true;
+  }
+
+private:
+  bool setError(const QString &message)
+  {
+    this->errorMessage = message;
+    return false;
+  }
+
+  FileSource                 file;
+  Size                       frameSize;
+  video::yuv::PixelFormatYUV pixelFormat;
+  int64_t                    bytesPerFrame{};
+  int64_t                    nextFrameIndex{};
+};
+
+class DecodedFrameSource : public FrameSource
+{
+public:
+  bool openFile(const QString &filePath)
+  {
+    // We decode the file from the beginning to the end, so there is no need to scan it for the
+    // key frames first.
+    if (!this->file.openFile(filePath, nullptr, nullptr, false))
+      return this->setError("Error opening file " + filePath + " using libavformat");
+    this->file.seekFileToBeginning();
+
+    if (this->file.getRawFormat() != video::RawFormat::YUV)
+      return this->setError("The decoded format of " + filePath + " is not YUV");
+
+    this->decoder = std::make_unique<decoder::decoderFFmpeg>(this->file.getVideoCodecPar());
+    if (this->decoder->errorInDecoder())
+      return this->setError("Error creating decoder: " + this->decoder->decoderErrorString());
+    return true;
+  }
+
+  bool readNextFrame(Frame &frame) override
+  {
+    while (true)
+    {
+      while (this->decoder->state() == decoder::DecoderState::NeedsMoreData)
+      {
+        auto packet        = this->file.getNextPacket(this->repushPacket);
+        this->repushPacket = false;
+        if (!this->decoder->pushAVPacket(packet))
+        {
+          if (this->decoder->state() != decoder::DecoderState::RetrieveFrames)
+            return this->setError("Error pushing data to the decoder: " +
+                                  this->decoder->decoderErrorString());
+          this->repushPacket = true;
+        }
+      }
+
+      if (this->decoder->state() == decoder::DecoderState::RetrieveFrames &&
+          this->decoder->decodeNextFrame())
+      {
+        frame.data        = this->decoder->getRawFrameData();
+        frame.frameSize   = this->decoder->getFrameSize();
+        frame.pixelFormat = this->decoder->getPixelFormatYUV();
+        return true;
+      }
+
+      if (this->decoder->state() == decoder::DecoderState::EndOfBitstream)
+        return false;
+      if (this->decoder->state() == decoder::DecoderState::Error)
+        return this->setError("Error decoding: " + this->decoder->decoderErrorString());
+    }
+  }
+
+private:
+  bool setError(const QString &message)
+  {
+    this->errorMessage = message;
+    return false;
+  }
+
+  FileSourceFFmpegFile                    file;
+  std::unique_ptr<decoder::decoderFFmpeg> decoder;
+  bool                                    repushPacket{false};
+};
+
+} // namespace
+
+std::unique_ptr<FrameSource> FrameSource::openFile(const QString &        filePath,
+                                                   const RawFileSettings &rawFileSettings,
+                                                   QString &              errorMessage)
+{
+  const auto suffix = QFileInfo(filePath).suffix().toLower();
+  if (RAW_YUV_EXTENSIONS.contains(suffix))
+  {
+    auto source = std::make_unique<RawFrameSource>();
+    if (source->openFile(filePath, rawFileSettings))
+      return source;
+    errorMessage = source->getErrorMessage();
+    return {};
+  }
+
+  auto source = std::make_unique<DecodedFrameSource>();
+  if (source->openFile(filePath))
+    return source;
+  errorMessage = source->getErrorMessage();
+  return {};
+}
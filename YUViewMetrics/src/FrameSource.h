@@ -0,0 +1,75 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/Typedef.h>
+#include <video/yuv/PixelFormatYUV.h>
+
+#include <QByteArray>
+#include <QString>
+
+#include <memory>
+
+struct Frame
+{
+  QByteArray                 data;
+  Size                       frameSize;
+  video::yuv::PixelFormatYUV pixelFormat;
+};
+
+// A source of frames for the metrics calculation. This is either a raw YUV file or any file that
+// can be opened using libavformat and decoded using libavcodec (FFmpeg).
+class FrameSource
+{
+public:
+  virtual ~FrameSource() = default;
+
+  // Read (and decode) the next frame. Return false at the end of the sequence or if an error
+  // occurred (getErrorMessage is not empty then).
+  virtual bool readNextFrame(Frame &frame) = 0;
+
+  QString getErrorMessage() const { return this->errorMessage; }
+
+  // For raw files, the frame size and the pixel format are guessed from the file name and size
+  // if they are not set.
+  struct RawFileSettings
+  {
+    Size                       frameSize;
+    video::yuv::PixelFormatYUV pixelFormat;
+  };
+  static std::unique_ptr<FrameSource>
+  openFile(const QString &filePath, const RawFileSettings &rawFileSettings, QString &errorMessage);
+
+protected:
+  QString errorMessage;
+};
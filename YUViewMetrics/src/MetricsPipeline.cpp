@@ -0,0 +1,241 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MetricsPipeline.h"
+
+#include <QFuture>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace
+{
+
+// The number of frames that a reader may read ahead. This limits the memory usage if the
+// calculation of the metrics can not keep up with reading/decoding.
+constexpr size_t MAX_NR_QUEUED_FRAMES = 8;
+
+// A bounded queue between a reader thread and the thread that pairs the frames.
+class FrameQueue
+{
+public:
+  // Blocks while the queue is full. Returns false if the queue was aborted.
+  bool push(Frame &&frame)
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->notFull.wait(lock, [this]() {
+      return this->aborted || this->frames.size() < MAX_NR_QUEUED_FRAMES;
+    });
+    if (this->aborted)
+      return false;
+    this->frames.push_back(std::move(frame));
+    this->notEmpty.notify_one();
+    return true;
+  }
+
+  // Blocks while the queue is empty. Returns no value once the queue is empty and finished or if
+  // it was aborted.
+  std::optional<Frame> pop()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->notEmpty.wait(
+        lock, [this]() { return this->aborted || this->finished || !this->frames.empty(); });
+    if (this->aborted || this->frames.empty())
+      return {};
+    auto frame = std::move(this->frames.front());
+    this->frames.pop_front();
+    this->notFull.notify_one();
+    return frame;
+  }
+
+  // The reader reached the end of the source. The queued frames can still be popped.
+  void finish()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->finished = true;
+    this->notEmpty.notify_all();
+  }
+
+  void abort()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->aborted = true;
+    this->notEmpty.notify_all();
+    this->notFull.notify_all();
+  }
+
+private:
+  std::mutex              mutex;
+  std::condition_variable notEmpty;
+  std::condition_variable notFull;
+  std::deque<Frame>       frames;
+  bool                    finished{false};
+  bool                    aborted{false};
+};
+
+void readFrames(FrameSource &source, FrameQueue &queue)
+{
+  while (true)
+  {
+    Frame frame;
+    if (!source.readNextFrame(frame))
+    {
+      queue.finish();
+      return;
+    }
+    if (!queue.push(std::move(frame)))
+      return;
+  }
+}
+
+} // namespace
+
+MetricsPipeline::MetricsPipeline(FrameSource &source1, FrameSource &source2)
+    : source1(source1), source2(source2)
+{
+}
+
+bool MetricsPipeline::run(std::optional<unsigned> maxNrFrames, const ResultCallback &callback)
+{
+  // The readers get their own pool so that they are never blocked by the metrics calculations
+  // that run in the global pool.
+  QThreadPool readerPool;
+  readerPool.setMaxThreadCount(2);
+
+  FrameQueue queue1;
+  FrameQueue queue2;
+  auto       reader1 = QtConcurrent::run(&readerPool, [&]() { readFrames(this->source1, queue1); });
+  auto       reader2 = QtConcurrent::run(&readerPool, [&]() { readFrames(this->source2, queue2); });
+
+  using MetricsFuture = QFuture<std::optional<video::yuv::FrameMetrics>>;
+  std::deque<MetricsFuture> runningCalculations;
+  const auto maxNrRunningCalculations = size_t(2 * std::max(1, QThread::idealThreadCount()));
+
+  unsigned nrFramesStarted  = 0;
+  unsigned nrFramesReported = 0;
+  auto     reportFinishedResults = [&](bool waitForAll) {
+    while (!runningCalculations.empty() &&
+           (waitForAll || runningCalculations.size() > maxNrRunningCalculations ||
+            runningCalculations.front().isFinished()))
+    {
+      const auto metrics = runningCalculations.front().result();
+      runningCalculations.pop_front();
+      if (!metrics)
+      {
+        this->errorMessage = "Error calculating the metrics of frame " +
+                             QString::number(nrFramesReported);
+        return false;
+      }
+      callback(nrFramesReported++, *metrics);
+    }
+    return true;
+  };
+
+  bool ok = true;
+  // Without a limit, all frames are compared. If one source ends before the other, this is the
+  // index (1 or 2) of the source that ends first.
+  std::optional<int> shorterSource;
+  while (ok && (!maxNrFrames || nrFramesStarted < *maxNrFrames))
+  {
+    auto frame1 = queue1.pop();
+    auto frame2 = queue2.pop();
+    if (!frame1 || !frame2)
+    {
+      if (!maxNrFrames && (frame1 || frame2))
+        shorterSource = frame1 ? 2 : 1;
+      break;
+    }
+
+    std::string whyNot;
+    if (frame1->frameSize != frame2->frameSize)
+    {
+      this->errorMessage = "The frame sizes of frame " + QString::number(nrFramesStarted) +
+                           " differ";
+      ok                 = false;
+    }
+    else if (!video::yuv::canCalculateFrameMetrics(
+                 frame1->pixelFormat, frame2->pixelFormat, &whyNot))
+    {
+      this->errorMessage = QString::fromStdString(whyNot);
+      ok                 = false;
+    }
+    else
+    {
+      runningCalculations.push_back(
+          QtConcurrent::run([frame1 = std::move(*frame1), frame2 = std::move(*frame2)]() {
+            return video::yuv::calculateFrameMetrics(frame1.data,
+                                                     frame1.pixelFormat,
+                                                     frame2.data,
+                                                     frame2.pixelFormat,
+                                                     frame1.frameSize);
+          }));
+      nrFramesStarted++;
+      ok = reportFinishedResults(false);
+    }
+  }
+
+  queue1.abort();
+  queue2.abort();
+  reader1.waitForFinished();
+  reader2.waitForFinished();
+
+  if (ok)
+    ok = reportFinishedResults(true);
+  else
+    for (auto &calculation : runningCalculations)
+      calculation.waitForFinished();
+
+  if (ok && !this->source1.getErrorMessage().isEmpty())
+  {
+    this->errorMessage = this->source1.getErrorMessage();
+    ok                 = false;
+  }
+  if (ok && !this->source2.getErrorMessage().isEmpty())
+  {
+    this->errorMessage = this->source2.getErrorMessage();
+    ok                 = false;
+  }
+  if (ok && shorterSource)
+  {
+    this->errorMessage = "Source " + QString::number(*shorterSource) + " ends after " +
+                         QString::number(nrFramesStarted) +
+                         " frames but the other source has more frames. Limit the number of "
+                         "frames to compare only the first frames of both sources.";
+    ok                 = false;
+  }
+  return ok;
+}
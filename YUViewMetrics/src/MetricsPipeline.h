@@ -0,0 +1,64 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FrameSource.h"
+
+#include <video/yuv/FrameMetricsYUV.h>
+
+#include <functional>
+#include <optional>
+
+// Compares the frames of two sources. Each source is read (and decoded) in its own thread while
+// the metrics of the frames that were already read are calculated in the global thread pool. The
+// results are reported in frame order.
+class MetricsPipeline
+{
+public:
+  MetricsPipeline(FrameSource &source1, FrameSource &source2);
+
+  using ResultCallback =
+      std::function<void(unsigned frameIndex, const video::yuv::FrameMetrics &metrics)>;
+
+  // Run until one of the sources ends or maxNrFrames frames were compared. Returns false if an
+  // error occurred (see getErrorMessage). The results up to the error are reported anyway.
+  // Without maxNrFrames, it is an error if the sources have a different number of frames.
+  bool run(std::optional<unsigned> maxNrFrames, const ResultCallback &callback);
+
+  QString getErrorMessage() const { return this->errorMessage; }
+
+private:
+  FrameSource &source1;
+  FrameSource &source2;
+  QString      errorMessage;
+};
@@ -0,0 +1,278 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrameSource.h"
+#include "MetricsPipeline.h"
+
+#include <common/Typedef.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+
+enum class OutputFormat
+{
+  CSV,
+  JSON
+};
+
+const auto PLANE_NAMES = std::vector<QString>({"y", "u", "v"});
+
+QString formatValue(double value, OutputFormat format)
+{
+  if (std::isinf(value))
+    return format == OutputFormat::JSON ? "null" : "inf";
+  return QString::number(value, 'f', 6);
+}
+
+// Writes the metrics of each frame as soon as it is reported by the pipeline
+class MetricsWriter
+{
+public:
+  MetricsWriter(QTextStream &stream, OutputFormat format) : stream(stream), format(format) {}
+
+  void writeFrame(unsigned frameIndex, const video::yuv::FrameMetrics &metrics)
+  {
+    if (this->format == OutputFormat::CSV)
+    {
+      if (frameIndex == 0)
+      {
+        this->stream << "frame";
+        for (size_t plane = 0; plane < metrics.size(); plane++)
+        {
+          const auto &name = PLANE_NAMES[plane];
+          this->stream << ",mse_" << name << ",psnr_" << name << ",ssim_" << name;
+        }
+        this->stream << "\n";
+      }
+      this->stream << frameIndex;
+      for (const auto &planeMetrics : metrics)
+        this->stream << "," << formatValue(planeMetrics.mse, this->format) << ","
+                     << formatValue(planeMetrics.psnr, this->format) << ","
+                     << formatValue(planeMetrics.ssim, this->format);
+      this->stream << "\n";
+    }
+    else
+    {
+      this->stream << (frameIndex == 0 ? "[\n" : ",\n");
+      this->stream << "  {\"frame\": " << frameIndex;
+      for (size_t plane = 0; plane < metrics.size(); plane++)
+      {
+        const auto &name = PLANE_NAMES[plane];
+        this->stream << ", \"mse_" << name
+                     << "\": " << formatValue(metrics[plane].mse, this->format) << ", \"psnr_"
+                     << name << "\": " << formatValue(metrics[plane].psnr, this->format)
+                     << ", \"ssim_" << name
+                     << "\": " << formatValue(metrics[plane].ssim, this->format);
+      }
+      this->stream << "}";
+    }
+    this->nrFramesWritten++;
+  }
+
+  void finish()
+  {
+    if (this->format == OutputFormat::JSON)
+      this->stream << (this->nrFramesWritten == 0 ? "[]\n" : "\n]\n");
+    this->stream.flush();
+  }
+
+private:
+  QTextStream &stream;
+  OutputFormat format;
+  unsigned     nrFramesWritten{};
+};
+
+int exitWithError(const QString &message)
+{
+  std::cerr << message.toStdString() << "\n";
+  return 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+  // Use the same identity as the GUI so that the settings (e.g. the FFmpeg library path) are
+  // shared.
+  QCoreApplication::setApplicationName("YUView");
+  QCoreApplication::setApplicationVersion(QString::fromUtf8(YUVIEW_VERSION));
+  QCoreApplication::setOrganizationName("Institut für Nachrichtentechnik, RWTH Aachen University");
+  QCoreApplication::setOrganizationDomain("ient.rwth-aachen.de");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+      "Calculate the MSE, PSNR and SSIM per frame and plane between two videos. Raw YUV files "
+      "(.yuv) are read directly. All other files are decoded using FFmpeg.");
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addPositionalArgument("file1", "The first (e.g. the reference) file.");
+  parser.addPositionalArgument("file2", "The second file.");
+  const QCommandLineOption outputOption(
+      {"o", "output"}, "Write the results to <file> instead of stdout.", "file");
+  const QCommandLineOption formatOption(
+      "format",
+      "The output format (csv or json). Default is json for output files ending in .json and "
+      "csv otherwise.",
+      "format");
+  const QCommandLineOption sizeOption(
+      {"s", "size"}, "The frame size of raw files (e.g. 1920x1080).", "WxH");
+  const QCommandLineOption pixelFormatOption(
+      {"p", "pixel-format"},
+      "The pixel format of raw files as it is shown in YUView (e.g. \"YUV 4:2:0 8-bit\" or "
+      "\"YUV 4:2:0 10-bit LE\").",
+      "name");
+  const QCommandLineOption framesOption(
+      {"n", "frames"},
+      "Compare at most <n> frames. Without this option, it is an error if the files have a "
+      "different number of frames.",
+      "n");
+  parser.addOptions({outputOption, formatOption, sizeOption, pixelFormatOption, framesOption});
+  parser.process(app);
+
+  const auto files = parser.positionalArguments();
+  if (files.size() != 2)
+  {
+    std::cerr << "Please specify exactly two files.\n\n";
+    parser.showHelp(1);
+  }
+
+  FrameSource::RawFileSettings rawFileSettings;
+  if (parser.isSet(sizeOption))
+  {
+    const auto values = parser.value(sizeOption).toLower().split('x');
+    bool       okWidth{}, okHeight{};
+    if (values.size() == 2)
+      rawFileSettings.frameSize =
+          Size(values[0].toUInt(&okWidth), values[1].toUInt(&okHeight));
+    if (!okWidth || !okHeight || !rawFileSettings.frameSize.isValid())
+      return exitWithError("Invalid frame size " + parser.value(sizeOption));
+  }
+  if (parser.isSet(pixelFormatOption))
+  {
+    rawFileSettings.pixelFormat =
+        video::yuv::PixelFormatYUV(parser.value(pixelFormatOption).toStdString());
+    if (!rawFileSettings.pixelFormat.isValid())
+      return exitWithError("Invalid pixel format " + parser.value(pixelFormatOption));
+  }
+
+  std::optional<unsigned> maxNrFrames;
+  if (parser.isSet(framesOption))
+  {
+    bool ok{};
+    maxNrFrames = parser.value(framesOption).toUInt(&ok);
+    if (!ok)
+      return exitWithError("Invalid number of frames " + parser.value(framesOption));
+  }
+
+  const auto outputFile = parser.value(outputOption);
+  auto       outputFormat =
+      QFileInfo(outputFile).suffix().toLower() == "json" ? OutputFormat::JSON : OutputFormat::CSV;
+  if (parser.isSet(formatOption))
+  {
+    const auto format = parser.value(formatOption).toLower();
+    if (format == "json")
+      outputFormat = OutputFormat::JSON;
+    else if (format == "csv")
+      outputFormat = OutputFormat::CSV;
+    else
+      return exitWithError("Unknown output format " + format);
+  }
+
+  QString errorMessage;
+  auto    source1 = FrameSource::openFile(files[0], rawFileSettings, errorMessage);
+  if (!source1)
+    return exitWithError(errorMessage);
+  auto source2 = FrameSource::openFile(files[1], rawFileSettings, errorMessage);
+  if (!source2)
+    return exitWithError(errorMessage);
+
+  QFile       file;
+  QTextStream stream;
+  if (outputFile.isEmpty())
+  {
+    if (!file.open(stdout, QIODevice::WriteOnly))
+      return exitWithError("Error opening stdout");
+  }
+  else
+  {
+    file.setFileName(outputFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+      return exitWithError("Error opening output file " + outputFile);
+  }
+  stream.setDevice(&file);
+
+  MetricsWriter            writer(stream, outputFormat);
+  video::yuv::FrameMetrics sumOfMetrics;
+  unsigned                 nrFrames{};
+
+  QElapsedTimer timer;
+  timer.start();
+  MetricsPipeline pipeline(*source1, *source2);
+  const auto      ok = pipeline.run(
+      maxNrFrames, [&](unsigned frameIndex, const video::yuv::FrameMetrics &metrics) {
+        writer.writeFrame(frameIndex, metrics);
+        sumOfMetrics.resize(metrics.size());
+        for (size_t plane = 0; plane < metrics.size(); plane++)
+        {
+          sumOfMetrics[plane].mse += metrics[plane].mse;
+          sumOfMetrics[plane].ssim += metrics[plane].ssim;
+        }
+        nrFrames++;
+      });
+  writer.finish();
+
+  // A short summary goes to stderr so that it does not mix with the results on stdout
+  const auto seconds = double(timer.elapsed()) / 1000.0;
+  std::cerr << "Compared " << nrFrames << " frames in " << seconds << " s";
+  if (seconds > 0)
+    std::cerr << " (" << double(nrFrames) / seconds << " fps)";
+  std::cerr << "\n";
+  for (size_t plane = 0; plane < sumOfMetrics.size() && nrFrames > 0; plane++)
+    std::cerr << "Average " << PLANE_NAMES[plane].toUpper().toStdString()
+              << ": MSE " << sumOfMetrics[plane].mse / nrFrames << " SSIM "
+              << sumOfMetrics[plane].ssim / nrFrames << "\n";
+
+  if (!ok)
+    return exitWithError(pipeline.getErrorMessage());
+  return 0;
+}
@@ -1,4 +1,4 @@
-QT += core xml 
+QT += core gui widgets xml concurrent
 
 TARGET = YUViewUnitTest
 TEMPLATE = app
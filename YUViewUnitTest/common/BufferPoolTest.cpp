@@ -0,0 +1,105 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <common/BufferPool.h>
+
+#include <cstdint>
+
+namespace
+{
+
+constexpr std::size_t FRAME_SIZE = 1920 * 1080 * 4;
+const auto            FRAME_SIZE_CLASS = BufferPool::getSizeClass(FRAME_SIZE);
+
+TEST(BufferPoolTest, SizeClassesWasteAtMostAnEighth)
+{
+  EXPECT_EQ(BufferPool::getSizeClass(0), 4096u);
+  EXPECT_EQ(BufferPool::getSizeClass(4096), 4096u);
+  EXPECT_EQ(BufferPool::getSizeClass(4097), 4608u);
+  EXPECT_EQ(BufferPool::getSizeClass(8192), 8192u);
+  EXPECT_EQ(BufferPool::getSizeClass(FRAME_SIZE), 8u << 20);
+
+  for (std::size_t nrBytes = 4097; nrBytes < 100'000'000; nrBytes = nrBytes * 3 / 2 + 7)
+  {
+    const auto sizeClass = BufferPool::getSizeClass(nrBytes);
+    EXPECT_GE(sizeClass, nrBytes);
+    EXPECT_LE(sizeClass - nrBytes, nrBytes / 8);
+  }
+}
+
+TEST(BufferPoolTest, BuffersAreAligned)
+{
+  BufferPool pool;
+  for (const auto nrBytes : {1u, 100u, 5000u, 123457u})
+  {
+    auto buffer = pool.allocate(nrBytes);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer) % BufferPool::ALIGNMENT, 0u);
+    pool.release(buffer);
+  }
+}
+
+TEST(BufferPoolTest, ReleasedBufferIsReusedForSameSizeClass)
+{
+  BufferPool pool;
+  pool.setMaxIdleBytes(4 * FRAME_SIZE_CLASS);
+
+  auto buffer = pool.allocate(FRAME_SIZE);
+  pool.release(buffer);
+  EXPECT_EQ(pool.getIdleBytes(), FRAME_SIZE_CLASS);
+
+  EXPECT_EQ(pool.allocate(FRAME_SIZE - 100), buffer);
+  EXPECT_EQ(pool.getIdleBytes(), 0u);
+  pool.release(buffer);
+}
+
+TEST(BufferPoolTest, IdleBuffersAreLimited)
+{
+  BufferPool pool;
+  pool.setMaxIdleBytes(2 * FRAME_SIZE_CLASS);
+
+  std::vector<void *> buffers;
+  for (int i = 0; i < 4; i++)
+    buffers.push_back(pool.allocate(FRAME_SIZE));
+  for (auto buffer : buffers)
+    pool.release(buffer);
+  EXPECT_EQ(pool.getIdleBytes(), 2 * FRAME_SIZE_CLASS);
+
+  pool.setMaxIdleBytes(FRAME_SIZE_CLASS + 1);
+  EXPECT_EQ(pool.getIdleBytes(), FRAME_SIZE_CLASS);
+
+  pool.setMaxIdleBytes(0);
+  EXPECT_EQ(pool.getIdleBytes(), 0u);
+}
+
+} // namespace
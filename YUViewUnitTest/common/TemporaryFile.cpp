@@ -32,6 +32,7 @@
 
 #include "TemporaryFile.h"
 
+#include <chrono>
 #include <fstream>
 #include <random>
 
@@ -95,4 +96,11 @@ std::string TemporaryFile::getFilePathString() const
   return this->temporaryFilePath.string();
 }
 
+void TemporaryFile::setModificationTimeToPast() const
+{
+  std::filesystem::last_write_time(this->temporaryFilePath,
+                                   std::filesystem::file_time_type::clock::now() -
+                                       std::chrono::hours(1));
+}
+
 } // namespace yuviewTest
\ No newline at end of file
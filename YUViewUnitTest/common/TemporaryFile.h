@@ -48,6 +48,10 @@ public:
   std::filesystem::path getFilePath() const;
   std::string           getFilePathString() const;
 
+  // Set the modification time of the file to one hour ago. Files that were modified recently are
+  // not memory mapped.
+  void setModificationTimeToPast() const;
+
 private:
   std::filesystem::path temporaryFilePath;
 };
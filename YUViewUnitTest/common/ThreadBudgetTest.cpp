@@ -0,0 +1,165 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <common/ThreadBudget.h>
+
+namespace
+{
+
+using functions::calculateThreadBudget;
+
+TEST(ThreadBudgetTest, InteractiveDecodersGetTheCoresDuringPlayback)
+{
+  const auto budget = calculateThreadBudget(16, 1, true);
+  EXPECT_EQ(budget.interactiveDecoderThreads, 7u);
+  EXPECT_EQ(budget.cachingDecoderThreads, 1u);
+  EXPECT_EQ(budget.parallelForThreads, 15u);
+}
+
+TEST(ThreadBudgetTest, CachingWorkersShareTheCoresWhenStopped)
+{
+  const auto budget = calculateThreadBudget(16, 2, false);
+  EXPECT_EQ(budget.interactiveDecoderThreads, 2u);
+  EXPECT_EQ(budget.cachingDecoderThreads, 6u);
+  EXPECT_EQ(budget.parallelForThreads, 4u);
+}
+
+TEST(ThreadBudgetTest, InteractiveLoadingGetsAllCoresWithoutCaching)
+{
+  for (const auto playing : {false, true})
+  {
+    const auto budget = calculateThreadBudget(16, 0, playing);
+    EXPECT_EQ(budget.interactiveDecoderThreads, 8u);
+    EXPECT_EQ(budget.parallelForThreads, 16u);
+  }
+}
+
+TEST(ThreadBudgetTest, NoOversubscriptionWithOneWorkerPerCore)
+{
+  const auto budget = calculateThreadBudget(16, 15, false);
+  EXPECT_EQ(budget.interactiveDecoderThreads, 1u);
+  EXPECT_EQ(budget.cachingDecoderThreads, 1u);
+  EXPECT_EQ(budget.parallelForThreads, 1u);
+}
+
+TEST(ThreadBudgetTest, NoOversubscriptionForAnyNumberOfWorkers)
+{
+  for (const auto playing : {false, true})
+  {
+    for (unsigned nrCores = 1; nrCores <= 64; nrCores++)
+    {
+      for (unsigned nrCachingWorkers = 0; nrCachingWorkers < nrCores; nrCachingWorkers++)
+      {
+        const auto budget = calculateThreadBudget(nrCores, nrCachingWorkers, playing);
+        const auto cachingThreads = nrCachingWorkers * budget.cachingDecoderThreads;
+        EXPECT_LE(cachingThreads + budget.parallelForThreads, nrCores)
+            << "nrCores " << nrCores << " nrCachingWorkers " << nrCachingWorkers;
+        // Both interactive loaders together use the cores of parallelFor
+        if (budget.parallelForThreads > 1)
+        {
+          EXPECT_LE(2 * budget.interactiveDecoderThreads, budget.parallelForThreads);
+        }
+      }
+    }
+  }
+}
+
+TEST(ThreadBudgetTest, AtLeastOneThreadForEveryUser)
+{
+  for (const auto playing : {false, true})
+  {
+    for (const auto nrCachingWorkers : {0u, 1u, 4u, 32u})
+    {
+      const auto budget = calculateThreadBudget(1, nrCachingWorkers, playing);
+      EXPECT_EQ(budget.interactiveDecoderThreads, 1u);
+      EXPECT_EQ(budget.cachingDecoderThreads, 1u);
+      EXPECT_EQ(budget.parallelForThreads, 1u);
+    }
+  }
+}
+
+TEST(ThreadBudgetTest, DecoderThreadsDependOnDecoderUse)
+{
+  const auto budget = calculateThreadBudget(16, 1, true);
+  EXPECT_EQ(budget.getDecoderThreads(false), budget.interactiveDecoderThreads);
+  EXPECT_EQ(budget.getDecoderThreads(true), budget.cachingDecoderThreads);
+}
+
+// Simulates a caching decoder that decodes a stream with a random access point every 8 frames.
+// Like the AnnexB parser, the closest seek point is the last random access point before a frame.
+TEST(ThreadBudgetTest, CachingDecoderIsRecreatedAtTheNextRandomAccessPoint)
+{
+  constexpr unsigned RANDOM_ACCESS_PERIOD = 8;
+  const auto         isRandomAccessPoint  = [](unsigned frameIdx) {
+    return frameIdx % RANDOM_ACCESS_PERIOD == 0;
+  };
+  const auto getClosestSeekPoint = [](unsigned frameIdx) {
+    return frameIdx == 0 ? 0 : (frameIdx - 1) / RANDOM_ACCESS_PERIOD * RANDOM_ACCESS_PERIOD;
+  };
+
+  const auto budgetStopped = calculateThreadBudget(16, 2, false).cachingDecoderThreads;
+  const auto budgetPlaying = calculateThreadBudget(16, 2, true).cachingDecoderThreads;
+  ASSERT_NE(budgetStopped, budgetPlaying);
+
+  auto                  decoderThreads = budgetStopped;
+  std::vector<unsigned> recreatedAt;
+  for (unsigned frameIdx = 0; frameIdx < 24; frameIdx++)
+  {
+    // Playback starts in the middle of the stream
+    const auto budget = frameIdx < 3 ? budgetStopped : budgetPlaying;
+    if (decoderThreads == budget)
+      continue;
+
+    // The frames are decoded one after the other, so the decoder does not have to seek
+    if (const auto startFrame = functions::getFrameToRecreateDecoderAt(
+            frameIdx, isRandomAccessPoint(frameIdx), false, getClosestSeekPoint(frameIdx)))
+    {
+      EXPECT_EQ(*startFrame, frameIdx);
+      recreatedAt.push_back(frameIdx);
+      decoderThreads = budget;
+    }
+  }
+  EXPECT_EQ(recreatedAt, std::vector<unsigned>({8}));
+}
+
+TEST(ThreadBudgetTest, CachingDecoderIsRecreatedWhenSeeking)
+{
+  const auto startFrame = functions::getFrameToRecreateDecoderAt(13, false, true, 8);
+  ASSERT_TRUE(startFrame);
+  EXPECT_EQ(*startFrame, 8u);
+
+  EXPECT_FALSE(functions::getFrameToRecreateDecoderAt(13, false, false, 8));
+}
+
+} // namespace
@@ -0,0 +1,90 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "YUVTestData.h"
+
+#include <video/yuv/ConversionYUV.h>
+
+#include <algorithm>
+#include <random>
+
+namespace yuviewTest
+{
+
+namespace
+{
+
+template <typename GetValue>
+QByteArray createFrameDataWithValues(const video::yuv::PixelFormatYUV &pixelFormat,
+                                     const Size                       &frameSize,
+                                     GetValue                          getValue)
+{
+  QByteArray data;
+  data.resize(int(pixelFormat.bytesPerFrame(frameSize)));
+  const auto bytesPerSample = (pixelFormat.getBitsPerSample() > 8) ? 2 : 1;
+  for (int i = 0; i < data.size() / bytesPerSample; i++)
+    video::yuv::setValueInBuffer(reinterpret_cast<unsigned char *>(data.data()),
+                                 getValue(),
+                                 i,
+                                 pixelFormat.getBitsPerSample(),
+                                 pixelFormat.isBigEndian());
+  return data;
+}
+
+} // namespace
+
+bool isSupportedByCPU(const simd::InstructionSet instructionSet)
+{
+  const auto supportedInstructionSets = simd::getAllSupportedInstructionSets();
+  return std::find(supportedInstructionSets.begin(),
+                   supportedInstructionSets.end(),
+                   instructionSet) != supportedInstructionSets.end();
+}
+
+QByteArray createFrameData(const video::yuv::PixelFormatYUV &pixelFormat,
+                           const Size                       &frameSize,
+                           const int                         value)
+{
+  return createFrameDataWithValues(pixelFormat, frameSize, [value]() { return value; });
+}
+
+QByteArray createRandomFrameData(const video::yuv::PixelFormatYUV &pixelFormat,
+                                 const Size                       &frameSize,
+                                 const unsigned                    seed)
+{
+  std::mt19937                       randomGenerator(seed);
+  std::uniform_int_distribution<int> distribution(0, (1 << pixelFormat.getBitsPerSample()) - 1);
+  return createFrameDataWithValues(
+      pixelFormat, frameSize, [&]() { return distribution(randomGenerator); });
+}
+
+} // namespace yuviewTest
@@ -0,0 +1,65 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/SIMD.h>
+#include <common/Typedef.h>
+#include <video/yuv/PixelFormatYUV.h>
+
+#include <QByteArray>
+
+namespace yuviewTest
+{
+
+// The frame size for comparing the SIMD implementations with the scalar code. The width is not a
+// multiple of the SIMD width so that the scalar processing at the end of each line is tested as
+// well. It is divisible by 4 (for 4:1:0 and 4:1:1) and the frame has more than one stripe of 64
+// lines.
+constexpr auto TEST_FRAME_SIZE = Size(76, 72);
+
+constexpr auto InstructionSetsToTest = {simd::InstructionSet::SSE4_1,
+                                        simd::InstructionSet::AVX2};
+
+bool isSupportedByCPU(const simd::InstructionSet instructionSet);
+
+// Create a frame with all samples set to the given value
+QByteArray createFrameData(const video::yuv::PixelFormatYUV &pixelFormat,
+                           const Size                       &frameSize,
+                           const int                         value);
+
+// Create a frame with random samples. The same seed always gives the same frame.
+QByteArray createRandomFrameData(const video::yuv::PixelFormatYUV &pixelFormat,
+                                 const Size                       &frameSize,
+                                 const unsigned                    seed = 1234);
+
+} // namespace yuviewTest
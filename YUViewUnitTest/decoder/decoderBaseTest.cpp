@@ -0,0 +1,113 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <decoder/decoderBase.h>
+
+#include <cstring>
+
+namespace
+{
+
+constexpr int FRAME_SIZE_BYTES = 1000;
+
+class TestDecoder : public decoder::decoderBase
+{
+public:
+  bool        decodeNextFrame() override { return false; }
+  QByteArray  getRawFrameData() override { return {}; }
+  bool        pushData(QByteArray &) override { return false; }
+  QStringList getLibraryPaths() const override { return {}; }
+  QString     getDecoderName() const override { return {}; }
+  QString     getCodecName() const override { return {}; }
+
+  using decoderBase::prepareOutputBuffer;
+  using decoderBase::releaseOutputBuffer;
+};
+
+TEST(DecoderBaseTest, ReleasedUnsharedBufferIsReused)
+{
+  TestDecoder decoder;
+  QByteArray  outputBuffer;
+
+  decoder.prepareOutputBuffer(outputBuffer, FRAME_SIZE_BYTES);
+  ASSERT_EQ(outputBuffer.size(), FRAME_SIZE_BYTES);
+  const auto bufferData = outputBuffer.constData();
+
+  decoder.releaseOutputBuffer(outputBuffer);
+  EXPECT_TRUE(outputBuffer.isEmpty());
+
+  decoder.prepareOutputBuffer(outputBuffer, FRAME_SIZE_BYTES);
+  EXPECT_EQ(outputBuffer.size(), FRAME_SIZE_BYTES);
+  EXPECT_EQ(outputBuffer.constData(), bufferData);
+
+  // A smaller frame also fits into the released buffer
+  decoder.releaseOutputBuffer(outputBuffer);
+  decoder.prepareOutputBuffer(outputBuffer, FRAME_SIZE_BYTES / 2);
+  EXPECT_EQ(outputBuffer.size(), FRAME_SIZE_BYTES / 2);
+  EXPECT_EQ(outputBuffer.constData(), bufferData);
+}
+
+TEST(DecoderBaseTest, SharedBufferIsNeverWrittenTo)
+{
+  TestDecoder decoder;
+  QByteArray  outputBuffer;
+
+  decoder.prepareOutputBuffer(outputBuffer, FRAME_SIZE_BYTES);
+  std::memset(outputBuffer.data(), 'a', FRAME_SIZE_BYTES);
+
+  // The cache or the video handler still references the frame
+  const auto cachedFrame = outputBuffer;
+  decoder.releaseOutputBuffer(outputBuffer);
+
+  decoder.prepareOutputBuffer(outputBuffer, FRAME_SIZE_BYTES);
+  EXPECT_EQ(outputBuffer.size(), FRAME_SIZE_BYTES);
+  EXPECT_NE(outputBuffer.constData(), cachedFrame.constData());
+  std::memset(outputBuffer.data(), 'b', FRAME_SIZE_BYTES);
+
+  EXPECT_EQ(cachedFrame, QByteArray(FRAME_SIZE_BYTES, 'a'));
+}
+
+TEST(DecoderBaseTest, LargerFrameGetsNewBuffer)
+{
+  TestDecoder decoder;
+  QByteArray  outputBuffer;
+
+  decoder.prepareOutputBuffer(outputBuffer, FRAME_SIZE_BYTES);
+  decoder.releaseOutputBuffer(outputBuffer);
+
+  decoder.prepareOutputBuffer(outputBuffer, 2 * FRAME_SIZE_BYTES);
+  EXPECT_EQ(outputBuffer.size(), 2 * FRAME_SIZE_BYTES);
+}
+
+} // namespace
@@ -0,0 +1,178 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <TemporaryFile.h>
+#include <filesource/BitstreamIndex.h>
+
+#include <QDir>
+#include <QFile>
+#include <QStandardPaths>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+
+class BitstreamIndexTest : public testing::Test
+{
+protected:
+  void SetUp() override { QStandardPaths::setTestModeEnabled(true); }
+  void TearDown() override
+  {
+    QFile::remove(BitstreamIndex::getIndexFilePath(this->getFilePath()));
+    QStandardPaths::setTestModeEnabled(false);
+  }
+
+  QString getFilePath() const
+  {
+    return QString::fromStdString(this->bitstreamFile.getFilePathString());
+  }
+
+  yuviewTest::TemporaryFile bitstreamFile{ByteVector(1000, 0xab)};
+};
+
+void writeTestValues(BitstreamIndex &index)
+{
+  index.writeUInt(0);
+  index.writeUInt(127);
+  index.writeUInt(128);
+  index.writeUInt(std::numeric_limits<uint64_t>::max());
+  index.writeInt(-1);
+  index.writeInt(std::numeric_limits<int64_t>::min());
+  index.writeInt(std::numeric_limits<int64_t>::max());
+  index.writeBool(true);
+  index.writeCount(2);
+  index.writeBytes({0, 0, 1, 0x40, 0x01});
+  index.writeBytes({});
+}
+
+TEST_F(BitstreamIndexTest, SaveAndLoadValues)
+{
+  BitstreamIndex writeIndex;
+  writeTestValues(writeIndex);
+  EXPECT_TRUE(writeIndex.save(this->getFilePath(), "Test"));
+
+  BitstreamIndex readIndex;
+  ASSERT_TRUE(readIndex.load(this->getFilePath(), "Test"));
+  EXPECT_EQ(readIndex.readUInt(), 0u);
+  EXPECT_EQ(readIndex.readUInt(), 127u);
+  EXPECT_EQ(readIndex.readUInt(), 128u);
+  EXPECT_EQ(readIndex.readUInt(), std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(readIndex.readInt(), -1);
+  EXPECT_EQ(readIndex.readInt(), std::numeric_limits<int64_t>::min());
+  EXPECT_EQ(readIndex.readInt(), std::numeric_limits<int64_t>::max());
+  EXPECT_TRUE(readIndex.readBool());
+  EXPECT_EQ(readIndex.readCount(), 2u);
+  EXPECT_THAT(readIndex.readBytes(), ElementsAre(0, 0, 1, 0x40, 0x01));
+  EXPECT_TRUE(readIndex.readBytes().empty());
+  EXPECT_TRUE(readIndex.isValid());
+  EXPECT_TRUE(readIndex.atEnd());
+
+  // Reading beyond the end of the index fails
+  readIndex.readUInt();
+  EXPECT_FALSE(readIndex.isValid());
+}
+
+TEST_F(BitstreamIndexTest, IndexWithOtherFormatIsNotLoaded)
+{
+  BitstreamIndex writeIndex;
+  writeTestValues(writeIndex);
+  EXPECT_TRUE(writeIndex.save(this->getFilePath(), "Test"));
+
+  BitstreamIndex readIndex;
+  EXPECT_FALSE(readIndex.load(this->getFilePath(), "OtherTest"));
+}
+
+TEST_F(BitstreamIndexTest, IndexOfChangedFileIsNotLoaded)
+{
+  BitstreamIndex writeIndex;
+  writeTestValues(writeIndex);
+  EXPECT_TRUE(writeIndex.save(this->getFilePath(), "Test"));
+
+  {
+    std::ofstream file(this->bitstreamFile.getFilePath(), std::ios::binary | std::ios::app);
+    file << char(0);
+  }
+
+  BitstreamIndex readIndex;
+  EXPECT_FALSE(readIndex.load(this->getFilePath(), "Test"));
+}
+
+TEST_F(BitstreamIndexTest, CountLargerThanIndexIsInvalid)
+{
+  BitstreamIndex writeIndex;
+  writeIndex.writeCount(100);
+  writeIndex.writeUInt(1);
+  EXPECT_TRUE(writeIndex.save(this->getFilePath(), "Test"));
+
+  BitstreamIndex readIndex;
+  ASSERT_TRUE(readIndex.load(this->getFilePath(), "Test"));
+  EXPECT_EQ(readIndex.readCount(), 0u);
+  EXPECT_FALSE(readIndex.isValid());
+}
+
+TEST_F(BitstreamIndexTest, OldAndLeastRecentlyUsedIndicesAreRemoved)
+{
+  QDir(BitstreamIndex::getIndexDirectory()).removeRecursively();
+  ASSERT_TRUE(QDir().mkpath(BitstreamIndex::getIndexDirectory()));
+
+  auto createIndexFile = [](const QString &name, const int ageDays) {
+    const auto filePath = QDir(BitstreamIndex::getIndexDirectory()).filePath(name);
+    std::ofstream(filePath.toStdString(), std::ios::binary) << std::string(100, 'x');
+    std::filesystem::last_write_time(filePath.toStdString(),
+                                     std::filesystem::file_time_type::clock::now() -
+                                         std::chrono::hours(24 * ageDays));
+    return filePath;
+  };
+
+  const auto newIndex       = createIndexFile("new.idx", 0);
+  const auto olderIndex     = createIndexFile("older.idx", 10);
+  const auto oldestIndex    = createIndexFile("oldest.idx", 20);
+  const auto outdatedIndex  = createIndexFile("outdated.idx", 100);
+  const auto otherCacheFile = createIndexFile("other.txt", 100);
+
+  BitstreamIndex::removeOldIndices(250, 90);
+
+  EXPECT_TRUE(QFile::exists(newIndex));
+  EXPECT_TRUE(QFile::exists(olderIndex));
+  EXPECT_FALSE(QFile::exists(oldestIndex));
+  EXPECT_FALSE(QFile::exists(outdatedIndex));
+  EXPECT_TRUE(QFile::exists(otherCacheFile));
+
+  QDir(BitstreamIndex::getIndexDirectory()).removeRecursively();
+}
+
+} // namespace
@@ -101,14 +101,10 @@ std::string getTestName(const testing::TestParamInfo<TestParameters> &testParam)
                                     testParameters.startCodePositions);
 }
 
-TEST_P(FileSourceAnnexBTest, TestNalUnitParsing)
+void checkNalUnitParsing(FileSourceAnnexBFile &annexBFile, const TestParameters &testParameters)
 {
-  const auto testParameters = GetParam();
-
   const auto [nalSizes, data] = generateAnnexBStream(testParameters);
-  yuviewTest::TemporaryFile temporaryFile(data);
 
-  FileSourceAnnexBFile annexBFile(QString::fromStdString(temporaryFile.getFilePathString()));
   EXPECT_EQ(static_cast<int>(annexBFile.getNrBytesBeforeFirstNAL()),
             testParameters.startCodePositions.at(0));
 
@@ -119,6 +115,35 @@ TEST_P(FileSourceAnnexBTest, TestNalUnitParsing)
     EXPECT_EQ(nalSizes.at(counter++), static_cast<int>(nalData.size()));
     nalData = annexBFile.getNextNALUnit();
   }
+  EXPECT_EQ(counter, static_cast<int>(nalSizes.size()));
+}
+
+TEST_P(FileSourceAnnexBTest, TestNalUnitParsing)
+{
+  const auto testParameters = GetParam();
+
+  const auto [nalSizes, data] = generateAnnexBStream(testParameters);
+  yuviewTest::TemporaryFile temporaryFile(data);
+  temporaryFile.setModificationTimeToPast();
+
+  FileSourceAnnexBFile annexBFile;
+  annexBFile.setUseMemoryMapping(true);
+  annexBFile.openFile(QString::fromStdString(temporaryFile.getFilePathString()));
+  EXPECT_TRUE(annexBFile.isMemoryMapped());
+  checkNalUnitParsing(annexBFile, testParameters);
+}
+
+TEST_P(FileSourceAnnexBTest, TestNalUnitParsingWithoutMemoryMapping)
+{
+  const auto testParameters = GetParam();
+
+  const auto [nalSizes, data] = generateAnnexBStream(testParameters);
+  yuviewTest::TemporaryFile temporaryFile(data);
+
+  FileSourceAnnexBFile annexBFile;
+  annexBFile.setUseMemoryMapping(false);
+  annexBFile.openFile(QString::fromStdString(temporaryFile.getFilePathString()));
+  checkNalUnitParsing(annexBFile, testParameters);
 }
 
 INSTANTIATE_TEST_SUITE_P(
@@ -149,4 +174,38 @@ INSTANTIATE_TEST_SUITE_P(
            TestParameters({3, 10000, {80, 208, 500, 9997}})),
     getTestName);
 
+TEST(FileSourceAnnexBStartCodeTest, FindStartCodeWithAllInstructionSets)
+{
+  std::vector<char> data(200, char(0x80));
+  // Zero bytes that are not part of a start code
+  data[10] = 0;
+  data[40] = 0;
+  data[41] = 0;
+  data[42] = 2;
+
+  for (const auto instructionSet : simd::getAllSupportedInstructionSets())
+  {
+    for (const auto startCodePos : {0, 15, 16, 17, 31, 32, 33, 60, 150, 197})
+    {
+      auto dataWithStartCode              = data;
+      dataWithStartCode[startCodePos]     = 0;
+      dataWithStartCode[startCodePos + 1] = 0;
+      dataWithStartCode[startCodePos + 2] = 1;
+      EXPECT_EQ(FileSourceAnnexBFile::findStartCode(
+                    dataWithStartCode.data(), int64_t(dataWithStartCode.size()), instructionSet),
+                startCodePos)
+          << "Instruction set " << simd::InstructionSetMapper.getName(instructionSet);
+    }
+    EXPECT_EQ(FileSourceAnnexBFile::findStartCode(data.data(), int64_t(data.size()), instructionSet),
+              -1);
+    // The start code must be complete
+    auto dataWithCutStartCode = data;
+    dataWithCutStartCode[198] = 0;
+    dataWithCutStartCode[199] = 0;
+    EXPECT_EQ(FileSourceAnnexBFile::findStartCode(
+                  dataWithCutStartCode.data(), int64_t(dataWithCutStartCode.size()), instructionSet),
+              -1);
+  }
+}
+
 } // namespace
@@ -0,0 +1,139 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <TemporaryFile.h>
+#include <filesource/FileSource.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+
+ByteVector createTestData(const int nrBytes, const int offset)
+{
+  ByteVector data(nrBytes);
+  for (int i = 0; i < nrBytes; i++)
+    data[i] = static_cast<unsigned char>((i + offset) % 251);
+  return data;
+}
+
+TEST(FileSourceTest, RecentlyModifiedFileIsNotMapped)
+{
+  yuviewTest::TemporaryFile temporaryFile(createTestData(1000, 0));
+
+  FileSource file;
+  EXPECT_TRUE(file.openFile(QString::fromStdString(temporaryFile.getFilePathString())));
+  EXPECT_FALSE(file.mapFileToMemory());
+  EXPECT_FALSE(file.isMemoryMapped());
+
+  QByteArray buffer;
+  EXPECT_EQ(file.readBytes(buffer, 100, 200), 200);
+  EXPECT_EQ(static_cast<unsigned char>(buffer.at(0)), 100);
+}
+
+TEST(FileSourceTest, DataAppendedAfterMappingIsReadFromFile)
+{
+  const auto                initialData = createTestData(1000, 0);
+  yuviewTest::TemporaryFile temporaryFile(initialData);
+  temporaryFile.setModificationTimeToPast();
+
+  FileSource file;
+  EXPECT_TRUE(file.openFile(QString::fromStdString(temporaryFile.getFilePathString())));
+  EXPECT_TRUE(file.mapFileToMemory());
+
+  const auto appendedData = createTestData(500, 1000);
+  {
+    std::ofstream writer(temporaryFile.getFilePath(), std::ios::binary | std::ios::app);
+    writer.write(reinterpret_cast<const char *>(appendedData.data()),
+                 std::streamsize(appendedData.size()));
+  }
+
+  // A range that starts in the mapping and ends in the appended data
+  QByteArray buffer;
+  EXPECT_EQ(file.readBytes(buffer, 900, 300), 300);
+  for (int i = 0; i < 300; i++)
+    EXPECT_EQ(static_cast<unsigned char>(buffer.at(i)), (900 + i) % 251);
+
+  // A range that is completely in the appended data
+  EXPECT_EQ(file.readBytes(buffer, 1200, 300), 300);
+  for (int i = 0; i < 300; i++)
+    EXPECT_EQ(static_cast<unsigned char>(buffer.at(i)), (1200 + i) % 251);
+
+  // Reading past the end of the file
+  EXPECT_EQ(file.readBytes(buffer, 1400, 300), 100);
+}
+
+TEST(FileSourceTest, MappingIsReleasedWhenTheFileIsTruncated)
+{
+  yuviewTest::TemporaryFile temporaryFile(createTestData(1000, 0));
+  temporaryFile.setModificationTimeToPast();
+
+  FileSource file;
+  EXPECT_TRUE(file.openFile(QString::fromStdString(temporaryFile.getFilePathString())));
+  EXPECT_TRUE(file.mapFileToMemory());
+
+  std::filesystem::resize_file(temporaryFile.getFilePath(), 500);
+
+  // Copying from the mapping beyond the new end of the file would crash
+  QByteArray buffer;
+  EXPECT_EQ(file.readBytes(buffer, 400, 300), 100);
+  EXPECT_FALSE(file.isMemoryMapped());
+  for (int i = 0; i < 100; i++)
+    EXPECT_EQ(static_cast<unsigned char>(buffer.at(i)), (400 + i) % 251);
+}
+
+TEST(FileSourceTest, MappingIsReleasedWhenTheFileIsRewritten)
+{
+  yuviewTest::TemporaryFile temporaryFile(createTestData(1000, 0));
+  temporaryFile.setModificationTimeToPast();
+
+  FileSource file;
+  EXPECT_TRUE(file.openFile(QString::fromStdString(temporaryFile.getFilePathString())));
+  EXPECT_TRUE(file.mapFileToMemory());
+
+  const auto newData = createTestData(1000, 7);
+  {
+    std::ofstream writer(temporaryFile.getFilePath(), std::ios::binary | std::ios::trunc);
+    writer.write(reinterpret_cast<const char *>(newData.data()), std::streamsize(newData.size()));
+  }
+
+  QByteArray buffer;
+  EXPECT_EQ(file.readBytes(buffer, 0, 1000), 1000);
+  EXPECT_FALSE(file.isMemoryMapped());
+  for (int i = 0; i < 1000; i++)
+    EXPECT_EQ(static_cast<unsigned char>(buffer.at(i)), (7 + i) % 251);
+}
+
+} // namespace
@@ -0,0 +1,442 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <TemporaryFile.h>
+#include <parser/AVC/ParserAnnexBAVC.h>
+#include <parser/HEVC/ParserAnnexBHEVC.h>
+#include <parser/Mpeg2/ParserAnnexBMpeg2.h>
+
+namespace
+{
+
+// With one sequence header and 7 NAL units per GOP, the NAL units are split into 3 chunks
+constexpr auto NR_GOPS           = 40u;
+constexpr auto PICTURES_PER_GOP  = 3u;
+constexpr auto NR_NAL_UNITS      = 1 + NR_GOPS * (1 + 2 * PICTURES_PER_GOP);
+constexpr auto NR_LOADED_NAL_MAX = 256u;
+
+// The AVC and HEVC streams are split into 3 chunks as well
+constexpr auto AVC_NR_FRAMES     = 150u;
+constexpr auto AVC_NR_NAL_UNITS  = 2 + 2 * AVC_NR_FRAMES;
+constexpr auto HEVC_NR_FRAMES    = 300u;
+constexpr auto HEVC_NR_NAL_UNITS = 3 + HEVC_NR_FRAMES;
+
+void addNALUnit(ByteVector &data, unsigned char startCodeValue, const ByteVector &payload)
+{
+  data.insert(data.end(), {char(0), char(0), char(1), char(startCodeValue)});
+  data.insert(data.end(), payload.begin(), payload.end());
+}
+
+// A stream of intra pictures. The POCs count up over the GOPs, so the names of the picture headers
+// depend on the state of the parser from all GOPs before.
+ByteVector createMpeg2Stream()
+{
+  ByteVector data;
+  // 16x16, aspect ratio 1, 30 fps, no quantiser matrices
+  addNALUnit(data, 0xb3, {char(0x01), char(0x00), char(0x10), char(0x13), char(0xff), char(0xff),
+                          char(0xe0), char(0x08)});
+  for (unsigned gop = 0; gop < NR_GOPS; gop++)
+  {
+    addNALUnit(data, 0xb8, {char(0x00), char(0x08), char(0x00), char(0x40)});
+    for (unsigned temporalReference = 0; temporalReference < PICTURES_PER_GOP; temporalReference++)
+    {
+      // temporal_reference, picture_coding_type I, vbv_delay 0xffff, no extra information
+      const auto header = (temporalReference << 22) | (1u << 19) | (0xffffu << 3);
+      addNALUnit(data,
+                 0x00,
+                 {char(header >> 24), char(header >> 16), char(header >> 8), char(header)});
+      addNALUnit(data, 0x01, {char(0x12), char(0x34), char(0x56), char(0x78)});
+    }
+  }
+  return data;
+}
+
+// Writes the RBSP of the parameter sets and slice headers of the synthetic AVC and HEVC streams
+class BitWriter
+{
+public:
+  void writeBits(unsigned value, unsigned nrBits)
+  {
+    for (unsigned i = nrBits; i > 0; i--)
+      this->writeFlag((value >> (i - 1)) & 1);
+  }
+  void writeFlag(bool flag)
+  {
+    if (this->bitPos % 8 == 0)
+      this->data.push_back(0);
+    if (flag)
+      this->data.back() |= 0x80 >> (this->bitPos % 8);
+    this->bitPos++;
+  }
+  void writeUEV(unsigned value)
+  {
+    auto nrBits = 0u;
+    while ((value + 1) >> (nrBits + 1))
+      nrBits++;
+    this->writeBits(0, nrBits);
+    this->writeBits(value + 1, nrBits + 1);
+  }
+  void writeSEV(int value)
+  {
+    this->writeUEV(value > 0 ? unsigned(2 * value - 1) : unsigned(-2 * value));
+  }
+  ByteVector finishRBSP()
+  {
+    this->writeFlag(true);
+    while (this->bitPos % 8 != 0)
+      this->writeFlag(false);
+    return this->data;
+  }
+
+private:
+  ByteVector data;
+  unsigned   bitPos{};
+};
+
+void addNALUnitWithHeader(ByteVector &data, const ByteVector &header, const ByteVector &rbsp)
+{
+  data.insert(data.end(), {0, 0, 0, 1});
+  data.insert(data.end(), header.begin(), header.end());
+  auto nrZeroBytes = 0u;
+  for (const auto byte : rbsp)
+  {
+    if (nrZeroBytes == 2 && byte <= 3)
+    {
+      data.push_back(3);
+      nrZeroBytes = 0;
+    }
+    data.push_back(byte);
+    nrZeroBytes = (byte == 0) ? nrZeroBytes + 1 : 0;
+  }
+}
+
+// 32x16 intra frames with two slices each. The 4 bit POC LSB wraps every 8 frames, so the POCs
+// depend on the state of the parser from all frames before.
+ByteVector createAVCStream()
+{
+  ByteVector data;
+
+  BitWriter sps;
+  sps.writeBits(66, 8); // profile_idc baseline
+  sps.writeBits(0, 8);  // constraint flags
+  sps.writeBits(30, 8); // level_idc
+  sps.writeUEV(0);      // seq_parameter_set_id
+  sps.writeUEV(0);      // log2_max_frame_num_minus4
+  sps.writeUEV(0);      // pic_order_cnt_type
+  sps.writeUEV(0);      // log2_max_pic_order_cnt_lsb_minus4
+  sps.writeUEV(1);      // max_num_ref_frames
+  sps.writeFlag(false); // gaps_in_frame_num_value_allowed_flag
+  sps.writeUEV(1);      // pic_width_in_mbs_minus1
+  sps.writeUEV(0);      // pic_height_in_map_units_minus1
+  sps.writeFlag(true);  // frame_mbs_only_flag
+  sps.writeFlag(true);  // direct_8x8_inference_flag
+  sps.writeFlag(false); // frame_cropping_flag
+  sps.writeFlag(false); // vui_parameters_present_flag
+  addNALUnitWithHeader(data, {0x67}, sps.finishRBSP());
+
+  BitWriter pps;
+  pps.writeUEV(0);      // pic_parameter_set_id
+  pps.writeUEV(0);      // seq_parameter_set_id
+  pps.writeFlag(false); // entropy_coding_mode_flag
+  pps.writeFlag(false); // bottom_field_pic_order_in_frame_present_flag
+  pps.writeUEV(0);      // num_slice_groups_minus1
+  pps.writeUEV(0);      // num_ref_idx_l0_default_active_minus1
+  pps.writeUEV(0);      // num_ref_idx_l1_default_active_minus1
+  pps.writeFlag(false); // weighted_pred_flag
+  pps.writeBits(0, 2);  // weighted_bipred_idc
+  pps.writeSEV(0);      // pic_init_qp_minus26
+  pps.writeSEV(0);      // pic_init_qs_minus26
+  pps.writeSEV(0);      // chroma_qp_index_offset
+  pps.writeFlag(false); // deblocking_filter_control_present_flag
+  pps.writeFlag(false); // constrained_intra_pred_flag
+  pps.writeFlag(false); // redundant_pic_cnt_present_flag
+  addNALUnitWithHeader(data, {0x68}, pps.finishRBSP());
+
+  for (unsigned frame = 0; frame < AVC_NR_FRAMES; frame++)
+  {
+    const auto isIDR = (frame == 0);
+    for (unsigned firstMB = 0; firstMB < 2; firstMB++)
+    {
+      BitWriter slice;
+      slice.writeUEV(firstMB);        // first_mb_in_slice
+      slice.writeUEV(7);              // slice_type I
+      slice.writeUEV(0);              // pic_parameter_set_id
+      slice.writeBits(frame % 16, 4); // frame_num
+      if (isIDR)
+        slice.writeUEV(0); // idr_pic_id
+      slice.writeBits((2 * frame) % 16, 4); // pic_order_cnt_lsb
+      if (isIDR)
+      {
+        slice.writeFlag(false); // no_output_of_prior_pics_flag
+        slice.writeFlag(false); // long_term_reference_flag
+      }
+      else
+        slice.writeFlag(false); // adaptive_ref_pic_marking_mode_flag
+      slice.writeSEV(0);        // slice_qp_delta
+      const unsigned char nalHeader = isIDR ? 0x65 : 0x41;
+      addNALUnitWithHeader(data, {nalHeader}, slice.finishRBSP());
+    }
+  }
+  return data;
+}
+
+// 64x64 intra frames. The 8 bit POC LSB wraps every 256 frames, so the POCs depend on the state of
+// the parser from all frames before.
+ByteVector createHEVCStream()
+{
+  ByteVector data;
+
+  const auto writeProfileTierLevel = [](BitWriter &writer) {
+    writer.writeBits(0, 2);           // general_profile_space
+    writer.writeFlag(false);          // general_tier_flag
+    writer.writeBits(1, 5);           // general_profile_idc main
+    writer.writeBits(0x60000000, 32); // general_profile_compatibility_flag
+    writer.writeFlag(true);           // general_progressive_source_flag
+    writer.writeFlag(false);          // general_interlaced_source_flag
+    writer.writeFlag(false);          // general_non_packed_constraint_flag
+    writer.writeFlag(true);           // general_frame_only_constraint_flag
+    writer.writeBits(0, 32);          // general_reserved_zero_bits
+    writer.writeBits(0, 11);
+    writer.writeFlag(false); // general_inbld_flag
+    writer.writeBits(60, 8); // general_level_idc
+  };
+
+  BitWriter vps;
+  vps.writeBits(0, 4);       // vps_video_parameter_set_id
+  vps.writeFlag(true);       // vps_base_layer_internal_flag
+  vps.writeFlag(true);       // vps_base_layer_available_flag
+  vps.writeBits(0, 6);       // vps_max_layers_minus1
+  vps.writeBits(0, 3);       // vps_max_sub_layers_minus1
+  vps.writeFlag(true);       // vps_temporal_id_nesting_flag
+  vps.writeBits(0xffff, 16); // vps_reserved_0xffff_16bits
+  writeProfileTierLevel(vps);
+  vps.writeFlag(true);  // vps_sub_layer_ordering_info_present_flag
+  vps.writeUEV(0);      // vps_max_dec_pic_buffering_minus1
+  vps.writeUEV(0);      // vps_max_num_reorder_pics
+  vps.writeUEV(0);      // vps_max_latency_increase_plus1
+  vps.writeBits(0, 6);  // vps_max_layer_id
+  vps.writeUEV(0);      // vps_num_layer_sets_minus1
+  vps.writeFlag(false); // vps_timing_info_present_flag
+  vps.writeFlag(false); // vps_extension_flag
+  addNALUnitWithHeader(data, {0x40, 0x01}, vps.finishRBSP());
+
+  BitWriter sps;
+  sps.writeBits(0, 4); // sps_video_parameter_set_id
+  sps.writeBits(0, 3); // sps_max_sub_layers_minus1
+  sps.writeFlag(true); // sps_temporal_id_nesting_flag
+  writeProfileTierLevel(sps);
+  sps.writeUEV(0);      // sps_seq_parameter_set_id
+  sps.writeUEV(1);      // chroma_format_idc
+  sps.writeUEV(64);     // pic_width_in_luma_samples
+  sps.writeUEV(64);     // pic_height_in_luma_samples
+  sps.writeFlag(false); // conformance_window_flag
+  sps.writeUEV(0);      // bit_depth_luma_minus8
+  sps.writeUEV(0);      // bit_depth_chroma_minus8
+  sps.writeUEV(4);      // log2_max_pic_order_cnt_lsb_minus4
+  sps.writeFlag(true);  // sps_sub_layer_ordering_info_present_flag
+  sps.writeUEV(0);      // sps_max_dec_pic_buffering_minus1
+  sps.writeUEV(0);      // sps_max_num_reorder_pics
+  sps.writeUEV(0);      // sps_max_latency_increase_plus1
+  sps.writeUEV(0);      // log2_min_luma_coding_block_size_minus3
+  sps.writeUEV(1);      // log2_diff_max_min_luma_coding_block_size
+  sps.writeUEV(0);      // log2_min_luma_transform_block_size_minus2
+  sps.writeUEV(1);      // log2_diff_max_min_luma_transform_block_size
+  sps.writeUEV(0);      // max_transform_hierarchy_depth_inter
+  sps.writeUEV(0);      // max_transform_hierarchy_depth_intra
+  sps.writeFlag(false); // scaling_list_enabled_flag
+  sps.writeFlag(false); // amp_enabled_flag
+  sps.writeFlag(false); // sample_adaptive_offset_enabled_flag
+  sps.writeFlag(false); // pcm_enabled_flag
+  sps.writeUEV(0);      // num_short_term_ref_pic_sets
+  sps.writeFlag(false); // long_term_ref_pics_present_flag
+  sps.writeFlag(false); // sps_temporal_mvp_enabled_flag
+  sps.writeFlag(false); // strong_intra_smoothing_enabled_flag
+  sps.writeFlag(false); // vui_parameters_present_flag
+  sps.writeFlag(false); // sps_extension_present_flag
+  addNALUnitWithHeader(data, {0x42, 0x01}, sps.finishRBSP());
+
+  BitWriter pps;
+  pps.writeUEV(0);      // pps_pic_parameter_set_id
+  pps.writeUEV(0);      // pps_seq_parameter_set_id
+  pps.writeFlag(false); // dependent_slice_segments_enabled_flag
+  pps.writeFlag(false); // output_flag_present_flag
+  pps.writeBits(0, 3);  // num_extra_slice_header_bits
+  pps.writeFlag(false); // sign_data_hiding_enabled_flag
+  pps.writeFlag(false); // cabac_init_present_flag
+  pps.writeUEV(0);      // num_ref_idx_l0_default_active_minus1
+  pps.writeUEV(0);      // num_ref_idx_l1_default_active_minus1
+  pps.writeSEV(0);      // init_qp_minus26
+  pps.writeFlag(false); // constrained_intra_pred_flag
+  pps.writeFlag(false); // transform_skip_enabled_flag
+  pps.writeFlag(false); // cu_qp_delta_enabled_flag
+  pps.writeSEV(0);      // pps_cb_qp_offset
+  pps.writeSEV(0);      // pps_cr_qp_offset
+  pps.writeFlag(false); // pps_slice_chroma_qp_offsets_present_flag
+  pps.writeFlag(false); // weighted_pred_flag
+  pps.writeFlag(false); // weighted_bipred_flag
+  pps.writeFlag(false); // transquant_bypass_enabled_flag
+  pps.writeFlag(false); // tiles_enabled_flag
+  pps.writeFlag(false); // entropy_coding_sync_enabled_flag
+  pps.writeFlag(false); // pps_loop_filter_across_slices_enabled_flag
+  pps.writeFlag(false); // deblocking_filter_control_present_flag
+  pps.writeFlag(false); // pps_scaling_list_data_present_flag
+  pps.writeFlag(false); // lists_modification_present_flag
+  pps.writeUEV(0);      // log2_parallel_merge_level_minus2
+  pps.writeFlag(false); // slice_segment_header_extension_present_flag
+  pps.writeFlag(false); // pps_extension_present_flag
+  addNALUnitWithHeader(data, {0x44, 0x01}, pps.finishRBSP());
+
+  for (unsigned frame = 0; frame < HEVC_NR_FRAMES; frame++)
+  {
+    const auto isIDR = (frame == 0);
+    BitWriter  slice;
+    slice.writeFlag(true); // first_slice_segment_in_pic_flag
+    if (isIDR)
+      slice.writeFlag(false); // no_output_of_prior_pics_flag
+    slice.writeUEV(0);        // slice_pic_parameter_set_id
+    slice.writeUEV(2);        // slice_type I
+    if (!isIDR)
+    {
+      slice.writeBits(frame % 256, 8); // slice_pic_order_cnt_lsb
+      slice.writeFlag(false);          // short_term_ref_pic_set_sps_flag
+      slice.writeUEV(0);               // num_negative_pics
+      slice.writeUEV(0);               // num_positive_pics
+    }
+    slice.writeSEV(0); // slice_qp_delta
+    // IDR_W_RADL or TRAIL_R
+    const unsigned char nalHeader = isIDR ? (19 << 1) : (1 << 1);
+    addNALUnitWithHeader(data, {nalHeader, 0x01}, slice.finishRBSP());
+  }
+  return data;
+}
+
+void parseStream(parser::ParserAnnexB &parser, const yuviewTest::TemporaryFile &file)
+{
+  parser.enableModel();
+  ASSERT_TRUE(parser.runParsingOfFile(QString::fromStdString(file.getFilePathString())));
+  parser.updateNumberModelItems();
+}
+
+void expectEqualItems(const QModelIndex &expected, const QModelIndex &actual)
+{
+  for (int column = 0; column < expected.model()->columnCount(); column++)
+    EXPECT_EQ(expected.sibling(expected.row(), column).data().toString().toStdString(),
+              actual.sibling(actual.row(), column).data().toString().toStdString());
+
+  const auto nrRows = expected.model()->rowCount(expected);
+  ASSERT_EQ(actual.model()->rowCount(actual), nrRows);
+  for (int row = 0; row < nrRows; row++)
+    expectEqualItems(expected.model()->index(row, 0, expected),
+                     actual.model()->index(row, 0, actual));
+}
+
+template <typename ParserType>
+void expectLoadedNALUnitSyntaxEqualsSyntaxParsedWithTheFile(const ByteVector &data,
+                                                            const unsigned    nrNALUnits)
+{
+  yuviewTest::TemporaryFile file(data);
+
+  ParserType parserWithSyntax;
+  parserWithSyntax.setLoadNALUnitSyntaxOnDemand(false);
+  parseStream(parserWithSyntax, file);
+  const auto modelWithSyntax = parserWithSyntax.getPacketItemModel();
+
+  ParserType parserOnDemand;
+  parseStream(parserOnDemand, file);
+  const auto modelOnDemand = parserOnDemand.getPacketItemModel();
+
+  ASSERT_EQ(modelWithSyntax->rowCount(), int(nrNALUnits));
+  ASSERT_EQ(modelOnDemand->rowCount(), int(nrNALUnits));
+
+  for (int row = 0; row < int(nrNALUnits); row++)
+  {
+    const auto indexWithSyntax = modelWithSyntax->index(row, 0);
+    const auto indexOnDemand   = modelOnDemand->index(row, 0);
+    EXPECT_FALSE(modelWithSyntax->canFetchMore(indexWithSyntax));
+    EXPECT_GT(modelWithSyntax->rowCount(indexWithSyntax), 0);
+
+    ASSERT_TRUE(modelOnDemand->canFetchMore(indexOnDemand));
+    EXPECT_EQ(modelOnDemand->rowCount(indexOnDemand), 0);
+    modelOnDemand->fetchMore(indexOnDemand);
+    EXPECT_FALSE(modelOnDemand->canFetchMore(indexOnDemand));
+
+    expectEqualItems(indexWithSyntax, indexOnDemand);
+  }
+}
+
+TEST(ParserAnnexBTest, LoadedNALUnitSyntaxEqualsSyntaxParsedWithTheFile)
+{
+  expectLoadedNALUnitSyntaxEqualsSyntaxParsedWithTheFile<parser::ParserAnnexBMpeg2>(
+      createMpeg2Stream(), NR_NAL_UNITS);
+}
+
+TEST(ParserAnnexBTest, LoadedAVCNALUnitSyntaxEqualsSyntaxParsedWithTheFile)
+{
+  expectLoadedNALUnitSyntaxEqualsSyntaxParsedWithTheFile<parser::ParserAnnexBAVC>(
+      createAVCStream(), AVC_NR_NAL_UNITS);
+}
+
+TEST(ParserAnnexBTest, LoadedHEVCNALUnitSyntaxEqualsSyntaxParsedWithTheFile)
+{
+  expectLoadedNALUnitSyntaxEqualsSyntaxParsedWithTheFile<parser::ParserAnnexBHEVC>(
+      createHEVCStream(), HEVC_NR_NAL_UNITS);
+}
+
+TEST(ParserAnnexBTest, OnlyTheSyntaxOfTheLastLoadedNALUnitsIsKept)
+{
+  yuviewTest::TemporaryFile file(createMpeg2Stream());
+
+  parser::ParserAnnexBMpeg2 parser;
+  parseStream(parser, file);
+  const auto model = parser.getPacketItemModel();
+
+  for (int row = 0; row < int(NR_NAL_UNITS); row++)
+    model->fetchMore(model->index(row, 0));
+
+  const auto nrUnloaded = int(NR_NAL_UNITS - NR_LOADED_NAL_MAX);
+  for (int row = 0; row < int(NR_NAL_UNITS); row++)
+  {
+    const auto index = model->index(row, 0);
+    EXPECT_EQ(model->canFetchMore(index), row < nrUnloaded);
+    EXPECT_EQ(model->rowCount(index) > 0, row >= nrUnloaded);
+  }
+
+  // An unloaded NAL unit can be loaded again
+  const auto firstIndex = model->index(0, 0);
+  model->fetchMore(firstIndex);
+  EXPECT_GT(model->rowCount(firstIndex), 0);
+  EXPECT_TRUE(model->canFetchMore(model->index(nrUnloaded, 0)));
+}
+
+} // namespace
@@ -0,0 +1,155 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <parser/common/PacketItemModel.h>
+
+namespace
+{
+
+constexpr auto NR_FIRST_LEVEL_ITEMS = 5u;
+
+struct ModelWithLoader
+{
+  ModelWithLoader(size_t maxNrLoadedItems)
+  {
+    this->model.rootItem = std::make_shared<TreeItem>();
+    for (unsigned i = 0; i < NR_FIRST_LEVEL_ITEMS; i++)
+      this->model.rootItem->createChildItem("NAL " + std::to_string(i));
+    this->model.updateNumberModelItems();
+
+    this->model.setChildItemLoader(
+        [this](size_t row, TreeItem &item)
+        {
+          this->loadedRows.push_back(row);
+          if (!this->loadingSucceeds)
+            return false;
+          item.createChildItem("nal_unit_type", int(row));
+          item.createChildItem("nuh_layer_id", 0);
+          return true;
+        },
+        maxNrLoadedItems);
+  }
+
+  size_t getNrChildItems(int row) const
+  {
+    return this->model.rootItem->getChild(unsigned(row))->getNrChildItems();
+  }
+
+  PacketItemModel     model{nullptr};
+  std::vector<size_t> loadedRows;
+  bool                loadingSucceeds{true};
+};
+
+TEST(PacketItemModelTest, FetchMoreLoadsTheChildItemsOfAFirstLevelItem)
+{
+  ModelWithLoader modelWithLoader(NR_FIRST_LEVEL_ITEMS);
+  auto &          model = modelWithLoader.model;
+
+  const auto index = model.index(2, 0);
+  EXPECT_TRUE(model.hasChildren(index));
+  EXPECT_EQ(model.rowCount(index), 0);
+  EXPECT_TRUE(model.canFetchMore(index));
+
+  model.fetchMore(index);
+
+  EXPECT_THAT(modelWithLoader.loadedRows, ElementsAre(2u));
+  ASSERT_EQ(model.rowCount(index), 2);
+  EXPECT_EQ(model.index(0, 0, index).data().toString(), "nal_unit_type");
+  EXPECT_EQ(model.index(0, 1, index).data().toString(), "2");
+  EXPECT_FALSE(model.canFetchMore(index));
+
+  // Items below the first level are never loaded
+  EXPECT_FALSE(model.canFetchMore(model.index(0, 0, index)));
+  EXPECT_FALSE(model.hasChildren(model.index(0, 0, index)));
+
+  // Fetching again does not call the loader
+  model.fetchMore(index);
+  EXPECT_EQ(modelWithLoader.loadedRows.size(), 1u);
+  EXPECT_EQ(model.rowCount(index), 2);
+}
+
+TEST(PacketItemModelTest, FetchMoreCanBeRetriedIfLoadingFailed)
+{
+  ModelWithLoader modelWithLoader(NR_FIRST_LEVEL_ITEMS);
+  auto &          model = modelWithLoader.model;
+
+  const auto index                = model.index(1, 0);
+  modelWithLoader.loadingSucceeds = false;
+  model.fetchMore(index);
+
+  EXPECT_EQ(model.rowCount(index), 0);
+  EXPECT_TRUE(model.canFetchMore(index));
+
+  modelWithLoader.loadingSucceeds = true;
+  model.fetchMore(index);
+
+  EXPECT_THAT(modelWithLoader.loadedRows, ElementsAre(1u, 1u));
+  EXPECT_EQ(model.rowCount(index), 2);
+}
+
+TEST(PacketItemModelTest, OnlyTheChildItemsOfTheLastLoadedItemsAreKept)
+{
+  ModelWithLoader modelWithLoader(2);
+  auto &          model = modelWithLoader.model;
+
+  for (const auto row : {3, 0, 4})
+    model.fetchMore(model.index(row, 0));
+
+  EXPECT_EQ(modelWithLoader.getNrChildItems(3), 0u);
+  EXPECT_EQ(modelWithLoader.getNrChildItems(0), 2u);
+  EXPECT_EQ(modelWithLoader.getNrChildItems(4), 2u);
+
+  // The unloaded item can be loaded again
+  EXPECT_TRUE(model.canFetchMore(model.index(3, 0)));
+  model.fetchMore(model.index(3, 0));
+
+  EXPECT_THAT(modelWithLoader.loadedRows, ElementsAre(3u, 0u, 4u, 3u));
+  EXPECT_EQ(modelWithLoader.getNrChildItems(3), 2u);
+  EXPECT_EQ(modelWithLoader.getNrChildItems(0), 0u);
+  EXPECT_EQ(modelWithLoader.getNrChildItems(4), 2u);
+}
+
+TEST(PacketItemModelTest, NothingIsFetchedWithoutLoader)
+{
+  PacketItemModel model(nullptr);
+  model.rootItem = std::make_shared<TreeItem>();
+  model.rootItem->createChildItem("NAL 0");
+  model.updateNumberModelItems();
+
+  const auto index = model.index(0, 0);
+  EXPECT_FALSE(model.hasChildren(index));
+  EXPECT_FALSE(model.canFetchMore(index));
+}
+
+} // namespace
@@ -0,0 +1,98 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <parser/common/SubByteReaderLogging.h>
+
+namespace
+{
+
+using parser::reader::SubByteReaderLogging;
+
+// 0x00 0x00 0x03 is an emulation prevention sequence. The 0x03 is removed when reading.
+const ByteVector TEST_DATA = {0xa5, 0x00, 0x00, 0x03, 0x01, 0xff, 0x12, 0x34, 0x56,
+                              0x78, 0x9a, 0xbc, 0xde, 0xf0, 0x00, 0x00, 0x03, 0x00};
+
+void readTestValues(SubByteReaderLogging &reader)
+{
+  EXPECT_EQ(reader.readBits("first", 3), 0b101u);
+  EXPECT_EQ(reader.readBits("second", 24), 0x280000u);
+  EXPECT_EQ(reader.readBits("third", 5), 0b00001u);
+  EXPECT_TRUE(reader.readFlag("flag"));
+  EXPECT_EQ(reader.readUEV("ue"), 0u);
+  EXPECT_EQ(reader.readBits("long", 62), 0x3f123456789abcdeu);
+  EXPECT_EQ(reader.readBits("end", 16), 0xf000u);
+  EXPECT_EQ(reader.readBits("zeroes", 16), 0u);
+  EXPECT_THROW(reader.readFlag("overflow"), std::logic_error);
+}
+
+TEST(SubByteReaderLoggingTest, ReadWithoutLoggingIsIdenticalToReadingWithLogging)
+{
+  SubByteReaderLogging readerWithoutLogging(TEST_DATA, nullptr);
+  readTestValues(readerWithoutLogging);
+
+  auto                 rootItem = std::make_shared<TreeItem>();
+  SubByteReaderLogging readerWithLogging(TEST_DATA, rootItem);
+  readTestValues(readerWithLogging);
+
+  // The error is logged as an additional item
+  ASSERT_EQ(rootItem->getNrChildItems(), 9u);
+  EXPECT_EQ(rootItem->getChild(0)->getData(3), "101");
+  EXPECT_EQ(rootItem->getChild(1)->getData(3), "001010000000000000000000");
+  EXPECT_EQ(rootItem->getChild(4)->getData(3), "1");
+  EXPECT_EQ(rootItem->getChild(6)->getData(3), "1111000000000000");
+}
+
+TEST(SubByteReaderLoggingTest, ExpGolombCodes)
+{
+  // 1 | 010 | 011 | 00101 | 00100 | 0001000 | rbsp_stop_one_bit
+  const ByteVector data = {0b10100110, 0b01010010, 0b00001000, 0b10000000};
+
+  SubByteReaderLogging reader(data, nullptr);
+  EXPECT_EQ(reader.readUEV("ue"), 0u);
+  EXPECT_EQ(reader.readUEV("ue"), 1u);
+  EXPECT_EQ(reader.readSEV("se"), -1);
+  EXPECT_EQ(reader.readUEV("ue"), 4u);
+  EXPECT_EQ(reader.readSEV("se"), 2);
+  EXPECT_EQ(reader.readUEV("ue"), 7u);
+  EXPECT_FALSE(reader.more_rbsp_data());
+}
+
+TEST(SubByteReaderLoggingTest, EmulationPreventionCanBeDisabled)
+{
+  SubByteReaderLogging reader(TEST_DATA, nullptr);
+  reader.disableEmulationPrevention();
+  EXPECT_EQ(reader.readBits("bits", 40), 0xa500000301u);
+}
+
+} // namespace
@@ -0,0 +1,75 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common/Testing.h>
+
+#include <parser/common/TreeItem.h>
+
+namespace
+{
+
+TEST(TreeItemTest, AppendChildItemsOfOtherItem)
+{
+  auto rootItem = std::make_shared<TreeItem>();
+  rootItem->createChildItem("NAL 0");
+
+  auto chunkItem = std::make_shared<TreeItem>();
+  auto nal1      = chunkItem->createChildItem("NAL 1");
+  nal1->createChildItem("nal_unit_type", 1);
+  chunkItem->createChildItem("NAL 2");
+
+  rootItem->appendChildItemsOf(*chunkItem);
+
+  EXPECT_EQ(chunkItem->getNrChildItems(), 0u);
+  ASSERT_EQ(rootItem->getNrChildItems(), 3u);
+  EXPECT_EQ(rootItem->getChild(1), nal1);
+  EXPECT_EQ(rootItem->getChild(2)->getData(0), "NAL 2");
+  EXPECT_EQ(nal1->getParentItem().lock(), rootItem);
+  EXPECT_EQ(rootItem->getIndexOfChildItem(nal1), 1u);
+  EXPECT_EQ(nal1->getNrChildItems(), 1u);
+}
+
+TEST(TreeItemTest, ClearChildItems)
+{
+  auto nalItem = std::make_shared<TreeItem>();
+  nalItem->setProperties("NAL 0");
+  nalItem->createChildItem("nal_unit_type", 1);
+  nalItem->createChildItem("nuh_layer_id", 0);
+
+  nalItem->clearChildItems();
+
+  EXPECT_EQ(nalItem->getNrChildItems(), 0u);
+  EXPECT_EQ(nalItem->getData(0), "NAL 0");
+}
+
+} // namespace
@@ -0,0 +1,128 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <statistics/FrameTypeData.h>
+#include <statistics/SpatialIndex.h>
+
+#include <algorithm>
+
+namespace
+{
+
+bool contains(const std::vector<unsigned> &indices, unsigned index)
+{
+  return std::find(indices.begin(), indices.end(), index) != indices.end();
+}
+
+TEST(SpatialIndex, testValueItemsInArea)
+{
+  stats::FrameTypeData data;
+  data.addBlockValue(0, 0, 16, 16, 1);
+  data.addBlockValue(200, 100, 16, 16, 2);
+  data.addBlockValue(900, 500, 256, 128, 3);
+
+  const auto itemsAtOrigin = data.getValueItemsInArea({4, 4, 4, 4});
+  EXPECT_TRUE(contains(itemsAtOrigin, 0));
+  EXPECT_FALSE(contains(itemsAtOrigin, 1));
+  EXPECT_FALSE(contains(itemsAtOrigin, 2));
+
+  const auto itemsInLargeBlock = data.getValueItemsInArea({1100, 600, 1100, 600});
+  EXPECT_FALSE(contains(itemsInLargeBlock, 0));
+  EXPECT_TRUE(contains(itemsInLargeBlock, 2));
+
+  const auto allItems = data.getValueItemsInArea({0, 0, 2000, 2000});
+  EXPECT_EQ(allItems, std::vector<unsigned>({0, 1, 2}));
+
+  // Adding an item after a query must update the index
+  data.addBlockValue(1500, 1500, 8, 8, 4);
+  EXPECT_TRUE(contains(data.getValueItemsInArea({1504, 1504, 1504, 1504}), 3));
+}
+
+TEST(SpatialIndex, testVectorItemsInArea)
+{
+  stats::FrameTypeData data;
+  data.addBlockVector(512, 512, 8, 8, 1, 1);
+  // A vector which points far to the left. Drawn from the block center with scaling 1.
+  data.addBlockVector(1024, 0, 8, 8, -800, 4);
+  // A line from (300, 300) to (600, 40)
+  data.addLine(300, 300, 16, 16, 0, 0, 300, -260);
+
+  const auto itemsNearEndOfVector = data.getVectorItemsInArea({228, 4, 230, 6}, 1);
+  EXPECT_TRUE(contains(itemsNearEndOfVector, 1));
+
+  const auto itemsNearEndOfLine = data.getVectorItemsInArea({598, 38, 602, 42}, 1);
+  EXPECT_TRUE(contains(itemsNearEndOfLine, 2));
+
+  const auto itemsInBlock = data.getVectorItemsInArea({514, 514, 514, 514}, 4);
+  EXPECT_TRUE(contains(itemsInBlock, 0));
+}
+
+TEST(SpatialIndex, testItemsInAreaAreUniqueAndInOrder)
+{
+  stats::SpatialIndex index;
+  // Items of 100x100 pixels in a 20x20 grid. Each item overlaps up to 4 cells.
+  index.build(400, [](size_t i) {
+    const auto x = int(i % 20) * 100;
+    const auto y = int(i / 20) * 100;
+    return stats::Area{x, y, x + 99, y + 99};
+  });
+
+  const auto checkItems = [&index](const stats::Area &area) {
+    std::vector<unsigned> expectedItems;
+    for (unsigned i = 0; i < 400; i++)
+    {
+      const auto x = int(i % 20) * 100;
+      const auto y = int(i / 20) * 100;
+      if (x <= area.xMax && x + 99 >= area.xMin && y <= area.yMax && y + 99 >= area.yMin)
+        expectedItems.push_back(i);
+    }
+
+    // The index may return more items but each one only once and in order
+    const auto items = index.getItemsInArea(area);
+    EXPECT_TRUE(std::is_sorted(items.begin(), items.end()));
+    EXPECT_EQ(std::adjacent_find(items.begin(), items.end()), items.end());
+    for (const auto item : expectedItems)
+      EXPECT_TRUE(contains(items, item));
+  };
+
+  // Small (sorted), big (marked) and whole frame areas
+  checkItems({150, 150, 260, 260});
+  checkItems({0, 0, 1500, 1500});
+  checkItems({-10, -10, 5000, 5000});
+
+  const auto allItems = index.getItemsInArea({0, 0, 1999, 1999});
+  EXPECT_EQ(allItems.size(), size_t(400));
+}
+
+} // namespace
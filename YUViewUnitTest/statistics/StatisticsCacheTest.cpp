@@ -0,0 +1,120 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common/Testing.h>
+
+#include <statistics/StatisticsCache.h>
+
+namespace
+{
+
+stats::FrameTypeData createFrameTypeData(int nrValues, int value)
+{
+  stats::FrameTypeData data;
+  for (int i = 0; i < nrValues; i++)
+    data.addBlockValue(static_cast<unsigned short>(i * 8), 0, 8, 8, value);
+  return data;
+}
+
+size_t getMemoryUsage(int nrValues)
+{
+  return stats::StatisticsCache::estimateMemoryUsage(createFrameTypeData(nrValues, 0));
+}
+
+TEST(StatisticsCache, InsertAndGetData)
+{
+  stats::StatisticsCache cache;
+  cache.setMemoryLimit(1000000);
+
+  cache.insert(0, 1, createFrameTypeData(10, 1));
+  cache.insert(0, 2, createFrameTypeData(20, 2));
+  cache.insert(3, 1, createFrameTypeData(30, 3));
+
+  const auto data = cache.get(0, 2);
+  ASSERT_TRUE(data);
+  ASSERT_EQ(data->valueData.size(), 20u);
+  EXPECT_EQ(data->valueData[0].value, 2);
+  EXPECT_FALSE(cache.get(1, 1));
+  EXPECT_FALSE(cache.contains(3, 2));
+
+  EXPECT_EQ(cache.getNumberCachedFrames(), 2u);
+  EXPECT_EQ(cache.getMemoryUsage(), getMemoryUsage(10) + getMemoryUsage(20) + getMemoryUsage(30));
+  EXPECT_THAT(cache.getCachedFrames({1}), ElementsAre(0, 3));
+  EXPECT_THAT(cache.getCachedFrames({1, 2}), ElementsAre(0));
+
+  // Replacing data must not count the replaced data
+  cache.insert(3, 1, createFrameTypeData(10, 4));
+  EXPECT_EQ(cache.getMemoryUsage(), 2 * getMemoryUsage(10) + getMemoryUsage(20));
+
+  cache.removeFrame(0);
+  EXPECT_THAT(cache.getCachedFrames({1}), ElementsAre(3));
+  EXPECT_EQ(cache.getMemoryUsage(), getMemoryUsage(10));
+
+  cache.clear();
+  EXPECT_EQ(cache.getNumberCachedFrames(), 0u);
+  EXPECT_EQ(cache.getMemoryUsage(), 0u);
+}
+
+TEST(StatisticsCache, LeastRecentlyUsedDataIsRemoved)
+{
+  stats::StatisticsCache cache;
+  cache.setMemoryLimit(3 * getMemoryUsage(100));
+
+  cache.insert(0, 1, createFrameTypeData(100, 0));
+  cache.insert(1, 1, createFrameTypeData(100, 1));
+  cache.insert(2, 1, createFrameTypeData(100, 2));
+  EXPECT_THAT(cache.getCachedFrames({1}), ElementsAre(0, 1, 2));
+
+  // Frame 0 was used so frame 1 is the least recently used one
+  EXPECT_TRUE(cache.get(0, 1));
+  cache.insert(3, 1, createFrameTypeData(100, 3));
+  EXPECT_THAT(cache.getCachedFrames({1}), ElementsAre(0, 2, 3));
+
+  cache.setMemoryLimit(getMemoryUsage(100));
+  EXPECT_THAT(cache.getCachedFrames({1}), ElementsAre(3));
+}
+
+TEST(StatisticsCache, DataLargerThanLimitIsNotInserted)
+{
+  stats::StatisticsCache cache;
+  cache.insert(0, 1, createFrameTypeData(10, 0));
+  EXPECT_FALSE(cache.contains(0, 1));
+
+  cache.setMemoryLimit(getMemoryUsage(10));
+  cache.insert(0, 1, createFrameTypeData(10, 0));
+  cache.insert(1, 1, createFrameTypeData(11, 0));
+  EXPECT_TRUE(cache.contains(0, 1));
+  EXPECT_FALSE(cache.contains(1, 1));
+}
+
+} // namespace
@@ -95,4 +95,64 @@ TEST(StatisticsData, testPixelValueRetrievalVector)
   EXPECT_EQ(dataOutside.at(0), QStringPair({"Something", "-"}));
 }
 
+TEST(StatisticsData, testFramesAreRestoredFromCache)
+{
+  stats::StatisticsData data;
+  data.getCache().setMemoryLimit(1000000);
+
+  constexpr auto typeID = 0;
+
+  stats::StatisticsType valueType(
+      typeID, "Something", stats::color::ColorMapper({0, 10}, stats::color::PredefinedType::Jet));
+  valueType.render = true;
+  data.addStatType(valueType);
+
+  for (int frameIndex = 0; frameIndex < 3; frameIndex++)
+  {
+    data.setFrameIndex(frameIndex);
+    data[typeID].addBlockValue(0, 0, 8, 8, frameIndex);
+  }
+  // The data of the current frame is only cached when another frame is set
+  EXPECT_THAT(data.getCachedFrames(), ElementsAre(0, 1));
+
+  EXPECT_TRUE(data.restoreFrameFromCache(1));
+  EXPECT_EQ(data.needsLoading(1), ItemLoadingState::LoadingNotNeeded);
+  EXPECT_EQ(data.getValuesAt(QPoint(4, 4)).at(0), QStringPair({"Something", "1"}));
+  EXPECT_THAT(data.getCachedFrames(), ElementsAre(0, 1, 2));
+
+  EXPECT_FALSE(data.restoreFrameFromCache(5));
+  EXPECT_EQ(data.needsLoading(5), ItemLoadingState::LoadingNeeded);
+}
+
+TEST(StatisticsData, testResetFrameDiscardsRestoredData)
+{
+  stats::StatisticsData data;
+  data.getCache().setMemoryLimit(1000000);
+
+  constexpr auto typeID = 0;
+
+  stats::StatisticsType valueType(
+      typeID, "Something", stats::color::ColorMapper({0, 10}, stats::color::PredefinedType::Jet));
+  valueType.render = true;
+  data.addStatType(valueType);
+
+  data.setFrameIndex(0);
+  data[typeID].addBlockValue(0, 0, 8, 8, 3);
+  data.setFrameIndex(1);
+  EXPECT_TRUE(data.restoreFrameFromCache(0));
+
+  // The frame is loaded again. Only the new data must be used.
+  data.resetFrame(0);
+  EXPECT_EQ(data.getFrameIndex(), 0);
+  EXPECT_EQ(data.needsLoading(0), ItemLoadingState::LoadingNeeded);
+  data[typeID].addBlockValue(0, 0, 8, 8, 5);
+  EXPECT_EQ(data[typeID].valueData.size(), std::size_t(1));
+  EXPECT_EQ(data.getValuesAt(QPoint(4, 4)).at(0), QStringPair({"Something", "5"}));
+
+  // Resetting another frame keeps the data of the previous frame in the cache
+  data.resetFrame(1);
+  EXPECT_TRUE(data.restoreFrameFromCache(0));
+  EXPECT_EQ(data.getValuesAt(QPoint(4, 4)).at(0), QStringPair({"Something", "5"}));
+}
+
 } // namespace
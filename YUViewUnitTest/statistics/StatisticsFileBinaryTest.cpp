@@ -0,0 +1,242 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include "CheckFunctions.h"
+
+#include <TemporaryFile.h>
+#include <statistics/StatisticsFileBinary.h>
+#include <statistics/StatisticsFileCSV.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+
+ByteVector getCSVTestData()
+{
+  const std::string stats_str =
+      R"(%;syntax-version;v1.2
+%;seq-specs;test;0;416;240;25;
+%;type;9;MVL0;vector;
+%;vectorColor;100;0;0;255
+%;scaleFactor;4
+%;type;1;PredMode;range;
+%;defaultRange;0;3;heat
+%;gridColor;255;255;255;
+0;0;0;16;16;1;2
+0;16;0;16;16;1;3
+0;0;0;16;16;9;-4;12
+2;32;16;8;8;9;7;-1
+2;32;16;8;8;1;1
+)";
+
+  return ByteVector(stats_str.begin(), stats_str.end());
+}
+
+bool writeLineFile(const QString &filePath)
+{
+  stats::FrameTypeData data;
+  data.addLine(0, 0, 16, 16, 0, 0, 15, 15);
+
+  stats::StatisticsFileBinaryWriter writer;
+  return writer.open(filePath, false) && writer.writeFrameTypeData(0, 0, data) &&
+         writer.finish({stats::StatisticsType(0, "Lines", 1)}, Size(64, 64), 0, -1);
+}
+
+class StatisticsFileBinaryTest : public testing::TestWithParam<bool>
+{
+protected:
+  QString getBinaryFilePath() const
+  {
+    return QString::fromStdString(this->binaryFile.getFilePathString());
+  }
+
+  yuviewTest::TemporaryFile csvFile{getCSVTestData()};
+  yuviewTest::TemporaryFile binaryFile{ByteVector()};
+};
+
+TEST_P(StatisticsFileBinaryTest, ConvertCSVFile)
+{
+  const auto compressChunks = GetParam();
+
+  {
+    stats::StatisticsData    csvData;
+    stats::StatisticsFileCSV csvStatFile(QString::fromStdString(csvFile.getFilePathString()),
+                                         csvData);
+    std::atomic_bool         breakAtomic(false);
+    EXPECT_TRUE(stats::convertToBinaryFile(
+        csvStatFile, csvData, this->getBinaryFilePath(), compressChunks, breakAtomic));
+  }
+
+  stats::StatisticsData       statData;
+  stats::StatisticsFileBinary statFile(this->getBinaryFilePath(), statData);
+  ASSERT_TRUE(statFile);
+
+  EXPECT_EQ(statData.getFrameSize(), Size(416, 240));
+  EXPECT_EQ(statFile.getMaxPoc(), 2);
+  EXPECT_EQ(statFile.getFramerate(), 25.0);
+
+  const auto &types = statData.getStatisticsTypes();
+  ASSERT_EQ(types.size(), size_t(2));
+  EXPECT_EQ(types[0].typeID, 9);
+  EXPECT_EQ(types[0].typeName, QString("MVL0"));
+  EXPECT_TRUE(types[0].hasVectorData);
+  EXPECT_EQ(types[0].vectorStyle.color.toHex(), "#640000");
+  EXPECT_EQ(types[0].vectorScale, 4);
+  EXPECT_EQ(types[1].typeID, 1);
+  EXPECT_EQ(types[1].typeName, QString("PredMode"));
+  EXPECT_TRUE(types[1].hasValueData);
+  EXPECT_EQ(types[1].colorMapper.valueRange.min, 0);
+  EXPECT_EQ(types[1].colorMapper.valueRange.max, 3);
+  EXPECT_EQ(types[1].colorMapper.predefinedType, stats::color::PredefinedType::Heat);
+  EXPECT_EQ(types[1].gridStyle.color.toHex(), "#ffffff");
+
+  statFile.loadStatisticData(statData, 0, 1);
+  statFile.loadStatisticData(statData, 0, 9);
+  EXPECT_EQ(statData.getFrameIndex(), 0);
+  yuviewTest::statistics::checkValueList(statData[1].valueData,
+                                         {{0, 0, 16, 16, 2}, {16, 0, 16, 16, 3}});
+  EXPECT_EQ(statData[1].maxBlockSize, 256u);
+  yuviewTest::statistics::checkVectorList(statData[9].vectorData, {{0, 0, 16, 16, -4, 12}});
+
+  // There is no data for POC 1
+  statFile.loadStatisticData(statData, 1, 1);
+  EXPECT_EQ(statData.getFrameIndex(), 1);
+  EXPECT_EQ(statData[1].valueData.size(), size_t(0));
+
+  statFile.loadStatisticData(statData, 2, 9);
+  EXPECT_EQ(statData.getFrameIndex(), 2);
+  yuviewTest::statistics::checkVectorList(statData[9].vectorData, {{32, 16, 8, 8, 7, -1}});
+}
+
+INSTANTIATE_TEST_SUITE_P(StatisticsFileBinaryTest,
+                         StatisticsFileBinaryTest,
+                         testing::Values(false, true),
+                         [](const testing::TestParamInfo<bool> &info) {
+                           return info.param ? "Compressed" : "Uncompressed";
+                         });
+
+TEST(StatisticsFileBinaryWriterTest, WriteAndReadAllItemTypes)
+{
+  yuviewTest::TemporaryFile binaryFile{ByteVector()};
+  const auto filePath = QString::fromStdString(binaryFile.getFilePathString());
+
+  stats::FrameTypeData data;
+  data.addBlockAffineTF(8, 16, 32, 32, 1, 2, 3, 4, 5, 6);
+  data.addLine(0, 0, 16, 16, 0, 0, 15, 15);
+  data.addPolygonValue({{0, 0}, {8, 0}, {0, 8}}, 7);
+  data.addPolygonVector({{4, 4}, {12, 4}, {12, 12}, {4, 12}}, -3, 9);
+
+  {
+    stats::StatisticsFileBinaryWriter writer;
+    ASSERT_TRUE(writer.open(filePath, false));
+    EXPECT_TRUE(writer.writeFrameTypeData(3, 0, data));
+    EXPECT_TRUE(writer.finish({stats::StatisticsType(0, "Something", 1)}, Size(64, 64), 3, -1));
+  }
+
+  stats::StatisticsData       statData;
+  stats::StatisticsFileBinary statFile(filePath, statData);
+  ASSERT_TRUE(statFile);
+  statFile.loadStatisticData(statData, 3, 0);
+
+  const auto &loaded = statData[0];
+  yuviewTest::statistics::checkAffineTFVectorList(loaded.affineTFData,
+                                                  {{8, 16, 32, 32, 1, 2, 3, 4, 5, 6}});
+  yuviewTest::statistics::checkLineList(loaded.vectorData, {{0, 0, 16, 16, 0, 0, 15, 15}});
+  ASSERT_EQ(loaded.polygonValueData.size(), size_t(1));
+  EXPECT_EQ(loaded.polygonValueData[0].corners, data.polygonValueData[0].corners);
+  EXPECT_EQ(loaded.polygonValueData[0].value, 7);
+  ASSERT_EQ(loaded.polygonVectorData.size(), size_t(1));
+  EXPECT_EQ(loaded.polygonVectorData[0].corners, data.polygonVectorData[0].corners);
+  EXPECT_EQ(loaded.polygonVectorData[0].point, stats::Point(-3, 9));
+}
+
+TEST(StatisticsFileBinaryWriterTest, ReadFromMappedFile)
+{
+  yuviewTest::TemporaryFile binaryFile{ByteVector()};
+  const auto filePath = QString::fromStdString(binaryFile.getFilePathString());
+  ASSERT_TRUE(writeLineFile(filePath));
+  binaryFile.setModificationTimeToPast();
+
+  stats::StatisticsData       statData;
+  stats::StatisticsFileBinary statFile(filePath, statData);
+  ASSERT_TRUE(statFile);
+  ASSERT_TRUE(statFile.mapFileToMemory());
+
+  statFile.loadStatisticData(statData, 0, 0);
+  ASSERT_TRUE(statFile);
+  yuviewTest::statistics::checkLineList(statData[0].vectorData, {{0, 0, 16, 16, 0, 0, 15, 15}});
+
+  // Reading the chunk from the mapping of the truncated file would crash
+  std::filesystem::resize_file(binaryFile.getFilePath(), 16);
+  statFile.loadStatisticData(statData, 0, 0);
+  EXPECT_FALSE(statFile);
+}
+
+TEST(StatisticsFileBinaryWriterTest, InvalidVectorItemIsAnError)
+{
+  yuviewTest::TemporaryFile binaryFile{ByteVector()};
+  const auto filePath = QString::fromStdString(binaryFile.getFilePathString());
+  ASSERT_TRUE(writeLineFile(filePath));
+
+  // Header (12 bytes), the 5 item counts (20 bytes) and the position/size of the vector (8 bytes).
+  // Then follows the isLine flag.
+  constexpr auto isLinePosition = 12 + 20 + 8;
+  {
+    std::fstream file(binaryFile.getFilePath(), std::ios::binary | std::ios::in | std::ios::out);
+    file.seekg(isLinePosition);
+    ASSERT_EQ(file.get(), 1);
+    file.seekp(isLinePosition);
+    file.put(7);
+  }
+
+  stats::StatisticsData       statData;
+  stats::StatisticsFileBinary statFile(filePath, statData);
+  ASSERT_TRUE(statFile);
+  statFile.loadStatisticData(statData, 0, 0);
+  EXPECT_FALSE(statFile);
+}
+
+TEST(StatisticsFileBinaryWriterTest, OtherFileIsNotOpened)
+{
+  yuviewTest::TemporaryFile otherFile{ByteVector(100, 0xab)};
+
+  stats::StatisticsData       statData;
+  stats::StatisticsFileBinary statFile(QString::fromStdString(otherFile.getFilePathString()),
+                                       statData);
+  EXPECT_FALSE(statFile);
+}
+
+} // namespace
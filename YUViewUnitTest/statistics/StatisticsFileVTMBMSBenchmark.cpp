@@ -0,0 +1,204 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <TemporaryFile.h>
+#include <statistics/StatisticsFileVTMBMS.h>
+
+#include <QFile>
+#include <QRegularExpression>
+#include <QTextStream>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+/* Benchmark for parsing big VTMBMS files. This is disabled by default. Run it with
+ * --gtest_also_run_disabled_tests --gtest_filter=*VTMBMSBenchmark*
+ * The size of the generated trace (in MB) can be set with the environment variable
+ * YUVIEW_VTMBMS_BENCHMARK_SIZE_MB (default 4096, so that file positions exceed 32 bit).
+ */
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto FRAME_WIDTH  = 7680;
+constexpr auto FRAME_HEIGHT = 4320;
+constexpr auto BLOCK_SIZE   = 16;
+
+const std::vector<std::pair<std::string, std::string>> BENCHMARK_TYPES = {
+    {"PredMode", "Integer; [0, 4]"},
+    {"SkipFlag", "Flag"},
+    {"MergeFlag", "Flag"},
+    {"IntraDir", "Integer; [0, 66]"},
+    {"QP", "Integer; [0, 63]"},
+    {"MVL0", "Vector; Scale: 4"},
+    {"MVL1", "Vector; Scale: 4"},
+    {"AffineMVL0", "AffineTFVectors; Scale: 4"}};
+
+int64_t getBenchmarkFileSize()
+{
+  int64_t sizeInMB = 4096;
+  if (const auto sizeString = std::getenv("YUVIEW_VTMBMS_BENCHMARK_SIZE_MB"))
+    sizeInMB = std::atoll(sizeString);
+  return sizeInMB * 1024 * 1024;
+}
+
+void writeBenchmarkFile(const std::filesystem::path &filePath, int64_t targetFileSize)
+{
+  std::ofstream file(filePath, std::ios::out | std::ios::binary);
+
+  file << "# VTMBMS Block Statistics\n";
+  file << "# Sequence size: [" << FRAME_WIDTH << "x " << FRAME_HEIGHT << "]\n";
+  for (const auto &[name, typeInfo] : BENCHMARK_TYPES)
+    file << "# Block Statistic Type: " << name << "; " << typeInfo << "\n";
+
+  for (int poc = 0; file.tellp() < targetFileSize; poc++)
+  {
+    for (int y = 0; y < FRAME_HEIGHT; y += BLOCK_SIZE)
+    {
+      for (int x = 0; x < FRAME_WIDTH; x += BLOCK_SIZE)
+      {
+        const auto block = "BlockStat: POC " + std::to_string(poc) + " @(" + std::to_string(x) +
+                           ", " + std::to_string(y) + ") [16x16] ";
+        const auto v = (x + y + poc) % 64;
+        file << block << "PredMode=" << v % 4 << "\n";
+        file << block << "SkipFlag=" << v % 2 << "\n";
+        file << block << "MergeFlag=" << (v / 2) % 2 << "\n";
+        file << block << "IntraDir=" << v << "\n";
+        file << block << "QP=" << 22 + v % 16 << "\n";
+        file << block << "MVL0={ " << v - 32 << ", " << 12 - v << "}\n";
+        file << block << "MVL1={ " << 5 - v << ", " << v << "}\n";
+        file << block << "AffineMVL0={ " << v << ", -" << v << ", 3, 4, " << v - 7 << ", 6}\n";
+      }
+    }
+  }
+}
+
+// This is how POCs were parsed before: One pass over the POC with regular expressions for every
+// type. Returns the number of items.
+size_t parseFirstPOCWithRegularExpressions(const QString &             filePath,
+                                          const stats::StatisticsType &type)
+{
+  QFile file(filePath);
+  file.open(QIODevice::ReadOnly);
+  QTextStream in(&file);
+
+  QRegularExpression pocRegex("BlockStat: POC ([0-9]+)");
+  QRegularExpression typeRegex(" " + type.typeName + "=");
+  QRegularExpression scalarRegex(
+      "POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x *([0-9]+)\\] *\\w+=([0-9\\-]+)");
+  QRegularExpression vectorRegex("POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x "
+                                 "*([0-9]+)\\] *\\w+={ *([0-9\\-]+), *([0-9\\-]+)}");
+  QRegularExpression affineTFRegex(
+      "POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x *([0-9]+)\\] *\\w+={ "
+      "*([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+)}");
+
+  size_t nrItems = 0;
+  while (!in.atEnd())
+  {
+    const auto line     = in.readLine();
+    const auto pocMatch = pocRegex.match(line);
+    if (!pocMatch.hasMatch())
+      continue;
+    if (pocMatch.captured(1).toInt() != 0)
+      break;
+    if (!typeRegex.match(line).hasMatch())
+      continue;
+
+    QRegularExpressionMatch match;
+    if (type.hasValueData)
+      match = scalarRegex.match(line);
+    else if (type.hasVectorData)
+      match = vectorRegex.match(line);
+    else if (type.hasAffineTFData)
+      match = affineTFRegex.match(line);
+    if (match.hasMatch())
+      nrItems++;
+  }
+  return nrItems;
+}
+
+size_t getNrItems(const stats::FrameTypeData &data)
+{
+  return data.valueData.size() + data.vectorData.size() + data.affineTFData.size() +
+         data.polygonValueData.size() + data.polygonVectorData.size();
+}
+
+double getSecondsSince(Clock::time_point start)
+{
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+TEST(StatisticsFileVTMBMS, DISABLED_VTMBMSBenchmark)
+{
+  yuviewTest::TemporaryFile benchmarkFile{ByteVector()};
+  writeBenchmarkFile(benchmarkFile.getFilePath(), getBenchmarkFileSize());
+  const auto filePath = QString::fromStdString(benchmarkFile.getFilePathString());
+
+  stats::StatisticsData       statData;
+  stats::StatisticsFileVTMBMS statFile(filePath, statData);
+  ASSERT_EQ(statData.getStatisticsTypes().size(), BENCHMARK_TYPES.size());
+
+  auto             start = Clock::now();
+  std::atomic_bool breakAtomic(false);
+  statFile.readFrameAndTypePositionsFromFile(breakAtomic);
+  const auto secondsIndexing = getSecondsSince(start);
+
+  // Load all types of a frame the same way that the playlist item does it
+  for (auto &type : statData.getStatisticsTypes())
+    type.render = true;
+  start = Clock::now();
+  for (const auto typeID : statData.getTypesThatNeedLoading(0))
+    statFile.loadStatisticData(statData, 0, typeID);
+  const auto secondsLoading = getSecondsSince(start);
+
+  start = Clock::now();
+  for (const auto &type : statData.getStatisticsTypes())
+    EXPECT_EQ(parseFirstPOCWithRegularExpressions(filePath, type),
+              getNrItems(statData[type.typeID]));
+  const auto secondsLoadingWithRegex = getSecondsSince(start);
+
+  std::cout << "File size:                     " << QFile(filePath).size() / (1024 * 1024)
+            << " MB with " << statFile.getMaxPoc() + 1 << " POCs\n";
+  std::cout << "Indexing POC positions:        " << secondsIndexing << " s\n";
+  std::cout << "Loading all types of one POC:  " << secondsLoading << " s\n";
+  std::cout << "Same with regular expressions: " << secondsLoadingWithRegex << " s\n";
+}
+
+} // namespace
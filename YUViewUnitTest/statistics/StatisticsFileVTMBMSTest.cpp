@@ -37,6 +37,9 @@
 #include <TemporaryFile.h>
 #include <statistics/StatisticsFileVTMBMS.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace
 {
 
@@ -217,4 +220,198 @@ TEST(StatisticsFileCSV, testCSVFileParsing)
       });
 }
 
+ByteVector toCRLFLineEndings(const ByteVector &data)
+{
+  ByteVector converted;
+  for (const auto c : data)
+  {
+    if (c == '\n')
+      converted.push_back('\r');
+    converted.push_back(c);
+  }
+  return converted;
+}
+
+void indexFile(stats::StatisticsFileVTMBMS &statFile)
+{
+  std::atomic_bool breakAtomic(false);
+  statFile.readFrameAndTypePositionsFromFile(breakAtomic);
+}
+
+void expectSameFrameTypeData(const stats::FrameTypeData &data, const stats::FrameTypeData &expected)
+{
+  ASSERT_EQ(data.valueData.size(), expected.valueData.size());
+  for (size_t i = 0; i < data.valueData.size(); i++)
+  {
+    const auto &item = data.valueData[i];
+    const auto &exp  = expected.valueData[i];
+    EXPECT_TRUE(std::equal(item.pos, item.pos + 2, exp.pos));
+    EXPECT_TRUE(std::equal(item.size, item.size + 2, exp.size));
+    EXPECT_EQ(item.value, exp.value);
+  }
+
+  ASSERT_EQ(data.vectorData.size(), expected.vectorData.size());
+  for (size_t i = 0; i < data.vectorData.size(); i++)
+  {
+    const auto &item = data.vectorData[i];
+    const auto &exp  = expected.vectorData[i];
+    EXPECT_TRUE(std::equal(item.pos, item.pos + 2, exp.pos));
+    EXPECT_TRUE(std::equal(item.size, item.size + 2, exp.size));
+    EXPECT_EQ(item.isLine, exp.isLine);
+    EXPECT_TRUE(std::equal(item.point, item.point + 2, exp.point));
+  }
+
+  ASSERT_EQ(data.affineTFData.size(), expected.affineTFData.size());
+  for (size_t i = 0; i < data.affineTFData.size(); i++)
+  {
+    const auto &item = data.affineTFData[i];
+    const auto &exp  = expected.affineTFData[i];
+    EXPECT_TRUE(std::equal(item.pos, item.pos + 2, exp.pos));
+    EXPECT_TRUE(std::equal(item.size, item.size + 2, exp.size));
+    EXPECT_TRUE(std::equal(item.point, item.point + 3, exp.point));
+  }
+
+  ASSERT_EQ(data.polygonValueData.size(), expected.polygonValueData.size());
+  for (size_t i = 0; i < data.polygonValueData.size(); i++)
+  {
+    EXPECT_EQ(data.polygonValueData[i].corners, expected.polygonValueData[i].corners);
+    EXPECT_EQ(data.polygonValueData[i].value, expected.polygonValueData[i].value);
+  }
+
+  ASSERT_EQ(data.polygonVectorData.size(), expected.polygonVectorData.size());
+  for (size_t i = 0; i < data.polygonVectorData.size(); i++)
+  {
+    EXPECT_EQ(data.polygonVectorData[i].corners, expected.polygonVectorData[i].corners);
+    EXPECT_EQ(data.polygonVectorData[i].point, expected.polygonVectorData[i].point);
+  }
+}
+
+TEST(StatisticsFileVTMBMS, CRLFLineEndingsAreParsedLikeLF)
+{
+  yuviewTest::TemporaryFile lfFile(getVTMBSTestData());
+  yuviewTest::TemporaryFile crlfFile(toCRLFLineEndings(getVTMBSTestData()));
+
+  stats::StatisticsData       lfData;
+  stats::StatisticsFileVTMBMS lfStatFile(QString::fromStdString(lfFile.getFilePathString()),
+                                         lfData);
+  stats::StatisticsData       crlfData;
+  stats::StatisticsFileVTMBMS crlfStatFile(QString::fromStdString(crlfFile.getFilePathString()),
+                                           crlfData);
+  indexFile(lfStatFile);
+  indexFile(crlfStatFile);
+
+  EXPECT_EQ(crlfData.getFrameSize(), Size(2048, 872));
+  EXPECT_EQ(crlfStatFile.getMaxPoc(), 8);
+  ASSERT_EQ(crlfData.getStatisticsTypes().size(), size_t(5));
+
+  for (const auto poc : {0, 2, 8})
+  {
+    for (const auto &type : lfData.getStatisticsTypes())
+    {
+      lfStatFile.loadStatisticData(lfData, poc, type.typeID);
+      crlfStatFile.loadStatisticData(crlfData, poc, type.typeID);
+      expectSameFrameTypeData(crlfData[type.typeID], lfData[type.typeID]);
+    }
+  }
+}
+
+TEST(StatisticsFileVTMBMS, InvalidLinesAreSkipped)
+{
+  const std::string stats_str =
+      R"(# VTMBMS Block Statistics
+# Sequence size: [256x 256]
+# Block Statistic Type: PredMode; Integer; [-4, 4]
+# Block Statistic Type: MVL0; Vector; Scale: 4
+# Block Statistic Type: GeoMVL0; VectorPolygon; Scale: 4
+BlockStat: POC 0 @(   0,   0) [8x8] PredMode=1
+BlockStat: POC 0 @(   8,   0) [8x8] PredMode=
+BlockStat: POC 0 @(  16,   0) PredMode=1
+BlockStat: POC 0 @(  24,   0) [8x] PredMode=1
+BlockStat: POC 0 @(  32,   0) [-8x8] PredMode=1
+BlockStat: POC 0 @(  40,   0) [8x8] =1
+BlockStat: POC 0 @(  48,   0 [8x8] PredMode=1
+BlockStat: POC 0 @(  56,   0) [8x8] PredMode=2147483648
+BlockStat: POC 0 @(  64,   0) [8x8] PredMode=-3
+BlockStat: POC 0 @(  72,   0) [8x8] PredMode=2147483647
+BlockStat: POC 0 @(  80,   0) [8x8] PredMode=-2147483648
+BlockStat: POC 0 @(   0,   8) [8x8] MVL0={ -5, 7}
+BlockStat: POC 0 @(   8,   8) [8x8] MVL0={ 1, 2
+BlockStat: POC 0 @(  16,   8) [8x8] MVL0={ 1, }
+BlockStat: POC 0 @(  24,   8) [8x8] MVL0={}
+BlockStat: POC 0 @(  32,   8) [8x8] MVL0={ -2147483648, -1}
+BlockStat: POC 0 @[(0, 16)--(8, 16)--(8, 24)--] GeoMVL0={ -1, -2}
+BlockStat: POC 0 @[(0, 16)--(8, 16)--(8, 24)] GeoMVL0={ 1, 2}
+BlockStat: POC 0 @[(0, 16)--(8, 16)--(8, 24)--(0, 24)--(0, 20)--(0, 18)--] GeoMVL0={ 1, 2}
+BlockStat: POC 0 @[(0, 16)--(8, 16)--] GeoMVL0={ 1, 2}
+BlockStat: POC
+BlockStat: POC 1 @(   0,   0) [8x8] PredMode=4
+)";
+
+  yuviewTest::TemporaryFile vtmbmsFile(ByteVector(stats_str.begin(), stats_str.end()));
+
+  stats::StatisticsData       statData;
+  stats::StatisticsFileVTMBMS statFile(QString::fromStdString(vtmbmsFile.getFilePathString()),
+                                       statData);
+  indexFile(statFile);
+  EXPECT_EQ(statFile.getMaxPoc(), 1);
+
+  constexpr auto intMin = std::numeric_limits<int>::min();
+  constexpr auto intMax = std::numeric_limits<int>::max();
+
+  statFile.loadStatisticData(statData, 0, 1);
+  yuviewTest::statistics::checkValueList(statData[1].valueData,
+                                         {{0, 0, 8, 8, 1},
+                                          {64, 0, 8, 8, -3},
+                                          {72, 0, 8, 8, intMax},
+                                          {80, 0, 8, 8, intMin}});
+
+  statFile.loadStatisticData(statData, 0, 2);
+  yuviewTest::statistics::checkVectorList(statData[2].vectorData,
+                                          {{0, 8, 8, 8, -5, 7}, {32, 8, 8, 8, intMin, -1}});
+
+  statFile.loadStatisticData(statData, 0, 3);
+  ASSERT_EQ(statData[3].polygonVectorData.size(), size_t(1));
+  EXPECT_EQ(statData[3].polygonVectorData[0].corners,
+            stats::Polygon({{0, 16}, {8, 16}, {8, 24}}));
+  EXPECT_EQ(statData[3].polygonVectorData[0].point, stats::Point(-1, -2));
+
+  statFile.loadStatisticData(statData, 1, 1);
+  yuviewTest::statistics::checkValueList(statData[1].valueData, {{0, 0, 8, 8, 4}});
+}
+
+TEST(StatisticsFileVTMBMS, LoadingAllTypesInOnePassMatchesLoadingOneType)
+{
+  yuviewTest::TemporaryFile vtmbmsFile(getVTMBSTestData());
+  const auto filePath = QString::fromStdString(vtmbmsFile.getFilePathString());
+
+  // All types are rendered, so loading one type also loads (prefetches) all others of the POC
+  stats::StatisticsData       allTypesData;
+  stats::StatisticsFileVTMBMS allTypesFile(filePath, allTypesData);
+  indexFile(allTypesFile);
+  for (auto &type : allTypesData.getStatisticsTypes())
+    type.render = true;
+
+  // Nothing is rendered, so every call only loads the requested type
+  stats::StatisticsData       singleTypeData;
+  stats::StatisticsFileVTMBMS singleTypeFile(filePath, singleTypeData);
+  indexFile(singleTypeFile);
+
+  // Request the types of POC 8 in reverse order and go back to it after other POCs were loaded
+  for (const auto poc : {8, 2, 0, 8})
+  {
+    std::vector<int> typeIDs;
+    for (const auto &type : allTypesData.getStatisticsTypes())
+      typeIDs.push_back(type.typeID);
+    if (poc == 8)
+      std::reverse(typeIDs.begin(), typeIDs.end());
+
+    for (const auto typeID : typeIDs)
+    {
+      allTypesFile.loadStatisticData(allTypesData, poc, typeID);
+      singleTypeFile.loadStatisticData(singleTypeData, poc, typeID);
+      expectSameFrameTypeData(allTypesData[typeID], singleTypeData[typeID]);
+    }
+  }
+}
+
 } // namespace
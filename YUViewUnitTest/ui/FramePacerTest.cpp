@@ -0,0 +1,143 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <ui/FramePacer.h>
+
+namespace
+{
+
+using namespace std::chrono_literals;
+
+constexpr auto FRAME_INTERVAL = FramePacer::Clock::duration(40ms);
+
+FramePacer createStartedPacer(FramePacer::Clock::time_point start, bool dropFrames)
+{
+  FramePacer pacer;
+  pacer.setDropFrames(dropFrames);
+  pacer.start(start, FRAME_INTERVAL);
+  return pacer;
+}
+
+TEST(FramePacerTest, DueTimesDoNotDriftWithTimerJitter)
+{
+  const FramePacer::Clock::time_point start{};
+  auto                                pacer = createStartedPacer(start, false);
+
+  for (int frame = 1; frame <= 100; frame++)
+  {
+    const auto due = pacer.getNextDueTime(start);
+    EXPECT_EQ(due, start + frame * FRAME_INTERVAL);
+
+    // The timer fires a bit late every time
+    EXPECT_EQ(pacer.presentFrame(due + 5ms, 10), 0u);
+  }
+
+  EXPECT_EQ(pacer.getCounters().presentedFrames, 100u);
+  EXPECT_EQ(pacer.getCounters().lateFrames, 0u);
+  EXPECT_EQ(pacer.getCounters().droppedFrames, 0u);
+}
+
+TEST(FramePacerTest, LateFrameContinuesFromNowWithoutDropping)
+{
+  const FramePacer::Clock::time_point start{};
+  auto                                pacer = createStartedPacer(start, false);
+
+  const auto presentTime = start + 3 * FRAME_INTERVAL + 10ms;
+  EXPECT_EQ(pacer.presentFrame(presentTime, 10), 0u);
+  EXPECT_EQ(pacer.getNextDueTime(presentTime), presentTime + FRAME_INTERVAL);
+  EXPECT_EQ(pacer.getCounters().lateFrames, 1u);
+  EXPECT_EQ(pacer.getCounters().droppedFrames, 0u);
+}
+
+TEST(FramePacerTest, LateFrameDropsMissedFrames)
+{
+  const FramePacer::Clock::time_point start{};
+  auto                                pacer = createStartedPacer(start, true);
+
+  // The first frame was due after 40ms. The frames due at 80ms and 120ms were missed.
+  const auto presentTime = start + 3 * FRAME_INTERVAL + 10ms;
+  EXPECT_EQ(pacer.presentFrame(presentTime, 10), 2u);
+  EXPECT_EQ(pacer.getNextDueTime(presentTime), start + 4 * FRAME_INTERVAL);
+  EXPECT_EQ(pacer.getCounters().lateFrames, 1u);
+  EXPECT_EQ(pacer.getCounters().droppedFrames, 2u);
+}
+
+TEST(FramePacerTest, FramesToDropAreKnownBeforePresenting)
+{
+  const FramePacer::Clock::time_point start{};
+  auto                                pacer = createStartedPacer(start, true);
+
+  const auto presentTime = start + 3 * FRAME_INTERVAL + 10ms;
+  EXPECT_EQ(pacer.getFramesToDrop(presentTime, 10), 2u);
+  EXPECT_EQ(pacer.getFramesToDrop(presentTime, 1), 1u);
+  EXPECT_EQ(pacer.getNextDueTime(presentTime), start + FRAME_INTERVAL);
+  EXPECT_EQ(pacer.getCounters().droppedFrames, 0u);
+
+  EXPECT_EQ(pacer.presentFrame(presentTime, 10), 2u);
+  EXPECT_EQ(pacer.getFramesToDrop(presentTime, 10), 0u);
+
+  auto pacerWithoutDropping = createStartedPacer(start, false);
+  EXPECT_EQ(pacerWithoutDropping.getFramesToDrop(presentTime, 10), 0u);
+}
+
+TEST(FramePacerTest, DroppedFramesAreLimited)
+{
+  const FramePacer::Clock::time_point start{};
+  auto                                pacer = createStartedPacer(start, true);
+
+  const auto presentTime = start + 6 * FRAME_INTERVAL;
+  EXPECT_EQ(pacer.presentFrame(presentTime, 1), 1u);
+  EXPECT_EQ(pacer.getNextDueTime(presentTime), start + 7 * FRAME_INTERVAL);
+  EXPECT_EQ(pacer.getCounters().droppedFrames, 1u);
+}
+
+TEST(FramePacerTest, WaitingForFrameChecksAgainAtNextDueTime)
+{
+  const FramePacer::Clock::time_point start{};
+  auto                                pacer = createStartedPacer(start, true);
+
+  EXPECT_FALSE(pacer.isWaitingForFrame());
+  pacer.frameNotReady();
+  EXPECT_TRUE(pacer.isWaitingForFrame());
+  const auto now = start + FRAME_INTERVAL + 50ms;
+  EXPECT_EQ(pacer.getNextDueTime(now), start + 3 * FRAME_INTERVAL);
+
+  pacer.resume(now);
+  EXPECT_FALSE(pacer.isWaitingForFrame());
+  EXPECT_EQ(pacer.getNextDueTime(now), now);
+  EXPECT_EQ(pacer.presentFrame(now, 10), 0u);
+  EXPECT_EQ(pacer.getNextDueTime(now), now + FRAME_INTERVAL);
+}
+
+} // namespace
@@ -0,0 +1,116 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <ui/views/PlotPointPyramid.h>
+
+namespace
+{
+
+PlotPointSummary getTestPoint(size_t pointIndex)
+{
+  const auto y = double((pointIndex * 7919) % 1000);
+  return PlotPointSummary::fromPoint(double(pointIndex), y, 1.0, pointIndex % 50 == 0);
+}
+
+PlotPointSummary summarizeAllPoints(size_t nrPoints)
+{
+  auto summary = getTestPoint(0);
+  for (size_t i = 1; i < nrPoints; i++)
+    summary.merge(getTestPoint(i));
+  return summary;
+}
+
+TEST(PlotPointPyramidTest, SummariesCoverAllPointsInRange)
+{
+  PlotPointPyramid pyramid;
+  pyramid.update(1000, getTestPoint);
+
+  const auto summaries = pyramid.getSummaries({0, 999}, 10.0);
+  EXPECT_LE(summaries.size(), 102u);
+
+  auto merged = summaries.front();
+  for (size_t i = 1; i < summaries.size(); i++)
+  {
+    EXPECT_LE(summaries[i - 1].x.max, summaries[i].x.min);
+    merged.merge(summaries[i]);
+  }
+
+  const auto expected = summarizeAllPoints(1000);
+  EXPECT_EQ(merged.nrPoints, 1000u);
+  EXPECT_EQ(merged.y.min, expected.y.min);
+  EXPECT_EQ(merged.y.max, expected.y.max);
+  EXPECT_EQ(merged.x.min, expected.x.min);
+  EXPECT_EQ(merged.x.max, expected.x.max);
+  EXPECT_EQ(merged.lastY, expected.lastY);
+  EXPECT_TRUE(merged.intra);
+}
+
+TEST(PlotPointPyramidTest, OneSummaryPerPointWhenZoomedIn)
+{
+  PlotPointPyramid pyramid;
+  pyramid.update(1000, getTestPoint);
+
+  const auto summaries = pyramid.getSummaries({100, 109}, 0.1);
+  ASSERT_EQ(summaries.size(), 12u);
+  for (size_t i = 0; i < summaries.size(); i++)
+  {
+    EXPECT_EQ(summaries[i].nrPoints, 1u);
+    EXPECT_EQ(summaries[i].firstY, getTestPoint(99 + i).firstY);
+  }
+}
+
+TEST(PlotPointPyramidTest, UpdateAfterAppendingAndChangingPoints)
+{
+  size_t changedPoint{};
+  auto   getPoint = [&changedPoint](size_t pointIndex) {
+    if (changedPoint > 0 && pointIndex == changedPoint)
+      return PlotPointSummary::fromPoint(double(pointIndex), 5000.0, 1.0, false);
+    return getTestPoint(pointIndex);
+  };
+
+  PlotPointPyramid pyramid;
+  pyramid.update(333, getPoint);
+  pyramid.update(777, getPoint);
+
+  changedPoint = 500;
+  pyramid.invalidateFrom(changedPoint);
+  pyramid.update(777, getPoint);
+
+  const auto summaries = pyramid.getSummaries({-0.5, 776.5}, 1000.0);
+  ASSERT_EQ(summaries.size(), 1u);
+  EXPECT_EQ(summaries[0].nrPoints, 777u);
+  EXPECT_EQ(summaries[0].y.max, 5000.0);
+}
+
+} // namespace
@@ -0,0 +1,186 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/ImagePyramid.h>
+
+namespace video::test
+{
+
+namespace
+{
+
+QImage createImage(const int width, const int height, std::function<QRgb(int, int)> getPixel)
+{
+  QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+  for (int y = 0; y < height; y++)
+    for (int x = 0; x < width; x++)
+      image.setPixel(x, y, getPixel(x, y));
+  return image;
+}
+
+QRgb getAverage(const QRgb a, const QRgb b, const QRgb c, const QRgb d)
+{
+  auto average = [&](std::function<int(QRgb)> getChannel) {
+    return (getChannel(a) + getChannel(b) + getChannel(c) + getChannel(d) + 2) / 4;
+  };
+  return qRgba(average(qRed), average(qGreen), average(qBlue), average(qAlpha));
+}
+
+} // namespace
+
+TEST(ImagePyramidTest, DownscaleEvenSize)
+{
+  const auto image =
+      createImage(6, 4, [](int x, int y) { return qRgba(x * 40, y * 60, x * y * 10, 255); });
+
+  const auto scaled = downscaleImageByTwo(image);
+  ASSERT_EQ(scaled.size(), QSize(3, 2));
+  EXPECT_EQ(scaled.format(), image.format());
+  for (int y = 0; y < 2; y++)
+    for (int x = 0; x < 3; x++)
+      EXPECT_EQ(scaled.pixel(x, y),
+                getAverage(image.pixel(2 * x, 2 * y),
+                           image.pixel(2 * x + 1, 2 * y),
+                           image.pixel(2 * x, 2 * y + 1),
+                           image.pixel(2 * x + 1, 2 * y + 1)))
+          << "Pixel " << x << "," << y;
+}
+
+TEST(ImagePyramidTest, DownscaleOddSizeUsesLastLineAndColumnTwice)
+{
+  const auto image =
+      createImage(5, 3, [](int x, int y) { return qRgba(x * 50, y * 100, 200 - x * 20, 255); });
+
+  const auto scaled = downscaleImageByTwo(image);
+  ASSERT_EQ(scaled.size(), QSize(3, 2));
+
+  // The last column
+  EXPECT_EQ(scaled.pixel(2, 0),
+            getAverage(image.pixel(4, 0), image.pixel(4, 0), image.pixel(4, 1), image.pixel(4, 1)));
+  // The last line
+  EXPECT_EQ(scaled.pixel(1, 1),
+            getAverage(image.pixel(2, 2), image.pixel(3, 2), image.pixel(2, 2), image.pixel(3, 2)));
+  // The last column in the last line
+  EXPECT_EQ(scaled.pixel(2, 1), image.pixel(4, 2));
+
+  const auto singlePixel =
+      downscaleImageByTwo(createImage(1, 1, [](int, int) { return QRgb(0xff102030); }));
+  ASSERT_EQ(singlePixel.size(), QSize(1, 1));
+  EXPECT_EQ(singlePixel.pixel(0, 0), 0xff102030u);
+}
+
+TEST(ImagePyramidTest, AverageIsRoundedPerChannel)
+{
+  // The four pixels of each output pixel are given per channel. The sum of the channels in the
+  // low bits of one channel must not carry over into the next channel.
+  struct TestCase
+  {
+    std::array<int, 4> values;
+    int                expected;
+  };
+  for (const auto &testCase : {TestCase({{0, 0, 0, 1}, 0}),
+                               TestCase({{0, 0, 1, 1}, 1}),
+                               TestCase({{0, 1, 1, 1}, 1}),
+                               TestCase({{1, 2, 2, 2}, 2}),
+                               TestCase({{0, 0, 1, 2}, 1}),
+                               TestCase({{254, 255, 255, 255}, 255}),
+                               TestCase({{255, 255, 255, 255}, 255})})
+  {
+    const auto &values = testCase.values;
+    const auto  image  = createImage(2, 2, [&values](int x, int y) {
+      const auto value = values[y * 2 + x];
+      return qRgba(value, value, value, 255);
+    });
+
+    const auto scaled   = downscaleImageByTwo(image);
+    const auto expected = testCase.expected;
+    ASSERT_EQ(scaled.size(), QSize(1, 1));
+    EXPECT_EQ(scaled.pixel(0, 0), qRgba(expected, expected, expected, 255))
+        << "Values " << values[0] << "," << values[1] << "," << values[2] << "," << values[3];
+  }
+}
+
+TEST(ImagePyramidTest, UnsupportedFormatIsNotDownscaled)
+{
+  const QImage image(4, 4, QImage::Format_RGB888);
+  EXPECT_TRUE(downscaleImageByTwo(image).isNull());
+}
+
+TEST(ImagePyramidTest, LevelForScale)
+{
+  const auto imageSize = QSize(1000, 800);
+  EXPECT_EQ(getPyramidLevel(4.0, imageSize), 0u);
+  EXPECT_EQ(getPyramidLevel(1.0, imageSize), 0u);
+  EXPECT_EQ(getPyramidLevel(0.6, imageSize), 0u);
+  EXPECT_EQ(getPyramidLevel(0.5, imageSize), 1u);
+  EXPECT_EQ(getPyramidLevel(0.3, imageSize), 1u);
+  EXPECT_EQ(getPyramidLevel(0.25, imageSize), 2u);
+  EXPECT_EQ(getPyramidLevel(0.1, imageSize), 3u);
+
+  // The smallest level is at least one pixel high
+  EXPECT_EQ(getPyramidLevel(0.001, QSize(1000, 4)), 2u);
+  EXPECT_EQ(getPyramidLevel(0.001, QSize(1, 1)), 0u);
+}
+
+TEST(ImagePyramidTest, VisiblePartIsAlignedToWholePixels)
+{
+  const auto targetRect = QRectF(100, 50, 200, 100);
+  const auto imageSize  = QSize(20, 10);
+
+  const auto part = getVisibleImagePart(targetRect, imageSize, QRectF(125, 72, 41, 50));
+  ASSERT_TRUE(part);
+  EXPECT_EQ(part->sourceRect, QRect(2, 2, 5, 6));
+  EXPECT_EQ(part->targetRect, QRectF(120, 70, 50, 60));
+}
+
+TEST(ImagePyramidTest, VisiblePartIsClippedToTheImage)
+{
+  const auto targetRect = QRectF(100, 50, 200, 100);
+  const auto imageSize  = QSize(20, 10);
+
+  const auto fullyVisible = getVisibleImagePart(targetRect, imageSize, QRectF(0, 0, 1000, 1000));
+  ASSERT_TRUE(fullyVisible);
+  EXPECT_EQ(fullyVisible->sourceRect, QRect(0, 0, 20, 10));
+  EXPECT_EQ(fullyVisible->targetRect, targetRect);
+
+  const auto bottomRight = getVisibleImagePart(targetRect, imageSize, QRectF(285, 145, 100, 100));
+  ASSERT_TRUE(bottomRight);
+  EXPECT_EQ(bottomRight->sourceRect, QRect(18, 9, 2, 1));
+  EXPECT_EQ(bottomRight->targetRect, QRectF(280, 140, 20, 10));
+
+  EXPECT_FALSE(getVisibleImagePart(targetRect, imageSize, QRectF(0, 0, 50, 50)));
+  EXPECT_FALSE(getVisibleImagePart(targetRect, imageSize, QRectF(300, 50, 10, 10)));
+}
+
+} // namespace video::test
@@ -0,0 +1,166 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <YUVTestData.h>
+#include <common/SIMD.h>
+#include <video/yuv/ConversionYUV.h>
+
+namespace video::yuv::test
+{
+
+namespace
+{
+
+using UChaVector = std::vector<unsigned char>;
+
+using yuviewTest::createRandomFrameData;
+using yuviewTest::InstructionSetsToTest;
+using yuviewTest::isSupportedByCPU;
+using yuviewTest::TEST_FRAME_SIZE;
+
+constexpr auto SubsamplingsToTest = {Subsampling::YUV_444,
+                                     Subsampling::YUV_422,
+                                     Subsampling::YUV_420,
+                                     Subsampling::YUV_440,
+                                     Subsampling::YUV_410,
+                                     Subsampling::YUV_411};
+
+constexpr auto BitDepthsToTest = {8u, 9u, 10u, 12u, 14u, 16u};
+
+UChaVector convert(const QByteArray           &data,
+                   const PixelFormatYUV       &pixelFormat,
+                   const ConversionSettings   &conversionSettings,
+                   const simd::InstructionSet instructionSet)
+{
+  UChaVector output(TEST_FRAME_SIZE.width * TEST_FRAME_SIZE.height * 4);
+  if (!convertYUVPlanarToARGB(
+          data, output.data(), TEST_FRAME_SIZE, pixelFormat, conversionSettings, instructionSet))
+    throw std::runtime_error("Conversion failed");
+  return output;
+}
+
+std::string getFirstDifference(const UChaVector &expected, const UChaVector &actual)
+{
+  for (size_t i = 0; i < expected.size(); i++)
+    if (expected[i] != actual[i])
+    {
+      const auto pixel = i / 4;
+      return "Pixel (" + std::to_string(pixel % TEST_FRAME_SIZE.width) + "," +
+             std::to_string(pixel / TEST_FRAME_SIZE.width) + ") component " +
+             std::to_string(i % 4) + " expected " + std::to_string(expected[i]) + " got " +
+             std::to_string(actual[i]);
+    }
+  return {};
+}
+
+} // namespace
+
+class ConversionYUVSIMDTest
+    : public TestWithParam<std::tuple<simd::InstructionSet, Subsampling, unsigned>>
+{
+};
+
+std::string getTestName(const testing::TestParamInfo<ConversionYUVSIMDTest::ParamType> &info)
+{
+  const auto [instructionSet, subsampling, bitDepth] = info.param;
+  return yuviewTest::formatTestName("InstructionSet",
+                                    std::string(simd::InstructionSetMapper.getName(instructionSet)),
+                                    "Subsampling",
+                                    SubsamplingMapper.getName(subsampling),
+                                    "BitDepth",
+                                    bitDepth);
+}
+
+TEST_P(ConversionYUVSIMDTest, TestConversionIsIdenticalToScalarConversion)
+{
+  const auto [instructionSet, subsampling, bitDepth] = GetParam();
+
+  if (!isSupportedByCPU(instructionSet))
+    GTEST_SKIP() << "Instruction set not supported by this CPU";
+
+  const auto mathParametersToTest = {std::make_pair(MathParameters(), MathParameters()),
+                                     std::make_pair(MathParameters(2, 100, false),
+                                                    MathParameters(1, 128, true)),
+                                     std::make_pair(MathParameters(1, 125, true),
+                                                    MathParameters(8, 128, false))};
+
+  for (const auto bigEndian : {false, true})
+  {
+    if (bigEndian && bitDepth == 8)
+      continue;
+    for (const auto planeOrder : {PlaneOrder::YUV, PlaneOrder::YVU})
+      for (const auto uvInterleaved : {false, true})
+        for (const auto chromaOffset : {Offset(0, 0), Offset(0, 1), Offset(1, 1)})
+        {
+          const PixelFormatYUV pixelFormat(
+              subsampling, bitDepth, planeOrder, bigEndian, chromaOffset, uvInterleaved);
+          const auto data = createRandomFrameData(pixelFormat, TEST_FRAME_SIZE);
+
+          for (const auto interpolation : ChromaInterpolationMapper.getValues())
+            for (const auto colorConversion : {ColorConversion::BT709_LimitedRange,
+                                               ColorConversion::BT2020_FullRange})
+              for (const auto &[mathLuma, mathChroma] : mathParametersToTest)
+                for (const auto displayMode : ComponentDisplayModeMapper.getValues())
+                {
+                  ConversionSettings conversionSettings;
+                  conversionSettings.chromaInterpolation               = interpolation;
+                  conversionSettings.componentDisplayMode              = displayMode;
+                  conversionSettings.colorConversion                   = colorConversion;
+                  conversionSettings.mathParameters[Component::Luma]   = mathLuma;
+                  conversionSettings.mathParameters[Component::Chroma] = mathChroma;
+
+                  const auto expected = convert(
+                      data, pixelFormat, conversionSettings, simd::InstructionSet::None);
+                  const auto actual =
+                      convert(data, pixelFormat, conversionSettings, instructionSet);
+
+                  EXPECT_TRUE(expected == actual)
+                      << "Format " << pixelFormat.getName() << " interpolation "
+                      << ChromaInterpolationMapper.getName(interpolation) << " display mode "
+                      << ComponentDisplayModeMapper.getName(displayMode) << " color conversion "
+                      << ColorConversionMapper.getName(colorConversion) << ": "
+                      << getFirstDifference(expected, actual);
+                }
+        }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(VideoYUVTest,
+                         ConversionYUVSIMDTest,
+                         Combine(ValuesIn(InstructionSetsToTest),
+                                 ValuesIn(SubsamplingsToTest),
+                                 ValuesIn(BitDepthsToTest)),
+                         getTestName);
+
+} // namespace video::yuv::test
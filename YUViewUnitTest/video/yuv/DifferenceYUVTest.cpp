@@ -0,0 +1,252 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <YUVTestData.h>
+#include <common/SIMD.h>
+#include <video/yuv/ConversionYUV.h>
+#include <video/yuv/DifferenceYUV.h>
+
+#include <random>
+
+namespace video::yuv::test
+{
+
+namespace
+{
+
+using yuviewTest::createFrameData;
+using yuviewTest::createRandomFrameData;
+using yuviewTest::InstructionSetsToTest;
+using yuviewTest::isSupportedByCPU;
+using yuviewTest::TEST_FRAME_SIZE;
+
+constexpr auto BitDepthsToTest = {8u, 10u, 12u, 15u, 16u};
+
+// Create two random frames where most of the samples are identical
+std::pair<QByteArray, QByteArray> createRandomFramePair(const PixelFormatYUV &pixelFormat)
+{
+  const auto frame1         = createRandomFrameData(pixelFormat, TEST_FRAME_SIZE, 1234);
+  const auto otherFrame     = createRandomFrameData(pixelFormat, TEST_FRAME_SIZE, 5678);
+  auto       frame2         = frame1;
+  const auto bytesPerSample = (pixelFormat.getBitsPerSample() > 8) ? 2 : 1;
+
+  std::mt19937                       randomGenerator(1234);
+  std::uniform_int_distribution<int> changeDistribution(0, 9);
+  for (int i = 0; i < frame2.size(); i += bytesPerSample)
+    if (changeDistribution(randomGenerator) == 0)
+      for (int byte = i; byte < i + bytesPerSample; byte++)
+        frame2[byte] = otherFrame.at(byte);
+  return {frame1, frame2};
+}
+
+void setSample(QByteArray &data, const int index, const int value, const PixelFormatYUV &format)
+{
+  setValueInBuffer(reinterpret_cast<unsigned char *>(data.data()),
+                   value,
+                   index,
+                   format.getBitsPerSample(),
+                   format.isBigEndian());
+}
+
+} // namespace
+
+class DifferenceYUVSIMDTest
+    : public TestWithParam<std::tuple<simd::InstructionSet, unsigned, int>>
+{
+};
+
+std::string getTestName(const testing::TestParamInfo<DifferenceYUVSIMDTest::ParamType> &info)
+{
+  const auto [instructionSet, bitDepth, amplificationFactor] = info.param;
+  return yuviewTest::formatTestName("InstructionSet",
+                                    std::string(simd::InstructionSetMapper.getName(instructionSet)),
+                                    "BitDepth",
+                                    bitDepth,
+                                    "Amplification",
+                                    amplificationFactor);
+}
+
+TEST_P(DifferenceYUVSIMDTest, TestDifferenceIsIdenticalToScalarDifference)
+{
+  const auto [instructionSet, bitDepth, amplificationFactor] = GetParam();
+
+  if (!isSupportedByCPU(instructionSet))
+    GTEST_SKIP() << "Instruction set not supported by this CPU";
+
+  for (const auto subsampling : {Subsampling::YUV_420, Subsampling::YUV_444, Subsampling::YUV_410})
+  {
+    const PixelFormatYUV pixelFormat(subsampling, bitDepth);
+    const auto [frame1, frame2] = createRandomFramePair(pixelFormat);
+
+    const auto expected = calculateDifferenceYUV(frame1,
+                                                 pixelFormat,
+                                                 TEST_FRAME_SIZE,
+                                                 frame2,
+                                                 pixelFormat,
+                                                 TEST_FRAME_SIZE,
+                                                 amplificationFactor,
+                                                 simd::InstructionSet::None);
+    const auto actual   = calculateDifferenceYUV(frame1,
+                                               pixelFormat,
+                                               TEST_FRAME_SIZE,
+                                               frame2,
+                                               pixelFormat,
+                                               TEST_FRAME_SIZE,
+                                               amplificationFactor,
+                                               instructionSet);
+    ASSERT_TRUE(expected);
+    ASSERT_TRUE(actual);
+
+    EXPECT_TRUE(expected->data == actual->data) << "Format " << pixelFormat.getName();
+    EXPECT_EQ(expected->sumSquaredDifferences, actual->sumSquaredDifferences);
+    ASSERT_TRUE(expected->firstDifference);
+    ASSERT_TRUE(actual->firstDifference);
+    EXPECT_EQ(expected->firstDifference->ctuIndex, actual->firstDifference->ctuIndex);
+    EXPECT_EQ(expected->firstDifference->x, actual->firstDifference->x);
+    EXPECT_EQ(expected->firstDifference->y, actual->firstDifference->y);
+    EXPECT_EQ(expected->firstDifference->partIndex, actual->firstDifference->partIndex);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(VideoYUVTest,
+                         DifferenceYUVSIMDTest,
+                         Combine(ValuesIn(InstructionSetsToTest),
+                                 ValuesIn(BitDepthsToTest),
+                                 Values(1, 7, 1000)),
+                         getTestName);
+
+TEST(DifferenceYUVTest, IdenticalFramesHaveNoDifference)
+{
+  const PixelFormatYUV format(Subsampling::YUV_420, 10);
+  const auto           frame = createFrameData(format, TEST_FRAME_SIZE, 300);
+
+  const auto difference =
+      calculateDifferenceYUV(frame, format, TEST_FRAME_SIZE, frame, format, TEST_FRAME_SIZE, 1);
+  ASSERT_TRUE(difference);
+  EXPECT_FALSE(difference->firstDifference);
+  EXPECT_EQ(difference->sumSquaredDifferences, (std::array<int64_t, 3>({0, 0, 0})));
+  EXPECT_TRUE(difference->data ==
+              createFrameData(difference->format, TEST_FRAME_SIZE, 512));
+}
+
+TEST(DifferenceYUVTest, FirstDifferenceIsFoundInCodingOrder)
+{
+  // 3x2 CTUs. The difference in the second CTU comes first in coding order.
+  const auto           frameSize = Size(160, 80);
+  const PixelFormatYUV format(Subsampling::YUV_420, 8);
+  const auto           frame1 = createFrameData(format, frameSize, 100);
+  auto                 frame2 = frame1;
+  setSample(frame2, 10 * 160 + 70, 90, format);
+  setSample(frame2, 70 * 160 + 5, 90, format);
+
+  const auto difference =
+      calculateDifferenceYUV(frame1, format, frameSize, frame2, format, frameSize, 1);
+  ASSERT_TRUE(difference);
+  ASSERT_TRUE(difference->firstDifference);
+  EXPECT_EQ(difference->firstDifference->ctuIndex, 1u);
+  EXPECT_EQ(difference->firstDifference->x, 68u);
+  EXPECT_EQ(difference->firstDifference->y, 8u);
+  // The block (1,2) in the CTU is the 10th block in z-order
+  EXPECT_EQ(difference->firstDifference->partIndex, 9u);
+  EXPECT_EQ(difference->sumSquaredDifferences, (std::array<int64_t, 3>({200, 0, 0})));
+}
+
+TEST(DifferenceYUVTest, ChromaDifferenceIsMappedToLumaBlock)
+{
+  const auto           frameSize = Size(64, 64);
+  const PixelFormatYUV format(Subsampling::YUV_420, 8);
+  const auto           frame1 = createFrameData(format, frameSize, 100);
+  auto                 frame2 = frame1;
+  // The chroma sample (10,3) of the U plane covers the luma samples (20,6) to (21,7)
+  setSample(frame2, 64 * 64 + 3 * 32 + 10, 103, format);
+
+  const auto difference =
+      calculateDifferenceYUV(frame1, format, frameSize, frame2, format, frameSize, 1);
+  ASSERT_TRUE(difference);
+  ASSERT_TRUE(difference->firstDifference);
+  EXPECT_EQ(difference->firstDifference->ctuIndex, 0u);
+  EXPECT_EQ(difference->firstDifference->x, 20u);
+  EXPECT_EQ(difference->firstDifference->y, 4u);
+  EXPECT_EQ(difference->firstDifference->partIndex, 19u);
+  EXPECT_EQ(difference->sumSquaredDifferences, (std::array<int64_t, 3>({0, 9, 0})));
+}
+
+TEST(DifferenceYUVTest, DifferentBitDepthsAndSizes)
+{
+  const PixelFormatYUV format8Bit(Subsampling::YUV_444, 8);
+  const PixelFormatYUV format10Bit(Subsampling::YUV_444, 10, PlaneOrder::YUV, true);
+  const auto           frame1 = createFrameData(format8Bit, Size(16, 8), 100);
+  const auto           frame2 = createFrameData(format10Bit, Size(20, 12), 401);
+
+  const auto difference =
+      calculateDifferenceYUV(frame1, format8Bit, Size(16, 8), frame2, format10Bit, Size(20, 12), 1);
+  ASSERT_TRUE(difference);
+  EXPECT_EQ(difference->frameSize, Size(16, 8));
+  EXPECT_EQ(difference->format.getBitsPerSample(), 10u);
+  EXPECT_EQ(difference->sumSquaredDifferences, (std::array<int64_t, 3>({128, 128, 128})));
+  EXPECT_TRUE(difference->data == createFrameData(difference->format, Size(16, 8), 511));
+}
+
+TEST(DifferenceYUVTest, AmplifiedDifferenceIsClipped)
+{
+  const auto           frameSize = Size(8, 8);
+  const PixelFormatYUV format(Subsampling::YUV_400, 8);
+  const auto           frame1 = createFrameData(format, frameSize, 100);
+  auto                 frame2 = frame1;
+  setSample(frame2, 0, 90, format);
+  setSample(frame2, 1, 110, format);
+  setSample(frame2, 2, 99, format);
+
+  const auto difference =
+      calculateDifferenceYUV(frame1, format, frameSize, frame2, format, frameSize, 100);
+  ASSERT_TRUE(difference);
+  const auto data = reinterpret_cast<const unsigned char *>(difference->data.constData());
+  EXPECT_EQ(data[0], 255);
+  EXPECT_EQ(data[1], 0);
+  EXPECT_EQ(data[2], 228);
+  EXPECT_EQ(data[3], 128);
+  EXPECT_EQ(difference->sumSquaredDifferences, (std::array<int64_t, 3>({201, 0, 0})));
+}
+
+TEST(DifferenceYUVTest, PackedFormatsAreNotSupported)
+{
+  const PixelFormatYUV planar(Subsampling::YUV_422, 8);
+  const PixelFormatYUV packed(Subsampling::YUV_422, 8, PackingOrder::YUYV, false, false);
+  EXPECT_TRUE(canCalculateDifferenceYUV(planar, planar));
+  EXPECT_FALSE(canCalculateDifferenceYUV(planar, packed));
+  EXPECT_FALSE(
+      canCalculateDifferenceYUV(planar, PixelFormatYUV(Subsampling::YUV_420, 8)));
+}
+
+} // namespace video::yuv::test
@@ -0,0 +1,183 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/yuv/FrameMetricsYUV.h>
+
+namespace video::yuv::test
+{
+
+namespace
+{
+
+constexpr auto TEST_FRAME_SIZE = Size(16, 8);
+
+QByteArray createFrame(const PixelFormatYUV &format, std::function<int(int)> getValue)
+{
+  QByteArray frame(int(format.bytesPerFrame(TEST_FRAME_SIZE)), 0);
+  const auto bytesPerSample = (format.getBitsPerSample() > 8) ? 2 : 1;
+  for (int i = 0; i < frame.size() / bytesPerSample; i++)
+  {
+    const auto value = getValue(i);
+    if (bytesPerSample == 1)
+      frame[i] = char(value);
+    else
+    {
+      frame[2 * i]     = char(value & 0xff);
+      frame[2 * i + 1] = char(value >> 8);
+    }
+  }
+  return frame;
+}
+
+} // namespace
+
+TEST(FrameMetricsYUVTest, IdenticalFrames)
+{
+  const PixelFormatYUV format(Subsampling::YUV_420, 8);
+  const auto           frame = createFrame(format, [](int i) { return (i * 37) % 256; });
+
+  const auto metrics = calculateFrameMetrics(frame, format, frame, format, TEST_FRAME_SIZE);
+  ASSERT_TRUE(metrics);
+  ASSERT_EQ(metrics->size(), 3u);
+  for (const auto &plane : *metrics)
+  {
+    EXPECT_EQ(plane.mse, 0.0);
+    EXPECT_TRUE(std::isinf(plane.psnr));
+    EXPECT_DOUBLE_EQ(plane.ssim, 1.0);
+  }
+}
+
+TEST(FrameMetricsYUVTest, ConstantDifferencePerPlane)
+{
+  const PixelFormatYUV format(Subsampling::YUV_420, 8);
+  const auto           lumaSamples = int(TEST_FRAME_SIZE.width * TEST_FRAME_SIZE.height);
+  const auto           frame1      = createFrame(format, [](int) { return 100; });
+  const auto           frame2      = createFrame(format, [lumaSamples](int i) {
+    // Y is 2 higher and U 4 higher. V is identical.
+    if (i < lumaSamples)
+      return 102;
+    return (i < lumaSamples * 5 / 4) ? 104 : 100;
+  });
+
+  const auto metrics = calculateFrameMetrics(frame1, format, frame2, format, TEST_FRAME_SIZE);
+  ASSERT_TRUE(metrics);
+  ASSERT_EQ(metrics->size(), 3u);
+  EXPECT_DOUBLE_EQ(metrics->at(0).mse, 4.0);
+  EXPECT_NEAR(metrics->at(0).psnr, 10 * std::log10(255.0 * 255.0 / 4.0), 1e-9);
+  EXPECT_DOUBLE_EQ(metrics->at(1).mse, 16.0);
+  EXPECT_DOUBLE_EQ(metrics->at(2).mse, 0.0);
+}
+
+TEST(FrameMetricsYUVTest, LowerBitDepthIsScaledUp)
+{
+  const PixelFormatYUV format8Bit(Subsampling::YUV_400, 8);
+  const PixelFormatYUV format10Bit(Subsampling::YUV_400, 10);
+  const auto           frame8Bit  = createFrame(format8Bit, [](int i) { return i % 256; });
+  const auto           frame10Bit = createFrame(format10Bit, [](int i) { return (i % 256) << 2; });
+
+  const auto metrics =
+      calculateFrameMetrics(frame8Bit, format8Bit, frame10Bit, format10Bit, TEST_FRAME_SIZE);
+  ASSERT_TRUE(metrics);
+  ASSERT_EQ(metrics->size(), 1u);
+  EXPECT_EQ(metrics->at(0).mse, 0.0);
+}
+
+TEST(FrameMetricsYUVTest, SSIMIsTheMeanOverAllSlidingWindows)
+{
+  const PixelFormatYUV format(Subsampling::YUV_400, 8);
+  const auto           frame1 = createFrame(format, [](int i) { return (i * 37) % 256; });
+  const auto           frame2 = createFrame(format, [](int i) { return (i * 37 + i % 7) % 256; });
+
+  // The SSIM of each window calculated directly from the definition
+  const auto c1          = std::pow(0.01 * 255, 2);
+  const auto c2          = std::pow(0.03 * 255, 2);
+  const auto width       = int(TEST_FRAME_SIZE.width);
+  double     expectedSum = 0.0;
+  int        nrWindows   = 0;
+  for (int windowY = 0; windowY + 8 <= int(TEST_FRAME_SIZE.height); windowY++)
+  {
+    for (int windowX = 0; windowX + 8 <= width; windowX++)
+    {
+      auto getSample = [&](const QByteArray &frame, int x, int y) {
+        const auto index = (windowY + y) * width + windowX + x;
+        return double(static_cast<unsigned char>(frame.at(index)));
+      };
+      double mean1 = 0, mean2 = 0;
+      for (int y = 0; y < 8; y++)
+        for (int x = 0; x < 8; x++)
+        {
+          mean1 += getSample(frame1, x, y) / 64;
+          mean2 += getSample(frame2, x, y) / 64;
+        }
+      double variance1 = 0, variance2 = 0, covariance = 0;
+      for (int y = 0; y < 8; y++)
+        for (int x = 0; x < 8; x++)
+        {
+          const auto diff1 = getSample(frame1, x, y) - mean1;
+          const auto diff2 = getSample(frame2, x, y) - mean2;
+          variance1 += diff1 * diff1 / 64;
+          variance2 += diff2 * diff2 / 64;
+          covariance += diff1 * diff2 / 64;
+        }
+      expectedSum += ((2 * mean1 * mean2 + c1) * (2 * covariance + c2)) /
+                     ((mean1 * mean1 + mean2 * mean2 + c1) * (variance1 + variance2 + c2));
+      nrWindows++;
+    }
+  }
+  EXPECT_EQ(nrWindows, 9);
+
+  const auto metrics = calculateFrameMetrics(frame1, format, frame2, format, TEST_FRAME_SIZE);
+  ASSERT_TRUE(metrics);
+  ASSERT_EQ(metrics->size(), 1u);
+  EXPECT_NEAR(metrics->at(0).ssim, expectedSum / nrWindows, 1e-9);
+  EXPECT_LT(metrics->at(0).ssim, 1.0);
+}
+
+TEST(FrameMetricsYUVTest, PackedFormatsAreNotSupported)
+{
+  const PixelFormatYUV planar(Subsampling::YUV_422, 8);
+  const PixelFormatYUV packed(Subsampling::YUV_422, 8, PackingOrder::UYVY);
+  EXPECT_TRUE(canCalculateFrameMetrics(planar, planar));
+  EXPECT_FALSE(canCalculateFrameMetrics(planar, packed));
+  EXPECT_FALSE(canCalculateFrameMetrics(planar, PixelFormatYUV(Subsampling::YUV_420, 8)));
+}
+
+TEST(FrameMetricsYUVTest, InterleavedUVPlanesAreNotSupported)
+{
+  const PixelFormatYUV planar(Subsampling::YUV_420, 8);
+  const PixelFormatYUV nv12(Subsampling::YUV_420, 8, PlaneOrder::YUV, false, {}, true);
+  EXPECT_FALSE(canCalculateFrameMetrics(planar, nv12));
+}
+
+} // namespace video::yuv::test
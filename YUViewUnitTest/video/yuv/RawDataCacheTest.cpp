@@ -0,0 +1,130 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <YUVTestData.h>
+#include <video/yuv/videoHandlerYUV.h>
+
+namespace video::yuv::test
+{
+
+namespace
+{
+
+constexpr auto NR_FRAMES = 3;
+
+// Gives access to the caches and counts how often the raw data of a frame is loaded
+class TestVideoHandlerYUV : public videoHandlerYUV
+{
+public:
+  TestVideoHandlerYUV(bool cacheRawData)
+  {
+    this->cacheRawData = cacheRawData;
+    this->setPixelFormatYUV(PixelFormatYUV(Subsampling::YUV_420, 8, PlaneOrder::YUV));
+    this->setFrameSize(yuviewTest::TEST_FRAME_SIZE);
+    this->setRawDataLoader([this](int frameIndex, QByteArray &targetBuffer) {
+      this->nrFramesLoaded++;
+      targetBuffer = yuviewTest::createRandomFrameData(
+          this->srcPixelFormat, this->frameSize, unsigned(frameIndex));
+      return true;
+    });
+  }
+
+  QImage getImageFromImageCache(int frameIndex) const
+  {
+    QMutexLocker lock(&this->imageCacheAccess);
+    return this->imageCache.value(frameIndex);
+  }
+
+  int getNrFramesInRawDataCache() const
+  {
+    QMutexLocker lock(&this->imageCacheAccess);
+    return this->rawDataCache.size();
+  }
+
+  int nrFramesLoaded{};
+};
+
+TEST(RawDataCacheTest, FrameFromRawDataCacheEqualsFrameFromImageCache)
+{
+  TestVideoHandlerYUV imageCacheHandler(false);
+  TestVideoHandlerYUV rawDataCacheHandler(true);
+  ASSERT_FALSE(imageCacheHandler.isRawDataCacheActive());
+  ASSERT_TRUE(rawDataCacheHandler.isRawDataCacheActive());
+
+  for (int frameIndex = 0; frameIndex < NR_FRAMES; frameIndex++)
+  {
+    imageCacheHandler.cacheFrame(frameIndex, false);
+    rawDataCacheHandler.cacheFrame(frameIndex, false);
+  }
+
+  EXPECT_EQ(rawDataCacheHandler.getNumberCachedFrames(), NR_FRAMES);
+  EXPECT_EQ(rawDataCacheHandler.getNrFramesInRawDataCache(), NR_FRAMES);
+  EXPECT_EQ(rawDataCacheHandler.nrFramesLoaded, NR_FRAMES);
+  EXPECT_EQ(int64_t(rawDataCacheHandler.getCachingFrameSize()),
+            rawDataCacheHandler.getBytesPerFrame());
+  EXPECT_LT(rawDataCacheHandler.getCachingFrameSize(), imageCacheHandler.getCachingFrameSize());
+
+  for (int frameIndex = 0; frameIndex < NR_FRAMES; frameIndex++)
+  {
+    EXPECT_TRUE(rawDataCacheHandler.isInCache(frameIndex));
+    EXPECT_NE(rawDataCacheHandler.needsLoading(frameIndex, false),
+              ItemLoadingState::LoadingNeeded);
+
+    // The raw data is taken from the cache and converted with the current settings
+    rawDataCacheHandler.loadFrame(frameIndex);
+    EXPECT_EQ(rawDataCacheHandler.nrFramesLoaded, NR_FRAMES);
+
+    const auto expectedImage = imageCacheHandler.getImageFromImageCache(frameIndex);
+    ASSERT_FALSE(expectedImage.isNull());
+    EXPECT_EQ(rawDataCacheHandler.getCurrentFrameAsImage(), expectedImage);
+  }
+}
+
+TEST(RawDataCacheTest, RemovingFramesRemovesRawData)
+{
+  TestVideoHandlerYUV handler(true);
+  for (int frameIndex = 0; frameIndex < NR_FRAMES; frameIndex++)
+    handler.cacheFrame(frameIndex, false);
+
+  handler.removeFrameFromCache(1);
+  EXPECT_FALSE(handler.isInCache(1));
+  EXPECT_EQ(handler.getCachedFrames(), QList<int>({0, 2}));
+
+  handler.removeAllFrameFromCache();
+  EXPECT_EQ(handler.getNumberCachedFrames(), 0);
+}
+
+} // namespace
+
+} // namespace video::yuv::test
@@ -0,0 +1,200 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <YUVTestData.h>
+#include <common/SIMD.h>
+#include <video/yuv/ConversionYUV.h>
+#include <video/yuv/ResampleYUV.h>
+
+namespace video::yuv::test
+{
+
+namespace
+{
+
+using yuviewTest::createFrameData;
+using yuviewTest::createRandomFrameData;
+using yuviewTest::InstructionSetsToTest;
+using yuviewTest::isSupportedByCPU;
+using yuviewTest::TEST_FRAME_SIZE;
+
+constexpr auto BitDepthsToTest = {8u, 10u, 16u};
+
+constexpr auto FiltersToTest = {ResampleFilter::Nearest,
+                                ResampleFilter::Bilinear,
+                                ResampleFilter::Bicubic,
+                                ResampleFilter::Lanczos3};
+
+std::string getFilterName(const ResampleFilter filter)
+{
+  switch (filter)
+  {
+  case ResampleFilter::Nearest:
+    return "Nearest";
+  case ResampleFilter::Bilinear:
+    return "Bilinear";
+  case ResampleFilter::Bicubic:
+    return "Bicubic";
+  case ResampleFilter::Lanczos3:
+    return "Lanczos3";
+  }
+  return {};
+}
+
+} // namespace
+
+class ResampleYUVSIMDTest
+    : public TestWithParam<std::tuple<simd::InstructionSet, unsigned, ResampleFilter>>
+{
+};
+
+std::string getTestName(const testing::TestParamInfo<ResampleYUVSIMDTest::ParamType> &info)
+{
+  const auto [instructionSet, bitDepth, filter] = info.param;
+  return yuviewTest::formatTestName("InstructionSet",
+                                    std::string(simd::InstructionSetMapper.getName(instructionSet)),
+                                    "BitDepth",
+                                    bitDepth,
+                                    "Filter",
+                                    getFilterName(filter));
+}
+
+TEST_P(ResampleYUVSIMDTest, TestResamplingIsIdenticalToScalarResampling)
+{
+  const auto [instructionSet, bitDepth, filter] = GetParam();
+
+  if (!isSupportedByCPU(instructionSet))
+    GTEST_SKIP() << "Instruction set not supported by this CPU";
+
+  for (const auto bigEndian : {false, true})
+  {
+    const PixelFormatYUV pixelFormat(Subsampling::YUV_420, bitDepth, PlaneOrder::YUV, bigEndian);
+    const auto           frame = createRandomFrameData(pixelFormat, TEST_FRAME_SIZE);
+
+    for (const auto targetSize : {Size(200, 130), Size(38, 36), Size(52, 100)})
+    {
+      const auto expected = resampleYUV(
+          frame, pixelFormat, TEST_FRAME_SIZE, targetSize, filter, simd::InstructionSet::None);
+      const auto actual =
+          resampleYUV(frame, pixelFormat, TEST_FRAME_SIZE, targetSize, filter, instructionSet);
+      ASSERT_EQ(expected.size(), pixelFormat.bytesPerFrame(targetSize));
+      EXPECT_TRUE(expected == actual) << "Format " << pixelFormat.getName() << " target size "
+                                      << targetSize.width << "x" << targetSize.height;
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(VideoYUVTest,
+                         ResampleYUVSIMDTest,
+                         Combine(ValuesIn(InstructionSetsToTest),
+                                 ValuesIn(BitDepthsToTest),
+                                 ValuesIn(FiltersToTest)),
+                         getTestName);
+
+TEST(ResampleYUVTest, ResamplingToTheSameSizeReturnsTheInput)
+{
+  for (const auto subsampling : {Subsampling::YUV_420, Subsampling::YUV_422, Subsampling::YUV_400})
+  {
+    for (const auto filter : FiltersToTest)
+    {
+      const PixelFormatYUV pixelFormat(subsampling, 10);
+      const auto           frame = createRandomFrameData(pixelFormat, TEST_FRAME_SIZE);
+      const auto           resampled =
+          resampleYUV(frame, pixelFormat, TEST_FRAME_SIZE, TEST_FRAME_SIZE, filter);
+      EXPECT_TRUE(frame == resampled)
+          << "Format " << pixelFormat.getName() << " filter " << getFilterName(filter);
+    }
+  }
+}
+
+TEST(ResampleYUVTest, ConstantFrameStaysConstant)
+{
+  const PixelFormatYUV pixelFormat(Subsampling::YUV_444, 8, PlaneOrder::YUVA);
+  const auto           frame = createFrameData(pixelFormat, TEST_FRAME_SIZE, 117);
+
+  for (const auto filter : FiltersToTest)
+  {
+    for (const auto targetSize : {Size(300, 211), Size(17, 9)})
+    {
+      const auto resampled = resampleYUV(frame, pixelFormat, TEST_FRAME_SIZE, targetSize, filter);
+      EXPECT_TRUE(resampled == createFrameData(pixelFormat, targetSize, 117))
+          << "Filter " << getFilterName(filter);
+    }
+  }
+}
+
+TEST(ResampleYUVTest, ChromaIsResampledIndependentOfLuma)
+{
+  const PixelFormatYUV pixelFormat(Subsampling::YUV_420, 8);
+  auto                 frame = createFrameData(pixelFormat, Size(16, 16), 20);
+
+  // Set the U plane to 200. The V plane stays at 20.
+  for (int i = 16 * 16; i < 16 * 16 + 8 * 8; i++)
+    setValueInBuffer(reinterpret_cast<unsigned char *>(frame.data()), 200, i, 8, false);
+
+  const auto resampled =
+      resampleYUV(frame, pixelFormat, Size(16, 16), Size(32, 32), ResampleFilter::Bicubic);
+  ASSERT_EQ(resampled.size(), pixelFormat.bytesPerFrame(Size(32, 32)));
+
+  const auto data = reinterpret_cast<const unsigned char *>(resampled.constData());
+  for (int i = 0; i < 32 * 32; i++)
+    ASSERT_EQ(getValueFromSource(data, i, 8, false), 20);
+  for (int i = 32 * 32; i < 32 * 32 + 16 * 16; i++)
+    ASSERT_EQ(getValueFromSource(data, i, 8, false), 200);
+  for (int i = 32 * 32 + 16 * 16; i < 32 * 32 + 2 * 16 * 16; i++)
+    ASSERT_EQ(getValueFromSource(data, i, 8, false), 20);
+}
+
+TEST(ResampleYUVTest, UnsupportedFormatsAndSizesReturnNoData)
+{
+  const PixelFormatYUV packedFormat(Subsampling::YUV_422, 8, PackingOrder::UYVY);
+  EXPECT_FALSE(canResampleYUV(packedFormat));
+  EXPECT_TRUE(resampleYUV(createFrameData(packedFormat, TEST_FRAME_SIZE, 0),
+                          packedFormat,
+                          TEST_FRAME_SIZE,
+                          Size(40, 40),
+                          ResampleFilter::Bilinear)
+                  .isEmpty());
+
+  const PixelFormatYUV planarFormat(Subsampling::YUV_420, 8);
+  EXPECT_TRUE(canResampleYUV(planarFormat));
+  EXPECT_TRUE(resampleYUV(createFrameData(planarFormat, TEST_FRAME_SIZE, 0),
+                          planarFormat,
+                          TEST_FRAME_SIZE,
+                          Size(41, 40),
+                          ResampleFilter::Bilinear)
+                  .isEmpty());
+}
+
+} // namespace video::yuv::test